@@ -0,0 +1,91 @@
+#include "./bench_common.hpp"
+
+// All batch kernels of a kernel-set (same set of kernels for every ISA)
+#define MATH3D_BENCH_BATCH_KERNELS(isa)                                        \
+    MATH3D_BENCH_BATCH_KERNEL(BenchBatchBinary, isa, kernel_add_vec3_batch);   \
+    MATH3D_BENCH_BATCH_KERNEL(BenchBatchBinary, isa, kernel_sub_vec3_batch);   \
+    MATH3D_BENCH_BATCH_KERNEL(BenchBatchScale, isa, kernel_scale_vec3_batch);  \
+    MATH3D_BENCH_BATCH_KERNEL(BenchBatchBinary, isa,                           \
+                              kernel_hadamard_vec3_batch);                     \
+    MATH3D_BENCH_BATCH_KERNEL(BenchBatchBinary, isa, kernel_dot_vec3_batch);   \
+    MATH3D_BENCH_BATCH_KERNEL(BenchBatchBinary, isa, kernel_cross_vec3_batch); \
+    MATH3D_BENCH_BATCH_KERNEL(BenchBatchUnary, isa,                            \
+                              kernel_length_square_vec3_batch);                \
+    MATH3D_BENCH_BATCH_KERNEL(BenchBatchUnary, isa, kernel_length_vec3_batch); \
+    MATH3D_BENCH_BATCH_KERNEL(BenchBatchUnary, isa,                            \
+                              kernel_normalize_vec3_batch);                    \
+    MATH3D_BENCH_BATCH_KERNEL(BenchBatchBinary, isa, kernel_dot_vec3_aos);     \
+    MATH3D_BENCH_BATCH_KERNEL(BenchBatchBinary, isa, kernel_cross_vec3_aos);   \
+    MATH3D_BENCH_BATCH_KERNEL(BenchBatchUnary, isa,                            \
+                              kernel_length_square_vec3_aos);                  \
+    MATH3D_BENCH_BATCH_KERNEL(BenchBatchUnary, isa, kernel_length_vec3_aos);   \
+    MATH3D_BENCH_BATCH_KERNEL(BenchBatchUnary, isa,                            \
+                              kernel_normalize_vec3_aos);                      \
+    MATH3D_BENCH_BATCH_KERNEL(BenchBatchLerp, isa, kernel_lerp_vec3_aos);      \
+    MATH3D_BENCH_BATCH_KERNEL(BenchBatchUnary, isa, kernel_aos_to_soa_vec3);   \
+    MATH3D_BENCH_BATCH_KERNEL(BenchBatchUnary, isa, kernel_soa_to_aos_vec3);   \
+    MATH3D_BENCH_BATCH_KERNEL(BenchBatchTransform, isa,                        \
+                              kernel_transform_points_vec3_aos);               \
+    MATH3D_BENCH_BATCH_KERNEL(BenchBatchTransform, isa,                        \
+                              kernel_transform_directions_vec3_aos);           \
+    MATH3D_BENCH_BATCH_KERNEL(BenchBatchTransform, isa,                        \
+                              kernel_transform_points_vec3_batch);             \
+    MATH3D_BENCH_BATCH_KERNEL(BenchBatchTransform, isa,                        \
+                              kernel_transform_directions_vec3_batch);         \
+    MATH3D_BENCH_BATCH_KERNEL(BenchBatchComposePoses, isa,                     \
+                              kernel_compose_poses_aos);                       \
+    MATH3D_BENCH_BATCH_KERNEL(BenchBatchInvertPoses, isa,                      \
+                              kernel_invert_poses_aos);                        \
+    MATH3D_BENCH_BATCH_KERNEL(BenchBatchSlerp, isa, kernel_slerp_quat_aos);    \
+    MATH3D_BENCH_BATCH_KERNEL(BenchBatchSlerp, isa, kernel_nlerp_quat_aos);    \
+    MATH3D_BENCH_BATCH_KERNEL(BenchBatchQuatFromMat3, isa,                     \
+                              kernel_quat_from_mat3_aos);                      \
+    MATH3D_BENCH_BATCH_KERNEL(BenchBatchMat3FromQuat, isa,                     \
+                              kernel_mat3_from_quat_aos);                      \
+    MATH3D_BENCH_BATCH_KERNEL(BenchBatchQuatFromEuler, isa,                    \
+                              kernel_quat_from_euler_aos);                     \
+    MATH3D_BENCH_BATCH_KERNEL(BenchBatchFastSincos, isa,                       \
+                              kernel_fast_sincos_batch);                       \
+    MATH3D_BENCH_BATCH_KERNEL(BenchBatchFastAtan2, isa,                        \
+                              kernel_fast_atan2_batch);                        \
+    MATH3D_BENCH_BATCH_KERNEL(BenchBatchFastUnary, isa,                        \
+                              kernel_fast_asin_batch);                         \
+    MATH3D_BENCH_BATCH_KERNEL(BenchBatchFastUnary, isa,                        \
+                              kernel_fast_acos_batch);                         \
+    MATH3D_BENCH_BATCH_KERNEL(BenchBatchRayAABB, isa, kernel_ray_aabb_batch);  \
+    MATH3D_BENCH_BATCH_KERNEL(BenchBatchCullPoints, isa, kernel_cull_points);  \
+    MATH3D_BENCH_BATCH_KERNEL(BenchBatchCullSpheres, isa,                      \
+                              kernel_cull_spheres);                            \
+    MATH3D_BENCH_BATCH_KERNEL(BenchBatchCullBoxes, isa, kernel_cull_boxes);    \
+    MATH3D_BENCH_BATCH_KERNEL(BenchBatchSpherePoints, isa,                     \
+                              kernel_sphere_points);                           \
+    MATH3D_BENCH_BATCH_KERNEL(BenchBatchSphereSpheres, isa,                    \
+                              kernel_sphere_spheres);                          \
+    MATH3D_BENCH_BATCH_KERNEL(BenchBatchAABBAABBs, isa, kernel_aabb_aabbs)
+
+namespace math {
+namespace bench {
+
+auto RegisterBatchKernels() -> void {
+    // The SIMD batch kernels can be compiled-in (runtime dispatch) while the
+    // host CPU doesn't support them, so only register the ones we can run
+    MATH3D_BENCH_BATCH_KERNELS(scalar);
+#if defined(MATH3D_DISPATCH_SSE)
+    if (dispatch::IsSupported(dispatch::Isa::SSE)) {
+        MATH3D_BENCH_BATCH_KERNELS(sse);
+    }
+#endif
+#if defined(MATH3D_DISPATCH_AVX)
+    if (dispatch::IsSupported(dispatch::Isa::AVX)) {
+        MATH3D_BENCH_BATCH_KERNELS(avx);
+    }
+#endif
+#if defined(MATH3D_DISPATCH_AVX512)
+    if (dispatch::IsSupported(dispatch::Isa::AVX512)) {
+        MATH3D_BENCH_BATCH_KERNELS(avx512);
+    }
+#endif
+}
+
+}  // namespace bench
+}  // namespace math
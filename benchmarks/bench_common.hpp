@@ -0,0 +1,804 @@
+#pragma once
+
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <math/aabb_batch_t.hpp>
+#include <math/frustum_culling.hpp>
+#include <math/dispatch.hpp>
+#include <math/fast_math.hpp>
+#include <math/mat2_t.hpp>
+#include <math/mat3_t.hpp>
+#include <math/mat4_t.hpp>
+#include <math/overlap_queries.hpp>
+#include <math/pose3d_t.hpp>
+#include <math/quat_t.hpp>
+#include <math/vec2_t.hpp>
+#include <math/vec3_batch_t.hpp>
+#include <math/vec3_t.hpp>
+#include <math/vec4_t.hpp>
+
+// -----------------------------------------------------------------------------
+// Helpers shared by all benchmarks
+//
+// Each single-object kernel is benchmarked through one of the generic bodies
+// below, picked according to the signature of the kernel, e.g. BenchBinary for
+// kernel_add_vec3 (dst, lhs, rhs) or BenchReduce for kernel_trace_mat4 (mat).
+// The buffer types are deduced from the kernel itself, so a single body covers
+// all types, kernel-sets (scalar, sse, avx) and scalar types (f32, f64).
+//
+// Benchmarks are named "<kernel>/<isa>/<dtype>", e.g. "kernel_add_vec3/sse/f32"
+// for the kernels, and "<group>/<operation>/<dtype>" for the operators.
+// -----------------------------------------------------------------------------
+
+// Registers the benchmark of `kernel` (for a single scalar type) in the given
+// kernel-set, e.g. MATH3D_BENCH_KERNEL_F32(BenchBinary, sse, kernel_add_vec3)
+#define MATH3D_BENCH_KERNEL_T(body, isa, kernel, T, dtype)                     \
+    ::benchmark::RegisterBenchmark(                                            \
+        #kernel "/" #isa "/" dtype, [](::benchmark::State& state) {            \
+            ::math::bench::body<::math::T>(state,                              \
+                                           &::math::isa::kernel<::math::T>);   \
+        })
+
+#define MATH3D_BENCH_KERNEL_F32(body, isa, kernel)                             \
+    MATH3D_BENCH_KERNEL_T(body, isa, kernel, float32_t, "f32")
+
+#define MATH3D_BENCH_KERNEL_F64(body, isa, kernel)                             \
+    MATH3D_BENCH_KERNEL_T(body, isa, kernel, float64_t, "f64")
+
+// Registers the benchmarks of `kernel` for both float32 and float64
+#define MATH3D_BENCH_KERNEL(body, isa, kernel)                                 \
+    MATH3D_BENCH_KERNEL_F32(body, isa, kernel);                                \
+    MATH3D_BENCH_KERNEL_F64(body, isa, kernel)
+
+// Registers the latency benchmarks of the product `kernel` (f32 and f64), named
+// "<kernel>/<isa>/<dtype>/latency" (see BenchProductLatency)
+#define MATH3D_BENCH_LATENCY(isa, kernel)                                      \
+    ::benchmark::RegisterBenchmark(                                            \
+        #kernel "/" #isa "/f32/latency", [](::benchmark::State& state) {       \
+            ::math::bench::BenchProductLatency<::math::float32_t>(             \
+                state, &::math::isa::kernel<::math::float32_t>);               \
+        });                                                                    \
+    ::benchmark::RegisterBenchmark(                                            \
+        #kernel "/" #isa "/f64/latency", [](::benchmark::State& state) {       \
+            ::math::bench::BenchProductLatency<::math::float64_t>(             \
+                state, &::math::isa::kernel<::math::float64_t>);               \
+        })
+
+// Registers the benchmarks of the batch kernel `kernel` (f32 and f64), over
+// arrays of each of the sizes in BATCH_SIZES
+#define MATH3D_BENCH_BATCH_KERNEL(body, isa, kernel)                           \
+    MATH3D_BENCH_KERNEL_F32(body, isa, kernel)                                 \
+        ->Apply(::math::bench::BatchSizes);                                    \
+    MATH3D_BENCH_KERNEL_F64(body, isa, kernel)->Apply(::math::bench::BatchSizes)
+
+namespace math {
+namespace bench {
+
+/// Number of elements used for the batch benchmarks (from L1 to L2 sizes)
+constexpr int64_t BATCH_SIZES[] = {64, 1024, 16384};
+
+/// Alignment of the buffers used by the single-object benchmarks (enough for
+/// the aligned loads|stores of every kernel-set, e.g. for MATH3D_VEC3_PADDED)
+constexpr size_t BUFFER_ALIGNMENT = 64;
+
+// Registration of the benchmarks of each group (one per source file)
+auto RegisterVectorKernels() -> void;
+auto RegisterQuaternionKernels() -> void;
+auto RegisterMatrixKernels() -> void;
+auto RegisterBatchKernels() -> void;
+auto RegisterOperators() -> void;
+auto RegisterGeometry() -> void;
+
+/// Returns the random engine used to generate the inputs (fixed seed)
+inline auto Engine() -> std::mt19937& {
+    static std::mt19937 s_engine(12345);  // NOLINT
+    return s_engine;
+}
+
+/// Returns a random value in the range [-1, 1]
+template <typename T>
+auto RandomValue() -> T {
+    std::uniform_real_distribution<T> dist(static_cast<T>(-1.0),
+                                           static_cast<T>(1.0));
+    return dist(Engine());
+}
+
+/// Fills all entries of the given buffer (e.g. a Mat4Buffer) with random values
+template <typename T, typename Buffer>
+auto FillRandom(Buffer& buffer) -> void {
+    static_assert(sizeof(Buffer) % sizeof(T) == 0,
+                  "Buffer must only hold values of type T");
+    auto* data = reinterpret_cast<T*>(&buffer);  // NOLINT
+    for (size_t i = 0; i < sizeof(Buffer) / sizeof(T); ++i) {
+        data[i] = RandomValue<T>();
+    }
+}
+
+/// Storage for the argument of a single-object kernel, followed by a register
+/// worth of zeros. The SIMD kernels of Vector2|Vector3 load|store 4 lanes per
+/// vector (the operators only use them over padded storage), so they would
+/// otherwise read and write past the end of a bare std::array<T, 2|3>
+template <typename Buffer>
+struct alignas(BUFFER_ALIGNMENT) Padded {
+    Buffer buffer{};
+    std::array<uint8_t, 32> padding{};
+};
+
+/// Returns a random rotation, as a unit quaternion
+template <typename T>
+auto RandomRotation() -> Quaternion<T> {
+    Quaternion<T> quat;
+    FillRandom<T>(quat.elements());
+    quat.normalize();
+    return quat;
+}
+
+/// Returns a random rigid transform, i.e. [R | p] with R a rotation matrix
+template <typename T>
+auto RandomRigidTransform() -> Matrix4<T> {
+    Vector3<T> position;
+    FillRandom<T>(position.elements());
+    return Matrix4<T>(position, RandomRotation<T>());
+}
+
+/// Returns a random pose, with a unit quaternion as orientation
+template <typename T>
+auto RandomPose() -> Pose3d<T> {
+    Vector3<T> position;
+    FillRandom<T>(position.elements());
+    return Pose3d<T>(position, RandomRotation<T>());
+}
+
+/// Returns an array of the given size with random values
+template <typename T>
+auto RandomArray(size_t size) -> std::vector<T> {
+    std::vector<T> array(size);
+    for (auto& value : array) {
+        value = RandomValue<T>();
+    }
+    return array;
+}
+
+/// Adds one run of a batch benchmark for each of the sizes in BATCH_SIZES
+inline auto BatchSizes(::benchmark::internal::Benchmark* bench) -> void {
+    for (const auto size : BATCH_SIZES) {
+        bench->Arg(size);
+    }
+}
+
+/// Reports the number of elements processed by a batch benchmark
+inline auto SetBatchCounters(::benchmark::State& state, int64_t num) -> void {
+    state.SetItemsProcessed(state.iterations() * num);
+}
+
+// *****************************************************************************
+//                   Bodies for the single-object kernels
+// *****************************************************************************
+
+// Notes:
+// * The inputs are escaped once before the timed loop, and memory is clobbered
+//   after each call, so the compiler can't hoist the kernel out of the loop.
+
+/// Kernels of the form kernel(dst, lhs, rhs), e.g. kernel_add_vec3
+template <typename T, typename Dst, typename Lhs, typename Rhs>
+auto BenchBinary(::benchmark::State& state,
+                 void (*kernel)(Dst&, const Lhs&, const Rhs&)) -> void {
+    Padded<Dst> dst_padded;
+    auto& dst = dst_padded.buffer;
+    Padded<Lhs> lhs_padded;
+    auto& lhs = lhs_padded.buffer;
+    Padded<Rhs> rhs_padded;
+    auto& rhs = rhs_padded.buffer;
+    FillRandom<T>(lhs);
+    FillRandom<T>(rhs);
+    ::benchmark::DoNotOptimize(&lhs);
+    ::benchmark::DoNotOptimize(&rhs);
+    for (auto _ : state) {
+        kernel(dst, lhs, rhs);
+        ::benchmark::DoNotOptimize(&dst);
+        ::benchmark::ClobberMemory();
+    }
+}
+
+/// Matrix products of the form kernel(dst, mat, rhs), e.g. kernel_matmul_mat4
+///
+/// Unlike BenchBinary (which measures throughput, as the calls are independent)
+/// each call takes the result of the previous one as its right-hand side, so
+/// this measures the latency of the dependency chain through the kernel. The
+/// matrix is the identity, so the values neither grow nor become denormals.
+template <typename T, typename Dst, typename Mat>
+auto BenchProductLatency(::benchmark::State& state,
+                         void (*kernel)(Dst&, const Mat&, const Dst&)) -> void {
+    Padded<Dst> dst_padded;
+    auto& dst = dst_padded.buffer;
+    Padded<Dst> rhs_padded;
+    auto& rhs = rhs_padded.buffer;
+    Padded<Mat> mat_padded;
+    auto& mat = mat_padded.buffer;
+    for (size_t i = 0; i < mat.size(); ++i) {
+        mat[i][i] = static_cast<T>(1.0);
+    }
+    FillRandom<T>(rhs);
+    ::benchmark::DoNotOptimize(&mat);
+    for (auto _ : state) {
+        kernel(dst, mat, rhs);
+        rhs = dst;
+        ::benchmark::DoNotOptimize(&rhs);
+    }
+}
+
+/// Kernels of the form kernel(dst, scale, src), e.g. kernel_scale_vec3
+template <typename T, typename Dst, typename Src>
+auto BenchScale(::benchmark::State& state, void (*kernel)(Dst&, T, const Src&))
+    -> void {
+    Padded<Dst> dst_padded;
+    auto& dst = dst_padded.buffer;
+    Padded<Src> src_padded;
+    auto& src = src_padded.buffer;
+    T scale = RandomValue<T>();
+    FillRandom<T>(src);
+    ::benchmark::DoNotOptimize(&src);
+    ::benchmark::DoNotOptimize(&scale);
+    for (auto _ : state) {
+        kernel(dst, scale, src);
+        ::benchmark::DoNotOptimize(&dst);
+        ::benchmark::ClobberMemory();
+    }
+}
+
+/// Kernels of the form kernel(dst, src), e.g. kernel_inverse_mat4
+template <typename T, typename Dst, typename Src>
+auto BenchUnary(::benchmark::State& state, void (*kernel)(Dst&, const Src&))
+    -> void {
+    Padded<Dst> dst_padded;
+    auto& dst = dst_padded.buffer;
+    Padded<Src> src_padded;
+    auto& src = src_padded.buffer;
+    FillRandom<T>(src);
+    ::benchmark::DoNotOptimize(&src);
+    for (auto _ : state) {
+        kernel(dst, src);
+        ::benchmark::DoNotOptimize(&dst);
+        ::benchmark::ClobberMemory();
+    }
+}
+
+/// Kernels that modify their argument, e.g. kernel_normalize_in_place_vec3
+template <typename T, typename Buffer>
+auto BenchInPlace(::benchmark::State& state, void (*kernel)(Buffer&)) -> void {
+    Padded<Buffer> buffer_padded;
+    auto& buffer = buffer_padded.buffer;
+    FillRandom<T>(buffer);
+    for (auto _ : state) {
+        kernel(buffer);
+        ::benchmark::DoNotOptimize(&buffer);
+        ::benchmark::ClobberMemory();
+    }
+}
+
+/// Kernels that reduce their argument to a value, e.g. kernel_trace_mat4
+template <typename T, typename Ret, typename Src>
+auto BenchReduce(::benchmark::State& state, Ret (*kernel)(const Src&))
+    -> void {
+    Padded<Src> src_padded;
+    auto& src = src_padded.buffer;
+    FillRandom<T>(src);
+    ::benchmark::DoNotOptimize(&src);
+    for (auto _ : state) {
+        auto result = kernel(src);
+        ::benchmark::DoNotOptimize(result);
+        ::benchmark::ClobberMemory();
+    }
+}
+
+/// Kernels that reduce two arguments to a value, e.g. kernel_dot_vec3
+template <typename T, typename Ret, typename Lhs, typename Rhs>
+auto BenchReduceBinary(::benchmark::State& state,
+                       Ret (*kernel)(const Lhs&, const Rhs&)) -> void {
+    Padded<Lhs> lhs_padded;
+    auto& lhs = lhs_padded.buffer;
+    Padded<Rhs> rhs_padded;
+    auto& rhs = rhs_padded.buffer;
+    FillRandom<T>(lhs);
+    FillRandom<T>(rhs);
+    ::benchmark::DoNotOptimize(&lhs);
+    ::benchmark::DoNotOptimize(&rhs);
+    for (auto _ : state) {
+        auto result = kernel(lhs, rhs);
+        ::benchmark::DoNotOptimize(result);
+        ::benchmark::ClobberMemory();
+    }
+}
+
+/// Kernels of the form kernel(src, tolerance), e.g. kernel_is_rigid_mat4
+template <typename T, typename Src>
+auto BenchPredicate(::benchmark::State& state, bool (*kernel)(const Src&, T))
+    -> void {
+    // Use a rigid transform, so the checks can't exit early
+    auto transform = RandomRigidTransform<T>();
+    auto& src = transform.elements();
+    T tolerance = static_cast<T>(1e-3);
+    ::benchmark::DoNotOptimize(&src);
+    ::benchmark::DoNotOptimize(&tolerance);
+    for (auto _ : state) {
+        auto result = kernel(src, tolerance);
+        ::benchmark::DoNotOptimize(result);
+        ::benchmark::ClobberMemory();
+    }
+}
+
+/// Kernels of the form kernel(dst, a, b, alpha), e.g. kernel_lerp_vec3
+template <typename T, typename Dst, typename Src>
+auto BenchLerp(::benchmark::State& state,
+               void (*kernel)(Dst&, const Src&, const Src&, T)) -> void {
+    Padded<Dst> dst_padded;
+    auto& dst = dst_padded.buffer;
+    Padded<Src> vec_a_padded;
+    auto& vec_a = vec_a_padded.buffer;
+    Padded<Src> vec_b_padded;
+    auto& vec_b = vec_b_padded.buffer;
+    T alpha = static_cast<T>(0.25);
+    FillRandom<T>(vec_a);
+    FillRandom<T>(vec_b);
+    ::benchmark::DoNotOptimize(&vec_a);
+    ::benchmark::DoNotOptimize(&vec_b);
+    ::benchmark::DoNotOptimize(&alpha);
+    for (auto _ : state) {
+        kernel(dst, vec_a, vec_b, alpha);
+        ::benchmark::DoNotOptimize(&dst);
+        ::benchmark::ClobberMemory();
+    }
+}
+
+// *****************************************************************************
+//                        Bodies for the batch kernels
+// *****************************************************************************
+
+/// Random inputs (or outputs) for the batch kernels, both in SoA and AoS form
+///
+/// Converts to whatever the kernel expects for each argument, i.e. SoA planes
+/// (Vector3Planes) or AoS arrays (T*), e.g. kernel_dot_vec3_batch(T* dst,
+/// Vector3Planes<const T> lhs, Vector3Planes<const T> rhs, size_t num)
+template <typename T>
+struct BatchData {
+    explicit BatchData(size_t num)
+        : x(RandomArray<T>(num)),
+          y(RandomArray<T>(num)),
+          z(RandomArray<T>(num)),
+          aos(RandomArray<T>(num * sizeof(Vector3<T>) / sizeof(T))) {}
+
+    // NOLINTNEXTLINE(google-explicit-constructor)
+    operator Vector3Planes<T>() { return {x.data(), y.data(), z.data()}; }
+
+    // NOLINTNEXTLINE(google-explicit-constructor)
+    operator Vector3Planes<const T>() const {
+        return {x.data(), y.data(), z.data()};
+    }
+
+    // NOLINTNEXTLINE(google-explicit-constructor)
+    operator T*() { return aos.data(); }
+
+    // NOLINTNEXTLINE(google-explicit-constructor)
+    operator const T*() const { return aos.data(); }
+
+    /// Coordinates of the vectors in SoA form (one array per coordinate)
+    std::vector<T> x;
+    std::vector<T> y;
+    std::vector<T> z;
+    /// Vectors in AoS form (same layout as an array of Vector3<T>)
+    std::vector<T> aos;
+};
+
+/// Batch kernels of the form kernel(dst, lhs, rhs, num), e.g.
+/// kernel_add_vec3_batch or kernel_dot_vec3_aos
+template <typename T, typename Dst, typename Lhs, typename Rhs>
+auto BenchBatchBinary(::benchmark::State& state,
+                      void (*kernel)(Dst, Lhs, Rhs, size_t)) -> void {
+    const auto num = static_cast<size_t>(state.range(0));
+    BatchData<T> dst(num);
+    const BatchData<T> lhs(num);
+    const BatchData<T> rhs(num);
+    for (auto _ : state) {
+        kernel(dst, lhs, rhs, num);
+        ::benchmark::ClobberMemory();
+    }
+    SetBatchCounters(state, static_cast<int64_t>(num));
+}
+
+/// Batch kernels of the form kernel(dst, scale, src, num), e.g.
+/// kernel_scale_vec3_batch
+template <typename T, typename Dst, typename Src>
+auto BenchBatchScale(::benchmark::State& state,
+                     void (*kernel)(Dst, T, Src, size_t)) -> void {
+    const auto num = static_cast<size_t>(state.range(0));
+    BatchData<T> dst(num);
+    const BatchData<T> src(num);
+    const T scale = RandomValue<T>();
+    for (auto _ : state) {
+        kernel(dst, scale, src, num);
+        ::benchmark::ClobberMemory();
+    }
+    SetBatchCounters(state, static_cast<int64_t>(num));
+}
+
+/// Batch kernels of the form kernel(dst, src, num), e.g.
+/// kernel_length_vec3_batch or kernel_aos_to_soa_vec3
+template <typename T, typename Dst, typename Src>
+auto BenchBatchUnary(::benchmark::State& state,
+                     void (*kernel)(Dst, Src, size_t)) -> void {
+    const auto num = static_cast<size_t>(state.range(0));
+    BatchData<T> dst(num);
+    const BatchData<T> src(num);
+    for (auto _ : state) {
+        kernel(dst, src, num);
+        ::benchmark::ClobberMemory();
+    }
+    SetBatchCounters(state, static_cast<int64_t>(num));
+}
+
+/// Batch kernels of the form kernel(dst, vec_a, vec_b, alpha, num), e.g.
+/// kernel_lerp_vec3_aos
+template <typename T, typename Dst, typename Src>
+auto BenchBatchLerp(::benchmark::State& state,
+                    void (*kernel)(Dst, Src, Src, T, size_t)) -> void {
+    const auto num = static_cast<size_t>(state.range(0));
+    BatchData<T> dst(num);
+    const BatchData<T> vec_a(num);
+    const BatchData<T> vec_b(num);
+    const T alpha = RandomValue<T>();
+    for (auto _ : state) {
+        kernel(dst, vec_a, vec_b, alpha, num);
+        ::benchmark::ClobberMemory();
+    }
+    SetBatchCounters(state, static_cast<int64_t>(num));
+}
+
+/// Batch kernels of the form kernel(dst, mat, src, num), e.g.
+/// kernel_transform_points_vec3_aos
+template <typename T, typename Dst, typename Src>
+auto BenchBatchTransform(::benchmark::State& state,
+                         void (*kernel)(Dst,
+                                        const typename Matrix4<T>::BufferType&,
+                                        Src, size_t)) -> void {
+    const auto num = static_cast<size_t>(state.range(0));
+    BatchData<T> dst(num);
+    const BatchData<T> src(num);
+    const auto transform = RandomRigidTransform<T>();
+    for (auto _ : state) {
+        kernel(dst, transform.elements(), src, num);
+        ::benchmark::ClobberMemory();
+    }
+    SetBatchCounters(state, static_cast<int64_t>(num));
+}
+
+/// Returns an array of the given size with random poses
+template <typename T>
+auto RandomPoses(size_t num) -> std::vector<Pose3d<T>> {
+    std::vector<Pose3d<T>> poses(num);
+    for (auto& pose : poses) {
+        pose = RandomPose<T>();
+    }
+    return poses;
+}
+
+/// Batch kernel kernel_compose_poses_aos (renormalizing every result)
+template <typename T>
+auto BenchBatchComposePoses(::benchmark::State& state,
+                            void (*kernel)(T*, const T*, const T*, size_t,
+                                           bool)) -> void {
+    const auto num = static_cast<size_t>(state.range(0));
+    auto dst = RandomPoses<T>(num);
+    const auto lhs = RandomPoses<T>(num);
+    const auto rhs = RandomPoses<T>(num);
+    for (auto _ : state) {
+        kernel(aos_cast<T>(dst.data()), aos_cast<T>(lhs.data()),
+               aos_cast<T>(rhs.data()), num, true);
+        ::benchmark::ClobberMemory();
+    }
+    SetBatchCounters(state, static_cast<int64_t>(num));
+}
+
+/// Batch kernel kernel_invert_poses_aos
+template <typename T>
+auto BenchBatchInvertPoses(::benchmark::State& state,
+                           void (*kernel)(T*, const T*, size_t)) -> void {
+    const auto num = static_cast<size_t>(state.range(0));
+    auto dst = RandomPoses<T>(num);
+    const auto src = RandomPoses<T>(num);
+    for (auto _ : state) {
+        kernel(aos_cast<T>(dst.data()), aos_cast<T>(src.data()), num);
+        ::benchmark::ClobberMemory();
+    }
+    SetBatchCounters(state, static_cast<int64_t>(num));
+}
+
+/// Returns an array of the given size with random unit quaternions
+template <typename T>
+auto RandomRotations(size_t num) -> std::vector<Quaternion<T>> {
+    std::vector<Quaternion<T>> rotations(num);
+    for (auto& rotation : rotations) {
+        rotation = RandomRotation<T>();
+    }
+    return rotations;
+}
+
+/// Batch kernels of the form kernel(dst, q_a, q_b, alpha, alpha_stride, num),
+/// e.g. kernel_slerp_quat_aos (with a different alpha for each pair)
+template <typename T>
+auto BenchBatchSlerp(::benchmark::State& state,
+                     void (*kernel)(T*, const T*, const T*, const T*, size_t,
+                                    size_t)) -> void {
+    const auto num = static_cast<size_t>(state.range(0));
+    auto dst = RandomRotations<T>(num);
+    const auto q_a = RandomRotations<T>(num);
+    const auto q_b = RandomRotations<T>(num);
+    const auto alpha = RandomArray<T>(num);
+    for (auto _ : state) {
+        kernel(aos_cast<T>(dst.data()), aos_cast<T>(q_a.data()),
+               aos_cast<T>(q_b.data()), alpha.data(), 1, num);
+        ::benchmark::ClobberMemory();
+    }
+    SetBatchCounters(state, static_cast<int64_t>(num));
+}
+
+/// Batch kernel kernel_quat_from_mat3_aos (over proper rotation matrices)
+template <typename T>
+auto BenchBatchQuatFromMat3(::benchmark::State& state,
+                            void (*kernel)(T*, const T*, size_t)) -> void {
+    const auto num = static_cast<size_t>(state.range(0));
+    auto dst = RandomRotations<T>(num);
+    std::vector<Matrix3<T>> mats(num);
+    for (auto& mat : mats) {
+        mat = Matrix3<T>(RandomRotation<T>());
+    }
+    for (auto _ : state) {
+        kernel(aos_cast<T>(dst.data()), aos_cast<T>(mats.data()), num);
+        ::benchmark::ClobberMemory();
+    }
+    SetBatchCounters(state, static_cast<int64_t>(num));
+}
+
+/// Batch kernel kernel_mat3_from_quat_aos
+template <typename T>
+auto BenchBatchMat3FromQuat(::benchmark::State& state,
+                            void (*kernel)(T*, const T*, size_t)) -> void {
+    const auto num = static_cast<size_t>(state.range(0));
+    std::vector<Matrix3<T>> dst(num);
+    const auto quats = RandomRotations<T>(num);
+    for (auto _ : state) {
+        kernel(aos_cast<T>(dst.data()), aos_cast<T>(quats.data()), num);
+        ::benchmark::ClobberMemory();
+    }
+    SetBatchCounters(state, static_cast<int64_t>(num));
+}
+
+/// Batch kernel kernel_fast_sincos_batch (FULL accuracy)
+template <typename T>
+auto BenchBatchFastSincos(::benchmark::State& state,
+                          void (*kernel)(T*, T*, const T*, size_t,
+                                         fast::Accuracy)) -> void {
+    const auto num = static_cast<size_t>(state.range(0));
+    std::vector<T> sines(num), cosines(num);
+    const auto angles = RandomArray<T>(num);
+    for (auto _ : state) {
+        kernel(sines.data(), cosines.data(), angles.data(), num,
+               fast::Accuracy::FULL);
+        ::benchmark::ClobberMemory();
+    }
+    SetBatchCounters(state, static_cast<int64_t>(num));
+}
+
+/// Batch kernel kernel_fast_atan2_batch (FULL accuracy)
+template <typename T>
+auto BenchBatchFastAtan2(::benchmark::State& state,
+                         void (*kernel)(T*, const T*, const T*, size_t,
+                                        fast::Accuracy)) -> void {
+    const auto num = static_cast<size_t>(state.range(0));
+    std::vector<T> dst(num);
+    const auto y = RandomArray<T>(num);
+    const auto x = RandomArray<T>(num);
+    for (auto _ : state) {
+        kernel(dst.data(), y.data(), x.data(), num, fast::Accuracy::FULL);
+        ::benchmark::ClobberMemory();
+    }
+    SetBatchCounters(state, static_cast<int64_t>(num));
+}
+
+/// Batch kernels of the form kernel(dst, x, num, accuracy), e.g.
+/// kernel_fast_asin_batch (FULL accuracy, over values in [-1, 1])
+template <typename T>
+auto BenchBatchFastUnary(::benchmark::State& state,
+                         void (*kernel)(T*, const T*, size_t, fast::Accuracy))
+    -> void {
+    const auto num = static_cast<size_t>(state.range(0));
+    std::vector<T> dst(num);
+    const auto x = RandomArray<T>(num);
+    for (auto _ : state) {
+        kernel(dst.data(), x.data(), num, fast::Accuracy::FULL);
+        ::benchmark::ClobberMemory();
+    }
+    SetBatchCounters(state, static_cast<int64_t>(num));
+}
+
+/// Batch kernel kernel_quat_from_euler_aos (XYZ order, FULL accuracy)
+template <typename T>
+auto BenchBatchQuatFromEuler(::benchmark::State& state,
+                             void (*kernel)(T*, const T*, euler::Order, size_t,
+                                            fast::Accuracy)) -> void {
+    const auto num = static_cast<size_t>(state.range(0));
+    auto dst = RandomRotations<T>(num);
+    const auto angles = RandomArray<T>(3 * num);
+    for (auto _ : state) {
+        kernel(aos_cast<T>(dst.data()), angles.data(), euler::Order::XYZ, num,
+               fast::Accuracy::FULL);
+        ::benchmark::ClobberMemory();
+    }
+    SetBatchCounters(state, static_cast<int64_t>(num));
+}
+
+/// Batch kernel kernel_ray_aabb_batch (one ray against a batch of random boxes)
+template <typename T>
+auto BenchBatchRayAABB(::benchmark::State& state,
+                       void (*kernel)(T*, const Ray<T>&, T, AABBPlanes<const T>,
+                                      size_t)) -> void {
+    const auto num = static_cast<size_t>(state.range(0));
+    std::vector<T> dst(num);
+    AABBBatch<T> boxes(num);
+    for (size_t i = 0; i < num; ++i) {
+        const Vector3<T> center(RandomValue<T>(), RandomValue<T>(),
+                                RandomValue<T>());
+        const Vector3<T> half(static_cast<T>(0.1), static_cast<T>(0.1),
+                              static_cast<T>(0.1));
+        boxes.set(i, AABB<T>(center - half, center + half));
+    }
+    const Ray<T> ray({RandomValue<T>(), RandomValue<T>(), RandomValue<T>()},
+                     {RandomValue<T>(), RandomValue<T>(), RandomValue<T>()});
+    const auto t_max = std::numeric_limits<T>::infinity();
+    for (auto _ : state) {
+        kernel(dst.data(), ray, t_max, boxes.planes(), num);
+        ::benchmark::ClobberMemory();
+    }
+    SetBatchCounters(state, static_cast<int64_t>(num));
+}
+
+/// Frustum used by the culling benchmarks, which sees about a fifth of the
+/// [-1, 1]^3 cube where the random points and volumes are
+template <typename T>
+auto BenchFrustum() -> Frustum<T> {
+    const auto proj = Matrix4<T>::Perspective(static_cast<T>(60.0),
+                                              static_cast<T>(1.0),
+                                              static_cast<T>(0.1),
+                                              static_cast<T>(1.5));
+    return Frustum<T>(proj * Matrix4<T>::Translation(
+                                 {static_cast<T>(0.0), static_cast<T>(0.0),
+                                  static_cast<T>(-1.0)}));
+}
+
+/// Batch kernel kernel_cull_points (random points against a frustum)
+template <typename T>
+auto BenchBatchCullPoints(::benchmark::State& state,
+                          void (*kernel)(uint64_t*, const Frustum<T>&,
+                                         Vector3Planes<const T>, size_t))
+    -> void {
+    const auto num = static_cast<size_t>(state.range(0));
+    std::vector<uint64_t> visible(bitmaskWords(num));
+    const BatchData<T> points(num);
+    const auto frustum = BenchFrustum<T>();
+    for (auto _ : state) {
+        kernel(visible.data(), frustum, points, num);
+        ::benchmark::ClobberMemory();
+    }
+    SetBatchCounters(state, static_cast<int64_t>(num));
+}
+
+/// Batch kernel kernel_cull_spheres (random spheres against a frustum)
+template <typename T>
+auto BenchBatchCullSpheres(::benchmark::State& state,
+                           void (*kernel)(uint64_t*, const Frustum<T>&,
+                                          Vector3Planes<const T>, const T*,
+                                          size_t)) -> void {
+    const auto num = static_cast<size_t>(state.range(0));
+    std::vector<uint64_t> visible(bitmaskWords(num));
+    const BatchData<T> centers(num);
+    const std::vector<T> radii(num, static_cast<T>(0.1));
+    const auto frustum = BenchFrustum<T>();
+    for (auto _ : state) {
+        kernel(visible.data(), frustum, centers, radii.data(), num);
+        ::benchmark::ClobberMemory();
+    }
+    SetBatchCounters(state, static_cast<int64_t>(num));
+}
+
+/// Batch kernel kernel_cull_boxes (random boxes against a frustum)
+template <typename T>
+auto BenchBatchCullBoxes(::benchmark::State& state,
+                         void (*kernel)(uint64_t*, const Frustum<T>&,
+                                        AABBPlanes<const T>, size_t)) -> void {
+    const auto num = static_cast<size_t>(state.range(0));
+    std::vector<uint64_t> visible(bitmaskWords(num));
+    AABBBatch<T> boxes(num);
+    for (size_t i = 0; i < num; ++i) {
+        const Vector3<T> center(RandomValue<T>(), RandomValue<T>(),
+                                RandomValue<T>());
+        const Vector3<T> half(static_cast<T>(0.1), static_cast<T>(0.1),
+                              static_cast<T>(0.1));
+        boxes.set(i, AABB<T>(center - half, center + half));
+    }
+    const auto frustum = BenchFrustum<T>();
+    for (auto _ : state) {
+        kernel(visible.data(), frustum, boxes.planes(), num);
+        ::benchmark::ClobberMemory();
+    }
+    SetBatchCounters(state, static_cast<int64_t>(num));
+}
+
+/// Batch kernel kernel_sphere_points (random points against a sphere)
+template <typename T>
+auto BenchBatchSpherePoints(::benchmark::State& state,
+                            void (*kernel)(uint64_t*, const Sphere<T>&,
+                                           Vector3Planes<const T>, size_t))
+    -> void {
+    const auto num = static_cast<size_t>(state.range(0));
+    std::vector<uint64_t> inside(bitmaskWords(num));
+    const BatchData<T> points(num);
+    const Sphere<T> sphere(Vector3<T>(), static_cast<T>(0.5));
+    for (auto _ : state) {
+        kernel(inside.data(), sphere, points, num);
+        ::benchmark::ClobberMemory();
+    }
+    SetBatchCounters(state, static_cast<int64_t>(num));
+}
+
+/// Batch kernel kernel_sphere_spheres (random spheres against a sphere)
+template <typename T>
+auto BenchBatchSphereSpheres(::benchmark::State& state,
+                             void (*kernel)(uint64_t*, const Sphere<T>&,
+                                            Vector3Planes<const T>, const T*,
+                                            size_t)) -> void {
+    const auto num = static_cast<size_t>(state.range(0));
+    std::vector<uint64_t> overlaps(bitmaskWords(num));
+    const BatchData<T> centers(num);
+    const std::vector<T> radii(num, static_cast<T>(0.1));
+    const Sphere<T> sphere(Vector3<T>(), static_cast<T>(0.5));
+    for (auto _ : state) {
+        kernel(overlaps.data(), sphere, centers, radii.data(), num);
+        ::benchmark::ClobberMemory();
+    }
+    SetBatchCounters(state, static_cast<int64_t>(num));
+}
+
+/// Batch kernel kernel_aabb_aabbs (random boxes against a box)
+template <typename T>
+auto BenchBatchAABBAABBs(::benchmark::State& state,
+                         void (*kernel)(uint64_t*, const AABB<T>&,
+                                        AABBPlanes<const T>, size_t)) -> void {
+    const auto num = static_cast<size_t>(state.range(0));
+    std::vector<uint64_t> overlaps(bitmaskWords(num));
+    AABBBatch<T> boxes(num);
+    for (size_t i = 0; i < num; ++i) {
+        const Vector3<T> center(RandomValue<T>(), RandomValue<T>(),
+                                RandomValue<T>());
+        const Vector3<T> half(static_cast<T>(0.1), static_cast<T>(0.1),
+                              static_cast<T>(0.1));
+        boxes.set(i, AABB<T>(center - half, center + half));
+    }
+    const Vector3<T> half(static_cast<T>(0.5), static_cast<T>(0.5),
+                          static_cast<T>(0.5));
+    const AABB<T> box(-half, half);
+    for (auto _ : state) {
+        kernel(overlaps.data(), box, boxes.planes(), num);
+        ::benchmark::ClobberMemory();
+    }
+    SetBatchCounters(state, static_cast<int64_t>(num));
+}
+
+}  // namespace bench
+}  // namespace math
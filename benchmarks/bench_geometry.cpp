@@ -0,0 +1,303 @@
+#include <math/aabb_batch_t.hpp>
+#include <math/utils/bvh.hpp>
+#include <math/utils/spatial_hash_grid.hpp>
+
+#include <cmath>
+#include <limits>
+
+#include "./bench_common.hpp"
+
+namespace math {
+namespace bench {
+
+/// Number of boxes used for the BVH benchmarks (the brute-force loops over all
+/// pairs take too long for larger arrays)
+constexpr int64_t NUM_BOXES[] = {1024, 16384};
+
+/// Adds one run of a BVH benchmark for each of the sizes in NUM_BOXES
+inline auto BoxSizes(::benchmark::internal::Benchmark* bench) -> void {
+    for (const auto size : NUM_BOXES) {
+        bench->Arg(size);
+    }
+}
+
+/// Number of points used for the spatial hash grid benchmarks
+constexpr int64_t NUM_POINTS[] = {16384, 1048576};
+
+/// Adds one run of a grid benchmark for each of the sizes in NUM_POINTS
+inline auto PointSizes(::benchmark::internal::Benchmark* bench) -> void {
+    for (const auto size : NUM_POINTS) {
+        bench->Arg(size);
+    }
+}
+
+/// Returns an array of random points, spread so that a sphere of radius 1
+/// around each one holds about 0.5 other points regardless of the size
+template <typename T>
+auto RandomPoints(size_t num) -> std::vector<Vector3<T>> {
+    const auto spread = static_cast<T>(std::cbrt(static_cast<double>(num)));
+    std::vector<Vector3<T>> points(num);
+    for (auto& point : points) {
+        point = Vector3<T>(spread * RandomValue<T>(), spread * RandomValue<T>(),
+                           spread * RandomValue<T>());
+    }
+    return points;
+}
+
+/// Returns an array of random boxes (with half-extents in [0, 0.5]), spread
+/// so that each one overlaps a few others regardless of the size of the array
+template <typename T>
+auto RandomBoxes(size_t num) -> std::vector<AABB<T>> {
+    const auto spread = static_cast<T>(std::cbrt(static_cast<double>(num)));
+    std::vector<AABB<T>> boxes(num);
+    for (auto& box : boxes) {
+        const Vector3<T> center(spread * RandomValue<T>(),
+                                spread * RandomValue<T>(),
+                                spread * RandomValue<T>());
+        const auto half = static_cast<T>(0.25) *
+                          (Vector3<T>(RandomValue<T>(), RandomValue<T>(),
+                                      RandomValue<T>()) +
+                           Vector3<T>(1.0, 1.0, 1.0));
+        box = AABB<T>(center - half, center + half);
+    }
+    return boxes;
+}
+
+/// Registers the benchmarks of the BVH, next to the brute-force loops over
+/// AABB::intersects that give the same results
+template <typename T>
+auto RegisterBVH(const std::string& dtype) -> void {
+    auto reg = [&dtype](const std::string& name,
+                        void (*body)(::benchmark::State&)) {
+        ::benchmark::RegisterBenchmark((name + "/" + dtype).c_str(), body)
+            ->Apply(BoxSizes);
+    };
+
+    reg("geometry/BVH::build", [](::benchmark::State& state) {
+        const auto num = static_cast<size_t>(state.range(0));
+        const auto boxes = RandomBoxes<T>(num);
+        BVH<T> bvh;
+        for (auto _ : state) {
+            bvh.build(boxes.data(), num);
+            ::benchmark::DoNotOptimize(bvh.nodes().data());
+        }
+        SetBatchCounters(state, static_cast<int64_t>(num));
+    });
+    reg("geometry/BVH::refit", [](::benchmark::State& state) {
+        const auto num = static_cast<size_t>(state.range(0));
+        const auto boxes = RandomBoxes<T>(num);
+        BVH<T> bvh(boxes.data(), num);
+        for (auto _ : state) {
+            bvh.refit(boxes.data(), num);
+            ::benchmark::DoNotOptimize(bvh.nodes().data());
+        }
+        SetBatchCounters(state, static_cast<int64_t>(num));
+    });
+
+    // All pairs of overlapping boxes (the broadphase of a collision pipeline)
+    reg("geometry/BVH::queryPairs", [](::benchmark::State& state) {
+        const auto num = static_cast<size_t>(state.range(0));
+        const auto boxes = RandomBoxes<T>(num);
+        BVH<T> bvh(boxes.data(), num);
+        for (auto _ : state) {
+            size_t num_pairs = 0;
+            bvh.queryPairs([&num_pairs](size_t, size_t) { ++num_pairs; });
+            ::benchmark::DoNotOptimize(num_pairs);
+        }
+        SetBatchCounters(state, static_cast<int64_t>(num));
+    });
+    reg("geometry/BVH::queryPairs/brute-force", [](::benchmark::State& state) {
+        const auto num = static_cast<size_t>(state.range(0));
+        const auto boxes = RandomBoxes<T>(num);
+        for (auto _ : state) {
+            size_t num_pairs = 0;
+            for (size_t i = 0; i < num; ++i) {
+                for (size_t j = i + 1; j < num; ++j) {
+                    num_pairs += boxes[i].intersects(boxes[j]) ? 1 : 0;
+                }
+            }
+            ::benchmark::DoNotOptimize(num_pairs);
+        }
+        SetBatchCounters(state, static_cast<int64_t>(num));
+    });
+
+    // One overlap query per box of the array
+    reg("geometry/BVH::queryOverlaps", [](::benchmark::State& state) {
+        const auto num = static_cast<size_t>(state.range(0));
+        const auto boxes = RandomBoxes<T>(num);
+        const auto queries = RandomBoxes<T>(num);
+        BVH<T> bvh(boxes.data(), num);
+        for (auto _ : state) {
+            size_t num_hits = 0;
+            for (const auto& query : queries) {
+                bvh.queryOverlaps(query, [&num_hits](size_t) { ++num_hits; });
+            }
+            ::benchmark::DoNotOptimize(num_hits);
+        }
+        SetBatchCounters(state, static_cast<int64_t>(num));
+    });
+    reg("geometry/BVH::queryOverlaps/brute-force",
+        [](::benchmark::State& state) {
+            const auto num = static_cast<size_t>(state.range(0));
+            const auto boxes = RandomBoxes<T>(num);
+            const auto queries = RandomBoxes<T>(num);
+            for (auto _ : state) {
+                size_t num_hits = 0;
+                for (const auto& query : queries) {
+                    for (const auto& box : boxes) {
+                        num_hits += query.intersects(box) ? 1 : 0;
+                    }
+                }
+                ::benchmark::DoNotOptimize(num_hits);
+            }
+            SetBatchCounters(state, static_cast<int64_t>(num));
+        });
+
+    // One ray per box of the array, from a random point in a random direction
+    reg("geometry/BVH::closestHit", [](::benchmark::State& state) {
+        const auto num = static_cast<size_t>(state.range(0));
+        const auto boxes = RandomBoxes<T>(num);
+        const auto origins = RandomArray<T>(3 * num);
+        const auto directions = RandomArray<T>(3 * num);
+        BVH<T> bvh(boxes.data(), num);
+        for (auto _ : state) {
+            T total = 0;
+            for (size_t i = 0; i < 3 * num; i += 3) {
+                const auto hit = bvh.closestHit(
+                    {origins[i], origins[i + 1], origins[i + 2]},
+                    {directions[i], directions[i + 1], directions[i + 2]});
+                total += hit.second;
+            }
+            ::benchmark::DoNotOptimize(total);
+        }
+        SetBatchCounters(state, static_cast<int64_t>(num));
+    });
+
+    // One ray against packets of 8 boxes (the nodes of an 8-wide BVH), with
+    // the dispatched kernel and with one Ray::intersect call per box
+    reg("geometry/intersect/AABBPacket8", [](::benchmark::State& state) {
+        const auto num = static_cast<size_t>(state.range(0));
+        const auto boxes = RandomBoxes<T>(num);
+        std::vector<AABBPacket<T, 8>> packets(num / 8);
+        for (size_t i = 0; i < packets.size() * 8; ++i) {
+            packets[i / 8].set(i % 8, boxes[i]);
+        }
+        const Ray<T> ray({0.0, 0.0, 0.0}, {1.0, 1.0, 1.0});
+        for (auto _ : state) {
+            uint32_t num_hits = 0;
+            T t_hits[8];
+            for (const auto& packet : packets) {
+                num_hits += (::math::intersect(ray, packet, t_hits) != 0U);
+            }
+            ::benchmark::DoNotOptimize(num_hits);
+        }
+        SetBatchCounters(state, static_cast<int64_t>(num));
+    });
+    reg("geometry/intersect/AABBPacket8/scalar", [](::benchmark::State& state) {
+        const auto num = static_cast<size_t>(state.range(0));
+        const auto boxes = RandomBoxes<T>(num);
+        const Ray<T> ray({0.0, 0.0, 0.0}, {1.0, 1.0, 1.0});
+        const auto inf = std::numeric_limits<T>::infinity();
+        for (auto _ : state) {
+            uint32_t num_hits = 0;
+            for (size_t i = 0; i + 8 <= num; i += 8) {
+                uint32_t mask = 0;
+                for (size_t k = 0; k < 8; ++k) {
+                    mask |= static_cast<uint32_t>(ray.intersect(boxes[i + k]) <
+                                                  inf)
+                            << k;
+                }
+                num_hits += (mask != 0U);
+            }
+            ::benchmark::DoNotOptimize(num_hits);
+        }
+        SetBatchCounters(state, static_cast<int64_t>(num));
+    });
+}
+
+/// Registers the benchmarks of the spatial hash grid, with a cell size equal
+/// to the radius of the queries
+template <typename T>
+auto RegisterSpatialHashGrid(const std::string& dtype) -> void {
+    auto reg = [&dtype](const std::string& name,
+                        void (*body)(::benchmark::State&)) {
+        ::benchmark::RegisterBenchmark((name + "/" + dtype).c_str(), body)
+            ->Apply(PointSizes);
+    };
+
+    reg("geometry/SpatialHashGrid::build", [](::benchmark::State& state) {
+        const auto num = static_cast<size_t>(state.range(0));
+        const auto points = RandomPoints<T>(num);
+        SpatialHashGrid<T> grid;
+        for (auto _ : state) {
+            grid.build(points.data(), num, 1.0);
+            ::benchmark::DoNotOptimize(grid.indices().data());
+        }
+        SetBatchCounters(state, static_cast<int64_t>(num));
+    });
+    reg("geometry/SpatialHashGrid::build/threaded",
+        [](::benchmark::State& state) {
+            const auto num = static_cast<size_t>(state.range(0));
+            const auto points = RandomPoints<T>(num);
+            const parallel::ScopedNumThreads guard(0);
+            SpatialHashGrid<T> grid;
+            for (auto _ : state) {
+                grid.build(points.data(), num, 1.0);
+                ::benchmark::DoNotOptimize(grid.indices().data());
+            }
+            SetBatchCounters(state, static_cast<int64_t>(num));
+        });
+
+    // One radius query and one 8-nearest query per point of the grid
+    reg("geometry/SpatialHashGrid::queryRadius", [](::benchmark::State& state) {
+        const auto num = static_cast<size_t>(state.range(0));
+        const auto points = RandomPoints<T>(num);
+        const SpatialHashGrid<T> grid(points, 1.0);
+        for (auto _ : state) {
+            size_t num_hits = 0;
+            for (const auto& point : points) {
+                grid.queryRadius(point, 1.0,
+                                 [&num_hits](size_t, T) { ++num_hits; });
+            }
+            ::benchmark::DoNotOptimize(num_hits);
+        }
+        SetBatchCounters(state, static_cast<int64_t>(num));
+    });
+    reg("geometry/SpatialHashGrid::queryKNearest",
+        [](::benchmark::State& state) {
+            const auto num = static_cast<size_t>(state.range(0));
+            const auto points = RandomPoints<T>(num);
+            const SpatialHashGrid<T> grid(points, 1.0);
+            for (auto _ : state) {
+                size_t total = 0;
+                for (const auto& point : points) {
+                    total += grid.queryKNearest(point, 8).back();
+                }
+                ::benchmark::DoNotOptimize(total);
+            }
+            SetBatchCounters(state, static_cast<int64_t>(num));
+        });
+
+    // All pairs of points within the radius
+    reg("geometry/SpatialHashGrid::queryPairs", [](::benchmark::State& state) {
+        const auto num = static_cast<size_t>(state.range(0));
+        const auto points = RandomPoints<T>(num);
+        const SpatialHashGrid<T> grid(points, 1.0);
+        for (auto _ : state) {
+            size_t num_pairs = 0;
+            grid.queryPairs(1.0, [&num_pairs](size_t, size_t) { ++num_pairs; });
+            ::benchmark::DoNotOptimize(num_pairs);
+        }
+        SetBatchCounters(state, static_cast<int64_t>(num));
+    });
+}
+
+auto RegisterGeometry() -> void {
+    RegisterBVH<float32_t>("f32");
+    RegisterBVH<float64_t>("f64");
+    RegisterSpatialHashGrid<float32_t>("f32");
+    RegisterSpatialHashGrid<float64_t>("f64");
+}
+
+}  // namespace bench
+}  // namespace math
@@ -0,0 +1,57 @@
+#include "./bench_common.hpp"
+
+namespace {
+
+/// Returns the kernel-set used by the single-object operators
+auto CompiledSimd() -> std::string {
+#if defined(MATH3D_AVX512_ENABLED)
+    std::string simd = "avx512";
+#elif defined(MATH3D_AVX_ENABLED)
+    std::string simd = "avx";
+#elif defined(MATH3D_SSE_ENABLED)
+    std::string simd = "sse";
+#else
+    std::string simd = "scalar";
+#endif
+#if defined(MATH3D_FMA_ENABLED)
+    simd += "+fma";
+#endif
+    return simd;
+}
+
+/// Returns the kernel-sets the batch entry points can dispatch to
+auto SupportedIsas() -> std::string {
+    std::string isas;
+    for (const auto isa : ::math::dispatch::GetSupportedIsas()) {
+        isas += (isas.empty() ? "" : ",") + ::math::dispatch::ToString(isa);
+    }
+    return isas;
+}
+
+}  // namespace
+
+// Same as BENCHMARK_MAIN(), but registers our benchmarks first, and adds the
+// configuration of the build to the context (e.g. in the JSON output), so the
+// results of different builds and machines can be told apart
+auto main(int argc, char** argv) -> int {
+    ::math::bench::RegisterVectorKernels();
+    ::math::bench::RegisterQuaternionKernels();
+    ::math::bench::RegisterMatrixKernels();
+    ::math::bench::RegisterBatchKernels();
+    ::math::bench::RegisterOperators();
+    ::math::bench::RegisterGeometry();
+
+    ::benchmark::AddCustomContext("math3d_simd", CompiledSimd());
+    ::benchmark::AddCustomContext("math3d_supported_isas", SupportedIsas());
+    ::benchmark::AddCustomContext(
+        "math3d_active_isa",
+        ::math::dispatch::ToString(::math::dispatch::GetActiveIsa()));
+
+    ::benchmark::Initialize(&argc, argv);
+    if (::benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+    ::benchmark::RunSpecifiedBenchmarks();
+    ::benchmark::Shutdown();
+    return 0;
+}
@@ -0,0 +1,145 @@
+#include "./bench_common.hpp"
+
+namespace math {
+namespace bench {
+
+auto RegisterMatrixKernels() -> void {
+    // -------------------------------------------------------------------------
+    // Matrix2 kernels
+    MATH3D_BENCH_KERNEL(BenchInPlace, scalar, kernel_transpose_inplace_mat2);
+    MATH3D_BENCH_KERNEL(BenchReduce, scalar, kernel_trace_mat2);
+    MATH3D_BENCH_KERNEL(BenchReduce, scalar, kernel_determinant_mat2);
+    MATH3D_BENCH_KERNEL(BenchUnary, scalar, kernel_inverse_mat2);
+    MATH3D_BENCH_KERNEL(BenchBinary, scalar, kernel_add_mat2);
+    MATH3D_BENCH_KERNEL(BenchBinary, scalar, kernel_sub_mat2);
+    MATH3D_BENCH_KERNEL(BenchScale, scalar, kernel_scale_mat2);
+    MATH3D_BENCH_KERNEL(BenchBinary, scalar, kernel_matmul_mat2);
+    MATH3D_BENCH_KERNEL(BenchBinary, scalar, kernel_matmul_vec_mat2);
+    MATH3D_BENCH_KERNEL(BenchBinary, scalar, kernel_hadamard_mat2);
+    MATH3D_BENCH_KERNEL(BenchReduceBinary, scalar, kernel_compare_eq_mat2);
+#if defined(MATH3D_SSE_ENABLED)
+    MATH3D_BENCH_KERNEL(BenchBinary, sse, kernel_add_mat2);
+    MATH3D_BENCH_KERNEL(BenchBinary, sse, kernel_sub_mat2);
+    MATH3D_BENCH_KERNEL(BenchScale, sse, kernel_scale_mat2);
+    MATH3D_BENCH_KERNEL(BenchBinary, sse, kernel_matmul_mat2);
+    MATH3D_BENCH_KERNEL(BenchBinary, sse, kernel_matmul_vec_mat2);
+    MATH3D_BENCH_KERNEL(BenchBinary, sse, kernel_hadamard_mat2);
+#endif
+#if defined(MATH3D_AVX_ENABLED)
+    MATH3D_BENCH_KERNEL(BenchBinary, avx, kernel_add_mat2);
+    MATH3D_BENCH_KERNEL(BenchBinary, avx, kernel_sub_mat2);
+    MATH3D_BENCH_KERNEL(BenchScale, avx, kernel_scale_mat2);
+    MATH3D_BENCH_KERNEL(BenchBinary, avx, kernel_matmul_mat2);
+    MATH3D_BENCH_KERNEL(BenchBinary, avx, kernel_matmul_vec_mat2);
+    MATH3D_BENCH_KERNEL(BenchBinary, avx, kernel_hadamard_mat2);
+#endif
+#if defined(MATH3D_FMA_ENABLED)
+    MATH3D_BENCH_KERNEL(BenchBinary, fma3, kernel_matmul_mat2);
+    MATH3D_BENCH_KERNEL(BenchBinary, fma3, kernel_matmul_vec_mat2);
+    MATH3D_BENCH_LATENCY(avx, kernel_matmul_mat2);
+    MATH3D_BENCH_LATENCY(avx, kernel_matmul_vec_mat2);
+    MATH3D_BENCH_LATENCY(fma3, kernel_matmul_mat2);
+    MATH3D_BENCH_LATENCY(fma3, kernel_matmul_vec_mat2);
+#endif
+
+    // -------------------------------------------------------------------------
+    // Matrix3 kernels
+    MATH3D_BENCH_KERNEL(BenchInPlace, scalar, kernel_transpose_inplace_mat3);
+    MATH3D_BENCH_KERNEL(BenchReduce, scalar, kernel_trace_mat3);
+    MATH3D_BENCH_KERNEL(BenchReduce, scalar, kernel_determinant_mat3);
+    MATH3D_BENCH_KERNEL(BenchUnary, scalar, kernel_inverse_mat3);
+    MATH3D_BENCH_KERNEL(BenchBinary, scalar, kernel_add_mat3);
+    MATH3D_BENCH_KERNEL(BenchBinary, scalar, kernel_sub_mat3);
+    MATH3D_BENCH_KERNEL(BenchScale, scalar, kernel_scale_mat3);
+    MATH3D_BENCH_KERNEL(BenchBinary, scalar, kernel_matmul_mat3);
+    MATH3D_BENCH_KERNEL(BenchBinary, scalar, kernel_matmul_vec_mat3);
+    MATH3D_BENCH_KERNEL(BenchBinary, scalar, kernel_hadamard_mat3);
+    MATH3D_BENCH_KERNEL(BenchReduceBinary, scalar, kernel_compare_eq_mat3);
+#if defined(MATH3D_SSE_ENABLED)
+    MATH3D_BENCH_KERNEL(BenchBinary, sse, kernel_add_mat3);
+    MATH3D_BENCH_KERNEL(BenchBinary, sse, kernel_sub_mat3);
+    MATH3D_BENCH_KERNEL(BenchScale, sse, kernel_scale_mat3);
+    MATH3D_BENCH_KERNEL(BenchBinary, sse, kernel_matmul_mat3);
+    MATH3D_BENCH_KERNEL(BenchBinary, sse, kernel_matmul_vec_mat3);
+    MATH3D_BENCH_KERNEL(BenchBinary, sse, kernel_hadamard_mat3);
+#endif
+#if defined(MATH3D_AVX_ENABLED)
+    MATH3D_BENCH_KERNEL(BenchBinary, avx, kernel_add_mat3);
+    MATH3D_BENCH_KERNEL(BenchBinary, avx, kernel_sub_mat3);
+    MATH3D_BENCH_KERNEL(BenchScale, avx, kernel_scale_mat3);
+    MATH3D_BENCH_KERNEL(BenchBinary, avx, kernel_matmul_mat3);
+    MATH3D_BENCH_KERNEL(BenchBinary, avx, kernel_matmul_vec_mat3);
+    MATH3D_BENCH_KERNEL(BenchBinary, avx, kernel_hadamard_mat3);
+#endif
+#if defined(MATH3D_FMA_ENABLED)
+    MATH3D_BENCH_KERNEL(BenchBinary, fma3, kernel_matmul_mat3);
+    MATH3D_BENCH_KERNEL(BenchBinary, fma3, kernel_matmul_vec_mat3);
+    MATH3D_BENCH_LATENCY(avx, kernel_matmul_mat3);
+    MATH3D_BENCH_LATENCY(avx, kernel_matmul_vec_mat3);
+    MATH3D_BENCH_LATENCY(fma3, kernel_matmul_mat3);
+    MATH3D_BENCH_LATENCY(fma3, kernel_matmul_vec_mat3);
+#endif
+
+    // -------------------------------------------------------------------------
+    // Matrix4 kernels
+    MATH3D_BENCH_KERNEL(BenchInPlace, scalar, kernel_transpose_inplace_mat4);
+    MATH3D_BENCH_KERNEL(BenchReduce, scalar, kernel_trace_mat4);
+    MATH3D_BENCH_KERNEL(BenchReduce, scalar, kernel_determinant_mat4);
+    MATH3D_BENCH_KERNEL(BenchUnary, scalar, kernel_inverse_mat4);
+    MATH3D_BENCH_KERNEL(BenchPredicate, scalar, kernel_is_affine_mat4);
+    MATH3D_BENCH_KERNEL(BenchPredicate, scalar, kernel_is_rigid_mat4);
+    MATH3D_BENCH_KERNEL(BenchUnary, scalar, kernel_inverse_rigid_mat4);
+    MATH3D_BENCH_KERNEL(BenchUnary, scalar, kernel_inverse_affine_mat4);
+    MATH3D_BENCH_KERNEL(BenchBinary, scalar, kernel_add_mat4);
+    MATH3D_BENCH_KERNEL(BenchBinary, scalar, kernel_sub_mat4);
+    MATH3D_BENCH_KERNEL(BenchScale, scalar, kernel_scale_mat4);
+    MATH3D_BENCH_KERNEL(BenchBinary, scalar, kernel_matmul_mat4);
+    MATH3D_BENCH_KERNEL(BenchBinary, scalar, kernel_matmul_vec_mat4);
+    MATH3D_BENCH_KERNEL(BenchBinary, scalar, kernel_hadamard_mat4);
+    MATH3D_BENCH_KERNEL(BenchReduceBinary, scalar, kernel_compare_eq_mat4);
+#if defined(MATH3D_SSE_ENABLED)
+    MATH3D_BENCH_KERNEL(BenchInPlace, sse, kernel_transpose_inplace_mat4);
+    MATH3D_BENCH_KERNEL(BenchReduce, sse, kernel_determinant_mat4);
+    MATH3D_BENCH_KERNEL(BenchUnary, sse, kernel_inverse_mat4);
+    MATH3D_BENCH_KERNEL(BenchUnary, sse, kernel_inverse_rigid_mat4);
+    MATH3D_BENCH_KERNEL(BenchUnary, sse, kernel_inverse_affine_mat4);
+    MATH3D_BENCH_KERNEL(BenchBinary, sse, kernel_add_mat4);
+    MATH3D_BENCH_KERNEL(BenchBinary, sse, kernel_sub_mat4);
+    MATH3D_BENCH_KERNEL(BenchScale, sse, kernel_scale_mat4);
+    MATH3D_BENCH_KERNEL(BenchBinary, sse, kernel_matmul_mat4);
+    MATH3D_BENCH_KERNEL(BenchBinary, sse, kernel_matmul_vec_mat4);
+    MATH3D_BENCH_KERNEL(BenchBinary, sse, kernel_hadamard_mat4);
+#endif
+#if defined(MATH3D_AVX_ENABLED)
+    MATH3D_BENCH_KERNEL(BenchInPlace, avx, kernel_transpose_inplace_mat4);
+    MATH3D_BENCH_KERNEL(BenchReduce, avx, kernel_determinant_mat4);
+    MATH3D_BENCH_KERNEL(BenchUnary, avx, kernel_inverse_mat4);
+    MATH3D_BENCH_KERNEL(BenchUnary, avx, kernel_inverse_rigid_mat4);
+    MATH3D_BENCH_KERNEL(BenchUnary, avx, kernel_inverse_affine_mat4);
+    MATH3D_BENCH_KERNEL(BenchBinary, avx, kernel_add_mat4);
+    MATH3D_BENCH_KERNEL(BenchBinary, avx, kernel_sub_mat4);
+    MATH3D_BENCH_KERNEL(BenchScale, avx, kernel_scale_mat4);
+    MATH3D_BENCH_KERNEL(BenchBinary, avx, kernel_matmul_mat4);
+    MATH3D_BENCH_KERNEL(BenchBinary, avx, kernel_matmul_vec_mat4);
+    MATH3D_BENCH_KERNEL(BenchBinary, avx, kernel_hadamard_mat4);
+#endif
+#if defined(MATH3D_AVX512_ENABLED)
+    MATH3D_BENCH_KERNEL(BenchBinary, avx512, kernel_add_mat4);
+    MATH3D_BENCH_KERNEL(BenchBinary, avx512, kernel_sub_mat4);
+    MATH3D_BENCH_KERNEL(BenchScale, avx512, kernel_scale_mat4);
+    MATH3D_BENCH_KERNEL(BenchBinary, avx512, kernel_matmul_mat4);
+    MATH3D_BENCH_KERNEL(BenchBinary, avx512, kernel_matmul_vec_mat4);
+    MATH3D_BENCH_KERNEL(BenchBinary, avx512, kernel_hadamard_mat4);
+#endif
+#if defined(MATH3D_FMA_ENABLED)
+    MATH3D_BENCH_KERNEL(BenchBinary, fma3, kernel_matmul_mat4);
+    MATH3D_BENCH_KERNEL(BenchBinary, fma3, kernel_matmul_vec_mat4);
+    MATH3D_BENCH_LATENCY(avx, kernel_matmul_mat4);
+    MATH3D_BENCH_LATENCY(avx, kernel_matmul_vec_mat4);
+    MATH3D_BENCH_LATENCY(fma3, kernel_matmul_mat4);
+    MATH3D_BENCH_LATENCY(fma3, kernel_matmul_vec_mat4);
+#endif
+}
+
+}  // namespace bench
+}  // namespace math
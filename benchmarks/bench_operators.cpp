@@ -0,0 +1,260 @@
+#include <math/transform_tree_t.hpp>
+
+#include "./bench_common.hpp"
+
+namespace math {
+namespace bench {
+
+/// Returns an object (vector, matrix, ...) with random entries
+template <typename Type>
+auto RandomObject() -> Type {
+    Type object;
+    FillRandom<typename Type::ElementType>(object.elements());
+    return object;
+}
+
+/// Benchmarks a single call to `op` (a binary operator), e.g. Vector3 + Vector3
+template <typename Lhs, typename Rhs, typename Op>
+auto BenchOperator(::benchmark::State& state, Lhs lhs, Rhs rhs, Op op)
+    -> void {
+    ::benchmark::DoNotOptimize(&lhs);
+    ::benchmark::DoNotOptimize(&rhs);
+    for (auto _ : state) {
+        auto result = op(lhs, rhs);
+        ::benchmark::DoNotOptimize(result);
+        ::benchmark::ClobberMemory();
+    }
+}
+
+/// Builds a tree whose levels are 1, 8, 64, ... nodes wide, up to `num` nodes
+template <typename T>
+auto BuildTransformTree(size_t num) -> TransformTree<T> {
+    constexpr size_t BRANCHING = 8;
+    TransformTree<T> tree;
+    tree.addNode(TransformTree<T>::NO_PARENT, RandomPose<T>());
+    for (size_t i = 1; i < num; ++i) {
+        const auto parent = static_cast<int32_t>((i - 1) / BRANCHING);
+        tree.addNode(parent, RandomPose<T>());
+    }
+    return tree;
+}
+
+/// Registers the benchmarks of the single-object operators, which use the
+/// kernel-set selected at compile time (see the "simd" context entry)
+template <typename T>
+auto RegisterSingleObjectOperators(const std::string& dtype) -> void {
+    using Vec3 = Vector3<T>;
+    using Vec4 = Vector4<T>;
+    using Quat = Quaternion<T>;
+    using Mat3 = Matrix3<T>;
+    using Mat4 = Matrix4<T>;
+    using Pose = Pose3d<T>;
+
+    auto reg = [&dtype](const std::string& name,
+                        void (*body)(::benchmark::State&)) {
+        ::benchmark::RegisterBenchmark((name + "/" + dtype).c_str(), body);
+    };
+
+    // -------------------------------------------------------------------------
+    reg("vec3/operator+", [](::benchmark::State& state) {
+        BenchOperator(state, RandomObject<Vec3>(), RandomObject<Vec3>(),
+                      [](const Vec3& a, const Vec3& b) { return a + b; });
+    });
+    reg("vec3/dot", [](::benchmark::State& state) {
+        BenchOperator(state, RandomObject<Vec3>(), RandomObject<Vec3>(),
+                      [](const Vec3& a, const Vec3& b) { return dot(a, b); });
+    });
+    reg("vec3/cross", [](::benchmark::State& state) {
+        BenchOperator(state, RandomObject<Vec3>(), RandomObject<Vec3>(),
+                      [](const Vec3& a, const Vec3& b) { return cross(a, b); });
+    });
+    reg("vec3/normalize", [](::benchmark::State& state) {
+        BenchOperator(state, RandomObject<Vec3>(), 0,
+                      [](const Vec3& a, int) { return normalize(a); });
+    });
+    reg("vec4/operator+", [](::benchmark::State& state) {
+        BenchOperator(state, RandomObject<Vec4>(), RandomObject<Vec4>(),
+                      [](const Vec4& a, const Vec4& b) { return a + b; });
+    });
+    reg("vec4/dot", [](::benchmark::State& state) {
+        BenchOperator(state, RandomObject<Vec4>(), RandomObject<Vec4>(),
+                      [](const Vec4& a, const Vec4& b) { return dot(a, b); });
+    });
+
+    // -------------------------------------------------------------------------
+    reg("quat/operator*", [](::benchmark::State& state) {
+        BenchOperator(state, RandomRotation<T>(), RandomRotation<T>(),
+                      [](const Quat& a, const Quat& b) { return a * b; });
+    });
+    reg("quat/rotate", [](::benchmark::State& state) {
+        BenchOperator(state, RandomRotation<T>(), RandomObject<Vec3>(),
+                      [](const Quat& q, const Vec3& v) {
+                          return rotate(q, v);
+                      });
+    });
+
+    // -------------------------------------------------------------------------
+    reg("mat3/operator*", [](::benchmark::State& state) {
+        BenchOperator(state, RandomObject<Mat3>(), RandomObject<Mat3>(),
+                      [](const Mat3& a, const Mat3& b) { return a * b; });
+    });
+    reg("mat3/operator*vec", [](::benchmark::State& state) {
+        BenchOperator(state, RandomObject<Mat3>(), RandomObject<Vec3>(),
+                      [](const Mat3& m, const Vec3& v) { return m * v; });
+    });
+    reg("mat3/inverse", [](::benchmark::State& state) {
+        BenchOperator(state, RandomObject<Mat3>(), 0,
+                      [](const Mat3& m, int) { return inverse(m); });
+    });
+    reg("mat4/operator*", [](::benchmark::State& state) {
+        BenchOperator(state, RandomObject<Mat4>(), RandomObject<Mat4>(),
+                      [](const Mat4& a, const Mat4& b) { return a * b; });
+    });
+    reg("mat4/operator*vec", [](::benchmark::State& state) {
+        BenchOperator(state, RandomObject<Mat4>(), RandomObject<Vec4>(),
+                      [](const Mat4& m, const Vec4& v) { return m * v; });
+    });
+    reg("mat4/transpose", [](::benchmark::State& state) {
+        BenchOperator(state, RandomObject<Mat4>(), 0,
+                      [](const Mat4& m, int) { return transpose(m); });
+    });
+    reg("mat4/determinant", [](::benchmark::State& state) {
+        BenchOperator(state, RandomObject<Mat4>(), 0,
+                      [](const Mat4& m, int) { return determinant(m); });
+    });
+    reg("mat4/inverse", [](::benchmark::State& state) {
+        BenchOperator(state, RandomObject<Mat4>(), 0,
+                      [](const Mat4& m, int) { return inverse(m); });
+    });
+    reg("mat4/inverseRigid", [](::benchmark::State& state) {
+        BenchOperator(state, RandomRigidTransform<T>(), 0,
+                      [](const Mat4& m, int) { return inverseRigid(m); });
+    });
+    reg("mat4/inverseAffine", [](::benchmark::State& state) {
+        BenchOperator(state, RandomRigidTransform<T>(), 0,
+                      [](const Mat4& m, int) { return inverseAffine(m); });
+    });
+
+    // -------------------------------------------------------------------------
+    reg("pose3d/operator*", [](::benchmark::State& state) {
+        BenchOperator(state, RandomPose<T>(), RandomPose<T>(),
+                      [](const Pose& a, const Pose& b) { return a * b; });
+    });
+    reg("pose3d/operator*vec", [](::benchmark::State& state) {
+        BenchOperator(state, RandomPose<T>(), RandomObject<Vec3>(),
+                      [](const Pose& p, const Vec3& v) { return p * v; });
+    });
+    reg("pose3d/inverse", [](::benchmark::State& state) {
+        BenchOperator(state, RandomPose<T>(), 0,
+                      [](const Pose& p, int) { return p.inverse(); });
+    });
+}
+
+/// Registers the benchmarks of the batch entry points, once for each
+/// kernel-set supported by the host CPU (selected via dispatch::ScopedIsa)
+template <typename T>
+auto RegisterBatchOperators(const std::string& dtype) -> void {
+    using Vec3 = Vector3<T>;
+    using Pose = Pose3d<T>;
+
+    using Body = void (*)(::benchmark::State&);
+    auto reg = [&dtype](const std::string& name, dispatch::Isa isa,
+                        Body body) {
+        const auto full_name =
+            name + "/" + dispatch::ToString(isa) + "/" + dtype;
+        ::benchmark::RegisterBenchmark(
+            full_name.c_str(),
+            [isa, body](::benchmark::State& state) {
+                dispatch::ScopedIsa guard(isa);
+                body(state);
+            })
+            ->Apply(BatchSizes);
+    };
+
+    for (const auto isa : dispatch::GetSupportedIsas()) {
+        reg("batch/transformPoints", isa, [](::benchmark::State& state) {
+            const auto num = static_cast<size_t>(state.range(0));
+            const auto transform = RandomRigidTransform<T>();
+            std::vector<Vec3> src(num);
+            std::vector<Vec3> dst(num);
+            for (auto& point : src) {
+                point = RandomObject<Vec3>();
+            }
+            for (auto _ : state) {
+                transformPoints(transform, src.data(), dst.data(), num);
+                ::benchmark::ClobberMemory();
+            }
+            SetBatchCounters(state, static_cast<int64_t>(num));
+        });
+        reg("batch/rotate", isa, [](::benchmark::State& state) {
+            const auto num = static_cast<size_t>(state.range(0));
+            const auto quat = RandomRotation<T>();
+            std::vector<Vec3> src(num);
+            std::vector<Vec3> dst(num);
+            for (auto& vec : src) {
+                vec = RandomObject<Vec3>();
+            }
+            for (auto _ : state) {
+                rotate(quat, src.data(), dst.data(), num);
+                ::benchmark::ClobberMemory();
+            }
+            SetBatchCounters(state, static_cast<int64_t>(num));
+        });
+        reg("batch/dot", isa, [](::benchmark::State& state) {
+            const auto num = static_cast<size_t>(state.range(0));
+            Vector3Batch<T> lhs(num);
+            Vector3Batch<T> rhs(num);
+            for (size_t i = 0; i < num; ++i) {
+                lhs.set(i, RandomObject<Vec3>());
+                rhs.set(i, RandomObject<Vec3>());
+            }
+            std::vector<T> dst(num);
+            for (auto _ : state) {
+                dot(lhs, rhs, dst.data());
+                ::benchmark::ClobberMemory();
+            }
+            SetBatchCounters(state, static_cast<int64_t>(num));
+        });
+        reg("batch/composePoses", isa, [](::benchmark::State& state) {
+            const auto num = static_cast<size_t>(state.range(0));
+            const auto lhs = RandomPoses<T>(num);
+            const auto rhs = RandomPoses<T>(num);
+            std::vector<Pose> dst(num);
+            for (auto _ : state) {
+                composePoses(lhs.data(), rhs.data(), dst.data(), num);
+                ::benchmark::ClobberMemory();
+            }
+            SetBatchCounters(state, static_cast<int64_t>(num));
+        });
+        reg("batch/invertPoses", isa, [](::benchmark::State& state) {
+            const auto num = static_cast<size_t>(state.range(0));
+            const auto src = RandomPoses<T>(num);
+            std::vector<Pose> dst(num);
+            for (auto _ : state) {
+                invertPoses(src.data(), dst.data(), num);
+                ::benchmark::ClobberMemory();
+            }
+            SetBatchCounters(state, static_cast<int64_t>(num));
+        });
+        reg("batch/TransformTree::update", isa, [](::benchmark::State& state) {
+            const auto num = static_cast<size_t>(state.range(0));
+            auto tree = BuildTransformTree<T>(num);
+            for (auto _ : state) {
+                tree.markAllDirty();
+                tree.update();
+                ::benchmark::ClobberMemory();
+            }
+            SetBatchCounters(state, static_cast<int64_t>(num));
+        });
+    }
+}
+
+auto RegisterOperators() -> void {
+    RegisterSingleObjectOperators<float32_t>("f32");
+    RegisterSingleObjectOperators<float64_t>("f64");
+    RegisterBatchOperators<float32_t>("f32");
+    RegisterBatchOperators<float64_t>("f64");
+}
+
+}  // namespace bench
+}  // namespace math
@@ -0,0 +1,39 @@
+#include "./bench_common.hpp"
+
+namespace math {
+namespace bench {
+
+auto RegisterQuaternionKernels() -> void {
+    MATH3D_BENCH_KERNEL(BenchBinary, scalar, kernel_add_quat);
+    MATH3D_BENCH_KERNEL(BenchBinary, scalar, kernel_sub_quat);
+    MATH3D_BENCH_KERNEL(BenchScale, scalar, kernel_scale_quat);
+    MATH3D_BENCH_KERNEL(BenchBinary, scalar, kernel_quatmul_quat);
+    MATH3D_BENCH_KERNEL(BenchBinary, scalar, kernel_rotate_vec3_quat);
+    MATH3D_BENCH_KERNEL(BenchReduce, scalar, kernel_length_square_quat);
+    MATH3D_BENCH_KERNEL(BenchInPlace, scalar, kernel_normalize_in_place_quat);
+    MATH3D_BENCH_KERNEL(BenchReduceBinary, scalar, kernel_compare_eq_quat);
+    MATH3D_BENCH_KERNEL(BenchUnary, scalar, kernel_rotation_mat4_quat);
+#if defined(MATH3D_SSE_ENABLED)
+    MATH3D_BENCH_KERNEL(BenchBinary, sse, kernel_add_quat);
+    MATH3D_BENCH_KERNEL(BenchBinary, sse, kernel_sub_quat);
+    MATH3D_BENCH_KERNEL(BenchScale, sse, kernel_scale_quat);
+    MATH3D_BENCH_KERNEL(BenchBinary, sse, kernel_quatmul_quat);
+    MATH3D_BENCH_KERNEL(BenchBinary, sse, kernel_rotate_vec3_quat);
+    MATH3D_BENCH_KERNEL(BenchReduce, sse, kernel_length_square_quat);
+    MATH3D_BENCH_KERNEL(BenchReduce, sse, kernel_length_quat);
+    MATH3D_BENCH_KERNEL(BenchInPlace, sse, kernel_normalize_in_place_quat);
+#endif
+#if defined(MATH3D_AVX_ENABLED)
+    MATH3D_BENCH_KERNEL(BenchBinary, avx, kernel_add_quat);
+    MATH3D_BENCH_KERNEL(BenchBinary, avx, kernel_sub_quat);
+    MATH3D_BENCH_KERNEL(BenchScale, avx, kernel_scale_quat);
+    MATH3D_BENCH_KERNEL(BenchBinary, avx, kernel_quatmul_quat);
+    MATH3D_BENCH_KERNEL(BenchBinary, avx, kernel_rotate_vec3_quat);
+    MATH3D_BENCH_KERNEL(BenchReduce, avx, kernel_length_square_quat);
+    MATH3D_BENCH_KERNEL(BenchReduce, avx, kernel_length_quat);
+    MATH3D_BENCH_KERNEL(BenchInPlace, avx, kernel_normalize_in_place_quat);
+#endif
+}
+
+}  // namespace bench
+}  // namespace math
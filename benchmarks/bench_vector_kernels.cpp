@@ -0,0 +1,111 @@
+#include "./bench_common.hpp"
+
+namespace math {
+namespace bench {
+
+auto RegisterVectorKernels() -> void {
+    // -------------------------------------------------------------------------
+    // Vector2 kernels
+    MATH3D_BENCH_KERNEL(BenchBinary, scalar, kernel_add_vec2);
+    MATH3D_BENCH_KERNEL(BenchBinary, scalar, kernel_sub_vec2);
+    MATH3D_BENCH_KERNEL(BenchScale, scalar, kernel_scale_vec2);
+    MATH3D_BENCH_KERNEL(BenchBinary, scalar, kernel_hadamard_vec2);
+    MATH3D_BENCH_KERNEL(BenchReduce, scalar, kernel_length_square_vec2);
+    MATH3D_BENCH_KERNEL(BenchInPlace, scalar, kernel_normalize_in_place_vec2);
+    MATH3D_BENCH_KERNEL(BenchReduceBinary, scalar, kernel_dot_vec2);
+    MATH3D_BENCH_KERNEL(BenchReduceBinary, scalar, kernel_compare_eq_vec2);
+    MATH3D_BENCH_KERNEL(BenchLerp, scalar, kernel_lerp_vec2);
+#if defined(MATH3D_SSE_ENABLED) || defined(MATH3D_AVX_ENABLED)
+    MATH3D_BENCH_KERNEL(BenchBinary, sse, kernel_add_vec2);
+    MATH3D_BENCH_KERNEL(BenchBinary, sse, kernel_sub_vec2);
+    MATH3D_BENCH_KERNEL(BenchScale, sse, kernel_scale_vec2);
+    MATH3D_BENCH_KERNEL(BenchBinary, sse, kernel_hadamard_vec2);
+    MATH3D_BENCH_KERNEL(BenchReduce, sse, kernel_length_square_vec2);
+    MATH3D_BENCH_KERNEL(BenchReduce, sse, kernel_length_vec2);
+    MATH3D_BENCH_KERNEL(BenchInPlace, sse, kernel_normalize_in_place_vec2);
+    MATH3D_BENCH_KERNEL(BenchReduceBinary, sse, kernel_dot_vec2);
+    MATH3D_BENCH_KERNEL(BenchLerp, sse, kernel_lerp_vec2);
+#endif
+
+    // -------------------------------------------------------------------------
+    // Vector3 kernels
+    MATH3D_BENCH_KERNEL(BenchBinary, scalar, kernel_add_vec3);
+    MATH3D_BENCH_KERNEL(BenchBinary, scalar, kernel_sub_vec3);
+    MATH3D_BENCH_KERNEL(BenchScale, scalar, kernel_scale_vec3);
+    MATH3D_BENCH_KERNEL(BenchBinary, scalar, kernel_hadamard_vec3);
+    MATH3D_BENCH_KERNEL(BenchReduce, scalar, kernel_length_square_vec3);
+    MATH3D_BENCH_KERNEL(BenchInPlace, scalar, kernel_normalize_in_place_vec3);
+    MATH3D_BENCH_KERNEL(BenchReduceBinary, scalar, kernel_dot_vec3);
+    MATH3D_BENCH_KERNEL(BenchReduceBinary, scalar, kernel_compare_eq_vec3);
+    MATH3D_BENCH_KERNEL(BenchBinary, scalar, kernel_cross_vec3);
+    MATH3D_BENCH_KERNEL(BenchLerp, scalar, kernel_lerp_vec3);
+#if defined(MATH3D_SSE_ENABLED)
+    MATH3D_BENCH_KERNEL(BenchBinary, sse, kernel_add_vec3);
+    MATH3D_BENCH_KERNEL(BenchBinary, sse, kernel_sub_vec3);
+    MATH3D_BENCH_KERNEL(BenchScale, sse, kernel_scale_vec3);
+    MATH3D_BENCH_KERNEL(BenchBinary, sse, kernel_hadamard_vec3);
+    MATH3D_BENCH_KERNEL(BenchReduce, sse, kernel_length_square_vec3);
+    MATH3D_BENCH_KERNEL(BenchReduce, sse, kernel_length_vec3);
+    MATH3D_BENCH_KERNEL(BenchInPlace, sse, kernel_normalize_in_place_vec3);
+    MATH3D_BENCH_KERNEL(BenchReduceBinary, sse, kernel_dot_vec3);
+    MATH3D_BENCH_KERNEL(BenchBinary, sse, kernel_cross_vec3);
+    MATH3D_BENCH_KERNEL(BenchLerp, sse, kernel_lerp_vec3);
+#endif
+#if defined(MATH3D_AVX_ENABLED)
+    MATH3D_BENCH_KERNEL(BenchBinary, avx, kernel_add_vec3);
+    MATH3D_BENCH_KERNEL(BenchBinary, avx, kernel_sub_vec3);
+    MATH3D_BENCH_KERNEL(BenchScale, avx, kernel_scale_vec3);
+    MATH3D_BENCH_KERNEL(BenchBinary, avx, kernel_hadamard_vec3);
+    MATH3D_BENCH_KERNEL(BenchReduce, avx, kernel_length_square_vec3);
+    MATH3D_BENCH_KERNEL(BenchReduce, avx, kernel_length_vec3);
+    MATH3D_BENCH_KERNEL(BenchInPlace, avx, kernel_normalize_in_place_vec3);
+    MATH3D_BENCH_KERNEL(BenchReduceBinary, avx, kernel_dot_vec3);
+    MATH3D_BENCH_KERNEL(BenchBinary, avx, kernel_cross_vec3);
+    MATH3D_BENCH_KERNEL(BenchLerp, avx, kernel_lerp_vec3);
+#endif
+#if defined(MATH3D_FMA_ENABLED)
+    MATH3D_BENCH_KERNEL(BenchReduceBinary, fma3, kernel_dot_vec3);
+    MATH3D_BENCH_KERNEL(BenchLerp, fma3, kernel_lerp_vec3);
+#endif
+
+    // -------------------------------------------------------------------------
+    // Vector4 kernels
+    MATH3D_BENCH_KERNEL(BenchBinary, scalar, kernel_add_vec4);
+    MATH3D_BENCH_KERNEL(BenchBinary, scalar, kernel_sub_vec4);
+    MATH3D_BENCH_KERNEL(BenchScale, scalar, kernel_scale_vec4);
+    MATH3D_BENCH_KERNEL(BenchBinary, scalar, kernel_hadamard_vec4);
+    MATH3D_BENCH_KERNEL(BenchReduce, scalar, kernel_length_square_vec4);
+    MATH3D_BENCH_KERNEL(BenchInPlace, scalar, kernel_normalize_in_place_vec4);
+    MATH3D_BENCH_KERNEL(BenchReduceBinary, scalar, kernel_dot_vec4);
+    MATH3D_BENCH_KERNEL(BenchReduceBinary, scalar, kernel_compare_eq_vec4);
+    MATH3D_BENCH_KERNEL(BenchLerp, scalar, kernel_lerp_vec4);
+#if defined(MATH3D_SSE_ENABLED)
+    MATH3D_BENCH_KERNEL(BenchBinary, sse, kernel_add_vec4);
+    MATH3D_BENCH_KERNEL(BenchBinary, sse, kernel_sub_vec4);
+    MATH3D_BENCH_KERNEL(BenchScale, sse, kernel_scale_vec4);
+    MATH3D_BENCH_KERNEL(BenchBinary, sse, kernel_hadamard_vec4);
+    MATH3D_BENCH_KERNEL(BenchReduce, sse, kernel_length_square_vec4);
+    MATH3D_BENCH_KERNEL(BenchReduce, sse, kernel_length_vec4);
+    MATH3D_BENCH_KERNEL(BenchInPlace, sse, kernel_normalize_in_place_vec4);
+    MATH3D_BENCH_KERNEL(BenchReduceBinary, sse, kernel_dot_vec4);
+    MATH3D_BENCH_KERNEL(BenchLerp, sse, kernel_lerp_vec4);
+#endif
+#if defined(MATH3D_AVX_ENABLED)
+    MATH3D_BENCH_KERNEL(BenchBinary, avx, kernel_add_vec4);
+    MATH3D_BENCH_KERNEL(BenchBinary, avx, kernel_sub_vec4);
+    MATH3D_BENCH_KERNEL(BenchScale, avx, kernel_scale_vec4);
+    MATH3D_BENCH_KERNEL(BenchBinary, avx, kernel_hadamard_vec4);
+    MATH3D_BENCH_KERNEL(BenchReduce, avx, kernel_length_square_vec4);
+    MATH3D_BENCH_KERNEL(BenchReduce, avx, kernel_length_vec4);
+    MATH3D_BENCH_KERNEL(BenchInPlace, avx, kernel_normalize_in_place_vec4);
+    MATH3D_BENCH_KERNEL(BenchReduceBinary, avx, kernel_dot_vec4);
+    MATH3D_BENCH_KERNEL(BenchLerp, avx, kernel_lerp_vec4);
+#endif
+#if defined(MATH3D_FMA_ENABLED)
+    MATH3D_BENCH_KERNEL(BenchReduceBinary, fma3, kernel_dot_vec4);
+    MATH3D_BENCH_KERNEL(BenchLerp, fma3, kernel_lerp_vec4);
+#endif
+}
+
+}  // namespace bench
+}  // namespace math
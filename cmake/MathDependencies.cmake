@@ -4,6 +4,7 @@
 # Dependencies:
 # * pybind11
 # * catch2
+# * benchmark (only if MATH3D_BUILD_BENCHMARKS is enabled)
 #
 # - Based on the superbuild script by jeffamstutz for ospray
 #   https://github.com/jeffamstutz/superbuild_ospray/blob/main/macros.cmake
@@ -19,8 +20,13 @@ set(MATH3D_DEP_VERSION_pybind11
     a2e59f0e7065404b44dfe92a28aca47ba1378dc4 # Release v2.13.6
     CACHE STRING "Version of PyBind11 to be fetched (used for python bindings)")
 
+set(MATH3D_DEP_VERSION_benchmark
+    344117638c8ff7e239044fd0fa7085839fc03021 # Release v1.8.3
+    CACHE STRING "Version of Google Benchmark to be fetched (for benchmarks)")
+
 mark_as_advanced(MATH3D_DEP_VERSION_catch2)
 mark_as_advanced(MATH3D_DEP_VERSION_pybind11)
+mark_as_advanced(MATH3D_DEP_VERSION_benchmark)
 
 # cmake-format: off
 # ------------------------------------------------------------------------------
@@ -66,4 +72,25 @@ loco_find_or_fetch_dependency(
   TARGETS pybind11::headers
   EXCLUDE_FROM_ALL)
 
+# ------------------------------------------------------------------------------
+# Google Benchmark is used for the performance measurements of our kernels
+# ------------------------------------------------------------------------------
+
+if (MATH3D_BUILD_BENCHMARKS)
+  set(BENCHMARK_ENABLE_TESTING OFF CACHE BOOL "" FORCE)
+  set(BENCHMARK_ENABLE_GTEST_TESTS OFF CACHE BOOL "" FORCE)
+  set(BENCHMARK_ENABLE_INSTALL OFF CACHE BOOL "" FORCE)
+
+  loco_find_or_fetch_dependency(
+    USE_SYSTEM_PACKAGE FALSE
+    PACKAGE_NAME benchmark
+    LIBRARY_NAME benchmark
+    GIT_REPO https://github.com/google/benchmark.git
+    GIT_TAG ${MATH3D_DEP_VERSION_benchmark}
+    GIT_PROGRESS FALSE
+    GIT_SHALLOW TRUE
+    TARGETS benchmark::benchmark
+    EXCLUDE_FROM_ALL)
+endif()
+
 # cmake-format: on
@@ -0,0 +1,116 @@
+#pragma once
+
+#include "./aabb_batch_t_decl.hpp"
+#include "./dispatch.hpp"
+
+#include "./impl/aabb_batch_t_scalar_impl.hpp"
+#include "./impl/aabb_batch_t_sse_impl.hpp"
+#include "./impl/aabb_batch_t_avx_impl.hpp"
+#include "./impl/aabb_batch_t_avx512_impl.hpp"
+
+namespace math {
+
+// ***************************************************************************//
+//                  AABBBatch helper functions and operators                  //
+// ***************************************************************************//
+
+/// \brief Computes the distance at which a ray enters each box of a batch
+///
+/// \tparam T Type of scalar used by the ray and the boxes
+///
+/// \param[in] ray The ray to test against the boxes
+/// \param[in] boxes The planes of the batch of boxes
+/// \param[in] num Number of boxes in the batch
+/// \param[out] dst Array where to store the entry distances (of size num), or
+///                 infinity for the boxes the ray misses (see Ray::intersect)
+/// \param[in] t_max Only entry distances in [0, t_max] are reported
+template <typename T>
+auto intersect(const Ray<T>& ray, AABBPlanes<const T> boxes, size_t num,
+               T* dst, T t_max = std::numeric_limits<T>::infinity())
+    -> void {
+    MATH3D_DISPATCH_KERNEL(kernel_ray_aabb_batch<T>, dst, ray, t_max, boxes,
+                           num);
+}
+
+/// \brief Computes the distance at which a ray enters each box of a batch
+///
+/// \param[in] ray The ray to test against the boxes
+/// \param[in] boxes The batch of boxes to test
+/// \param[out] dst Array where to store the results (of size boxes.size())
+/// \param[in] t_max Only entry distances in [0, t_max] are reported
+template <typename T>
+auto intersect(const Ray<T>& ray, const AABBBatch<T>& boxes, T* dst,
+               T t_max = std::numeric_limits<T>::infinity()) -> void {
+    intersect<T>(ray, boxes.planes(), boxes.size(), dst, t_max);
+}
+
+/// \brief Returns the distance at which a ray enters each box of a batch
+template <typename T>
+auto intersect(const Ray<T>& ray, const AABBBatch<T>& boxes,
+               T t_max = std::numeric_limits<T>::infinity())
+    -> std::vector<T> {
+    std::vector<T> dst(boxes.size());
+    intersect<T>(ray, boxes, dst.data(), t_max);
+    return dst;
+}
+
+/// \brief Tests a ray against all the boxes of a packet (e.g. a wide BVH node)
+///
+/// \tparam T Type of scalar used by the ray and the boxes
+/// \tparam N Number of boxes in the packet (4 or 8)
+///
+/// \param[in] ray The ray to test against the boxes
+/// \param[in] packet The packet of boxes to test
+/// \param[out] dst Array where to store the entry distance into each box (of
+///                 size N), or infinity for the boxes the ray misses
+/// \param[in] t_max Only entry distances in [0, t_max] are reported
+/// \return A mask with the bit i set if the ray hits the i-th box
+template <typename T, size_t N>
+auto intersect(const Ray<T>& ray, const AABBPacket<T, N>& packet, T* dst,
+               T t_max = std::numeric_limits<T>::infinity()) -> uint32_t {
+    intersect<T>(ray, packet.planes(), N, dst, t_max);
+    const auto inf = std::numeric_limits<T>::infinity();
+    uint32_t mask = 0;
+    for (size_t i = 0; i < N; ++i) {
+        mask |= static_cast<uint32_t>(dst[i] < inf) << i;
+    }
+    return mask;
+}
+
+/// \brief Prints the given batch of boxes to the given output stream
+template <typename T>
+auto operator<<(std::ostream& output_stream, const AABBBatch<T>& src)
+    -> std::ostream& {
+    output_stream << src.toString();
+    return output_stream;
+}
+
+// ***************************************************************************//
+//                           AABBBatch-type methods                           //
+// ***************************************************************************//
+
+template <typename T>
+auto AABBBatch<T>::resize(size_t size) -> void {
+    const size_t stride =
+        ((size + PLANE_PADDING - 1) / PLANE_PADDING) * PLANE_PADDING;
+    const size_t num_kept = std::min(size, m_Size);
+    if (stride != m_Stride) {
+        BufferType elements(NUM_PLANES * stride, static_cast<T>(0));
+        for (size_t plane = 0; plane < NUM_PLANES; ++plane) {
+            std::copy_n(m_Elements.data() + plane * m_Stride, num_kept,
+                        elements.data() + plane * stride);
+        }
+        m_Elements.swap(elements);
+        m_Stride = stride;
+    } else if (size < m_Size) {
+        // Keep the padding zeroed, in case the batch grows back later
+        for (size_t plane = 0; plane < NUM_PLANES; ++plane) {
+            std::fill(m_Elements.data() + plane * m_Stride + size,
+                      m_Elements.data() + plane * m_Stride + m_Size,
+                      static_cast<T>(0));
+        }
+    }
+    m_Size = size;
+}
+
+}  // namespace math
@@ -0,0 +1,303 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "./aligned_allocator.hpp"
+#include "./common.hpp"
+#include "./utils/geometry_helpers.hpp"
+
+namespace math {
+
+/// \struct AABBPlanes
+///
+/// \brief Non-owning view of a batch of axis-aligned boxes stored as SoA
+///
+/// \tparam T Type of scalar of the planes (use `const T` for read-only views)
+///
+/// This is what the box kernels operate on: six planes of scalars, with the
+/// i-th box given by (min_x[i], min_y[i], min_z[i]) - (max_x[i], max_y[i],
+/// max_z[i]).
+template <typename T>
+struct AABBPlanes {
+    /// Plane holding the lower x-boundaries of the batch
+    T* min_x = nullptr;
+    /// Plane holding the lower y-boundaries of the batch
+    T* min_y = nullptr;
+    /// Plane holding the lower z-boundaries of the batch
+    T* min_z = nullptr;
+    /// Plane holding the upper x-boundaries of the batch
+    T* max_x = nullptr;
+    /// Plane holding the upper y-boundaries of the batch
+    T* max_y = nullptr;
+    /// Plane holding the upper z-boundaries of the batch
+    T* max_z = nullptr;
+
+    /// Constructs an empty view
+    AABBPlanes() = default;
+
+    /// Constructs a view of the given planes
+    AABBPlanes(T* min_x_plane, T* min_y_plane, T* min_z_plane,
+               T* max_x_plane, T* max_y_plane, T* max_z_plane)
+        : min_x(min_x_plane),
+          min_y(min_y_plane),
+          min_z(min_z_plane),
+          max_x(max_x_plane),
+          max_y(max_y_plane),
+          max_z(max_z_plane) {}
+
+    /// Returns a view of the same planes, starting at the given index
+    auto offset(size_t index) const -> AABBPlanes<T> {
+        return {min_x + index, min_y + index, min_z + index,
+                max_x + index, max_y + index, max_z + index};
+    }
+
+    /// Converts a mutable view into a read-only one
+    // NOLINTNEXTLINE(google-explicit-constructor)
+    operator AABBPlanes<const T>() const {
+        return {min_x, min_y, min_z, max_x, max_y, max_z};
+    }
+};
+
+/// \class AABBBatch
+///
+/// \brief Batch of axis-aligned boxes stored as a structure of arrays (SoA)
+///
+/// \tparam T Type of scalar value used for the boxes (float|double)
+///
+/// Stores the boundaries of a batch of boxes in six separate planes, so the
+/// box kernels can test a ray against a full SIMD register of boxes at once
+/// (4 or 8 boxes per instruction, depending on the ISA selected at runtime,
+/// see dispatch.hpp). Each plane is aligned to a 64-byte boundary, and padded
+/// to a multiple of 64 bytes.
+template <typename T>
+class AABBBatch {
+ public:
+    /// Alignment (in bytes) of each one of the planes
+    static constexpr uint32_t ALIGNMENT = 64;
+    /// Each plane is padded to a multiple of this number of scalars
+    static constexpr uint32_t PLANE_PADDING = ALIGNMENT / sizeof(T);
+    /// Number of planes (boundaries) stored for each box
+    static constexpr uint32_t NUM_PLANES = 6;
+
+    // Some handy type aliases used throught the codebase
+    using Type = AABBBatch<T>;
+    using ElementType = T;
+    using BufferType = std::vector<T, AlignedAllocator<T, ALIGNMENT>>;
+
+    // Some related types
+    using Vec3 = Vector3<T>;
+    using Box = AABB<T>;
+
+    /// Constructs an empty batch
+    AABBBatch() = default;
+
+    /// Constructs a batch of the given size, with all boxes set to zero
+    explicit AABBBatch(size_t size) { resize(size); }
+
+    /// Constructs a batch by gathering the given array of boxes
+    explicit AABBBatch(const Box* boxes, size_t size) { fromAoS(boxes, size); }
+
+    /// Constructs a batch by gathering the given vector of boxes
+    explicit AABBBatch(const std::vector<Box>& boxes) {
+        fromAoS(boxes.data(), boxes.size());
+    }
+
+    /// Returns the number of boxes in the batch
+    auto size() const -> size_t { return m_Size; }
+
+    /// Returns whether or not the batch has no boxes
+    auto empty() const -> bool { return m_Size == 0; }
+
+    /// Returns the distance (in scalars) between the start of two planes
+    auto stride() const -> size_t { return m_Stride; }
+
+    /// Changes the number of boxes (keeps the existing ones, zero-fills new)
+    auto resize(size_t size) -> void;
+
+    /// Removes all boxes from the batch
+    auto clear() -> void { resize(0); }
+
+    /// Returns a mutable view of the planes, as used by the box kernels
+    auto planes() -> AABBPlanes<T> {
+        T* data = m_Elements.data();
+        return {data,
+                data + m_Stride,
+                data + 2 * m_Stride,
+                data + 3 * m_Stride,
+                data + 4 * m_Stride,
+                data + 5 * m_Stride};
+    }
+
+    /// Returns an unmutable view of the planes, as used by the box kernels
+    auto planes() const -> AABBPlanes<const T> {
+        const T* data = m_Elements.data();
+        return {data,
+                data + m_Stride,
+                data + 2 * m_Stride,
+                data + 3 * m_Stride,
+                data + 4 * m_Stride,
+                data + 5 * m_Stride};
+    }
+
+    /// Returns a mutable reference to the underlying storage of the batch
+    auto elements() -> BufferType& { return m_Elements; }
+
+    /// Returns an unmutable reference to the underlying storage of the batch
+    auto elements() const -> const BufferType& { return m_Elements; }
+
+    /// Returns a copy of the box at the given index
+    auto get(size_t index) const -> Box {
+        assert(index < m_Size);
+        const auto view = planes();
+        return Box(Vec3(view.min_x[index], view.min_y[index],
+                        view.min_z[index]),
+                   Vec3(view.max_x[index], view.max_y[index],
+                        view.max_z[index]));
+    }
+
+    /// Sets the box at the given index
+    auto set(size_t index, const Box& box) -> void {
+        assert(index < m_Size);
+        const auto view = planes();
+        view.min_x[index] = box.p_min.x();
+        view.min_y[index] = box.p_min.y();
+        view.min_z[index] = box.p_min.z();
+        view.max_x[index] = box.p_max.x();
+        view.max_y[index] = box.p_max.y();
+        view.max_z[index] = box.p_max.z();
+    }
+
+    /// Returns a copy of the box at the given index
+    auto operator[](size_t index) const -> Box { return get(index); }
+
+    /// Replaces the contents of the batch with the given array of boxes
+    auto fromAoS(const Box* boxes, size_t size) -> void {
+        resize(size);
+        for (size_t i = 0; i < size; ++i) {
+            set(i, boxes[i]);
+        }
+    }
+
+    /// Returns the boxes of the batch as an array of AABB
+    auto toVector() const -> std::vector<Box> {
+        std::vector<Box> boxes(m_Size);
+        for (size_t i = 0; i < m_Size; ++i) {
+            boxes[i] = get(i);
+        }
+        return boxes;
+    }
+
+    /// Returns a printable string-representation of the batch
+    MATH3D_NODISCARD auto toString() const -> std::string {
+        std::stringstream str_result;
+        if (std::is_same<ElementType, float>::value) {
+            str_result << "AABBBatchf(";
+        } else if (std::is_same<ElementType, double>::value) {
+            str_result << "AABBBatchd(";
+        } else {
+            str_result << "AABBBatchX(";
+        }
+        const auto view = planes();
+        for (size_t i = 0; i < m_Size; ++i) {
+            str_result << (i > 0 ? ", " : "") << "((" << view.min_x[i] << ", "
+                       << view.min_y[i] << ", " << view.min_z[i] << "), ("
+                       << view.max_x[i] << ", " << view.max_y[i] << ", "
+                       << view.max_z[i] << "))";
+        }
+        str_result << ")";
+        return str_result.str();
+    }
+
+ private:
+    /// Number of boxes in the batch
+    size_t m_Size = 0;
+    /// Number of scalars reserved for each plane (multiple of PLANE_PADDING)
+    size_t m_Stride = 0;
+    /// Storage for the six planes, back to back (min_x, ..., max_z)
+    BufferType m_Elements;
+};
+
+/// \struct AABBPacket
+///
+/// \brief Fixed group of N axis-aligned boxes stored as SoA
+///
+/// \tparam T Type of scalar value used for the boxes (float|double)
+/// \tparam N Number of boxes in the packet (4 or 8)
+///
+/// This is the layout of a node of a wide (4-ary or 8-ary) BVH: the bounds of
+/// all its children side by side, so a ray can be tested against all of them
+/// with a single call that returns a mask of the children it hits. The unused
+/// slots hold a box at infinity, which no ray can hit. An inverted box doesn't
+/// work here, as the slab test swaps the boundaries of each axis.
+template <typename T, size_t N>
+struct AABBPacket {
+    static_assert(N == 4 || N == 8, "AABBPacket only supports 4|8 boxes");
+
+    /// Number of boxes in the packet
+    static constexpr size_t SIZE = N;
+
+    // Some related types
+    using Vec3 = Vector3<T>;
+    using Box = AABB<T>;
+
+    /// Lower x-boundaries of the boxes
+    std::array<T, N> min_x;
+    /// Lower y-boundaries of the boxes
+    std::array<T, N> min_y;
+    /// Lower z-boundaries of the boxes
+    std::array<T, N> min_z;
+    /// Upper x-boundaries of the boxes
+    std::array<T, N> max_x;
+    /// Upper y-boundaries of the boxes
+    std::array<T, N> max_y;
+    /// Upper z-boundaries of the boxes
+    std::array<T, N> max_z;
+
+    /// Constructs a packet with all of its slots empty
+    AABBPacket() {
+        for (size_t slot = 0; slot < N; ++slot) {
+            clear(slot);
+        }
+    }
+
+    /// Sets the box at the given slot
+    auto set(size_t slot, const Box& box) -> void {
+        assert(slot < N);
+        min_x[slot] = box.p_min.x();
+        min_y[slot] = box.p_min.y();
+        min_z[slot] = box.p_min.z();
+        max_x[slot] = box.p_max.x();
+        max_y[slot] = box.p_max.y();
+        max_z[slot] = box.p_max.z();
+    }
+
+    /// Returns a copy of the box at the given slot
+    auto get(size_t slot) const -> Box {
+        assert(slot < N);
+        return Box(Vec3(min_x[slot], min_y[slot], min_z[slot]),
+                   Vec3(max_x[slot], max_y[slot], max_z[slot]));
+    }
+
+    /// Empties the given slot (its box is moved to infinity)
+    auto clear(size_t slot) -> void {
+        assert(slot < N);
+        const auto inf = std::numeric_limits<T>::infinity();
+        min_x[slot] = min_y[slot] = min_z[slot] = inf;
+        max_x[slot] = max_y[slot] = max_z[slot] = inf;
+    }
+
+    /// Returns an unmutable view of the planes, as used by the box kernels
+    auto planes() const -> AABBPlanes<const T> {
+        return {min_x.data(), min_y.data(), min_z.data(),
+                max_x.data(), max_y.data(), max_z.data()};
+    }
+};
+
+}  // namespace math
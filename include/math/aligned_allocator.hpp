@@ -0,0 +1,90 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <new>
+
+#if defined(_MSC_VER)
+#include <malloc.h>
+#endif
+
+namespace math {
+
+/// \class AlignedAllocator
+///
+/// \brief Minimal allocator that returns storage aligned to a given boundary
+///
+/// \tparam T Type of the elements to be allocated
+/// \tparam Alignment Alignment in bytes (power of 2, at least alignof(void*))
+///
+/// Used by the batch containers (e.g. Vector3Batch), so each of their planes
+/// starts at a cache-line boundary, and the SIMD kernels never split a
+/// register load across two cache lines.
+template <typename T, size_t Alignment>
+struct AlignedAllocator {
+    static_assert((Alignment & (Alignment - 1)) == 0,
+                  "Alignment must be a power of 2");
+    static_assert(Alignment >= alignof(void*),
+                  "Alignment must be at least the one of a pointer");
+
+    using value_type = T;
+
+    template <typename U>
+    struct rebind {
+        using other = AlignedAllocator<U, Alignment>;
+    };
+
+    AlignedAllocator() noexcept = default;
+
+    template <typename U>
+    // NOLINTNEXTLINE(google-explicit-constructor)
+    AlignedAllocator(const AlignedAllocator<U, Alignment>& /*other*/) noexcept {
+    }
+
+    /// Allocates storage for `count` elements, aligned to `Alignment` bytes
+    auto allocate(size_t count) -> T* {
+        if (count > std::numeric_limits<size_t>::max() / sizeof(T)) {
+            throw std::bad_alloc();
+        }
+        // Round the requested size up to a multiple of the alignment
+        const size_t num_bytes =
+            ((count * sizeof(T) + Alignment - 1) / Alignment) * Alignment;
+        void* ptr = nullptr;
+#if defined(_MSC_VER)
+        ptr = _aligned_malloc(num_bytes, Alignment);
+#else
+        if (posix_memalign(&ptr, Alignment, num_bytes) != 0) {
+            ptr = nullptr;
+        }
+#endif
+        if (ptr == nullptr) {
+            throw std::bad_alloc();
+        }
+        return static_cast<T*>(ptr);
+    }
+
+    /// Releases storage previously returned by `allocate`
+    auto deallocate(T* ptr, size_t /*count*/) noexcept -> void {
+#if defined(_MSC_VER)
+        _aligned_free(ptr);
+#else
+        free(ptr);  // NOLINT
+#endif
+    }
+};
+
+template <typename T, typename U, size_t Alignment>
+auto operator==(const AlignedAllocator<T, Alignment>& /*lhs*/,
+                const AlignedAllocator<U, Alignment>& /*rhs*/) -> bool {
+    return true;
+}
+
+template <typename T, typename U, size_t Alignment>
+auto operator!=(const AlignedAllocator<T, Alignment>& /*lhs*/,
+                const AlignedAllocator<U, Alignment>& /*rhs*/) -> bool {
+    return false;
+}
+
+}  // namespace math
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace math {
+
+// ***************************************************************************//
+//                  Bitmasks with the results of batch queries                //
+// ***************************************************************************//
+
+// The result of a query for the i-th element of a batch (e.g. whether it's
+// visible or overlaps a box) is stored as the bit (i % 64) of the word (i / 64)
+// of a bitmask, and the unused bits of its last word are left cleared.
+
+/// Returns the number of 64-bit words of a bitmask of the given number of bits
+inline auto bitmaskWords(size_t num) -> size_t {
+    return (num + 63) / 64;
+}
+
+/// Returns whether or not the given bit of a bitmask is set
+inline auto bitmaskTest(const uint64_t* bitmask, size_t index) -> bool {
+    return ((bitmask[index / 64] >> (index % 64)) & 1U) != 0;
+}
+
+/// \brief Writes the given bits into a bitmask, starting at the given index
+///
+/// The bits must not cross a word boundary. Each word is reset when its first
+/// bit is written, so the bitmask doesn't have to be cleared beforehand as
+/// long as it's written in order (this is what the batch kernels do).
+inline auto bitmaskWrite(uint64_t* bitmask, size_t index, uint64_t bits)
+    -> void {
+    const size_t word = index / 64;
+    const size_t shift = index % 64;
+    bitmask[word] = ((shift == 0) ? 0 : bitmask[word]) | (bits << shift);
+}
+
+/// Returns the index of the lowest bit set in the given (non-zero) word
+inline auto bitmaskLowestBit(uint64_t word) -> size_t {
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<size_t>(__builtin_ctzll(word));
+#elif defined(_MSC_VER) && defined(_M_X64)
+    unsigned long index = 0;  // NOLINT
+    _BitScanForward64(&index, word);
+    return static_cast<size_t>(index);
+#else
+    size_t index = 0;
+    while ((word & 1U) == 0) {
+        word >>= 1;
+        ++index;
+    }
+    return index;
+#endif
+}
+
+/// Returns the number of bits set in the first num bits of a bitmask
+inline auto bitmaskCount(const uint64_t* bitmask, size_t num) -> size_t {
+    size_t count = 0;
+    const size_t num_words = bitmaskWords(num);
+    for (size_t w = 0; w < num_words; ++w) {
+        // Clears the lowest bit set, once per bit (the words are mostly sparse)
+        for (uint64_t word = bitmask[w]; word != 0; word &= word - 1) {
+            ++count;
+        }
+    }
+    return count;
+}
+
+/// \brief Returns the indices of the bits set in the first num bits of a
+/// bitmask, in increasing order
+///
+/// Only the set bits are visited (a word at a time), so this is cheap for the
+/// sparse results of most queries, e.g. the few boxes overlapping another one.
+inline auto bitmaskToIndices(const uint64_t* bitmask, size_t num)
+    -> std::vector<size_t> {
+    std::vector<size_t> indices;
+    const size_t num_words = bitmaskWords(num);
+    for (size_t w = 0; w < num_words; ++w) {
+        for (uint64_t word = bitmask[w]; word != 0; word &= word - 1) {
+            indices.push_back(64 * w + bitmaskLowestBit(word));
+        }
+    }
+    return indices;
+}
+
+}  // namespace math
@@ -137,6 +137,35 @@ using HAS_AVX = std::true_type;
 using HAS_AVX = std::false_type;
 #endif
 
+#if defined(MATH3D_AVX512_ENABLED)
+using HAS_AVX512 = std::true_type;
+#else
+using HAS_AVX512 = std::false_type;
+#endif
+
+#if defined(MATH3D_FMA_ENABLED)
+using HAS_FMA = std::true_type;
+#else
+using HAS_FMA = std::false_type;
+#endif
+
+// Vector3 (and each column of Matrix3) is stored as 4 aligned lanes instead of
+// 3 packed scalars, so the SIMD kernels can load|store whole registers
+#if defined(MATH3D_VEC3_PADDED)
+using HAS_VEC3_PADDING = std::true_type;
+#else
+using HAS_VEC3_PADDING = std::false_type;
+#endif
+
+// The SSE|AVX kernels of Vector3 and Matrix3 load|store 4 lanes per vector (or
+// column), so the operators only use them if the storage is padded
+#if defined(MATH3D_VEC3_PADDED) && defined(MATH3D_SSE_ENABLED)
+#define MATH3D_VEC3_SSE_ENABLED
+#endif
+#if defined(MATH3D_VEC3_PADDED) && defined(MATH3D_AVX_ENABLED)
+#define MATH3D_VEC3_AVX_ENABLED
+#endif
+
 // clang-format off
 template <typename Tp> struct IsFloat32 : public std::false_type {};
 template <> struct IsFloat32<float32_t> : public std::true_type {};
@@ -164,6 +193,14 @@ template <typename Tp>
 struct CpuHasAVX : public std::integral_constant<bool,
                 IsScalar<Tp>::value && HAS_AVX::value> {};
 
+template <typename Tp>
+struct CpuHasAVX512 : public std::integral_constant<bool,
+                IsScalar<Tp>::value && HAS_AVX512::value> {};
+
+template <typename Tp>
+struct CpuHasFMA : public std::integral_constant<bool,
+                IsScalar<Tp>::value && HAS_FMA::value> {};
+
 // clang-format on
 
 /// \class VecCommaInitializer
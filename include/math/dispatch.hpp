@@ -0,0 +1,450 @@
+#pragma once
+
+// -----------------------------------------------------------------------------
+// Runtime selection of the kernel-set (ISA) used by the batch entry points
+//
+// The single-object operators (e.g. `Vector3 + Vector3`) keep choosing their
+// kernels at compile time (MATH3D_SSE_ENABLED, MATH3D_AVX_ENABLED), as a
+// runtime check per call would cost more than the operation itself. The batch
+// entry points (those that work over arrays of objects) instead query the
+// active ISA exposed here once per call, and forward the whole batch to the
+// kernels of the best instruction set supported by the host CPU.
+//
+// When built with MATH3D_RUNTIME_DISPATCH_ENABLED (CMake option
+// MATH3D_BUILD_RUNTIME_DISPATCH), the SIMD batch kernels are compiled using
+// per-function target attributes, so a binary built for the lowest common CPU
+// (e.g. our manylinux wheels) still ships the SSE and AVX batch kernels, and
+// uses them if the CPU reports support for them (checked once via cpuid).
+//
+// The same goes for the AVX-512 batch kernels, which are only selected on CPUs
+// that report AVX-512F and AVX-512DQ. Without runtime dispatch they're only
+// compiled-in when the build targets AVX-512 (option MATH3D_BUILD_AVX512).
+//
+// The SIMD batch kernels of each family are written only once, against the
+// register helpers Packet<T>, in impl/<family>_simd_impl.hpp. These files have
+// no include guard: the SSE, AVX and AVX-512 headers of the family include them
+// inside their own namespace (so Packet<T> resolves to the one of that ISA),
+// with MATH3D_TARGET_ISA defined as the target attribute of that ISA.
+
+// clang-format off
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+    #define MATH3D_ARCH_X86
+#endif
+
+#if defined(MATH3D_ARCH_X86) && defined(MATH3D_RUNTIME_DISPATCH_ENABLED)
+    #if defined(__GNUC__) || defined(__clang__)
+        #define MATH3D_TARGET_SSE __attribute__((target("sse2,ssse3,sse4.1")))
+        #define MATH3D_TARGET_AVX __attribute__((target("avx,avx2,fma")))
+        #define MATH3D_TARGET_AVX512                                           \
+            __attribute__((target("avx,avx2,fma,avx512f,avx512dq")))
+    #else
+        #define MATH3D_TARGET_SSE
+        #define MATH3D_TARGET_AVX
+        #define MATH3D_TARGET_AVX512
+    #endif
+    #define MATH3D_DISPATCH_SSE
+    #define MATH3D_DISPATCH_AVX
+    #define MATH3D_DISPATCH_FMA
+    #define MATH3D_DISPATCH_AVX512
+#else
+    #define MATH3D_TARGET_SSE
+    #define MATH3D_TARGET_AVX
+    #define MATH3D_TARGET_AVX512
+    #if defined(MATH3D_SSE_ENABLED)
+        #define MATH3D_DISPATCH_SSE
+    #endif
+    #if defined(MATH3D_AVX_ENABLED)
+        #define MATH3D_DISPATCH_AVX
+    #endif
+    // GCC and Clang only expose the FMA intrinsics with -mfma (-mavx2 alone
+    // is not enough), while MSVC enables them as part of /arch:AVX2
+    #if defined(MATH3D_AVX_ENABLED) &&                                         \
+        (defined(__FMA__) || (defined(_MSC_VER) && defined(__AVX2__)))
+        #define MATH3D_DISPATCH_FMA
+    #endif
+    #if defined(MATH3D_AVX512_ENABLED)
+        #define MATH3D_DISPATCH_AVX512
+    #endif
+#endif
+
+#if defined(MATH3D_ARCH_X86)
+    #if defined(_MSC_VER)
+        #include <intrin.h>
+    #else
+        #include <cpuid.h>
+    #endif
+#endif
+
+// Forwards a call to the batch kernel `kernel` of the active kernel-set, e.g.
+// MATH3D_DISPATCH_KERNEL(kernel_dot_vec3_batch<T>, dst, lhs, rhs, num)
+#if defined(MATH3D_DISPATCH_AVX512)
+    #define MATH3D_DISPATCH_CASE_AVX512(kernel, ...)                           \
+        case ::math::dispatch::Isa::AVX512:                                    \
+            ::math::avx512::kernel(__VA_ARGS__);                               \
+            break;
+#else
+    #define MATH3D_DISPATCH_CASE_AVX512(kernel, ...)
+#endif
+
+#if defined(MATH3D_DISPATCH_AVX)
+    #define MATH3D_DISPATCH_CASE_AVX(kernel, ...)                              \
+        case ::math::dispatch::Isa::AVX:                                       \
+            ::math::avx::kernel(__VA_ARGS__);                                  \
+            break;
+#else
+    #define MATH3D_DISPATCH_CASE_AVX(kernel, ...)
+#endif
+
+#if defined(MATH3D_DISPATCH_SSE)
+    #define MATH3D_DISPATCH_CASE_SSE(kernel, ...)                              \
+        case ::math::dispatch::Isa::SSE:                                       \
+            ::math::sse::kernel(__VA_ARGS__);                                  \
+            break;
+#else
+    #define MATH3D_DISPATCH_CASE_SSE(kernel, ...)
+#endif
+
+#define MATH3D_DISPATCH_KERNEL(kernel, ...)                                    \
+    switch (::math::dispatch::GetActiveIsa()) {                                \
+        MATH3D_DISPATCH_CASE_AVX512(kernel, __VA_ARGS__)                       \
+        MATH3D_DISPATCH_CASE_AVX(kernel, __VA_ARGS__)                          \
+        MATH3D_DISPATCH_CASE_SSE(kernel, __VA_ARGS__)                          \
+        default:                                                               \
+            ::math::scalar::kernel(__VA_ARGS__);                               \
+            break;                                                             \
+    }
+
+// clang-format on
+
+#include <array>
+#include <atomic>
+#include <cctype>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "./common.hpp"
+
+namespace math {
+namespace dispatch {
+
+/// Kernel-sets available for the batch entry points (ordered by capability)
+enum class Isa : uint8_t {
+    SCALAR,
+    SSE,
+    AVX,
+    AVX512,
+};
+
+/// Returns the string representation of the given kernel-set
+inline auto ToString(const Isa& p_isa) -> std::string {
+    switch (p_isa) {
+        case Isa::SCALAR:
+            return "scalar";
+        case Isa::SSE:
+            return "sse";
+        case Isa::AVX:
+            return "avx";
+        case Isa::AVX512:
+            return "avx512";
+        default:
+            return "undefined";
+    }
+}
+
+/// Instruction-set extensions reported by the host CPU (and enabled by the OS)
+struct CpuFeatures {
+    /// Whether or not the CPU supports SSE2
+    bool sse2 = false;
+    /// Whether or not the CPU supports SSE4.1
+    bool sse41 = false;
+    /// Whether or not the CPU supports AVX (and the OS saves the ymm state)
+    bool avx = false;
+    /// Whether or not the CPU supports AVX2
+    bool avx2 = false;
+    /// Whether or not the CPU supports FMA3
+    bool fma = false;
+    /// Whether or not the CPU supports AVX-512F (and the OS saves zmm state)
+    bool avx512f = false;
+    /// Whether or not the CPU supports AVX-512DQ
+    bool avx512dq = false;
+};
+
+namespace detail {
+
+/// Value stored in the active-isa slot before it has been resolved
+constexpr int ISA_UNRESOLVED = -1;
+
+#if defined(MATH3D_ARCH_X86)
+/// Runs the cpuid instruction for the given leaf and sub-leaf
+inline auto cpuid(uint32_t leaf, uint32_t subleaf) -> std::array<uint32_t, 4> {
+    std::array<uint32_t, 4> regs = {0, 0, 0, 0};
+#if defined(_MSC_VER)
+    std::array<int, 4> info = {0, 0, 0, 0};
+    __cpuidex(info.data(), static_cast<int>(leaf), static_cast<int>(subleaf));
+    for (size_t i = 0; i < regs.size(); ++i) {
+        regs[i] = static_cast<uint32_t>(info[i]);
+    }
+#else
+    __cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+#endif
+    return regs;
+}
+
+/// Returns the XCR0 register, which tells which register states the OS saves
+inline auto xgetbv0() -> uint64_t {
+#if defined(_MSC_VER)
+    return static_cast<uint64_t>(_xgetbv(0));
+#else
+    uint32_t eax = 0;
+    uint32_t edx = 0;
+    __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    return (static_cast<uint64_t>(edx) << 32) | eax;
+#endif
+}
+#endif  // MATH3D_ARCH_X86
+
+/// Queries the CPU for the instruction-set extensions we care about
+inline auto DetectCpuFeatures() -> CpuFeatures {
+    CpuFeatures features;
+#if defined(MATH3D_ARCH_X86)
+    constexpr uint32_t BIT_SSE2 = 1U << 26;     // leaf 1, edx
+    constexpr uint32_t BIT_SSE41 = 1U << 19;    // leaf 1, ecx
+    constexpr uint32_t BIT_FMA = 1U << 12;      // leaf 1, ecx
+    constexpr uint32_t BIT_OSXSAVE = 1U << 27;  // leaf 1, ecx
+    constexpr uint32_t BIT_AVX = 1U << 28;      // leaf 1, ecx
+    constexpr uint32_t BIT_AVX2 = 1U << 5;      // leaf 7, ebx
+    constexpr uint32_t BIT_AVX512F = 1U << 16;  // leaf 7, ebx
+    constexpr uint32_t BIT_AVX512DQ = 1U << 17; // leaf 7, ebx
+    constexpr uint64_t XCR0_XMM_YMM = 0x6;      // SSE and AVX register states
+    constexpr uint64_t XCR0_ZMM = 0xe0;         // opmask and zmm states
+
+    const auto max_leaf = cpuid(0, 0)[0];
+    if (max_leaf < 1) {
+        return features;
+    }
+
+    const auto leaf_1 = cpuid(1, 0);
+    features.sse2 = (leaf_1[3] & BIT_SSE2) != 0;
+    features.sse41 = (leaf_1[2] & BIT_SSE41) != 0;
+
+    const bool os_xsave = (leaf_1[2] & BIT_OSXSAVE) != 0;
+    const uint64_t xcr0 = os_xsave ? xgetbv0() : 0;
+    const bool os_saves_ymm = (xcr0 & XCR0_XMM_YMM) == XCR0_XMM_YMM;
+    const bool os_saves_zmm = os_saves_ymm && ((xcr0 & XCR0_ZMM) == XCR0_ZMM);
+    features.avx = os_saves_ymm && ((leaf_1[2] & BIT_AVX) != 0);
+    features.fma = features.avx && ((leaf_1[2] & BIT_FMA) != 0);
+
+    if (max_leaf >= 7) {
+        const auto leaf_7 = cpuid(7, 0);
+        features.avx2 = features.avx && ((leaf_7[1] & BIT_AVX2) != 0);
+        features.avx512f = os_saves_zmm && ((leaf_7[1] & BIT_AVX512F) != 0);
+        features.avx512dq =
+            features.avx512f && ((leaf_7[1] & BIT_AVX512DQ) != 0);
+    }
+#endif  // MATH3D_ARCH_X86
+    return features;
+}
+
+/// Parses the name of a kernel-set (as given by ToString), case-insensitive
+inline auto ParseIsa(const std::string& name, Isa& isa) -> bool {
+    std::string lowered;
+    for (const auto chr : name) {
+        lowered.push_back(static_cast<char>(
+            std::tolower(static_cast<unsigned char>(chr))));
+    }
+    for (const auto candidate :
+         {Isa::SCALAR, Isa::SSE, Isa::AVX, Isa::AVX512}) {
+        if (lowered == ToString(candidate)) {
+            isa = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+/// Storage for the kernel-set currently in use (shared by all callers)
+inline auto ActiveIsaSlot() -> std::atomic<int>& {
+    static std::atomic<int> s_active_isa{ISA_UNRESOLVED};
+    return s_active_isa;
+}
+
+}  // namespace detail
+
+/// Returns the features of the host CPU (detected once, on first use)
+inline auto GetCpuFeatures() -> const CpuFeatures& {
+    static const CpuFeatures s_features = detail::DetectCpuFeatures();
+    return s_features;
+}
+
+/// Returns whether the kernels for the given ISA were compiled into the binary
+inline auto IsCompiledIn(Isa isa) -> bool {
+    switch (isa) {
+        case Isa::SCALAR:
+            return true;
+        case Isa::SSE:
+#if defined(MATH3D_DISPATCH_SSE)
+            return true;
+#else
+            return false;
+#endif
+        case Isa::AVX:
+#if defined(MATH3D_DISPATCH_AVX)
+            return true;
+#else
+            return false;
+#endif
+        case Isa::AVX512:
+#if defined(MATH3D_DISPATCH_AVX512)
+            return true;
+#else
+            return false;
+#endif
+        default:
+            return false;
+    }
+}
+
+/// Returns whether the given ISA is both compiled-in and supported by the CPU
+inline auto IsSupported(Isa isa) -> bool {
+    if (!IsCompiledIn(isa)) {
+        return false;
+    }
+    const auto& cpu = GetCpuFeatures();
+    switch (isa) {
+        case Isa::SCALAR:
+            return true;
+        case Isa::SSE:
+            return cpu.sse2 && cpu.sse41;
+        case Isa::AVX:
+#if defined(MATH3D_RUNTIME_DISPATCH_ENABLED)
+            // Compiled with target("avx,avx2,fma"), so require all of them
+            return cpu.avx && cpu.avx2 && cpu.fma;
+#else
+            return cpu.avx;
+#endif
+        case Isa::AVX512:
+            // The AVX-512 kernels also use AVX2 and FMA (e.g. for the tails)
+            return cpu.avx && cpu.avx2 && cpu.fma && cpu.avx512f &&
+                   cpu.avx512dq;
+        default:
+            return false;
+    }
+}
+
+/// Returns all kernel-sets that can be used in this machine (lowest first)
+inline auto GetSupportedIsas() -> std::vector<Isa> {
+    std::vector<Isa> isas;
+    for (const auto isa : {Isa::SCALAR, Isa::SSE, Isa::AVX, Isa::AVX512}) {
+        if (IsSupported(isa)) {
+            isas.push_back(isa);
+        }
+    }
+    return isas;
+}
+
+/// Returns the most capable kernel-set that can be used in this machine
+inline auto GetBestIsa() -> Isa {
+    return GetSupportedIsas().back();
+}
+
+/// Returns the kernel-set the batch entry points should dispatch to
+///
+/// The first call resolves it to the best supported ISA, unless the
+/// environment variable `MATH3D_FORCE_ISA` requests a lower one (values are
+/// "scalar", "sse", "avx" or "avx512"). Unsupported requests fall back to the
+/// best ISA.
+inline auto GetActiveIsa() -> Isa {
+    auto& slot = detail::ActiveIsaSlot();
+    auto active = slot.load(std::memory_order_relaxed);
+    if (active != detail::ISA_UNRESOLVED) {
+        return static_cast<Isa>(active);
+    }
+
+    auto resolved = GetBestIsa();
+#if defined(_MSC_VER)
+#pragma warning(push)
+#pragma warning(disable : 4996)
+#endif
+    const char* env_isa = std::getenv("MATH3D_FORCE_ISA");  // NOLINT
+#if defined(_MSC_VER)
+#pragma warning(pop)
+#endif
+    Isa requested = Isa::SCALAR;
+    if (env_isa != nullptr && detail::ParseIsa(env_isa, requested) &&
+        IsSupported(requested)) {
+        resolved = requested;
+    }
+
+    // Keep the value of any concurrent call that might have resolved it first
+    int expected = detail::ISA_UNRESOLVED;
+    slot.compare_exchange_strong(expected, static_cast<int>(resolved),
+                                 std::memory_order_relaxed);
+    return static_cast<Isa>(slot.load(std::memory_order_relaxed));
+}
+
+/// Forces the batch entry points to use the given kernel-set
+///
+/// \param[in] isa The kernel-set to be used from now on
+/// \returns false (and keeps the current ISA) if it isn't supported here
+inline auto SetActiveIsa(Isa isa) -> bool {
+    if (!IsSupported(isa)) {
+        return false;
+    }
+    detail::ActiveIsaSlot().store(static_cast<int>(isa),
+                                  std::memory_order_relaxed);
+    return true;
+}
+
+/// Restores the default kernel-set (resolved again on the next query)
+inline auto ResetActiveIsa() -> void {
+    detail::ActiveIsaSlot().store(detail::ISA_UNRESOLVED,
+                                  std::memory_order_relaxed);
+}
+
+/// \class ScopedIsa
+///
+/// \brief Forces a kernel-set for the lifetime of this object
+///
+/// Mostly useful for testing and benchmarking the kernels of a specific ISA:
+///
+/// \code
+///     {
+///         math::dispatch::ScopedIsa guard(math::dispatch::Isa::SCALAR);
+///         math::transformPoints(tf, points.data(), out.data(), n);
+///     }
+/// \endcode
+class ScopedIsa {
+ public:
+    /// Forces the given ISA (check `active()` in case it isn't supported)
+    explicit ScopedIsa(Isa isa)
+        : m_Previous(detail::ActiveIsaSlot().load(std::memory_order_relaxed)),
+          m_Active(SetActiveIsa(isa)) {}
+
+    ScopedIsa(const ScopedIsa& other) = delete;
+
+    ScopedIsa(ScopedIsa&& other) = delete;
+
+    auto operator=(const ScopedIsa& rhs) -> ScopedIsa& = delete;
+
+    auto operator=(ScopedIsa&& rhs) -> ScopedIsa& = delete;
+
+    /// Restores the kernel-set that was in use before this guard was created
+    ~ScopedIsa() {
+        detail::ActiveIsaSlot().store(m_Previous, std::memory_order_relaxed);
+    }
+
+    /// Returns whether the requested ISA could be forced
+    MATH3D_NODISCARD auto active() const -> bool { return m_Active; }
+
+ private:
+    /// The value of the active-isa slot when this guard was created
+    int m_Previous = detail::ISA_UNRESOLVED;
+    /// Whether or not the requested ISA is the one currently in use
+    bool m_Active = false;
+};
+
+}  // namespace dispatch
+}  // namespace math
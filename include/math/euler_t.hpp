@@ -4,6 +4,7 @@
 #include <string>
 
 #include "./euler_t_decl.hpp"
+#include "./fast_math.hpp"
 
 #include "./quat_t.hpp"
 #include "./mat3_t.hpp"
@@ -50,6 +51,7 @@ auto ToString(const Convention& p_convention) -> std::string {
 // ***************************************************************************//
 
 template <typename T>
+template <typename Trig>
 auto Euler<T>::setFromRotationMatrix(const Mat3& m) -> void {
     // Implementation based on ThreeJS Euler.js implementation [0]
 
@@ -73,67 +75,67 @@ auto Euler<T>::setFromRotationMatrix(const Mat3& m) -> void {
 
     switch (this->order) {
         case euler::Order::XYZ: {
-            this->y = std::asin(clamp(m13, SIN_MIN, SIN_MAX));
+            this->y = Trig::asin(clamp(m13, SIN_MIN, SIN_MAX));
             if (std::abs(m13) < ONE_MINUS_EPS) {
-                this->x = std::atan2(-m23, m33);
-                this->z = std::atan2(-m12, m11);
+                this->x = Trig::atan2(-m23, m33);
+                this->z = Trig::atan2(-m12, m11);
             } else {
-                this->x = std::atan2(m32, m22);
+                this->x = Trig::atan2(m32, m22);
                 this->z = ZERO;
             }
             break;
         }
         case euler::Order::YXZ: {
-            this->x = std::asin(-clamp(m23, SIN_MIN, SIN_MAX));
+            this->x = Trig::asin(-clamp(m23, SIN_MIN, SIN_MAX));
             if (std::abs(m23) < ONE_MINUS_EPS) {
-                this->y = std::atan2(m13, m33);
-                this->z = std::atan2(m21, m22);
+                this->y = Trig::atan2(m13, m33);
+                this->z = Trig::atan2(m21, m22);
             } else {
-                this->y = std::atan2(-m31, m11);
+                this->y = Trig::atan2(-m31, m11);
                 this->z = ZERO;
             }
             break;
         }
         case euler::Order::ZXY: {
-            this->x = std::asin(clamp(m32, SIN_MIN, SIN_MAX));
+            this->x = Trig::asin(clamp(m32, SIN_MIN, SIN_MAX));
             if (std::abs(m32) < ONE_MINUS_EPS) {
-                this->y = std::atan2(-m31, m33);
-                this->z = std::atan2(-m12, m22);
+                this->y = Trig::atan2(-m31, m33);
+                this->z = Trig::atan2(-m12, m22);
             } else {
                 this->y = ZERO;
-                this->z = std::atan2(m21, m11);
+                this->z = Trig::atan2(m21, m11);
             }
             break;
         }
         case euler::Order::ZYX: {
-            this->y = std::asin(-clamp(m31, SIN_MIN, SIN_MAX));
+            this->y = Trig::asin(-clamp(m31, SIN_MIN, SIN_MAX));
             if (std::abs(m31) < ONE_MINUS_EPS) {
-                this->x = std::atan2(m32, m33);
-                this->z = std::atan2(m21, m11);
+                this->x = Trig::atan2(m32, m33);
+                this->z = Trig::atan2(m21, m11);
             } else {
                 this->x = ZERO;
-                this->z = std::atan2(-m12, m22);
+                this->z = Trig::atan2(-m12, m22);
             }
             break;
         }
         case euler::Order::YZX: {
-            this->z = std::asin(clamp(m21, SIN_MIN, SIN_MAX));
+            this->z = Trig::asin(clamp(m21, SIN_MIN, SIN_MAX));
             if (std::abs(m21) < ONE_MINUS_EPS) {
-                this->x = std::atan2(-m23, m22);
-                this->y = std::atan2(-m31, m11);
+                this->x = Trig::atan2(-m23, m22);
+                this->y = Trig::atan2(-m31, m11);
             } else {
                 this->x = ZERO;
-                this->y = std::atan2(m13, m33);
+                this->y = Trig::atan2(m13, m33);
             }
             break;
         }
         case euler::Order::XZY: {
-            this->z = std::asin(-clamp(m12, SIN_MIN, SIN_MAX));
+            this->z = Trig::asin(-clamp(m12, SIN_MIN, SIN_MAX));
             if (std::abs(m12) < ONE_MINUS_EPS) {
-                this->x = std::atan2(m32, m22);
-                this->y = std::atan2(m13, m11);
+                this->x = Trig::atan2(m32, m22);
+                this->y = Trig::atan2(m13, m11);
             } else {
-                this->x = std::atan2(-m23, m33);
+                this->x = Trig::atan2(-m23, m33);
                 this->y = ZERO;
             }
             break;
@@ -12,6 +12,7 @@
 #include <algorithm>
 #include <type_traits>
 
+#include "./fast_math_decl.hpp"
 #include "./vec3_t_decl.hpp"
 #include "./mat3_t_decl.hpp"
 #include "./mat4_t_decl.hpp"
@@ -172,6 +173,7 @@ class Euler {
     }
 
     /// Updates this set of Euler angles with the given 3x3 rotation matrix
+    template <typename Trig = fast::StdTrig>
     auto setFromRotationMatrix(const Mat3& matrix) -> void;
 
     /// Updates this set of Euler angles with the given 4x4 transform matrix
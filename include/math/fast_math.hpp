@@ -0,0 +1,104 @@
+#pragma once
+
+#include <cstddef>
+
+#include "./dispatch.hpp"
+#include "./fast_math_decl.hpp"
+
+#include "./impl/fast_math_scalar_impl.hpp"
+#include "./impl/fast_math_sse_impl.hpp"
+#include "./impl/fast_math_avx_impl.hpp"
+#include "./impl/fast_math_avx512_impl.hpp"
+
+namespace math {
+namespace fast {
+
+// ***************************************************************************//
+//                       Fast trigonometric functions                         //
+// ***************************************************************************//
+
+template <Accuracy A, typename T>
+auto sincos(T x, T& sin_x, T& cos_x) -> void {
+    scalar::kernel_fast_sincos<T>(x, sin_x, cos_x, A);
+}
+
+template <Accuracy A, typename T>
+auto tan(T x) -> T {
+    T sin_x, cos_x;  // NOLINT
+    scalar::kernel_fast_sincos<T>(x, sin_x, cos_x, A);
+    return sin_x / cos_x;
+}
+
+template <Accuracy A, typename T>
+auto atan2(T y, T x) -> T {
+    return scalar::kernel_fast_atan2<T>(y, x, A);
+}
+
+template <Accuracy A, typename T>
+auto asin(T x) -> T {
+    return scalar::kernel_fast_asin<T>(x, A);
+}
+
+template <Accuracy A, typename T>
+auto acos(T x) -> T {
+    return scalar::kernel_fast_acos<T>(x, A);
+}
+
+// ***************************************************************************//
+//             Fast trigonometric functions over arrays of values             //
+// ***************************************************************************//
+
+/// \brief Computes the sine and cosine of each angle of an array
+///
+/// \param[in] x Array of angles (in radians)
+/// \param[out] sin_x Array where to store the sines
+/// \param[out] cos_x Array where to store the cosines
+/// \param[in] num Number of angles in the array
+/// \param[in] accuracy Accuracy of the approximations
+template <typename T>
+auto sincos(const T* x, T* sin_x, T* cos_x, size_t num,
+            Accuracy accuracy = Accuracy::FULL) -> void {
+    MATH3D_DISPATCH_KERNEL(kernel_fast_sincos_batch<T>, sin_x, cos_x, x, num,
+                           accuracy);
+}
+
+/// \brief Computes atan2(y[i], x[i]) for each pair of entries of two arrays
+///
+/// \param[in] y Array of the y-coordinates of the points
+/// \param[in] x Array of the x-coordinates of the points
+/// \param[out] dst Array where to store the angles (in [-pi, pi])
+/// \param[in] num Number of points in the arrays
+/// \param[in] accuracy Accuracy of the approximations
+template <typename T>
+auto atan2(const T* y, const T* x, T* dst, size_t num,
+           Accuracy accuracy = Accuracy::FULL) -> void {
+    MATH3D_DISPATCH_KERNEL(kernel_fast_atan2_batch<T>, dst, y, x, num,
+                           accuracy);
+}
+
+/// \brief Computes the arc-sine of each value of an array
+///
+/// \param[in] x Array of values in [-1, 1]
+/// \param[out] dst Array where to store the angles (in [-pi / 2, pi / 2])
+/// \param[in] num Number of values in the array
+/// \param[in] accuracy Accuracy of the approximations
+template <typename T>
+auto asin(const T* x, T* dst, size_t num, Accuracy accuracy = Accuracy::FULL)
+    -> void {
+    MATH3D_DISPATCH_KERNEL(kernel_fast_asin_batch<T>, dst, x, num, accuracy);
+}
+
+/// \brief Computes the arc-cosine of each value of an array
+///
+/// \param[in] x Array of values in [-1, 1]
+/// \param[out] dst Array where to store the angles (in [0, pi])
+/// \param[in] num Number of values in the array
+/// \param[in] accuracy Accuracy of the approximations
+template <typename T>
+auto acos(const T* x, T* dst, size_t num, Accuracy accuracy = Accuracy::FULL)
+    -> void {
+    MATH3D_DISPATCH_KERNEL(kernel_fast_acos_batch<T>, dst, x, num, accuracy);
+}
+
+}  // namespace fast
+}  // namespace math
@@ -0,0 +1,113 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+
+#include "./common.hpp"
+
+// -----------------------------------------------------------------------------
+// Fast approximations of the trigonometric functions used by the rotations
+//
+// The functions of this module evaluate sin|cos (fused into a single sincos),
+// tan, atan2, asin and acos with a range reduction followed by polynomials, so
+// they take no branches on the value of the input and have SIMD versions for
+// whole arrays (see fast_math.hpp). The rotation constructors and conversions
+// (e.g. Matrix4::RotationX, Quaternion::setFromEuler) take a `Trig` policy
+// that selects between these and the functions of <cmath>, the latter being
+// the default so their results don't change unless requested:
+//
+//     auto rot = Matrix4<double>::RotationX<fast::FastTrig<>>(angle);
+// -----------------------------------------------------------------------------
+
+namespace math {
+namespace fast {
+
+/// Accuracy of the approximations of this module
+enum class Accuracy : uint8_t {
+    /// Within ~1 ulp of the functions of <cmath>, for float32 and float64
+    FULL,
+    /// Uses the (shorter) float32 polynomials for float64 too, which are within
+    /// 1e-8 of the functions of <cmath> (same as FULL for float32)
+    FAST,
+};
+
+/// Computes both the sine and cosine of the given angle
+template <Accuracy A = Accuracy::FULL, typename T>
+auto sincos(T x, T& sin_x, T& cos_x) -> void;
+
+/// Returns the tangent of the given angle
+template <Accuracy A = Accuracy::FULL, typename T>
+auto tan(T x) -> T;
+
+/// Returns the angle in [-pi, pi] of the point (x, y) w.r.t. the X-axis
+template <Accuracy A = Accuracy::FULL, typename T>
+auto atan2(T y, T x) -> T;
+
+/// Returns the arc-sine (in [-pi / 2, pi / 2]) of a value in [-1, 1]
+template <Accuracy A = Accuracy::FULL, typename T>
+auto asin(T x) -> T;
+
+/// Returns the arc-cosine (in [0, pi]) of a value in [-1, 1]
+template <Accuracy A = Accuracy::FULL, typename T>
+auto acos(T x) -> T;
+
+/// Trigonometric policy that uses the functions of <cmath> (the default)
+struct StdTrig {
+    template <typename T>
+    static auto sincos(T x, T& sin_x, T& cos_x) -> void {
+        sin_x = std::sin(x);
+        cos_x = std::cos(x);
+    }
+
+    template <typename T>
+    static auto tan(T x) -> T {
+        return std::tan(x);
+    }
+
+    template <typename T>
+    static auto atan2(T y, T x) -> T {
+        return std::atan2(y, x);
+    }
+
+    template <typename T>
+    static auto asin(T x) -> T {
+        return std::asin(x);
+    }
+
+    template <typename T>
+    static auto acos(T x) -> T {
+        return std::acos(x);
+    }
+};
+
+/// Trigonometric policy that uses the approximations of this module
+template <Accuracy A = Accuracy::FULL>
+struct FastTrig {
+    template <typename T>
+    static auto sincos(T x, T& sin_x, T& cos_x) -> void {
+        ::math::fast::sincos<A>(x, sin_x, cos_x);
+    }
+
+    template <typename T>
+    static auto tan(T x) -> T {
+        return ::math::fast::tan<A>(x);
+    }
+
+    template <typename T>
+    static auto atan2(T y, T x) -> T {
+        return ::math::fast::atan2<A>(y, x);
+    }
+
+    template <typename T>
+    static auto asin(T x) -> T {
+        return ::math::fast::asin<A>(x);
+    }
+
+    template <typename T>
+    static auto acos(T x) -> T {
+        return ::math::fast::acos<A>(x);
+    }
+};
+
+}  // namespace fast
+}  // namespace math
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+#include "./aabb_batch_t.hpp"
+#include "./bitmask.hpp"
+#include "./dispatch.hpp"
+#include "./vec3_batch_t.hpp"
+#include "./utils/geometry_helpers.hpp"
+
+#include "./impl/frustum_culling_scalar_impl.hpp"
+#include "./impl/frustum_culling_sse_impl.hpp"
+#include "./impl/frustum_culling_avx_impl.hpp"
+#include "./impl/frustum_culling_avx512_impl.hpp"
+
+namespace math {
+
+// ***************************************************************************//
+//                     Frustum culling of batches of volumes                  //
+// ***************************************************************************//
+
+// The visibility of the i-th element of a batch is stored as its bit of a
+// bitmask (see bitmask.hpp). The spheres and boxes use the conservative tests
+// of Frustum, so a few volumes near the corners of the frustum are reported as
+// visible.
+
+/// \brief Tests which points of a batch are inside the given frustum
+///
+/// \tparam T Type of scalar used by the frustum and the points
+///
+/// \param[in] frustum The frustum to test the points against
+/// \param[in] points The planes of the batch of points
+/// \param[in] num Number of points in the batch
+/// \param[out] visible Bitmask where to store the results (of size
+///                     bitmaskWords(num)), with the bit i set if the i-th
+///                     point is inside the frustum
+template <typename T>
+auto cullPoints(const Frustum<T>& frustum, Vector3Planes<const T> points,
+                size_t num, uint64_t* visible) -> void {
+    MATH3D_DISPATCH_KERNEL(kernel_cull_points<T>, visible, frustum, points,
+                           num);
+}
+
+/// \brief Returns the bitmask of the points of a batch inside the frustum
+template <typename T>
+auto cullPoints(const Frustum<T>& frustum, const Vector3Batch<T>& points)
+    -> std::vector<uint64_t> {
+    std::vector<uint64_t> visible(bitmaskWords(points.size()));
+    cullPoints<T>(frustum, points.planes(), points.size(), visible.data());
+    return visible;
+}
+
+/// \brief Tests which spheres of a batch may be visible from the frustum
+///
+/// \param[in] frustum The frustum to test the spheres against
+/// \param[in] centers The planes of the batch of centers of the spheres
+/// \param[in] radii Array with the radius of each sphere
+/// \param[in] num Number of spheres in the batch
+/// \param[out] visible Bitmask where to store the results (of size
+///                     bitmaskWords(num))
+template <typename T>
+auto cullSpheres(const Frustum<T>& frustum, Vector3Planes<const T> centers,
+                 const T* radii, size_t num, uint64_t* visible) -> void {
+    MATH3D_DISPATCH_KERNEL(kernel_cull_spheres<T>, visible, frustum, centers,
+                           radii, num);
+}
+
+/// \brief Returns the bitmask of the spheres that may be visible
+template <typename T>
+auto cullSpheres(const Frustum<T>& frustum, const Vector3Batch<T>& centers,
+                 const std::vector<T>& radii) -> std::vector<uint64_t> {
+    assert(radii.size() == centers.size());
+    std::vector<uint64_t> visible(bitmaskWords(centers.size()));
+    cullSpheres<T>(frustum, centers.planes(), radii.data(), centers.size(),
+                   visible.data());
+    return visible;
+}
+
+/// \brief Tests which boxes of a batch may be visible from the frustum
+///
+/// \param[in] frustum The frustum to test the boxes against
+/// \param[in] boxes The planes of the batch of boxes
+/// \param[in] num Number of boxes in the batch
+/// \param[out] visible Bitmask where to store the results (of size
+///                     bitmaskWords(num))
+template <typename T>
+auto cullBoxes(const Frustum<T>& frustum, AABBPlanes<const T> boxes,
+               size_t num, uint64_t* visible) -> void {
+    MATH3D_DISPATCH_KERNEL(kernel_cull_boxes<T>, visible, frustum, boxes, num);
+}
+
+/// \brief Returns the bitmask of the boxes of a batch that may be visible
+template <typename T>
+auto cullBoxes(const Frustum<T>& frustum, const AABBBatch<T>& boxes)
+    -> std::vector<uint64_t> {
+    std::vector<uint64_t> visible(bitmaskWords(boxes.size()));
+    cullBoxes<T>(frustum, boxes.planes(), boxes.size(), visible.data());
+    return visible;
+}
+
+}  // namespace math
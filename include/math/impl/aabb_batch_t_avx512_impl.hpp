@@ -0,0 +1,36 @@
+#pragma once
+
+#include <limits>
+
+#include "./packet_avx512_impl.hpp"
+#include "./aabb_batch_t_scalar_impl.hpp"
+#include "./aabb_batch_t_avx_impl.hpp"
+
+#if defined(MATH3D_DISPATCH_AVX512)
+
+/**
+ * AVX-512 batch kernels for AABB (AVX512F|AVX512DQ)
+ *
+ * The kernels of aabb_batch_t_simd_impl.hpp over zmm registers, i.e. 16
+ * float32 or 8 float64 boxes per iteration. The remaining boxes of the batch
+ * (if any) are handled by the AVX kernel, as a packet of 8 float32 boxes (a
+ * node of a wide BVH) is narrower than a single zmm register.
+ */
+
+namespace math {
+namespace avx512 {
+
+#define MATH3D_TARGET_ISA MATH3D_TARGET_AVX512
+#if defined(MATH3D_DISPATCH_AVX)
+#define MATH3D_REMAINDER_ISA avx
+#else
+#define MATH3D_REMAINDER_ISA scalar
+#endif
+#include "./aabb_batch_t_simd_impl.hpp"
+#undef MATH3D_REMAINDER_ISA
+#undef MATH3D_TARGET_ISA
+
+}  // namespace avx512
+}  // namespace math
+
+#endif  // MATH3D_DISPATCH_AVX512
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <limits>
+
+#include "./packet_avx_impl.hpp"
+#include "./aabb_batch_t_scalar_impl.hpp"
+
+#if defined(MATH3D_DISPATCH_AVX)
+
+/**
+ * AVX batch kernels for AABB (AVX|AVX2|FMA)
+ *
+ * The kernels of aabb_batch_t_simd_impl.hpp over ymm registers, i.e. 8
+ * float32 or 4 float64 boxes per iteration. The remaining boxes of the batch
+ * (if any) are handled by the scalar kernel.
+ */
+
+namespace math {
+namespace avx {
+
+#define MATH3D_TARGET_ISA MATH3D_TARGET_AVX
+#define MATH3D_REMAINDER_ISA scalar
+#include "./aabb_batch_t_simd_impl.hpp"
+#undef MATH3D_REMAINDER_ISA
+#undef MATH3D_TARGET_ISA
+
+}  // namespace avx
+}  // namespace math
+
+#endif  // MATH3D_DISPATCH_AVX
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <limits>
+
+#include "../aabb_batch_t_decl.hpp"
+
+/**
+ * Scalar batch kernels for AABB
+ *
+ * kernel_ray_aabb_batch computes the distance at which a ray enters each box of
+ * a batch stored as SoA (six planes of `num` scalars), with the same slab test
+ * as Ray::intersect (infinity for the boxes it misses). It's also used by the
+ * SIMD kernels to handle the remainder of a batch whose size is not a multiple
+ * of the register width.
+ */
+
+namespace math {
+namespace scalar {
+
+template <typename T>
+using AABBConstPlanes = AABBPlanes<const T>;
+
+template <typename T>
+auto kernel_ray_aabb_batch(T* dst, const Ray<T>& ray, T t_max,
+                           AABBConstPlanes<T> boxes, size_t num) -> void {
+    for (size_t i = 0; i < num; ++i) {
+        const T p_min[] = {boxes.min_x[i], boxes.min_y[i], boxes.min_z[i]};
+        const T p_max[] = {boxes.max_x[i], boxes.max_y[i], boxes.max_z[i]};
+        dst[i] = ray.intersect(p_min, p_max, t_max);
+    }
+}
+
+}  // namespace scalar
+}  // namespace math
@@ -0,0 +1,60 @@
+// No include guard, see MATH3D_TARGET_ISA in dispatch.hpp
+#if !defined(MATH3D_TARGET_ISA) || !defined(MATH3D_REMAINDER_ISA)
+#error "Include the SSE, AVX or AVX-512 header of these kernels"
+#endif
+
+/**
+ * SIMD batch kernels for AABB (SSE, AVX and AVX-512)
+ *
+ * Each iteration tests the ray against Packet<T>::WIDTH boxes at once, one
+ * register per boundary. The remaining boxes of the batch (if any) are handled
+ * by the kernel of MATH3D_REMAINDER_ISA, set by the header of each ISA.
+ */
+
+template <typename T>
+using AABBConstPlanes = AABBPlanes<const T>;
+
+/// Clips the interval [t_enter, t_exit] of each lane against one slab
+template <typename P>
+MATH3D_TARGET_ISA auto clip_slab(typename P::Reg& t_enter,
+                                 typename P::Reg& t_exit,
+                                 typename P::Reg origin,
+                                 typename P::Reg inv_direction,
+                                 typename P::Reg p_min,
+                                 typename P::Reg p_max) -> void {
+    const auto t_a = P::mul(P::sub(p_min, origin), inv_direction);
+    const auto t_b = P::mul(P::sub(p_max, origin), inv_direction);
+    // Same ordering as the scalar slab test: min|max return their second
+    // operand if any of them is NaN, so NaN slabs don't clip the interval
+    t_enter = P::max(P::min(t_b, t_a), t_enter);
+    t_exit = P::min(P::max(t_a, t_b), t_exit);
+}
+
+template <typename T>
+MATH3D_TARGET_ISA auto kernel_ray_aabb_batch(T* dst, const Ray<T>& ray, T t_max,
+                                             AABBConstPlanes<T> boxes,
+                                             size_t num) -> void {
+    using P = Packet<T>;
+    const auto origin_x = P::set1(ray.origin.x());
+    const auto origin_y = P::set1(ray.origin.y());
+    const auto origin_z = P::set1(ray.origin.z());
+    const auto inv_dir_x = P::set1(ray.inv_direction.x());
+    const auto inv_dir_y = P::set1(ray.inv_direction.y());
+    const auto inv_dir_z = P::set1(ray.inv_direction.z());
+    const auto t_max_v = P::set1(t_max);
+    const auto inf_v = P::set1(std::numeric_limits<T>::infinity());
+    size_t i = 0;
+    for (; i + P::WIDTH <= num; i += P::WIDTH) {
+        auto t_enter = P::zero();
+        auto t_exit = t_max_v;
+        clip_slab<P>(t_enter, t_exit, origin_x, inv_dir_x,
+                     P::load(boxes.min_x + i), P::load(boxes.max_x + i));
+        clip_slab<P>(t_enter, t_exit, origin_y, inv_dir_y,
+                     P::load(boxes.min_y + i), P::load(boxes.max_y + i));
+        clip_slab<P>(t_enter, t_exit, origin_z, inv_dir_z,
+                     P::load(boxes.min_z + i), P::load(boxes.max_z + i));
+        P::store(dst + i, P::select_gt(t_enter, t_exit, inf_v, t_enter));
+    }
+    MATH3D_REMAINDER_ISA::kernel_ray_aabb_batch<T>(dst + i, ray, t_max,
+                                                   boxes.offset(i), num - i);
+}
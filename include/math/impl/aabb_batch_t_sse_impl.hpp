@@ -0,0 +1,30 @@
+#pragma once
+
+#include <limits>
+
+#include "./packet_sse_impl.hpp"
+#include "./aabb_batch_t_scalar_impl.hpp"
+
+#if defined(MATH3D_DISPATCH_SSE)
+
+/**
+ * SSE batch kernels for AABB (SSE|SSE2|SSE4.1)
+ *
+ * The kernels of aabb_batch_t_simd_impl.hpp over xmm registers, i.e. 4
+ * float32 or 2 float64 boxes per iteration. The remaining boxes of the batch
+ * (if any) are handled by the scalar kernel.
+ */
+
+namespace math {
+namespace sse {
+
+#define MATH3D_TARGET_ISA MATH3D_TARGET_SSE
+#define MATH3D_REMAINDER_ISA scalar
+#include "./aabb_batch_t_simd_impl.hpp"
+#undef MATH3D_REMAINDER_ISA
+#undef MATH3D_TARGET_ISA
+
+}  // namespace sse
+}  // namespace math
+
+#endif  // MATH3D_DISPATCH_SSE
@@ -0,0 +1,25 @@
+#pragma once
+
+#include "./fast_math_scalar_impl.hpp"
+#include "./packet_avx512_impl.hpp"
+
+#if defined(MATH3D_DISPATCH_AVX512)
+
+/**
+ * AVX-512 kernels of the fast trigonometric functions
+ *
+ * The kernels of fast_math_simd_impl.hpp over zmm registers, i.e. 16 float32
+ * or 8 float64 values per iteration.
+ */
+
+namespace math {
+namespace avx512 {
+
+#define MATH3D_TARGET_ISA MATH3D_TARGET_AVX512
+#include "./fast_math_simd_impl.hpp"
+#undef MATH3D_TARGET_ISA
+
+}  // namespace avx512
+}  // namespace math
+
+#endif  // MATH3D_DISPATCH_AVX512
@@ -0,0 +1,25 @@
+#pragma once
+
+#include "./fast_math_scalar_impl.hpp"
+#include "./packet_avx_impl.hpp"
+
+#if defined(MATH3D_DISPATCH_AVX)
+
+/**
+ * AVX kernels of the fast trigonometric functions
+ *
+ * The kernels of fast_math_simd_impl.hpp over ymm registers, i.e. 8 float32
+ * or 4 float64 values per iteration.
+ */
+
+namespace math {
+namespace avx {
+
+#define MATH3D_TARGET_ISA MATH3D_TARGET_AVX
+#include "./fast_math_simd_impl.hpp"
+#undef MATH3D_TARGET_ISA
+
+}  // namespace avx
+}  // namespace math
+
+#endif  // MATH3D_DISPATCH_AVX
@@ -0,0 +1,211 @@
+// No include guard, see MATH3D_TARGET_ISA in dispatch.hpp
+#if !defined(MATH3D_TARGET_ISA)
+#error "Include the SSE, AVX or AVX-512 header of these kernels"
+#endif
+
+/**
+ * SIMD kernels of the fast trigonometric functions (SSE, AVX and AVX-512)
+ *
+ * The steps are the same as the ones of the scalar kernels (see the notes of
+ * fast_math_scalar_impl.hpp), with every branch replaced by compares and
+ * blends. The quadrant of sincos stays in floating point, as k - 4 * floor(k /
+ * 4), so no integer lanes (nor AVX2) are required.
+ */
+
+/// Evaluates the polynomial with the given coefficients (highest degree first)
+template <typename T, size_t N>
+MATH3D_TARGET_ISA auto fast_horner_packet(const std::array<double, N>& coeffs,
+                                          typename Packet<T>::Reg z) ->
+    typename Packet<T>::Reg {
+    using P = Packet<T>;
+    auto poly = P::set1(static_cast<T>(coeffs[0]));
+    for (size_t k = 1; k < N; ++k) {
+        poly = P::fmadd(poly, z, P::set1(static_cast<T>(coeffs[k])));
+    }
+    return poly;
+}
+
+/// Computes the sine and cosine of each lane of the given register
+template <typename T, fast::Accuracy A>
+MATH3D_TARGET_ISA auto fast_sincos_packet(typename Packet<T>::Reg x,
+                                          typename Packet<T>::Reg& sin_x,
+                                          typename Packet<T>::Reg& cos_x)
+    -> void {
+    using P = Packet<T>;
+    constexpr auto PIO2 = scalar::fast_pio2_parts<T>();
+    const auto one = P::set1(static_cast<T>(1.0));
+    const auto half = P::set1(static_cast<T>(0.5));
+    const auto minus_one = P::set1(static_cast<T>(-1.0));
+
+    const auto k = P::round(P::mul(x, P::set1(static_cast<T>(2.0 / PI))));
+    auto r = P::fnmadd(k, P::set1(PIO2[0]), x);
+    r = P::fnmadd(k, P::set1(PIO2[1]), r);
+    r = P::fnmadd(k, P::set1(PIO2[2]), r);
+    const auto z = P::mul(r, r);
+
+    typename P::Reg sin_poly, cos_poly;  // NOLINT
+    if (scalar::fast_uses_f64_poly<T>(A)) {
+        sin_poly = fast_horner_packet<T>(scalar::fast_sin_coeffs_f64(), z);
+        cos_poly = fast_horner_packet<T>(scalar::fast_cos_coeffs_f64(), z);
+    } else {
+        sin_poly = fast_horner_packet<T>(scalar::fast_sin_coeffs_f32(), z);
+        cos_poly = fast_horner_packet<T>(scalar::fast_cos_coeffs_f32(), z);
+    }
+    const auto sin_r = P::fmadd(P::mul(r, z), sin_poly, r);
+    const auto cos_r =
+        P::fmadd(P::mul(z, z), cos_poly, P::fnmadd(half, z, one));
+
+    // Odd quadrants swap sin|cos, sin is negative in quadrants 2 and 3, and
+    // cos is negative in quadrants 1 and 2
+    const auto quarter_k = P::mul(k, P::set1(static_cast<T>(0.25)));
+    const auto quadrant =
+        P::fnmadd(P::set1(static_cast<T>(4.0)), P::floor(quarter_k), k);
+    const auto odd = P::fnmadd(P::set1(static_cast<T>(2.0)),
+                               P::floor(P::mul(quadrant, half)), quadrant);
+    const auto sin_q = P::select_gt(odd, half, cos_r, sin_r);
+    const auto cos_q = P::select_gt(odd, half, sin_r, cos_r);
+    sin_x = P::select_gt(quadrant, P::set1(static_cast<T>(1.5)),
+                         P::mulsign(sin_q, minus_one), sin_q);
+    cos_x = P::select_gt(one,
+                         P::abs(P::sub(quadrant, P::set1(static_cast<T>(1.5)))),
+                         P::mulsign(cos_q, minus_one), cos_q);
+}
+
+/// Computes fast_sincos_packet with the given accuracy
+template <typename T>
+MATH3D_TARGET_ISA auto fast_sincos_select(typename Packet<T>::Reg x,
+                                          typename Packet<T>::Reg& sin_x,
+                                          typename Packet<T>::Reg& cos_x,
+                                          fast::Accuracy accuracy) -> void {
+    if (accuracy == fast::Accuracy::FULL) {
+        fast_sincos_packet<T, fast::Accuracy::FULL>(x, sin_x, cos_x);
+    } else {
+        fast_sincos_packet<T, fast::Accuracy::FAST>(x, sin_x, cos_x);
+    }
+}
+
+/// Returns atan(t) of each lane of the given register, with t in [0, 1]
+template <typename T, fast::Accuracy A>
+MATH3D_TARGET_ISA auto fast_atan_unit_packet(typename Packet<T>::Reg t) ->
+    typename Packet<T>::Reg {
+    using P = Packet<T>;
+    const auto one = P::set1(static_cast<T>(1.0));
+    const auto split = P::set1(scalar::fast_atan_split<T>(A));
+    const auto reduced = P::div(P::sub(t, one), P::add(t, one));
+    const auto u = P::select_gt(t, split, reduced, t);
+    const auto offset = P::select_gt(
+        t, split, P::set1(scalar::fast_atan_offset<T>(A)), P::zero());
+    const auto z = P::mul(u, u);
+    typename P::Reg poly;  // NOLINT
+    if (scalar::fast_uses_f64_poly<T>(A)) {
+        poly = P::div(
+            P::mul(P::mul(u, z),
+                   fast_horner_packet<T>(scalar::fast_atan_p_coeffs_f64(), z)),
+            fast_horner_packet<T>(scalar::fast_atan_q_coeffs_f64(), z));
+    } else {
+        poly = P::mul(P::mul(u, z),
+                      fast_horner_packet<T>(scalar::fast_atan_coeffs_f32(), z));
+    }
+    return P::add(offset, P::add(u, poly));
+}
+
+/// Returns the angle of each point (x, y) w.r.t. the X-axis
+template <typename T, fast::Accuracy A>
+MATH3D_TARGET_ISA auto fast_atan2_packet(typename Packet<T>::Reg y,
+                                         typename Packet<T>::Reg x) ->
+    typename Packet<T>::Reg {
+    using P = Packet<T>;
+    const auto abs_x = P::abs(x);
+    const auto abs_y = P::abs(y);
+    const auto den = P::max(abs_x, abs_y);
+    const auto t = P::select_gt(den, P::zero(),
+                                P::div(P::min(abs_x, abs_y), den), P::zero());
+    auto angle = fast_atan_unit_packet<T, A>(t);
+    angle = P::select_gt(abs_y, abs_x,
+                         P::sub(P::set1(static_cast<T>(PI / 2.0)), angle),
+                         angle);
+    // The sign of x is moved onto 1, so -0 counts as negative (as in signbit)
+    angle = P::select_gt(P::zero(), P::mulsign(P::set1(static_cast<T>(1.0)), x),
+                         P::sub(P::set1(static_cast<T>(PI)), angle), angle);
+    return P::mulsign(angle, y);
+}
+
+/// Returns fast_atan2_packet with the given accuracy
+template <typename T>
+MATH3D_TARGET_ISA auto fast_atan2_select(typename Packet<T>::Reg y,
+                                         typename Packet<T>::Reg x,
+                                         fast::Accuracy accuracy) ->
+    typename Packet<T>::Reg {
+    return (accuracy == fast::Accuracy::FULL)
+               ? fast_atan2_packet<T, fast::Accuracy::FULL>(y, x)
+               : fast_atan2_packet<T, fast::Accuracy::FAST>(y, x);
+}
+
+/// Returns sqrt((1 - x) * (1 + x)) of each lane of the given register
+template <typename T>
+MATH3D_TARGET_ISA auto fast_cofactor_packet(typename Packet<T>::Reg x) ->
+    typename Packet<T>::Reg {
+    using P = Packet<T>;
+    const auto one = P::set1(static_cast<T>(1.0));
+    return P::sqrt(P::mul(P::sub(one, x), P::add(one, x)));
+}
+
+template <typename T>
+MATH3D_TARGET_ISA auto kernel_fast_sincos_batch(T* sin_dst, T* cos_dst,
+                                                const T* x, size_t num,
+                                                fast::Accuracy accuracy)
+    -> void {
+    using P = Packet<T>;
+    size_t i = 0;
+    for (; i + P::WIDTH <= num; i += P::WIDTH) {
+        typename P::Reg sin_x, cos_x;  // NOLINT
+        fast_sincos_select<T>(P::load(x + i), sin_x, cos_x, accuracy);
+        P::store(sin_dst + i, sin_x);
+        P::store(cos_dst + i, cos_x);
+    }
+    scalar::kernel_fast_sincos_batch<T>(sin_dst + i, cos_dst + i, x + i,
+                                        num - i, accuracy);
+}
+
+template <typename T>
+MATH3D_TARGET_ISA auto kernel_fast_atan2_batch(T* dst, const T* y, const T* x,
+                                               size_t num,
+                                               fast::Accuracy accuracy)
+    -> void {
+    using P = Packet<T>;
+    size_t i = 0;
+    for (; i + P::WIDTH <= num; i += P::WIDTH) {
+        P::store(dst + i, fast_atan2_select<T>(P::load(y + i), P::load(x + i),
+                                               accuracy));
+    }
+    scalar::kernel_fast_atan2_batch<T>(dst + i, y + i, x + i, num - i,
+                                       accuracy);
+}
+
+template <typename T>
+MATH3D_TARGET_ISA auto kernel_fast_asin_batch(T* dst, const T* x, size_t num,
+                                              fast::Accuracy accuracy)
+    -> void {
+    using P = Packet<T>;
+    size_t i = 0;
+    for (; i + P::WIDTH <= num; i += P::WIDTH) {
+        const auto x_i = P::load(x + i);
+        const auto cofactor = fast_cofactor_packet<T>(x_i);
+        P::store(dst + i, fast_atan2_select<T>(x_i, cofactor, accuracy));
+    }
+    scalar::kernel_fast_asin_batch<T>(dst + i, x + i, num - i, accuracy);
+}
+
+template <typename T>
+MATH3D_TARGET_ISA auto kernel_fast_acos_batch(T* dst, const T* x, size_t num,
+                                              fast::Accuracy accuracy)
+    -> void {
+    using P = Packet<T>;
+    size_t i = 0;
+    for (; i + P::WIDTH <= num; i += P::WIDTH) {
+        const auto x_i = P::load(x + i);
+        const auto cofactor = fast_cofactor_packet<T>(x_i);
+        P::store(dst + i, fast_atan2_select<T>(cofactor, x_i, accuracy));
+    }
+    scalar::kernel_fast_acos_batch<T>(dst + i, x + i, num - i, accuracy);
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include "./fast_math_scalar_impl.hpp"
+#include "./packet_sse_impl.hpp"
+
+#if defined(MATH3D_DISPATCH_SSE)
+
+/**
+ * SSE kernels of the fast trigonometric functions
+ *
+ * The kernels of fast_math_simd_impl.hpp over xmm registers, i.e. 4 float32
+ * or 2 float64 values per iteration.
+ */
+
+namespace math {
+namespace sse {
+
+#define MATH3D_TARGET_ISA MATH3D_TARGET_SSE
+#include "./fast_math_simd_impl.hpp"
+#undef MATH3D_TARGET_ISA
+
+}  // namespace sse
+}  // namespace math
+
+#endif  // MATH3D_DISPATCH_SSE
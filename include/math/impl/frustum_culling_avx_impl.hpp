@@ -0,0 +1,27 @@
+#pragma once
+
+#include <limits>
+
+#include "./packet_avx_impl.hpp"
+#include "./frustum_culling_scalar_impl.hpp"
+
+#if defined(MATH3D_DISPATCH_AVX)
+
+/**
+ * AVX frustum-culling kernels (AVX|AVX2|FMA)
+ *
+ * The kernels of frustum_culling_simd_impl.hpp over ymm registers, i.e. 8
+ * float32 or 4 float64 elements per iteration.
+ */
+
+namespace math {
+namespace avx {
+
+#define MATH3D_TARGET_ISA MATH3D_TARGET_AVX
+#include "./frustum_culling_simd_impl.hpp"
+#undef MATH3D_TARGET_ISA
+
+}  // namespace avx
+}  // namespace math
+
+#endif  // MATH3D_DISPATCH_AVX
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <cstdint>
+
+#include "../aabb_batch_t_decl.hpp"
+#include "../bitmask.hpp"
+#include "../vec3_batch_t_decl.hpp"
+#include "../utils/geometry_helpers.hpp"
+
+/**
+ * Scalar frustum-culling kernels
+ *
+ * Each kernel tests a batch stored as SoA (points, spheres or boxes) against
+ * the planes of a frustum, with the same tests as Frustum::contains|intersects,
+ * and writes the results as a bitmask (see bitmask.hpp), with the bit i set if
+ * the i-th element is visible. The bitmask is written in order, so the caller
+ * doesn't have to clear it beforehand.
+ *
+ * The *_range versions only test the elements in [begin, end), and are used by
+ * the SIMD kernels for the remainder of a batch (the bits of the remainder
+ * don't necessarily start at a new word).
+ */
+
+namespace math {
+namespace scalar {
+
+template <typename T>
+using Vec3ConstPlanes = Vector3Planes<const T>;
+
+template <typename T>
+using AABBConstPlanes = AABBPlanes<const T>;
+
+template <typename T>
+auto kernel_cull_points_range(uint64_t* visible, const Frustum<T>& frustum,
+                              Vec3ConstPlanes<T> points, size_t begin,
+                              size_t end) -> void {
+    for (size_t i = begin; i < end; ++i) {
+        const Vector3<T> point(points.x[i], points.y[i], points.z[i]);
+        bitmaskWrite(visible, i, frustum.contains(point) ? 1U : 0U);
+    }
+}
+
+template <typename T>
+auto kernel_cull_spheres_range(uint64_t* visible, const Frustum<T>& frustum,
+                               Vec3ConstPlanes<T> centers, const T* radii,
+                               size_t begin, size_t end) -> void {
+    for (size_t i = begin; i < end; ++i) {
+        const Sphere<T> sphere(
+            Vector3<T>(centers.x[i], centers.y[i], centers.z[i]), radii[i]);
+        bitmaskWrite(visible, i, frustum.intersects(sphere) ? 1U : 0U);
+    }
+}
+
+template <typename T>
+auto kernel_cull_boxes_range(uint64_t* visible, const Frustum<T>& frustum,
+                             AABBConstPlanes<T> boxes, size_t begin,
+                             size_t end) -> void {
+    for (size_t i = begin; i < end; ++i) {
+        const AABB<T> box(
+            Vector3<T>(boxes.min_x[i], boxes.min_y[i], boxes.min_z[i]),
+            Vector3<T>(boxes.max_x[i], boxes.max_y[i], boxes.max_z[i]));
+        bitmaskWrite(visible, i, frustum.intersects(box) ? 1U : 0U);
+    }
+}
+
+template <typename T>
+auto kernel_cull_points(uint64_t* visible, const Frustum<T>& frustum,
+                        Vec3ConstPlanes<T> points, size_t num) -> void {
+    kernel_cull_points_range<T>(visible, frustum, points, 0, num);
+}
+
+template <typename T>
+auto kernel_cull_spheres(uint64_t* visible, const Frustum<T>& frustum,
+                         Vec3ConstPlanes<T> centers, const T* radii,
+                         size_t num) -> void {
+    kernel_cull_spheres_range<T>(visible, frustum, centers, radii, 0, num);
+}
+
+template <typename T>
+auto kernel_cull_boxes(uint64_t* visible, const Frustum<T>& frustum,
+                       AABBConstPlanes<T> boxes, size_t num) -> void {
+    kernel_cull_boxes_range<T>(visible, frustum, boxes, 0, num);
+}
+
+}  // namespace scalar
+}  // namespace math
@@ -0,0 +1,135 @@
+// No include guard, see MATH3D_TARGET_ISA in dispatch.hpp
+#if !defined(MATH3D_TARGET_ISA)
+#error "Include the SSE, AVX or AVX-512 header of these kernels"
+#endif
+
+/**
+ * SIMD frustum-culling kernels (SSE, AVX and AVX-512)
+ *
+ * Each iteration tests Packet<T>::WIDTH elements at once against the six
+ * planes, broadcasting the coefficients of one plane at a time. The smallest
+ * of the six signed distances of each lane gives its visibility, and the bits
+ * of all lanes are written at once (see Packet<T>::mask_ge). The distances
+ * use separate products and sums (not fmadd), so the results match the scalar
+ * kernels exactly. The remaining elements of the batch (if any) are handled by
+ * the scalar kernels.
+ */
+
+template <typename T>
+using Vec3ConstPlanes = Vector3Planes<const T>;
+
+template <typename T>
+using AABBConstPlanes = AABBPlanes<const T>;
+
+/// Returns the signed distance n.dot(p) + d of each lane to the given plane
+/// (same order of operations as Frustum::signedDistanceTo)
+template <typename P>
+MATH3D_TARGET_ISA auto plane_distance(typename P::Reg normal_x,
+                                      typename P::Reg normal_y,
+                                      typename P::Reg normal_z,
+                                      typename P::Reg offset,
+                                      typename P::Reg x,
+                                      typename P::Reg y,
+                                      typename P::Reg z) ->
+    typename P::Reg {
+    return P::add(P::add(P::add(P::mul(normal_x, x), P::mul(normal_y, y)),
+                         P::mul(normal_z, z)),
+                  offset);
+}
+
+template <typename T>
+MATH3D_TARGET_ISA auto kernel_cull_points(uint64_t* visible,
+                                          const Frustum<T>& frustum,
+                                          Vec3ConstPlanes<T> points,
+                                          size_t num) -> void {
+    using P = Packet<T>;
+    constexpr auto NUM_PLANES = static_cast<size_t>(Frustum<T>::NUM_PLANES);
+    const auto zero = P::zero();
+    const auto inf_v = P::set1(std::numeric_limits<T>::infinity());
+    size_t i = 0;
+    for (; i + P::WIDTH <= num; i += P::WIDTH) {
+        const auto x = P::load(points.x + i);
+        const auto y = P::load(points.y + i);
+        const auto z = P::load(points.z + i);
+        auto dist_min = inf_v;
+        for (size_t k = 0; k < NUM_PLANES; ++k) {
+            dist_min = P::min(
+                plane_distance<P>(P::set1(frustum.normal_x[k]),
+                                  P::set1(frustum.normal_y[k]),
+                                  P::set1(frustum.normal_z[k]),
+                                  P::set1(frustum.offset[k]), x, y, z),
+                dist_min);
+        }
+        bitmaskWrite(visible, i, P::mask_ge(dist_min, zero));
+    }
+    scalar::kernel_cull_points_range<T>(visible, frustum, points, i, num);
+}
+
+template <typename T>
+MATH3D_TARGET_ISA auto kernel_cull_spheres(uint64_t* visible,
+                                           const Frustum<T>& frustum,
+                                           Vec3ConstPlanes<T> centers,
+                                           const T* radii,
+                                           size_t num) -> void {
+    using P = Packet<T>;
+    constexpr auto NUM_PLANES = static_cast<size_t>(Frustum<T>::NUM_PLANES);
+    const auto zero = P::zero();
+    const auto inf_v = P::set1(std::numeric_limits<T>::infinity());
+    size_t i = 0;
+    for (; i + P::WIDTH <= num; i += P::WIDTH) {
+        const auto x = P::load(centers.x + i);
+        const auto y = P::load(centers.y + i);
+        const auto z = P::load(centers.z + i);
+        auto dist_min = inf_v;
+        for (size_t k = 0; k < NUM_PLANES; ++k) {
+            dist_min = P::min(
+                plane_distance<P>(P::set1(frustum.normal_x[k]),
+                                  P::set1(frustum.normal_y[k]),
+                                  P::set1(frustum.normal_z[k]),
+                                  P::set1(frustum.offset[k]), x, y, z),
+                dist_min);
+        }
+        const auto neg_radii = P::sub(zero, P::load(radii + i));
+        bitmaskWrite(visible, i, P::mask_ge(dist_min, neg_radii));
+    }
+    scalar::kernel_cull_spheres_range<T>(visible, frustum, centers, radii, i,
+                                         num);
+}
+
+template <typename T>
+MATH3D_TARGET_ISA auto kernel_cull_boxes(uint64_t* visible,
+                                         const Frustum<T>& frustum,
+                                         AABBConstPlanes<T> boxes,
+                                         size_t num) -> void {
+    using P = Packet<T>;
+    constexpr auto NUM_PLANES = static_cast<size_t>(Frustum<T>::NUM_PLANES);
+    // The corner of the boxes furthest along the normal of each plane (if it's
+    // outside the plane, so is the whole box). The plane is the same for all
+    // lanes, so this just picks the planes of the batch to load
+    const T* corner_x[NUM_PLANES];
+    const T* corner_y[NUM_PLANES];
+    const T* corner_z[NUM_PLANES];
+    const T ZERO = static_cast<T>(0.0);
+    for (size_t k = 0; k < NUM_PLANES; ++k) {
+        corner_x[k] = (frustum.normal_x[k] >= ZERO) ? boxes.max_x : boxes.min_x;
+        corner_y[k] = (frustum.normal_y[k] >= ZERO) ? boxes.max_y : boxes.min_y;
+        corner_z[k] = (frustum.normal_z[k] >= ZERO) ? boxes.max_z : boxes.min_z;
+    }
+    const auto zero = P::zero();
+    const auto inf_v = P::set1(std::numeric_limits<T>::infinity());
+    size_t i = 0;
+    for (; i + P::WIDTH <= num; i += P::WIDTH) {
+        auto dist_min = inf_v;
+        for (size_t k = 0; k < NUM_PLANES; ++k) {
+            dist_min = P::min(
+                plane_distance<P>(
+                    P::set1(frustum.normal_x[k]), P::set1(frustum.normal_y[k]),
+                    P::set1(frustum.normal_z[k]), P::set1(frustum.offset[k]),
+                    P::load(corner_x[k] + i), P::load(corner_y[k] + i),
+                    P::load(corner_z[k] + i)),
+                dist_min);
+        }
+        bitmaskWrite(visible, i, P::mask_ge(dist_min, zero));
+    }
+    scalar::kernel_cull_boxes_range<T>(visible, frustum, boxes, i, num);
+}
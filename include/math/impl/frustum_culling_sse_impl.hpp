@@ -0,0 +1,27 @@
+#pragma once
+
+#include <limits>
+
+#include "./packet_sse_impl.hpp"
+#include "./frustum_culling_scalar_impl.hpp"
+
+#if defined(MATH3D_DISPATCH_SSE)
+
+/**
+ * SSE frustum-culling kernels (SSE|SSE2|SSE4.1)
+ *
+ * The kernels of frustum_culling_simd_impl.hpp over xmm registers, i.e. 4
+ * float32 or 2 float64 elements per iteration.
+ */
+
+namespace math {
+namespace sse {
+
+#define MATH3D_TARGET_ISA MATH3D_TARGET_SSE
+#include "./frustum_culling_simd_impl.hpp"
+#undef MATH3D_TARGET_ISA
+
+}  // namespace sse
+}  // namespace math
+
+#endif  // MATH3D_DISPATCH_SSE
@@ -0,0 +1,123 @@
+#pragma once
+
+#if defined(MATH3D_FMA_ENABLED)
+
+#include <immintrin.h>
+
+#include "../mat2_t_decl.hpp"
+
+/**
+ * FMA instruction sets required for each kernel:
+ *
+ * - kernel_matmul_mat2             : AVX|FMA
+ * - kernel_matmul_vec_mat2         : AVX|FMA
+ *
+ * Notes:
+ * 0. Matrix order:
+ *    Our matrices' internal storage layout is column-major order
+ *
+ * 1. Linear-combination view:
+ *    Same as in the Matrix4 case, each column of the result is a combination of
+ *    the columns of the left-hand side, so the second product of each entry is
+ *    fused into the first one: (A * B)[:,k] = fma(b1k, a1, b0k * a0)
+ *
+ * 2. For FMA-float32:
+ *    The whole matrix fits into an xmm register, so both columns of the result
+ *    are computed at once
+ *
+ * 3. For FMA-float64:
+ *    The whole matrix fits into a ymm register
+ */
+
+namespace math {
+namespace fma3 {
+
+template <typename T>
+using Mat2Buffer = typename Matrix2<T>::BufferType;
+
+template <typename T>
+using Vec2Buffer = typename Vector2<T>::BufferType;
+
+template <typename T>
+using SFINAE_MAT2_F32_FMA_GUARD =
+    typename std::enable_if<CpuHasFMA<T>::value && IsFloat32<T>::value>::type*;
+
+template <typename T>
+using SFINAE_MAT2_F64_FMA_GUARD =
+    typename std::enable_if<CpuHasFMA<T>::value && IsFloat64<T>::value>::type*;
+
+// ***************************************************************************//
+//                Dispatch FMA-kernel for matrix-matrix product               //
+// ***************************************************************************//
+
+template <typename T, SFINAE_MAT2_F32_FMA_GUARD<T> = nullptr>
+MATH3D_INLINE auto kernel_matmul_mat2(Mat2Buffer<T>& dst,
+                                      const Mat2Buffer<T>& lhs,
+                                      const Mat2Buffer<T>& rhs) -> void {
+    auto xmm_mat_lhs = _mm_loadu_ps(lhs[0].data());
+    auto xmm_mat_rhs = _mm_loadu_ps(rhs[0].data());
+    // We have loaded on the xmm registers (lhs = a, rhs = b):
+    //      [a00,a10,a01,a11]
+    //      [b00,b10,b01,b11] (recall we use column-major)
+    //
+    // [a00,a10,a00,a10] * [b00,b00,b01,b01] +
+    // [a01,a11,a01,a11] * [b10,b10,b11,b11] = [matmul result]
+    auto xmm_lhs_col_0 = _mm_movelh_ps(xmm_mat_lhs, xmm_mat_lhs);
+    auto xmm_lhs_col_1 = _mm_movehl_ps(xmm_mat_lhs, xmm_mat_lhs);
+    auto xmm_rhs_mix_0 = _mm_shuffle_ps(xmm_mat_rhs, xmm_mat_rhs, 0xa0);
+    auto xmm_rhs_mix_1 = _mm_shuffle_ps(xmm_mat_rhs, xmm_mat_rhs, 0xf5);
+
+    auto xmm_result = _mm_mul_ps(xmm_rhs_mix_0, xmm_lhs_col_0);
+    xmm_result = _mm_fmadd_ps(xmm_rhs_mix_1, xmm_lhs_col_1, xmm_result);
+    _mm_storeu_ps(dst[0].data(), xmm_result);
+}
+
+template <typename T, SFINAE_MAT2_F64_FMA_GUARD<T> = nullptr>
+MATH3D_INLINE auto kernel_matmul_mat2(Mat2Buffer<T>& dst,
+                                      const Mat2Buffer<T>& lhs,
+                                      const Mat2Buffer<T>& rhs) -> void {
+    // Same as the float32 version, using the lanes of a ymm register
+    auto ymm_mat_lhs = _mm256_loadu_pd(lhs[0].data());
+    auto ymm_mat_rhs = _mm256_loadu_pd(rhs[0].data());
+    auto ymm_lhs_col_0 = _mm256_permute2f128_pd(ymm_mat_lhs, ymm_mat_lhs, 0x00);
+    auto ymm_lhs_col_1 = _mm256_permute2f128_pd(ymm_mat_lhs, ymm_mat_lhs, 0x11);
+    auto ymm_rhs_mix_0 = _mm256_shuffle_pd(ymm_mat_rhs, ymm_mat_rhs, 0x00);
+    auto ymm_rhs_mix_1 = _mm256_shuffle_pd(ymm_mat_rhs, ymm_mat_rhs, 0x0f);
+
+    auto ymm_result = _mm256_mul_pd(ymm_rhs_mix_0, ymm_lhs_col_0);
+    ymm_result = _mm256_fmadd_pd(ymm_rhs_mix_1, ymm_lhs_col_1, ymm_result);
+    _mm256_storeu_pd(dst[0].data(), ymm_result);
+}
+
+// ***************************************************************************//
+//                Dispatch FMA-kernel for matrix-vector product               //
+// ***************************************************************************//
+
+template <typename T, SFINAE_MAT2_F32_FMA_GUARD<T> = nullptr>
+MATH3D_INLINE auto kernel_matmul_vec_mat2(Vec2Buffer<T>& dst,
+                                          const Mat2Buffer<T>& mat,
+                                          const Vec2Buffer<T>& vec) -> void {
+    // The lower half has the first column, and the upper half the second one
+    auto xmm_mat = _mm_loadu_ps(mat[0].data());
+    auto xmm_mat_col_1 = _mm_movehl_ps(xmm_mat, xmm_mat);
+    auto xmm_result = _mm_mul_ps(_mm_set1_ps(vec[0]), xmm_mat);
+    xmm_result = _mm_fmadd_ps(_mm_set1_ps(vec[1]), xmm_mat_col_1, xmm_result);
+    dst[0] = _mm_cvtss_f32(xmm_result);
+    dst[1] = _mm_cvtss_f32(_mm_movehdup_ps(xmm_result));
+}
+
+template <typename T, SFINAE_MAT2_F64_FMA_GUARD<T> = nullptr>
+MATH3D_INLINE auto kernel_matmul_vec_mat2(Vec2Buffer<T>& dst,
+                                          const Mat2Buffer<T>& mat,
+                                          const Vec2Buffer<T>& vec) -> void {
+    auto xmm_mat_col_0 = _mm_loadu_pd(mat[0].data());
+    auto xmm_mat_col_1 = _mm_loadu_pd(mat[1].data());
+    auto xmm_result = _mm_mul_pd(_mm_set1_pd(vec[0]), xmm_mat_col_0);
+    xmm_result = _mm_fmadd_pd(_mm_set1_pd(vec[1]), xmm_mat_col_1, xmm_result);
+    _mm_storeu_pd(dst.data(), xmm_result);
+}
+
+}  // namespace fma3
+}  // namespace math
+
+#endif  // MATH3D_FMA_ENABLED
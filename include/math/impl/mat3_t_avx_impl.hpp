@@ -5,6 +5,7 @@
 #include <immintrin.h>
 
 #include "../mat3_t_decl.hpp"
+#include "./vec3_t_avx_impl.hpp"
 
 /**
  * SSE instruction sets required for each kernel:
@@ -27,6 +28,12 @@
  *
  * 2. For AVX-float64:
  *    We can only store full columns into the ymm registers
+ *
+ * 3. Storage:
+ *    Each column is loaded|stored as a whole Vector3 (4 lanes), so the padded
+ *    storage of MATH3D_VEC3_PADDED is required (see vec3_t_sse_impl.hpp). The
+ *    float32 ymm loads|stores of the first 2 columns stay unaligned, as the
+ *    matrix itself is only aligned to the 16 bytes of each column
  */
 
 namespace math {
@@ -61,12 +68,12 @@ MATH3D_INLINE auto kernel_add_mat3(Mat3Buffer<T>& dst, const Mat3Buffer<T>& lhs,
         _mm256_loadu_ps(static_cast<const float*>(rhs[0].data()));
     auto ymm_sum_cols_01 = _mm256_add_ps(ymm_lhs_cols_01, ymm_rhs_cols_01);
 
-    auto xmm_lhs_col_2 = _mm_loadu_ps(static_cast<const float*>(lhs[2].data()));
-    auto xmm_rhs_col_2 = _mm_loadu_ps(static_cast<const float*>(rhs[2].data()));
+    auto xmm_lhs_col_2 = load_vec3(lhs[2].data());
+    auto xmm_rhs_col_2 = load_vec3(rhs[2].data());
     auto xmm_sum_col_2 = _mm_add_ps(xmm_lhs_col_2, xmm_rhs_col_2);
 
     _mm256_storeu_ps(static_cast<float*>(dst[0].data()), ymm_sum_cols_01);
-    _mm_storeu_ps(static_cast<float*>(dst[2].data()), xmm_sum_col_2);
+    store_vec3(dst[2].data(), xmm_sum_col_2);
 }
 
 template <typename T, SFINAE_MAT3_F64_AVX_GUARD<T> = nullptr>
@@ -74,12 +81,10 @@ MATH3D_INLINE auto kernel_add_mat3(Mat3Buffer<T>& dst, const Mat3Buffer<T>& lhs,
                                    const Mat3Buffer<T>& rhs) -> void {
     // A single column fits into a ymm register ((3+1)xf64 <> 256-bit reg.)
     for (uint32_t j = 0; j < Matrix3<T>::MATRIX_SIZE; ++j) {
-        auto ymm_lhs_col_j =
-            _mm256_loadu_pd(static_cast<const double*>(lhs[j].data()));
-        auto ymm_rhs_col_j =
-            _mm256_loadu_pd(static_cast<const double*>(rhs[j].data()));
+        auto ymm_lhs_col_j = load_vec3(lhs[j].data());
+        auto ymm_rhs_col_j = load_vec3(rhs[j].data());
         auto ymm_sum_cols_j = _mm256_add_pd(ymm_lhs_col_j, ymm_rhs_col_j);
-        _mm256_storeu_pd(static_cast<double*>(dst[j].data()), ymm_sum_cols_j);
+        store_vec3(dst[j].data(), ymm_sum_cols_j);
     }
 }
 
@@ -97,24 +102,22 @@ MATH3D_INLINE auto kernel_sub_mat3(Mat3Buffer<T>& dst, const Mat3Buffer<T>& lhs,
         _mm256_loadu_ps(static_cast<const float*>(rhs[0].data()));
     auto ymm_sum_cols_01 = _mm256_sub_ps(ymm_lhs_cols_01, ymm_rhs_cols_01);
 
-    auto xmm_lhs_col_2 = _mm_loadu_ps(static_cast<const float*>(lhs[2].data()));
-    auto xmm_rhs_col_2 = _mm_loadu_ps(static_cast<const float*>(rhs[2].data()));
+    auto xmm_lhs_col_2 = load_vec3(lhs[2].data());
+    auto xmm_rhs_col_2 = load_vec3(rhs[2].data());
     auto xmm_sub_col_2 = _mm_sub_ps(xmm_lhs_col_2, xmm_rhs_col_2);
 
     _mm256_storeu_ps(static_cast<float*>(dst[0].data()), ymm_sum_cols_01);
-    _mm_storeu_ps(static_cast<float*>(dst[2].data()), xmm_sub_col_2);
+    store_vec3(dst[2].data(), xmm_sub_col_2);
 }
 
 template <typename T, SFINAE_MAT3_F64_AVX_GUARD<T> = nullptr>
 MATH3D_INLINE auto kernel_sub_mat3(Mat3Buffer<T>& dst, const Mat3Buffer<T>& lhs,
                                    const Mat3Buffer<T>& rhs) -> void {
     for (uint32_t j = 0; j < Matrix3<T>::MATRIX_SIZE; ++j) {
-        auto ymm_lhs_col_j =
-            _mm256_loadu_pd(static_cast<const double*>(lhs[j].data()));
-        auto ymm_rhs_col_j =
-            _mm256_loadu_pd(static_cast<const double*>(rhs[j].data()));
+        auto ymm_lhs_col_j = load_vec3(lhs[j].data());
+        auto ymm_rhs_col_j = load_vec3(rhs[j].data());
         auto ymm_sub_col_j = _mm256_sub_pd(ymm_lhs_col_j, ymm_rhs_col_j);
-        _mm256_storeu_pd(static_cast<double*>(dst[j].data()), ymm_sub_col_j);
+        store_vec3(dst[j].data(), ymm_sub_col_j);
     }
 }
 
@@ -132,12 +135,12 @@ MATH3D_INLINE auto kernel_scale_mat3(Mat3Buffer<T>& dst, T scale,
     auto ymm_mat_scaled_cols_01 = _mm256_mul_ps(ymm_scale, ymm_mat_cols_01);
 
     auto xmm_scale = _mm_set1_ps(scale);
-    auto xmm_mat_col_2 = _mm_loadu_ps(static_cast<const float*>(src[2].data()));
+    auto xmm_mat_col_2 = load_vec3(src[2].data());
     auto xmm_mat_scaled_col_2 = _mm_mul_ps(xmm_scale, xmm_mat_col_2);
 
     _mm256_storeu_ps(static_cast<float*>(dst[0].data()),
                      ymm_mat_scaled_cols_01);
-    _mm_storeu_ps(static_cast<float*>(dst[2].data()), xmm_mat_scaled_col_2);
+    store_vec3(dst[2].data(), xmm_mat_scaled_col_2);
 }
 
 template <typename T, SFINAE_MAT3_F64_AVX_GUARD<T> = nullptr>
@@ -145,11 +148,9 @@ MATH3D_INLINE auto kernel_scale_mat3(Mat3Buffer<T>& dst, T scale,
                                      const Mat3Buffer<T>& src) -> void {
     auto ymm_scale = _mm256_set1_pd(scale);
     for (uint32_t j = 0; j < Matrix3<T>::MATRIX_SIZE; ++j) {
-        auto ymm_mat_col_j =
-            _mm256_loadu_pd(static_cast<const double*>(src[j].data()));
+        auto ymm_mat_col_j = load_vec3(src[j].data());
         auto ymm_mat_scaled_col_j = _mm256_mul_pd(ymm_scale, ymm_mat_col_j);
-        _mm256_storeu_pd(static_cast<double*>(dst[j].data()),
-                         ymm_mat_scaled_col_j);
+        store_vec3(dst[j].data(), ymm_mat_scaled_col_j);
     }
 }
 
@@ -165,12 +166,11 @@ MATH3D_INLINE auto kernel_matmul_mat3(Mat3Buffer<T>& dst,
         auto xmm_result_col_k = _mm_setzero_ps();
         for (uint32_t j = 0; j < Matrix3<T>::MATRIX_SIZE; ++j) {
             auto xmm_scalar_rhs_jk = _mm_set1_ps(rhs[k][j]);
-            auto xmm_lhs_col_j =
-                _mm_loadu_ps(static_cast<const float*>(lhs[j].data()));
+            auto xmm_lhs_col_j = load_vec3(lhs[j].data());
             xmm_result_col_k = _mm_add_ps(
                 xmm_result_col_k, _mm_mul_ps(xmm_scalar_rhs_jk, xmm_lhs_col_j));
         }
-        _mm_storeu_ps(static_cast<float*>(dst[k].data()), xmm_result_col_k);
+        store_vec3(dst[k].data(), xmm_result_col_k);
     }
 }
 
@@ -182,13 +182,12 @@ MATH3D_INLINE auto kernel_matmul_mat3(Mat3Buffer<T>& dst,
         auto ymm_result_col_k = _mm256_setzero_pd();
         for (uint32_t j = 0; j < Matrix3<T>::MATRIX_SIZE; ++j) {
             auto ymm_scalar_rhs_jk = _mm256_set1_pd(rhs[k][j]);
-            auto ymm_lhs_col_j =
-                _mm256_loadu_pd(static_cast<const double*>(lhs[j].data()));
+            auto ymm_lhs_col_j = load_vec3(lhs[j].data());
             ymm_result_col_k =
                 _mm256_add_pd(ymm_result_col_k,
                               _mm256_mul_pd(ymm_scalar_rhs_jk, ymm_lhs_col_j));
         }
-        _mm256_storeu_pd(static_cast<double*>(dst[k].data()), ymm_result_col_k);
+        store_vec3(dst[k].data(), ymm_result_col_k);
     }
 }
 
@@ -203,12 +202,11 @@ MATH3D_INLINE auto kernel_matmul_vec_mat3(Vec3Buffer<T>& dst,
     auto xmm_result = _mm_setzero_ps();
     for (uint32_t j = 0; j < Matrix3<T>::MATRIX_SIZE; ++j) {
         auto xmm_vec_scalar_j = _mm_set1_ps(vec[j]);
-        auto xmm_mat_col_j =
-            _mm_loadu_ps(static_cast<const float*>(mat[j].data()));
+        auto xmm_mat_col_j = load_vec3(mat[j].data());
         xmm_result =
             _mm_add_ps(xmm_result, _mm_mul_ps(xmm_vec_scalar_j, xmm_mat_col_j));
     }
-    _mm_storeu_ps(static_cast<float*>(dst.data()), xmm_result);
+    store_vec3(dst.data(), xmm_result);
 }
 
 template <typename T, SFINAE_MAT3_F64_AVX_GUARD<T> = nullptr>
@@ -218,12 +216,11 @@ MATH3D_INLINE auto kernel_matmul_vec_mat3(Vec3Buffer<T>& dst,
     auto ymm_result = _mm256_setzero_pd();
     for (uint32_t j = 0; j < Matrix3<T>::MATRIX_SIZE; ++j) {
         auto ymm_vec_scalar_j = _mm256_set1_pd(vec[j]);
-        auto ymm_mat_col_j =
-            _mm256_loadu_pd(static_cast<const double*>(mat[j].data()));
+        auto ymm_mat_col_j = load_vec3(mat[j].data());
         ymm_result = _mm256_add_pd(
             ymm_result, _mm256_mul_pd(ymm_vec_scalar_j, ymm_mat_col_j));
     }
-    _mm256_storeu_pd(static_cast<double*>(dst.data()), ymm_result);
+    store_vec3(dst.data(), ymm_result);
 }
 
 // ***************************************************************************//
@@ -240,12 +237,12 @@ MATH3D_INLINE auto kernel_hadamard_mat3(Mat3Buffer<T>& dst,
         _mm256_loadu_ps(static_cast<const float*>(rhs[0].data()));
     auto ymm_mul_cols_01 = _mm256_mul_ps(ymm_lhs_cols_01, ymm_rhs_cols_01);
 
-    auto xmm_lhs_col_2 = _mm_loadu_ps(static_cast<const float*>(lhs[2].data()));
-    auto xmm_rhs_col_2 = _mm_loadu_ps(static_cast<const float*>(rhs[2].data()));
+    auto xmm_lhs_col_2 = load_vec3(lhs[2].data());
+    auto xmm_rhs_col_2 = load_vec3(rhs[2].data());
     auto xmm_mul_col_2 = _mm_mul_ps(xmm_lhs_col_2, xmm_rhs_col_2);
 
     _mm256_storeu_ps(static_cast<float*>(dst[0].data()), ymm_mul_cols_01);
-    _mm_storeu_ps(static_cast<float*>(dst[2].data()), xmm_mul_col_2);
+    store_vec3(dst[2].data(), xmm_mul_col_2);
 }
 
 template <typename T, SFINAE_MAT3_F64_AVX_GUARD<T> = nullptr>
@@ -253,12 +250,10 @@ MATH3D_INLINE auto kernel_hadamard_mat3(Mat3Buffer<T>& dst,
                                         const Mat3Buffer<T>& lhs,
                                         const Mat3Buffer<T>& rhs) -> void {
     for (uint32_t j = 0; j < Matrix3<T>::MATRIX_SIZE; ++j) {
-        auto ymm_lhs_col_j =
-            _mm256_loadu_pd(static_cast<const double*>(lhs[j].data()));
-        auto ymm_rhs_col_j =
-            _mm256_loadu_pd(static_cast<const double*>(rhs[j].data()));
+        auto ymm_lhs_col_j = load_vec3(lhs[j].data());
+        auto ymm_rhs_col_j = load_vec3(rhs[j].data());
         auto ymm_mul_col_j = _mm256_mul_pd(ymm_lhs_col_j, ymm_rhs_col_j);
-        _mm256_storeu_pd(static_cast<double*>(dst[j].data()), ymm_mul_col_j);
+        store_vec3(dst[j].data(), ymm_mul_col_j);
     }
 }
 
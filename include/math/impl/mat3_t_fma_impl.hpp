@@ -0,0 +1,126 @@
+#pragma once
+
+#if defined(MATH3D_FMA_ENABLED)
+
+#include <immintrin.h>
+
+#include "../mat3_t_decl.hpp"
+#include "./vec3_t_fma_impl.hpp"
+
+/**
+ * FMA instruction sets required for each kernel:
+ *
+ * - kernel_matmul_mat3             : AVX|FMA
+ * - kernel_matmul_vec_mat3         : AVX|FMA
+ *
+ * Notes:
+ * 0. Matrix order:
+ *    Our matrices' internal storage layout is column-major order
+ *
+ * 1. Linear-combination view:
+ *    Same as in the Matrix4 case, each column of the result is a combination of
+ *    the columns of the left-hand side:
+ *
+ *        (A * B)[:,k] = fma(b2k, a2, fma(b1k, a1, b0k * a0))
+ *
+ * 2. Masked loads and stores:
+ *    Each column has only 3 entries, so a full xmm|ymm load of the last column
+ *    would read past the end of the matrix (and a full store would write past
+ *    it). The columns are instead moved with vmaskmov, which never touches the
+ *    masked-out lane (and leaves it zeroed on loads). With the padded storage
+ *    of MATH3D_VEC3_PADDED the columns use plain aligned loads|stores instead
+ */
+
+namespace math {
+namespace fma3 {
+
+template <typename T>
+using Mat3Buffer = typename Matrix3<T>::BufferType;
+
+template <typename T>
+using Vec3Buffer = typename Vector3<T>::BufferType;
+
+template <typename T>
+using SFINAE_MAT3_F32_FMA_GUARD =
+    typename std::enable_if<CpuHasFMA<T>::value && IsFloat32<T>::value>::type*;
+
+template <typename T>
+using SFINAE_MAT3_F64_FMA_GUARD =
+    typename std::enable_if<CpuHasFMA<T>::value && IsFloat64<T>::value>::type*;
+
+// ***************************************************************************//
+//                Dispatch FMA-kernel for matrix-matrix product               //
+// ***************************************************************************//
+
+template <typename T, SFINAE_MAT3_F32_FMA_GUARD<T> = nullptr>
+MATH3D_INLINE auto kernel_matmul_mat3(Mat3Buffer<T>& dst,
+                                      const Mat3Buffer<T>& lhs,
+                                      const Mat3Buffer<T>& rhs) -> void {
+    auto xmm_lhs_0 = load_vec3(lhs[0].data());
+    auto xmm_lhs_1 = load_vec3(lhs[1].data());
+    auto xmm_lhs_2 = load_vec3(lhs[2].data());
+    __m128 xmm_result_cols[Matrix3<T>::MATRIX_SIZE];
+    for (uint32_t k = 0; k < Matrix3<T>::MATRIX_SIZE; ++k) {
+        auto xmm_col_k = _mm_mul_ps(_mm_set1_ps(rhs[k][0]), xmm_lhs_0);
+        xmm_col_k = _mm_fmadd_ps(_mm_set1_ps(rhs[k][1]), xmm_lhs_1, xmm_col_k);
+        xmm_result_cols[k] =
+            _mm_fmadd_ps(_mm_set1_ps(rhs[k][2]), xmm_lhs_2, xmm_col_k);
+    }
+    for (uint32_t k = 0; k < Matrix3<T>::MATRIX_SIZE; ++k) {
+        store_vec3(dst[k].data(), xmm_result_cols[k]);
+    }
+}
+
+template <typename T, SFINAE_MAT3_F64_FMA_GUARD<T> = nullptr>
+MATH3D_INLINE auto kernel_matmul_mat3(Mat3Buffer<T>& dst,
+                                      const Mat3Buffer<T>& lhs,
+                                      const Mat3Buffer<T>& rhs) -> void {
+    auto ymm_lhs_0 = load_vec3(lhs[0].data());
+    auto ymm_lhs_1 = load_vec3(lhs[1].data());
+    auto ymm_lhs_2 = load_vec3(lhs[2].data());
+    __m256d ymm_result_cols[Matrix3<T>::MATRIX_SIZE];
+    for (uint32_t k = 0; k < Matrix3<T>::MATRIX_SIZE; ++k) {
+        auto ymm_col_k = _mm256_mul_pd(_mm256_set1_pd(rhs[k][0]), ymm_lhs_0);
+        ymm_col_k =
+            _mm256_fmadd_pd(_mm256_set1_pd(rhs[k][1]), ymm_lhs_1, ymm_col_k);
+        ymm_result_cols[k] =
+            _mm256_fmadd_pd(_mm256_set1_pd(rhs[k][2]), ymm_lhs_2, ymm_col_k);
+    }
+    for (uint32_t k = 0; k < Matrix3<T>::MATRIX_SIZE; ++k) {
+        store_vec3(dst[k].data(), ymm_result_cols[k]);
+    }
+}
+
+// ***************************************************************************//
+//                Dispatch FMA-kernel for matrix-vector product               //
+// ***************************************************************************//
+
+template <typename T, SFINAE_MAT3_F32_FMA_GUARD<T> = nullptr>
+MATH3D_INLINE auto kernel_matmul_vec_mat3(Vec3Buffer<T>& dst,
+                                          const Mat3Buffer<T>& mat,
+                                          const Vec3Buffer<T>& vec) -> void {
+    auto xmm_result = _mm_mul_ps(_mm_set1_ps(vec[0]), load_vec3(mat[0].data()));
+    xmm_result =
+        _mm_fmadd_ps(_mm_set1_ps(vec[1]), load_vec3(mat[1].data()), xmm_result);
+    xmm_result =
+        _mm_fmadd_ps(_mm_set1_ps(vec[2]), load_vec3(mat[2].data()), xmm_result);
+    store_vec3(dst.data(), xmm_result);
+}
+
+template <typename T, SFINAE_MAT3_F64_FMA_GUARD<T> = nullptr>
+MATH3D_INLINE auto kernel_matmul_vec_mat3(Vec3Buffer<T>& dst,
+                                          const Mat3Buffer<T>& mat,
+                                          const Vec3Buffer<T>& vec) -> void {
+    auto ymm_result =
+        _mm256_mul_pd(_mm256_set1_pd(vec[0]), load_vec3(mat[0].data()));
+    ymm_result = _mm256_fmadd_pd(_mm256_set1_pd(vec[1]),
+                                 load_vec3(mat[1].data()), ymm_result);
+    ymm_result = _mm256_fmadd_pd(_mm256_set1_pd(vec[2]),
+                                 load_vec3(mat[2].data()), ymm_result);
+    store_vec3(dst.data(), ymm_result);
+}
+
+}  // namespace fma3
+}  // namespace math
+
+#endif  // MATH3D_FMA_ENABLED
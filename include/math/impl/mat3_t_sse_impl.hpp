@@ -7,6 +7,7 @@
 #include <xmmintrin.h>
 
 #include "../mat3_t_decl.hpp"
+#include "./vec3_t_sse_impl.hpp"
 
 /**
  * SSE instruction sets required for each kernel:
@@ -33,6 +34,10 @@
  * 3. The kernels for mat3 should be similar to the ones for mat4 (as we're
  *    using 1float for padding), but different in the sense that these should be
  *    truncated (we're missing one column, so we have to handle evth manually)
+ *
+ * 4. Storage:
+ *    Each column is loaded|stored as a whole Vector3 (4 lanes), so the padded
+ *    storage of MATH3D_VEC3_PADDED is required (see vec3_t_sse_impl.hpp)
  */
 
 namespace math {
@@ -62,13 +67,11 @@ MATH3D_INLINE auto kernel_add_mat3(Mat3Buffer<T>& dst, const Mat3Buffer<T>& lhs,
     // vec3 (4 floats, as it uses padding) fits into an xmm register. The
     // padding float is set to zero during instantiation
     for (uint32_t j = 0; j < Matrix3<T>::MATRIX_SIZE; ++j) {
-        auto xmm_lhs_col_j =
-            _mm_loadu_ps(static_cast<const float*>(lhs[j].data()));
-        auto xmm_rhs_col_j =
-            _mm_loadu_ps(static_cast<const float*>(rhs[j].data()));
+        auto xmm_lhs_col_j = load_vec3(lhs[j].data());
+        auto xmm_rhs_col_j = load_vec3(rhs[j].data());
         auto xmm_sum_col_j = _mm_add_ps(xmm_lhs_col_j, xmm_rhs_col_j);
 
-        _mm_storeu_ps(static_cast<float*>(dst[j].data()), xmm_sum_col_j);
+        store_vec3(dst[j].data(), xmm_sum_col_j);
     }
 }
 
@@ -78,22 +81,17 @@ MATH3D_INLINE auto kernel_add_mat3(Mat3Buffer<T>& dst, const Mat3Buffer<T>& lhs,
     // [c0, c1, c2, c3] -> column-major order (in storage), each with (3+1)xf32
     // So, we can send only half of each column to an xmm register
     for (uint32_t j = 0; j < Matrix3<T>::MATRIX_SIZE; ++j) {
-        auto xmm_lhs_col_j_lo =
-            _mm_loadu_pd(static_cast<const double*>(lhs[j].data()));
-        auto xmm_lhs_col_j_hi =
-            _mm_loadu_pd(static_cast<const double*>(lhs[j].data() + 2));
+        auto xmm_lhs_col_j_lo = load_vec3(lhs[j].data());
+        auto xmm_lhs_col_j_hi = load_vec3(lhs[j].data() + 2);
 
-        auto xmm_rhs_col_j_lo =
-            _mm_loadu_pd(static_cast<const double*>(rhs[j].data()));
-        auto xmm_rhs_col_j_hi =
-            _mm_loadu_pd(static_cast<const double*>(rhs[j].data() + 2));
+        auto xmm_rhs_col_j_lo = load_vec3(rhs[j].data());
+        auto xmm_rhs_col_j_hi = load_vec3(rhs[j].data() + 2);
 
         auto xmm_add_col_j_lo = _mm_add_pd(xmm_lhs_col_j_lo, xmm_rhs_col_j_lo);
         auto xmm_add_col_j_hi = _mm_add_pd(xmm_lhs_col_j_hi, xmm_rhs_col_j_hi);
 
-        _mm_storeu_pd(static_cast<double*>(dst[j].data()), xmm_add_col_j_lo);
-        _mm_storeu_pd(static_cast<double*>(dst[j].data() + 2),
-                      xmm_add_col_j_hi);
+        store_vec3(dst[j].data(), xmm_add_col_j_lo);
+        store_vec3(dst[j].data() + 2, xmm_add_col_j_hi);
     }
 }
 
@@ -105,13 +103,11 @@ template <typename T, SFINAE_MAT3_SSE_F32_GUARD<T> = nullptr>
 MATH3D_INLINE auto kernel_sub_mat3(Mat3Buffer<T>& dst, const Mat3Buffer<T>& lhs,
                                    const Mat3Buffer<T>& rhs) -> void {
     for (uint32_t j = 0; j < Matrix3<T>::MATRIX_SIZE; ++j) {
-        auto xmm_lhs_col_j =
-            _mm_loadu_ps(static_cast<const float*>(lhs[j].data()));
-        auto xmm_rhs_col_j =
-            _mm_loadu_ps(static_cast<const float*>(rhs[j].data()));
+        auto xmm_lhs_col_j = load_vec3(lhs[j].data());
+        auto xmm_rhs_col_j = load_vec3(rhs[j].data());
         auto xmm_sub_col_j = _mm_sub_ps(xmm_lhs_col_j, xmm_rhs_col_j);
 
-        _mm_storeu_ps(static_cast<float*>(dst[j].data()), xmm_sub_col_j);
+        store_vec3(dst[j].data(), xmm_sub_col_j);
     }
 }
 
@@ -119,22 +115,17 @@ template <typename T, SFINAE_MAT3_SSE_F64_GUARD<T> = nullptr>
 MATH3D_INLINE auto kernel_sub_mat3(Mat3Buffer<T>& dst, const Mat3Buffer<T>& lhs,
                                    const Mat3Buffer<T>& rhs) -> void {
     for (uint32_t j = 0; j < Matrix3<T>::MATRIX_SIZE; ++j) {
-        auto xmm_lhs_col_j_lo =
-            _mm_loadu_pd(static_cast<const double*>(lhs[j].data()));
-        auto xmm_lhs_col_j_hi =
-            _mm_loadu_pd(static_cast<const double*>(lhs[j].data() + 2));
+        auto xmm_lhs_col_j_lo = load_vec3(lhs[j].data());
+        auto xmm_lhs_col_j_hi = load_vec3(lhs[j].data() + 2);
 
-        auto xmm_rhs_col_j_lo =
-            _mm_loadu_pd(static_cast<const double*>(rhs[j].data()));
-        auto xmm_rhs_col_j_hi =
-            _mm_loadu_pd(static_cast<const double*>(rhs[j].data() + 2));
+        auto xmm_rhs_col_j_lo = load_vec3(rhs[j].data());
+        auto xmm_rhs_col_j_hi = load_vec3(rhs[j].data() + 2);
 
         auto xmm_sub_col_j_lo = _mm_sub_pd(xmm_lhs_col_j_lo, xmm_rhs_col_j_lo);
         auto xmm_sub_col_j_hi = _mm_sub_pd(xmm_lhs_col_j_hi, xmm_rhs_col_j_hi);
 
-        _mm_storeu_pd(static_cast<double*>(dst[j].data()), xmm_sub_col_j_lo);
-        _mm_storeu_pd(static_cast<double*>(dst[j].data() + 2),
-                      xmm_sub_col_j_hi);
+        store_vec3(dst[j].data(), xmm_sub_col_j_lo);
+        store_vec3(dst[j].data() + 2, xmm_sub_col_j_hi);
     }
 }
 
@@ -147,9 +138,9 @@ MATH3D_INLINE auto kernel_scale_mat3(Mat3Buffer<T>& dst, T scale,
                                      const Mat3Buffer<T>& src) -> void {
     auto xmm_scale = _mm_set1_ps(scale);
     for (uint32_t j = 0; j < Matrix3<T>::MATRIX_SIZE; ++j) {
-        auto xmm_col_j = _mm_loadu_ps(static_cast<const float*>(src[j].data()));
+        auto xmm_col_j = load_vec3(src[j].data());
         auto xmm_col_scaled_j = _mm_mul_ps(xmm_scale, xmm_col_j);
-        _mm_storeu_ps(static_cast<float*>(dst[j].data()), xmm_col_scaled_j);
+        store_vec3(dst[j].data(), xmm_col_scaled_j);
     }
 }
 
@@ -158,15 +149,12 @@ MATH3D_INLINE auto kernel_scale_mat3(Mat3Buffer<T>& dst, T scale,
                                      const Mat3Buffer<T>& src) -> void {
     auto xmm_scale = _mm_set1_pd(scale);
     for (uint32_t j = 0; j < Matrix3<T>::MATRIX_SIZE; ++j) {
-        auto xmm_col_j_lo =
-            _mm_loadu_pd(static_cast<const double*>(src[j].data()));
-        auto xmm_col_j_hi =
-            _mm_loadu_pd(static_cast<const double*>(src[j].data() + 2));
+        auto xmm_col_j_lo = load_vec3(src[j].data());
+        auto xmm_col_j_hi = load_vec3(src[j].data() + 2);
         auto xmm_col_scaled_j_lo = _mm_mul_pd(xmm_scale, xmm_col_j_lo);
         auto xmm_col_scaled_j_hi = _mm_mul_pd(xmm_scale, xmm_col_j_hi);
-        _mm_storeu_pd(static_cast<double*>(dst[j].data()), xmm_col_scaled_j_lo);
-        _mm_storeu_pd(static_cast<double*>(dst[j].data() + 2),
-                      xmm_col_scaled_j_hi);
+        store_vec3(dst[j].data(), xmm_col_scaled_j_lo);
+        store_vec3(dst[j].data() + 2, xmm_col_scaled_j_hi);
     }
 }
 
@@ -188,14 +176,13 @@ MATH3D_INLINE auto kernel_matmul_mat3(Mat3Buffer<T>& dst,
             // A * v = (lhs * rhs)[:,k] = SUM   rhs[j,k] * |  lhs[:,j]  ]
             //                              k=0            [      |     ]
             auto xmm_scalar_rhs_jk = _mm_set1_ps(rhs[k][j]);
-            auto xmm_lhs_col_j =
-                _mm_loadu_ps(static_cast<const float*>(lhs[j].data()));
+            auto xmm_lhs_col_j = load_vec3(lhs[j].data());
             auto xmm_lhs_col_scaled_j =
                 _mm_mul_ps(xmm_scalar_rhs_jk, xmm_lhs_col_j);
             xmm_result_col_k =
                 _mm_add_ps(xmm_result_col_k, xmm_lhs_col_scaled_j);
         }
-        _mm_storeu_ps(static_cast<float*>(dst[k].data()), xmm_result_col_k);
+        store_vec3(dst[k].data(), xmm_result_col_k);
     }
 }
 
@@ -209,10 +196,8 @@ MATH3D_INLINE auto kernel_matmul_mat3(Mat3Buffer<T>& dst,
         auto xmm_result_col_k_hi = _mm_setzero_pd();
         for (uint32_t j = 0; j < Matrix3<T>::MATRIX_SIZE; ++j) {
             auto xmm_scalar_rhs_jk = _mm_set1_pd(rhs[k][j]);
-            auto xmm_lhs_col_j_lo =
-                _mm_loadu_pd(static_cast<const double*>(lhs[j].data()));
-            auto xmm_lhs_col_j_hi =
-                _mm_loadu_pd(static_cast<const double*>(lhs[j].data() + 2));
+            auto xmm_lhs_col_j_lo = load_vec3(lhs[j].data());
+            auto xmm_lhs_col_j_hi = load_vec3(lhs[j].data() + 2);
             auto xmm_lhs_col_scaled_j_lo =
                 _mm_mul_pd(xmm_scalar_rhs_jk, xmm_lhs_col_j_lo);
             auto xmm_lhs_col_scaled_j_hi =
@@ -222,9 +207,8 @@ MATH3D_INLINE auto kernel_matmul_mat3(Mat3Buffer<T>& dst,
             xmm_result_col_k_hi =
                 _mm_add_pd(xmm_result_col_k_hi, xmm_lhs_col_scaled_j_hi);
         }
-        _mm_storeu_pd(static_cast<double*>(dst[k].data()), xmm_result_col_k_lo);
-        _mm_storeu_pd(static_cast<double*>(dst[k].data() + 2),
-                      xmm_result_col_k_hi);
+        store_vec3(dst[k].data(), xmm_result_col_k_lo);
+        store_vec3(dst[k].data() + 2, xmm_result_col_k_hi);
     }
 }
 
@@ -250,12 +234,11 @@ MATH3D_INLINE auto kernel_matmul_vec_mat3(Vec3Buffer<T>& dst,
     auto xmm_result = _mm_setzero_ps();
     for (uint32_t j = 0; j < Matrix3<T>::MATRIX_SIZE; ++j) {
         auto xmm_vec_scalar_j = _mm_set1_ps(vec[j]);
-        auto xmm_mat_col_j =
-            _mm_loadu_ps(static_cast<const float*>(mat[j].data()));
+        auto xmm_mat_col_j = load_vec3(mat[j].data());
         auto xmm_mat_col_scaled_j = _mm_mul_ps(xmm_vec_scalar_j, xmm_mat_col_j);
         xmm_result = _mm_add_ps(xmm_result, xmm_mat_col_scaled_j);
     }
-    _mm_storeu_ps(static_cast<float*>(dst.data()), xmm_result);
+    store_vec3(dst.data(), xmm_result);
 }
 
 template <typename T, SFINAE_MAT3_SSE_F64_GUARD<T> = nullptr>
@@ -277,10 +260,8 @@ MATH3D_INLINE auto kernel_matmul_vec_mat3(Vec3Buffer<T>& dst,
     auto xmm_result_hi = _mm_setzero_pd();
     for (uint32_t j = 0; j < Matrix3<T>::MATRIX_SIZE; ++j) {
         auto xmm_vec_scalar_j = _mm_set1_pd(vec[j]);
-        auto xmm_mat_col_j_lo =
-            _mm_loadu_pd(static_cast<const double*>(mat[j].data()));
-        auto xmm_mat_col_j_hi =
-            _mm_loadu_pd(static_cast<const double*>(mat[j].data() + 2));
+        auto xmm_mat_col_j_lo = load_vec3(mat[j].data());
+        auto xmm_mat_col_j_hi = load_vec3(mat[j].data() + 2);
         auto xmm_mat_col_j_scaled_lo =
             _mm_mul_pd(xmm_vec_scalar_j, xmm_mat_col_j_lo);
         auto xmm_mat_col_j_scaled_hi =
@@ -289,8 +270,8 @@ MATH3D_INLINE auto kernel_matmul_vec_mat3(Vec3Buffer<T>& dst,
         xmm_result_lo = _mm_add_pd(xmm_result_lo, xmm_mat_col_j_scaled_lo);
         xmm_result_hi = _mm_add_pd(xmm_result_hi, xmm_mat_col_j_scaled_hi);
     }
-    _mm_storeu_pd(static_cast<double*>(dst.data()), xmm_result_lo);
-    _mm_storeu_pd(static_cast<double*>(dst.data() + 2), xmm_result_hi);
+    store_vec3(dst.data(), xmm_result_lo);
+    store_vec3(dst.data() + 2, xmm_result_hi);
 }
 
 // ***************************************************************************//
@@ -302,13 +283,11 @@ MATH3D_INLINE auto kernel_hadamard_mat3(Mat3Buffer<T>& dst,
                                         const Mat3Buffer<T>& lhs,
                                         const Mat3Buffer<T>& rhs) -> void {
     for (uint32_t j = 0; j < Matrix3<T>::MATRIX_SIZE; ++j) {
-        auto xmm_lhs_col_j =
-            _mm_loadu_ps(static_cast<const float*>(lhs[j].data()));
-        auto xmm_rhs_col_j =
-            _mm_loadu_ps(static_cast<const float*>(rhs[j].data()));
+        auto xmm_lhs_col_j = load_vec3(lhs[j].data());
+        auto xmm_rhs_col_j = load_vec3(rhs[j].data());
         auto xmm_prod_col_j = _mm_mul_ps(xmm_lhs_col_j, xmm_rhs_col_j);
 
-        _mm_storeu_ps(static_cast<float*>(dst[j].data()), xmm_prod_col_j);
+        store_vec3(dst[j].data(), xmm_prod_col_j);
     }
 }
 
@@ -317,22 +296,17 @@ MATH3D_INLINE auto kernel_hadamard_mat3(Mat3Buffer<T>& dst,
                                         const Mat3Buffer<T>& lhs,
                                         const Mat3Buffer<T>& rhs) -> void {
     for (uint32_t j = 0; j < Matrix3<T>::MATRIX_SIZE; ++j) {
-        auto xmm_lhs_col_j_lo =
-            _mm_loadu_pd(static_cast<const double*>(lhs[j].data()));
-        auto xmm_lhs_col_j_hi =
-            _mm_loadu_pd(static_cast<const double*>(lhs[j].data() + 2));
+        auto xmm_lhs_col_j_lo = load_vec3(lhs[j].data());
+        auto xmm_lhs_col_j_hi = load_vec3(lhs[j].data() + 2);
 
-        auto xmm_rhs_col_j_lo =
-            _mm_loadu_pd(static_cast<const double*>(rhs[j].data()));
-        auto xmm_rhs_col_j_hi =
-            _mm_loadu_pd(static_cast<const double*>(rhs[j].data() + 2));
+        auto xmm_rhs_col_j_lo = load_vec3(rhs[j].data());
+        auto xmm_rhs_col_j_hi = load_vec3(rhs[j].data() + 2);
 
         auto xmm_prod_col_j_lo = _mm_mul_pd(xmm_lhs_col_j_lo, xmm_rhs_col_j_lo);
         auto xmm_prod_col_j_hi = _mm_mul_pd(xmm_lhs_col_j_hi, xmm_rhs_col_j_hi);
 
-        _mm_storeu_pd(static_cast<double*>(dst[j].data()), xmm_prod_col_j_lo);
-        _mm_storeu_pd(static_cast<double*>(dst[j].data() + 2),
-                      xmm_prod_col_j_hi);
+        store_vec3(dst[j].data(), xmm_prod_col_j_lo);
+        store_vec3(dst[j].data() + 2, xmm_prod_col_j_hi);
     }
 }
 
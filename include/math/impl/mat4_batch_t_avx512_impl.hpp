@@ -0,0 +1,28 @@
+#pragma once
+
+#include "./mat4_batch_t_scalar_impl.hpp"
+#include "./packet_avx512_impl.hpp"
+#include "./vec3_batch_t_avx512_impl.hpp"
+
+#if defined(MATH3D_DISPATCH_AVX512)
+
+/**
+ * AVX-512 batch kernels for transforming arrays of 3d vectors by a Matrix4
+ *
+ * The kernels of mat4_batch_t_simd_impl.hpp over zmm registers, i.e. 16
+ * float32 or 8 float64 vectors per group. The 12 broadcasts plus the 2x6
+ * registers of the unrolled loop still fit in the 32 zmm registers, so nothing
+ * is spilled to the stack.
+ */
+
+namespace math {
+namespace avx512 {
+
+#define MATH3D_TARGET_ISA MATH3D_TARGET_AVX512
+#include "./mat4_batch_t_simd_impl.hpp"
+#undef MATH3D_TARGET_ISA
+
+}  // namespace avx512
+}  // namespace math
+
+#endif  // MATH3D_DISPATCH_AVX512
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "./mat4_batch_t_scalar_impl.hpp"
+#include "./packet_avx_impl.hpp"
+#include "./vec3_batch_t_avx_impl.hpp"
+
+#if defined(MATH3D_DISPATCH_AVX)
+
+/**
+ * AVX batch kernels for transforming arrays of 3d vectors by a Matrix4
+ *
+ * The kernels of mat4_batch_t_simd_impl.hpp over ymm registers, i.e. 8 float32
+ * or 4 float64 vectors per group. With FMA each row of the transform costs 3
+ * fused instructions per group, so for large batches the kernel is bound by
+ * memory.
+ */
+
+namespace math {
+namespace avx {
+
+#define MATH3D_TARGET_ISA MATH3D_TARGET_AVX
+#include "./mat4_batch_t_simd_impl.hpp"
+#undef MATH3D_TARGET_ISA
+
+}  // namespace avx
+}  // namespace math
+
+#endif  // MATH3D_DISPATCH_AVX
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "../mat4_t_decl.hpp"
+#include "../vec3_batch_t_decl.hpp"
+#include "./vec3_batch_t_scalar_impl.hpp"
+
+/**
+ * Scalar batch kernels for transforming arrays of 3d vectors by a Matrix4
+ *
+ * - kernel_transform_points_*     : dst = (M * [p, 1]).xyz
+ * - kernel_transform_directions_* : dst = (M * [d, 0]).xyz
+ *
+ * Only the upper 3x4 block of the matrix is used (the usual case of rigid and
+ * affine transforms), so there's no division by the w-coordinate.
+ */
+
+namespace math {
+namespace scalar {
+
+/// Storage of a Matrix4 (array of columns), as taken by the batch kernels
+template <typename T>
+using Mat4Columns = typename Matrix4<T>::BufferType;
+
+template <typename T>
+auto kernel_transform_points_vec3_aos(T* dst, const Mat4Columns<T>& mat,
+                                      const T* src, size_t num) -> void {
+    constexpr size_t STRIDE = vec3_aos_stride<T>();
+    for (size_t i = 0; i < num; ++i) {
+        const T* p = src + i * STRIDE;
+        const T px = p[0];
+        const T py = p[1];
+        const T pz = p[2];
+        T* q = dst + i * STRIDE;
+        q[0] = mat[0][0] * px + mat[1][0] * py + mat[2][0] * pz + mat[3][0];
+        q[1] = mat[0][1] * px + mat[1][1] * py + mat[2][1] * pz + mat[3][1];
+        q[2] = mat[0][2] * px + mat[1][2] * py + mat[2][2] * pz + mat[3][2];
+    }
+}
+
+template <typename T>
+auto kernel_transform_directions_vec3_aos(T* dst, const Mat4Columns<T>& mat,
+                                          const T* src, size_t num) -> void {
+    constexpr size_t STRIDE = vec3_aos_stride<T>();
+    for (size_t i = 0; i < num; ++i) {
+        const T* d = src + i * STRIDE;
+        const T dx = d[0];
+        const T dy = d[1];
+        const T dz = d[2];
+        T* q = dst + i * STRIDE;
+        q[0] = mat[0][0] * dx + mat[1][0] * dy + mat[2][0] * dz;
+        q[1] = mat[0][1] * dx + mat[1][1] * dy + mat[2][1] * dz;
+        q[2] = mat[0][2] * dx + mat[1][2] * dy + mat[2][2] * dz;
+    }
+}
+
+template <typename T>
+auto kernel_transform_points_vec3_batch(Vec3Planes<T> dst,
+                                        const Mat4Columns<T>& mat,
+                                        Vec3ConstPlanes<T> src, size_t num)
+    -> void {
+    for (size_t i = 0; i < num; ++i) {
+        const T px = src.x[i];
+        const T py = src.y[i];
+        const T pz = src.z[i];
+        dst.x[i] = mat[0][0] * px + mat[1][0] * py + mat[2][0] * pz + mat[3][0];
+        dst.y[i] = mat[0][1] * px + mat[1][1] * py + mat[2][1] * pz + mat[3][1];
+        dst.z[i] = mat[0][2] * px + mat[1][2] * py + mat[2][2] * pz + mat[3][2];
+    }
+}
+
+template <typename T>
+auto kernel_transform_directions_vec3_batch(Vec3Planes<T> dst,
+                                            const Mat4Columns<T>& mat,
+                                            Vec3ConstPlanes<T> src, size_t num)
+    -> void {
+    for (size_t i = 0; i < num; ++i) {
+        const T dx = src.x[i];
+        const T dy = src.y[i];
+        const T dz = src.z[i];
+        dst.x[i] = mat[0][0] * dx + mat[1][0] * dy + mat[2][0] * dz;
+        dst.y[i] = mat[0][1] * dx + mat[1][1] * dy + mat[2][1] * dz;
+        dst.z[i] = mat[0][2] * dx + mat[1][2] * dy + mat[2][2] * dz;
+    }
+}
+
+}  // namespace scalar
+}  // namespace math
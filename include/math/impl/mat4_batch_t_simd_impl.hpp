@@ -0,0 +1,180 @@
+// No include guard, see MATH3D_TARGET_ISA in dispatch.hpp
+#if !defined(MATH3D_TARGET_ISA)
+#error "Include the SSE, AVX or AVX-512 header of these kernels"
+#endif
+
+/**
+ * SIMD batch kernels for transforming arrays of 3d vectors by a Matrix4 (SSE,
+ * AVX and AVX-512)
+ *
+ * Notes:
+ * 1. Each entry of the upper 3x4 block of the matrix is broadcast once into
+ *    its own register, and kept there for the whole batch. Then each lane of
+ *    a register holds a different vector, so every coordinate of the result
+ *    is just a chain of (fused) multiply-adds:
+ *
+ *      x' = m00 * x + m01 * y + m02 * z + m03
+ *
+ * 2. The main loop is unrolled twice (2 groups of WIDTH vectors), so there
+ *    are two independent multiply-add chains in flight per coordinate.
+ */
+
+template <typename T>
+using Mat4Columns = typename Matrix4<T>::BufferType;
+
+/// Upper 3x4 block of a Matrix4, with each entry broadcast into a register
+template <typename T>
+struct Mat3x4Packet {
+    using P = Packet<T>;
+    using Reg = typename P::Reg;
+
+    /// Entries of the matrix, in row-major order (rows[i][j] = M(i, j))
+    Reg rows[3][4];
+
+    MATH3D_TARGET_ISA explicit Mat3x4Packet(const Mat4Columns<T>& mat) {
+        for (uint32_t row = 0; row < 3; ++row) {
+            for (uint32_t col = 0; col < 4; ++col) {
+                rows[row][col] = P::set1(mat[col][row]);
+            }
+        }
+    }
+
+    /// Returns the given row of M[0:3, 0:3] * (x, y, z) + M[0:3, 3]
+    MATH3D_TARGET_ISA auto point(uint32_t row, Reg x, Reg y, Reg z) const
+        -> Reg {
+        return P::fmadd(rows[row][2], z,
+                        P::fmadd(rows[row][1], y,
+                                 P::fmadd(rows[row][0], x, rows[row][3])));
+    }
+
+    /// Returns the given row of M[0:3, 0:3] * (x, y, z)
+    MATH3D_TARGET_ISA auto direction(uint32_t row, Reg x, Reg y, Reg z) const
+        -> Reg {
+        return P::fmadd(rows[row][2], z,
+                        P::fmadd(rows[row][1], y, P::mul(rows[row][0], x)));
+    }
+};
+
+template <typename T>
+MATH3D_TARGET_ISA auto kernel_transform_points_vec3_aos(
+    T* dst, const Mat4Columns<T>& mat, const T* src, size_t num) -> void {
+    using P = Packet<T>;
+    using Reg = typename P::Reg;
+    constexpr size_t STRIDE = scalar::vec3_aos_stride<T>();
+    constexpr size_t WIDTH = P::WIDTH;
+    const Mat3x4Packet<T> m(mat);
+    size_t i = 0;
+    for (; i + 2 * WIDTH <= num; i += 2 * WIDTH) {
+        Reg ax, ay, az, bx, by, bz;  // NOLINT
+        P::load_aos3(src + i * STRIDE, ax, ay, az);
+        P::load_aos3(src + (i + WIDTH) * STRIDE, bx, by, bz);
+        P::store_aos3(dst + i * STRIDE, m.point(0, ax, ay, az),
+                      m.point(1, ax, ay, az), m.point(2, ax, ay, az));
+        P::store_aos3(dst + (i + WIDTH) * STRIDE, m.point(0, bx, by, bz),
+                      m.point(1, bx, by, bz), m.point(2, bx, by, bz));
+    }
+    for (; i + WIDTH <= num; i += WIDTH) {
+        Reg x, y, z;  // NOLINT
+        P::load_aos3(src + i * STRIDE, x, y, z);
+        P::store_aos3(dst + i * STRIDE, m.point(0, x, y, z),
+                      m.point(1, x, y, z), m.point(2, x, y, z));
+    }
+    scalar::kernel_transform_points_vec3_aos<T>(dst + i * STRIDE, mat,
+                                                src + i * STRIDE, num - i);
+}
+
+template <typename T>
+MATH3D_TARGET_ISA auto kernel_transform_directions_vec3_aos(
+    T* dst, const Mat4Columns<T>& mat, const T* src, size_t num) -> void {
+    using P = Packet<T>;
+    using Reg = typename P::Reg;
+    constexpr size_t STRIDE = scalar::vec3_aos_stride<T>();
+    constexpr size_t WIDTH = P::WIDTH;
+    const Mat3x4Packet<T> m(mat);
+    size_t i = 0;
+    for (; i + 2 * WIDTH <= num; i += 2 * WIDTH) {
+        Reg ax, ay, az, bx, by, bz;  // NOLINT
+        P::load_aos3(src + i * STRIDE, ax, ay, az);
+        P::load_aos3(src + (i + WIDTH) * STRIDE, bx, by, bz);
+        P::store_aos3(dst + i * STRIDE, m.direction(0, ax, ay, az),
+                      m.direction(1, ax, ay, az), m.direction(2, ax, ay, az));
+        P::store_aos3(dst + (i + WIDTH) * STRIDE, m.direction(0, bx, by, bz),
+                      m.direction(1, bx, by, bz), m.direction(2, bx, by, bz));
+    }
+    for (; i + WIDTH <= num; i += WIDTH) {
+        Reg x, y, z;  // NOLINT
+        P::load_aos3(src + i * STRIDE, x, y, z);
+        P::store_aos3(dst + i * STRIDE, m.direction(0, x, y, z),
+                      m.direction(1, x, y, z), m.direction(2, x, y, z));
+    }
+    scalar::kernel_transform_directions_vec3_aos<T>(
+        dst + i * STRIDE, mat, src + i * STRIDE, num - i);
+}
+
+template <typename T>
+MATH3D_TARGET_ISA auto kernel_transform_points_vec3_batch(
+    Vec3Planes<T> dst, const Mat4Columns<T>& mat, Vec3ConstPlanes<T> src,
+    size_t num) -> void {
+    using P = Packet<T>;
+    constexpr size_t WIDTH = P::WIDTH;
+    const Mat3x4Packet<T> m(mat);
+    size_t i = 0;
+    for (; i + 2 * WIDTH <= num; i += 2 * WIDTH) {
+        auto ax = P::load(src.x + i);
+        auto ay = P::load(src.y + i);
+        auto az = P::load(src.z + i);
+        auto bx = P::load(src.x + i + WIDTH);
+        auto by = P::load(src.y + i + WIDTH);
+        auto bz = P::load(src.z + i + WIDTH);
+        P::store(dst.x + i, m.point(0, ax, ay, az));
+        P::store(dst.y + i, m.point(1, ax, ay, az));
+        P::store(dst.z + i, m.point(2, ax, ay, az));
+        P::store(dst.x + i + WIDTH, m.point(0, bx, by, bz));
+        P::store(dst.y + i + WIDTH, m.point(1, bx, by, bz));
+        P::store(dst.z + i + WIDTH, m.point(2, bx, by, bz));
+    }
+    for (; i + WIDTH <= num; i += WIDTH) {
+        auto x = P::load(src.x + i);
+        auto y = P::load(src.y + i);
+        auto z = P::load(src.z + i);
+        P::store(dst.x + i, m.point(0, x, y, z));
+        P::store(dst.y + i, m.point(1, x, y, z));
+        P::store(dst.z + i, m.point(2, x, y, z));
+    }
+    scalar::kernel_transform_points_vec3_batch<T>(dst.offset(i), mat,
+                                                  src.offset(i), num - i);
+}
+
+template <typename T>
+MATH3D_TARGET_ISA auto kernel_transform_directions_vec3_batch(
+    Vec3Planes<T> dst, const Mat4Columns<T>& mat, Vec3ConstPlanes<T> src,
+    size_t num) -> void {
+    using P = Packet<T>;
+    constexpr size_t WIDTH = P::WIDTH;
+    const Mat3x4Packet<T> m(mat);
+    size_t i = 0;
+    for (; i + 2 * WIDTH <= num; i += 2 * WIDTH) {
+        auto ax = P::load(src.x + i);
+        auto ay = P::load(src.y + i);
+        auto az = P::load(src.z + i);
+        auto bx = P::load(src.x + i + WIDTH);
+        auto by = P::load(src.y + i + WIDTH);
+        auto bz = P::load(src.z + i + WIDTH);
+        P::store(dst.x + i, m.direction(0, ax, ay, az));
+        P::store(dst.y + i, m.direction(1, ax, ay, az));
+        P::store(dst.z + i, m.direction(2, ax, ay, az));
+        P::store(dst.x + i + WIDTH, m.direction(0, bx, by, bz));
+        P::store(dst.y + i + WIDTH, m.direction(1, bx, by, bz));
+        P::store(dst.z + i + WIDTH, m.direction(2, bx, by, bz));
+    }
+    for (; i + WIDTH <= num; i += WIDTH) {
+        auto x = P::load(src.x + i);
+        auto y = P::load(src.y + i);
+        auto z = P::load(src.z + i);
+        P::store(dst.x + i, m.direction(0, x, y, z));
+        P::store(dst.y + i, m.direction(1, x, y, z));
+        P::store(dst.z + i, m.direction(2, x, y, z));
+    }
+    scalar::kernel_transform_directions_vec3_batch<T>(dst.offset(i), mat,
+                                                      src.offset(i), num - i);
+}
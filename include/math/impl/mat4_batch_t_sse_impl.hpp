@@ -0,0 +1,26 @@
+#pragma once
+
+#include "./mat4_batch_t_scalar_impl.hpp"
+#include "./packet_sse_impl.hpp"
+#include "./vec3_batch_t_sse_impl.hpp"
+
+#if defined(MATH3D_DISPATCH_SSE)
+
+/**
+ * SSE batch kernels for transforming arrays of 3d vectors by a Matrix4
+ *
+ * The kernels of mat4_batch_t_simd_impl.hpp over xmm registers, i.e. 4 float32
+ * or 2 float64 vectors per group.
+ */
+
+namespace math {
+namespace sse {
+
+#define MATH3D_TARGET_ISA MATH3D_TARGET_SSE
+#include "./mat4_batch_t_simd_impl.hpp"
+#undef MATH3D_TARGET_ISA
+
+}  // namespace sse
+}  // namespace math
+
+#endif  // MATH3D_DISPATCH_SSE
@@ -0,0 +1,285 @@
+#pragma once
+
+#if defined(MATH3D_AVX512_ENABLED)
+
+#include <immintrin.h>
+
+#include "../mat4_t_decl.hpp"
+
+/**
+ * AVX-512 instruction sets required for each kernel:
+ *
+ * - kernel_add_mat4                : AVX512F
+ * - kernel_sub_mat4                : AVX512F
+ * - kernel_scale_mat4              : AVX512F
+ * - kernel_hadamard_mat4           : AVX512F
+ * - kernel_matmul_mat4             : AVX512F
+ * - kernel_matmul_vec_mat4         : AVX512F
+ *
+ * The remaining kernels (transpose, determinant, inverse) are taken from the
+ * AVX kernel-set, as they work on 2x2 blocks and don't benefit from the wider
+ * registers.
+ *
+ * Notes:
+ * 0. Matrix order:
+ *    Our matrices' internal storage layout is column-major order
+ *
+ * 1. For AVX512-float32:
+ *    The whole matrix (16xf32) fits into a single zmm register, with each
+ *    column in its own 128-bit lane
+ *
+ * 2. For AVX512-float64:
+ *    The matrix (16xf64) fits into two zmm registers, with two columns each
+ *    (one per 256-bit lane)
+ *
+ * 3. Matrix products:
+ *    Both use the linear-combination view of the product (as the AVX kernels),
+ *    but compute all columns of the result at once. The j-th column of the
+ *    lhs is broadcast to every lane, and multiplied by the j-th entry of each
+ *    column of the rhs, which is broadcast inside its own lane (in-lane
+ *    permutes, so no lane-crossing latency)
+ *
+ * 4. Products and rounding:
+ *    The sums are accumulated in the same order as the other kernel-sets, and
+ *    without fused multiply-adds, so the results match theirs bit by bit
+ */
+
+namespace math {
+namespace avx512 {
+
+template <typename T>
+using Mat4Buffer = typename Matrix4<T>::BufferType;
+
+template <typename T>
+using Vec4Buffer = typename Vector4<T>::BufferType;
+
+template <typename T>
+using SFINAE_MAT4_F32_AVX512_GUARD =
+    typename std::enable_if<CpuHasAVX512<T>::value &&
+                            IsFloat32<T>::value>::type*;
+
+template <typename T>
+using SFINAE_MAT4_F64_AVX512_GUARD =
+    typename std::enable_if<CpuHasAVX512<T>::value &&
+                            IsFloat64<T>::value>::type*;
+
+// ***************************************************************************//
+//                  Dispatch AVX512-kernel for matrix addition                //
+// ***************************************************************************//
+
+template <typename T, SFINAE_MAT4_F32_AVX512_GUARD<T> = nullptr>
+MATH3D_INLINE auto kernel_add_mat4(Mat4Buffer<T>& dst, const Mat4Buffer<T>& lhs,
+                                   const Mat4Buffer<T>& rhs) -> void {
+    // [c0, c1, c2, c3] -> column-major order (in storage), 16 x f32 contiguous
+    // in memory, so the whole matrix fits into a single ZMM register
+    auto zmm_lhs = _mm512_loadu_ps(lhs[0].data());
+    auto zmm_rhs = _mm512_loadu_ps(rhs[0].data());
+    _mm512_storeu_ps(dst[0].data(), _mm512_add_ps(zmm_lhs, zmm_rhs));
+}
+
+template <typename T, SFINAE_MAT4_F64_AVX512_GUARD<T> = nullptr>
+MATH3D_INLINE auto kernel_add_mat4(Mat4Buffer<T>& dst, const Mat4Buffer<T>& lhs,
+                                   const Mat4Buffer<T>& rhs) -> void {
+    // [c0, c1] and [c2, c3] go into two separate ZMM registers (8 x f64 each)
+    for (uint32_t k = 0; k < 2; ++k) {
+        auto zmm_lhs_cols = _mm512_loadu_pd(lhs[2 * k].data());
+        auto zmm_rhs_cols = _mm512_loadu_pd(rhs[2 * k].data());
+        _mm512_storeu_pd(dst[2 * k].data(),
+                         _mm512_add_pd(zmm_lhs_cols, zmm_rhs_cols));
+    }
+}
+
+// ***************************************************************************//
+//                Dispatch AVX512-kernel for matrix substraction              //
+// ***************************************************************************//
+
+template <typename T, SFINAE_MAT4_F32_AVX512_GUARD<T> = nullptr>
+MATH3D_INLINE auto kernel_sub_mat4(Mat4Buffer<T>& dst, const Mat4Buffer<T>& lhs,
+                                   const Mat4Buffer<T>& rhs) -> void {
+    auto zmm_lhs = _mm512_loadu_ps(lhs[0].data());
+    auto zmm_rhs = _mm512_loadu_ps(rhs[0].data());
+    _mm512_storeu_ps(dst[0].data(), _mm512_sub_ps(zmm_lhs, zmm_rhs));
+}
+
+template <typename T, SFINAE_MAT4_F64_AVX512_GUARD<T> = nullptr>
+MATH3D_INLINE auto kernel_sub_mat4(Mat4Buffer<T>& dst, const Mat4Buffer<T>& lhs,
+                                   const Mat4Buffer<T>& rhs) -> void {
+    for (uint32_t k = 0; k < 2; ++k) {
+        auto zmm_lhs_cols = _mm512_loadu_pd(lhs[2 * k].data());
+        auto zmm_rhs_cols = _mm512_loadu_pd(rhs[2 * k].data());
+        _mm512_storeu_pd(dst[2 * k].data(),
+                         _mm512_sub_pd(zmm_lhs_cols, zmm_rhs_cols));
+    }
+}
+
+// ***************************************************************************//
+//               Dispatch AVX512-kernel for matrix-scalar product             //
+// ***************************************************************************//
+
+template <typename T, SFINAE_MAT4_F32_AVX512_GUARD<T> = nullptr>
+MATH3D_INLINE auto kernel_scale_mat4(Mat4Buffer<T>& dst, T scale,
+                                     const Mat4Buffer<T>& mat) -> void {
+    auto zmm_scale = _mm512_set1_ps(scale);
+    auto zmm_mat = _mm512_loadu_ps(mat[0].data());
+    _mm512_storeu_ps(dst[0].data(), _mm512_mul_ps(zmm_scale, zmm_mat));
+}
+
+template <typename T, SFINAE_MAT4_F64_AVX512_GUARD<T> = nullptr>
+MATH3D_INLINE auto kernel_scale_mat4(Mat4Buffer<T>& dst, T scale,
+                                     const Mat4Buffer<T>& mat) -> void {
+    auto zmm_scale = _mm512_set1_pd(scale);
+    for (uint32_t k = 0; k < 2; ++k) {
+        auto zmm_mat_cols = _mm512_loadu_pd(mat[2 * k].data());
+        _mm512_storeu_pd(dst[2 * k].data(),
+                         _mm512_mul_pd(zmm_scale, zmm_mat_cols));
+    }
+}
+
+// ***************************************************************************//
+//            Dispatch AVX512-kernel for matrix element-wise product          //
+// ***************************************************************************//
+
+template <typename T, SFINAE_MAT4_F32_AVX512_GUARD<T> = nullptr>
+MATH3D_INLINE auto kernel_hadamard_mat4(Mat4Buffer<T>& dst,
+                                        const Mat4Buffer<T>& lhs,
+                                        const Mat4Buffer<T>& rhs) -> void {
+    auto zmm_lhs = _mm512_loadu_ps(lhs[0].data());
+    auto zmm_rhs = _mm512_loadu_ps(rhs[0].data());
+    _mm512_storeu_ps(dst[0].data(), _mm512_mul_ps(zmm_lhs, zmm_rhs));
+}
+
+template <typename T, SFINAE_MAT4_F64_AVX512_GUARD<T> = nullptr>
+MATH3D_INLINE auto kernel_hadamard_mat4(Mat4Buffer<T>& dst,
+                                        const Mat4Buffer<T>& lhs,
+                                        const Mat4Buffer<T>& rhs) -> void {
+    for (uint32_t k = 0; k < 2; ++k) {
+        auto zmm_lhs_cols = _mm512_loadu_pd(lhs[2 * k].data());
+        auto zmm_rhs_cols = _mm512_loadu_pd(rhs[2 * k].data());
+        _mm512_storeu_pd(dst[2 * k].data(),
+                         _mm512_mul_pd(zmm_lhs_cols, zmm_rhs_cols));
+    }
+}
+
+// ***************************************************************************//
+//               Dispatch AVX512-kernel for matrix-matrix product             //
+// ***************************************************************************//
+
+/// Broadcasts entry j of each 128-bit lane into the whole lane
+template <uint j>
+MATH3D_INLINE auto splat_lanes_f32(__m512 vec) -> __m512 {
+    return _mm512_permute_ps(
+        vec, static_cast<int>(math::ShuffleMask<j, j, j, j>::value));
+}
+
+/// Broadcasts entry j of each 256-bit lane into the whole lane
+template <uint j>
+MATH3D_INLINE auto splat_lanes_f64(__m512d vec) -> __m512d {
+    return _mm512_permutex_pd(
+        vec, static_cast<int>(math::ShuffleMask<j, j, j, j>::value));
+}
+
+template <typename T, SFINAE_MAT4_F32_AVX512_GUARD<T> = nullptr>
+MATH3D_INLINE auto kernel_matmul_mat4(Mat4Buffer<T>& dst,
+                                      const Mat4Buffer<T>& lhs,
+                                      const Mat4Buffer<T>& rhs) -> void {
+    //                              j=4            [      |     ]
+    // A * B = (lhs * rhs)[:,k] = SUM   rhs[j,k] * |  lhs[:,j]  ]
+    //                              j=0            [      |     ]
+    //
+    // Lane k of zmm_rhs holds rhs[:,k], so splatting its j-th entry gives the
+    // factor rhs[j,k] for all columns k at once
+    auto zmm_rhs = _mm512_loadu_ps(rhs[0].data());
+    auto zmm_lhs_col_0 = _mm512_broadcast_f32x4(_mm_loadu_ps(lhs[0].data()));
+    auto zmm_lhs_col_1 = _mm512_broadcast_f32x4(_mm_loadu_ps(lhs[1].data()));
+    auto zmm_lhs_col_2 = _mm512_broadcast_f32x4(_mm_loadu_ps(lhs[2].data()));
+    auto zmm_lhs_col_3 = _mm512_broadcast_f32x4(_mm_loadu_ps(lhs[3].data()));
+    auto zmm_result = _mm512_mul_ps(zmm_lhs_col_0, splat_lanes_f32<0>(zmm_rhs));
+    zmm_result = _mm512_add_ps(
+        zmm_result, _mm512_mul_ps(zmm_lhs_col_1, splat_lanes_f32<1>(zmm_rhs)));
+    zmm_result = _mm512_add_ps(
+        zmm_result, _mm512_mul_ps(zmm_lhs_col_2, splat_lanes_f32<2>(zmm_rhs)));
+    zmm_result = _mm512_add_ps(
+        zmm_result, _mm512_mul_ps(zmm_lhs_col_3, splat_lanes_f32<3>(zmm_rhs)));
+    _mm512_storeu_ps(dst[0].data(), zmm_result);
+}
+
+template <typename T, SFINAE_MAT4_F64_AVX512_GUARD<T> = nullptr>
+MATH3D_INLINE auto kernel_matmul_mat4(Mat4Buffer<T>& dst,
+                                      const Mat4Buffer<T>& lhs,
+                                      const Mat4Buffer<T>& rhs) -> void {
+    // Same as the float32 version, but for two columns of the result at once
+    auto zmm_lhs_col_0 = _mm512_broadcast_f64x4(_mm256_loadu_pd(lhs[0].data()));
+    auto zmm_lhs_col_1 = _mm512_broadcast_f64x4(_mm256_loadu_pd(lhs[1].data()));
+    auto zmm_lhs_col_2 = _mm512_broadcast_f64x4(_mm256_loadu_pd(lhs[2].data()));
+    auto zmm_lhs_col_3 = _mm512_broadcast_f64x4(_mm256_loadu_pd(lhs[3].data()));
+    for (uint32_t k = 0; k < 2; ++k) {
+        auto zmm_rhs_cols = _mm512_loadu_pd(rhs[2 * k].data());
+        auto zmm_result =
+            _mm512_mul_pd(zmm_lhs_col_0, splat_lanes_f64<0>(zmm_rhs_cols));
+        zmm_result = _mm512_add_pd(
+            zmm_result,
+            _mm512_mul_pd(zmm_lhs_col_1, splat_lanes_f64<1>(zmm_rhs_cols)));
+        zmm_result = _mm512_add_pd(
+            zmm_result,
+            _mm512_mul_pd(zmm_lhs_col_2, splat_lanes_f64<2>(zmm_rhs_cols)));
+        zmm_result = _mm512_add_pd(
+            zmm_result,
+            _mm512_mul_pd(zmm_lhs_col_3, splat_lanes_f64<3>(zmm_rhs_cols)));
+        _mm512_storeu_pd(dst[2 * k].data(), zmm_result);
+    }
+}
+
+// ***************************************************************************//
+//               Dispatch AVX512-kernel for matrix-vector product             //
+// ***************************************************************************//
+
+template <typename T, SFINAE_MAT4_F32_AVX512_GUARD<T> = nullptr>
+MATH3D_INLINE auto kernel_matmul_vec_mat4(Vec4Buffer<T>& dst,
+                                          const Mat4Buffer<T>& mat,
+                                          const Vec4Buffer<T>& vec) -> void {
+    // Use the "linear combination view" of the matrix-vector product, with
+    // all the products v[j] * A[:,j] computed at once (one per 128-bit lane)
+    //
+    //             [ |]       [ |]        [ |]        [ |]
+    // A * v = v0 *|a0]+ v1 * |a1] + v2 * |a2] + v3 * |a3]
+    //             [ |]       [ |]        [ |]        [ |]
+    const auto idx = _mm512_setr_epi32(0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3,
+                                       3, 3);
+    auto zmm_vec = _mm512_permutexvar_ps(
+        idx, _mm512_castps128_ps512(_mm_loadu_ps(vec.data())));
+    auto zmm_prod = _mm512_mul_ps(_mm512_loadu_ps(mat[0].data()), zmm_vec);
+    // Reduce the 4 lanes: ((a0v0 + a1v1) + a2v2) + a3v3
+    auto xmm_result = _mm_add_ps(_mm512_castps512_ps128(zmm_prod),
+                                 _mm512_extractf32x4_ps(zmm_prod, 1));
+    xmm_result = _mm_add_ps(xmm_result, _mm512_extractf32x4_ps(zmm_prod, 2));
+    xmm_result = _mm_add_ps(xmm_result, _mm512_extractf32x4_ps(zmm_prod, 3));
+    _mm_storeu_ps(dst.data(), xmm_result);
+}
+
+template <typename T, SFINAE_MAT4_F64_AVX512_GUARD<T> = nullptr>
+MATH3D_INLINE auto kernel_matmul_vec_mat4(Vec4Buffer<T>& dst,
+                                          const Mat4Buffer<T>& mat,
+                                          const Vec4Buffer<T>& vec) -> void {
+    // Same as the float32 version, with the products of [a0, a1] and [a2, a3]
+    // in two registers (one per 256-bit lane)
+    auto zmm_vec = _mm512_castpd256_pd512(_mm256_loadu_pd(vec.data()));
+    auto zmm_vec_01 = _mm512_permutexvar_pd(
+        _mm512_setr_epi64(0, 0, 0, 0, 1, 1, 1, 1), zmm_vec);
+    auto zmm_vec_23 = _mm512_permutexvar_pd(
+        _mm512_setr_epi64(2, 2, 2, 2, 3, 3, 3, 3), zmm_vec);
+    auto zmm_prod_01 =
+        _mm512_mul_pd(_mm512_loadu_pd(mat[0].data()), zmm_vec_01);
+    auto zmm_prod_23 =
+        _mm512_mul_pd(_mm512_loadu_pd(mat[2].data()), zmm_vec_23);
+    auto ymm_result = _mm256_add_pd(_mm512_castpd512_pd256(zmm_prod_01),
+                                    _mm512_extractf64x4_pd(zmm_prod_01, 1));
+    ymm_result = _mm256_add_pd(ymm_result, _mm512_castpd512_pd256(zmm_prod_23));
+    ymm_result =
+        _mm256_add_pd(ymm_result, _mm512_extractf64x4_pd(zmm_prod_23, 1));
+    _mm256_storeu_pd(dst.data(), ymm_result);
+}
+
+}  // namespace avx512
+}  // namespace math
+
+#endif  // MATH3D_AVX512_ENABLED
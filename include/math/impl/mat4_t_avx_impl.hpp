@@ -5,6 +5,7 @@
 #include <immintrin.h>
 
 #include "../mat4_t_decl.hpp"
+#include "./vec3_t_avx_impl.hpp"
 
 /**
  * SSE instruction sets required for each kernel:
@@ -15,6 +16,11 @@
  * - kernel_hadamard_mat4           : AVX
  *   kernel_matmul_mat4             : AVX|FMA?(if available)
  *   kernel_matmul_vec_mat4         : AVX|FMA?(if available)
+ * - kernel_transpose_inplace_mat4  : AVX
+ * - kernel_determinant_mat4        : AVX
+ * - kernel_inverse_mat4            : AVX
+ * - kernel_inverse_rigid_mat4      : AVX
+ * - kernel_inverse_affine_mat4     : AVX
  *
  * Notes:
  * 0. Matrix order:
@@ -33,6 +39,11 @@
  *    the kernels mentioned above, but it'd require for the matrix storage
  *    layout to be row-major :/, unless it can be done in the linear-combination
  *    view of matrices and vectors
+ *
+ * 4. Inverse and determinant:
+ *    Both use a block-wise expansion of the matrix into 2x2 sub-matrices (see
+ *    kernel_inverse_mat4 for details). Each 2x2 block fits into a single xmm
+ *    register for float32, and into a single ymm register for float64
  */
 
 namespace math {
@@ -265,6 +276,242 @@ MATH3D_INLINE auto kernel_hadamard_mat4(Mat4Buffer<T>& dst,
     }
 }
 
+// ***************************************************************************//
+//         Dispatch AVX-kernels for transpose, determinant and inverse      //
+// ***************************************************************************//
+
+template <typename T>
+using SFINAE_MAT4_F32_XMM_GUARD = SFINAE_MAT4_F32_AVX_GUARD<T>;
+
+#include "./mat4_t_f32_xmm_impl.hpp"
+
+// The helpers below are the float64 versions of the 2x2 matrix helpers, with
+// the 2x2 matrix {m00, m01, m10, m11} stored in a ymm register. As AVX can't
+// shuffle across its 128-bit lanes, every permutation is built from in-lane
+// permutes and blends with the swapped lanes (swap = {m10, m11, m00, m01})
+
+/// Returns the 2x2 matrix product lhs * rhs
+inline auto mat2_mul_f64(__m256d lhs, __m256d rhs) -> __m256d {
+    auto rhs_swap = _mm256_permute2f128_pd(rhs, rhs, 0x01);
+    auto rhs_0303 = _mm256_blend_pd(rhs, rhs_swap, 0x06);  // {r0, r3, r0, r3}
+    auto rhs_2121 = _mm256_blend_pd(rhs, rhs_swap, 0x09);  // {r2, r1, r2, r1}
+    auto lhs_1032 = _mm256_permute_pd(lhs, 0x05);          // {l1, l0, l3, l2}
+    return _mm256_add_pd(_mm256_mul_pd(lhs, rhs_0303),
+                         _mm256_mul_pd(lhs_1032, rhs_2121));
+}
+
+/// Returns the 2x2 matrix product lhs# * rhs
+inline auto mat2_adjmul_f64(__m256d lhs, __m256d rhs) -> __m256d {
+    auto lhs_swap = _mm256_permute2f128_pd(lhs, lhs, 0x01);
+    auto lhs_3300 = _mm256_permute_pd(lhs_swap, 0x03);      // {l3, l3, l0, l0}
+    auto lhs_1122 = _mm256_permute_pd(lhs, 0x03);           // {l1, l1, l2, l2}
+    auto rhs_2301 = _mm256_permute2f128_pd(rhs, rhs, 0x01);  // {r2, r3, r0, r1}
+    return _mm256_sub_pd(_mm256_mul_pd(lhs_3300, rhs),
+                         _mm256_mul_pd(lhs_1122, rhs_2301));
+}
+
+/// Returns the 2x2 matrix product lhs * rhs#
+inline auto mat2_muladj_f64(__m256d lhs, __m256d rhs) -> __m256d {
+    auto rhs_swap = _mm256_permute2f128_pd(rhs, rhs, 0x01);
+    auto rhs_0303 = _mm256_blend_pd(rhs, rhs_swap, 0x06);  // {r0, r3, r0, r3}
+    auto rhs_3030 = _mm256_permute_pd(rhs_0303, 0x05);      // {r3, r0, r3, r0}
+    auto rhs_2121 = _mm256_blend_pd(rhs, rhs_swap, 0x09);  // {r2, r1, r2, r1}
+    auto lhs_1032 = _mm256_permute_pd(lhs, 0x05);          // {l1, l0, l3, l2}
+    return _mm256_sub_pd(_mm256_mul_pd(lhs, rhs_3030),
+                         _mm256_mul_pd(lhs_1032, rhs_2121));
+}
+
+/// Returns the determinant of the given 2x2 matrix, in all lanes
+inline auto mat2_det_f64(__m256d mat) -> __m256d {
+    auto mat_swap = _mm256_permute2f128_pd(mat, mat, 0x01);
+    auto mat_3210 = _mm256_permute_pd(mat_swap, 0x05);  // {m3, m2, m1, m0}
+    // {m0 * m3, m1 * m2, m2 * m1, m3 * m0} -> {det, det, -det, -det}
+    auto prods = _mm256_mul_pd(mat, mat_3210);
+    auto dets = _mm256_hsub_pd(prods, prods);
+    return _mm256_permute2f128_pd(dets, dets, 0x00);
+}
+
+/// Returns the trace of the 2x2 matrix product lhs * rhs, in all lanes
+inline auto mat2_trace_mul_f64(__m256d lhs, __m256d rhs) -> __m256d {
+    // tr(L * R) = l0 * r0 + l1 * r2 + l2 * r1 + l3 * r3
+    auto rhs_swap = _mm256_permute2f128_pd(rhs, rhs, 0x01);
+    auto rhs_3210 = _mm256_permute_pd(rhs_swap, 0x05);  // {r3, r2, r1, r0}
+    auto prods = _mm256_blend_pd(_mm256_mul_pd(lhs, rhs),
+                                 _mm256_mul_pd(lhs, rhs_3210), 0x06);
+    auto sums = _mm256_hadd_pd(prods, prods);
+    return _mm256_add_pd(sums, _mm256_permute2f128_pd(sums, sums, 0x01));
+}
+
+template <typename T, SFINAE_MAT4_F64_AVX_GUARD<T> = nullptr>
+MATH3D_INLINE auto kernel_transpose_inplace_mat4(Mat4Buffer<T>& mat) -> void {
+    auto ymm_col_0 = _mm256_loadu_pd(mat[0].data());
+    auto ymm_col_1 = _mm256_loadu_pd(mat[1].data());
+    auto ymm_col_2 = _mm256_loadu_pd(mat[2].data());
+    auto ymm_col_3 = _mm256_loadu_pd(mat[3].data());
+    // {m00, m01, m20, m21}, {m10, m11, m30, m31}, ...
+    auto ymm_tmp_0 = _mm256_unpacklo_pd(ymm_col_0, ymm_col_1);
+    auto ymm_tmp_1 = _mm256_unpackhi_pd(ymm_col_0, ymm_col_1);
+    auto ymm_tmp_2 = _mm256_unpacklo_pd(ymm_col_2, ymm_col_3);
+    auto ymm_tmp_3 = _mm256_unpackhi_pd(ymm_col_2, ymm_col_3);
+    _mm256_storeu_pd(mat[0].data(),
+                     _mm256_permute2f128_pd(ymm_tmp_0, ymm_tmp_2, 0x20));
+    _mm256_storeu_pd(mat[1].data(),
+                     _mm256_permute2f128_pd(ymm_tmp_1, ymm_tmp_3, 0x20));
+    _mm256_storeu_pd(mat[2].data(),
+                     _mm256_permute2f128_pd(ymm_tmp_0, ymm_tmp_2, 0x31));
+    _mm256_storeu_pd(mat[3].data(),
+                     _mm256_permute2f128_pd(ymm_tmp_1, ymm_tmp_3, 0x31));
+}
+
+template <typename T, SFINAE_MAT4_F64_AVX_GUARD<T> = nullptr>
+MATH3D_INLINE auto kernel_determinant_mat4(const Mat4Buffer<T>& mat) -> T {
+    // Same block-wise expansion as in the float32 version
+    auto ymm_col_0 = _mm256_loadu_pd(mat[0].data());
+    auto ymm_col_1 = _mm256_loadu_pd(mat[1].data());
+    auto ymm_col_2 = _mm256_loadu_pd(mat[2].data());
+    auto ymm_col_3 = _mm256_loadu_pd(mat[3].data());
+
+    auto ymm_a = _mm256_permute2f128_pd(ymm_col_0, ymm_col_1, 0x20);
+    auto ymm_b = _mm256_permute2f128_pd(ymm_col_0, ymm_col_1, 0x31);
+    auto ymm_c = _mm256_permute2f128_pd(ymm_col_2, ymm_col_3, 0x20);
+    auto ymm_d = _mm256_permute2f128_pd(ymm_col_2, ymm_col_3, 0x31);
+
+    auto ymm_d_c = mat2_adjmul_f64(ymm_d, ymm_c);
+    auto ymm_a_b = mat2_adjmul_f64(ymm_a, ymm_b);
+
+    auto ymm_det = _mm256_sub_pd(
+        _mm256_add_pd(_mm256_mul_pd(mat2_det_f64(ymm_a), mat2_det_f64(ymm_d)),
+                      _mm256_mul_pd(mat2_det_f64(ymm_b), mat2_det_f64(ymm_c))),
+        mat2_trace_mul_f64(ymm_a_b, ymm_d_c));
+    return _mm256_cvtsd_f64(ymm_det);
+}
+
+template <typename T, SFINAE_MAT4_F64_AVX_GUARD<T> = nullptr>
+MATH3D_INLINE auto kernel_inverse_mat4(Mat4Buffer<T>& dst,
+                                       const Mat4Buffer<T>& src) -> void {
+    // Same block-wise inverse as in the float32 version (see the notes there)
+    auto ymm_col_0 = _mm256_loadu_pd(src[0].data());
+    auto ymm_col_1 = _mm256_loadu_pd(src[1].data());
+    auto ymm_col_2 = _mm256_loadu_pd(src[2].data());
+    auto ymm_col_3 = _mm256_loadu_pd(src[3].data());
+
+    // 2x2 sub-matrices (each one in its own register)
+    auto ymm_a = _mm256_permute2f128_pd(ymm_col_0, ymm_col_1, 0x20);
+    auto ymm_b = _mm256_permute2f128_pd(ymm_col_0, ymm_col_1, 0x31);
+    auto ymm_c = _mm256_permute2f128_pd(ymm_col_2, ymm_col_3, 0x20);
+    auto ymm_d = _mm256_permute2f128_pd(ymm_col_2, ymm_col_3, 0x31);
+
+    auto ymm_det_a = mat2_det_f64(ymm_a);
+    auto ymm_det_b = mat2_det_f64(ymm_b);
+    auto ymm_det_c = mat2_det_f64(ymm_c);
+    auto ymm_det_d = mat2_det_f64(ymm_d);
+
+    auto ymm_d_c = mat2_adjmul_f64(ymm_d, ymm_c);
+    auto ymm_a_b = mat2_adjmul_f64(ymm_a, ymm_b);
+
+    auto ymm_x = _mm256_sub_pd(_mm256_mul_pd(ymm_det_d, ymm_a),
+                               mat2_mul_f64(ymm_b, ymm_d_c));
+    auto ymm_w = _mm256_sub_pd(_mm256_mul_pd(ymm_det_a, ymm_d),
+                               mat2_mul_f64(ymm_c, ymm_a_b));
+    auto ymm_y = _mm256_sub_pd(_mm256_mul_pd(ymm_det_b, ymm_c),
+                               mat2_muladj_f64(ymm_d, ymm_a_b));
+    auto ymm_z = _mm256_sub_pd(_mm256_mul_pd(ymm_det_c, ymm_b),
+                               mat2_muladj_f64(ymm_a, ymm_d_c));
+
+    auto ymm_det = _mm256_sub_pd(
+        _mm256_add_pd(_mm256_mul_pd(ymm_det_a, ymm_det_d),
+                      _mm256_mul_pd(ymm_det_b, ymm_det_c)),
+        mat2_trace_mul_f64(ymm_a_b, ymm_d_c));
+
+    // {1/|M|, -1/|M|, -1/|M|, 1/|M|} (signs of the adjugate of the blocks)
+    auto ymm_inv_det =
+        _mm256_div_pd(_mm256_setr_pd(1.0, -1.0, -1.0, 1.0), ymm_det);
+    ymm_x = _mm256_mul_pd(ymm_x, ymm_inv_det);
+    ymm_y = _mm256_mul_pd(ymm_y, ymm_inv_det);
+    ymm_z = _mm256_mul_pd(ymm_z, ymm_inv_det);
+    ymm_w = _mm256_mul_pd(ymm_w, ymm_inv_det);
+
+    // Take the adjugate of each block, and place them back into the columns:
+    // {x3, x1, y3, y1}, {x2, x0, y2, y0}, {z3, z1, w3, w1}, {z2, z0, w2, w0}
+    auto ymm_xy_lo = _mm256_permute2f128_pd(ymm_x, ymm_y, 0x20);
+    auto ymm_xy_hi = _mm256_permute2f128_pd(ymm_x, ymm_y, 0x31);
+    auto ymm_zw_lo = _mm256_permute2f128_pd(ymm_z, ymm_w, 0x20);
+    auto ymm_zw_hi = _mm256_permute2f128_pd(ymm_z, ymm_w, 0x31);
+    _mm256_storeu_pd(dst[0].data(),
+                     _mm256_shuffle_pd(ymm_xy_hi, ymm_xy_lo, 0x0f));
+    _mm256_storeu_pd(dst[1].data(),
+                     _mm256_shuffle_pd(ymm_xy_hi, ymm_xy_lo, 0x00));
+    _mm256_storeu_pd(dst[2].data(),
+                     _mm256_shuffle_pd(ymm_zw_hi, ymm_zw_lo, 0x0f));
+    _mm256_storeu_pd(dst[3].data(),
+                     _mm256_shuffle_pd(ymm_zw_hi, ymm_zw_lo, 0x00));
+}
+
+// ***************************************************************************//
+//         Dispatch AVX-kernels for the inverse of rigid|affine matrices      //
+// ***************************************************************************//
+
+// The float32 kernels are in mat4_t_f32_xmm_impl.hpp (included above)
+
+/// Stores [M | -M * pos] into dst, given the rows of the 3x3 block M
+inline auto store_inverse_affine_f64(Mat4Buffer<float64_t>& dst,
+                                     __m256d ymm_row_0, __m256d ymm_row_1,
+                                     __m256d ymm_row_2, const float64_t* pos)
+    -> void {
+    // Same transpose as in kernel_transpose_inplace_mat4, with a zero 4th row
+    auto ymm_zero = _mm256_setzero_pd();
+    auto ymm_tmp_0 = _mm256_unpacklo_pd(ymm_row_0, ymm_row_1);
+    auto ymm_tmp_1 = _mm256_unpackhi_pd(ymm_row_0, ymm_row_1);
+    auto ymm_tmp_2 = _mm256_unpacklo_pd(ymm_row_2, ymm_zero);
+    auto ymm_tmp_3 = _mm256_unpackhi_pd(ymm_row_2, ymm_zero);
+    auto ymm_col_0 = _mm256_permute2f128_pd(ymm_tmp_0, ymm_tmp_2, 0x20);
+    auto ymm_col_1 = _mm256_permute2f128_pd(ymm_tmp_1, ymm_tmp_3, 0x20);
+    auto ymm_col_2 = _mm256_permute2f128_pd(ymm_tmp_0, ymm_tmp_2, 0x31);
+    auto ymm_trans = _mm256_add_pd(
+        _mm256_add_pd(_mm256_mul_pd(ymm_col_0, _mm256_set1_pd(pos[0])),
+                      _mm256_mul_pd(ymm_col_1, _mm256_set1_pd(pos[1]))),
+        _mm256_mul_pd(ymm_col_2, _mm256_set1_pd(pos[2])));
+    ymm_trans = _mm256_sub_pd(ymm_zero, ymm_trans);
+    ymm_trans = _mm256_blend_pd(ymm_trans, _mm256_set1_pd(1.0), 0x08);
+    _mm256_storeu_pd(dst[0].data(), ymm_col_0);
+    _mm256_storeu_pd(dst[1].data(), ymm_col_1);
+    _mm256_storeu_pd(dst[2].data(), ymm_col_2);
+    _mm256_storeu_pd(dst[3].data(), ymm_trans);
+}
+
+template <typename T, SFINAE_MAT4_F64_AVX_GUARD<T> = nullptr>
+MATH3D_INLINE auto kernel_inverse_rigid_mat4(Mat4Buffer<T>& dst,
+                                             const Mat4Buffer<T>& src) -> void {
+    store_inverse_affine_f64(dst, _mm256_loadu_pd(src[0].data()),
+                             _mm256_loadu_pd(src[1].data()),
+                             _mm256_loadu_pd(src[2].data()), src[3].data());
+}
+
+template <typename T, SFINAE_MAT4_F64_AVX_GUARD<T> = nullptr>
+MATH3D_INLINE auto kernel_inverse_affine_mat4(Mat4Buffer<T>& dst,
+                                              const Mat4Buffer<T>& src)
+    -> void {
+    // Same approach as in the float32 version (cross products of the columns)
+    auto ymm_col_0 = _mm256_loadu_pd(src[0].data());
+    auto ymm_col_1 = _mm256_loadu_pd(src[1].data());
+    auto ymm_col_2 = _mm256_loadu_pd(src[2].data());
+    auto ymm_row_0 = cross_f64(ymm_col_1, ymm_col_2);
+    auto ymm_row_1 = cross_f64(ymm_col_2, ymm_col_0);
+    auto ymm_row_2 = cross_f64(ymm_col_0, ymm_col_1);
+    // det(A) = c0 . (c1 x c2), adding up only the first 3 lanes of the product
+    auto ymm_prod = _mm256_mul_pd(ymm_col_0, ymm_row_0);
+    auto xmm_prod_lo = _mm256_castpd256_pd128(ymm_prod);
+    auto xmm_prod_hi = _mm256_extractf128_pd(ymm_prod, 1);
+    auto xmm_det = _mm_add_sd(
+        _mm_add_sd(xmm_prod_lo, _mm_unpackhi_pd(xmm_prod_lo, xmm_prod_lo)),
+        xmm_prod_hi);
+    auto ymm_inv_det = _mm256_set1_pd(1.0 / _mm_cvtsd_f64(xmm_det));
+    store_inverse_affine_f64(dst, _mm256_mul_pd(ymm_row_0, ymm_inv_det),
+                             _mm256_mul_pd(ymm_row_1, ymm_inv_det),
+                             _mm256_mul_pd(ymm_row_2, ymm_inv_det),
+                             src[3].data());
+}
+
 }  // namespace avx
 }  // namespace math
 
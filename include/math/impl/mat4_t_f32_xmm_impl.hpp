@@ -0,0 +1,232 @@
+// No include guard, see the notes below
+/**
+ * Matrix4 float32 kernels over xmm registers (SSE and AVX)
+ *
+ * Each column of a float32 matrix fits into a single xmm register, so AVX has
+ * nothing to add to these kernels over SSE (the ymm registers would only hold
+ * two columns, which the block-wise expansions below can't make use of).
+ * Hence they're written once here, and this header is included into both the
+ * sse and avx namespaces (see mat4_t_sse_impl.hpp and mat4_t_avx_impl.hpp),
+ * which have to provide:
+ *
+ * - SFINAE_MAT4_F32_XMM_GUARD : the float32 guard of the namespace
+ * - Mat4Buffer, cross_f32     : as in the rest of the kernels
+ */
+
+// ***************************************************************************//
+//                Kernels for transpose, determinant and inverse              //
+// ***************************************************************************//
+
+/// Returns {lhs[l0], lhs[l1], rhs[l2], rhs[l3]} (as in _mm_shuffle_ps)
+template <uint l3, uint l2, uint l1, uint l0>
+MATH3D_INLINE auto shuffle_f32(__m128 lhs, __m128 rhs) -> __m128 {
+    return _mm_shuffle_ps(
+        lhs, rhs, static_cast<int>(math::ShuffleMask<l3, l2, l1, l0>::value));
+}
+
+/// Returns {vec[l0], vec[l1], vec[l2], vec[l3]}
+template <uint l3, uint l2, uint l1, uint l0>
+MATH3D_INLINE auto swizzle_f32(__m128 vec) -> __m128 {
+    return shuffle_f32<l3, l2, l1, l0>(vec, vec);
+}
+
+// The helpers below work on 2x2 matrices stored in a single register, in the
+// order {m00, m01, m10, m11}. Recall that the adjugate of a 2x2 matrix M is:
+//   M# = {m11, -m01, -m10, m00}, so M * M# = M# * M = |M| * I
+
+/// Returns the 2x2 matrix product lhs * rhs
+inline auto mat2_mul_f32(__m128 lhs, __m128 rhs) -> __m128 {
+    return _mm_add_ps(
+        _mm_mul_ps(lhs, swizzle_f32<3, 0, 3, 0>(rhs)),
+        _mm_mul_ps(swizzle_f32<2, 3, 0, 1>(lhs), swizzle_f32<1, 2, 1, 2>(rhs)));
+}
+
+/// Returns the 2x2 matrix product lhs# * rhs
+inline auto mat2_adjmul_f32(__m128 lhs, __m128 rhs) -> __m128 {
+    return _mm_sub_ps(
+        _mm_mul_ps(swizzle_f32<0, 0, 3, 3>(lhs), rhs),
+        _mm_mul_ps(swizzle_f32<2, 2, 1, 1>(lhs), swizzle_f32<1, 0, 3, 2>(rhs)));
+}
+
+/// Returns the 2x2 matrix product lhs * rhs#
+inline auto mat2_muladj_f32(__m128 lhs, __m128 rhs) -> __m128 {
+    return _mm_sub_ps(
+        _mm_mul_ps(lhs, swizzle_f32<0, 3, 0, 3>(rhs)),
+        _mm_mul_ps(swizzle_f32<2, 3, 0, 1>(lhs), swizzle_f32<1, 2, 1, 2>(rhs)));
+}
+
+template <typename T, SFINAE_MAT4_F32_XMM_GUARD<T> = nullptr>
+MATH3D_INLINE auto kernel_transpose_inplace_mat4(Mat4Buffer<T>& mat) -> void {
+    auto xmm_col_0 = _mm_loadu_ps(mat[0].data());
+    auto xmm_col_1 = _mm_loadu_ps(mat[1].data());
+    auto xmm_col_2 = _mm_loadu_ps(mat[2].data());
+    auto xmm_col_3 = _mm_loadu_ps(mat[3].data());
+    // Interleaves the columns using unpack + movelh/movehl
+    _MM_TRANSPOSE4_PS(xmm_col_0, xmm_col_1, xmm_col_2, xmm_col_3);
+    _mm_storeu_ps(mat[0].data(), xmm_col_0);
+    _mm_storeu_ps(mat[1].data(), xmm_col_1);
+    _mm_storeu_ps(mat[2].data(), xmm_col_2);
+    _mm_storeu_ps(mat[3].data(), xmm_col_3);
+}
+
+template <typename T, SFINAE_MAT4_F32_XMM_GUARD<T> = nullptr>
+MATH3D_INLINE auto kernel_determinant_mat4(const Mat4Buffer<T>& mat) -> T {
+    // Same block-wise expansion as in the inverse kernel (see below), i.e.
+    //   |M| = |A| * |D| + |B| * |C| - tr((A# * B) * (D# * C))
+    auto xmm_col_0 = _mm_loadu_ps(mat[0].data());
+    auto xmm_col_1 = _mm_loadu_ps(mat[1].data());
+    auto xmm_col_2 = _mm_loadu_ps(mat[2].data());
+    auto xmm_col_3 = _mm_loadu_ps(mat[3].data());
+
+    auto xmm_a = _mm_movelh_ps(xmm_col_0, xmm_col_1);
+    auto xmm_b = _mm_movehl_ps(xmm_col_1, xmm_col_0);
+    auto xmm_c = _mm_movelh_ps(xmm_col_2, xmm_col_3);
+    auto xmm_d = _mm_movehl_ps(xmm_col_3, xmm_col_2);
+
+    // {|A|, |B|, |C|, |D|}
+    auto xmm_det_sub = _mm_sub_ps(
+        _mm_mul_ps(shuffle_f32<2, 0, 2, 0>(xmm_col_0, xmm_col_2),
+                   shuffle_f32<3, 1, 3, 1>(xmm_col_1, xmm_col_3)),
+        _mm_mul_ps(shuffle_f32<3, 1, 3, 1>(xmm_col_0, xmm_col_2),
+                   shuffle_f32<2, 0, 2, 0>(xmm_col_1, xmm_col_3)));
+
+    auto xmm_d_c = mat2_adjmul_f32(xmm_d, xmm_c);
+    auto xmm_a_b = mat2_adjmul_f32(xmm_a, xmm_b);
+
+    // {|A| * |D|, |B| * |C|, -, -}
+    auto xmm_det_prods =
+        _mm_mul_ps(xmm_det_sub, swizzle_f32<0, 1, 2, 3>(xmm_det_sub));
+    auto xmm_tr = _mm_mul_ps(xmm_a_b, swizzle_f32<3, 1, 2, 0>(xmm_d_c));
+    xmm_tr = _mm_hadd_ps(xmm_tr, xmm_tr);
+    xmm_tr = _mm_hadd_ps(xmm_tr, xmm_tr);
+    auto xmm_det = _mm_sub_ps(
+        _mm_add_ss(xmm_det_prods, swizzle_f32<1, 1, 1, 1>(xmm_det_prods)),
+        xmm_tr);
+    return _mm_cvtss_f32(xmm_det);
+}
+
+template <typename T, SFINAE_MAT4_F32_XMM_GUARD<T> = nullptr>
+MATH3D_INLINE auto kernel_inverse_mat4(Mat4Buffer<T>& dst,
+                                       const Mat4Buffer<T>& src) -> void {
+    // Implementation adapted from Eric Zhang's block-wise inverse, see the
+    // post "Fast 4x4 Matrix Inverse with SSE SIMD, Explained" (2019):
+    //
+    //       | A  B |                      1   | X  Y |
+    //   M = |      |  ->  M^-1 = ------- * |      |, where
+    //       | C  D |                     |M|  | Z  W |
+    //
+    //   X# = |D| * A - B * (D# * C)     Y# = |B| * C - D * (A# * B)#
+    //   Z# = |C| * B - A * (D# * C)#    W# = |A| * D - C * (A# * B)
+    //   |M| = |A| * |D| + |B| * |C| - tr((A# * B) * (D# * C))
+    //
+    // The algorithm expects a row-major matrix. Our storage is column-major,
+    // i.e. we're actually inverting the transpose of the matrix, and as the
+    // result is stored in the same order we get (M^T)^-1^T = M^-1 for free
+    auto xmm_col_0 = _mm_loadu_ps(src[0].data());
+    auto xmm_col_1 = _mm_loadu_ps(src[1].data());
+    auto xmm_col_2 = _mm_loadu_ps(src[2].data());
+    auto xmm_col_3 = _mm_loadu_ps(src[3].data());
+
+    // 2x2 sub-matrices (each one in its own register)
+    auto xmm_a = _mm_movelh_ps(xmm_col_0, xmm_col_1);
+    auto xmm_b = _mm_movehl_ps(xmm_col_1, xmm_col_0);
+    auto xmm_c = _mm_movelh_ps(xmm_col_2, xmm_col_3);
+    auto xmm_d = _mm_movehl_ps(xmm_col_3, xmm_col_2);
+
+    // {|A|, |B|, |C|, |D|}
+    auto xmm_det_sub = _mm_sub_ps(
+        _mm_mul_ps(shuffle_f32<2, 0, 2, 0>(xmm_col_0, xmm_col_2),
+                   shuffle_f32<3, 1, 3, 1>(xmm_col_1, xmm_col_3)),
+        _mm_mul_ps(shuffle_f32<3, 1, 3, 1>(xmm_col_0, xmm_col_2),
+                   shuffle_f32<2, 0, 2, 0>(xmm_col_1, xmm_col_3)));
+    auto xmm_det_a = swizzle_f32<0, 0, 0, 0>(xmm_det_sub);
+    auto xmm_det_b = swizzle_f32<1, 1, 1, 1>(xmm_det_sub);
+    auto xmm_det_c = swizzle_f32<2, 2, 2, 2>(xmm_det_sub);
+    auto xmm_det_d = swizzle_f32<3, 3, 3, 3>(xmm_det_sub);
+
+    auto xmm_d_c = mat2_adjmul_f32(xmm_d, xmm_c);
+    auto xmm_a_b = mat2_adjmul_f32(xmm_a, xmm_b);
+
+    auto xmm_x = _mm_sub_ps(_mm_mul_ps(xmm_det_d, xmm_a),
+                            mat2_mul_f32(xmm_b, xmm_d_c));
+    auto xmm_w = _mm_sub_ps(_mm_mul_ps(xmm_det_a, xmm_d),
+                            mat2_mul_f32(xmm_c, xmm_a_b));
+    auto xmm_y = _mm_sub_ps(_mm_mul_ps(xmm_det_b, xmm_c),
+                            mat2_muladj_f32(xmm_d, xmm_a_b));
+    auto xmm_z = _mm_sub_ps(_mm_mul_ps(xmm_det_c, xmm_b),
+                            mat2_muladj_f32(xmm_a, xmm_d_c));
+
+    auto xmm_tr = _mm_mul_ps(xmm_a_b, swizzle_f32<3, 1, 2, 0>(xmm_d_c));
+    xmm_tr = _mm_hadd_ps(xmm_tr, xmm_tr);
+    xmm_tr = _mm_hadd_ps(xmm_tr, xmm_tr);
+    auto xmm_det = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(xmm_det_a, xmm_det_d),
+                                         _mm_mul_ps(xmm_det_b, xmm_det_c)),
+                              xmm_tr);
+
+    // {1/|M|, -1/|M|, -1/|M|, 1/|M|} (signs of the adjugate of the blocks)
+    auto xmm_inv_det =
+        _mm_div_ps(_mm_setr_ps(1.0F, -1.0F, -1.0F, 1.0F), xmm_det);
+    xmm_x = _mm_mul_ps(xmm_x, xmm_inv_det);
+    xmm_y = _mm_mul_ps(xmm_y, xmm_inv_det);
+    xmm_z = _mm_mul_ps(xmm_z, xmm_inv_det);
+    xmm_w = _mm_mul_ps(xmm_w, xmm_inv_det);
+
+    // Take the adjugate of each block, and place them back into the columns
+    _mm_storeu_ps(dst[0].data(), shuffle_f32<1, 3, 1, 3>(xmm_x, xmm_y));
+    _mm_storeu_ps(dst[1].data(), shuffle_f32<0, 2, 0, 2>(xmm_x, xmm_y));
+    _mm_storeu_ps(dst[2].data(), shuffle_f32<1, 3, 1, 3>(xmm_z, xmm_w));
+    _mm_storeu_ps(dst[3].data(), shuffle_f32<0, 2, 0, 2>(xmm_z, xmm_w));
+}
+
+// ***************************************************************************//
+//                Kernels for the inverse of rigid|affine matrices            //
+// ***************************************************************************//
+
+/// Stores [M | -M * pos] into dst, given the rows of the 3x3 block M
+inline auto store_inverse_affine_f32(Mat4Buffer<float32_t>& dst,
+                                     __m128 xmm_row_0, __m128 xmm_row_1,
+                                     __m128 xmm_row_2, const float32_t* pos)
+    -> void {
+    // The columns of M are the rows of its transpose (lane 3 ends up zeroed)
+    auto xmm_row_3 = _mm_setzero_ps();
+    _MM_TRANSPOSE4_PS(xmm_row_0, xmm_row_1, xmm_row_2, xmm_row_3);
+    auto xmm_trans = _mm_add_ps(
+        _mm_add_ps(_mm_mul_ps(xmm_row_0, _mm_set1_ps(pos[0])),
+                   _mm_mul_ps(xmm_row_1, _mm_set1_ps(pos[1]))),
+        _mm_mul_ps(xmm_row_2, _mm_set1_ps(pos[2])));
+    xmm_trans = _mm_sub_ps(_mm_setzero_ps(), xmm_trans);
+    xmm_trans = _mm_blend_ps(xmm_trans, _mm_set1_ps(1.0F), 0x08);
+    _mm_storeu_ps(dst[0].data(), xmm_row_0);
+    _mm_storeu_ps(dst[1].data(), xmm_row_1);
+    _mm_storeu_ps(dst[2].data(), xmm_row_2);
+    _mm_storeu_ps(dst[3].data(), xmm_trans);
+}
+
+template <typename T, SFINAE_MAT4_F32_XMM_GUARD<T> = nullptr>
+MATH3D_INLINE auto kernel_inverse_rigid_mat4(Mat4Buffer<T>& dst,
+                                             const Mat4Buffer<T>& src) -> void {
+    // inv([R | p]) = [R^T | -R^T p], and the rows of R^T are the columns of R
+    store_inverse_affine_f32(dst, _mm_loadu_ps(src[0].data()),
+                             _mm_loadu_ps(src[1].data()),
+                             _mm_loadu_ps(src[2].data()), src[3].data());
+}
+
+template <typename T, SFINAE_MAT4_F32_XMM_GUARD<T> = nullptr>
+MATH3D_INLINE auto kernel_inverse_affine_mat4(Mat4Buffer<T>& dst,
+                                              const Mat4Buffer<T>& src)
+    -> void {
+    // inv([A | p]) = [inv(A) | -inv(A) p], where the rows of inv(A) are the
+    // cross products of the columns of A, divided by det(A) = c0 . (c1 x c2)
+    auto xmm_col_0 = _mm_loadu_ps(src[0].data());
+    auto xmm_col_1 = _mm_loadu_ps(src[1].data());
+    auto xmm_col_2 = _mm_loadu_ps(src[2].data());
+    auto xmm_row_0 = cross_f32(xmm_col_1, xmm_col_2);
+    auto xmm_row_1 = cross_f32(xmm_col_2, xmm_col_0);
+    auto xmm_row_2 = cross_f32(xmm_col_0, xmm_col_1);
+    auto xmm_inv_det = _mm_div_ps(_mm_set1_ps(1.0F),
+                                  _mm_dp_ps(xmm_col_0, xmm_row_0, 0x7f));
+    store_inverse_affine_f32(dst, _mm_mul_ps(xmm_row_0, xmm_inv_det),
+                             _mm_mul_ps(xmm_row_1, xmm_inv_det),
+                             _mm_mul_ps(xmm_row_2, xmm_inv_det),
+                             src[3].data());
+}
@@ -0,0 +1,148 @@
+#pragma once
+
+#if defined(MATH3D_FMA_ENABLED)
+
+#include <immintrin.h>
+
+#include "../mat4_t_decl.hpp"
+
+/**
+ * FMA instruction sets required for each kernel:
+ *
+ * - kernel_matmul_mat4             : AVX|FMA
+ * - kernel_matmul_vec_mat4         : AVX|FMA
+ *
+ * Notes:
+ * 0. Matrix order:
+ *    Our matrices' internal storage layout is column-major order
+ *
+ * 1. Linear-combination view:
+ *    Each column of the result is a linear combination of the columns of the
+ *    left-hand side, weighted by the entries of the matching column of the
+ *    right-hand side (or of the vector). This maps directly to the column-major
+ *    storage, so every term after the first one is a single fused multiply-add
+ *    of a broadcast scalar and a loaded column (no transposes required):
+ *
+ *        (A * B)[:,k] = fma(b3k, a3, fma(b2k, a2, fma(b1k, a1, b0k * a0)))
+ *
+ * 2. Rounding:
+ *    Each fused multiply-add rounds once instead of twice, so the results can
+ *    differ from the SSE|AVX kernels in the last bits (and are usually closer
+ *    to the exact result)
+ *
+ * 3. For float32 each column fits into an xmm register, and for float64 each
+ *    column fits into a ymm register
+ */
+
+namespace math {
+namespace fma3 {
+
+template <typename T>
+using Mat4Buffer = typename Matrix4<T>::BufferType;
+
+template <typename T>
+using Vec4Buffer = typename Vector4<T>::BufferType;
+
+template <typename T>
+using SFINAE_MAT4_F32_FMA_GUARD =
+    typename std::enable_if<CpuHasFMA<T>::value && IsFloat32<T>::value>::type*;
+
+template <typename T>
+using SFINAE_MAT4_F64_FMA_GUARD =
+    typename std::enable_if<CpuHasFMA<T>::value && IsFloat64<T>::value>::type*;
+
+// ***************************************************************************//
+//                Dispatch FMA-kernel for matrix-matrix product               //
+// ***************************************************************************//
+
+template <typename T, SFINAE_MAT4_F32_FMA_GUARD<T> = nullptr>
+MATH3D_INLINE auto kernel_matmul_mat4(Mat4Buffer<T>& dst,
+                                      const Mat4Buffer<T>& lhs,
+                                      const Mat4Buffer<T>& rhs) -> void {
+    // The columns of lhs are shared by all columns of the result, so keep them
+    // in registers (this also allows dst to alias lhs or rhs)
+    auto xmm_lhs_0 = _mm_loadu_ps(lhs[0].data());
+    auto xmm_lhs_1 = _mm_loadu_ps(lhs[1].data());
+    auto xmm_lhs_2 = _mm_loadu_ps(lhs[2].data());
+    auto xmm_lhs_3 = _mm_loadu_ps(lhs[3].data());
+    __m128 xmm_result_cols[Matrix4<T>::MATRIX_SIZE];
+    for (uint32_t k = 0; k < Matrix4<T>::MATRIX_SIZE; ++k) {
+        //                              j=3            [      |     ]
+        // A * v = (lhs * rhs)[:,k] = SUM   rhs[j,k] * |  lhs[:,j]  ]
+        //                              j=0            [      |     ]
+        auto xmm_col_k = _mm_mul_ps(_mm_set1_ps(rhs[k][0]), xmm_lhs_0);
+        xmm_col_k = _mm_fmadd_ps(_mm_set1_ps(rhs[k][1]), xmm_lhs_1, xmm_col_k);
+        xmm_col_k = _mm_fmadd_ps(_mm_set1_ps(rhs[k][2]), xmm_lhs_2, xmm_col_k);
+        xmm_result_cols[k] =
+            _mm_fmadd_ps(_mm_set1_ps(rhs[k][3]), xmm_lhs_3, xmm_col_k);
+    }
+    for (uint32_t k = 0; k < Matrix4<T>::MATRIX_SIZE; ++k) {
+        _mm_storeu_ps(dst[k].data(), xmm_result_cols[k]);
+    }
+}
+
+template <typename T, SFINAE_MAT4_F64_FMA_GUARD<T> = nullptr>
+MATH3D_INLINE auto kernel_matmul_mat4(Mat4Buffer<T>& dst,
+                                      const Mat4Buffer<T>& lhs,
+                                      const Mat4Buffer<T>& rhs) -> void {
+    // Same as the float32 version, but each column is a ymm register
+    auto ymm_lhs_0 = _mm256_loadu_pd(lhs[0].data());
+    auto ymm_lhs_1 = _mm256_loadu_pd(lhs[1].data());
+    auto ymm_lhs_2 = _mm256_loadu_pd(lhs[2].data());
+    auto ymm_lhs_3 = _mm256_loadu_pd(lhs[3].data());
+    __m256d ymm_result_cols[Matrix4<T>::MATRIX_SIZE];
+    for (uint32_t k = 0; k < Matrix4<T>::MATRIX_SIZE; ++k) {
+        auto ymm_col_k = _mm256_mul_pd(_mm256_set1_pd(rhs[k][0]), ymm_lhs_0);
+        ymm_col_k =
+            _mm256_fmadd_pd(_mm256_set1_pd(rhs[k][1]), ymm_lhs_1, ymm_col_k);
+        ymm_col_k =
+            _mm256_fmadd_pd(_mm256_set1_pd(rhs[k][2]), ymm_lhs_2, ymm_col_k);
+        ymm_result_cols[k] =
+            _mm256_fmadd_pd(_mm256_set1_pd(rhs[k][3]), ymm_lhs_3, ymm_col_k);
+    }
+    for (uint32_t k = 0; k < Matrix4<T>::MATRIX_SIZE; ++k) {
+        _mm256_storeu_pd(dst[k].data(), ymm_result_cols[k]);
+    }
+}
+
+// ***************************************************************************//
+//                Dispatch FMA-kernel for matrix-vector product               //
+// ***************************************************************************//
+
+template <typename T, SFINAE_MAT4_F32_FMA_GUARD<T> = nullptr>
+MATH3D_INLINE auto kernel_matmul_vec_mat4(Vec4Buffer<T>& dst,
+                                          const Mat4Buffer<T>& mat,
+                                          const Vec4Buffer<T>& vec) -> void {
+    //             [ |]       [ |]        [ |]        [ |]
+    // A * v = v0 *|a0]+ v1 * |a1] + v2 * |a2] + v3 * |a3]
+    //             [ |]       [ |]        [ |]        [ |]
+    auto xmm_result =
+        _mm_mul_ps(_mm_set1_ps(vec[0]), _mm_loadu_ps(mat[0].data()));
+    xmm_result = _mm_fmadd_ps(_mm_set1_ps(vec[1]), _mm_loadu_ps(mat[1].data()),
+                              xmm_result);
+    xmm_result = _mm_fmadd_ps(_mm_set1_ps(vec[2]), _mm_loadu_ps(mat[2].data()),
+                              xmm_result);
+    xmm_result = _mm_fmadd_ps(_mm_set1_ps(vec[3]), _mm_loadu_ps(mat[3].data()),
+                              xmm_result);
+    _mm_storeu_ps(dst.data(), xmm_result);
+}
+
+template <typename T, SFINAE_MAT4_F64_FMA_GUARD<T> = nullptr>
+MATH3D_INLINE auto kernel_matmul_vec_mat4(Vec4Buffer<T>& dst,
+                                          const Mat4Buffer<T>& mat,
+                                          const Vec4Buffer<T>& vec) -> void {
+    auto ymm_result =
+        _mm256_mul_pd(_mm256_set1_pd(vec[0]), _mm256_loadu_pd(mat[0].data()));
+    ymm_result = _mm256_fmadd_pd(_mm256_set1_pd(vec[1]),
+                                 _mm256_loadu_pd(mat[1].data()), ymm_result);
+    ymm_result = _mm256_fmadd_pd(_mm256_set1_pd(vec[2]),
+                                 _mm256_loadu_pd(mat[2].data()), ymm_result);
+    ymm_result = _mm256_fmadd_pd(_mm256_set1_pd(vec[3]),
+                                 _mm256_loadu_pd(mat[3].data()), ymm_result);
+    _mm256_storeu_pd(dst.data(), ymm_result);
+}
+
+}  // namespace fma3
+}  // namespace math
+
+#endif  // MATH3D_FMA_ENABLED
@@ -132,6 +132,101 @@ MATH3D_INLINE auto kernel_inverse_mat4(Mat4Buffer<T>& dst,
     dst[3][3] = (m22 * m0101 - m12 * m0201 + m02 * m1201) * inv_det;
 }
 
+template <typename T>
+MATH3D_INLINE auto kernel_is_affine_mat4(const Mat4Buffer<T>& mat, T tolerance)
+    -> bool {
+    using std::abs;
+    return abs(mat[0][3]) < tolerance && abs(mat[1][3]) < tolerance &&
+           abs(mat[2][3]) < tolerance &&
+           abs(mat[3][3] - static_cast<T>(1.0)) < tolerance;
+}
+
+template <typename T>
+MATH3D_INLINE auto kernel_is_rigid_mat4(const Mat4Buffer<T>& mat, T tolerance)
+    -> bool {
+    using std::abs;
+    if (!kernel_is_affine_mat4<T>(mat, tolerance)) {
+        return false;
+    }
+    // The columns of the rotation block must be orthonormal (R^T R = I) ...
+    for (uint32_t i = 0; i < 3; ++i) {
+        for (uint32_t j = i; j < 3; ++j) {
+            auto dot = mat[i][0] * mat[j][0] + mat[i][1] * mat[j][1] +
+                       mat[i][2] * mat[j][2];
+            auto expected = static_cast<T>(i == j ? 1.0 : 0.0);
+            if (abs(dot - expected) > tolerance) {
+                return false;
+            }
+        }
+    }
+    // ... and right-handed, (c0 x c1) . c2 = det(R) = +1
+    auto det = (mat[0][1] * mat[1][2] - mat[0][2] * mat[1][1]) * mat[2][0] +
+               (mat[0][2] * mat[1][0] - mat[0][0] * mat[1][2]) * mat[2][1] +
+               (mat[0][0] * mat[1][1] - mat[0][1] * mat[1][0]) * mat[2][2];
+    return abs(det - static_cast<T>(1.0)) < tolerance;
+}
+
+template <typename T>
+MATH3D_INLINE auto kernel_inverse_rigid_mat4(Mat4Buffer<T>& dst,
+                                             const Mat4Buffer<T>& src) -> void {
+    // inv([R | p]) = [R^T | -R^T p]
+    const T px = src[3][0];
+    const T py = src[3][1];
+    const T pz = src[3][2];
+    for (uint32_t i = 0; i < 3; ++i) {
+        const T r0 = src[i][0];
+        const T r1 = src[i][1];
+        const T r2 = src[i][2];
+        dst[0][i] = r0;
+        dst[1][i] = r1;
+        dst[2][i] = r2;
+        dst[3][i] = -(r0 * px + r1 * py + r2 * pz);
+    }
+    dst[0][3] = static_cast<T>(0.0);
+    dst[1][3] = static_cast<T>(0.0);
+    dst[2][3] = static_cast<T>(0.0);
+    dst[3][3] = static_cast<T>(1.0);
+}
+
+template <typename T>
+MATH3D_INLINE auto kernel_inverse_affine_mat4(Mat4Buffer<T>& dst,
+                                              const Mat4Buffer<T>& src)
+    -> void {
+    // inv([A | p]) = [inv(A) | -inv(A) p], where the rows of inv(A) are the
+    // cross products of the columns of A, divided by det(A) = c0 . (c1 x c2)
+    const auto& c0 = src[0];
+    const auto& c1 = src[1];
+    const auto& c2 = src[2];
+    const T rows[3][3] = {{c1[1] * c2[2] - c1[2] * c2[1],
+                           c1[2] * c2[0] - c1[0] * c2[2],
+                           c1[0] * c2[1] - c1[1] * c2[0]},
+                          {c2[1] * c0[2] - c2[2] * c0[1],
+                           c2[2] * c0[0] - c2[0] * c0[2],
+                           c2[0] * c0[1] - c2[1] * c0[0]},
+                          {c0[1] * c1[2] - c0[2] * c1[1],
+                           c0[2] * c1[0] - c0[0] * c1[2],
+                           c0[0] * c1[1] - c0[1] * c1[0]}};
+    const T det = c0[0] * rows[0][0] + c0[1] * rows[0][1] + c0[2] * rows[0][2];
+    const T inv_det = static_cast<T>(1.0) / det;
+
+    const T px = src[3][0];
+    const T py = src[3][1];
+    const T pz = src[3][2];
+    for (uint32_t i = 0; i < 3; ++i) {
+        const T r0 = rows[i][0] * inv_det;
+        const T r1 = rows[i][1] * inv_det;
+        const T r2 = rows[i][2] * inv_det;
+        dst[0][i] = r0;
+        dst[1][i] = r1;
+        dst[2][i] = r2;
+        dst[3][i] = -(r0 * px + r1 * py + r2 * pz);
+    }
+    dst[0][3] = static_cast<T>(0.0);
+    dst[1][3] = static_cast<T>(0.0);
+    dst[2][3] = static_cast<T>(0.0);
+    dst[3][3] = static_cast<T>(1.0);
+}
+
 template <typename T>
 MATH3D_INLINE auto kernel_add_mat4(Mat4Buffer<T>& dst, const Mat4Buffer<T>& lhs,
                                    const Mat4Buffer<T>& rhs) -> void {
@@ -7,6 +7,8 @@
 #include <xmmintrin.h>
 
 #include "../mat4_t_decl.hpp"
+#include "./mat4_t_scalar_impl.hpp"
+#include "./vec3_t_sse_impl.hpp"
 
 /**
  * SSE instruction sets required for each kernel:
@@ -17,6 +19,11 @@
  * - kernel_hadamard_mat4           : SSE|SSE2
  *   kernel_matmul_mat4             : SSE|SSE2|FMA?(if available)
  *   kernel_matmul_vec_mat4         : SSE|SSE2|FMA?(if available)
+ * - kernel_transpose_inplace_mat4  : SSE|SSE2
+ * - kernel_determinant_mat4        : SSE|SSE3
+ * - kernel_inverse_mat4            : SSE|SSE3
+ * - kernel_inverse_rigid_mat4      : SSE|SSE4.1 (float32 only)
+ * - kernel_inverse_affine_mat4     : SSE|SSE4.1 (float32 only)
  *
  * Notes:
  * 0. Matrix order:
@@ -35,6 +42,11 @@
  *    the kernels mentioned above, but it'd require for the matrix storage
  *    layout to be row-major :/, unless it can be done in the linear-combination
  *    view of matrices and vectors
+ *
+ * 4. Inverse and determinant:
+ *    Both use a block-wise expansion of the matrix into 2x2 sub-matrices (see
+ *    kernel_inverse_mat4 for details), as each 2x2 block fits into a single
+ *    xmm register for float32 (and into an xmm pair for float64)
  */
 
 namespace math {
@@ -290,6 +302,184 @@ MATH3D_INLINE auto kernel_hadamard_mat4(Mat4Buffer<T>& dst,
     }
 }
 
+// ***************************************************************************//
+//         Dispatch SSE-kernels for transpose, determinant and inverse      //
+// ***************************************************************************//
+
+template <typename T>
+using SFINAE_MAT4_F32_XMM_GUARD = SFINAE_MAT4_F32_SSE_GUARD<T>;
+
+#include "./mat4_t_f32_xmm_impl.hpp"
+
+template <typename T, SFINAE_MAT4_F64_SSE_GUARD<T> = nullptr>
+MATH3D_INLINE auto kernel_transpose_inplace_mat4(Mat4Buffer<T>& mat) -> void {
+    // Each column is split into lo={m0j, m1j} and hi={m2j, m3j} parts, so the
+    // transpose is made of the four 2x2 blocks, each one transposed by unpacks
+    auto xmm_col_0_lo = _mm_loadu_pd(mat[0].data());
+    auto xmm_col_0_hi = _mm_loadu_pd(mat[0].data() + 2);
+    auto xmm_col_1_lo = _mm_loadu_pd(mat[1].data());
+    auto xmm_col_1_hi = _mm_loadu_pd(mat[1].data() + 2);
+    auto xmm_col_2_lo = _mm_loadu_pd(mat[2].data());
+    auto xmm_col_2_hi = _mm_loadu_pd(mat[2].data() + 2);
+    auto xmm_col_3_lo = _mm_loadu_pd(mat[3].data());
+    auto xmm_col_3_hi = _mm_loadu_pd(mat[3].data() + 2);
+
+    _mm_storeu_pd(mat[0].data(), _mm_unpacklo_pd(xmm_col_0_lo, xmm_col_1_lo));
+    _mm_storeu_pd(mat[0].data() + 2,
+                  _mm_unpacklo_pd(xmm_col_2_lo, xmm_col_3_lo));
+    _mm_storeu_pd(mat[1].data(), _mm_unpackhi_pd(xmm_col_0_lo, xmm_col_1_lo));
+    _mm_storeu_pd(mat[1].data() + 2,
+                  _mm_unpackhi_pd(xmm_col_2_lo, xmm_col_3_lo));
+    _mm_storeu_pd(mat[2].data(), _mm_unpacklo_pd(xmm_col_0_hi, xmm_col_1_hi));
+    _mm_storeu_pd(mat[2].data() + 2,
+                  _mm_unpacklo_pd(xmm_col_2_hi, xmm_col_3_hi));
+    _mm_storeu_pd(mat[3].data(), _mm_unpackhi_pd(xmm_col_0_hi, xmm_col_1_hi));
+    _mm_storeu_pd(mat[3].data() + 2,
+                  _mm_unpackhi_pd(xmm_col_2_hi, xmm_col_3_hi));
+}
+
+// The helpers below are the float64 versions of the 2x2 matrix helpers, with
+// the 2x2 matrix {m00, m01, m10, m11} split into the xmm pair lo = {m00, m01},
+// hi = {m10, m11}. Each pair is also half of two columns of the 4x4 matrix
+
+/// 2x2 matrix of float64, stored as two xmm registers
+struct Mat2F64 {
+    __m128d lo;
+    __m128d hi;
+};
+
+/// Returns the 2x2 matrix product lhs * rhs
+inline auto mat2_mul_f64(const Mat2F64& lhs, const Mat2F64& rhs) -> Mat2F64 {
+    return {_mm_add_pd(_mm_mul_pd(_mm_unpacklo_pd(lhs.lo, lhs.lo), rhs.lo),
+                       _mm_mul_pd(_mm_unpackhi_pd(lhs.lo, lhs.lo), rhs.hi)),
+            _mm_add_pd(_mm_mul_pd(_mm_unpacklo_pd(lhs.hi, lhs.hi), rhs.lo),
+                       _mm_mul_pd(_mm_unpackhi_pd(lhs.hi, lhs.hi), rhs.hi))};
+}
+
+/// Returns the adjugate of the given 2x2 matrix
+inline auto mat2_adj_f64(const Mat2F64& mat) -> Mat2F64 {
+    // {m11, -m01}, {-m10, m00}
+    return {_mm_mul_pd(_mm_unpackhi_pd(mat.hi, mat.lo), _mm_setr_pd(1.0, -1.0)),
+            _mm_mul_pd(_mm_unpacklo_pd(mat.hi, mat.lo),
+                       _mm_setr_pd(-1.0, 1.0))};
+}
+
+/// Returns the determinant of the given 2x2 matrix, in both lanes
+inline auto mat2_det_f64(const Mat2F64& mat) -> __m128d {
+    // {m00 * m11, m01 * m10} -> {det, det}
+    auto prods = _mm_mul_pd(mat.lo, _mm_shuffle_pd(mat.hi, mat.hi, 0x01));
+    return _mm_hsub_pd(prods, prods);
+}
+
+/// Returns the trace of the 2x2 matrix product lhs * rhs, in both lanes
+inline auto mat2_trace_mul_f64(const Mat2F64& lhs, const Mat2F64& rhs)
+    -> __m128d {
+    // tr(L * R) = l00 * r00 + l01 * r10 + l10 * r01 + l11 * r11
+    auto sums = _mm_add_pd(
+        _mm_mul_pd(lhs.lo, _mm_unpacklo_pd(rhs.lo, rhs.hi)),
+        _mm_mul_pd(lhs.hi, _mm_unpackhi_pd(rhs.lo, rhs.hi)));
+    return _mm_hadd_pd(sums, sums);
+}
+
+template <typename T, SFINAE_MAT4_F64_SSE_GUARD<T> = nullptr>
+MATH3D_INLINE auto kernel_determinant_mat4(const Mat4Buffer<T>& mat) -> T {
+    // Same block-wise expansion as in the float32 version, where the blocks
+    // are made of the halves of the columns
+    const Mat2F64 mat_a = {_mm_loadu_pd(mat[0].data()),
+                           _mm_loadu_pd(mat[1].data())};
+    const Mat2F64 mat_b = {_mm_loadu_pd(mat[0].data() + 2),
+                           _mm_loadu_pd(mat[1].data() + 2)};
+    const Mat2F64 mat_c = {_mm_loadu_pd(mat[2].data()),
+                           _mm_loadu_pd(mat[3].data())};
+    const Mat2F64 mat_d = {_mm_loadu_pd(mat[2].data() + 2),
+                           _mm_loadu_pd(mat[3].data() + 2)};
+
+    auto mat_d_c = mat2_mul_f64(mat2_adj_f64(mat_d), mat_c);
+    auto mat_a_b = mat2_mul_f64(mat2_adj_f64(mat_a), mat_b);
+
+    auto xmm_det = _mm_sub_pd(
+        _mm_add_pd(_mm_mul_pd(mat2_det_f64(mat_a), mat2_det_f64(mat_d)),
+                   _mm_mul_pd(mat2_det_f64(mat_b), mat2_det_f64(mat_c))),
+        mat2_trace_mul_f64(mat_a_b, mat_d_c));
+    return _mm_cvtsd_f64(xmm_det);
+}
+
+template <typename T, SFINAE_MAT4_F64_SSE_GUARD<T> = nullptr>
+MATH3D_INLINE auto kernel_inverse_mat4(Mat4Buffer<T>& dst,
+                                       const Mat4Buffer<T>& src) -> void {
+    // Same block-wise inverse as in the float32 version (see the notes there)
+    const Mat2F64 mat_a = {_mm_loadu_pd(src[0].data()),
+                           _mm_loadu_pd(src[1].data())};
+    const Mat2F64 mat_b = {_mm_loadu_pd(src[0].data() + 2),
+                           _mm_loadu_pd(src[1].data() + 2)};
+    const Mat2F64 mat_c = {_mm_loadu_pd(src[2].data()),
+                           _mm_loadu_pd(src[3].data())};
+    const Mat2F64 mat_d = {_mm_loadu_pd(src[2].data() + 2),
+                           _mm_loadu_pd(src[3].data() + 2)};
+
+    auto xmm_det_a = mat2_det_f64(mat_a);
+    auto xmm_det_b = mat2_det_f64(mat_b);
+    auto xmm_det_c = mat2_det_f64(mat_c);
+    auto xmm_det_d = mat2_det_f64(mat_d);
+
+    auto mat_d_c = mat2_mul_f64(mat2_adj_f64(mat_d), mat_c);
+    auto mat_a_b = mat2_mul_f64(mat2_adj_f64(mat_a), mat_b);
+
+    auto xmm_det = _mm_sub_pd(_mm_add_pd(_mm_mul_pd(xmm_det_a, xmm_det_d),
+                                         _mm_mul_pd(xmm_det_b, xmm_det_c)),
+                              mat2_trace_mul_f64(mat_a_b, mat_d_c));
+
+    // {1/|M|, -1/|M|}, {-1/|M|, 1/|M|} (signs of the adjugate of the blocks)
+    auto xmm_inv_det_lo = _mm_div_pd(_mm_setr_pd(1.0, -1.0), xmm_det);
+    auto xmm_inv_det_hi = _mm_div_pd(_mm_setr_pd(-1.0, 1.0), xmm_det);
+
+    // X = |D| * A - B * (D# * C), and the same for the other blocks
+    auto scaled_diff = [&](__m128d det, const Mat2F64& mat,
+                           const Mat2F64& prod) -> Mat2F64 {
+        return {_mm_mul_pd(_mm_sub_pd(_mm_mul_pd(det, mat.lo), prod.lo),
+                           xmm_inv_det_lo),
+                _mm_mul_pd(_mm_sub_pd(_mm_mul_pd(det, mat.hi), prod.hi),
+                           xmm_inv_det_hi)};
+    };
+    auto mat_x = scaled_diff(xmm_det_d, mat_a, mat2_mul_f64(mat_b, mat_d_c));
+    auto mat_w = scaled_diff(xmm_det_a, mat_d, mat2_mul_f64(mat_c, mat_a_b));
+    auto mat_y = scaled_diff(xmm_det_b, mat_c,
+                             mat2_mul_f64(mat_d, mat2_adj_f64(mat_a_b)));
+    auto mat_z = scaled_diff(xmm_det_c, mat_b,
+                             mat2_mul_f64(mat_a, mat2_adj_f64(mat_d_c)));
+
+    // Take the adjugate of each block, and place them back into the columns:
+    // {x11, x01, y11, y01}, {x10, x00, y10, y00}, {z11, z01, w11, w01}, ...
+    _mm_storeu_pd(dst[0].data(), _mm_unpackhi_pd(mat_x.hi, mat_x.lo));
+    _mm_storeu_pd(dst[0].data() + 2, _mm_unpackhi_pd(mat_y.hi, mat_y.lo));
+    _mm_storeu_pd(dst[1].data(), _mm_unpacklo_pd(mat_x.hi, mat_x.lo));
+    _mm_storeu_pd(dst[1].data() + 2, _mm_unpacklo_pd(mat_y.hi, mat_y.lo));
+    _mm_storeu_pd(dst[2].data(), _mm_unpackhi_pd(mat_z.hi, mat_z.lo));
+    _mm_storeu_pd(dst[2].data() + 2, _mm_unpackhi_pd(mat_w.hi, mat_w.lo));
+    _mm_storeu_pd(dst[3].data(), _mm_unpacklo_pd(mat_z.hi, mat_z.lo));
+    _mm_storeu_pd(dst[3].data() + 2, _mm_unpacklo_pd(mat_w.hi, mat_w.lo));
+}
+
+// ***************************************************************************//
+//         Dispatch SSE-kernels for the inverse of rigid|affine matrices      //
+// ***************************************************************************//
+
+// The float32 kernels are in mat4_t_f32_xmm_impl.hpp (included above)
+
+template <typename T, SFINAE_MAT4_F64_SSE_GUARD<T> = nullptr>
+MATH3D_INLINE auto kernel_inverse_rigid_mat4(Mat4Buffer<T>& dst,
+                                             const Mat4Buffer<T>& src) -> void {
+    // Only a handful of scalar ops, and each column would span two registers
+    scalar::kernel_inverse_rigid_mat4<T>(dst, src);
+}
+
+template <typename T, SFINAE_MAT4_F64_SSE_GUARD<T> = nullptr>
+MATH3D_INLINE auto kernel_inverse_affine_mat4(Mat4Buffer<T>& dst,
+                                              const Mat4Buffer<T>& src)
+    -> void {
+    scalar::kernel_inverse_affine_mat4<T>(dst, src);
+}
+
 }  // namespace sse
 }  // namespace math
 
@@ -0,0 +1,26 @@
+#pragma once
+
+#include "./packet_avx512_impl.hpp"
+#include "./overlap_queries_scalar_impl.hpp"
+
+#if defined(MATH3D_DISPATCH_AVX512)
+
+/**
+ * AVX-512 overlap-query kernels (AVX512F|AVX512DQ)
+ *
+ * The kernels of overlap_queries_simd_impl.hpp over zmm registers, i.e. 16
+ * float32 or 8 float64 elements per iteration. Each comparison writes the bits
+ * of all lanes directly into a mask register.
+ */
+
+namespace math {
+namespace avx512 {
+
+#define MATH3D_TARGET_ISA MATH3D_TARGET_AVX512
+#include "./overlap_queries_simd_impl.hpp"
+#undef MATH3D_TARGET_ISA
+
+}  // namespace avx512
+}  // namespace math
+
+#endif  // MATH3D_DISPATCH_AVX512
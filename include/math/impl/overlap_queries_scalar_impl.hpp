@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cstdint>
+
+#include "../aabb_batch_t_decl.hpp"
+#include "../bitmask.hpp"
+#include "../vec3_batch_t_decl.hpp"
+#include "../utils/geometry_helpers.hpp"
+
+/**
+ * Scalar overlap-query kernels
+ *
+ * Each kernel tests a single volume (a sphere or a box) against a batch stored
+ * as SoA (points, spheres or boxes), with the same tests as Sphere::contains,
+ * Sphere::intersects and AABB::intersects, and writes the results as a bitmask
+ * (see bitmask.hpp) with the bit i set if the i-th element overlaps the volume.
+ *
+ * The *_range versions only test the elements in [begin, end), and are used by
+ * the SIMD kernels for the remainder of a batch.
+ */
+
+namespace math {
+namespace scalar {
+
+template <typename T>
+using Vec3ConstPlanes = Vector3Planes<const T>;
+
+template <typename T>
+using AABBConstPlanes = AABBPlanes<const T>;
+
+template <typename T>
+auto kernel_sphere_points_range(uint64_t* overlaps, const Sphere<T>& sphere,
+                                Vec3ConstPlanes<T> points, size_t begin,
+                                size_t end) -> void {
+    for (size_t i = begin; i < end; ++i) {
+        const Vector3<T> point(points.x[i], points.y[i], points.z[i]);
+        bitmaskWrite(overlaps, i, sphere.contains(point) ? 1U : 0U);
+    }
+}
+
+template <typename T>
+auto kernel_sphere_spheres_range(uint64_t* overlaps, const Sphere<T>& sphere,
+                                 Vec3ConstPlanes<T> centers, const T* radii,
+                                 size_t begin, size_t end) -> void {
+    for (size_t i = begin; i < end; ++i) {
+        const Sphere<T> other(
+            Vector3<T>(centers.x[i], centers.y[i], centers.z[i]), radii[i]);
+        bitmaskWrite(overlaps, i, sphere.intersects(other) ? 1U : 0U);
+    }
+}
+
+template <typename T>
+auto kernel_aabb_aabbs_range(uint64_t* overlaps, const AABB<T>& box,
+                             AABBConstPlanes<T> boxes, size_t begin,
+                             size_t end) -> void {
+    for (size_t i = begin; i < end; ++i) {
+        const AABB<T> other(
+            Vector3<T>(boxes.min_x[i], boxes.min_y[i], boxes.min_z[i]),
+            Vector3<T>(boxes.max_x[i], boxes.max_y[i], boxes.max_z[i]));
+        bitmaskWrite(overlaps, i, box.intersects(other) ? 1U : 0U);
+    }
+}
+
+template <typename T>
+auto kernel_sphere_points(uint64_t* overlaps, const Sphere<T>& sphere,
+                          Vec3ConstPlanes<T> points, size_t num) -> void {
+    kernel_sphere_points_range<T>(overlaps, sphere, points, 0, num);
+}
+
+template <typename T>
+auto kernel_sphere_spheres(uint64_t* overlaps, const Sphere<T>& sphere,
+                           Vec3ConstPlanes<T> centers, const T* radii,
+                           size_t num) -> void {
+    kernel_sphere_spheres_range<T>(overlaps, sphere, centers, radii, 0, num);
+}
+
+template <typename T>
+auto kernel_aabb_aabbs(uint64_t* overlaps, const AABB<T>& box,
+                       AABBConstPlanes<T> boxes, size_t num) -> void {
+    kernel_aabb_aabbs_range<T>(overlaps, box, boxes, 0, num);
+}
+
+}  // namespace scalar
+}  // namespace math
@@ -0,0 +1,104 @@
+// No include guard, see MATH3D_TARGET_ISA in dispatch.hpp
+#if !defined(MATH3D_TARGET_ISA)
+#error "Include the SSE, AVX or AVX-512 header of these kernels"
+#endif
+
+/**
+ * SIMD overlap-query kernels (SSE, AVX and AVX-512)
+ *
+ * Each iteration tests Packet<T>::WIDTH elements at once against the broadcast
+ * sphere or box, and writes the bits of all lanes at once (see
+ * Packet<T>::mask_ge). The squared distances use separate products and sums
+ * in the same order as Vector3::lengthSquare, so the results match the scalar
+ * kernels. The remaining elements of the batch (if any) are handled by the
+ * scalar kernels.
+ */
+
+template <typename T>
+using Vec3ConstPlanes = Vector3Planes<const T>;
+
+template <typename T>
+using AABBConstPlanes = AABBPlanes<const T>;
+
+/// Returns the squared distance of each lane to the given (broadcast) center
+template <typename P>
+MATH3D_TARGET_ISA auto square_distance(typename P::Reg center_x,
+                                       typename P::Reg center_y,
+                                       typename P::Reg center_z,
+                                       typename P::Reg x, typename P::Reg y,
+                                       typename P::Reg z) -> typename P::Reg {
+    const auto dx = P::sub(x, center_x);
+    const auto dy = P::sub(y, center_y);
+    const auto dz = P::sub(z, center_z);
+    return P::add(P::add(P::mul(dx, dx), P::mul(dy, dy)), P::mul(dz, dz));
+}
+
+template <typename T>
+MATH3D_TARGET_ISA auto kernel_sphere_points(uint64_t* overlaps,
+                                            const Sphere<T>& sphere,
+                                            Vec3ConstPlanes<T> points,
+                                            size_t num) -> void {
+    using P = Packet<T>;
+    const auto center_x = P::set1(sphere.center.x());
+    const auto center_y = P::set1(sphere.center.y());
+    const auto center_z = P::set1(sphere.center.z());
+    const auto radius_sq = P::set1(sphere.radius * sphere.radius);
+    size_t i = 0;
+    for (; i + P::WIDTH <= num; i += P::WIDTH) {
+        const auto dist_sq = square_distance<P>(
+            center_x, center_y, center_z, P::load(points.x + i),
+            P::load(points.y + i), P::load(points.z + i));
+        bitmaskWrite(overlaps, i, P::mask_ge(radius_sq, dist_sq));
+    }
+    scalar::kernel_sphere_points_range<T>(overlaps, sphere, points, i, num);
+}
+
+template <typename T>
+MATH3D_TARGET_ISA auto kernel_sphere_spheres(uint64_t* overlaps,
+                                             const Sphere<T>& sphere,
+                                             Vec3ConstPlanes<T> centers,
+                                             const T* radii,
+                                             size_t num) -> void {
+    using P = Packet<T>;
+    const auto center_x = P::set1(sphere.center.x());
+    const auto center_y = P::set1(sphere.center.y());
+    const auto center_z = P::set1(sphere.center.z());
+    const auto radius = P::set1(sphere.radius);
+    size_t i = 0;
+    for (; i + P::WIDTH <= num; i += P::WIDTH) {
+        const auto dist_sq = square_distance<P>(
+            center_x, center_y, center_z, P::load(centers.x + i),
+            P::load(centers.y + i), P::load(centers.z + i));
+        const auto radius_sum = P::add(radius, P::load(radii + i));
+        bitmaskWrite(overlaps, i,
+                     P::mask_ge(P::mul(radius_sum, radius_sum), dist_sq));
+    }
+    scalar::kernel_sphere_spheres_range<T>(overlaps, sphere, centers, radii, i,
+                                           num);
+}
+
+template <typename T>
+MATH3D_TARGET_ISA auto kernel_aabb_aabbs(uint64_t* overlaps,
+                                         const AABB<T>& box,
+                                         AABBConstPlanes<T> boxes,
+                                         size_t num) -> void {
+    using P = Packet<T>;
+    const auto min_x = P::set1(box.p_min.x());
+    const auto min_y = P::set1(box.p_min.y());
+    const auto min_z = P::set1(box.p_min.z());
+    const auto max_x = P::set1(box.p_max.x());
+    const auto max_y = P::set1(box.p_max.y());
+    const auto max_z = P::set1(box.p_max.z());
+    size_t i = 0;
+    for (; i + P::WIDTH <= num; i += P::WIDTH) {
+        // The boxes overlap if their ranges overlap along all three axes
+        const uint32_t bits_x = P::mask_ge(P::load(boxes.max_x + i), min_x) &
+                                P::mask_ge(max_x, P::load(boxes.min_x + i));
+        const uint32_t bits_y = P::mask_ge(P::load(boxes.max_y + i), min_y) &
+                                P::mask_ge(max_y, P::load(boxes.min_y + i));
+        const uint32_t bits_z = P::mask_ge(P::load(boxes.max_z + i), min_z) &
+                                P::mask_ge(max_z, P::load(boxes.min_z + i));
+        bitmaskWrite(overlaps, i, bits_x & bits_y & bits_z);
+    }
+    scalar::kernel_aabb_aabbs_range<T>(overlaps, box, boxes, i, num);
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include "./packet_sse_impl.hpp"
+#include "./overlap_queries_scalar_impl.hpp"
+
+#if defined(MATH3D_DISPATCH_SSE)
+
+/**
+ * SSE overlap-query kernels (SSE|SSE2|SSE4.1)
+ *
+ * The kernels of overlap_queries_simd_impl.hpp over xmm registers, i.e. 4
+ * float32 or 2 float64 elements per iteration.
+ */
+
+namespace math {
+namespace sse {
+
+#define MATH3D_TARGET_ISA MATH3D_TARGET_SSE
+#include "./overlap_queries_simd_impl.hpp"
+#undef MATH3D_TARGET_ISA
+
+}  // namespace sse
+}  // namespace math
+
+#endif  // MATH3D_DISPATCH_SSE
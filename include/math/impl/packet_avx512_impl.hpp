@@ -0,0 +1,399 @@
+#pragma once
+
+#include "../dispatch.hpp"
+
+#if defined(MATH3D_DISPATCH_AVX512)
+
+#include <immintrin.h>
+
+/**
+ * Register-level helpers used by the AVX-512 batch kernels (AVX512F|AVX512DQ)
+ *
+ * Same interface as avx::Packet<T>, but for zmm registers (16xf32 or 8xf64).
+ * AVX-512F always comes with FMA, so fmadd/fnmadd map to a single fused
+ * instruction.
+ *
+ * Notes:
+ * 1. load_aos3/store_aos3 use two full-width two-source permutes per
+ *    component (vpermt2ps/vpermt2pd). Unlike AVX these can cross lanes, so the
+ *    interleaved xyz data of WIDTH vectors (3 registers) is deinterleaved with
+ *    the first permute picking from the first two registers, and the second
+ *    one filling the rest of the lanes from the third register. With
+ *    MATH3D_VEC3_PADDED (xyz0xyz0..., 4 registers) each component is permuted
+ *    out of the first and last register pairs, and the two halves are joined
+ *    with a 128-bit lane shuffle. The stores fill x|y first, then z, and keep
+ *    the padding entries zero through the permute masks.
+ */
+
+namespace math {
+namespace avx512 {
+
+template <typename T>
+struct Packet;
+
+template <>
+struct Packet<float32_t> {
+    using Reg = __m512;
+    static constexpr size_t WIDTH = 16;
+
+    MATH3D_TARGET_AVX512 static auto load(const float32_t* src) -> Reg {
+        return _mm512_loadu_ps(src);
+    }
+
+    MATH3D_TARGET_AVX512 static auto store(float32_t* dst, Reg reg) -> void {
+        _mm512_storeu_ps(dst, reg);
+    }
+
+    MATH3D_TARGET_AVX512 static auto set1(float32_t value) -> Reg {
+        return _mm512_set1_ps(value);
+    }
+
+    MATH3D_TARGET_AVX512 static auto zero() -> Reg {
+        return _mm512_setzero_ps();
+    }
+
+    MATH3D_TARGET_AVX512 static auto add(Reg lhs, Reg rhs) -> Reg {
+        return _mm512_add_ps(lhs, rhs);
+    }
+
+    MATH3D_TARGET_AVX512 static auto sub(Reg lhs, Reg rhs) -> Reg {
+        return _mm512_sub_ps(lhs, rhs);
+    }
+
+    MATH3D_TARGET_AVX512 static auto mul(Reg lhs, Reg rhs) -> Reg {
+        return _mm512_mul_ps(lhs, rhs);
+    }
+
+    MATH3D_TARGET_AVX512 static auto div(Reg lhs, Reg rhs) -> Reg {
+        return _mm512_div_ps(lhs, rhs);
+    }
+
+    MATH3D_TARGET_AVX512 static auto sqrt(Reg reg) -> Reg {
+        return _mm512_sqrt_ps(reg);
+    }
+
+    /// Returns a * b + c
+    MATH3D_TARGET_AVX512 static auto fmadd(Reg a, Reg b, Reg c) -> Reg {
+        return _mm512_fmadd_ps(a, b, c);
+    }
+
+    /// Returns c - a * b
+    MATH3D_TARGET_AVX512 static auto fnmadd(Reg a, Reg b, Reg c) -> Reg {
+        return _mm512_fnmadd_ps(a, b, c);
+    }
+
+    /// Returns the lane-wise maximum of the given registers
+    MATH3D_TARGET_AVX512 static auto max(Reg lhs, Reg rhs) -> Reg {
+        return _mm512_max_ps(lhs, rhs);
+    }
+
+    /// Returns the lane-wise minimum of the given registers
+    MATH3D_TARGET_AVX512 static auto min(Reg lhs, Reg rhs) -> Reg {
+        return _mm512_min_ps(lhs, rhs);
+    }
+
+    /// Returns the absolute value of each lane
+    MATH3D_TARGET_AVX512 static auto abs(Reg reg) -> Reg {
+        return _mm512_abs_ps(reg);
+    }
+
+    /// Rounds each lane to the nearest integer (ties to even)
+    MATH3D_TARGET_AVX512 static auto round(Reg reg) -> Reg {
+        return _mm512_roundscale_ps(
+            reg, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    }
+
+    /// Rounds each lane down to an integer
+    MATH3D_TARGET_AVX512 static auto floor(Reg reg) -> Reg {
+        return _mm512_roundscale_ps(reg,
+                                    _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC);
+    }
+
+    /// Returns `a` with its sign flipped in the lanes where `b` is negative
+    MATH3D_TARGET_AVX512 static auto mulsign(Reg a, Reg b) -> Reg {
+        return _mm512_xor_ps(a, _mm512_and_ps(b, _mm512_set1_ps(-0.0F)));
+    }
+
+    /// Returns `if_true` in the lanes where lhs > rhs, and `if_false` elsewhere
+    MATH3D_TARGET_AVX512 static auto select_gt(Reg lhs, Reg rhs, Reg if_true,
+                                               Reg if_false) -> Reg {
+        return _mm512_mask_blend_ps(_mm512_cmp_ps_mask(lhs, rhs, _CMP_GT_OQ),
+                                    if_false, if_true);
+    }
+
+    /// Returns a bitmask with the bit i set if lhs >= rhs in the i-th lane
+    MATH3D_TARGET_AVX512 static auto mask_ge(Reg lhs, Reg rhs) -> uint32_t {
+        return static_cast<uint32_t>(_mm512_cmp_ps_mask(lhs, rhs, _CMP_GE_OQ));
+    }
+
+#if defined(MATH3D_VEC3_PADDED)
+    /// Loads 16 consecutive Vector3 (64 floats, xyz0 interleaved) as x, y, z
+    MATH3D_TARGET_AVX512 static auto load_aos3(const float32_t* src, Reg& x,
+                                               Reg& y, Reg& z) -> void {
+        auto a = _mm512_loadu_ps(src);
+        auto b = _mm512_loadu_ps(src + 16);
+        auto c = _mm512_loadu_ps(src + 32);
+        auto d = _mm512_loadu_ps(src + 48);
+        // Lane i of component k is at 4i+k: vectors 0-7 come from a|b, and
+        // vectors 8-15 from c|d (only the lower 8 lanes of each are used)
+        // clang-format off
+        const auto x_idx = _mm512_setr_epi32(0, 4, 8, 12, 16, 20, 24, 28,
+                                             0, 4, 8, 12, 16, 20, 24, 28);
+        // clang-format on
+        const auto y_idx = _mm512_add_epi32(x_idx, _mm512_set1_epi32(1));
+        const auto z_idx = _mm512_add_epi32(x_idx, _mm512_set1_epi32(2));
+        x = _mm512_shuffle_f32x4(_mm512_permutex2var_ps(a, x_idx, b),
+                                 _mm512_permutex2var_ps(c, x_idx, d), 0x44);
+        y = _mm512_shuffle_f32x4(_mm512_permutex2var_ps(a, y_idx, b),
+                                 _mm512_permutex2var_ps(c, y_idx, d), 0x44);
+        z = _mm512_shuffle_f32x4(_mm512_permutex2var_ps(a, z_idx, b),
+                                 _mm512_permutex2var_ps(c, z_idx, d), 0x44);
+    }
+
+    /// Stores x, y, z as 16 consecutive Vector3 (64 floats, xyz0 interleaved)
+    MATH3D_TARGET_AVX512 static auto store_aos3(float32_t* dst, Reg x, Reg y,
+                                                Reg z) -> void {
+        // Output register r holds the vectors 4r..4r+3, so the indices of the
+        // first one are just shifted by 4r for the others
+        // clang-format off
+        const auto idx = _mm512_setr_epi32(0, 16, 0, 0, 1, 17, 1, 0,
+                                           2, 18, 2, 0, 3, 19, 3, 0);
+        // clang-format on
+        for (int32_t r = 0; r < 4; ++r) {
+            auto idx_r = _mm512_add_epi32(idx, _mm512_set1_epi32(4 * r));
+            auto xy = _mm512_maskz_permutex2var_ps(0x3333, x, idx_r, y);
+            _mm512_storeu_ps(dst + 16 * r, _mm512_mask_permutexvar_ps(
+                                               xy, 0x4444, idx_r, z));
+        }
+    }
+#else
+    /// Loads 16 consecutive Vector3 (48 floats, xyz interleaved) as x, y, z
+    MATH3D_TARGET_AVX512 static auto load_aos3(const float32_t* src, Reg& x,
+                                               Reg& y, Reg& z) -> void {
+        auto a = _mm512_loadu_ps(src);
+        auto b = _mm512_loadu_ps(src + 16);
+        auto c = _mm512_loadu_ps(src + 32);
+        // Lane i of component k is at 3i+k: the first permute gathers the ones
+        // in a|b (0-31), and the second one gathers the remaining ones from c
+        // clang-format off
+        const auto x_ab = _mm512_setr_epi32(0, 3, 6, 9, 12, 15, 18, 21,
+                                            24, 27, 30, 0, 0, 0, 0, 0);
+        const auto x_c = _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7,
+                                           8, 9, 10, 17, 20, 23, 26, 29);
+        const auto y_ab = _mm512_setr_epi32(1, 4, 7, 10, 13, 16, 19, 22,
+                                            25, 28, 31, 0, 0, 0, 0, 0);
+        const auto y_c = _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7,
+                                           8, 9, 10, 18, 21, 24, 27, 30);
+        const auto z_ab = _mm512_setr_epi32(2, 5, 8, 11, 14, 17, 20, 23,
+                                            26, 29, 0, 0, 0, 0, 0, 0);
+        const auto z_c = _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7,
+                                           8, 9, 16, 19, 22, 25, 28, 31);
+        // clang-format on
+        x = _mm512_permutex2var_ps(_mm512_permutex2var_ps(a, x_ab, b), x_c, c);
+        y = _mm512_permutex2var_ps(_mm512_permutex2var_ps(a, y_ab, b), y_c, c);
+        z = _mm512_permutex2var_ps(_mm512_permutex2var_ps(a, z_ab, b), z_c, c);
+    }
+
+    /// Stores x, y, z as 16 consecutive Vector3 (48 floats, xyz interleaved)
+    MATH3D_TARGET_AVX512 static auto store_aos3(float32_t* dst, Reg x, Reg y,
+                                                Reg z) -> void {
+        // Each output register takes its x and y entries first (x|y), and then
+        // the z entries are permuted into the remaining slots
+        // clang-format off
+        const auto a_xy = _mm512_setr_epi32(0, 16, 0, 1, 17, 0, 2, 18,
+                                            0, 3, 19, 0, 4, 20, 0, 5);
+        const auto a_z = _mm512_setr_epi32(0, 1, 16, 3, 4, 17, 6, 7,
+                                           18, 9, 10, 19, 12, 13, 20, 15);
+        const auto b_xy = _mm512_setr_epi32(21, 0, 6, 22, 0, 7, 23, 0,
+                                            8, 24, 0, 9, 25, 0, 10, 26);
+        const auto b_z = _mm512_setr_epi32(0, 21, 2, 3, 22, 5, 6, 23,
+                                           8, 9, 24, 11, 12, 25, 14, 15);
+        const auto c_xy = _mm512_setr_epi32(0, 11, 27, 0, 12, 28, 0, 13,
+                                            29, 0, 14, 30, 0, 15, 31, 0);
+        const auto c_z = _mm512_setr_epi32(26, 1, 2, 27, 4, 5, 28, 7,
+                                           8, 29, 10, 11, 30, 13, 14, 31);
+        // clang-format on
+        _mm512_storeu_ps(dst, _mm512_permutex2var_ps(
+                                  _mm512_permutex2var_ps(x, a_xy, y), a_z, z));
+        _mm512_storeu_ps(
+            dst + 16,
+            _mm512_permutex2var_ps(_mm512_permutex2var_ps(x, b_xy, y), b_z, z));
+        _mm512_storeu_ps(
+            dst + 32,
+            _mm512_permutex2var_ps(_mm512_permutex2var_ps(x, c_xy, y), c_z, z));
+    }
+#endif  // MATH3D_VEC3_PADDED
+};
+
+template <>
+struct Packet<float64_t> {
+    using Reg = __m512d;
+    static constexpr size_t WIDTH = 8;
+
+    MATH3D_TARGET_AVX512 static auto load(const float64_t* src) -> Reg {
+        return _mm512_loadu_pd(src);
+    }
+
+    MATH3D_TARGET_AVX512 static auto store(float64_t* dst, Reg reg) -> void {
+        _mm512_storeu_pd(dst, reg);
+    }
+
+    MATH3D_TARGET_AVX512 static auto set1(float64_t value) -> Reg {
+        return _mm512_set1_pd(value);
+    }
+
+    MATH3D_TARGET_AVX512 static auto zero() -> Reg {
+        return _mm512_setzero_pd();
+    }
+
+    MATH3D_TARGET_AVX512 static auto add(Reg lhs, Reg rhs) -> Reg {
+        return _mm512_add_pd(lhs, rhs);
+    }
+
+    MATH3D_TARGET_AVX512 static auto sub(Reg lhs, Reg rhs) -> Reg {
+        return _mm512_sub_pd(lhs, rhs);
+    }
+
+    MATH3D_TARGET_AVX512 static auto mul(Reg lhs, Reg rhs) -> Reg {
+        return _mm512_mul_pd(lhs, rhs);
+    }
+
+    MATH3D_TARGET_AVX512 static auto div(Reg lhs, Reg rhs) -> Reg {
+        return _mm512_div_pd(lhs, rhs);
+    }
+
+    MATH3D_TARGET_AVX512 static auto sqrt(Reg reg) -> Reg {
+        return _mm512_sqrt_pd(reg);
+    }
+
+    /// Returns a * b + c
+    MATH3D_TARGET_AVX512 static auto fmadd(Reg a, Reg b, Reg c) -> Reg {
+        return _mm512_fmadd_pd(a, b, c);
+    }
+
+    /// Returns c - a * b
+    MATH3D_TARGET_AVX512 static auto fnmadd(Reg a, Reg b, Reg c) -> Reg {
+        return _mm512_fnmadd_pd(a, b, c);
+    }
+
+    /// Returns the lane-wise maximum of the given registers
+    MATH3D_TARGET_AVX512 static auto max(Reg lhs, Reg rhs) -> Reg {
+        return _mm512_max_pd(lhs, rhs);
+    }
+
+    /// Returns the lane-wise minimum of the given registers
+    MATH3D_TARGET_AVX512 static auto min(Reg lhs, Reg rhs) -> Reg {
+        return _mm512_min_pd(lhs, rhs);
+    }
+
+    /// Returns the absolute value of each lane
+    MATH3D_TARGET_AVX512 static auto abs(Reg reg) -> Reg {
+        return _mm512_abs_pd(reg);
+    }
+
+    /// Rounds each lane to the nearest integer (ties to even)
+    MATH3D_TARGET_AVX512 static auto round(Reg reg) -> Reg {
+        return _mm512_roundscale_pd(
+            reg, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    }
+
+    /// Rounds each lane down to an integer
+    MATH3D_TARGET_AVX512 static auto floor(Reg reg) -> Reg {
+        return _mm512_roundscale_pd(reg,
+                                    _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC);
+    }
+
+    /// Returns `a` with its sign flipped in the lanes where `b` is negative
+    MATH3D_TARGET_AVX512 static auto mulsign(Reg a, Reg b) -> Reg {
+        return _mm512_xor_pd(a, _mm512_and_pd(b, _mm512_set1_pd(-0.0)));
+    }
+
+    /// Returns `if_true` in the lanes where lhs > rhs, and `if_false` elsewhere
+    MATH3D_TARGET_AVX512 static auto select_gt(Reg lhs, Reg rhs, Reg if_true,
+                                               Reg if_false) -> Reg {
+        return _mm512_mask_blend_pd(_mm512_cmp_pd_mask(lhs, rhs, _CMP_GT_OQ),
+                                    if_false, if_true);
+    }
+
+    /// Returns a bitmask with the bit i set if lhs >= rhs in the i-th lane
+    MATH3D_TARGET_AVX512 static auto mask_ge(Reg lhs, Reg rhs) -> uint32_t {
+        return static_cast<uint32_t>(_mm512_cmp_pd_mask(lhs, rhs, _CMP_GE_OQ));
+    }
+
+#if defined(MATH3D_VEC3_PADDED)
+    /// Loads 8 consecutive Vector3 (32 doubles, xyz0 interleaved) as x, y, z
+    MATH3D_TARGET_AVX512 static auto load_aos3(const float64_t* src, Reg& x,
+                                               Reg& y, Reg& z) -> void {
+        auto a = _mm512_loadu_pd(src);
+        auto b = _mm512_loadu_pd(src + 8);
+        auto c = _mm512_loadu_pd(src + 16);
+        auto d = _mm512_loadu_pd(src + 24);
+        // Same scheme as the float32 version (a|b and c|d, then joined)
+        const auto x_idx = _mm512_setr_epi64(0, 4, 8, 12, 0, 4, 8, 12);
+        const auto y_idx = _mm512_add_epi64(x_idx, _mm512_set1_epi64(1));
+        const auto z_idx = _mm512_add_epi64(x_idx, _mm512_set1_epi64(2));
+        x = _mm512_shuffle_f64x2(_mm512_permutex2var_pd(a, x_idx, b),
+                                 _mm512_permutex2var_pd(c, x_idx, d), 0x44);
+        y = _mm512_shuffle_f64x2(_mm512_permutex2var_pd(a, y_idx, b),
+                                 _mm512_permutex2var_pd(c, y_idx, d), 0x44);
+        z = _mm512_shuffle_f64x2(_mm512_permutex2var_pd(a, z_idx, b),
+                                 _mm512_permutex2var_pd(c, z_idx, d), 0x44);
+    }
+
+    /// Stores x, y, z as 8 consecutive Vector3 (32 doubles, xyz0 interleaved)
+    MATH3D_TARGET_AVX512 static auto store_aos3(float64_t* dst, Reg x, Reg y,
+                                                Reg z) -> void {
+        // Same scheme as the float32 version (2 vectors per register)
+        const auto idx = _mm512_setr_epi64(0, 8, 0, 0, 1, 9, 1, 0);
+        for (int64_t r = 0; r < 4; ++r) {
+            auto idx_r = _mm512_add_epi64(idx, _mm512_set1_epi64(2 * r));
+            auto xy = _mm512_maskz_permutex2var_pd(0x33, x, idx_r, y);
+            _mm512_storeu_pd(dst + 8 * r,
+                             _mm512_mask_permutexvar_pd(xy, 0x44, idx_r, z));
+        }
+    }
+#else
+    /// Loads 8 consecutive Vector3 (24 doubles, xyz interleaved) as x, y, z
+    MATH3D_TARGET_AVX512 static auto load_aos3(const float64_t* src, Reg& x,
+                                               Reg& y, Reg& z) -> void {
+        auto a = _mm512_loadu_pd(src);
+        auto b = _mm512_loadu_pd(src + 8);
+        auto c = _mm512_loadu_pd(src + 16);
+        // Same scheme as the float32 version (a|b first, then c)
+        const auto x_ab = _mm512_setr_epi64(0, 3, 6, 9, 12, 15, 0, 0);
+        const auto x_c = _mm512_setr_epi64(0, 1, 2, 3, 4, 5, 10, 13);
+        const auto y_ab = _mm512_setr_epi64(1, 4, 7, 10, 13, 0, 0, 0);
+        const auto y_c = _mm512_setr_epi64(0, 1, 2, 3, 4, 8, 11, 14);
+        const auto z_ab = _mm512_setr_epi64(2, 5, 8, 11, 14, 0, 0, 0);
+        const auto z_c = _mm512_setr_epi64(0, 1, 2, 3, 4, 9, 12, 15);
+        x = _mm512_permutex2var_pd(_mm512_permutex2var_pd(a, x_ab, b), x_c, c);
+        y = _mm512_permutex2var_pd(_mm512_permutex2var_pd(a, y_ab, b), y_c, c);
+        z = _mm512_permutex2var_pd(_mm512_permutex2var_pd(a, z_ab, b), z_c, c);
+    }
+
+    /// Stores x, y, z as 8 consecutive Vector3 (24 doubles, xyz interleaved)
+    MATH3D_TARGET_AVX512 static auto store_aos3(float64_t* dst, Reg x, Reg y,
+                                                Reg z) -> void {
+        // Same scheme as the float32 version (x|y first, then z)
+        const auto a_xy = _mm512_setr_epi64(0, 8, 0, 1, 9, 0, 2, 10);
+        const auto a_z = _mm512_setr_epi64(0, 1, 8, 3, 4, 9, 6, 7);
+        const auto b_xy = _mm512_setr_epi64(0, 3, 11, 0, 4, 12, 0, 5);
+        const auto b_z = _mm512_setr_epi64(10, 1, 2, 11, 4, 5, 12, 7);
+        const auto c_xy = _mm512_setr_epi64(13, 0, 6, 14, 0, 7, 15, 0);
+        const auto c_z = _mm512_setr_epi64(0, 13, 2, 3, 14, 5, 6, 15);
+        _mm512_storeu_pd(dst, _mm512_permutex2var_pd(
+                                  _mm512_permutex2var_pd(x, a_xy, y), a_z, z));
+        _mm512_storeu_pd(
+            dst + 8,
+            _mm512_permutex2var_pd(_mm512_permutex2var_pd(x, b_xy, y), b_z, z));
+        _mm512_storeu_pd(
+            dst + 16,
+            _mm512_permutex2var_pd(_mm512_permutex2var_pd(x, c_xy, y), c_z, z));
+    }
+#endif  // MATH3D_VEC3_PADDED
+};
+
+}  // namespace avx512
+}  // namespace math
+
+#endif  // MATH3D_DISPATCH_AVX512
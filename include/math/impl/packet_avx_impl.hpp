@@ -0,0 +1,398 @@
+#pragma once
+
+#include "../dispatch.hpp"
+
+#if defined(MATH3D_DISPATCH_AVX)
+
+#include <immintrin.h>
+
+/**
+ * Register-level helpers used by the AVX batch kernels (AVX|AVX2|FMA)
+ *
+ * Same interface as sse::Packet<T>, but for ymm registers (8xf32 or 4xf64).
+ * When FMA is available (always the case for the runtime-dispatched kernels),
+ * fmadd/fnmadd map to a single fused instruction.
+ *
+ * Notes:
+ * 1. load_aos3/store_aos3 work on two groups of WIDTH/2 vectors, one per
+ *    128-bit lane, and use the same blend/shuffle trick of the SSE version
+ *    inside each lane (AVX shuffles and blends can't cross lanes). With
+ *    MATH3D_VEC3_PADDED (xyz0xyz0...) the float32 version does the padded SSE
+ *    transpose in each lane, and the float64 version a 4x4 transpose.
+ */
+
+namespace math {
+namespace avx {
+
+template <typename T>
+struct Packet;
+
+// Masks of the shuffles used by load_aos3|store_aos3 for float32, as constants
+// (the intrinsics can be macros, which would split the template arguments)
+constexpr int SHUFFLE_LOW_PAIRS =
+    static_cast<int>(ShuffleMask<1, 0, 1, 0>::value);
+constexpr int SHUFFLE_HIGH_PAIRS =
+    static_cast<int>(ShuffleMask<3, 2, 3, 2>::value);
+constexpr int SHUFFLE_ROTATE_1 =
+    static_cast<int>(ShuffleMask<1, 2, 3, 0>::value);
+constexpr int SHUFFLE_ROTATE_2 =
+    static_cast<int>(ShuffleMask<2, 3, 0, 1>::value);
+constexpr int SHUFFLE_ROTATE_3 =
+    static_cast<int>(ShuffleMask<3, 0, 1, 2>::value);
+
+template <>
+struct Packet<float32_t> {
+    using Reg = __m256;
+    static constexpr size_t WIDTH = 8;
+
+    MATH3D_TARGET_AVX static auto load(const float32_t* src) -> Reg {
+        return _mm256_loadu_ps(src);
+    }
+
+    MATH3D_TARGET_AVX static auto store(float32_t* dst, Reg reg) -> void {
+        _mm256_storeu_ps(dst, reg);
+    }
+
+    MATH3D_TARGET_AVX static auto set1(float32_t value) -> Reg {
+        return _mm256_set1_ps(value);
+    }
+
+    MATH3D_TARGET_AVX static auto zero() -> Reg { return _mm256_setzero_ps(); }
+
+    MATH3D_TARGET_AVX static auto add(Reg lhs, Reg rhs) -> Reg {
+        return _mm256_add_ps(lhs, rhs);
+    }
+
+    MATH3D_TARGET_AVX static auto sub(Reg lhs, Reg rhs) -> Reg {
+        return _mm256_sub_ps(lhs, rhs);
+    }
+
+    MATH3D_TARGET_AVX static auto mul(Reg lhs, Reg rhs) -> Reg {
+        return _mm256_mul_ps(lhs, rhs);
+    }
+
+    MATH3D_TARGET_AVX static auto div(Reg lhs, Reg rhs) -> Reg {
+        return _mm256_div_ps(lhs, rhs);
+    }
+
+    MATH3D_TARGET_AVX static auto sqrt(Reg reg) -> Reg {
+        return _mm256_sqrt_ps(reg);
+    }
+
+    /// Returns a * b + c
+    MATH3D_TARGET_AVX static auto fmadd(Reg a, Reg b, Reg c) -> Reg {
+#if defined(MATH3D_DISPATCH_FMA)
+        return _mm256_fmadd_ps(a, b, c);
+#else
+        return _mm256_add_ps(_mm256_mul_ps(a, b), c);
+#endif
+    }
+
+    /// Returns c - a * b
+    MATH3D_TARGET_AVX static auto fnmadd(Reg a, Reg b, Reg c) -> Reg {
+#if defined(MATH3D_DISPATCH_FMA)
+        return _mm256_fnmadd_ps(a, b, c);
+#else
+        return _mm256_sub_ps(c, _mm256_mul_ps(a, b));
+#endif
+    }
+
+    /// Returns the lane-wise maximum of the given registers
+    MATH3D_TARGET_AVX static auto max(Reg lhs, Reg rhs) -> Reg {
+        return _mm256_max_ps(lhs, rhs);
+    }
+
+    /// Returns the lane-wise minimum of the given registers
+    MATH3D_TARGET_AVX static auto min(Reg lhs, Reg rhs) -> Reg {
+        return _mm256_min_ps(lhs, rhs);
+    }
+
+    /// Returns the absolute value of each lane
+    MATH3D_TARGET_AVX static auto abs(Reg reg) -> Reg {
+        return _mm256_andnot_ps(_mm256_set1_ps(-0.0F), reg);
+    }
+
+    /// Rounds each lane to the nearest integer (ties to even)
+    MATH3D_TARGET_AVX static auto round(Reg reg) -> Reg {
+        return _mm256_round_ps(reg,
+                               _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    }
+
+    /// Rounds each lane down to an integer
+    MATH3D_TARGET_AVX static auto floor(Reg reg) -> Reg {
+        return _mm256_floor_ps(reg);
+    }
+
+    /// Returns `a` with its sign flipped in the lanes where `b` is negative
+    MATH3D_TARGET_AVX static auto mulsign(Reg a, Reg b) -> Reg {
+        return _mm256_xor_ps(a, _mm256_and_ps(b, _mm256_set1_ps(-0.0F)));
+    }
+
+    /// Returns `if_true` in the lanes where lhs > rhs, and `if_false` elsewhere
+    MATH3D_TARGET_AVX static auto select_gt(Reg lhs, Reg rhs, Reg if_true,
+                                            Reg if_false) -> Reg {
+        return _mm256_blendv_ps(if_false, if_true,
+                                _mm256_cmp_ps(lhs, rhs, _CMP_GT_OQ));
+    }
+
+    /// Returns a bitmask with the bit i set if lhs >= rhs in the i-th lane
+    MATH3D_TARGET_AVX static auto mask_ge(Reg lhs, Reg rhs) -> uint32_t {
+        return static_cast<uint32_t>(
+            _mm256_movemask_ps(_mm256_cmp_ps(lhs, rhs, _CMP_GE_OQ)));
+    }
+
+#if defined(MATH3D_VEC3_PADDED)
+    /// Loads 8 consecutive Vector3 (32 floats, xyz0 interleaved) as x, y, z
+    MATH3D_TARGET_AVX static auto load_aos3(const float32_t* src, Reg& x,
+                                            Reg& y, Reg& z) -> void {
+        // Vectors 0-3 go into the low lane, and vectors 4-7 into the high one
+        auto a = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(src)),
+                                      _mm_loadu_ps(src + 16), 1);
+        auto b = _mm256_insertf128_ps(
+            _mm256_castps128_ps256(_mm_loadu_ps(src + 4)),
+            _mm_loadu_ps(src + 20), 1);
+        auto c = _mm256_insertf128_ps(
+            _mm256_castps128_ps256(_mm_loadu_ps(src + 8)),
+            _mm_loadu_ps(src + 24), 1);
+        auto d = _mm256_insertf128_ps(
+            _mm256_castps128_ps256(_mm_loadu_ps(src + 12)),
+            _mm_loadu_ps(src + 28), 1);
+        auto t0 = _mm256_unpacklo_ps(a, b);
+        auto t1 = _mm256_unpackhi_ps(a, b);
+        auto t2 = _mm256_unpacklo_ps(c, d);
+        auto t3 = _mm256_unpackhi_ps(c, d);
+        x = _mm256_shuffle_ps(t0, t2, SHUFFLE_LOW_PAIRS);
+        y = _mm256_shuffle_ps(t0, t2, SHUFFLE_HIGH_PAIRS);
+        z = _mm256_shuffle_ps(t1, t3, SHUFFLE_LOW_PAIRS);
+    }
+
+    /// Stores x, y, z as 8 consecutive Vector3 (32 floats, xyz0 interleaved)
+    MATH3D_TARGET_AVX static auto store_aos3(float32_t* dst, Reg x, Reg y,
+                                             Reg z) -> void {
+        auto t0 = _mm256_unpacklo_ps(x, y);
+        auto t1 = _mm256_unpackhi_ps(x, y);
+        auto t2 = _mm256_unpacklo_ps(z, _mm256_setzero_ps());
+        auto t3 = _mm256_unpackhi_ps(z, _mm256_setzero_ps());
+        auto a = _mm256_shuffle_ps(t0, t2, SHUFFLE_LOW_PAIRS);
+        auto b = _mm256_shuffle_ps(t0, t2, SHUFFLE_HIGH_PAIRS);
+        auto c = _mm256_shuffle_ps(t1, t3, SHUFFLE_LOW_PAIRS);
+        auto d = _mm256_shuffle_ps(t1, t3, SHUFFLE_HIGH_PAIRS);
+        _mm_storeu_ps(dst, _mm256_castps256_ps128(a));
+        _mm_storeu_ps(dst + 4, _mm256_castps256_ps128(b));
+        _mm_storeu_ps(dst + 8, _mm256_castps256_ps128(c));
+        _mm_storeu_ps(dst + 12, _mm256_castps256_ps128(d));
+        _mm_storeu_ps(dst + 16, _mm256_extractf128_ps(a, 1));
+        _mm_storeu_ps(dst + 20, _mm256_extractf128_ps(b, 1));
+        _mm_storeu_ps(dst + 24, _mm256_extractf128_ps(c, 1));
+        _mm_storeu_ps(dst + 28, _mm256_extractf128_ps(d, 1));
+    }
+#else
+    /// Loads 8 consecutive Vector3 (24 floats, xyz interleaved) as x, y, z
+    MATH3D_TARGET_AVX static auto load_aos3(const float32_t* src, Reg& x,
+                                            Reg& y, Reg& z) -> void {
+        // Vectors 0-3 go into the low lane, and vectors 4-7 into the high one
+        auto a = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(src)),
+                                      _mm_loadu_ps(src + 12), 1);
+        auto b = _mm256_insertf128_ps(
+            _mm256_castps128_ps256(_mm_loadu_ps(src + 4)),
+            _mm_loadu_ps(src + 16), 1);
+        auto c = _mm256_insertf128_ps(
+            _mm256_castps128_ps256(_mm_loadu_ps(src + 8)),
+            _mm_loadu_ps(src + 20), 1);
+        auto tx = _mm256_blend_ps(_mm256_blend_ps(a, b, 0x44), c, 0x22);
+        auto ty = _mm256_blend_ps(_mm256_blend_ps(b, a, 0x22), c, 0x44);
+        auto tz = _mm256_blend_ps(_mm256_blend_ps(c, b, 0x22), a, 0x44);
+        x = _mm256_shuffle_ps(tx, tx, SHUFFLE_ROTATE_1);
+        y = _mm256_shuffle_ps(ty, ty, SHUFFLE_ROTATE_2);
+        z = _mm256_shuffle_ps(tz, tz, SHUFFLE_ROTATE_3);
+    }
+
+    /// Stores x, y, z as 8 consecutive Vector3 (24 floats, xyz interleaved)
+    MATH3D_TARGET_AVX static auto store_aos3(float32_t* dst, Reg x, Reg y,
+                                             Reg z) -> void {
+        auto tx = _mm256_shuffle_ps(x, x, SHUFFLE_ROTATE_1);
+        auto ty = _mm256_shuffle_ps(y, y, SHUFFLE_ROTATE_2);
+        auto tz = _mm256_shuffle_ps(z, z, SHUFFLE_ROTATE_3);
+        auto a = _mm256_blend_ps(_mm256_blend_ps(tx, ty, 0x22), tz, 0x44);
+        auto b = _mm256_blend_ps(_mm256_blend_ps(ty, tz, 0x22), tx, 0x44);
+        auto c = _mm256_blend_ps(_mm256_blend_ps(tz, tx, 0x22), ty, 0x44);
+        _mm_storeu_ps(dst, _mm256_castps256_ps128(a));
+        _mm_storeu_ps(dst + 4, _mm256_castps256_ps128(b));
+        _mm_storeu_ps(dst + 8, _mm256_castps256_ps128(c));
+        _mm_storeu_ps(dst + 12, _mm256_extractf128_ps(a, 1));
+        _mm_storeu_ps(dst + 16, _mm256_extractf128_ps(b, 1));
+        _mm_storeu_ps(dst + 20, _mm256_extractf128_ps(c, 1));
+    }
+#endif  // MATH3D_VEC3_PADDED
+};
+
+template <>
+struct Packet<float64_t> {
+    using Reg = __m256d;
+    static constexpr size_t WIDTH = 4;
+
+    MATH3D_TARGET_AVX static auto load(const float64_t* src) -> Reg {
+        return _mm256_loadu_pd(src);
+    }
+
+    MATH3D_TARGET_AVX static auto store(float64_t* dst, Reg reg) -> void {
+        _mm256_storeu_pd(dst, reg);
+    }
+
+    MATH3D_TARGET_AVX static auto set1(float64_t value) -> Reg {
+        return _mm256_set1_pd(value);
+    }
+
+    MATH3D_TARGET_AVX static auto zero() -> Reg { return _mm256_setzero_pd(); }
+
+    MATH3D_TARGET_AVX static auto add(Reg lhs, Reg rhs) -> Reg {
+        return _mm256_add_pd(lhs, rhs);
+    }
+
+    MATH3D_TARGET_AVX static auto sub(Reg lhs, Reg rhs) -> Reg {
+        return _mm256_sub_pd(lhs, rhs);
+    }
+
+    MATH3D_TARGET_AVX static auto mul(Reg lhs, Reg rhs) -> Reg {
+        return _mm256_mul_pd(lhs, rhs);
+    }
+
+    MATH3D_TARGET_AVX static auto div(Reg lhs, Reg rhs) -> Reg {
+        return _mm256_div_pd(lhs, rhs);
+    }
+
+    MATH3D_TARGET_AVX static auto sqrt(Reg reg) -> Reg {
+        return _mm256_sqrt_pd(reg);
+    }
+
+    /// Returns a * b + c
+    MATH3D_TARGET_AVX static auto fmadd(Reg a, Reg b, Reg c) -> Reg {
+#if defined(MATH3D_DISPATCH_FMA)
+        return _mm256_fmadd_pd(a, b, c);
+#else
+        return _mm256_add_pd(_mm256_mul_pd(a, b), c);
+#endif
+    }
+
+    /// Returns c - a * b
+    MATH3D_TARGET_AVX static auto fnmadd(Reg a, Reg b, Reg c) -> Reg {
+#if defined(MATH3D_DISPATCH_FMA)
+        return _mm256_fnmadd_pd(a, b, c);
+#else
+        return _mm256_sub_pd(c, _mm256_mul_pd(a, b));
+#endif
+    }
+
+    /// Returns the lane-wise maximum of the given registers
+    MATH3D_TARGET_AVX static auto max(Reg lhs, Reg rhs) -> Reg {
+        return _mm256_max_pd(lhs, rhs);
+    }
+
+    /// Returns the lane-wise minimum of the given registers
+    MATH3D_TARGET_AVX static auto min(Reg lhs, Reg rhs) -> Reg {
+        return _mm256_min_pd(lhs, rhs);
+    }
+
+    /// Returns the absolute value of each lane
+    MATH3D_TARGET_AVX static auto abs(Reg reg) -> Reg {
+        return _mm256_andnot_pd(_mm256_set1_pd(-0.0), reg);
+    }
+
+    /// Rounds each lane to the nearest integer (ties to even)
+    MATH3D_TARGET_AVX static auto round(Reg reg) -> Reg {
+        return _mm256_round_pd(reg,
+                               _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    }
+
+    /// Rounds each lane down to an integer
+    MATH3D_TARGET_AVX static auto floor(Reg reg) -> Reg {
+        return _mm256_floor_pd(reg);
+    }
+
+    /// Returns `a` with its sign flipped in the lanes where `b` is negative
+    MATH3D_TARGET_AVX static auto mulsign(Reg a, Reg b) -> Reg {
+        return _mm256_xor_pd(a, _mm256_and_pd(b, _mm256_set1_pd(-0.0)));
+    }
+
+    /// Returns `if_true` in the lanes where lhs > rhs, and `if_false` elsewhere
+    MATH3D_TARGET_AVX static auto select_gt(Reg lhs, Reg rhs, Reg if_true,
+                                            Reg if_false) -> Reg {
+        return _mm256_blendv_pd(if_false, if_true,
+                                _mm256_cmp_pd(lhs, rhs, _CMP_GT_OQ));
+    }
+
+    /// Returns a bitmask with the bit i set if lhs >= rhs in the i-th lane
+    MATH3D_TARGET_AVX static auto mask_ge(Reg lhs, Reg rhs) -> uint32_t {
+        return static_cast<uint32_t>(
+            _mm256_movemask_pd(_mm256_cmp_pd(lhs, rhs, _CMP_GE_OQ)));
+    }
+
+#if defined(MATH3D_VEC3_PADDED)
+    /// Loads 4 consecutive Vector3 (16 doubles, xyz0 interleaved) as x, y, z
+    MATH3D_TARGET_AVX static auto load_aos3(const float64_t* src, Reg& x,
+                                            Reg& y, Reg& z) -> void {
+        // t0 = [x0 x1 z0 z1], t1 = [y0 y1 0 0], t2|t3 same for vectors 2-3
+        auto t0 = _mm256_unpacklo_pd(_mm256_loadu_pd(src),
+                                     _mm256_loadu_pd(src + 4));
+        auto t1 = _mm256_unpackhi_pd(_mm256_loadu_pd(src),
+                                     _mm256_loadu_pd(src + 4));
+        auto t2 = _mm256_unpacklo_pd(_mm256_loadu_pd(src + 8),
+                                     _mm256_loadu_pd(src + 12));
+        auto t3 = _mm256_unpackhi_pd(_mm256_loadu_pd(src + 8),
+                                     _mm256_loadu_pd(src + 12));
+        x = _mm256_permute2f128_pd(t0, t2, 0x20);
+        y = _mm256_permute2f128_pd(t1, t3, 0x20);
+        z = _mm256_permute2f128_pd(t0, t2, 0x31);
+    }
+
+    /// Stores x, y, z as 4 consecutive Vector3 (16 doubles, xyz0 interleaved)
+    MATH3D_TARGET_AVX static auto store_aos3(float64_t* dst, Reg x, Reg y,
+                                             Reg z) -> void {
+        // a = [x0 x1 z0 z1], c = [y0 y1 0 0], b|d same for vectors 2-3
+        auto a = _mm256_permute2f128_pd(x, z, 0x20);
+        auto b = _mm256_permute2f128_pd(x, z, 0x31);
+        auto c = _mm256_permute2f128_pd(y, _mm256_setzero_pd(), 0x20);
+        auto d = _mm256_permute2f128_pd(y, _mm256_setzero_pd(), 0x31);
+        _mm256_storeu_pd(dst, _mm256_unpacklo_pd(a, c));
+        _mm256_storeu_pd(dst + 4, _mm256_unpackhi_pd(a, c));
+        _mm256_storeu_pd(dst + 8, _mm256_unpacklo_pd(b, d));
+        _mm256_storeu_pd(dst + 12, _mm256_unpackhi_pd(b, d));
+    }
+#else
+    /// Loads 4 consecutive Vector3 (12 doubles, xyz interleaved) as x, y, z
+    MATH3D_TARGET_AVX static auto load_aos3(const float64_t* src, Reg& x,
+                                            Reg& y, Reg& z) -> void {
+        // Vectors 0-1 go into the low lane, and vectors 2-3 into the high one
+        auto a = _mm256_insertf128_pd(_mm256_castpd128_pd256(_mm_loadu_pd(src)),
+                                      _mm_loadu_pd(src + 6), 1);
+        auto b = _mm256_insertf128_pd(
+            _mm256_castpd128_pd256(_mm_loadu_pd(src + 2)),
+            _mm_loadu_pd(src + 8), 1);
+        auto c = _mm256_insertf128_pd(
+            _mm256_castpd128_pd256(_mm_loadu_pd(src + 4)),
+            _mm_loadu_pd(src + 10), 1);
+        x = _mm256_shuffle_pd(a, b, 0xa);
+        y = _mm256_shuffle_pd(a, c, 0x5);
+        z = _mm256_shuffle_pd(b, c, 0xa);
+    }
+
+    /// Stores x, y, z as 4 consecutive Vector3 (12 doubles, xyz interleaved)
+    MATH3D_TARGET_AVX static auto store_aos3(float64_t* dst, Reg x, Reg y,
+                                             Reg z) -> void {
+        auto a = _mm256_shuffle_pd(x, y, 0x0);
+        auto b = _mm256_shuffle_pd(z, x, 0xa);
+        auto c = _mm256_shuffle_pd(y, z, 0xf);
+        _mm_storeu_pd(dst, _mm256_castpd256_pd128(a));
+        _mm_storeu_pd(dst + 2, _mm256_castpd256_pd128(b));
+        _mm_storeu_pd(dst + 4, _mm256_castpd256_pd128(c));
+        _mm_storeu_pd(dst + 6, _mm256_extractf128_pd(a, 1));
+        _mm_storeu_pd(dst + 8, _mm256_extractf128_pd(b, 1));
+        _mm_storeu_pd(dst + 10, _mm256_extractf128_pd(c, 1));
+    }
+#endif  // MATH3D_VEC3_PADDED
+};
+
+}  // namespace avx
+}  // namespace math
+
+#endif  // MATH3D_DISPATCH_AVX
@@ -0,0 +1,350 @@
+#pragma once
+
+#include "../dispatch.hpp"
+
+#if defined(MATH3D_DISPATCH_SSE)
+
+#include <emmintrin.h>
+#include <smmintrin.h>
+#include <xmmintrin.h>
+
+/**
+ * Register-level helpers used by the SSE batch kernels (SSE|SSE2|SSE4.1)
+ *
+ * The batch kernels are written once for both float32 and float64 against the
+ * Packet<T> interface below, which just wraps the intrinsics of the matching
+ * width (4xf32 or 2xf64 per xmm register). All functions are compiled with the
+ * SSE target attribute, so they can be used by the runtime-dispatched kernels
+ * even if the translation unit itself is built for a lower ISA.
+ *
+ * Notes:
+ * 1. All loads and stores are unaligned. On the CPUs we target there's no
+ *    penalty when the address happens to be aligned (e.g. the planes of a
+ *    Vector3Batch), and it allows us to use the same kernels on user buffers.
+ *
+ * 2. load_aos3/store_aos3 transpose, within registers, WIDTH consecutive
+ *    Vector3 stored as xyzxyz... into/from one register per coordinate. This
+ *    allows the SIMD kernels to work directly on AoS buffers (e.g. a
+ *    std::vector<Vector3<T>>), without having to copy them into SoA storage.
+ *    With MATH3D_VEC3_PADDED each Vector3 takes 4 entries (xyz0xyz0...), so
+ *    the padded variants are a plain 4x4 (or 2x2 per half) transpose instead,
+ *    and the stores write back a zero padding entry.
+ */
+
+namespace math {
+namespace sse {
+
+template <typename T>
+struct Packet;
+
+// Masks of the shuffles used by load_aos3|store_aos3 for float32, as constants
+// (the intrinsics can be macros, which would split the template arguments)
+constexpr int SHUFFLE_LOW_PAIRS =
+    static_cast<int>(ShuffleMask<1, 0, 1, 0>::value);
+constexpr int SHUFFLE_HIGH_PAIRS =
+    static_cast<int>(ShuffleMask<3, 2, 3, 2>::value);
+constexpr int SHUFFLE_ROTATE_1 =
+    static_cast<int>(ShuffleMask<1, 2, 3, 0>::value);
+constexpr int SHUFFLE_ROTATE_2 =
+    static_cast<int>(ShuffleMask<2, 3, 0, 1>::value);
+constexpr int SHUFFLE_ROTATE_3 =
+    static_cast<int>(ShuffleMask<3, 0, 1, 2>::value);
+
+template <>
+struct Packet<float32_t> {
+    using Reg = __m128;
+    static constexpr size_t WIDTH = 4;
+
+    MATH3D_TARGET_SSE static auto load(const float32_t* src) -> Reg {
+        return _mm_loadu_ps(src);
+    }
+
+    MATH3D_TARGET_SSE static auto store(float32_t* dst, Reg reg) -> void {
+        _mm_storeu_ps(dst, reg);
+    }
+
+    MATH3D_TARGET_SSE static auto set1(float32_t value) -> Reg {
+        return _mm_set1_ps(value);
+    }
+
+    MATH3D_TARGET_SSE static auto zero() -> Reg { return _mm_setzero_ps(); }
+
+    MATH3D_TARGET_SSE static auto add(Reg lhs, Reg rhs) -> Reg {
+        return _mm_add_ps(lhs, rhs);
+    }
+
+    MATH3D_TARGET_SSE static auto sub(Reg lhs, Reg rhs) -> Reg {
+        return _mm_sub_ps(lhs, rhs);
+    }
+
+    MATH3D_TARGET_SSE static auto mul(Reg lhs, Reg rhs) -> Reg {
+        return _mm_mul_ps(lhs, rhs);
+    }
+
+    MATH3D_TARGET_SSE static auto div(Reg lhs, Reg rhs) -> Reg {
+        return _mm_div_ps(lhs, rhs);
+    }
+
+    MATH3D_TARGET_SSE static auto sqrt(Reg reg) -> Reg {
+        return _mm_sqrt_ps(reg);
+    }
+
+    /// Returns a * b + c (no FMA in this tier, so two roundings)
+    MATH3D_TARGET_SSE static auto fmadd(Reg a, Reg b, Reg c) -> Reg {
+        return _mm_add_ps(_mm_mul_ps(a, b), c);
+    }
+
+    /// Returns c - a * b
+    MATH3D_TARGET_SSE static auto fnmadd(Reg a, Reg b, Reg c) -> Reg {
+        return _mm_sub_ps(c, _mm_mul_ps(a, b));
+    }
+
+    /// Returns the lane-wise maximum of the given registers
+    MATH3D_TARGET_SSE static auto max(Reg lhs, Reg rhs) -> Reg {
+        return _mm_max_ps(lhs, rhs);
+    }
+
+    /// Returns the lane-wise minimum of the given registers
+    MATH3D_TARGET_SSE static auto min(Reg lhs, Reg rhs) -> Reg {
+        return _mm_min_ps(lhs, rhs);
+    }
+
+    /// Returns the absolute value of each lane
+    MATH3D_TARGET_SSE static auto abs(Reg reg) -> Reg {
+        return _mm_andnot_ps(_mm_set1_ps(-0.0F), reg);
+    }
+
+    /// Rounds each lane to the nearest integer (ties to even)
+    MATH3D_TARGET_SSE static auto round(Reg reg) -> Reg {
+        return _mm_round_ps(reg, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    }
+
+    /// Rounds each lane down to an integer
+    MATH3D_TARGET_SSE static auto floor(Reg reg) -> Reg {
+        return _mm_floor_ps(reg);
+    }
+
+    /// Returns `a` with its sign flipped in the lanes where `b` is negative
+    MATH3D_TARGET_SSE static auto mulsign(Reg a, Reg b) -> Reg {
+        return _mm_xor_ps(a, _mm_and_ps(b, _mm_set1_ps(-0.0F)));
+    }
+
+    /// Returns `if_true` in the lanes where lhs > rhs, and `if_false` elsewhere
+    MATH3D_TARGET_SSE static auto select_gt(Reg lhs, Reg rhs, Reg if_true,
+                                            Reg if_false) -> Reg {
+        return _mm_blendv_ps(if_false, if_true, _mm_cmpgt_ps(lhs, rhs));
+    }
+
+    /// Returns a bitmask with the bit i set if lhs >= rhs in the i-th lane
+    MATH3D_TARGET_SSE static auto mask_ge(Reg lhs, Reg rhs) -> uint32_t {
+        return static_cast<uint32_t>(_mm_movemask_ps(_mm_cmpge_ps(lhs, rhs)));
+    }
+
+#if defined(MATH3D_VEC3_PADDED)
+    /// Loads 4 consecutive Vector3 (16 floats, xyz0 interleaved) as x, y, z
+    MATH3D_TARGET_SSE static auto load_aos3(const float32_t* src, Reg& x,
+                                            Reg& y, Reg& z) -> void {
+        // t0 = [x0 x1 y0 y1], t1 = [z0 z1 0 0], t2 = [x2 x3 y2 y3], ...
+        auto a = _mm_loadu_ps(src);
+        auto b = _mm_loadu_ps(src + 4);
+        auto c = _mm_loadu_ps(src + 8);
+        auto d = _mm_loadu_ps(src + 12);
+        auto t0 = _mm_unpacklo_ps(a, b);
+        auto t1 = _mm_unpackhi_ps(a, b);
+        auto t2 = _mm_unpacklo_ps(c, d);
+        auto t3 = _mm_unpackhi_ps(c, d);
+        x = _mm_shuffle_ps(t0, t2, SHUFFLE_LOW_PAIRS);
+        y = _mm_shuffle_ps(t0, t2, SHUFFLE_HIGH_PAIRS);
+        z = _mm_shuffle_ps(t1, t3, SHUFFLE_LOW_PAIRS);
+    }
+
+    /// Stores x, y, z as 4 consecutive Vector3 (16 floats, xyz0 interleaved)
+    MATH3D_TARGET_SSE static auto store_aos3(float32_t* dst, Reg x, Reg y,
+                                             Reg z) -> void {
+        // t0 = [x0 y0 x1 y1], t2 = [z0 0 z1 0], t1|t3 same for vectors 2-3
+        auto t0 = _mm_unpacklo_ps(x, y);
+        auto t1 = _mm_unpackhi_ps(x, y);
+        auto t2 = _mm_unpacklo_ps(z, _mm_setzero_ps());
+        auto t3 = _mm_unpackhi_ps(z, _mm_setzero_ps());
+        _mm_storeu_ps(dst,
+                      _mm_shuffle_ps(t0, t2, SHUFFLE_LOW_PAIRS));
+        _mm_storeu_ps(dst + 4,
+                      _mm_shuffle_ps(t0, t2, SHUFFLE_HIGH_PAIRS));
+        _mm_storeu_ps(dst + 8,
+                      _mm_shuffle_ps(t1, t3, SHUFFLE_LOW_PAIRS));
+        _mm_storeu_ps(dst + 12,
+                      _mm_shuffle_ps(t1, t3, SHUFFLE_HIGH_PAIRS));
+    }
+#else
+    /// Loads 4 consecutive Vector3 (12 floats, xyz interleaved) as x, y, z
+    MATH3D_TARGET_SSE static auto load_aos3(const float32_t* src, Reg& x,
+                                            Reg& y, Reg& z) -> void {
+        // a = [x0 y0 z0 x1], b = [y1 z1 x2 y2], c = [z2 x3 y3 z3]
+        auto a = _mm_loadu_ps(src);
+        auto b = _mm_loadu_ps(src + 4);
+        auto c = _mm_loadu_ps(src + 8);
+        // Blend so every lane holds the right coordinate, then fix the order
+        auto tx = _mm_blend_ps(_mm_blend_ps(a, b, 0x4), c, 0x2);  // x0 x3 x2 x1
+        auto ty = _mm_blend_ps(_mm_blend_ps(b, a, 0x2), c, 0x4);  // y1 y0 y3 y2
+        auto tz = _mm_blend_ps(_mm_blend_ps(c, b, 0x2), a, 0x4);  // z2 z1 z0 z3
+        x = _mm_shuffle_ps(tx, tx, SHUFFLE_ROTATE_1);
+        y = _mm_shuffle_ps(ty, ty, SHUFFLE_ROTATE_2);
+        z = _mm_shuffle_ps(tz, tz, SHUFFLE_ROTATE_3);
+    }
+
+    /// Stores x, y, z as 4 consecutive Vector3 (12 floats, xyz interleaved)
+    MATH3D_TARGET_SSE static auto store_aos3(float32_t* dst, Reg x, Reg y,
+                                             Reg z) -> void {
+        // Inverse of load_aos3 (the permutations are their own inverse), so
+        // tx = [x0 x3 x2 x1], ty = [y1 y0 y3 y2], tz = [z2 z1 z0 z3]
+        auto tx = _mm_shuffle_ps(x, x, SHUFFLE_ROTATE_1);
+        auto ty = _mm_shuffle_ps(y, y, SHUFFLE_ROTATE_2);
+        auto tz = _mm_shuffle_ps(z, z, SHUFFLE_ROTATE_3);
+        _mm_storeu_ps(dst, _mm_blend_ps(_mm_blend_ps(tx, ty, 0x2), tz, 0x4));
+        _mm_storeu_ps(dst + 4,
+                      _mm_blend_ps(_mm_blend_ps(ty, tz, 0x2), tx, 0x4));
+        _mm_storeu_ps(dst + 8,
+                      _mm_blend_ps(_mm_blend_ps(tz, tx, 0x2), ty, 0x4));
+    }
+#endif  // MATH3D_VEC3_PADDED
+};
+
+template <>
+struct Packet<float64_t> {
+    using Reg = __m128d;
+    static constexpr size_t WIDTH = 2;
+
+    MATH3D_TARGET_SSE static auto load(const float64_t* src) -> Reg {
+        return _mm_loadu_pd(src);
+    }
+
+    MATH3D_TARGET_SSE static auto store(float64_t* dst, Reg reg) -> void {
+        _mm_storeu_pd(dst, reg);
+    }
+
+    MATH3D_TARGET_SSE static auto set1(float64_t value) -> Reg {
+        return _mm_set1_pd(value);
+    }
+
+    MATH3D_TARGET_SSE static auto zero() -> Reg { return _mm_setzero_pd(); }
+
+    MATH3D_TARGET_SSE static auto add(Reg lhs, Reg rhs) -> Reg {
+        return _mm_add_pd(lhs, rhs);
+    }
+
+    MATH3D_TARGET_SSE static auto sub(Reg lhs, Reg rhs) -> Reg {
+        return _mm_sub_pd(lhs, rhs);
+    }
+
+    MATH3D_TARGET_SSE static auto mul(Reg lhs, Reg rhs) -> Reg {
+        return _mm_mul_pd(lhs, rhs);
+    }
+
+    MATH3D_TARGET_SSE static auto div(Reg lhs, Reg rhs) -> Reg {
+        return _mm_div_pd(lhs, rhs);
+    }
+
+    MATH3D_TARGET_SSE static auto sqrt(Reg reg) -> Reg {
+        return _mm_sqrt_pd(reg);
+    }
+
+    /// Returns a * b + c (no FMA in this tier, so two roundings)
+    MATH3D_TARGET_SSE static auto fmadd(Reg a, Reg b, Reg c) -> Reg {
+        return _mm_add_pd(_mm_mul_pd(a, b), c);
+    }
+
+    /// Returns c - a * b
+    MATH3D_TARGET_SSE static auto fnmadd(Reg a, Reg b, Reg c) -> Reg {
+        return _mm_sub_pd(c, _mm_mul_pd(a, b));
+    }
+
+    /// Returns the lane-wise maximum of the given registers
+    MATH3D_TARGET_SSE static auto max(Reg lhs, Reg rhs) -> Reg {
+        return _mm_max_pd(lhs, rhs);
+    }
+
+    /// Returns the lane-wise minimum of the given registers
+    MATH3D_TARGET_SSE static auto min(Reg lhs, Reg rhs) -> Reg {
+        return _mm_min_pd(lhs, rhs);
+    }
+
+    /// Returns the absolute value of each lane
+    MATH3D_TARGET_SSE static auto abs(Reg reg) -> Reg {
+        return _mm_andnot_pd(_mm_set1_pd(-0.0), reg);
+    }
+
+    /// Rounds each lane to the nearest integer (ties to even)
+    MATH3D_TARGET_SSE static auto round(Reg reg) -> Reg {
+        return _mm_round_pd(reg, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    }
+
+    /// Rounds each lane down to an integer
+    MATH3D_TARGET_SSE static auto floor(Reg reg) -> Reg {
+        return _mm_floor_pd(reg);
+    }
+
+    /// Returns `a` with its sign flipped in the lanes where `b` is negative
+    MATH3D_TARGET_SSE static auto mulsign(Reg a, Reg b) -> Reg {
+        return _mm_xor_pd(a, _mm_and_pd(b, _mm_set1_pd(-0.0)));
+    }
+
+    /// Returns `if_true` in the lanes where lhs > rhs, and `if_false` elsewhere
+    MATH3D_TARGET_SSE static auto select_gt(Reg lhs, Reg rhs, Reg if_true,
+                                            Reg if_false) -> Reg {
+        return _mm_blendv_pd(if_false, if_true, _mm_cmpgt_pd(lhs, rhs));
+    }
+
+    /// Returns a bitmask with the bit i set if lhs >= rhs in the i-th lane
+    MATH3D_TARGET_SSE static auto mask_ge(Reg lhs, Reg rhs) -> uint32_t {
+        return static_cast<uint32_t>(_mm_movemask_pd(_mm_cmpge_pd(lhs, rhs)));
+    }
+
+#if defined(MATH3D_VEC3_PADDED)
+    /// Loads 2 consecutive Vector3 (8 doubles, xyz0 interleaved) as x, y, z
+    MATH3D_TARGET_SSE static auto load_aos3(const float64_t* src, Reg& x,
+                                            Reg& y, Reg& z) -> void {
+        // a = [x0 y0], b = [z0 0], c = [x1 y1], d = [z1 0]
+        auto a = _mm_loadu_pd(src);
+        auto b = _mm_loadu_pd(src + 2);
+        auto c = _mm_loadu_pd(src + 4);
+        auto d = _mm_loadu_pd(src + 6);
+        x = _mm_unpacklo_pd(a, c);
+        y = _mm_unpackhi_pd(a, c);
+        z = _mm_unpacklo_pd(b, d);
+    }
+
+    /// Stores x, y, z as 2 consecutive Vector3 (8 doubles, xyz0 interleaved)
+    MATH3D_TARGET_SSE static auto store_aos3(float64_t* dst, Reg x, Reg y,
+                                             Reg z) -> void {
+        _mm_storeu_pd(dst, _mm_unpacklo_pd(x, y));
+        _mm_storeu_pd(dst + 2, _mm_unpacklo_pd(z, _mm_setzero_pd()));
+        _mm_storeu_pd(dst + 4, _mm_unpackhi_pd(x, y));
+        _mm_storeu_pd(dst + 6, _mm_unpackhi_pd(z, _mm_setzero_pd()));
+    }
+#else
+    /// Loads 2 consecutive Vector3 (6 doubles, xyz interleaved) as x, y, z
+    MATH3D_TARGET_SSE static auto load_aos3(const float64_t* src, Reg& x,
+                                            Reg& y, Reg& z) -> void {
+        // a = [x0 y0], b = [z0 x1], c = [y1 z1]
+        auto a = _mm_loadu_pd(src);
+        auto b = _mm_loadu_pd(src + 2);
+        auto c = _mm_loadu_pd(src + 4);
+        x = _mm_shuffle_pd(a, b, 0x2);
+        y = _mm_shuffle_pd(a, c, 0x1);
+        z = _mm_shuffle_pd(b, c, 0x2);
+    }
+
+    /// Stores x, y, z as 2 consecutive Vector3 (6 doubles, xyz interleaved)
+    MATH3D_TARGET_SSE static auto store_aos3(float64_t* dst, Reg x, Reg y,
+                                             Reg z) -> void {
+        _mm_storeu_pd(dst, _mm_shuffle_pd(x, y, 0x0));
+        _mm_storeu_pd(dst + 2, _mm_shuffle_pd(z, x, 0x2));
+        _mm_storeu_pd(dst + 4, _mm_shuffle_pd(y, z, 0x3));
+    }
+#endif  // MATH3D_VEC3_PADDED
+};
+
+}  // namespace sse
+}  // namespace math
+
+#endif  // MATH3D_DISPATCH_SSE
@@ -0,0 +1,25 @@
+#pragma once
+
+#include "./packet_avx512_impl.hpp"
+#include "./pose3d_batch_t_scalar_impl.hpp"
+
+#if defined(MATH3D_DISPATCH_AVX512)
+
+/**
+ * AVX-512 batch kernels for composing and inverting arrays of Pose3d
+ *
+ * The kernels of pose3d_batch_t_simd_impl.hpp over zmm registers, i.e. 16
+ * float32 or 8 float64 poses per group.
+ */
+
+namespace math {
+namespace avx512 {
+
+#define MATH3D_TARGET_ISA MATH3D_TARGET_AVX512
+#include "./pose3d_batch_t_simd_impl.hpp"
+#undef MATH3D_TARGET_ISA
+
+}  // namespace avx512
+}  // namespace math
+
+#endif  // MATH3D_DISPATCH_AVX512
@@ -0,0 +1,25 @@
+#pragma once
+
+#include "./packet_avx_impl.hpp"
+#include "./pose3d_batch_t_scalar_impl.hpp"
+
+#if defined(MATH3D_DISPATCH_AVX)
+
+/**
+ * AVX batch kernels for composing and inverting arrays of Pose3d
+ *
+ * The kernels of pose3d_batch_t_simd_impl.hpp over ymm registers, i.e. 8
+ * float32 or 4 float64 poses per group.
+ */
+
+namespace math {
+namespace avx {
+
+#define MATH3D_TARGET_ISA MATH3D_TARGET_AVX
+#include "./pose3d_batch_t_simd_impl.hpp"
+#undef MATH3D_TARGET_ISA
+
+}  // namespace avx
+}  // namespace math
+
+#endif  // MATH3D_DISPATCH_AVX
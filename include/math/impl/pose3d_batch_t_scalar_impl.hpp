@@ -0,0 +1,118 @@
+#pragma once
+
+#include <cmath>
+
+#include "../pose3d_t_decl.hpp"
+#include "../quat_t_decl.hpp"
+#include "./vec3_batch_t_scalar_impl.hpp"
+
+/**
+ * Scalar batch kernels for composing and inverting arrays of Pose3d
+ *
+ * - kernel_compose_poses_aos : dst[i] = lhs[i] * rhs[i]
+ * - kernel_invert_poses_aos  : dst[i] = inverse(src[i])
+ *
+ * The poses are taken as arrays of scalars, with the layout of Pose3d (the
+ * position, followed by the orientation as (w, x, y, z)). The orientations
+ * are assumed to be unit quaternions, so rotations use q^-1 = conj(q). The
+ * composed orientation is only renormalized when requested, which saves a
+ * sqrt and a division per pose when the caller renormalizes less often.
+ */
+
+namespace math {
+namespace scalar {
+
+/// Returns the number of scalars between two consecutive poses of an array
+template <typename T>
+constexpr auto pose_aos_stride() -> size_t {
+    return sizeof(Pose3d<T>) / sizeof(T);
+}
+
+/// Returns the index of the orientation's w-coordinate within a pose
+template <typename T>
+constexpr auto pose_quat_offset() -> size_t {
+    return vec3_aos_stride<T>();
+}
+
+template <typename T>
+auto kernel_compose_poses_aos(T* dst, const T* lhs, const T* rhs, size_t num,
+                              bool renormalize) -> void {
+    constexpr size_t STRIDE = pose_aos_stride<T>();
+    constexpr size_t QUAT = pose_quat_offset<T>();
+    for (size_t i = 0; i < num; ++i) {
+        const T* a = lhs + i * STRIDE;
+        const T* b = rhs + i * STRIDE;
+        const T aw = a[QUAT + 0];
+        const T ax = a[QUAT + 1];
+        const T ay = a[QUAT + 2];
+        const T az = a[QUAT + 3];
+        const T bw = b[QUAT + 0];
+        const T bx = b[QUAT + 1];
+        const T by = b[QUAT + 2];
+        const T bz = b[QUAT + 3];
+        const T vx = b[0];
+        const T vy = b[1];
+        const T vz = b[2];
+
+        // Rotate rhs.position by lhs.orientation: t = 2 (u x v), so that
+        // v' = v + w * t + u x t (with q = (w, u) a unit quaternion)
+        const T tx = static_cast<T>(2.0) * (ay * vz - az * vy);
+        const T ty = static_cast<T>(2.0) * (az * vx - ax * vz);
+        const T tz = static_cast<T>(2.0) * (ax * vy - ay * vx);
+
+        T qw = aw * bw - ax * bx - ay * by - az * bz;
+        T qx = aw * bx + ax * bw + ay * bz - az * by;
+        T qy = aw * by - ax * bz + ay * bw + az * bx;
+        T qz = aw * bz + ax * by - ay * bx + az * bw;
+        if (renormalize) {
+            const T inv_norm = static_cast<T>(1.0) /
+                               std::sqrt(qw * qw + qx * qx + qy * qy + qz * qz);
+            qw *= inv_norm;
+            qx *= inv_norm;
+            qy *= inv_norm;
+            qz *= inv_norm;
+        }
+
+        T* q = dst + i * STRIDE;
+        q[0] = a[0] + vx + aw * tx + (ay * tz - az * ty);
+        q[1] = a[1] + vy + aw * ty + (az * tx - ax * tz);
+        q[2] = a[2] + vz + aw * tz + (ax * ty - ay * tx);
+        q[QUAT + 0] = qw;
+        q[QUAT + 1] = qx;
+        q[QUAT + 2] = qy;
+        q[QUAT + 3] = qz;
+    }
+}
+
+template <typename T>
+auto kernel_invert_poses_aos(T* dst, const T* src, size_t num) -> void {
+    constexpr size_t STRIDE = pose_aos_stride<T>();
+    constexpr size_t QUAT = pose_quat_offset<T>();
+    for (size_t i = 0; i < num; ++i) {
+        const T* p = src + i * STRIDE;
+        // inverse(p, q) = (-conj(q) * p, conj(q)), with conj(q) = (w, -u)
+        const T w = p[QUAT + 0];
+        const T ux = -p[QUAT + 1];
+        const T uy = -p[QUAT + 2];
+        const T uz = -p[QUAT + 3];
+        const T vx = p[0];
+        const T vy = p[1];
+        const T vz = p[2];
+
+        const T tx = static_cast<T>(2.0) * (uy * vz - uz * vy);
+        const T ty = static_cast<T>(2.0) * (uz * vx - ux * vz);
+        const T tz = static_cast<T>(2.0) * (ux * vy - uy * vx);
+
+        T* q = dst + i * STRIDE;
+        q[0] = -(vx + w * tx + (uy * tz - uz * ty));
+        q[1] = -(vy + w * ty + (uz * tx - ux * tz));
+        q[2] = -(vz + w * tz + (ux * ty - uy * tx));
+        q[QUAT + 0] = w;
+        q[QUAT + 1] = ux;
+        q[QUAT + 2] = uy;
+        q[QUAT + 3] = uz;
+    }
+}
+
+}  // namespace scalar
+}  // namespace math
@@ -0,0 +1,181 @@
+// No include guard, see MATH3D_TARGET_ISA in dispatch.hpp
+#if !defined(MATH3D_TARGET_ISA)
+#error "Include the SSE, AVX or AVX-512 header of these kernels"
+#endif
+
+/**
+ * SIMD batch kernels for composing and inverting arrays of Pose3d (SSE, AVX
+ * and AVX-512)
+ *
+ * Notes:
+ * 1. Each group of WIDTH poses is first transposed into SoA form, i.e. one
+ *    register per coordinate (3 for the position and 4 for the orientation),
+ *    going through a small tile in the stack. Then each lane of a register
+ *    holds a different pose, and the quaternion product and rotation are just
+ *    chains of (fused) multiply-adds, same as in the scalar kernels.
+ *
+ * 2. The renormalization (if requested) is done for the whole group at once,
+ *    with a single sqrt and division per register.
+ */
+
+/// Group of Packet<T>::WIDTH poses, with each coordinate in its own register
+template <typename T>
+struct PosePacket {
+    using P = Packet<T>;
+    using Reg = typename P::Reg;
+
+    static constexpr size_t STRIDE = scalar::pose_aos_stride<T>();
+    static constexpr size_t QUAT = scalar::pose_quat_offset<T>();
+    /// Number of coordinates of a pose (3 for position, 4 for orientation)
+    static constexpr size_t NUM_COORDS = 7;
+
+    /// Position (x, y, z) of the poses
+    Reg pos[3];
+    /// Orientation (w, x, y, z) of the poses
+    Reg quat[4];
+
+    /// Gathers WIDTH consecutive poses from the given array
+    MATH3D_TARGET_ISA auto load(const T* src) -> void {
+        T tile[NUM_COORDS][P::WIDTH];
+        for (size_t lane = 0; lane < P::WIDTH; ++lane) {
+            const T* pose = src + lane * STRIDE;
+            for (size_t k = 0; k < 3; ++k) {
+                tile[k][lane] = pose[k];
+            }
+            for (size_t k = 0; k < 4; ++k) {
+                tile[3 + k][lane] = pose[QUAT + k];
+            }
+        }
+        for (size_t k = 0; k < 3; ++k) {
+            pos[k] = P::load(tile[k]);
+        }
+        for (size_t k = 0; k < 4; ++k) {
+            quat[k] = P::load(tile[3 + k]);
+        }
+    }
+
+    /// Scatters the poses into WIDTH consecutive entries of the given array
+    MATH3D_TARGET_ISA auto store(T* dst) const -> void {
+        T tile[NUM_COORDS][P::WIDTH];
+        for (size_t k = 0; k < 3; ++k) {
+            P::store(tile[k], pos[k]);
+        }
+        for (size_t k = 0; k < 4; ++k) {
+            P::store(tile[3 + k], quat[k]);
+        }
+        for (size_t lane = 0; lane < P::WIDTH; ++lane) {
+            T* pose = dst + lane * STRIDE;
+            for (size_t k = 0; k < 3; ++k) {
+                pose[k] = tile[k][lane];
+            }
+            for (size_t k = 0; k < 4; ++k) {
+                pose[QUAT + k] = tile[3 + k][lane];
+            }
+        }
+    }
+};
+
+/// Stores into dst the vector v rotated by the unit quaternion (w, ux, uy, uz)
+template <typename T>
+MATH3D_TARGET_ISA auto rotate_packet(typename Packet<T>::Reg* dst,
+                                     typename Packet<T>::Reg w,
+                                     typename Packet<T>::Reg ux,
+                                     typename Packet<T>::Reg uy,
+                                     typename Packet<T>::Reg uz,
+                                     const typename Packet<T>::Reg* v)
+    -> void {
+    using P = Packet<T>;
+    // t = 2 (u x v), v' = v + w * t + u x t
+    const auto two = P::set1(static_cast<T>(2.0));
+    auto tx = P::mul(two, P::fnmadd(uz, v[1], P::mul(uy, v[2])));
+    auto ty = P::mul(two, P::fnmadd(ux, v[2], P::mul(uz, v[0])));
+    auto tz = P::mul(two, P::fnmadd(uy, v[0], P::mul(ux, v[1])));
+    dst[0] = P::add(P::fmadd(w, tx, v[0]), P::fnmadd(uz, ty, P::mul(uy, tz)));
+    dst[1] = P::add(P::fmadd(w, ty, v[1]), P::fnmadd(ux, tz, P::mul(uz, tx)));
+    dst[2] = P::add(P::fmadd(w, tz, v[2]), P::fnmadd(uy, tx, P::mul(ux, ty)));
+}
+
+template <typename T>
+MATH3D_TARGET_ISA auto kernel_compose_poses_aos(T* dst, const T* lhs,
+                                                const T* rhs, size_t num,
+                                                bool renormalize) -> void {
+    using P = Packet<T>;
+    constexpr size_t STRIDE = scalar::pose_aos_stride<T>();
+    size_t i = 0;
+    for (; i + P::WIDTH <= num; i += P::WIDTH) {
+        PosePacket<T> a, b, res;  // NOLINT
+        a.load(lhs + i * STRIDE);
+        b.load(rhs + i * STRIDE);
+        const auto& qa = a.quat;
+        const auto& qb = b.quat;
+
+        typename P::Reg rotated[3];
+        rotate_packet<T>(rotated, qa[0], qa[1], qa[2], qa[3], b.pos);
+        for (size_t k = 0; k < 3; ++k) {
+            res.pos[k] = P::add(a.pos[k], rotated[k]);
+        }
+
+        // Hamilton product (same terms as in kernel_quatmul_quat)
+        auto qw = P::fnmadd(qa[3], qb[3],
+                            P::fnmadd(qa[2], qb[2],
+                                      P::fnmadd(qa[1], qb[1],
+                                                P::mul(qa[0], qb[0]))));
+        auto qx = P::fnmadd(qa[3], qb[2],
+                            P::fmadd(qa[2], qb[3],
+                                     P::fmadd(qa[1], qb[0],
+                                              P::mul(qa[0], qb[1]))));
+        auto qy = P::fmadd(qa[3], qb[1],
+                           P::fmadd(qa[2], qb[0],
+                                    P::fnmadd(qa[1], qb[3],
+                                              P::mul(qa[0], qb[2]))));
+        auto qz = P::fmadd(qa[3], qb[0],
+                           P::fnmadd(qa[2], qb[1],
+                                     P::fmadd(qa[1], qb[2],
+                                              P::mul(qa[0], qb[3]))));
+        if (renormalize) {
+            auto norm = P::sqrt(P::fmadd(
+                qz, qz, P::fmadd(qy, qy, P::fmadd(qx, qx, P::mul(qw, qw)))));
+            auto inv_norm = P::div(P::set1(static_cast<T>(1.0)), norm);
+            qw = P::mul(qw, inv_norm);
+            qx = P::mul(qx, inv_norm);
+            qy = P::mul(qy, inv_norm);
+            qz = P::mul(qz, inv_norm);
+        }
+        res.quat[0] = qw;
+        res.quat[1] = qx;
+        res.quat[2] = qy;
+        res.quat[3] = qz;
+        res.store(dst + i * STRIDE);
+    }
+    scalar::kernel_compose_poses_aos<T>(dst + i * STRIDE, lhs + i * STRIDE,
+                                        rhs + i * STRIDE, num - i,
+                                        renormalize);
+}
+
+template <typename T>
+MATH3D_TARGET_ISA auto kernel_invert_poses_aos(T* dst, const T* src,
+                                               size_t num) -> void {
+    using P = Packet<T>;
+    constexpr size_t STRIDE = scalar::pose_aos_stride<T>();
+    size_t i = 0;
+    for (; i + P::WIDTH <= num; i += P::WIDTH) {
+        PosePacket<T> pose, res;  // NOLINT
+        pose.load(src + i * STRIDE);
+        // inverse(p, q) = (-conj(q) * p, conj(q)), with conj(q) = (w, -u)
+        const auto zero = P::zero();
+        res.quat[0] = pose.quat[0];
+        res.quat[1] = P::sub(zero, pose.quat[1]);
+        res.quat[2] = P::sub(zero, pose.quat[2]);
+        res.quat[3] = P::sub(zero, pose.quat[3]);
+
+        typename P::Reg rotated[3];
+        rotate_packet<T>(rotated, res.quat[0], res.quat[1], res.quat[2],
+                         res.quat[3], pose.pos);
+        for (size_t k = 0; k < 3; ++k) {
+            res.pos[k] = P::sub(zero, rotated[k]);
+        }
+        res.store(dst + i * STRIDE);
+    }
+    scalar::kernel_invert_poses_aos<T>(dst + i * STRIDE, src + i * STRIDE,
+                                       num - i);
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include "./fast_math_avx_impl.hpp"
+#include "./packet_avx_impl.hpp"
+#include "./quat_batch_t_scalar_impl.hpp"
+
+#if defined(MATH3D_DISPATCH_AVX)
+
+/**
+ * AVX batch kernels for interpolating and converting arrays of quaternions
+ *
+ * The kernels of quat_batch_t_simd_impl.hpp over ymm registers, i.e. 8
+ * float32 or 4 float64 pairs per group.
+ */
+
+namespace math {
+namespace avx {
+
+#define MATH3D_TARGET_ISA MATH3D_TARGET_AVX
+#include "./quat_batch_t_simd_impl.hpp"
+#undef MATH3D_TARGET_ISA
+
+}  // namespace avx
+}  // namespace math
+
+#endif  // MATH3D_DISPATCH_AVX
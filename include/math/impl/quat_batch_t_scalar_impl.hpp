@@ -0,0 +1,343 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+#include "../quat_t_decl.hpp"
+#include "./fast_math_scalar_impl.hpp"
+#include "./mat4_batch_t_scalar_impl.hpp"
+#include "./quat_t_scalar_impl.hpp"
+#include "./vec3_batch_t_scalar_impl.hpp"
+
+/**
+ * Scalar batch kernels and helpers for quaternions
+ *
+ * Notes:
+ * 1. Rotating a vector with the expanded form of q * p * q^-1 takes ~30 flops,
+ *    whereas multiplying by the equivalent 3x3 rotation matrix takes 15. So
+ *    for batches we build the matrix once, and reuse the (dispatched) kernels
+ *    that transform arrays of 3d vectors by a Matrix4 (mat4_batch_t_*_impl)
+ *
+ * 2. The batched slerp replaces acos and sin by polynomials, so the SIMD
+ *    kernels can evaluate them with (fused) multiply-adds only:
+ *
+ *        acos(x) ~= sqrt(1 - x) * p(x), x in [0, 1], |error| <= 2e-8
+ *        sin(x)  ~= x * q(x^2),         x in [0, pi/2], |error| <= 7e-10
+ *
+ *    (Abramowitz & Stegun 4.4.46, and the Taylor series up to x^13). Taking
+ *    the shortest path keeps the angle in [0, pi/2], so for alpha in [0, 1]
+ *    the entries of the results are within 2e-8 of the exact slerp for
+ *    float64, while for float32 the rounding errors dominate (~3e-7). The
+ *    scalar kernels use the same approximations, so every kernel-set gives
+ *    the same results up to rounding
+ *
+ * 3. If both quaternions are the same (angle of zero) the angle is clamped to
+ *    a tiny value, for which sin(t * angle) / sin(angle) = t, i.e. the slerp
+ *    becomes a lerp instead of 0 / 0 (without any branch in the SIMD kernels)
+ *
+ * 4. The six orders of (intrinsic) Euler angles only differ in the signs of
+ *    the second product of each entry of the quaternion, e.g. for XYZ:
+ *
+ *        w = c1 c2 c3 - s1 s2 s3,  x = s1 c2 c3 + c1 s2 s3, ...
+ *
+ *    (with ci, si the cosine and sine of half of each angle). So the order is
+ *    resolved once per batch into a table of signs (euler_quat_signs), instead
+ *    of a switch for each set of angles
+ *
+ * 5. Each of the four branches of Quaternion::setFromRotationMatrix gives the
+ *    quaternion as a column of the same symmetric matrix (built from the sums
+ *    and differences of the off-diagonal entries), scaled by 0.5 / sqrt(t),
+ *    where t is the diagonal entry of that column. The SIMD kernels compute
+ *    all candidates and select the column with compares and blends, so they
+ *    pick the same branch per matrix, but take a single sqrt and no branches
+ *
+ * 6. The sines and cosines of the half-angles of the Euler angles come from the
+ *    fast sincos kernels (fast_math_*_impl.hpp), so the SIMD kernels evaluate
+ *    a whole register of angles at once, and all kernel-sets agree up to
+ *    rounding. With Accuracy::FULL the results are within ~1 ulp of the ones
+ *    of Quaternion::setFromEuler (which uses <cmath> by default)
+ */
+
+namespace math {
+namespace scalar {
+
+/// Stores into the given Matrix4 storage the rotation given by the quaternion
+///
+/// The quaternion doesn't have to be normalized (same as q * p * q^-1), and
+/// the translation part of the resulting transform is set to zero
+template <typename T>
+auto kernel_rotation_mat4_quat(Mat4Columns<T>& dst, const QuatBuffer<T>& quat)
+    -> void {
+    auto q_w = quat[0];
+    auto q_x = quat[1];
+    auto q_y = quat[2];
+    auto q_z = quat[3];
+
+    auto scale =
+        static_cast<T>(2.0) / (q_w * q_w + q_x * q_x + q_y * q_y + q_z * q_z);
+    auto xx = scale * q_x * q_x;
+    auto yy = scale * q_y * q_y;
+    auto zz = scale * q_z * q_z;
+    auto xy = scale * q_x * q_y;
+    auto xz = scale * q_x * q_z;
+    auto yz = scale * q_y * q_z;
+    auto wx = scale * q_w * q_x;
+    auto wy = scale * q_w * q_y;
+    auto wz = scale * q_w * q_z;
+
+    constexpr T ZERO = static_cast<T>(0.0);
+    constexpr T ONE = static_cast<T>(1.0);
+    // Recall that the storage is column-major, i.e. dst[col][row]
+    dst[0] = Vector4<T>(ONE - (yy + zz), xy + wz, xz - wy, ZERO);
+    dst[1] = Vector4<T>(xy - wz, ONE - (xx + zz), yz + wx, ZERO);
+    dst[2] = Vector4<T>(xz + wy, yz - wx, ONE - (xx + yy), ZERO);
+    dst[3] = Vector4<T>(ZERO, ZERO, ZERO, ONE);
+}
+
+/// Number of scalars between two consecutive quaternions in AoS storage
+template <typename T>
+constexpr auto quat_aos_stride() -> size_t {
+    return sizeof(Quaternion<T>) / sizeof(T);
+}
+
+/// Number of scalars between two consecutive Matrix3 in AoS storage
+template <typename T>
+constexpr auto mat3_aos_stride() -> size_t {
+    return sizeof(Matrix3<T>) / sizeof(T);
+}
+
+/// Smallest angle used by the batched slerp (see note 3 above)
+constexpr double SLERP_MIN_ANGLE = 1e-30;
+
+/// Coefficients of p(x) in acos(x) ~= sqrt(1 - x) * p(x) (highest degree first)
+template <typename T>
+constexpr auto acos_poly_coeffs() -> std::array<T, 8> {
+    return {{static_cast<T>(-0.0012624911), static_cast<T>(0.0066700901),
+             static_cast<T>(-0.0170881256), static_cast<T>(0.0308918810),
+             static_cast<T>(-0.0501743046), static_cast<T>(0.0889789874),
+             static_cast<T>(-0.2145988016), static_cast<T>(1.5707963050)}};
+}
+
+/// Coefficients of q(x^2) in sin(x) ~= x * q(x^2) (highest degree first)
+template <typename T>
+constexpr auto sin_poly_coeffs() -> std::array<T, 7> {
+    return {{static_cast<T>(1.0 / 6227020800.0),
+             static_cast<T>(-1.0 / 39916800.0), static_cast<T>(1.0 / 362880.0),
+             static_cast<T>(-1.0 / 5040.0), static_cast<T>(1.0 / 120.0),
+             static_cast<T>(-1.0 / 6.0), static_cast<T>(1.0)}};
+}
+
+/// Returns the approximation of acos(x) used by the batched slerp
+template <typename T>
+auto acos_poly(T x) -> T {
+    constexpr auto COEFFS = acos_poly_coeffs<T>();
+    T poly = COEFFS[0];
+    for (size_t k = 1; k < COEFFS.size(); ++k) {
+        poly = poly * x + COEFFS[k];
+    }
+    return std::sqrt(std::max(static_cast<T>(1.0) - x, static_cast<T>(0.0))) *
+           poly;
+}
+
+/// Returns the approximation of sin(x) used by the batched slerp
+template <typename T>
+auto sin_poly(T x) -> T {
+    constexpr auto COEFFS = sin_poly_coeffs<T>();
+    const T x2 = x * x;
+    T poly = COEFFS[0];
+    for (size_t k = 1; k < COEFFS.size(); ++k) {
+        poly = poly * x2 + COEFFS[k];
+    }
+    return x * poly;
+}
+
+/// Interpolates between the quaternions (w, x, y, z) at `q_a` and `q_b`, with
+/// `alpha` being read at `alpha[i * alpha_stride]` for the i-th pair (so a
+/// stride of zero uses the same alpha for all pairs)
+template <typename T>
+auto kernel_slerp_quat_aos(T* dst, const T* q_a, const T* q_b, const T* alpha,
+                           size_t alpha_stride, size_t num) -> void {
+    constexpr size_t STRIDE = quat_aos_stride<T>();
+    for (size_t i = 0; i < num; ++i) {
+        const T* a = q_a + i * STRIDE;
+        const T* b = q_b + i * STRIDE;
+        const T t = alpha[i * alpha_stride];
+        const T cos_angle =
+            a[0] * b[0] + a[1] * b[1] + a[2] * b[2] + a[3] * b[3];
+        // Take the shortest path, i.e. use -b (same rotation) if required
+        const T sign = std::signbit(cos_angle) ? static_cast<T>(-1.0)
+                                               : static_cast<T>(1.0);
+        const T angle = std::max(acos_poly<T>(sign * cos_angle),
+                                 static_cast<T>(SLERP_MIN_ANGLE));
+        const T inv_sin_angle = static_cast<T>(1.0) / sin_poly<T>(angle);
+        const T w_a = sin_poly<T>((static_cast<T>(1.0) - t) * angle) *
+                      inv_sin_angle;
+        const T w_b = sign * sin_poly<T>(t * angle) * inv_sin_angle;
+        T* c = dst + i * STRIDE;
+        for (size_t k = 0; k < STRIDE; ++k) {
+            c[k] = w_a * a[k] + w_b * b[k];
+        }
+    }
+}
+
+/// Same as kernel_slerp_quat_aos, but with a normalized linear interpolation
+template <typename T>
+auto kernel_nlerp_quat_aos(T* dst, const T* q_a, const T* q_b, const T* alpha,
+                           size_t alpha_stride, size_t num) -> void {
+    constexpr size_t STRIDE = quat_aos_stride<T>();
+    for (size_t i = 0; i < num; ++i) {
+        const T* a = q_a + i * STRIDE;
+        const T* b = q_b + i * STRIDE;
+        const T t = alpha[i * alpha_stride];
+        const T cos_angle =
+            a[0] * b[0] + a[1] * b[1] + a[2] * b[2] + a[3] * b[3];
+        const T sign = std::signbit(cos_angle) ? static_cast<T>(-1.0)
+                                               : static_cast<T>(1.0);
+        const T w_a = static_cast<T>(1.0) - t;
+        const T w_b = sign * t;
+        T lerp[STRIDE];  // NOLINT
+        T length_square = static_cast<T>(0.0);
+        for (size_t k = 0; k < STRIDE; ++k) {
+            lerp[k] = w_a * a[k] + w_b * b[k];
+            length_square += lerp[k] * lerp[k];
+        }
+        const T inv_length = static_cast<T>(1.0) / std::sqrt(length_square);
+        T* c = dst + i * STRIDE;
+        for (size_t k = 0; k < STRIDE; ++k) {
+            c[k] = lerp[k] * inv_length;
+        }
+    }
+}
+
+/// Returns the signs (for w, x, y, z) of the second product of each entry of
+/// the quaternion associated with the given order of Euler angles (note 4)
+template <typename T>
+auto euler_quat_signs(euler::Order order) -> std::array<T, 4> {
+    constexpr T POS = static_cast<T>(1.0);
+    constexpr T NEG = static_cast<T>(-1.0);
+    switch (order) {
+        case euler::Order::XYZ:
+            return {{NEG, POS, NEG, POS}};
+        case euler::Order::YXZ:
+            return {{POS, POS, NEG, NEG}};
+        case euler::Order::ZXY:
+            return {{NEG, NEG, POS, POS}};
+        case euler::Order::ZYX:
+            return {{POS, NEG, POS, NEG}};
+        case euler::Order::YZX:
+            return {{NEG, POS, POS, NEG}};
+        case euler::Order::XZY:
+        default:
+            return {{POS, NEG, NEG, POS}};
+    }
+}
+
+/// Stores into `dst` the quaternions of the (intrinsic) Euler angles (x, y, z)
+/// at `angles`, all of them given in the same order (note 6)
+template <typename T>
+auto kernel_quat_from_euler_aos(T* dst, const T* angles, euler::Order order,
+                                size_t num, fast::Accuracy accuracy) -> void {
+    constexpr size_t STRIDE = quat_aos_stride<T>();
+    constexpr size_t ANGLES_STRIDE = vec3_aos_stride<T>();
+    constexpr auto HALF = static_cast<T>(0.5);
+    const auto signs = euler_quat_signs<T>(order);
+    for (size_t i = 0; i < num; ++i) {
+        const T* e = angles + i * ANGLES_STRIDE;
+        T s1, s2, s3, c1, c2, c3;  // NOLINT
+        kernel_fast_sincos<T>(HALF * e[0], s1, c1, accuracy);
+        kernel_fast_sincos<T>(HALF * e[1], s2, c2, accuracy);
+        kernel_fast_sincos<T>(HALF * e[2], s3, c3, accuracy);
+        T* q = dst + i * STRIDE;
+        q[0] = c1 * c2 * c3 + signs[0] * (s1 * s2 * s3);
+        q[1] = s1 * c2 * c3 + signs[1] * (c1 * s2 * s3);
+        q[2] = c1 * s2 * c3 + signs[2] * (s1 * c2 * s3);
+        q[3] = c1 * c2 * s3 + signs[3] * (s1 * s2 * c3);
+    }
+}
+
+/// Stores into `dst` the quaternions of the rotation matrices at `mats`, with
+/// the same choice of branch as Quaternion::setFromRotationMatrix (note 5)
+template <typename T>
+auto kernel_quat_from_mat3_aos(T* dst, const T* mats, size_t num) -> void {
+    constexpr size_t STRIDE = quat_aos_stride<T>();
+    constexpr size_t MAT_STRIDE = mat3_aos_stride<T>();
+    constexpr size_t COL = vec3_aos_stride<T>();
+    constexpr auto ONE = static_cast<T>(1.0);
+    constexpr auto HALF = static_cast<T>(0.5);
+    for (size_t i = 0; i < num; ++i) {
+        // Recall that the storage is column-major, i.e. mat[col][row]
+        const T* c0 = mats + i * MAT_STRIDE;
+        const T* c1 = c0 + COL;
+        const T* c2 = c1 + COL;
+        // clang-format off
+        const T m00 = c0[0]; const T m01 = c1[0]; const T m02 = c2[0];
+        const T m10 = c0[1]; const T m11 = c1[1]; const T m12 = c2[1];
+        const T m20 = c0[2]; const T m21 = c1[2]; const T m22 = c2[2];
+        // clang-format on
+        const T diff_x = m21 - m12;
+        const T diff_y = m02 - m20;
+        const T diff_z = m10 - m01;
+        const T sum_xy = m01 + m10;
+        const T sum_xz = m02 + m20;
+        const T sum_yz = m12 + m21;
+        T t = ONE;
+        std::array<T, 4> col{};
+        if (m00 + m11 + m22 > 0) {
+            t = ONE + m00 + m11 + m22;
+            col = {{t, diff_x, diff_y, diff_z}};
+        } else if ((m00 > m11) && (m00 > m22)) {
+            t = ONE + m00 - m11 - m22;
+            col = {{diff_x, t, sum_xy, sum_xz}};
+        } else if (m11 > m22) {
+            t = ONE - m00 + m11 - m22;
+            col = {{diff_y, sum_xy, t, sum_yz}};
+        } else {
+            t = ONE - m00 - m11 + m22;
+            col = {{diff_z, sum_xz, sum_yz, t}};
+        }
+        const T scale = HALF / std::sqrt(t);
+        T* q = dst + i * STRIDE;
+        for (size_t k = 0; k < STRIDE; ++k) {
+            q[k] = col[k] * scale;
+        }
+    }
+}
+
+/// Stores into `dst` the rotation matrices of the quaternions at `quats`, which
+/// don't have to be normalized (the padding of the columns is set to zero)
+template <typename T>
+auto kernel_mat3_from_quat_aos(T* dst, const T* quats, size_t num) -> void {
+    constexpr size_t STRIDE = quat_aos_stride<T>();
+    constexpr size_t MAT_STRIDE = mat3_aos_stride<T>();
+    constexpr size_t COL = vec3_aos_stride<T>();
+    constexpr auto ONE = static_cast<T>(1.0);
+    constexpr auto TWO = static_cast<T>(2.0);
+    for (size_t i = 0; i < num; ++i) {
+        const T* q = quats + i * STRIDE;
+        const T scale =
+            TWO / (q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3]);
+        const T xx = scale * q[1] * q[1];
+        const T yy = scale * q[2] * q[2];
+        const T zz = scale * q[3] * q[3];
+        const T xy = scale * q[1] * q[2];
+        const T xz = scale * q[1] * q[3];
+        const T yz = scale * q[2] * q[3];
+        const T wx = scale * q[0] * q[1];
+        const T wy = scale * q[0] * q[2];
+        const T wz = scale * q[0] * q[3];
+        const std::array<T, 9> entries = {{ONE - (yy + zz), xy + wz, xz - wy,
+                                           xy - wz, ONE - (xx + zz), yz + wx,
+                                           xz + wy, yz - wx, ONE - (xx + yy)}};
+        T* m = dst + i * MAT_STRIDE;
+        for (size_t col = 0; col < 3; ++col) {
+            for (size_t row = 0; row < COL; ++row) {
+                m[col * COL + row] =
+                    (row < 3) ? entries[col * 3 + row] : static_cast<T>(0.0);
+            }
+        }
+    }
+}
+
+}  // namespace scalar
+}  // namespace math
@@ -0,0 +1,349 @@
+// No include guard, see MATH3D_TARGET_ISA in dispatch.hpp
+#if !defined(MATH3D_TARGET_ISA)
+#error "Include the SSE, AVX or AVX-512 header of these kernels"
+#endif
+
+/**
+ * SIMD batch kernels for interpolating and converting arrays of quaternions
+ * (SSE, AVX and AVX-512)
+ *
+ * Notes:
+ * 1. Each group of WIDTH pairs of quaternions is first transposed into SoA
+ *    form, i.e. one register per coordinate (w, x, y, z), going through a small
+ *    tile in the stack (same as the Pose3d kernels). Then each lane of a
+ *    register holds a different pair, and the dot products, polynomials and
+ *    weighted sums are just chains of (fused) multiply-adds.
+ *
+ * 2. The shortest path is taken without branches, by flipping the sign of the
+ *    cosine and of the weight of the second quaternion in the lanes where the
+ *    dot product is negative. The polynomials used for acos and sin (and their
+ *    error bounds) are described in quat_batch_t_scalar_impl.hpp
+ *
+ * 3. The conversions between rotation matrices and quaternions transpose the
+ *    matrices in the same way (one register per entry). From matrices, the
+ *    branch of each lane is chosen with compares and blends, as explained in
+ *    note 5 of quat_batch_t_scalar_impl.hpp
+ */
+
+/// Group of Packet<T>::WIDTH quaternions, with each coordinate in its register
+template <typename T>
+struct QuatPacket {
+    using P = Packet<T>;
+    using Reg = typename P::Reg;
+
+    static constexpr size_t STRIDE = scalar::quat_aos_stride<T>();
+
+    /// Coordinates (w, x, y, z) of the quaternions
+    Reg coords[STRIDE];
+
+    /// Gathers WIDTH consecutive quaternions from the given array
+    MATH3D_TARGET_ISA auto load(const T* src) -> void {
+        T tile[STRIDE][P::WIDTH];
+        for (size_t lane = 0; lane < P::WIDTH; ++lane) {
+            for (size_t k = 0; k < STRIDE; ++k) {
+                tile[k][lane] = src[lane * STRIDE + k];
+            }
+        }
+        for (size_t k = 0; k < STRIDE; ++k) {
+            coords[k] = P::load(tile[k]);
+        }
+    }
+
+    /// Scatters the quaternions into WIDTH consecutive entries of the array
+    MATH3D_TARGET_ISA auto store(T* dst) const -> void {
+        T tile[STRIDE][P::WIDTH];
+        for (size_t k = 0; k < STRIDE; ++k) {
+            P::store(tile[k], coords[k]);
+        }
+        for (size_t lane = 0; lane < P::WIDTH; ++lane) {
+            for (size_t k = 0; k < STRIDE; ++k) {
+                dst[lane * STRIDE + k] = tile[k][lane];
+            }
+        }
+    }
+
+    /// Returns the dot product of each pair of quaternions of both groups
+    MATH3D_TARGET_ISA auto dot(const QuatPacket<T>& other) const -> Reg {
+        return P::fmadd(
+            coords[3], other.coords[3],
+            P::fmadd(coords[2], other.coords[2],
+                     P::fmadd(coords[1], other.coords[1],
+                              P::mul(coords[0], other.coords[0]))));
+    }
+};
+
+/// Returns scalar::acos_poly of each lane of the given register
+template <typename T>
+MATH3D_TARGET_ISA auto acos_packet(typename Packet<T>::Reg x)
+    -> typename Packet<T>::Reg {
+    using P = Packet<T>;
+    constexpr auto COEFFS = scalar::acos_poly_coeffs<T>();
+    auto poly = P::set1(COEFFS[0]);
+    for (size_t k = 1; k < COEFFS.size(); ++k) {
+        poly = P::fmadd(poly, x, P::set1(COEFFS[k]));
+    }
+    auto one_minus_x = P::sub(P::set1(static_cast<T>(1.0)), x);
+    return P::mul(P::sqrt(P::max(one_minus_x, P::zero())), poly);
+}
+
+/// Returns scalar::sin_poly of each lane of the given register
+template <typename T>
+MATH3D_TARGET_ISA auto sin_packet(typename Packet<T>::Reg x)
+    -> typename Packet<T>::Reg {
+    using P = Packet<T>;
+    constexpr auto COEFFS = scalar::sin_poly_coeffs<T>();
+    auto x2 = P::mul(x, x);
+    auto poly = P::set1(COEFFS[0]);
+    for (size_t k = 1; k < COEFFS.size(); ++k) {
+        poly = P::fmadd(poly, x2, P::set1(COEFFS[k]));
+    }
+    return P::mul(x, poly);
+}
+
+template <typename T>
+MATH3D_TARGET_ISA auto kernel_slerp_quat_aos(T* dst, const T* q_a,
+                                             const T* q_b, const T* alpha,
+                                             size_t alpha_stride, size_t num)
+    -> void {
+    using P = Packet<T>;
+    constexpr size_t STRIDE = scalar::quat_aos_stride<T>();
+    const auto one = P::set1(static_cast<T>(1.0));
+    const auto min_angle = P::set1(static_cast<T>(scalar::SLERP_MIN_ANGLE));
+    size_t i = 0;
+    for (; i + P::WIDTH <= num; i += P::WIDTH) {
+        QuatPacket<T> a, b, res;  // NOLINT
+        a.load(q_a + i * STRIDE);
+        b.load(q_b + i * STRIDE);
+        auto t = (alpha_stride == 0) ? P::set1(alpha[0]) : P::load(alpha + i);
+        auto cos_angle = a.dot(b);
+        auto angle = P::max(acos_packet<T>(P::mulsign(cos_angle, cos_angle)),
+                            min_angle);
+        auto inv_sin_angle = P::div(one, sin_packet<T>(angle));
+        auto w_a = P::mul(sin_packet<T>(P::mul(P::sub(one, t), angle)),
+                          inv_sin_angle);
+        auto w_b = P::mul(sin_packet<T>(P::mul(t, angle)), inv_sin_angle);
+        w_b = P::mulsign(w_b, cos_angle);
+        for (size_t k = 0; k < STRIDE; ++k) {
+            res.coords[k] =
+                P::fmadd(w_b, b.coords[k], P::mul(w_a, a.coords[k]));
+        }
+        res.store(dst + i * STRIDE);
+    }
+    scalar::kernel_slerp_quat_aos<T>(dst + i * STRIDE, q_a + i * STRIDE,
+                                     q_b + i * STRIDE, alpha + i * alpha_stride,
+                                     alpha_stride, num - i);
+}
+
+template <typename T>
+MATH3D_TARGET_ISA auto kernel_nlerp_quat_aos(T* dst, const T* q_a,
+                                             const T* q_b, const T* alpha,
+                                             size_t alpha_stride, size_t num)
+    -> void {
+    using P = Packet<T>;
+    constexpr size_t STRIDE = scalar::quat_aos_stride<T>();
+    const auto one = P::set1(static_cast<T>(1.0));
+    size_t i = 0;
+    for (; i + P::WIDTH <= num; i += P::WIDTH) {
+        QuatPacket<T> a, b, res;  // NOLINT
+        a.load(q_a + i * STRIDE);
+        b.load(q_b + i * STRIDE);
+        auto t = (alpha_stride == 0) ? P::set1(alpha[0]) : P::load(alpha + i);
+        auto w_a = P::sub(one, t);
+        auto w_b = P::mulsign(t, a.dot(b));
+        for (size_t k = 0; k < STRIDE; ++k) {
+            res.coords[k] =
+                P::fmadd(w_b, b.coords[k], P::mul(w_a, a.coords[k]));
+        }
+        auto inv_length = P::div(one, P::sqrt(res.dot(res)));
+        for (size_t k = 0; k < STRIDE; ++k) {
+            res.coords[k] = P::mul(res.coords[k], inv_length);
+        }
+        res.store(dst + i * STRIDE);
+    }
+    scalar::kernel_nlerp_quat_aos<T>(dst + i * STRIDE, q_a + i * STRIDE,
+                                     q_b + i * STRIDE, alpha + i * alpha_stride,
+                                     alpha_stride, num - i);
+}
+
+/// Group of Packet<T>::WIDTH 3x3 matrices, with each entry in its own register
+template <typename T>
+struct Mat3Packet {
+    using P = Packet<T>;
+    using Reg = typename P::Reg;
+
+    static constexpr size_t STRIDE = scalar::mat3_aos_stride<T>();
+    static constexpr size_t COL = scalar::vec3_aos_stride<T>();
+
+    /// Entries of the matrices, in column-major order, i.e. entries[col][row]
+    Reg entries[3][3];
+
+    /// Gathers WIDTH consecutive matrices from the given array
+    MATH3D_TARGET_ISA auto load(const T* src) -> void {
+        T tile[STRIDE][P::WIDTH];
+        for (size_t lane = 0; lane < P::WIDTH; ++lane) {
+            for (size_t k = 0; k < STRIDE; ++k) {
+                tile[k][lane] = src[lane * STRIDE + k];
+            }
+        }
+        for (size_t col = 0; col < 3; ++col) {
+            for (size_t row = 0; row < 3; ++row) {
+                entries[col][row] = P::load(tile[col * COL + row]);
+            }
+        }
+    }
+
+    /// Scatters the matrices into WIDTH consecutive entries of the array (with
+    /// the padding of the columns, if any, set to zero)
+    MATH3D_TARGET_ISA auto store(T* dst) const -> void {
+        T tile[STRIDE][P::WIDTH] = {};
+        for (size_t col = 0; col < 3; ++col) {
+            for (size_t row = 0; row < 3; ++row) {
+                P::store(tile[col * COL + row], entries[col][row]);
+            }
+        }
+        for (size_t lane = 0; lane < P::WIDTH; ++lane) {
+            for (size_t k = 0; k < STRIDE; ++k) {
+                dst[lane * STRIDE + k] = tile[k][lane];
+            }
+        }
+    }
+};
+
+template <typename T>
+MATH3D_TARGET_ISA auto kernel_quat_from_euler_aos(T* dst, const T* angles,
+                                                  euler::Order order,
+                                                  size_t num,
+                                                  fast::Accuracy accuracy)
+    -> void {
+    using P = Packet<T>;
+    constexpr size_t STRIDE = scalar::quat_aos_stride<T>();
+    constexpr size_t ANGLES_STRIDE = scalar::vec3_aos_stride<T>();
+    const auto signs = scalar::euler_quat_signs<T>(order);
+    const auto half = P::set1(static_cast<T>(0.5));
+    size_t i = 0;
+    for (; i + P::WIDTH <= num; i += P::WIDTH) {
+        typename P::Reg e_x, e_y, e_z;         // NOLINT
+        typename P::Reg s1, s2, s3, c1, c2, c3;  // NOLINT
+        P::load_aos3(angles + i * ANGLES_STRIDE, e_x, e_y, e_z);
+        fast_sincos_select<T>(P::mul(half, e_x), s1, c1, accuracy);
+        fast_sincos_select<T>(P::mul(half, e_y), s2, c2, accuracy);
+        fast_sincos_select<T>(P::mul(half, e_z), s3, c3, accuracy);
+        QuatPacket<T> res;  // NOLINT
+        res.coords[0] = P::fmadd(P::set1(signs[0]), P::mul(P::mul(s1, s2), s3),
+                                 P::mul(P::mul(c1, c2), c3));
+        res.coords[1] = P::fmadd(P::set1(signs[1]), P::mul(P::mul(c1, s2), s3),
+                                 P::mul(P::mul(s1, c2), c3));
+        res.coords[2] = P::fmadd(P::set1(signs[2]), P::mul(P::mul(s1, c2), s3),
+                                 P::mul(P::mul(c1, s2), c3));
+        res.coords[3] = P::fmadd(P::set1(signs[3]), P::mul(P::mul(s1, s2), c3),
+                                 P::mul(P::mul(c1, c2), s3));
+        res.store(dst + i * STRIDE);
+    }
+    scalar::kernel_quat_from_euler_aos<T>(dst + i * STRIDE,
+                                          angles + i * ANGLES_STRIDE, order,
+                                          num - i, accuracy);
+}
+
+template <typename T>
+MATH3D_TARGET_ISA auto kernel_quat_from_mat3_aos(T* dst, const T* mats,
+                                                 size_t num) -> void {
+    using P = Packet<T>;
+    constexpr size_t STRIDE = scalar::quat_aos_stride<T>();
+    using Reg = typename P::Reg;
+    constexpr size_t MAT_STRIDE = scalar::mat3_aos_stride<T>();
+    const auto one = P::set1(static_cast<T>(1.0));
+    const auto half = P::set1(static_cast<T>(0.5));
+    size_t i = 0;
+    for (; i + P::WIDTH <= num; i += P::WIDTH) {
+        Mat3Packet<T> mat;  // NOLINT
+        QuatPacket<T> res;  // NOLINT
+        mat.load(mats + i * MAT_STRIDE);
+        const auto& m00 = mat.entries[0][0];
+        const auto& m01 = mat.entries[1][0];
+        const auto& m02 = mat.entries[2][0];
+        const auto& m10 = mat.entries[0][1];
+        const auto& m11 = mat.entries[1][1];
+        const auto& m12 = mat.entries[2][1];
+        const auto& m20 = mat.entries[0][2];
+        const auto& m21 = mat.entries[1][2];
+        const auto& m22 = mat.entries[2][2];
+        auto diff_x = P::sub(m21, m12);
+        auto diff_y = P::sub(m02, m20);
+        auto diff_z = P::sub(m10, m01);
+        auto sum_xy = P::add(m01, m10);
+        auto sum_xz = P::add(m02, m20);
+        auto sum_yz = P::add(m12, m21);
+        auto t_w = P::add(P::add(P::add(one, m00), m11), m22);
+        auto t_x = P::sub(P::sub(P::add(one, m00), m11), m22);
+        auto t_y = P::sub(P::add(P::sub(one, m00), m11), m22);
+        auto t_z = P::add(P::sub(P::sub(one, m00), m11), m22);
+        // Select the column of each lane, in reverse order of the branches
+        auto t = t_z;
+        Reg col[4] = {diff_z, sum_xz, sum_yz, t_z};
+        const Reg col_y[4] = {diff_y, sum_xy, t_y, sum_yz};
+        const Reg col_x[4] = {diff_x, t_x, sum_xy, sum_xz};
+        const Reg col_w[4] = {t_w, diff_x, diff_y, diff_z};
+        const auto trace = P::add(P::add(m00, m11), m22);
+        const auto max_yz = P::max(m11, m22);
+        t = P::select_gt(m11, m22, t_y, t);
+        t = P::select_gt(m00, max_yz, t_x, t);
+        t = P::select_gt(trace, P::zero(), t_w, t);
+        for (size_t k = 0; k < STRIDE; ++k) {
+            col[k] = P::select_gt(m11, m22, col_y[k], col[k]);
+            col[k] = P::select_gt(m00, max_yz, col_x[k], col[k]);
+            col[k] = P::select_gt(trace, P::zero(), col_w[k], col[k]);
+        }
+        auto scale = P::div(half, P::sqrt(t));
+        for (size_t k = 0; k < STRIDE; ++k) {
+            res.coords[k] = P::mul(col[k], scale);
+        }
+        res.store(dst + i * STRIDE);
+    }
+    scalar::kernel_quat_from_mat3_aos<T>(dst + i * STRIDE,
+                                         mats + i * MAT_STRIDE, num - i);
+}
+
+template <typename T>
+MATH3D_TARGET_ISA auto kernel_mat3_from_quat_aos(T* dst, const T* quats,
+                                                 size_t num) -> void {
+    using P = Packet<T>;
+    constexpr size_t STRIDE = scalar::quat_aos_stride<T>();
+    constexpr size_t MAT_STRIDE = scalar::mat3_aos_stride<T>();
+    const auto one = P::set1(static_cast<T>(1.0));
+    const auto two = P::set1(static_cast<T>(2.0));
+    size_t i = 0;
+    for (; i + P::WIDTH <= num; i += P::WIDTH) {
+        QuatPacket<T> quat;  // NOLINT
+        Mat3Packet<T> res;   // NOLINT
+        quat.load(quats + i * STRIDE);
+        const auto& q_w = quat.coords[0];
+        const auto& q_x = quat.coords[1];
+        const auto& q_y = quat.coords[2];
+        const auto& q_z = quat.coords[3];
+        auto scale = P::div(two, quat.dot(quat));
+        auto s_x = P::mul(scale, q_x);
+        auto s_y = P::mul(scale, q_y);
+        auto s_z = P::mul(scale, q_z);
+        auto xx = P::mul(s_x, q_x);
+        auto yy = P::mul(s_y, q_y);
+        auto zz = P::mul(s_z, q_z);
+        auto xy = P::mul(s_x, q_y);
+        auto xz = P::mul(s_x, q_z);
+        auto yz = P::mul(s_y, q_z);
+        auto wx = P::mul(s_x, q_w);
+        auto wy = P::mul(s_y, q_w);
+        auto wz = P::mul(s_z, q_w);
+        res.entries[0][0] = P::sub(one, P::add(yy, zz));
+        res.entries[0][1] = P::add(xy, wz);
+        res.entries[0][2] = P::sub(xz, wy);
+        res.entries[1][0] = P::sub(xy, wz);
+        res.entries[1][1] = P::sub(one, P::add(xx, zz));
+        res.entries[1][2] = P::add(yz, wx);
+        res.entries[2][0] = P::add(xz, wy);
+        res.entries[2][1] = P::sub(yz, wx);
+        res.entries[2][2] = P::sub(one, P::add(xx, yy));
+        res.store(dst + i * MAT_STRIDE);
+    }
+    scalar::kernel_mat3_from_quat_aos<T>(dst + i * MAT_STRIDE,
+                                         quats + i * STRIDE, num - i);
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include "./fast_math_sse_impl.hpp"
+#include "./packet_sse_impl.hpp"
+#include "./quat_batch_t_scalar_impl.hpp"
+
+#if defined(MATH3D_DISPATCH_SSE)
+
+/**
+ * SSE batch kernels for interpolating and converting arrays of quaternions
+ *
+ * The kernels of quat_batch_t_simd_impl.hpp over xmm registers, i.e. 4
+ * float32 or 2 float64 pairs per group.
+ */
+
+namespace math {
+namespace sse {
+
+#define MATH3D_TARGET_ISA MATH3D_TARGET_SSE
+#include "./quat_batch_t_simd_impl.hpp"
+#undef MATH3D_TARGET_ISA
+
+}  // namespace sse
+}  // namespace math
+
+#endif  // MATH3D_DISPATCH_SSE
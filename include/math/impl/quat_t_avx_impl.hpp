@@ -5,6 +5,7 @@
 #include <immintrin.h>
 
 #include "../quat_t_decl.hpp"
+#include "./vec3_t_avx_impl.hpp"
 
 namespace math {
 namespace avx {
@@ -74,6 +75,90 @@ MATH3D_INLINE auto kernel_scale_quat(QuatBuffer<T>& dst, T scale,
     _mm256_storeu_pd(dst.data(), ymm_result);
 }
 
+template <typename T, SFINAE_QUAT_F32_AVX_GUARD<T> = nullptr>
+MATH3D_INLINE auto kernel_quatmul_quat(QuatBuffer<T>& dst,
+                                       const QuatBuffer<T>& lhs,
+                                       const QuatBuffer<T>& rhs) -> void {
+    // The Hamilton product a * b can be written as a sum of four products:
+    //   a * b = a.w * { b.w,  b.x,  b.y,  b.z}
+    //         + a.x * {-b.x,  b.w, -b.z,  b.y}
+    //         + a.y * {-b.y,  b.z,  b.w, -b.x}
+    //         + a.z * {-b.z, -b.y,  b.x,  b.w}
+    // So each term is a broadcast of a, times a shuffle of b with some sign
+    // flips (xor-ing the sign bits)
+    auto xmm_a = _mm_loadu_ps(lhs.data());  // a = {a.w, a.x, a.y, a.z}
+    auto xmm_b = _mm_loadu_ps(rhs.data());  // b = {b.w, b.x, b.y, b.z}
+
+    auto xmm_a_w = _mm_shuffle_ps(
+        xmm_a, xmm_a, static_cast<int>(math::ShuffleMask<0, 0, 0, 0>::value));
+    auto xmm_a_x = _mm_shuffle_ps(
+        xmm_a, xmm_a, static_cast<int>(math::ShuffleMask<1, 1, 1, 1>::value));
+    auto xmm_a_y = _mm_shuffle_ps(
+        xmm_a, xmm_a, static_cast<int>(math::ShuffleMask<2, 2, 2, 2>::value));
+    auto xmm_a_z = _mm_shuffle_ps(
+        xmm_a, xmm_a, static_cast<int>(math::ShuffleMask<3, 3, 3, 3>::value));
+
+    // b_1 = {-b.x, b.w, -b.z, b.y}
+    auto xmm_b_1 = _mm_xor_ps(
+        _mm_shuffle_ps(xmm_b, xmm_b,
+                       static_cast<int>(math::ShuffleMask<2, 3, 0, 1>::value)),
+        _mm_setr_ps(-0.0F, 0.0F, -0.0F, 0.0F));
+    // b_2 = {-b.y, b.z, b.w, -b.x}
+    auto xmm_b_2 = _mm_xor_ps(
+        _mm_shuffle_ps(xmm_b, xmm_b,
+                       static_cast<int>(math::ShuffleMask<1, 0, 3, 2>::value)),
+        _mm_setr_ps(-0.0F, 0.0F, 0.0F, -0.0F));
+    // b_3 = {-b.z, -b.y, b.x, b.w}
+    auto xmm_b_3 = _mm_xor_ps(
+        _mm_shuffle_ps(xmm_b, xmm_b,
+                       static_cast<int>(math::ShuffleMask<0, 1, 2, 3>::value)),
+        _mm_setr_ps(-0.0F, -0.0F, 0.0F, 0.0F));
+
+    auto xmm_result =
+        _mm_add_ps(_mm_add_ps(_mm_mul_ps(xmm_a_w, xmm_b),
+                              _mm_mul_ps(xmm_a_x, xmm_b_1)),
+                   _mm_add_ps(_mm_mul_ps(xmm_a_y, xmm_b_2),
+                              _mm_mul_ps(xmm_a_z, xmm_b_3)));
+    _mm_storeu_ps(dst.data(), xmm_result);
+}
+
+template <typename T, SFINAE_QUAT_F64_AVX_GUARD<T> = nullptr>
+MATH3D_INLINE auto kernel_quatmul_quat(QuatBuffer<T>& dst,
+                                       const QuatBuffer<T>& lhs,
+                                       const QuatBuffer<T>& rhs) -> void {
+    // Same sum of four products as in the float32 version. The shuffles of b
+    // are built from in-lane swaps (permute) and swaps of the 128-bit halves
+    auto ymm_b = _mm256_loadu_pd(rhs.data());  // b = {b.w, b.x, b.y, b.z}
+    // {b.x, b.w, b.z, b.y}
+    auto ymm_b_swap = _mm256_permute_pd(ymm_b, 0x05);
+    // {b.y, b.z, b.w, b.x}
+    auto ymm_b_halves = _mm256_permute2f128_pd(ymm_b, ymm_b, 0x01);
+    // {b.z, b.y, b.x, b.w}
+    auto ymm_b_reverse = _mm256_permute_pd(ymm_b_halves, 0x05);
+
+    // b_1 = {-b.x, b.w, -b.z, b.y}
+    auto ymm_b_1 =
+        _mm256_xor_pd(ymm_b_swap, _mm256_setr_pd(-0.0, 0.0, -0.0, 0.0));
+    // b_2 = {-b.y, b.z, b.w, -b.x}
+    auto ymm_b_2 =
+        _mm256_xor_pd(ymm_b_halves, _mm256_setr_pd(-0.0, 0.0, 0.0, -0.0));
+    // b_3 = {-b.z, -b.y, b.x, b.w}
+    auto ymm_b_3 =
+        _mm256_xor_pd(ymm_b_reverse, _mm256_setr_pd(-0.0, -0.0, 0.0, 0.0));
+
+    auto ymm_a_w = _mm256_broadcast_sd(lhs.data());
+    auto ymm_a_x = _mm256_broadcast_sd(lhs.data() + 1);
+    auto ymm_a_y = _mm256_broadcast_sd(lhs.data() + 2);
+    auto ymm_a_z = _mm256_broadcast_sd(lhs.data() + 3);
+
+    auto ymm_result =
+        _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(ymm_a_w, ymm_b),
+                                    _mm256_mul_pd(ymm_a_x, ymm_b_1)),
+                      _mm256_add_pd(_mm256_mul_pd(ymm_a_y, ymm_b_2),
+                                    _mm256_mul_pd(ymm_a_z, ymm_b_3)));
+    _mm256_storeu_pd(dst.data(), ymm_result);
+}
+
 template <typename T, SFINAE_QUAT_F32_AVX_GUARD<T> = nullptr>
 MATH3D_INLINE auto kernel_length_square_quat(const QuatBuffer<T>& quat) -> T {
     auto xmm_q = _mm_loadu_ps(static_cast<const float*>(quat.data()));
@@ -138,6 +223,60 @@ MATH3D_INLINE auto kernel_normalize_in_place_quat(QuatBuffer<T>& quat) -> void {
     _mm256_storeu_pd(static_cast<double*>(quat.data()), ymm_v_norm);
 }
 
+template <typename T, SFINAE_QUAT_F64_AVX_GUARD<T> = nullptr>
+MATH3D_INLINE auto kernel_rotate_vec3_quat(Vec3Buffer<T>& dst,
+                                           const QuatBuffer<T>& quat,
+                                           const Vec3Buffer<T>& vec) -> void {
+    // Same expanded form of q * p * q^-1 as the scalar kernel, i.e.:
+    //   t = s * (u x v), f(v) = v + w * t + u x t, with s = 2 / |q|^2
+    // Only the first 3 lanes hold the result (the 4th lane is never stored)
+    auto ymm_q = _mm256_loadu_pd(quat.data());  // q = {w, x, y, z}
+    auto ymm_v = _mm256_setr_pd(vec[0], vec[1], vec[2], 0.0);
+    // u = {x, y, z, w}, built from {y, z, w, x} (swapped 128-bit halves)
+    auto ymm_q_swap = _mm256_permute2f128_pd(ymm_q, ymm_q, 0x01);
+    auto ymm_u = _mm256_shuffle_pd(ymm_q, ymm_q_swap, 0x05);
+    auto ymm_w = _mm256_broadcast_sd(quat.data());
+    // Sum of squares of q into each lane (same as in the normalize kernel)
+    auto ymm_squares = _mm256_mul_pd(ymm_q, ymm_q);
+    auto ymm_tmp0 = _mm256_permute2f128_pd(ymm_squares, ymm_squares, 0x21);
+    auto ymm_tmp1 = _mm256_hadd_pd(ymm_squares, ymm_tmp0);
+    auto ymm_squares_sum = _mm256_hadd_pd(ymm_tmp1, ymm_tmp1);
+    auto ymm_scale = _mm256_div_pd(_mm256_set1_pd(2.0), ymm_squares_sum);
+    auto ymm_t = _mm256_mul_pd(ymm_scale, cross_f64(ymm_u, ymm_v));
+    auto ymm_result =
+        _mm256_add_pd(_mm256_add_pd(ymm_v, _mm256_mul_pd(ymm_w, ymm_t)),
+                      cross_f64(ymm_u, ymm_t));
+    // The buffer of a 3d-vector only has room for 3 doubles
+    _mm_storeu_pd(dst.data(), _mm256_castpd256_pd128(ymm_result));
+    _mm_store_sd(dst.data() + 2, _mm256_extractf128_pd(ymm_result, 1));
+}
+
+template <typename T, SFINAE_QUAT_F32_AVX_GUARD<T> = nullptr>
+MATH3D_INLINE auto kernel_rotate_vec3_quat(Vec3Buffer<T>& dst,
+                                           const QuatBuffer<T>& quat,
+                                           const Vec3Buffer<T>& vec) -> void {
+    // Same expanded form of q * p * q^-1 as the scalar kernel, i.e.:
+    //   t = s * (u x v), f(v) = v + w * t + u x t, with s = 2 / |q|^2
+    // Only the first 3 lanes hold the result (the 4th lane is never stored)
+    auto xmm_q = _mm_loadu_ps(quat.data());  // q = {w, x, y, z}
+    auto xmm_v = _mm_setr_ps(vec[0], vec[1], vec[2], 0.0F);
+    // u = {x, y, z, w}
+    auto xmm_u = _mm_shuffle_ps(
+        xmm_q, xmm_q, static_cast<int>(math::ShuffleMask<0, 3, 2, 1>::value));
+    // w = {w, w, w, w}
+    auto xmm_w = _mm_shuffle_ps(
+        xmm_q, xmm_q, static_cast<int>(math::ShuffleMask<0, 0, 0, 0>::value));
+    auto xmm_scale =
+        _mm_div_ps(_mm_set1_ps(2.0F), _mm_dp_ps(xmm_q, xmm_q, 0xff));
+    auto xmm_t = _mm_mul_ps(xmm_scale, cross_f32(xmm_u, xmm_v));
+    auto xmm_result = _mm_add_ps(_mm_add_ps(xmm_v, _mm_mul_ps(xmm_w, xmm_t)),
+                                 cross_f32(xmm_u, xmm_t));
+    // The buffer of a 3d-vector only has room for 3 floats
+    _mm_storel_pi(reinterpret_cast<__m64*>(dst.data()),  // NOLINT
+                  xmm_result);
+    _mm_store_ss(dst.data() + 2, _mm_movehl_ps(xmm_result, xmm_result));
+}
+
 }  // namespace avx
 }  // namespace math
 
@@ -3,6 +3,7 @@
 #include <cmath>
 
 #include "../quat_t_decl.hpp"
+#include "./vec3_t_scalar_impl.hpp"
 
 namespace math {
 namespace scalar {
@@ -54,6 +55,32 @@ MATH3D_INLINE auto kernel_quatmul_quat(QuatBuffer<T>& dst,
     dst[3] = a_w * b_z + b_w * a_z + a_x * b_y - b_x * a_y;
 }
 
+template <typename T>
+MATH3D_INLINE auto kernel_rotate_vec3_quat(Vec3Buffer<T>& dst,
+                                           const QuatBuffer<T>& quat,
+                                           const Vec3Buffer<T>& vec) -> void {
+    // We use the expanded form of q * p * q^-1 (no need to build the inverse):
+    //   t = s * (u x v), f(v) = v + w * t + u x t, with s = 2 / |q|^2
+    auto q_w = quat[0];
+    auto q_x = quat[1];
+    auto q_y = quat[2];
+    auto q_z = quat[3];
+
+    auto v_x = vec[0];
+    auto v_y = vec[1];
+    auto v_z = vec[2];
+
+    auto scale =
+        static_cast<T>(2.0) / (q_w * q_w + q_x * q_x + q_y * q_y + q_z * q_z);
+    auto t_x = scale * (q_y * v_z - q_z * v_y);
+    auto t_y = scale * (q_z * v_x - q_x * v_z);
+    auto t_z = scale * (q_x * v_y - q_y * v_x);
+
+    dst[0] = v_x + q_w * t_x + (q_y * t_z - q_z * t_y);
+    dst[1] = v_y + q_w * t_y + (q_z * t_x - q_x * t_z);
+    dst[2] = v_z + q_w * t_z + (q_x * t_y - q_y * t_x);
+}
+
 template <typename T>
 MATH3D_INLINE auto kernel_length_square_quat(const QuatBuffer<T>& quat) -> T {
     return quat[0] * quat[0] + quat[1] * quat[1] + quat[2] * quat[2] +
@@ -7,6 +7,8 @@
 #include <xmmintrin.h>
 
 #include "../quat_t_decl.hpp"
+#include "./quat_t_scalar_impl.hpp"
+#include "./vec3_t_sse_impl.hpp"
 
 namespace math {
 namespace sse {
@@ -87,6 +89,94 @@ MATH3D_INLINE auto kernel_scale_quat(QuatBuffer<T>& dst, T scale,
     _mm_storeu_pd(dst.data() + 2, xmm_result_hi);
 }
 
+template <typename T, SFINAE_QUAT_F32_SSE_GUARD<T> = nullptr>
+MATH3D_INLINE auto kernel_quatmul_quat(QuatBuffer<T>& dst,
+                                       const QuatBuffer<T>& lhs,
+                                       const QuatBuffer<T>& rhs) -> void {
+    // The Hamilton product a * b can be written as a sum of four products:
+    //   a * b = a.w * { b.w,  b.x,  b.y,  b.z}
+    //         + a.x * {-b.x,  b.w, -b.z,  b.y}
+    //         + a.y * {-b.y,  b.z,  b.w, -b.x}
+    //         + a.z * {-b.z, -b.y,  b.x,  b.w}
+    // So each term is a broadcast of a, times a shuffle of b with some sign
+    // flips (xor-ing the sign bits)
+    auto xmm_a = _mm_loadu_ps(lhs.data());  // a = {a.w, a.x, a.y, a.z}
+    auto xmm_b = _mm_loadu_ps(rhs.data());  // b = {b.w, b.x, b.y, b.z}
+
+    auto xmm_a_w = _mm_shuffle_ps(
+        xmm_a, xmm_a, static_cast<int>(math::ShuffleMask<0, 0, 0, 0>::value));
+    auto xmm_a_x = _mm_shuffle_ps(
+        xmm_a, xmm_a, static_cast<int>(math::ShuffleMask<1, 1, 1, 1>::value));
+    auto xmm_a_y = _mm_shuffle_ps(
+        xmm_a, xmm_a, static_cast<int>(math::ShuffleMask<2, 2, 2, 2>::value));
+    auto xmm_a_z = _mm_shuffle_ps(
+        xmm_a, xmm_a, static_cast<int>(math::ShuffleMask<3, 3, 3, 3>::value));
+
+    // b_1 = {-b.x, b.w, -b.z, b.y}
+    auto xmm_b_1 = _mm_xor_ps(
+        _mm_shuffle_ps(xmm_b, xmm_b,
+                       static_cast<int>(math::ShuffleMask<2, 3, 0, 1>::value)),
+        _mm_setr_ps(-0.0F, 0.0F, -0.0F, 0.0F));
+    // b_2 = {-b.y, b.z, b.w, -b.x}
+    auto xmm_b_2 = _mm_xor_ps(
+        _mm_shuffle_ps(xmm_b, xmm_b,
+                       static_cast<int>(math::ShuffleMask<1, 0, 3, 2>::value)),
+        _mm_setr_ps(-0.0F, 0.0F, 0.0F, -0.0F));
+    // b_3 = {-b.z, -b.y, b.x, b.w}
+    auto xmm_b_3 = _mm_xor_ps(
+        _mm_shuffle_ps(xmm_b, xmm_b,
+                       static_cast<int>(math::ShuffleMask<0, 1, 2, 3>::value)),
+        _mm_setr_ps(-0.0F, -0.0F, 0.0F, 0.0F));
+
+    auto xmm_result =
+        _mm_add_ps(_mm_add_ps(_mm_mul_ps(xmm_a_w, xmm_b),
+                              _mm_mul_ps(xmm_a_x, xmm_b_1)),
+                   _mm_add_ps(_mm_mul_ps(xmm_a_y, xmm_b_2),
+                              _mm_mul_ps(xmm_a_z, xmm_b_3)));
+    _mm_storeu_ps(dst.data(), xmm_result);
+}
+
+template <typename T, SFINAE_QUAT_F64_SSE_GUARD<T> = nullptr>
+MATH3D_INLINE auto kernel_quatmul_quat(QuatBuffer<T>& dst,
+                                       const QuatBuffer<T>& lhs,
+                                       const QuatBuffer<T>& rhs) -> void {
+    // Same sum of four products as in the float32 version, but computed on
+    // the lo={w, x} and hi={y, z} parts of the quaternions separately:
+    //   lo = a.w * {b.w, b.x} + a.x * {-b.x, b.w}
+    //      + a.y * {-b.y, b.z} + a.z * {-b.z, -b.y}
+    //   hi = a.w * {b.y, b.z} + a.x * {-b.z, b.y}
+    //      + a.y * {b.w, -b.x} + a.z * {b.x, b.w}
+    auto xmm_b_lo = _mm_loadu_pd(rhs.data());      // {b.w, b.x}
+    auto xmm_b_hi = _mm_loadu_pd(rhs.data() + 2);  // {b.y, b.z}
+    auto xmm_b_lo_swap = _mm_shuffle_pd(xmm_b_lo, xmm_b_lo, 0x01);  // {x, w}
+    auto xmm_b_hi_swap = _mm_shuffle_pd(xmm_b_hi, xmm_b_hi, 0x01);  // {z, y}
+
+    auto xmm_a_w = _mm_set1_pd(lhs[0]);
+    auto xmm_a_x = _mm_set1_pd(lhs[1]);
+    auto xmm_a_y = _mm_set1_pd(lhs[2]);
+    auto xmm_a_z = _mm_set1_pd(lhs[3]);
+
+    auto xmm_sign_np = _mm_setr_pd(-0.0, 0.0);
+    auto xmm_sign_pn = _mm_setr_pd(0.0, -0.0);
+    auto xmm_sign_nn = _mm_setr_pd(-0.0, -0.0);
+
+    auto xmm_result_lo = _mm_add_pd(
+        _mm_add_pd(
+            _mm_mul_pd(xmm_a_w, xmm_b_lo),
+            _mm_mul_pd(xmm_a_x, _mm_xor_pd(xmm_b_lo_swap, xmm_sign_np))),
+        _mm_add_pd(
+            _mm_mul_pd(xmm_a_y, _mm_xor_pd(xmm_b_hi, xmm_sign_np)),
+            _mm_mul_pd(xmm_a_z, _mm_xor_pd(xmm_b_hi_swap, xmm_sign_nn))));
+    auto xmm_result_hi = _mm_add_pd(
+        _mm_add_pd(
+            _mm_mul_pd(xmm_a_w, xmm_b_hi),
+            _mm_mul_pd(xmm_a_x, _mm_xor_pd(xmm_b_hi_swap, xmm_sign_np))),
+        _mm_add_pd(_mm_mul_pd(xmm_a_y, _mm_xor_pd(xmm_b_lo, xmm_sign_pn)),
+                   _mm_mul_pd(xmm_a_z, xmm_b_lo_swap)));
+    _mm_storeu_pd(dst.data(), xmm_result_lo);
+    _mm_storeu_pd(dst.data() + 2, xmm_result_hi);
+}
+
 template <typename T, SFINAE_QUAT_F32_SSE_GUARD<T> = nullptr>
 MATH3D_INLINE auto kernel_length_square_quat(const QuatBuffer<T>& quat) -> T {
     auto xmm_q = _mm_loadu_ps(static_cast<const float*>(quat.data()));
@@ -144,6 +234,80 @@ MATH3D_INLINE auto kernel_normalize_in_place_quat(QuatBuffer<T>& quat) -> void {
     _mm_storeu_pd(static_cast<double*>(quat.data() + 2), xmm_v_norm_hi);
 }
 
+template <typename T, SFINAE_QUAT_F32_SSE_GUARD<T> = nullptr>
+MATH3D_INLINE auto kernel_rotate_vec3_quat(Vec3Buffer<T>& dst,
+                                           const QuatBuffer<T>& quat,
+                                           const Vec3Buffer<T>& vec) -> void {
+    // Same expanded form of q * p * q^-1 as the scalar kernel, i.e.:
+    //   t = s * (u x v), f(v) = v + w * t + u x t, with s = 2 / |q|^2
+    // Only the first 3 lanes hold the result (the 4th lane is never stored)
+    auto xmm_q = _mm_loadu_ps(quat.data());  // q = {w, x, y, z}
+    auto xmm_v = _mm_setr_ps(vec[0], vec[1], vec[2], 0.0F);
+    // u = {x, y, z, w}
+    auto xmm_u = _mm_shuffle_ps(
+        xmm_q, xmm_q, static_cast<int>(math::ShuffleMask<0, 3, 2, 1>::value));
+    // w = {w, w, w, w}
+    auto xmm_w = _mm_shuffle_ps(
+        xmm_q, xmm_q, static_cast<int>(math::ShuffleMask<0, 0, 0, 0>::value));
+    auto xmm_scale =
+        _mm_div_ps(_mm_set1_ps(2.0F), _mm_dp_ps(xmm_q, xmm_q, 0xff));
+    auto xmm_t = _mm_mul_ps(xmm_scale, cross_f32(xmm_u, xmm_v));
+    auto xmm_result = _mm_add_ps(_mm_add_ps(xmm_v, _mm_mul_ps(xmm_w, xmm_t)),
+                                 cross_f32(xmm_u, xmm_t));
+    // The buffer of a 3d-vector only has room for 3 floats
+    _mm_storel_pi(reinterpret_cast<__m64*>(dst.data()),  // NOLINT
+                  xmm_result);
+    _mm_store_ss(dst.data() + 2, _mm_movehl_ps(xmm_result, xmm_result));
+}
+
+/// Cross product of 3d-vectors of float64 split into xmm pairs {x, y}, {z, 0}
+inline auto cross_f64(__m128d lhs_lo, __m128d lhs_hi, __m128d rhs_lo,
+                      __m128d rhs_hi, __m128d& dst_lo, __m128d& dst_hi)
+    -> void {
+    auto zero = _mm_setzero_pd();
+    auto lhs_yz = _mm_shuffle_pd(lhs_lo, lhs_hi, 0x01);
+    auto lhs_zx = _mm_shuffle_pd(lhs_hi, lhs_lo, 0x00);
+    auto rhs_yz = _mm_shuffle_pd(rhs_lo, rhs_hi, 0x01);
+    auto rhs_zx = _mm_shuffle_pd(rhs_hi, rhs_lo, 0x00);
+    // {y0 * z1 - z0 * y1, z0 * x1 - x0 * z1}, {x0 * y1 - y0 * x1, 0}
+    dst_lo = _mm_sub_pd(_mm_mul_pd(lhs_yz, rhs_zx), _mm_mul_pd(lhs_zx, rhs_yz));
+    auto lhs_x0 = _mm_unpacklo_pd(lhs_lo, zero);
+    auto lhs_y0 = _mm_unpackhi_pd(lhs_lo, zero);
+    auto rhs_x0 = _mm_unpacklo_pd(rhs_lo, zero);
+    auto rhs_y0 = _mm_unpackhi_pd(rhs_lo, zero);
+    dst_hi = _mm_sub_pd(_mm_mul_pd(lhs_x0, rhs_y0), _mm_mul_pd(lhs_y0, rhs_x0));
+}
+
+template <typename T, SFINAE_QUAT_F64_SSE_GUARD<T> = nullptr>
+MATH3D_INLINE auto kernel_rotate_vec3_quat(Vec3Buffer<T>& dst,
+                                           const QuatBuffer<T>& quat,
+                                           const Vec3Buffer<T>& vec) -> void {
+    // Same expanded form as the float32 version, with the 3d-vectors split
+    // into the xmm pairs {x, y}, {z, 0}
+    auto xmm_q_lo = _mm_loadu_pd(quat.data());      // {w, x}
+    auto xmm_q_hi = _mm_loadu_pd(quat.data() + 2);  // {y, z}
+    auto xmm_u_lo = _mm_shuffle_pd(xmm_q_lo, xmm_q_hi, 0x01);
+    auto xmm_u_hi = _mm_unpackhi_pd(xmm_q_hi, _mm_setzero_pd());
+    auto xmm_v_lo = _mm_loadu_pd(vec.data());
+    auto xmm_v_hi = _mm_load_sd(vec.data() + 2);
+    auto xmm_w = _mm_set1_pd(quat[0]);
+    auto xmm_square_sum = _mm_add_pd(_mm_dp_pd(xmm_q_lo, xmm_q_lo, 0x33),
+                                     _mm_dp_pd(xmm_q_hi, xmm_q_hi, 0x33));
+    auto xmm_scale = _mm_div_pd(_mm_set1_pd(2.0), xmm_square_sum);
+
+    __m128d xmm_t_lo, xmm_t_hi, xmm_ut_lo, xmm_ut_hi;  // NOLINT
+    cross_f64(xmm_u_lo, xmm_u_hi, xmm_v_lo, xmm_v_hi, xmm_t_lo, xmm_t_hi);
+    xmm_t_lo = _mm_mul_pd(xmm_scale, xmm_t_lo);
+    xmm_t_hi = _mm_mul_pd(xmm_scale, xmm_t_hi);
+    cross_f64(xmm_u_lo, xmm_u_hi, xmm_t_lo, xmm_t_hi, xmm_ut_lo, xmm_ut_hi);
+    auto xmm_result_lo = _mm_add_pd(
+        _mm_add_pd(xmm_v_lo, _mm_mul_pd(xmm_w, xmm_t_lo)), xmm_ut_lo);
+    auto xmm_result_hi = _mm_add_pd(
+        _mm_add_pd(xmm_v_hi, _mm_mul_pd(xmm_w, xmm_t_hi)), xmm_ut_hi);
+    _mm_storeu_pd(dst.data(), xmm_result_lo);
+    _mm_store_sd(dst.data() + 2, xmm_result_hi);
+}
+
 }  // namespace sse
 }  // namespace math
 
@@ -11,15 +11,15 @@
 /**
  * SSE instruction sets required for each kernel:
  *
- * - kernel_add_vec3                : SSE|SSE2
- * - kernel_sub_vec3                : SSE|SSE2
- * - kernel_scale_vec3              : SSE|SSE2
- * - kernel_hadamard_vec3           : SSE|SSE2
- * - kernel_length_square_vec3      : SSE|SSE2|SSE4.1
- * - kernel_length_vec3             : SSE|SSE2|SSE4.1
- * - kernel_normalize_in_place_vec3 : SSE|SSE2|SSE4.1
- * - kernel_dot_vec3                : SSE|SSE2|SSE4.1
- * - kernel_cross_vec3              : SSE
+ * - kernel_add_vec2                : SSE|SSE2
+ * - kernel_sub_vec2                : SSE|SSE2
+ * - kernel_scale_vec2              : SSE|SSE2
+ * - kernel_hadamard_vec2           : SSE|SSE2
+ * - kernel_length_square_vec2      : SSE|SSE2|SSE4.1
+ * - kernel_length_vec2             : SSE|SSE2|SSE4.1
+ * - kernel_normalize_in_place_vec2 : SSE|SSE2|SSE4.1
+ * - kernel_dot_vec2                : SSE|SSE2|SSE4.1
+ * - kernel_lerp_vec2               : SSE|SSE2
  *
  * Notes:
  * 1. For SSE-float32:
@@ -202,19 +202,27 @@ MATH3D_INLINE auto kernel_lerp_vec2(Vec2Buffer<T>& dst,
                                     const Vec2Buffer<T>& vec_a,
                                     const Vec2Buffer<T>& vec_b, T alpha)
     -> void {
-    // TODO(wilbert): implement more performant kernel (fuse multiply adds)
-    auto xmm_a = _mm_loadu_ps(vec_a.data());
-    auto xmm_b = _mm_loadu_ps(vec_b.data());
-    // NOLINTNEXTLINE
-    const float ALPHA[4] = {alpha, alpha, 0.0F, 0.0F};
-    auto xmm_alpha = _mm_loadu_ps(static_cast<const float*>(ALPHA));
-    // NOLINTNEXTLINE
-    const float ONE_MINUS_ALPHA[4] = {1.0F - alpha, 1.0F - alpha, 0.0F, 0.0F};
-    auto xmm_one_minus_alpha =
-        _mm_loadu_ps(static_cast<const float*>(ONE_MINUS_ALPHA));
-
-    auto xmm_lerp = _mm_add_ps(_mm_mul_ps(xmm_one_minus_alpha, xmm_a),
-                               _mm_mul_ps(xmm_alpha, xmm_b));
+    // Same expression as the scalar kernel, so both endpoints are exact. Only
+    // the 2 floats of each vector are loaded (as a single 64-bit lane)
+    auto xmm_a = _mm_castpd_ps(
+        _mm_load_sd(reinterpret_cast<const double*>(vec_a.data())));  // NOLINT
+    auto xmm_b = _mm_castpd_ps(
+        _mm_load_sd(reinterpret_cast<const double*>(vec_b.data())));  // NOLINT
+    auto xmm_lerp = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(1.0F - alpha), xmm_a),
+                               _mm_mul_ps(_mm_set1_ps(alpha), xmm_b));
+    _mm_storel_pi(reinterpret_cast<__m64*>(dst.data()), xmm_lerp);  // NOLINT
+}
+
+template <typename T, SFINAE_VEC2_F64_SSE_GUARD<T> = nullptr>
+MATH3D_INLINE auto kernel_lerp_vec2(Vec2Buffer<T>& dst,
+                                    const Vec2Buffer<T>& vec_a,
+                                    const Vec2Buffer<T>& vec_b, T alpha)
+    -> void {
+    auto xmm_a = _mm_loadu_pd(vec_a.data());
+    auto xmm_b = _mm_loadu_pd(vec_b.data());
+    auto xmm_lerp = _mm_add_pd(_mm_mul_pd(_mm_set1_pd(1.0 - alpha), xmm_a),
+                               _mm_mul_pd(_mm_set1_pd(alpha), xmm_b));
+    _mm_storeu_pd(dst.data(), xmm_lerp);
 }
 
 }  // namespace sse
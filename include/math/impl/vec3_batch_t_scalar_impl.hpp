@@ -0,0 +1,249 @@
+#pragma once
+
+#include <cmath>
+
+#include "../vec3_batch_t_decl.hpp"
+
+/**
+ * Scalar batch kernels for Vector3
+ *
+ * Two flavors of kernels are provided:
+ *
+ * - kernel_xyz_vec3_batch : operate on SoA storage, given as three planes of
+ *                           scalars (x, y, z) of `num` elements each.
+ * - kernel_xyz_vec3_aos   : operate directly on AoS storage, i.e. `num`
+ *                           Vector3 stored back to back (x0 y0 z0 x1 ...).
+ *
+ * These are also used by the SIMD kernels to handle the remainder of a batch
+ * whose size is not a multiple of the register width.
+ */
+
+namespace math {
+namespace scalar {
+
+template <typename T>
+using Vec3Planes = Vector3Planes<T>;
+
+template <typename T>
+using Vec3ConstPlanes = Vector3Planes<const T>;
+
+/// Number of scalars between two consecutive Vector3 in AoS storage
+template <typename T>
+constexpr auto vec3_aos_stride() -> size_t {
+    return sizeof(Vector3<T>) / sizeof(T);
+}
+
+// ***************************************************************************//
+//                          SoA (Vector3Batch) kernels                        //
+// ***************************************************************************//
+
+template <typename T>
+auto kernel_add_vec3_batch(Vec3Planes<T> dst, Vec3ConstPlanes<T> lhs,
+                           Vec3ConstPlanes<T> rhs, size_t num) -> void {
+    for (size_t i = 0; i < num; ++i) {
+        dst.x[i] = lhs.x[i] + rhs.x[i];
+        dst.y[i] = lhs.y[i] + rhs.y[i];
+        dst.z[i] = lhs.z[i] + rhs.z[i];
+    }
+}
+
+template <typename T>
+auto kernel_sub_vec3_batch(Vec3Planes<T> dst, Vec3ConstPlanes<T> lhs,
+                           Vec3ConstPlanes<T> rhs, size_t num) -> void {
+    for (size_t i = 0; i < num; ++i) {
+        dst.x[i] = lhs.x[i] - rhs.x[i];
+        dst.y[i] = lhs.y[i] - rhs.y[i];
+        dst.z[i] = lhs.z[i] - rhs.z[i];
+    }
+}
+
+template <typename T>
+auto kernel_scale_vec3_batch(Vec3Planes<T> dst, T scale,
+                             Vec3ConstPlanes<T> src, size_t num) -> void {
+    for (size_t i = 0; i < num; ++i) {
+        dst.x[i] = scale * src.x[i];
+        dst.y[i] = scale * src.y[i];
+        dst.z[i] = scale * src.z[i];
+    }
+}
+
+template <typename T>
+auto kernel_hadamard_vec3_batch(Vec3Planes<T> dst, Vec3ConstPlanes<T> lhs,
+                                Vec3ConstPlanes<T> rhs, size_t num) -> void {
+    for (size_t i = 0; i < num; ++i) {
+        dst.x[i] = lhs.x[i] * rhs.x[i];
+        dst.y[i] = lhs.y[i] * rhs.y[i];
+        dst.z[i] = lhs.z[i] * rhs.z[i];
+    }
+}
+
+template <typename T>
+auto kernel_dot_vec3_batch(T* dst, Vec3ConstPlanes<T> lhs,
+                           Vec3ConstPlanes<T> rhs, size_t num) -> void {
+    for (size_t i = 0; i < num; ++i) {
+        dst[i] =
+            lhs.x[i] * rhs.x[i] + lhs.y[i] * rhs.y[i] + lhs.z[i] * rhs.z[i];
+    }
+}
+
+template <typename T>
+auto kernel_cross_vec3_batch(Vec3Planes<T> dst, Vec3ConstPlanes<T> lhs,
+                             Vec3ConstPlanes<T> rhs, size_t num) -> void {
+    for (size_t i = 0; i < num; ++i) {
+        // Compute into temporaries, as dst might alias lhs or rhs
+        const T cx = lhs.y[i] * rhs.z[i] - lhs.z[i] * rhs.y[i];
+        const T cy = lhs.z[i] * rhs.x[i] - lhs.x[i] * rhs.z[i];
+        const T cz = lhs.x[i] * rhs.y[i] - lhs.y[i] * rhs.x[i];
+        dst.x[i] = cx;
+        dst.y[i] = cy;
+        dst.z[i] = cz;
+    }
+}
+
+template <typename T>
+auto kernel_length_square_vec3_batch(T* dst, Vec3ConstPlanes<T> src,
+                                     size_t num) -> void {
+    for (size_t i = 0; i < num; ++i) {
+        dst[i] =
+            src.x[i] * src.x[i] + src.y[i] * src.y[i] + src.z[i] * src.z[i];
+    }
+}
+
+template <typename T>
+auto kernel_length_vec3_batch(T* dst, Vec3ConstPlanes<T> src, size_t num)
+    -> void {
+    for (size_t i = 0; i < num; ++i) {
+        dst[i] = std::sqrt(src.x[i] * src.x[i] + src.y[i] * src.y[i] +
+                           src.z[i] * src.z[i]);
+    }
+}
+
+template <typename T>
+auto kernel_normalize_vec3_batch(Vec3Planes<T> dst, Vec3ConstPlanes<T> src,
+                                 size_t num) -> void {
+    for (size_t i = 0; i < num; ++i) {
+        const T length = std::sqrt(src.x[i] * src.x[i] + src.y[i] * src.y[i] +
+                                   src.z[i] * src.z[i]);
+        dst.x[i] = src.x[i] / length;
+        dst.y[i] = src.y[i] / length;
+        dst.z[i] = src.z[i] / length;
+    }
+}
+
+// ***************************************************************************//
+//                       AoS (Vector3 arrays) kernels                         //
+// ***************************************************************************//
+
+template <typename T>
+auto kernel_dot_vec3_aos(T* dst, const T* lhs, const T* rhs, size_t num)
+    -> void {
+    constexpr size_t STRIDE = vec3_aos_stride<T>();
+    for (size_t i = 0; i < num; ++i) {
+        const T* a = lhs + i * STRIDE;
+        const T* b = rhs + i * STRIDE;
+        dst[i] = a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+    }
+}
+
+template <typename T>
+auto kernel_cross_vec3_aos(T* dst, const T* lhs, const T* rhs, size_t num)
+    -> void {
+    constexpr size_t STRIDE = vec3_aos_stride<T>();
+    for (size_t i = 0; i < num; ++i) {
+        const T* a = lhs + i * STRIDE;
+        const T* b = rhs + i * STRIDE;
+        const T cx = a[1] * b[2] - a[2] * b[1];
+        const T cy = a[2] * b[0] - a[0] * b[2];
+        const T cz = a[0] * b[1] - a[1] * b[0];
+        T* c = dst + i * STRIDE;
+        c[0] = cx;
+        c[1] = cy;
+        c[2] = cz;
+    }
+}
+
+template <typename T>
+auto kernel_length_square_vec3_aos(T* dst, const T* src, size_t num) -> void {
+    constexpr size_t STRIDE = vec3_aos_stride<T>();
+    for (size_t i = 0; i < num; ++i) {
+        const T* v = src + i * STRIDE;
+        dst[i] = v[0] * v[0] + v[1] * v[1] + v[2] * v[2];
+    }
+}
+
+template <typename T>
+auto kernel_length_vec3_aos(T* dst, const T* src, size_t num) -> void {
+    constexpr size_t STRIDE = vec3_aos_stride<T>();
+    for (size_t i = 0; i < num; ++i) {
+        const T* v = src + i * STRIDE;
+        dst[i] = std::sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+    }
+}
+
+template <typename T>
+auto kernel_normalize_vec3_aos(T* dst, const T* src, size_t num) -> void {
+    constexpr size_t STRIDE = vec3_aos_stride<T>();
+    for (size_t i = 0; i < num; ++i) {
+        const T* v = src + i * STRIDE;
+        const T length = std::sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+        T* n = dst + i * STRIDE;
+        n[0] = v[0] / length;
+        n[1] = v[1] / length;
+        n[2] = v[2] / length;
+    }
+}
+
+template <typename T>
+auto kernel_lerp_vec3_aos(T* dst, const T* vec_a, const T* vec_b, T alpha,
+                          size_t num) -> void {
+    // The arrays are contiguous, so just stream over all of their scalars
+    const size_t num_scalars = num * vec3_aos_stride<T>();
+    const T one_minus_alpha = static_cast<T>(1) - alpha;
+    for (size_t i = 0; i < num_scalars; ++i) {
+        dst[i] = one_minus_alpha * vec_a[i] + alpha * vec_b[i];
+    }
+}
+
+template <typename T>
+auto kernel_lerp_vec3_aos(T* dst, const T* vec_a, const T* vec_b,
+                          const T* alpha, size_t num) -> void {
+    constexpr size_t STRIDE = vec3_aos_stride<T>();
+    for (size_t i = 0; i < num; ++i) {
+        const T* a = vec_a + i * STRIDE;
+        const T* b = vec_b + i * STRIDE;
+        const T one_minus_alpha = static_cast<T>(1) - alpha[i];
+        T* c = dst + i * STRIDE;
+        c[0] = one_minus_alpha * a[0] + alpha[i] * b[0];
+        c[1] = one_minus_alpha * a[1] + alpha[i] * b[1];
+        c[2] = one_minus_alpha * a[2] + alpha[i] * b[2];
+    }
+}
+
+// ***************************************************************************//
+//                           AoS <-> SoA conversions                          //
+// ***************************************************************************//
+
+template <typename T>
+auto kernel_aos_to_soa_vec3(Vec3Planes<T> dst, const T* src, size_t num)
+    -> void {
+    constexpr size_t STRIDE = vec3_aos_stride<T>();
+    for (size_t i = 0; i < num; ++i) {
+        dst.x[i] = src[i * STRIDE + 0];
+        dst.y[i] = src[i * STRIDE + 1];
+        dst.z[i] = src[i * STRIDE + 2];
+    }
+}
+
+template <typename T>
+auto kernel_soa_to_aos_vec3(T* dst, Vec3ConstPlanes<T> src, size_t num)
+    -> void {
+    constexpr size_t STRIDE = vec3_aos_stride<T>();
+    for (size_t i = 0; i < num; ++i) {
+        dst[i * STRIDE + 0] = src.x[i];
+        dst[i * STRIDE + 1] = src.y[i];
+        dst[i * STRIDE + 2] = src.z[i];
+    }
+}
+
+}  // namespace scalar
+}  // namespace math
@@ -0,0 +1,353 @@
+// No include guard, see MATH3D_TARGET_ISA in dispatch.hpp
+#if !defined(MATH3D_TARGET_ISA)
+#error "Include the SSE, AVX or AVX-512 header of these kernels"
+#endif
+
+/**
+ * SIMD batch kernels for Vector3 (SSE, AVX and AVX-512)
+ *
+ * Each iteration processes Packet<T>::WIDTH vectors at once, one register per
+ * coordinate. The remaining vectors of the batch (if any) are handled by the
+ * scalar kernels.
+ *
+ * The AoS kernels first transpose each group of vectors into registers (see
+ * Packet<T>::load_aos3), so they run the exact same arithmetic as the SoA ones.
+ */
+
+template <typename T>
+using Vec3Planes = Vector3Planes<T>;
+
+template <typename T>
+using Vec3ConstPlanes = Vector3Planes<const T>;
+
+// ***************************************************************************//
+//                          SoA (Vector3Batch) kernels                        //
+// ***************************************************************************//
+
+template <typename T>
+MATH3D_TARGET_ISA auto kernel_add_vec3_batch(Vec3Planes<T> dst,
+                                             Vec3ConstPlanes<T> lhs,
+                                             Vec3ConstPlanes<T> rhs,
+                                             size_t num) -> void {
+    using P = Packet<T>;
+    size_t i = 0;
+    for (; i + P::WIDTH <= num; i += P::WIDTH) {
+        P::store(dst.x + i, P::add(P::load(lhs.x + i), P::load(rhs.x + i)));
+        P::store(dst.y + i, P::add(P::load(lhs.y + i), P::load(rhs.y + i)));
+        P::store(dst.z + i, P::add(P::load(lhs.z + i), P::load(rhs.z + i)));
+    }
+    scalar::kernel_add_vec3_batch<T>(dst.offset(i), lhs.offset(i),
+                                     rhs.offset(i), num - i);
+}
+
+template <typename T>
+MATH3D_TARGET_ISA auto kernel_sub_vec3_batch(Vec3Planes<T> dst,
+                                             Vec3ConstPlanes<T> lhs,
+                                             Vec3ConstPlanes<T> rhs,
+                                             size_t num) -> void {
+    using P = Packet<T>;
+    size_t i = 0;
+    for (; i + P::WIDTH <= num; i += P::WIDTH) {
+        P::store(dst.x + i, P::sub(P::load(lhs.x + i), P::load(rhs.x + i)));
+        P::store(dst.y + i, P::sub(P::load(lhs.y + i), P::load(rhs.y + i)));
+        P::store(dst.z + i, P::sub(P::load(lhs.z + i), P::load(rhs.z + i)));
+    }
+    scalar::kernel_sub_vec3_batch<T>(dst.offset(i), lhs.offset(i),
+                                     rhs.offset(i), num - i);
+}
+
+template <typename T>
+MATH3D_TARGET_ISA auto kernel_scale_vec3_batch(Vec3Planes<T> dst, T scale,
+                                               Vec3ConstPlanes<T> src,
+                                               size_t num) -> void {
+    using P = Packet<T>;
+    const auto scale_v = P::set1(scale);
+    size_t i = 0;
+    for (; i + P::WIDTH <= num; i += P::WIDTH) {
+        P::store(dst.x + i, P::mul(scale_v, P::load(src.x + i)));
+        P::store(dst.y + i, P::mul(scale_v, P::load(src.y + i)));
+        P::store(dst.z + i, P::mul(scale_v, P::load(src.z + i)));
+    }
+    scalar::kernel_scale_vec3_batch<T>(dst.offset(i), scale, src.offset(i),
+                                       num - i);
+}
+
+template <typename T>
+MATH3D_TARGET_ISA auto kernel_hadamard_vec3_batch(Vec3Planes<T> dst,
+                                                  Vec3ConstPlanes<T> lhs,
+                                                  Vec3ConstPlanes<T> rhs,
+                                                  size_t num) -> void {
+    using P = Packet<T>;
+    size_t i = 0;
+    for (; i + P::WIDTH <= num; i += P::WIDTH) {
+        P::store(dst.x + i, P::mul(P::load(lhs.x + i), P::load(rhs.x + i)));
+        P::store(dst.y + i, P::mul(P::load(lhs.y + i), P::load(rhs.y + i)));
+        P::store(dst.z + i, P::mul(P::load(lhs.z + i), P::load(rhs.z + i)));
+    }
+    scalar::kernel_hadamard_vec3_batch<T>(dst.offset(i), lhs.offset(i),
+                                          rhs.offset(i), num - i);
+}
+
+template <typename T>
+MATH3D_TARGET_ISA auto kernel_dot_vec3_batch(T* dst, Vec3ConstPlanes<T> lhs,
+                                             Vec3ConstPlanes<T> rhs,
+                                             size_t num) -> void {
+    using P = Packet<T>;
+    size_t i = 0;
+    for (; i + P::WIDTH <= num; i += P::WIDTH) {
+        auto dot = P::mul(P::load(lhs.x + i), P::load(rhs.x + i));
+        dot = P::fmadd(P::load(lhs.y + i), P::load(rhs.y + i), dot);
+        dot = P::fmadd(P::load(lhs.z + i), P::load(rhs.z + i), dot);
+        P::store(dst + i, dot);
+    }
+    scalar::kernel_dot_vec3_batch<T>(dst + i, lhs.offset(i), rhs.offset(i),
+                                     num - i);
+}
+
+/// Computes the cross products of the given registers (one per coordinate)
+template <typename P>
+MATH3D_TARGET_ISA auto cross_packet(typename P::Reg& cx, typename P::Reg& cy,
+                                    typename P::Reg& cz, typename P::Reg ax,
+                                    typename P::Reg ay, typename P::Reg az,
+                                    typename P::Reg bx, typename P::Reg by,
+                                    typename P::Reg bz) -> void {
+    cx = P::fnmadd(az, by, P::mul(ay, bz));
+    cy = P::fnmadd(ax, bz, P::mul(az, bx));
+    cz = P::fnmadd(ay, bx, P::mul(ax, by));
+}
+
+template <typename T>
+MATH3D_TARGET_ISA auto kernel_cross_vec3_batch(Vec3Planes<T> dst,
+                                               Vec3ConstPlanes<T> lhs,
+                                               Vec3ConstPlanes<T> rhs,
+                                               size_t num) -> void {
+    using P = Packet<T>;
+    size_t i = 0;
+    for (; i + P::WIDTH <= num; i += P::WIDTH) {
+        typename P::Reg cx, cy, cz;  // NOLINT
+        cross_packet<P>(cx, cy, cz, P::load(lhs.x + i), P::load(lhs.y + i),
+                        P::load(lhs.z + i), P::load(rhs.x + i),
+                        P::load(rhs.y + i), P::load(rhs.z + i));
+        P::store(dst.x + i, cx);
+        P::store(dst.y + i, cy);
+        P::store(dst.z + i, cz);
+    }
+    scalar::kernel_cross_vec3_batch<T>(dst.offset(i), lhs.offset(i),
+                                       rhs.offset(i), num - i);
+}
+
+template <typename T>
+MATH3D_TARGET_ISA auto kernel_length_square_vec3_batch(T* dst,
+                                                       Vec3ConstPlanes<T> src,
+                                                       size_t num) -> void {
+    using P = Packet<T>;
+    size_t i = 0;
+    for (; i + P::WIDTH <= num; i += P::WIDTH) {
+        auto x = P::load(src.x + i);
+        auto y = P::load(src.y + i);
+        auto z = P::load(src.z + i);
+        P::store(dst + i, P::fmadd(z, z, P::fmadd(y, y, P::mul(x, x))));
+    }
+    scalar::kernel_length_square_vec3_batch<T>(dst + i, src.offset(i),
+                                               num - i);
+}
+
+template <typename T>
+MATH3D_TARGET_ISA auto kernel_length_vec3_batch(T* dst, Vec3ConstPlanes<T> src,
+                                                size_t num) -> void {
+    using P = Packet<T>;
+    size_t i = 0;
+    for (; i + P::WIDTH <= num; i += P::WIDTH) {
+        auto x = P::load(src.x + i);
+        auto y = P::load(src.y + i);
+        auto z = P::load(src.z + i);
+        P::store(dst + i,
+                 P::sqrt(P::fmadd(z, z, P::fmadd(y, y, P::mul(x, x)))));
+    }
+    scalar::kernel_length_vec3_batch<T>(dst + i, src.offset(i), num - i);
+}
+
+template <typename T>
+MATH3D_TARGET_ISA auto kernel_normalize_vec3_batch(Vec3Planes<T> dst,
+                                                   Vec3ConstPlanes<T> src,
+                                                   size_t num) -> void {
+    using P = Packet<T>;
+    size_t i = 0;
+    for (; i + P::WIDTH <= num; i += P::WIDTH) {
+        auto x = P::load(src.x + i);
+        auto y = P::load(src.y + i);
+        auto z = P::load(src.z + i);
+        auto length = P::sqrt(P::fmadd(z, z, P::fmadd(y, y, P::mul(x, x))));
+        P::store(dst.x + i, P::div(x, length));
+        P::store(dst.y + i, P::div(y, length));
+        P::store(dst.z + i, P::div(z, length));
+    }
+    scalar::kernel_normalize_vec3_batch<T>(dst.offset(i), src.offset(i),
+                                           num - i);
+}
+
+// ***************************************************************************//
+//                       AoS (Vector3 arrays) kernels                         //
+// ***************************************************************************//
+
+template <typename T>
+MATH3D_TARGET_ISA auto kernel_dot_vec3_aos(T* dst, const T* lhs, const T* rhs,
+                                           size_t num) -> void {
+    using P = Packet<T>;
+    constexpr size_t STRIDE = scalar::vec3_aos_stride<T>();
+    size_t i = 0;
+    for (; i + P::WIDTH <= num; i += P::WIDTH) {
+        typename P::Reg ax, ay, az, bx, by, bz;  // NOLINT
+        P::load_aos3(lhs + i * STRIDE, ax, ay, az);
+        P::load_aos3(rhs + i * STRIDE, bx, by, bz);
+        P::store(dst + i, P::fmadd(az, bz, P::fmadd(ay, by, P::mul(ax, bx))));
+    }
+    scalar::kernel_dot_vec3_aos<T>(dst + i, lhs + i * STRIDE, rhs + i * STRIDE,
+                                   num - i);
+}
+
+template <typename T>
+MATH3D_TARGET_ISA auto kernel_cross_vec3_aos(T* dst, const T* lhs,
+                                             const T* rhs, size_t num)
+    -> void {
+    using P = Packet<T>;
+    constexpr size_t STRIDE = scalar::vec3_aos_stride<T>();
+    size_t i = 0;
+    for (; i + P::WIDTH <= num; i += P::WIDTH) {
+        typename P::Reg ax, ay, az, bx, by, bz, cx, cy, cz;  // NOLINT
+        P::load_aos3(lhs + i * STRIDE, ax, ay, az);
+        P::load_aos3(rhs + i * STRIDE, bx, by, bz);
+        cross_packet<P>(cx, cy, cz, ax, ay, az, bx, by, bz);
+        P::store_aos3(dst + i * STRIDE, cx, cy, cz);
+    }
+    scalar::kernel_cross_vec3_aos<T>(dst + i * STRIDE, lhs + i * STRIDE,
+                                     rhs + i * STRIDE, num - i);
+}
+
+template <typename T>
+MATH3D_TARGET_ISA auto kernel_length_square_vec3_aos(T* dst, const T* src,
+                                                     size_t num) -> void {
+    using P = Packet<T>;
+    constexpr size_t STRIDE = scalar::vec3_aos_stride<T>();
+    size_t i = 0;
+    for (; i + P::WIDTH <= num; i += P::WIDTH) {
+        typename P::Reg x, y, z;  // NOLINT
+        P::load_aos3(src + i * STRIDE, x, y, z);
+        P::store(dst + i, P::fmadd(z, z, P::fmadd(y, y, P::mul(x, x))));
+    }
+    scalar::kernel_length_square_vec3_aos<T>(dst + i, src + i * STRIDE,
+                                             num - i);
+}
+
+template <typename T>
+MATH3D_TARGET_ISA auto kernel_length_vec3_aos(T* dst, const T* src,
+                                              size_t num) -> void {
+    using P = Packet<T>;
+    constexpr size_t STRIDE = scalar::vec3_aos_stride<T>();
+    size_t i = 0;
+    for (; i + P::WIDTH <= num; i += P::WIDTH) {
+        typename P::Reg x, y, z;  // NOLINT
+        P::load_aos3(src + i * STRIDE, x, y, z);
+        P::store(dst + i,
+                 P::sqrt(P::fmadd(z, z, P::fmadd(y, y, P::mul(x, x)))));
+    }
+    scalar::kernel_length_vec3_aos<T>(dst + i, src + i * STRIDE, num - i);
+}
+
+template <typename T>
+MATH3D_TARGET_ISA auto kernel_normalize_vec3_aos(T* dst, const T* src,
+                                                 size_t num) -> void {
+    using P = Packet<T>;
+    constexpr size_t STRIDE = scalar::vec3_aos_stride<T>();
+    size_t i = 0;
+    for (; i + P::WIDTH <= num; i += P::WIDTH) {
+        typename P::Reg x, y, z;  // NOLINT
+        P::load_aos3(src + i * STRIDE, x, y, z);
+        auto length = P::sqrt(P::fmadd(z, z, P::fmadd(y, y, P::mul(x, x))));
+        P::store_aos3(dst + i * STRIDE, P::div(x, length), P::div(y, length),
+                      P::div(z, length));
+    }
+    scalar::kernel_normalize_vec3_aos<T>(dst + i * STRIDE, src + i * STRIDE,
+                                         num - i);
+}
+
+template <typename T>
+MATH3D_TARGET_ISA auto kernel_lerp_vec3_aos(T* dst, const T* vec_a,
+                                            const T* vec_b, T alpha,
+                                            size_t num) -> void {
+    using P = Packet<T>;
+    constexpr size_t STRIDE = scalar::vec3_aos_stride<T>();
+    // The arrays are contiguous, so WIDTH vectors span exactly STRIDE packets
+    auto reg_alpha = P::set1(alpha);
+    auto reg_one_minus_alpha = P::set1(static_cast<T>(1) - alpha);
+    size_t i = 0;
+    for (; i + P::WIDTH <= num; i += P::WIDTH) {
+        for (size_t k = 0; k < STRIDE; ++k) {
+            const size_t offset = i * STRIDE + k * P::WIDTH;
+            auto a = P::load(vec_a + offset);
+            auto b = P::load(vec_b + offset);
+            P::store(dst + offset,
+                     P::fmadd(reg_alpha, b, P::mul(reg_one_minus_alpha, a)));
+        }
+    }
+    scalar::kernel_lerp_vec3_aos<T>(dst + i * STRIDE, vec_a + i * STRIDE,
+                                    vec_b + i * STRIDE, alpha, num - i);
+}
+
+template <typename T>
+MATH3D_TARGET_ISA auto kernel_lerp_vec3_aos(T* dst, const T* vec_a,
+                                            const T* vec_b, const T* alpha,
+                                            size_t num) -> void {
+    using P = Packet<T>;
+    constexpr size_t STRIDE = scalar::vec3_aos_stride<T>();
+    auto one = P::set1(static_cast<T>(1));
+    size_t i = 0;
+    for (; i + P::WIDTH <= num; i += P::WIDTH) {
+        typename P::Reg ax, ay, az, bx, by, bz;  // NOLINT
+        P::load_aos3(vec_a + i * STRIDE, ax, ay, az);
+        P::load_aos3(vec_b + i * STRIDE, bx, by, bz);
+        auto t = P::load(alpha + i);
+        auto one_minus_t = P::sub(one, t);
+        P::store_aos3(dst + i * STRIDE,
+                      P::fmadd(t, bx, P::mul(one_minus_t, ax)),
+                      P::fmadd(t, by, P::mul(one_minus_t, ay)),
+                      P::fmadd(t, bz, P::mul(one_minus_t, az)));
+    }
+    scalar::kernel_lerp_vec3_aos<T>(dst + i * STRIDE, vec_a + i * STRIDE,
+                                    vec_b + i * STRIDE, alpha + i, num - i);
+}
+
+// ***************************************************************************//
+//                           AoS <-> SoA conversions                          //
+// ***************************************************************************//
+
+template <typename T>
+MATH3D_TARGET_ISA auto kernel_aos_to_soa_vec3(Vec3Planes<T> dst, const T* src,
+                                              size_t num) -> void {
+    using P = Packet<T>;
+    constexpr size_t STRIDE = scalar::vec3_aos_stride<T>();
+    size_t i = 0;
+    for (; i + P::WIDTH <= num; i += P::WIDTH) {
+        typename P::Reg x, y, z;  // NOLINT
+        P::load_aos3(src + i * STRIDE, x, y, z);
+        P::store(dst.x + i, x);
+        P::store(dst.y + i, y);
+        P::store(dst.z + i, z);
+    }
+    scalar::kernel_aos_to_soa_vec3<T>(dst.offset(i), src + i * STRIDE,
+                                      num - i);
+}
+
+template <typename T>
+MATH3D_TARGET_ISA auto kernel_soa_to_aos_vec3(T* dst, Vec3ConstPlanes<T> src,
+                                              size_t num) -> void {
+    using P = Packet<T>;
+    constexpr size_t STRIDE = scalar::vec3_aos_stride<T>();
+    size_t i = 0;
+    for (; i + P::WIDTH <= num; i += P::WIDTH) {
+        P::store_aos3(dst + i * STRIDE, P::load(src.x + i), P::load(src.y + i),
+                      P::load(src.z + i));
+    }
+    scalar::kernel_soa_to_aos_vec3<T>(dst + i * STRIDE, src.offset(i),
+                                      num - i);
+}
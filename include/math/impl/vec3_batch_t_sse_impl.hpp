@@ -0,0 +1,25 @@
+#pragma once
+
+#include "./packet_sse_impl.hpp"
+#include "./vec3_batch_t_scalar_impl.hpp"
+
+#if defined(MATH3D_DISPATCH_SSE)
+
+/**
+ * SSE batch kernels for Vector3 (SSE|SSE2|SSE4.1)
+ *
+ * The kernels of vec3_batch_t_simd_impl.hpp over xmm registers, i.e. 4 float32
+ * or 2 float64 vectors per iteration.
+ */
+
+namespace math {
+namespace sse {
+
+#define MATH3D_TARGET_ISA MATH3D_TARGET_SSE
+#include "./vec3_batch_t_simd_impl.hpp"
+#undef MATH3D_TARGET_ISA
+
+}  // namespace sse
+}  // namespace math
+
+#endif  // MATH3D_DISPATCH_SSE
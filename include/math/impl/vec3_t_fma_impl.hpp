@@ -0,0 +1,155 @@
+#pragma once
+
+#if defined(MATH3D_FMA_ENABLED)
+
+#include <immintrin.h>
+
+#include "../vec3_t_decl.hpp"
+
+/**
+ * FMA instruction sets required for each kernel:
+ *
+ * - kernel_dot_vec3                : AVX|FMA
+ * - kernel_lerp_vec3               : AVX|FMA
+ *
+ * Notes:
+ * 1. Masked loads and stores:
+ *    A Vector3 has only 3 entries, so the vectors are moved with vmaskmov,
+ *    which never touches the 4th lane in memory (and leaves it zeroed on
+ *    loads). If the storage is padded (MATH3D_VEC3_PADDED) plain aligned
+ *    loads|stores are used instead, as the 4th lane is part of the vector
+ *
+ * 2. Dot product:
+ *    Instead of dpps (or a mul followed by two horizontal adds), the upper half
+ *    of the product is fused into the lower half, and the remaining two lanes
+ *    are added: dot(a, b) = (a0 * b0 + a2 * b2) + (a1 * b1 + 0)
+ *
+ * 3. Linear interpolation:
+ *    Computed as lerp(a, b, t) = a + t * (b - a), which is a single fused
+ *    multiply-add after the difference
+ */
+
+namespace math {
+namespace fma3 {
+
+template <typename T>
+using Vec3Buffer = typename Vector3<T>::BufferType;
+
+template <typename T>
+using SFINAE_VEC3_F32_FMA_GUARD =
+    typename std::enable_if<CpuHasFMA<T>::value && IsFloat32<T>::value>::type*;
+
+template <typename T>
+using SFINAE_VEC3_F64_FMA_GUARD =
+    typename std::enable_if<CpuHasFMA<T>::value && IsFloat64<T>::value>::type*;
+
+/// Returns the mask used to load|store the 3 entries of a float32 vector
+inline auto mask_xyz_f32() -> __m128i {
+    return _mm_setr_epi32(-1, -1, -1, 0);
+}
+
+/// Returns the mask used to load|store the 3 entries of a float64 vector
+inline auto mask_xyz_f64() -> __m256i {
+    return _mm256_setr_epi64x(-1, -1, -1, 0);
+}
+
+/// Loads the 3 entries of a Vector3 (the 4th lane is zero)
+inline auto load_vec3(const float32_t* src) -> __m128 {
+#if defined(MATH3D_VEC3_PADDED)
+    return _mm_load_ps(src);
+#else
+    return _mm_maskload_ps(src, mask_xyz_f32());
+#endif
+}
+
+/// Loads the 3 entries of a Vector3 (the 4th lane is zero)
+inline auto load_vec3(const float64_t* src) -> __m256d {
+#if defined(MATH3D_VEC3_PADDED)
+    return _mm256_load_pd(src);
+#else
+    return _mm256_maskload_pd(src, mask_xyz_f64());
+#endif
+}
+
+/// Stores the first 3 lanes of the given register into a Vector3
+inline auto store_vec3(float32_t* dst, __m128 src) -> void {
+#if defined(MATH3D_VEC3_PADDED)
+    _mm_store_ps(dst, src);
+#else
+    _mm_maskstore_ps(dst, mask_xyz_f32(), src);
+#endif
+}
+
+/// Stores the first 3 lanes of the given register into a Vector3
+inline auto store_vec3(float64_t* dst, __m256d src) -> void {
+#if defined(MATH3D_VEC3_PADDED)
+    _mm256_store_pd(dst, src);
+#else
+    _mm256_maskstore_pd(dst, mask_xyz_f64(), src);
+#endif
+}
+
+/// Returns the sum of the products of the 4 lanes of the given registers
+inline auto dot_f32(__m128 lhs, __m128 rhs) -> float32_t {
+    auto xmm_sum = _mm_fmadd_ps(_mm_movehl_ps(lhs, lhs),
+                                _mm_movehl_ps(rhs, rhs), _mm_mul_ps(lhs, rhs));
+    return _mm_cvtss_f32(_mm_add_ss(xmm_sum, _mm_movehdup_ps(xmm_sum)));
+}
+
+/// Returns the sum of the products of the 4 lanes of the given registers
+inline auto dot_f64(__m256d lhs, __m256d rhs) -> float64_t {
+    auto xmm_sum = _mm_fmadd_pd(
+        _mm256_extractf128_pd(lhs, 1), _mm256_extractf128_pd(rhs, 1),
+        _mm_mul_pd(_mm256_castpd256_pd128(lhs), _mm256_castpd256_pd128(rhs)));
+    auto xmm_sum_hi = _mm_unpackhi_pd(xmm_sum, xmm_sum);
+    return _mm_cvtsd_f64(_mm_add_sd(xmm_sum, xmm_sum_hi));
+}
+
+// ***************************************************************************//
+//                  Dispatch FMA-kernel for vector dot-product                //
+// ***************************************************************************//
+
+template <typename T, SFINAE_VEC3_F32_FMA_GUARD<T> = nullptr>
+MATH3D_INLINE auto kernel_dot_vec3(const Vec3Buffer<T>& lhs,
+                                   const Vec3Buffer<T>& rhs) -> T {
+    return dot_f32(load_vec3(lhs.data()), load_vec3(rhs.data()));
+}
+
+template <typename T, SFINAE_VEC3_F64_FMA_GUARD<T> = nullptr>
+MATH3D_INLINE auto kernel_dot_vec3(const Vec3Buffer<T>& lhs,
+                                   const Vec3Buffer<T>& rhs) -> T {
+    return dot_f64(load_vec3(lhs.data()), load_vec3(rhs.data()));
+}
+
+// ***************************************************************************//
+//              Dispatch FMA-kernel for vector linear interpolation           //
+// ***************************************************************************//
+
+template <typename T, SFINAE_VEC3_F32_FMA_GUARD<T> = nullptr>
+MATH3D_INLINE auto kernel_lerp_vec3(Vec3Buffer<T>& dst,
+                                    const Vec3Buffer<T>& vec_a,
+                                    const Vec3Buffer<T>& vec_b, T alpha)
+    -> void {
+    auto xmm_a = load_vec3(vec_a.data());
+    auto xmm_b = load_vec3(vec_b.data());
+    auto xmm_result =
+        _mm_fmadd_ps(_mm_set1_ps(alpha), _mm_sub_ps(xmm_b, xmm_a), xmm_a);
+    store_vec3(dst.data(), xmm_result);
+}
+
+template <typename T, SFINAE_VEC3_F64_FMA_GUARD<T> = nullptr>
+MATH3D_INLINE auto kernel_lerp_vec3(Vec3Buffer<T>& dst,
+                                    const Vec3Buffer<T>& vec_a,
+                                    const Vec3Buffer<T>& vec_b, T alpha)
+    -> void {
+    auto ymm_a = load_vec3(vec_a.data());
+    auto ymm_b = load_vec3(vec_b.data());
+    auto ymm_result = _mm256_fmadd_pd(_mm256_set1_pd(alpha),
+                                      _mm256_sub_pd(ymm_b, ymm_a), ymm_a);
+    store_vec3(dst.data(), ymm_result);
+}
+
+}  // namespace fma3
+}  // namespace math
+
+#endif  // MATH3D_FMA_ENABLED
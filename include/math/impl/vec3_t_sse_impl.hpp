@@ -20,11 +20,19 @@
  * - kernel_normalize_in_place_vec3 : SSE|SSE2|SSE4.1
  * - kernel_dot_vec3                : SSE|SSE2|SSE4.1
  * - kernel_cross_vec3              : SSE
+ * - kernel_lerp_vec3               : SSE|SSE2
  *
  * Notes:
+ * 0. Storage:
+ *    These kernels load|store 4 lanes per vector, so they require the padded
+ *    storage of MATH3D_VEC3_PADDED (4 entries, aligned to 16|32 bytes), and use
+ *    aligned loads|stores in that case. Without padding the loads|stores are
+ *    unaligned and go past the 3rd entry, which is why the operators only use
+ *    these kernels if the storage is padded (see MATH3D_VEC3_SSE_ENABLED)
+ *
  * 1. For SSE-float32:
- *    All elements of the buffer (4xf32, recall padding for alignment) fit into
- *    a single xmm register (128-bits <=> 4xfloat32)
+ *    All elements of the buffer (4xf32, incl. the padding) fit into a single
+ *    xmm register (128-bits <=> 4xfloat32)
  *
  * 2. For SSE-float64:
  *    Vector buffer contains 4xfloat64 <=> 256 bits <=> 32 bytes; however, xmm
@@ -48,104 +56,154 @@ template <typename T>
 using SFINAE_VEC3_F64_SSE_GUARD =
     typename std::enable_if<CpuHasSSE<T>::value && IsFloat64<T>::value>::type*;
 
+/// Loads the 4 lanes of a Vector3 (aligned if the storage is padded)
+inline auto load_vec3(const float32_t* src) -> __m128 {
+#if defined(MATH3D_VEC3_PADDED)
+    return _mm_load_ps(src);
+#else
+    return _mm_loadu_ps(src);
+#endif
+}
+
+/// Loads 2 of the 4 lanes of a Vector3 (aligned if the storage is padded)
+inline auto load_vec3(const float64_t* src) -> __m128d {
+#if defined(MATH3D_VEC3_PADDED)
+    return _mm_load_pd(src);
+#else
+    return _mm_loadu_pd(src);
+#endif
+}
+
+/// Stores the 4 lanes of a Vector3 (aligned if the storage is padded)
+inline auto store_vec3(float32_t* dst, __m128 src) -> void {
+#if defined(MATH3D_VEC3_PADDED)
+    _mm_store_ps(dst, src);
+#else
+    _mm_storeu_ps(dst, src);
+#endif
+}
+
+/// Stores 2 of the 4 lanes of a Vector3 (aligned if the storage is padded)
+inline auto store_vec3(float64_t* dst, __m128d src) -> void {
+#if defined(MATH3D_VEC3_PADDED)
+    _mm_store_pd(dst, src);
+#else
+    _mm_storeu_pd(dst, src);
+#endif
+}
+
+/// Returns the cross product of the first 3 lanes of the given registers
+inline auto cross_f32(__m128 lhs, __m128 rhs) -> __m128 {
+    // Same shuffles as in kernel_cross_vec3 (see below)
+    auto tmp_0 = _mm_shuffle_ps(
+        lhs, lhs, static_cast<int>(math::ShuffleMask<3, 0, 2, 1>::value));
+    auto tmp_1 = _mm_shuffle_ps(
+        rhs, rhs, static_cast<int>(math::ShuffleMask<3, 1, 0, 2>::value));
+    auto tmp_2 = _mm_shuffle_ps(
+        lhs, lhs, static_cast<int>(math::ShuffleMask<3, 1, 0, 2>::value));
+    auto tmp_3 = _mm_shuffle_ps(
+        rhs, rhs, static_cast<int>(math::ShuffleMask<3, 0, 2, 1>::value));
+    return _mm_sub_ps(_mm_mul_ps(tmp_0, tmp_1), _mm_mul_ps(tmp_2, tmp_3));
+}
+
 template <typename T, SFINAE_VEC3_F32_SSE_GUARD<T> = nullptr>
 MATH3D_INLINE auto kernel_add_vec3(Vec3Buffer<T>& dst, const Vec3Buffer<T>& lhs,
                                    const Vec3Buffer<T>& rhs) -> void {
-    auto xmm_lhs = _mm_loadu_ps(lhs.data());
-    auto xmm_rhs = _mm_loadu_ps(rhs.data());
+    auto xmm_lhs = load_vec3(lhs.data());
+    auto xmm_rhs = load_vec3(rhs.data());
     auto xmm_result = _mm_add_ps(xmm_lhs, xmm_rhs);
-    _mm_storeu_ps(dst.data(), xmm_result);
+    store_vec3(dst.data(), xmm_result);
 }
 
 template <typename T, SFINAE_VEC3_F64_SSE_GUARD<T> = nullptr>
 MATH3D_INLINE auto kernel_add_vec3(Vec3Buffer<T>& dst, const Vec3Buffer<T>& lhs,
                                    const Vec3Buffer<T>& rhs) -> void {
-    auto xmm_lhs_lo = _mm_loadu_pd(lhs.data());
-    auto xmm_lhs_hi = _mm_loadu_pd(lhs.data() + 2);
-    auto xmm_rhs_lo = _mm_loadu_pd(rhs.data());
-    auto xmm_rhs_hi = _mm_loadu_pd(rhs.data() + 2);
+    auto xmm_lhs_lo = load_vec3(lhs.data());
+    auto xmm_lhs_hi = load_vec3(lhs.data() + 2);
+    auto xmm_rhs_lo = load_vec3(rhs.data());
+    auto xmm_rhs_hi = load_vec3(rhs.data() + 2);
     auto xmm_result_lo = _mm_add_pd(xmm_lhs_lo, xmm_rhs_lo);
     auto xmm_result_hi = _mm_add_pd(xmm_lhs_hi, xmm_rhs_hi);
-    _mm_storeu_pd(dst.data(), xmm_result_lo);
-    _mm_storeu_pd(dst.data() + 2, xmm_result_hi);
+    store_vec3(dst.data(), xmm_result_lo);
+    store_vec3(dst.data() + 2, xmm_result_hi);
 }
 
 template <typename T, SFINAE_VEC3_F32_SSE_GUARD<T> = nullptr>
 MATH3D_INLINE auto kernel_sub_vec3(Vec3Buffer<T>& dst, const Vec3Buffer<T>& lhs,
                                    const Vec3Buffer<T>& rhs) -> void {
-    auto xmm_lhs = _mm_loadu_ps(lhs.data());
-    auto xmm_rhs = _mm_loadu_ps(rhs.data());
+    auto xmm_lhs = load_vec3(lhs.data());
+    auto xmm_rhs = load_vec3(rhs.data());
     auto xmm_result = _mm_sub_ps(xmm_lhs, xmm_rhs);
-    _mm_storeu_ps(dst.data(), xmm_result);
+    store_vec3(dst.data(), xmm_result);
 }
 
 template <typename T, SFINAE_VEC3_F64_SSE_GUARD<T> = nullptr>
 MATH3D_INLINE auto kernel_sub_vec3(Vec3Buffer<T>& dst, const Vec3Buffer<T>& lhs,
                                    const Vec3Buffer<T>& rhs) -> void {
-    auto xmm_lhs_lo = _mm_loadu_pd(lhs.data());
-    auto xmm_lhs_hi = _mm_loadu_pd(lhs.data() + 2);
-    auto xmm_rhs_lo = _mm_loadu_pd(rhs.data());
-    auto xmm_rhs_hi = _mm_loadu_pd(rhs.data() + 2);
+    auto xmm_lhs_lo = load_vec3(lhs.data());
+    auto xmm_lhs_hi = load_vec3(lhs.data() + 2);
+    auto xmm_rhs_lo = load_vec3(rhs.data());
+    auto xmm_rhs_hi = load_vec3(rhs.data() + 2);
     auto xmm_result_lo = _mm_sub_pd(xmm_lhs_lo, xmm_rhs_lo);
     auto xmm_result_hi = _mm_sub_pd(xmm_lhs_hi, xmm_rhs_hi);
-    _mm_storeu_pd(dst.data(), xmm_result_lo);
-    _mm_storeu_pd(dst.data() + 2, xmm_result_hi);
+    store_vec3(dst.data(), xmm_result_lo);
+    store_vec3(dst.data() + 2, xmm_result_hi);
 }
 
 template <typename T, SFINAE_VEC3_F32_SSE_GUARD<T> = nullptr>
 MATH3D_INLINE auto kernel_scale_vec3(Vec3Buffer<T>& dst, T scale,
                                      const Vec3Buffer<T>& vec) -> void {
     auto xmm_scale = _mm_set1_ps(scale);
-    auto xmm_vector = _mm_loadu_ps(vec.data());
+    auto xmm_vector = load_vec3(vec.data());
     auto xmm_result = _mm_mul_ps(xmm_scale, xmm_vector);
-    _mm_storeu_ps(dst.data(), xmm_result);
+    store_vec3(dst.data(), xmm_result);
 }
 
 template <typename T, SFINAE_VEC3_F64_SSE_GUARD<T> = nullptr>
 MATH3D_INLINE auto kernel_scale_vec3(Vec3Buffer<T>& dst, T scale,
                                      const Vec3Buffer<T>& vec) -> void {
     auto xmm_scale = _mm_set1_pd(scale);
-    auto xmm_vector_lo = _mm_loadu_pd(vec.data());
-    auto xmm_vector_hi = _mm_loadu_pd(vec.data() + 2);
+    auto xmm_vector_lo = load_vec3(vec.data());
+    auto xmm_vector_hi = load_vec3(vec.data() + 2);
     auto xmm_result_lo = _mm_mul_pd(xmm_scale, xmm_vector_lo);
     auto xmm_result_hi = _mm_mul_pd(xmm_scale, xmm_vector_hi);
-    _mm_storeu_pd(dst.data(), xmm_result_lo);
-    _mm_storeu_pd(dst.data() + 2, xmm_result_hi);
+    store_vec3(dst.data(), xmm_result_lo);
+    store_vec3(dst.data() + 2, xmm_result_hi);
 }
 
 template <typename T, SFINAE_VEC3_F32_SSE_GUARD<T> = nullptr>
 MATH3D_INLINE auto kernel_hadamard_vec3(Vec3Buffer<T>& dst,
                                         const Vec3Buffer<T>& lhs,
                                         const Vec3Buffer<T>& rhs) -> void {
-    auto xmm_lhs = _mm_loadu_ps(lhs.data());
-    auto xmm_rhs = _mm_loadu_ps(rhs.data());
-    _mm_storeu_ps(dst.data(), _mm_mul_ps(xmm_lhs, xmm_rhs));
+    auto xmm_lhs = load_vec3(lhs.data());
+    auto xmm_rhs = load_vec3(rhs.data());
+    store_vec3(dst.data(), _mm_mul_ps(xmm_lhs, xmm_rhs));
 }
 
 template <typename T, SFINAE_VEC3_F64_SSE_GUARD<T> = nullptr>
 MATH3D_INLINE auto kernel_hadamard_vec3(Vec3Buffer<T>& dst,
                                         const Vec3Buffer<T>& lhs,
                                         const Vec3Buffer<T>& rhs) -> void {
-    auto xmm_lhs_lo = _mm_loadu_pd(lhs.data());
-    auto xmm_lhs_hi = _mm_loadu_pd(lhs.data() + 2);
-    auto xmm_rhs_lo = _mm_loadu_pd(rhs.data());
-    auto xmm_rhs_hi = _mm_loadu_pd(rhs.data() + 2);
-    _mm_storeu_pd(dst.data(), _mm_mul_pd(xmm_lhs_lo, xmm_rhs_lo));
-    _mm_storeu_pd(dst.data() + 2, _mm_mul_pd(xmm_lhs_hi, xmm_rhs_hi));
+    auto xmm_lhs_lo = load_vec3(lhs.data());
+    auto xmm_lhs_hi = load_vec3(lhs.data() + 2);
+    auto xmm_rhs_lo = load_vec3(rhs.data());
+    auto xmm_rhs_hi = load_vec3(rhs.data() + 2);
+    store_vec3(dst.data(), _mm_mul_pd(xmm_lhs_lo, xmm_rhs_lo));
+    store_vec3(dst.data() + 2, _mm_mul_pd(xmm_lhs_hi, xmm_rhs_hi));
 }
 
 template <typename T, SFINAE_VEC3_F32_SSE_GUARD<T> = nullptr>
 MATH3D_INLINE auto kernel_length_square_vec3(const Vec3Buffer<T>& vec) -> T {
     // Implementation based on this post: https://bit.ly/3FyZF0n
-    auto xmm_v = _mm_loadu_ps(vec.data());
+    auto xmm_v = load_vec3(vec.data());
     return _mm_cvtss_f32(_mm_dp_ps(xmm_v, xmm_v, 0x71));
 }
 
 template <typename T, SFINAE_VEC3_F64_SSE_GUARD<T> = nullptr>
 MATH3D_INLINE auto kernel_length_square_vec3(const Vec3Buffer<T>& vec) -> T {
     // Implementation based on this post: https://bit.ly/3FyZF0n
-    auto xmm_v_lo = _mm_loadu_pd(vec.data());
-    auto xmm_v_hi = _mm_loadu_pd(vec.data() + 2);
+    auto xmm_v_lo = load_vec3(vec.data());
+    auto xmm_v_hi = load_vec3(vec.data() + 2);
     auto xmm_square_sum_lo = _mm_dp_pd(xmm_v_lo, xmm_v_lo, 0x31);
     auto xmm_square_sum_hi = _mm_dp_pd(xmm_v_hi, xmm_v_hi, 0x31);
     auto xmm_square_sum = _mm_add_pd(xmm_square_sum_lo, xmm_square_sum_hi);
@@ -155,15 +213,15 @@ MATH3D_INLINE auto kernel_length_square_vec3(const Vec3Buffer<T>& vec) -> T {
 template <typename T, SFINAE_VEC3_F32_SSE_GUARD<T> = nullptr>
 MATH3D_INLINE auto kernel_length_vec3(const Vec3Buffer<T>& vec) -> T {
     // Implementation based on this post: https://bit.ly/3FyZF0n
-    auto xmm_v = _mm_loadu_ps(vec.data());
+    auto xmm_v = load_vec3(vec.data());
     return _mm_cvtss_f32(_mm_sqrt_ss(_mm_dp_ps(xmm_v, xmm_v, 0x71)));
 }
 
 template <typename T, SFINAE_VEC3_F64_SSE_GUARD<T> = nullptr>
 MATH3D_INLINE auto kernel_length_vec3(const Vec3Buffer<T>& vec) -> T {
     // Implementation based on this post: https://bit.ly/3FyZF0n
-    auto xmm_v_01 = _mm_loadu_pd(vec.data());
-    auto xmm_v_23 = _mm_loadu_pd(vec.data() + 2);
+    auto xmm_v_01 = load_vec3(vec.data());
+    auto xmm_v_23 = load_vec3(vec.data() + 2);
     auto xmm_square_sum_01 = _mm_dp_pd(xmm_v_01, xmm_v_01, 0x31);
     auto xmm_square_sum_23 = _mm_dp_pd(xmm_v_23, xmm_v_23, 0x31);
     auto xmm_square_sum = _mm_add_pd(xmm_square_sum_01, xmm_square_sum_23);
@@ -173,32 +231,32 @@ MATH3D_INLINE auto kernel_length_vec3(const Vec3Buffer<T>& vec) -> T {
 template <typename T, SFINAE_VEC3_F32_SSE_GUARD<T> = nullptr>
 MATH3D_INLINE auto kernel_normalize_in_place_vec3(Vec3Buffer<T>& vec) -> void {
     // Implementation based on this post: https://bit.ly/3FyZF0n
-    auto xmm_v = _mm_loadu_ps(vec.data());
+    auto xmm_v = load_vec3(vec.data());
     auto xmm_sums = _mm_dp_ps(xmm_v, xmm_v, 0x7f);
     auto xmm_r_sqrt_sums = _mm_sqrt_ps(xmm_sums);
     auto xmm_v_norm = _mm_div_ps(xmm_v, xmm_r_sqrt_sums);
-    _mm_storeu_ps(vec.data(), xmm_v_norm);
+    store_vec3(vec.data(), xmm_v_norm);
 }
 
 template <typename T, SFINAE_VEC3_F64_SSE_GUARD<T> = nullptr>
 MATH3D_INLINE auto kernel_normalize_in_place_vec3(Vec3Buffer<T>& vec) -> void {
     // Implementation based on this post: https://bit.ly/3FyZF0n
-    auto xmm_v_01 = _mm_loadu_pd(vec.data());
-    auto xmm_v_23 = _mm_loadu_pd(vec.data() + 2);
+    auto xmm_v_01 = load_vec3(vec.data());
+    auto xmm_v_23 = load_vec3(vec.data() + 2);
     auto xmm_sums_01 = _mm_dp_pd(xmm_v_01, xmm_v_01, 0x33);
     auto xmm_sums_23 = _mm_dp_pd(xmm_v_23, xmm_v_23, 0x33);
     auto xmm_r_sqrt_sums = _mm_sqrt_pd(_mm_add_pd(xmm_sums_01, xmm_sums_23));
     auto xmm_v_norm_01 = _mm_div_pd(xmm_v_01, xmm_r_sqrt_sums);
     auto xmm_v_norm_23 = _mm_div_pd(xmm_v_23, xmm_r_sqrt_sums);
-    _mm_storeu_pd(vec.data(), xmm_v_norm_01);
-    _mm_storeu_pd(vec.data() + 2, xmm_v_norm_23);
+    store_vec3(vec.data(), xmm_v_norm_01);
+    store_vec3(vec.data() + 2, xmm_v_norm_23);
 }
 
 template <typename T, SFINAE_VEC3_F32_SSE_GUARD<T> = nullptr>
 MATH3D_INLINE auto kernel_dot_vec3(const Vec3Buffer<T>& lhs,
                                    const Vec3Buffer<T>& rhs) -> T {
-    auto xmm_lhs = _mm_loadu_ps(lhs.data());
-    auto xmm_rhs = _mm_loadu_ps(rhs.data());
+    auto xmm_lhs = load_vec3(lhs.data());
+    auto xmm_rhs = load_vec3(rhs.data());
     auto xmm_cond_prod = _mm_dp_ps(xmm_lhs, xmm_rhs, 0x71);
     return _mm_cvtss_f32(xmm_cond_prod);
 }
@@ -206,10 +264,10 @@ MATH3D_INLINE auto kernel_dot_vec3(const Vec3Buffer<T>& lhs,
 template <typename T, SFINAE_VEC3_F64_SSE_GUARD<T> = nullptr>
 MATH3D_INLINE auto kernel_dot_vec3(const Vec3Buffer<T>& lhs,
                                    const Vec3Buffer<T>& rhs) -> T {
-    auto xmm_lhs_01 = _mm_loadu_pd(lhs.data());
-    auto xmm_lhs_23 = _mm_loadu_pd(lhs.data() + 2);
-    auto xmm_rhs_01 = _mm_loadu_pd(rhs.data());
-    auto xmm_rhs_23 = _mm_loadu_pd(rhs.data() + 2);
+    auto xmm_lhs_01 = load_vec3(lhs.data());
+    auto xmm_lhs_23 = load_vec3(lhs.data() + 2);
+    auto xmm_rhs_01 = load_vec3(rhs.data());
+    auto xmm_rhs_23 = load_vec3(rhs.data() + 2);
     auto xmm_dot_01 = _mm_dp_pd(xmm_lhs_01, xmm_rhs_01, 0x31);
     auto xmm_dot_23 = _mm_dp_pd(xmm_lhs_23, xmm_rhs_23, 0x31);
     return _mm_cvtsd_f64(_mm_add_pd(xmm_dot_01, xmm_dot_23));
@@ -227,8 +285,8 @@ MATH3D_INLINE auto kernel_cross_vec3(Vec3Buffer<T>& dst,
     //            a[2] * b[0] - a[0] * b[2],
     //            a[0] * b[1] - a[1] * b[0],
     //                        0            ]
-    auto vec_a = _mm_loadu_ps(lhs.data());  // a = {a[0], a[1], a[2], a[3]=0}
-    auto vec_b = _mm_loadu_ps(rhs.data());  // b = {b[0], b[1], b[2], b[3]=0}
+    auto vec_a = load_vec3(lhs.data());  // a = {a[0], a[1], a[2], a[3]=0}
+    auto vec_b = load_vec3(rhs.data());  // b = {b[0], b[1], b[2], b[3]=0}
     // tmp_0 = {a[1], a[2], a[0], 0}
     auto tmp_0 = _mm_shuffle_ps(
         vec_a, vec_a, static_cast<int>(math::ShuffleMask<3, 0, 2, 1>::value));
@@ -241,8 +299,8 @@ MATH3D_INLINE auto kernel_cross_vec3(Vec3Buffer<T>& dst,
     // tmp_3 = {b[1], b[2], b[0], 0}
     auto tmp_3 = _mm_shuffle_ps(
         vec_b, vec_b, static_cast<int>(math::ShuffleMask<3, 0, 2, 1>::value));
-    _mm_storeu_ps(dst.data(), _mm_sub_ps(_mm_mul_ps(tmp_0, tmp_1),
-                                         _mm_mul_ps(tmp_2, tmp_3)));
+    store_vec3(dst.data(),
+               _mm_sub_ps(_mm_mul_ps(tmp_0, tmp_1), _mm_mul_ps(tmp_2, tmp_3)));
 }
 
 template <typename T, SFINAE_VEC3_F64_SSE_GUARD<T> = nullptr>
@@ -256,6 +314,37 @@ MATH3D_INLINE auto kernel_cross_vec3(Vec3Buffer<T>& dst,
     dst[2] = lhs[0] * rhs[1] - lhs[1] * rhs[0];
 }
 
+template <typename T, SFINAE_VEC3_F32_SSE_GUARD<T> = nullptr>
+MATH3D_INLINE auto kernel_lerp_vec3(Vec3Buffer<T>& dst,
+                                    const Vec3Buffer<T>& vec_a,
+                                    const Vec3Buffer<T>& vec_b, T alpha)
+    -> void {
+    // Same expression as the scalar kernel, so both endpoints are exact
+    auto xmm_a = load_vec3(vec_a.data());
+    auto xmm_b = load_vec3(vec_b.data());
+    store_vec3(dst.data(),
+               _mm_add_ps(_mm_mul_ps(_mm_set1_ps(1.0F - alpha), xmm_a),
+                          _mm_mul_ps(_mm_set1_ps(alpha), xmm_b)));
+}
+
+template <typename T, SFINAE_VEC3_F64_SSE_GUARD<T> = nullptr>
+MATH3D_INLINE auto kernel_lerp_vec3(Vec3Buffer<T>& dst,
+                                    const Vec3Buffer<T>& vec_a,
+                                    const Vec3Buffer<T>& vec_b, T alpha)
+    -> void {
+    auto xmm_alpha = _mm_set1_pd(alpha);
+    auto xmm_one_minus_alpha = _mm_set1_pd(1.0 - alpha);
+    auto xmm_a_lo = load_vec3(vec_a.data());
+    auto xmm_a_hi = load_vec3(vec_a.data() + 2);
+    auto xmm_b_lo = load_vec3(vec_b.data());
+    auto xmm_b_hi = load_vec3(vec_b.data() + 2);
+    store_vec3(dst.data(), _mm_add_pd(_mm_mul_pd(xmm_one_minus_alpha, xmm_a_lo),
+                                      _mm_mul_pd(xmm_alpha, xmm_b_lo)));
+    store_vec3(dst.data() + 2,
+               _mm_add_pd(_mm_mul_pd(xmm_one_minus_alpha, xmm_a_hi),
+                          _mm_mul_pd(xmm_alpha, xmm_b_hi)));
+}
+
 }  // namespace sse
 }  // namespace math
 
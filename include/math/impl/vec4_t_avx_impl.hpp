@@ -14,6 +14,7 @@
  * - kernel_scale_vec4      : SSE|AVX
  * - kernel_hadamard_vec4   : SSE|AVX
  * - kernel_dot_vec4        : SSE|AVX|SSE2
+ * - kernel_lerp_vec4       : SSE|AVX
  *
  * Notes:
  * 1. For AVX float32:
@@ -201,6 +202,32 @@ MATH3D_INLINE auto kernel_dot_vec4(const Vec4Buffer<T>& lhs,
     return _mm_cvtsd_f64(xmm_result);
 }
 
+template <typename T, SFINAE_VEC4_F32_AVX_GUARD<T> = nullptr>
+MATH3D_INLINE auto kernel_lerp_vec4(Vec4Buffer<T>& dst,
+                                    const Vec4Buffer<T>& vec_a,
+                                    const Vec4Buffer<T>& vec_b, T alpha)
+    -> void {
+    // Same expression as the scalar kernel, so both endpoints are exact
+    auto xmm_a = _mm_loadu_ps(vec_a.data());
+    auto xmm_b = _mm_loadu_ps(vec_b.data());
+    auto xmm_lerp = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(1.0F - alpha), xmm_a),
+                               _mm_mul_ps(_mm_set1_ps(alpha), xmm_b));
+    _mm_storeu_ps(dst.data(), xmm_lerp);
+}
+
+template <typename T, SFINAE_VEC4_F64_AVX_GUARD<T> = nullptr>
+MATH3D_INLINE auto kernel_lerp_vec4(Vec4Buffer<T>& dst,
+                                    const Vec4Buffer<T>& vec_a,
+                                    const Vec4Buffer<T>& vec_b, T alpha)
+    -> void {
+    auto ymm_a = _mm256_loadu_pd(vec_a.data());
+    auto ymm_b = _mm256_loadu_pd(vec_b.data());
+    auto ymm_lerp =
+        _mm256_add_pd(_mm256_mul_pd(_mm256_set1_pd(1.0 - alpha), ymm_a),
+                      _mm256_mul_pd(_mm256_set1_pd(alpha), ymm_b));
+    _mm256_storeu_pd(dst.data(), ymm_lerp);
+}
+
 }  // namespace avx
 }  // namespace math
 
@@ -0,0 +1,83 @@
+#pragma once
+
+#if defined(MATH3D_FMA_ENABLED)
+
+#include <immintrin.h>
+
+#include "../vec4_t_decl.hpp"
+#include "./vec3_t_fma_impl.hpp"
+
+/**
+ * FMA instruction sets required for each kernel:
+ *
+ * - kernel_dot_vec4                : AVX|FMA
+ * - kernel_lerp_vec4               : AVX|FMA
+ *
+ * Notes:
+ * 1. Same approach as in the Vector3 kernels (see vec3_t_fma_impl.hpp), but
+ *    with plain loads and stores, as the 4 entries fill a whole xmm (float32)
+ *    or ymm (float64) register
+ */
+
+namespace math {
+namespace fma3 {
+
+template <typename T>
+using Vec4Buffer = typename Vector4<T>::BufferType;
+
+template <typename T>
+using SFINAE_VEC4_F32_FMA_GUARD =
+    typename std::enable_if<CpuHasFMA<T>::value && IsFloat32<T>::value>::type*;
+
+template <typename T>
+using SFINAE_VEC4_F64_FMA_GUARD =
+    typename std::enable_if<CpuHasFMA<T>::value && IsFloat64<T>::value>::type*;
+
+// ***************************************************************************//
+//                  Dispatch FMA-kernel for vector dot-product                //
+// ***************************************************************************//
+
+template <typename T, SFINAE_VEC4_F32_FMA_GUARD<T> = nullptr>
+MATH3D_INLINE auto kernel_dot_vec4(const Vec4Buffer<T>& lhs,
+                                   const Vec4Buffer<T>& rhs) -> T {
+    return dot_f32(_mm_loadu_ps(lhs.data()), _mm_loadu_ps(rhs.data()));
+}
+
+template <typename T, SFINAE_VEC4_F64_FMA_GUARD<T> = nullptr>
+MATH3D_INLINE auto kernel_dot_vec4(const Vec4Buffer<T>& lhs,
+                                   const Vec4Buffer<T>& rhs) -> T {
+    return dot_f64(_mm256_loadu_pd(lhs.data()), _mm256_loadu_pd(rhs.data()));
+}
+
+// ***************************************************************************//
+//              Dispatch FMA-kernel for vector linear interpolation           //
+// ***************************************************************************//
+
+template <typename T, SFINAE_VEC4_F32_FMA_GUARD<T> = nullptr>
+MATH3D_INLINE auto kernel_lerp_vec4(Vec4Buffer<T>& dst,
+                                    const Vec4Buffer<T>& vec_a,
+                                    const Vec4Buffer<T>& vec_b, T alpha)
+    -> void {
+    auto xmm_a = _mm_loadu_ps(vec_a.data());
+    auto xmm_b = _mm_loadu_ps(vec_b.data());
+    auto xmm_result =
+        _mm_fmadd_ps(_mm_set1_ps(alpha), _mm_sub_ps(xmm_b, xmm_a), xmm_a);
+    _mm_storeu_ps(dst.data(), xmm_result);
+}
+
+template <typename T, SFINAE_VEC4_F64_FMA_GUARD<T> = nullptr>
+MATH3D_INLINE auto kernel_lerp_vec4(Vec4Buffer<T>& dst,
+                                    const Vec4Buffer<T>& vec_a,
+                                    const Vec4Buffer<T>& vec_b, T alpha)
+    -> void {
+    auto ymm_a = _mm256_loadu_pd(vec_a.data());
+    auto ymm_b = _mm256_loadu_pd(vec_b.data());
+    auto ymm_result = _mm256_fmadd_pd(_mm256_set1_pd(alpha),
+                                      _mm256_sub_pd(ymm_b, ymm_a), ymm_a);
+    _mm256_storeu_pd(dst.data(), ymm_result);
+}
+
+}  // namespace fma3
+}  // namespace math
+
+#endif  // MATH3D_FMA_ENABLED
@@ -16,6 +16,7 @@
  * - kernel_scale_vec4      : SSE|SSE2
  * - kernel_hadamard_vec4   : SSE|SSE2
  * - kernel_dot_vec4        : SSE|SSE2|SSE4.1
+ * - kernel_lerp_vec4       : SSE|SSE2
  *
  * Notes:
  * 1. For SSE-float32:
@@ -212,6 +213,38 @@ MATH3D_INLINE auto kernel_dot_vec4(const Vec4Buffer<T>& lhs,
     return _mm_cvtsd_f64(_mm_add_pd(xmm_dot_lo, xmm_dot_hi));
 }
 
+template <typename T, SFINAE_VEC4_F32_SSE_GUARD<T> = nullptr>
+MATH3D_INLINE auto kernel_lerp_vec4(Vec4Buffer<T>& dst,
+                                    const Vec4Buffer<T>& vec_a,
+                                    const Vec4Buffer<T>& vec_b, T alpha)
+    -> void {
+    // Same expression as the scalar kernel, so both endpoints are exact
+    auto xmm_a = _mm_loadu_ps(vec_a.data());
+    auto xmm_b = _mm_loadu_ps(vec_b.data());
+    auto xmm_lerp = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(1.0F - alpha), xmm_a),
+                               _mm_mul_ps(_mm_set1_ps(alpha), xmm_b));
+    _mm_storeu_ps(dst.data(), xmm_lerp);
+}
+
+template <typename T, SFINAE_VEC4_F64_SSE_GUARD<T> = nullptr>
+MATH3D_INLINE auto kernel_lerp_vec4(Vec4Buffer<T>& dst,
+                                    const Vec4Buffer<T>& vec_a,
+                                    const Vec4Buffer<T>& vec_b, T alpha)
+    -> void {
+    auto xmm_alpha = _mm_set1_pd(alpha);
+    auto xmm_one_minus_alpha = _mm_set1_pd(1.0 - alpha);
+    auto xmm_a_lo = _mm_loadu_pd(vec_a.data());
+    auto xmm_a_hi = _mm_loadu_pd(vec_a.data() + 2);
+    auto xmm_b_lo = _mm_loadu_pd(vec_b.data());
+    auto xmm_b_hi = _mm_loadu_pd(vec_b.data() + 2);
+    auto xmm_lerp_lo = _mm_add_pd(_mm_mul_pd(xmm_one_minus_alpha, xmm_a_lo),
+                                  _mm_mul_pd(xmm_alpha, xmm_b_lo));
+    auto xmm_lerp_hi = _mm_add_pd(_mm_mul_pd(xmm_one_minus_alpha, xmm_a_hi),
+                                  _mm_mul_pd(xmm_alpha, xmm_b_hi));
+    _mm_storeu_pd(dst.data(), xmm_lerp_lo);
+    _mm_storeu_pd(dst.data() + 2, xmm_lerp_hi);
+}
+
 }  // namespace sse
 }  // namespace math
 
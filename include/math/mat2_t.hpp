@@ -8,6 +8,7 @@
 #include "./impl/mat2_t_scalar_impl.hpp"
 #include "./impl/mat2_t_sse_impl.hpp"
 #include "./impl/mat2_t_avx_impl.hpp"
+#include "./impl/mat2_t_fma_impl.hpp"
 
 namespace math {
 
@@ -167,7 +168,9 @@ template <typename T>
 MATH3D_INLINE auto operator*(const Matrix2<T>& lhs, const Matrix2<T>& rhs)
     -> Matrix2<T> {
     Matrix2<T> dst;
-#if defined(MATH3D_AVX_ENABLED)
+#if defined(MATH3D_FMA_ENABLED)
+    fma3::kernel_matmul_mat2<T>(dst.elements(), lhs.elements(), rhs.elements());
+#elif defined(MATH3D_AVX_ENABLED)
     avx::kernel_matmul_mat2<T>(dst.elements(), lhs.elements(), rhs.elements());
 #elif defined(MATH3D_SSE_ENABLED)
     sse::kernel_matmul_mat2<T>(dst.elements(), lhs.elements(), rhs.elements());
@@ -182,7 +185,10 @@ template <typename T>
 MATH3D_INLINE auto operator*(const Matrix2<T>& lhs_mat,
                              const Vector2<T>& rhs_vec) -> Vector2<T> {
     Vector2<T> dst;
-#if defined(MATH3D_AVX_ENABLED)
+#if defined(MATH3D_FMA_ENABLED)
+    fma3::kernel_matmul_vec_mat2<T>(dst.elements(), lhs_mat.elements(),
+                                    rhs_vec.elements());
+#elif defined(MATH3D_AVX_ENABLED)
     avx::kernel_matmul_vec_mat2<T>(dst.elements(), lhs_mat.elements(),
                                    rhs_vec.elements());
 #elif defined(MATH3D_SSE_ENABLED)
@@ -3,11 +3,13 @@
 #include <cmath>
 #include <iomanip>
 
+#include "./fast_math.hpp"
 #include "./mat3_t_decl.hpp"
 
 #include "./impl/mat3_t_scalar_impl.hpp"
 #include "./impl/mat3_t_sse_impl.hpp"
 #include "./impl/mat3_t_avx_impl.hpp"
+#include "./impl/mat3_t_fma_impl.hpp"
 
 #include "./quat_t.hpp"
 #include "./euler_t.hpp"
@@ -75,9 +77,10 @@ auto Matrix3<T>::setFromTransform(const Mat4& m) -> void {
 }
 
 template <typename T>
+template <typename Trig>
 auto Matrix3<T>::RotationX(T angle) -> Matrix3<T> {
-    auto cos_t = std::cos(angle);
-    auto sin_t = std::sin(angle);
+    T sin_t, cos_t;  // NOLINT
+    Trig::sincos(angle, sin_t, cos_t);
     // clang-format off
     return Matrix3<T>(
         1.0, 0.0, 0.0,
@@ -87,9 +90,10 @@ auto Matrix3<T>::RotationX(T angle) -> Matrix3<T> {
 }
 
 template <typename T>
+template <typename Trig>
 auto Matrix3<T>::RotationY(T angle) -> Matrix3<T> {
-    auto cos_t = std::cos(angle);
-    auto sin_t = std::sin(angle);
+    T sin_t, cos_t;  // NOLINT
+    Trig::sincos(angle, sin_t, cos_t);
     // clang-format off
     return Matrix3<T>(
         cos_t, 0.0, sin_t,
@@ -99,9 +103,10 @@ auto Matrix3<T>::RotationY(T angle) -> Matrix3<T> {
 }
 
 template <typename T>
+template <typename Trig>
 auto Matrix3<T>::RotationZ(T angle) -> Matrix3<T> {
-    auto cos_t = std::cos(angle);
-    auto sin_t = std::sin(angle);
+    T sin_t, cos_t;  // NOLINT
+    Trig::sincos(angle, sin_t, cos_t);
     // clang-format off
     return Matrix3<T>(
         cos_t, -sin_t, 0.0,
@@ -186,7 +191,13 @@ template <typename T>
 MATH3D_INLINE auto operator+(const Matrix3<T>& lhs, const Matrix3<T>& rhs)
     -> Matrix3<T> {
     Matrix3<T> dst;
+#if defined(MATH3D_VEC3_AVX_ENABLED)
+    avx::kernel_add_mat3<T>(dst.elements(), lhs.elements(), rhs.elements());
+#elif defined(MATH3D_VEC3_SSE_ENABLED)
+    sse::kernel_add_mat3<T>(dst.elements(), lhs.elements(), rhs.elements());
+#else
     scalar::kernel_add_mat3<T>(dst.elements(), lhs.elements(), rhs.elements());
+#endif
     return dst;
 }
 
@@ -194,7 +205,13 @@ template <typename T>
 MATH3D_INLINE auto operator-(const Matrix3<T>& lhs, const Matrix3<T>& rhs)
     -> Matrix3<T> {
     Matrix3<T> dst;
+#if defined(MATH3D_VEC3_AVX_ENABLED)
+    avx::kernel_sub_mat3<T>(dst.elements(), lhs.elements(), rhs.elements());
+#elif defined(MATH3D_VEC3_SSE_ENABLED)
+    sse::kernel_sub_mat3<T>(dst.elements(), lhs.elements(), rhs.elements());
+#else
     scalar::kernel_sub_mat3<T>(dst.elements(), lhs.elements(), rhs.elements());
+#endif
     return dst;
 }
 
@@ -202,8 +219,16 @@ template <typename T>
 MATH3D_INLINE auto operator*(double scale, const Matrix3<T>& mat)
     -> Matrix3<T> {
     Matrix3<T> dst;
+#if defined(MATH3D_VEC3_AVX_ENABLED)
+    avx::kernel_scale_mat3<T>(dst.elements(), static_cast<T>(scale),
+                              mat.elements());
+#elif defined(MATH3D_VEC3_SSE_ENABLED)
+    sse::kernel_scale_mat3<T>(dst.elements(), static_cast<T>(scale),
+                              mat.elements());
+#else
     scalar::kernel_scale_mat3<T>(dst.elements(), static_cast<T>(scale),
                                  mat.elements());
+#endif
     return dst;
 }
 
@@ -211,8 +236,16 @@ template <typename T>
 MATH3D_INLINE auto operator*(const Matrix3<T>& mat, double scale)
     -> Matrix3<T> {
     Matrix3<T> dst;
+#if defined(MATH3D_VEC3_AVX_ENABLED)
+    avx::kernel_scale_mat3<T>(dst.elements(), static_cast<T>(scale),
+                              mat.elements());
+#elif defined(MATH3D_VEC3_SSE_ENABLED)
+    sse::kernel_scale_mat3<T>(dst.elements(), static_cast<T>(scale),
+                              mat.elements());
+#else
     scalar::kernel_scale_mat3<T>(dst.elements(), static_cast<T>(scale),
                                  mat.elements());
+#endif
     return dst;
 }
 
@@ -220,8 +253,16 @@ template <typename T>
 MATH3D_INLINE auto operator*(const Matrix3<T>& lhs, const Matrix3<T>& rhs)
     -> Matrix3<T> {
     Matrix3<T> dst;
+#if defined(MATH3D_FMA_ENABLED)
+    fma3::kernel_matmul_mat3<T>(dst.elements(), lhs.elements(), rhs.elements());
+#elif defined(MATH3D_VEC3_AVX_ENABLED)
+    avx::kernel_matmul_mat3<T>(dst.elements(), lhs.elements(), rhs.elements());
+#elif defined(MATH3D_VEC3_SSE_ENABLED)
+    sse::kernel_matmul_mat3<T>(dst.elements(), lhs.elements(), rhs.elements());
+#else
     scalar::kernel_matmul_mat3<T>(dst.elements(), lhs.elements(),
                                   rhs.elements());
+#endif
     return dst;
 }
 
@@ -229,8 +270,19 @@ template <typename T>
 MATH3D_INLINE auto operator*(const Matrix3<T>& lhs_mat,
                              const Vector3<T>& rhs_vec) -> Vector3<T> {
     Vector3<T> dst;
+#if defined(MATH3D_FMA_ENABLED)
+    fma3::kernel_matmul_vec_mat3<T>(dst.elements(), lhs_mat.elements(),
+                                    rhs_vec.elements());
+#elif defined(MATH3D_VEC3_AVX_ENABLED)
+    avx::kernel_matmul_vec_mat3<T>(dst.elements(), lhs_mat.elements(),
+                                   rhs_vec.elements());
+#elif defined(MATH3D_VEC3_SSE_ENABLED)
+    sse::kernel_matmul_vec_mat3<T>(dst.elements(), lhs_mat.elements(),
+                                   rhs_vec.elements());
+#else
     scalar::kernel_matmul_vec_mat3<T>(dst.elements(), lhs_mat.elements(),
                                       rhs_vec.elements());
+#endif
     return dst;
 }
 
@@ -238,8 +290,16 @@ template <typename T>
 MATH3D_INLINE auto hadamard(const Matrix3<T>& lhs, const Matrix3<T>& rhs)
     -> Matrix3<T> {
     Matrix3<T> dst;
+#if defined(MATH3D_VEC3_AVX_ENABLED)
+    avx::kernel_hadamard_mat3<T>(dst.elements(), lhs.elements(),
+                                 rhs.elements());
+#elif defined(MATH3D_VEC3_SSE_ENABLED)
+    sse::kernel_hadamard_mat3<T>(dst.elements(), lhs.elements(),
+                                 rhs.elements());
+#else
     scalar::kernel_hadamard_mat3<T>(dst.elements(), lhs.elements(),
                                     rhs.elements());
+#endif
     return dst;
 }
 
@@ -274,7 +334,7 @@ auto operator>>(std::istream& input_stream, Matrix3<T>& dst) -> std::istream& {
     // Based on ignition-math implementation https://bit.ly/3MPgPcW
     input_stream.setf(std::ios_base::skipws);
     // Temporary place to store the inputs given by the user
-    std::array<T, Matrix3<T>::BUFFER_SIZE> mat;
+    std::array<T, Matrix3<T>::MATRIX_SIZE * Matrix3<T>::MATRIX_SIZE> mat;
     // Get these many items/elements from the input stream (row-major order)
     // NOLINTNEXTLINE
     input_stream >> mat[0] >> mat[1] >> mat[2] >> mat[3] >> mat[4] >> mat[5] >>
@@ -5,6 +5,7 @@
 #include <sstream>
 #include <string>
 
+#include "./fast_math_decl.hpp"
 #include "./vec3_t_decl.hpp"
 #include "./mat4_t_decl.hpp"
 #include "./quat_t_decl.hpp"
@@ -33,12 +34,13 @@ namespace math {
 ///
 /// This is a class that represents 3x3 matrices with real-valued entries. The
 /// internal data is stored as the columns of the matrix using 3d vectors of the
-/// same scalar type, thus using a column major order.
+/// same scalar type, thus using a column major order (when built with
+/// MATH3D_VEC3_PADDED each column is padded to 4 aligned entries, see Vector3).
 template <typename T>
 class Matrix3 {
  public:
-    /// Number of scalars used for the storage of this matrix
-    static constexpr uint32_t BUFFER_SIZE = 9;
+    /// Number of scalars used for the storage of this matrix (incl. padding)
+    static constexpr uint32_t BUFFER_SIZE = 3 * Vector3<T>::BUFFER_SIZE;
     /// Number of dimensions of the matrix (square 3x3 matrix)
     static constexpr uint32_t MATRIX_SIZE = 3;
     /// Number of dimensions of this matrix (as in numpy.ndarray.ndim)
@@ -179,12 +181,15 @@ class Matrix3 {
     }
 
     /// Creates a rotation matrix for the given angle around the X-axis
+    template <typename Trig = fast::StdTrig>
     static auto RotationX(T angle) -> Matrix3<T>;
 
     /// Creates a rotation matrix for the given angle around the Y-axis
+    template <typename Trig = fast::StdTrig>
     static auto RotationY(T angle) -> Matrix3<T>;
 
     /// Creates a rotation matrix for the given angle around the Z-axis
+    template <typename Trig = fast::StdTrig>
     static auto RotationZ(T angle) -> Matrix3<T>;
 
     /// Creates a scale matrix for the given separate scale arguments
@@ -215,4 +220,18 @@ class Matrix3 {
     BufferType m_Elements;
 };
 
+/// \brief Returns a pointer to the scalars of an array of 3x3 matrices
+///
+/// Same as aos_cast for arrays of Vector3, i.e. the batch kernels take the
+/// array as the entries of the matrices, each one in column-major order
+template <typename T>
+MATH3D_INLINE auto aos_cast(Matrix3<T>* mats) -> T* {
+    return reinterpret_cast<T*>(mats);  // NOLINT
+}
+
+template <typename T>
+MATH3D_INLINE auto aos_cast(const Matrix3<T>* mats) -> const T* {
+    return reinterpret_cast<const T*>(mats);  // NOLINT
+}
+
 }  // namespace math
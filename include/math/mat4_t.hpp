@@ -3,11 +3,21 @@
 #include <cmath>
 #include <iomanip>
 
+#include "./dispatch.hpp"
+#include "./fast_math.hpp"
 #include "./mat4_t_decl.hpp"
+#include "./vec3_batch_t.hpp"
 
 #include "./impl/mat4_t_scalar_impl.hpp"
 #include "./impl/mat4_t_sse_impl.hpp"
 #include "./impl/mat4_t_avx_impl.hpp"
+#include "./impl/mat4_t_avx512_impl.hpp"
+#include "./impl/mat4_t_fma_impl.hpp"
+
+#include "./impl/mat4_batch_t_scalar_impl.hpp"
+#include "./impl/mat4_batch_t_sse_impl.hpp"
+#include "./impl/mat4_batch_t_avx_impl.hpp"
+#include "./impl/mat4_batch_t_avx512_impl.hpp"
 
 #include "./quat_t.hpp"
 #include "./euler_t.hpp"
@@ -53,9 +63,10 @@ auto Matrix4<T>::setRotation(const Euler<T>& euler) -> void {
 // ***************************************************************************//
 
 template <typename T>
+template <typename Trig>
 auto Matrix4<T>::RotationX(T angle) -> Matrix4<T> {
-    auto cos_t = std::cos(angle);
-    auto sin_t = std::sin(angle);
+    T sin_t, cos_t;  // NOLINT
+    Trig::sincos(angle, sin_t, cos_t);
     // clang-format off
     return Matrix4<T>(
         1.0,   0.0,    0.0, 0.0,
@@ -66,9 +77,10 @@ auto Matrix4<T>::RotationX(T angle) -> Matrix4<T> {
 }
 
 template <typename T>
+template <typename Trig>
 auto Matrix4<T>::RotationY(T angle) -> Matrix4<T> {
-    auto cos_t = std::cos(angle);
-    auto sin_t = std::sin(angle);
+    T sin_t, cos_t;  // NOLINT
+    Trig::sincos(angle, sin_t, cos_t);
     // clang-format off
     return Matrix4<T>(
         cos_t, 0.0, sin_t, 0.0,
@@ -79,9 +91,10 @@ auto Matrix4<T>::RotationY(T angle) -> Matrix4<T> {
 }
 
 template <typename T>
+template <typename Trig>
 auto Matrix4<T>::RotationZ(T angle) -> Matrix4<T> {
-    auto cos_t = std::cos(angle);
-    auto sin_t = std::sin(angle);
+    T sin_t, cos_t;  // NOLINT
+    Trig::sincos(angle, sin_t, cos_t);
     // clang-format off
     return Matrix4<T>(
         cos_t, -sin_t, 0.0, 0.0,
@@ -125,10 +138,11 @@ auto Matrix4<T>::Translation(const Vector3<T>& position) -> Matrix4<T> {
 }
 
 template <typename T>
+template <typename Trig>
 auto Matrix4<T>::Perspective(T fov, T aspect, T near, T far) -> Matrix4<T> {
     auto tmp_0 = static_cast<T>(1.0) /
-                 std::tan((fov / static_cast<T>(2.0)) *
-                          (static_cast<T>(PI) / static_cast<T>(180.0)));
+                 Trig::tan((fov / static_cast<T>(2.0)) *
+                           (static_cast<T>(PI) / static_cast<T>(180.0)));
     auto tmp_1 = tmp_0 / aspect;
     auto tmp_2 = near - far;
     auto tmp_3 = (far + near) / tmp_2;
@@ -203,14 +217,26 @@ auto Matrix4<T>::Zeros() -> Matrix4<T> {
 template <typename T>
 MATH3D_INLINE auto transpose(const Matrix4<T>& mat) -> Matrix4<T> {
     Matrix4<T> dst = mat;
+#if defined(MATH3D_AVX_ENABLED)
+    avx::kernel_transpose_inplace_mat4<T>(dst.elements());
+#elif defined(MATH3D_SSE_ENABLED)
+    sse::kernel_transpose_inplace_mat4<T>(dst.elements());
+#else
     scalar::kernel_transpose_inplace_mat4<T>(dst.elements());
+#endif
     return dst;
 }
 
 /// \brief Transposes the given matrix in-place
 template <typename T>
 MATH3D_INLINE auto transposeInPlace(Matrix4<T>& mat) -> void {  // NOLINT
+#if defined(MATH3D_AVX_ENABLED)
+    avx::kernel_transpose_inplace_mat4<T>(mat.elements());
+#elif defined(MATH3D_SSE_ENABLED)
+    sse::kernel_transpose_inplace_mat4<T>(mat.elements());
+#else
     scalar::kernel_transpose_inplace_mat4<T>(mat.elements());
+#endif
 }
 
 /// Returns the trace (sum of diagonal elements) of the matrix
@@ -222,14 +248,67 @@ MATH3D_INLINE auto trace(const Matrix4<T>& mat) -> T {
 /// Returns the determinant of the matrix
 template <typename T>
 MATH3D_INLINE auto determinant(const Matrix4<T>& mat) -> T {
+#if defined(MATH3D_AVX_ENABLED)
+    return avx::kernel_determinant_mat4<T>(mat.elements());
+#elif defined(MATH3D_SSE_ENABLED)
+    return sse::kernel_determinant_mat4<T>(mat.elements());
+#else
     return scalar::kernel_determinant_mat4<T>(mat.elements());
+#endif
 }
 
 /// Returns the inverse of the matrix
 template <typename T>
 MATH3D_INLINE auto inverse(const Matrix4<T>& mat) -> Matrix4<T> {
     Matrix4<T> dst;
+#if defined(MATH3D_AVX_ENABLED)
+    avx::kernel_inverse_mat4<T>(dst.elements(), mat.elements());
+#elif defined(MATH3D_SSE_ENABLED)
+    sse::kernel_inverse_mat4<T>(dst.elements(), mat.elements());
+#else
     scalar::kernel_inverse_mat4<T>(dst.elements(), mat.elements());
+#endif
+    return dst;
+}
+
+/// \brief Returns the inverse of a rigid transform [R | p]
+///
+/// Computes [R^T | -R^T p] directly, which is much cheaper than the general
+/// inverse. The matrix is expected to be rigid, i.e. with an orthonormal and
+/// right-handed rotation block, and with (0, 0, 0, 1) as its last row. This is
+/// only checked in debug builds, otherwise the result is just not the inverse
+template <typename T>
+MATH3D_INLINE auto inverseRigid(const Matrix4<T>& mat) -> Matrix4<T> {
+    assert(scalar::kernel_is_rigid_mat4<T>(mat.elements(),
+                                          static_cast<T>(1e-3)));
+    Matrix4<T> dst;
+#if defined(MATH3D_AVX_ENABLED)
+    avx::kernel_inverse_rigid_mat4<T>(dst.elements(), mat.elements());
+#elif defined(MATH3D_SSE_ENABLED)
+    sse::kernel_inverse_rigid_mat4<T>(dst.elements(), mat.elements());
+#else
+    scalar::kernel_inverse_rigid_mat4<T>(dst.elements(), mat.elements());
+#endif
+    return dst;
+}
+
+/// \brief Returns the inverse of an affine transform [A | p]
+///
+/// Computes [inv(A) | -inv(A) p], inverting only the upper-left 3x3 block. The
+/// matrix is expected to have (0, 0, 0, 1) as its last row (checked only in
+/// debug builds), and its 3x3 block A to be invertible
+template <typename T>
+MATH3D_INLINE auto inverseAffine(const Matrix4<T>& mat) -> Matrix4<T> {
+    assert(scalar::kernel_is_affine_mat4<T>(mat.elements(),
+                                           static_cast<T>(1e-3)));
+    Matrix4<T> dst;
+#if defined(MATH3D_AVX_ENABLED)
+    avx::kernel_inverse_affine_mat4<T>(dst.elements(), mat.elements());
+#elif defined(MATH3D_SSE_ENABLED)
+    sse::kernel_inverse_affine_mat4<T>(dst.elements(), mat.elements());
+#else
+    scalar::kernel_inverse_affine_mat4<T>(dst.elements(), mat.elements());
+#endif
     return dst;
 }
 
@@ -238,7 +317,9 @@ template <typename T>
 MATH3D_INLINE auto operator+(const Matrix4<T>& lhs, const Matrix4<T>& rhs)
     -> Matrix4<T> {
     Matrix4<T> dst;
-#if defined(MATH3D_AVX_ENABLED)
+#if defined(MATH3D_AVX512_ENABLED)
+    avx512::kernel_add_mat4<T>(dst.elements(), lhs.elements(), rhs.elements());
+#elif defined(MATH3D_AVX_ENABLED)
     avx::kernel_add_mat4<T>(dst.elements(), lhs.elements(), rhs.elements());
 #elif defined(MATH3D_SSE_ENABLED)
     sse::kernel_add_mat4<T>(dst.elements(), lhs.elements(), rhs.elements());
@@ -253,7 +334,9 @@ template <typename T>
 MATH3D_INLINE auto operator-(const Matrix4<T>& lhs, const Matrix4<T>& rhs)
     -> Matrix4<T> {
     Matrix4<T> dst;
-#if defined(MATH3D_AVX_ENABLED)
+#if defined(MATH3D_AVX512_ENABLED)
+    avx512::kernel_sub_mat4<T>(dst.elements(), lhs.elements(), rhs.elements());
+#elif defined(MATH3D_AVX_ENABLED)
     avx::kernel_sub_mat4<T>(dst.elements(), lhs.elements(), rhs.elements());
 #elif defined(MATH3D_SSE_ENABLED)
     sse::kernel_sub_mat4<T>(dst.elements(), lhs.elements(), rhs.elements());
@@ -268,7 +351,10 @@ template <typename T>
 MATH3D_INLINE auto operator*(double scale, const Matrix4<T>& mat)
     -> Matrix4<T> {
     Matrix4<T> dst;
-#if defined(MATH3D_AVX_ENABLED)
+#if defined(MATH3D_AVX512_ENABLED)
+    avx512::kernel_scale_mat4<T>(dst.elements(), static_cast<T>(scale),
+                                 mat.elements());
+#elif defined(MATH3D_AVX_ENABLED)
     avx::kernel_scale_mat4<T>(dst.elements(), static_cast<T>(scale),
                               mat.elements());
 #elif defined(MATH3D_SSE_ENABLED)
@@ -286,7 +372,10 @@ template <typename T>
 MATH3D_INLINE auto operator*(const Matrix4<T>& mat, double scale)
     -> Matrix4<T> {
     Matrix4<T> dst;
-#if defined(MATH3D_AVX_ENABLED)
+#if defined(MATH3D_AVX512_ENABLED)
+    avx512::kernel_scale_mat4<T>(dst.elements(), static_cast<T>(scale),
+                                 mat.elements());
+#elif defined(MATH3D_AVX_ENABLED)
     avx::kernel_scale_mat4<T>(dst.elements(), static_cast<T>(scale),
                               mat.elements());
 #elif defined(MATH3D_SSE_ENABLED)
@@ -304,7 +393,12 @@ template <typename T>
 MATH3D_INLINE auto operator*(const Matrix4<T>& lhs, const Matrix4<T>& rhs)
     -> Matrix4<T> {
     Matrix4<T> dst;
-#if defined(MATH3D_AVX_ENABLED)
+#if defined(MATH3D_AVX512_ENABLED)
+    avx512::kernel_matmul_mat4<T>(dst.elements(), lhs.elements(),
+                                  rhs.elements());
+#elif defined(MATH3D_FMA_ENABLED)
+    fma3::kernel_matmul_mat4<T>(dst.elements(), lhs.elements(), rhs.elements());
+#elif defined(MATH3D_AVX_ENABLED)
     avx::kernel_matmul_mat4<T>(dst.elements(), lhs.elements(), rhs.elements());
 #elif defined(MATH3D_SSE_ENABLED)
     sse::kernel_matmul_mat4<T>(dst.elements(), lhs.elements(), rhs.elements());
@@ -320,7 +414,13 @@ template <typename T>
 MATH3D_INLINE auto operator*(const Matrix4<T>& lhs_mat,
                              const Vector4<T>& rhs_vec) -> Vector4<T> {
     Vector4<T> dst;
-#if defined(MATH3D_AVX_ENABLED)
+#if defined(MATH3D_AVX512_ENABLED)
+    avx512::kernel_matmul_vec_mat4<T>(dst.elements(), lhs_mat.elements(),
+                                      rhs_vec.elements());
+#elif defined(MATH3D_FMA_ENABLED)
+    fma3::kernel_matmul_vec_mat4<T>(dst.elements(), lhs_mat.elements(),
+                                    rhs_vec.elements());
+#elif defined(MATH3D_AVX_ENABLED)
     avx::kernel_matmul_vec_mat4<T>(dst.elements(), lhs_mat.elements(),
                                    rhs_vec.elements());
 #elif defined(MATH3D_SSE_ENABLED)
@@ -333,12 +433,102 @@ MATH3D_INLINE auto operator*(const Matrix4<T>& lhs_mat,
     return dst;
 }
 
+/// \brief Transforms an array of points by the given matrix
+///
+/// Computes dst[i] = (mat * [src[i], 1]).xyz for all the given points, using
+/// the batch kernels of the active ISA (see dispatch.hpp). Only the upper 3x4
+/// block of the matrix is used, i.e. there's no division by w, as in the case
+/// of rigid and affine transforms.
+///
+/// \tparam T Type of scalar used by the matrix and the points
+///
+/// \param[in] mat The transform to be applied to the points
+/// \param[in] src Array of points to be transformed
+/// \param[out] dst Array where to store the results (can be the same as src)
+/// \param[in] num Number of points in the arrays
+template <typename T>
+auto transformPoints(const Matrix4<T>& mat, const Vector3<T>* src,
+                     Vector3<T>* dst, size_t num) -> void {
+    MATH3D_DISPATCH_KERNEL(kernel_transform_points_vec3_aos<T>,
+                           aos_cast<T>(dst), mat.elements(), aos_cast<T>(src),
+                           num);
+}
+
+/// \brief Transforms an array of directions by the given matrix
+///
+/// Computes dst[i] = (mat * [src[i], 0]).xyz for all the given directions,
+/// i.e. only the upper 3x3 block of the matrix is applied (no translation)
+///
+/// \tparam T Type of scalar used by the matrix and the directions
+///
+/// \param[in] mat The transform to be applied to the directions
+/// \param[in] src Array of directions to be transformed
+/// \param[out] dst Array where to store the results (can be the same as src)
+/// \param[in] num Number of directions in the arrays
+template <typename T>
+auto transformDirections(const Matrix4<T>& mat, const Vector3<T>* src,
+                         Vector3<T>* dst, size_t num) -> void {
+    MATH3D_DISPATCH_KERNEL(kernel_transform_directions_vec3_aos<T>,
+                           aos_cast<T>(dst), mat.elements(), aos_cast<T>(src),
+                           num);
+}
+
+/// \brief Transforms a batch of points (SoA) by the given matrix
+///
+/// Same as the array version, but reads and writes the coordinates directly
+/// from the planes of the batches (no transposes required)
+///
+/// \param[in] mat The transform to be applied to the points
+/// \param[in] src Batch of points to be transformed
+/// \param[out] dst Batch where to store the results (resized if required)
+template <typename T>
+auto transformPoints(const Matrix4<T>& mat, const Vector3Batch<T>& src,
+                     Vector3Batch<T>& dst) -> void {  // NOLINT
+    dst.resize(src.size());
+    MATH3D_DISPATCH_KERNEL(kernel_transform_points_vec3_batch<T>, dst.planes(),
+                           mat.elements(), src.planes(), src.size());
+}
+
+/// \brief Transforms a batch of directions (SoA) by the given matrix
+///
+/// \param[in] mat The transform to be applied to the directions
+/// \param[in] src Batch of directions to be transformed
+/// \param[out] dst Batch where to store the results (resized if required)
+template <typename T>
+auto transformDirections(const Matrix4<T>& mat, const Vector3Batch<T>& src,
+                         Vector3Batch<T>& dst) -> void {  // NOLINT
+    dst.resize(src.size());
+    MATH3D_DISPATCH_KERNEL(kernel_transform_directions_vec3_batch<T>,
+                           dst.planes(), mat.elements(), src.planes(),
+                           src.size());
+}
+
+/// \brief Multiplies two arrays of matrices element-wise, dst[i] = lhs[i] *
+/// rhs[i]
+///
+/// Each product uses the same kernel as operator* (selected at compile time)
+///
+/// \param[in] lhs Array of `num` matrices (left-hand side of each product)
+/// \param[in] rhs Array of `num` matrices (right-hand side of each product)
+/// \param[out] dst Array where to store the results (can be lhs or rhs)
+/// \param[in] num Number of matrices in the arrays
+template <typename T>
+auto multiplyMatrices(const Matrix4<T>* lhs, const Matrix4<T>* rhs,
+                      Matrix4<T>* dst, size_t num) -> void {
+    for (size_t i = 0; i < num; ++i) {
+        dst[i] = lhs[i] * rhs[i];
+    }
+}
+
 /// \brief Returns the element-wise product of the two given matrices
 template <typename T>
 MATH3D_INLINE auto hadamard(const Matrix4<T>& lhs, const Matrix4<T>& rhs)
     -> Matrix4<T> {
     Matrix4<T> dst;
-#if defined(MATH3D_AVX_ENABLED)
+#if defined(MATH3D_AVX512_ENABLED)
+    avx512::kernel_hadamard_mat4<T>(dst.elements(), lhs.elements(),
+                                    rhs.elements());
+#elif defined(MATH3D_AVX_ENABLED)
     avx::kernel_hadamard_mat4<T>(dst.elements(), lhs.elements(),
                                  rhs.elements());
 #elif defined(MATH3D_SSE_ENABLED)
@@ -5,6 +5,7 @@
 #include <sstream>
 #include <string>
 
+#include "./fast_math_decl.hpp"
 #include "./vec3_t_decl.hpp"
 #include "./vec4_t_decl.hpp"
 #include "./mat3_t_decl.hpp"
@@ -205,12 +206,15 @@ class Matrix4 {
     }
 
     /// Creates a rotation matrix for the given angle around the X-axis
+    template <typename Trig = fast::StdTrig>
     static auto RotationX(T angle) -> Matrix4<T>;
 
     /// Creates a rotation matrix for the given angle around the Y-axis
+    template <typename Trig = fast::StdTrig>
     static auto RotationY(T angle) -> Matrix4<T>;
 
     /// Creates a rotation matrix for the given angle around the Z-axis
+    template <typename Trig = fast::StdTrig>
     static auto RotationZ(T angle) -> Matrix4<T>;
 
     /// Creates a scale matrix for the given separate scale arguments
@@ -223,6 +227,7 @@ class Matrix4 {
     static auto Translation(const Vector3<T>& position) -> Matrix4<T>;
 
     /// Creates a perspective projection matrix from the given configuration
+    template <typename Trig = fast::StdTrig>
     static auto Perspective(T fov, T aspect, T near, T far) -> Matrix4<T>;
 
     /// Creates a perspective projection matrix from the frustum sizes
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+#include "./aabb_batch_t.hpp"
+#include "./bitmask.hpp"
+#include "./dispatch.hpp"
+#include "./vec3_batch_t.hpp"
+#include "./utils/geometry_helpers.hpp"
+
+#include "./impl/overlap_queries_scalar_impl.hpp"
+#include "./impl/overlap_queries_sse_impl.hpp"
+#include "./impl/overlap_queries_avx_impl.hpp"
+#include "./impl/overlap_queries_avx512_impl.hpp"
+
+namespace math {
+
+// ***************************************************************************//
+//                  Overlap queries of a volume against batches               //
+// ***************************************************************************//
+
+// Each query tests a single sphere or box against a batch of points, spheres
+// or boxes (stored as SoA), with the same tests as Sphere::contains,
+// Sphere::intersects and AABB::intersects, and writes the results as a bitmask
+// (see bitmask.hpp). Use bitmaskToIndices to get the list of the elements that
+// overlap the volume.
+
+/// \brief Tests which points of a batch are inside the given sphere
+///
+/// \tparam T Type of scalar used by the sphere and the points
+///
+/// \param[in] sphere The sphere to test the points against
+/// \param[in] points The planes of the batch of points
+/// \param[in] num Number of points in the batch
+/// \param[out] inside Bitmask where to store the results (of size
+///                    bitmaskWords(num)), with the bit i set if the i-th point
+///                    is inside the sphere
+template <typename T>
+auto sphereContainsPoints(const Sphere<T>& sphere,
+                          Vector3Planes<const T> points, size_t num,
+                          uint64_t* inside) -> void {
+    MATH3D_DISPATCH_KERNEL(kernel_sphere_points<T>, inside, sphere, points,
+                           num);
+}
+
+/// \brief Returns the bitmask of the points of a batch inside the sphere
+template <typename T>
+auto sphereContainsPoints(const Sphere<T>& sphere,
+                          const Vector3Batch<T>& points)
+    -> std::vector<uint64_t> {
+    std::vector<uint64_t> inside(bitmaskWords(points.size()));
+    sphereContainsPoints<T>(sphere, points.planes(), points.size(),
+                            inside.data());
+    return inside;
+}
+
+/// \brief Tests which spheres of a batch intersect the given sphere
+///
+/// \param[in] sphere The sphere to test the batch against
+/// \param[in] centers The planes of the batch of centers of the spheres
+/// \param[in] radii Array with the radius of each sphere of the batch
+/// \param[in] num Number of spheres in the batch
+/// \param[out] overlaps Bitmask where to store the results (of size
+///                      bitmaskWords(num))
+template <typename T>
+auto sphereIntersectsSpheres(const Sphere<T>& sphere,
+                             Vector3Planes<const T> centers, const T* radii,
+                             size_t num, uint64_t* overlaps) -> void {
+    MATH3D_DISPATCH_KERNEL(kernel_sphere_spheres<T>, overlaps, sphere, centers,
+                           radii, num);
+}
+
+/// \brief Returns the bitmask of the spheres of a batch intersecting the sphere
+template <typename T>
+auto sphereIntersectsSpheres(const Sphere<T>& sphere,
+                             const Vector3Batch<T>& centers,
+                             const std::vector<T>& radii)
+    -> std::vector<uint64_t> {
+    assert(radii.size() == centers.size());
+    std::vector<uint64_t> overlaps(bitmaskWords(centers.size()));
+    sphereIntersectsSpheres<T>(sphere, centers.planes(), radii.data(),
+                               centers.size(), overlaps.data());
+    return overlaps;
+}
+
+/// \brief Tests which boxes of a batch intersect the given box
+///
+/// \param[in] box The box to test the batch against
+/// \param[in] boxes The planes of the batch of boxes
+/// \param[in] num Number of boxes in the batch
+/// \param[out] overlaps Bitmask where to store the results (of size
+///                      bitmaskWords(num))
+template <typename T>
+auto aabbIntersectsAABBs(const AABB<T>& box, AABBPlanes<const T> boxes,
+                         size_t num, uint64_t* overlaps) -> void {
+    MATH3D_DISPATCH_KERNEL(kernel_aabb_aabbs<T>, overlaps, box, boxes, num);
+}
+
+/// \brief Returns the bitmask of the boxes of a batch intersecting the box
+template <typename T>
+auto aabbIntersectsAABBs(const AABB<T>& box, const AABBBatch<T>& boxes)
+    -> std::vector<uint64_t> {
+    std::vector<uint64_t> overlaps(bitmaskWords(boxes.size()));
+    aabbIntersectsAABBs<T>(box, boxes.planes(), boxes.size(), overlaps.data());
+    return overlaps;
+}
+
+}  // namespace math
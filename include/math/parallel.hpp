@@ -0,0 +1,212 @@
+#pragma once
+
+// -----------------------------------------------------------------------------
+// Threaded execution of the batch entry points over large arrays
+//
+// The batch functions work over independent elements, so a large array can be
+// split into contiguous ranges, each one processed by the batch kernels in its
+// own thread. The number of threads is a process-wide setting (1 by default,
+// i.e. everything runs in the calling thread), which the Python bindings use
+// to split their batch calls while the GIL is released. The worker threads are
+// spawned per call and joined before returning (TransformTree also splits its
+// levels this way), which only pays off for arrays of (at least) a few
+// thousand elements per thread.
+// -----------------------------------------------------------------------------
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include "./common.hpp"
+
+namespace math {
+namespace parallel {
+
+/// Arrays with less than this many elements per thread are processed serially
+constexpr size_t MIN_ELEMENTS_PER_THREAD = 4096;
+
+namespace detail {
+
+/// Value of the num-threads slot before it's resolved (see GetNumThreads)
+constexpr size_t NUM_THREADS_UNRESOLVED = 0;
+
+/// Storage for the number of threads used by the batch calls
+inline auto NumThreadsSlot() -> std::atomic<size_t>& {
+    static std::atomic<size_t> s_num_threads{NUM_THREADS_UNRESOLVED};
+    return s_num_threads;
+}
+
+/// Returns the number of hardware threads (at least 1)
+inline auto HardwareThreads() -> size_t {
+    return std::max(static_cast<size_t>(1),
+                    static_cast<size_t>(std::thread::hardware_concurrency()));
+}
+
+/// Joins the given worker threads when going out of scope, so they are never
+/// destroyed while still joinable (e.g. if the calling thread throws)
+class ThreadsJoiner {
+ public:
+    explicit ThreadsJoiner(std::vector<std::thread>& threads)
+        : m_Threads(threads) {}
+
+    ThreadsJoiner(const ThreadsJoiner& other) = delete;
+
+    ThreadsJoiner(ThreadsJoiner&& other) = delete;
+
+    auto operator=(const ThreadsJoiner& rhs) -> ThreadsJoiner& = delete;
+
+    auto operator=(ThreadsJoiner&& rhs) -> ThreadsJoiner& = delete;
+
+    ~ThreadsJoiner() {
+        for (auto& thread : m_Threads) {
+            if (thread.joinable()) {
+                thread.join();
+            }
+        }
+    }
+
+ private:
+    /// The worker threads to be joined
+    std::vector<std::thread>& m_Threads;
+};
+
+}  // namespace detail
+
+/// Returns the max. number of threads the batch calls are split across
+///
+/// The first call resolves it to 1, unless the environment variable
+/// `MATH3D_NUM_THREADS` requests more ("0" requests one per hardware thread)
+inline auto GetNumThreads() -> size_t {
+    auto& slot = detail::NumThreadsSlot();
+    const auto num_threads = slot.load(std::memory_order_relaxed);
+    if (num_threads != detail::NUM_THREADS_UNRESOLVED) {
+        return num_threads;
+    }
+
+    size_t resolved = 1;
+#if defined(_MSC_VER)
+#pragma warning(push)
+#pragma warning(disable : 4996)
+#endif
+    const char* env_threads = std::getenv("MATH3D_NUM_THREADS");  // NOLINT
+#if defined(_MSC_VER)
+#pragma warning(pop)
+#endif
+    if (env_threads != nullptr && *env_threads != '\0') {
+        char* end = nullptr;
+        const auto requested = std::strtoul(env_threads, &end, 10);
+        if (end != nullptr && *end == '\0') {
+            resolved = (requested == 0) ? detail::HardwareThreads()
+                                        : static_cast<size_t>(requested);
+        }
+    }
+
+    size_t expected = detail::NUM_THREADS_UNRESOLVED;
+    slot.compare_exchange_strong(expected, resolved,
+                                 std::memory_order_relaxed);
+    return slot.load(std::memory_order_relaxed);
+}
+
+/// Sets the max. number of threads the batch calls are split across
+///
+/// \param[in] num_threads Number of threads (0 uses one per hardware thread)
+inline auto SetNumThreads(size_t num_threads) -> void {
+    detail::NumThreadsSlot().store(
+        (num_threads == 0) ? detail::HardwareThreads() : num_threads,
+        std::memory_order_relaxed);
+}
+
+/// \brief Runs fn(begin, end) over contiguous ranges that cover [0, num)
+///
+/// The ranges are split across up to `num_threads` threads, one range per
+/// thread (the calling thread runs the first one), and this call returns once
+/// all of them are done. The function must be safe to run concurrently over
+/// disjoint ranges, e.g. a batch function over the elements of the range. If
+/// a worker thread can't be created, the calling thread runs the remaining
+/// ranges itself, and if fn throws in the calling thread the workers are
+/// joined before the exception propagates.
+///
+/// \param[in] num_threads Max. number of threads to split the ranges across
+/// \param[in] num Number of elements to process
+/// \param[in] fn Function that processes the elements in [begin, end)
+/// \param[in] min_per_thread Min. number of elements given to each thread
+/// \param[in] grain Ranges start at multiples of this many elements
+template <typename Fn>
+auto ParallelForThreads(size_t num_threads, size_t num, Fn fn,
+                        size_t min_per_thread = MIN_ELEMENTS_PER_THREAD,
+                        size_t grain = 1) -> void {
+    grain = std::max(grain, static_cast<size_t>(1));
+    const size_t num_workers = std::max(
+        static_cast<size_t>(1),
+        std::min(num_threads,
+                 num / std::max(min_per_thread, static_cast<size_t>(1))));
+    if (num_workers == 1) {
+        fn(static_cast<size_t>(0), num);
+        return;
+    }
+    // Round the ranges up to whole grains, so the last one might be shorter
+    const size_t per_worker = (num + num_workers - 1) / num_workers;
+    const size_t chunk = ((per_worker + grain - 1) / grain) * grain;
+    std::vector<std::thread> workers;
+    workers.reserve(num_workers - 1);
+    detail::ThreadsJoiner joiner(workers);
+    size_t start = chunk;
+    for (; start < num; start += chunk) {
+        try {
+            workers.emplace_back(fn, start, std::min(start + chunk, num));
+        } catch (const std::system_error&) {
+            // Out of threads, so the ranges left are run below serially
+            break;
+        }
+    }
+    fn(static_cast<size_t>(0), std::min(chunk, num));
+    for (; start < num; start += chunk) {
+        fn(start, std::min(start + chunk, num));
+    }
+}
+
+/// \brief Runs fn(begin, end) over contiguous ranges that cover [0, num)
+///
+/// Same as ParallelForThreads, split across up to GetNumThreads() threads
+template <typename Fn>
+auto ParallelFor(size_t num, Fn fn,
+                 size_t min_per_thread = MIN_ELEMENTS_PER_THREAD,
+                 size_t grain = 1) -> void {
+    ParallelForThreads(GetNumThreads(), num, fn, min_per_thread, grain);
+}
+
+/// \class ScopedNumThreads
+///
+/// \brief Sets the number of threads for the lifetime of this object
+class ScopedNumThreads {
+ public:
+    /// Sets the given number of threads (0 uses one per hardware thread)
+    explicit ScopedNumThreads(size_t num_threads)
+        : m_Previous(detail::NumThreadsSlot().load(std::memory_order_relaxed)) {
+        SetNumThreads(num_threads);
+    }
+
+    ScopedNumThreads(const ScopedNumThreads& other) = delete;
+
+    ScopedNumThreads(ScopedNumThreads&& other) = delete;
+
+    auto operator=(const ScopedNumThreads& rhs) -> ScopedNumThreads& = delete;
+
+    auto operator=(ScopedNumThreads&& rhs) -> ScopedNumThreads& = delete;
+
+    /// Restores the number of threads used before this guard was created
+    ~ScopedNumThreads() {
+        detail::NumThreadsSlot().store(m_Previous, std::memory_order_relaxed);
+    }
+
+ private:
+    /// The value of the num-threads slot when this guard was created
+    size_t m_Previous = detail::NUM_THREADS_UNRESOLVED;
+};
+
+}  // namespace parallel
+}  // namespace math
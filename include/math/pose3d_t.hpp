@@ -8,6 +8,11 @@
 #include "./quat_t.hpp"
 #include "./mat4_t.hpp"
 
+#include "./impl/pose3d_batch_t_scalar_impl.hpp"
+#include "./impl/pose3d_batch_t_sse_impl.hpp"
+#include "./impl/pose3d_batch_t_avx_impl.hpp"
+#include "./impl/pose3d_batch_t_avx512_impl.hpp"
+
 namespace math {
 
 template <typename T>
@@ -42,6 +47,18 @@ auto Pose3d<T>::apply(const Vec3& rhs) const -> Vec3 {
     return this->position + this->orientation.rotate(rhs);
 }
 
+template <typename T>
+auto Pose3d<T>::apply(const Vec3* src, Vec3* dst, size_t num) const -> void {
+    // Build the equivalent 3x4 transform once, and run the batch kernels
+    typename Mat4::BufferType transform;
+    scalar::kernel_rotation_mat4_quat<T>(transform,
+                                         this->orientation.elements());
+    transform[3] = Vec4(this->position.x(), this->position.y(),
+                        this->position.z(), static_cast<T>(1.0));
+    MATH3D_DISPATCH_KERNEL(kernel_transform_points_vec3_aos<T>,
+                           aos_cast<T>(dst), transform, aos_cast<T>(src), num);
+}
+
 template <typename T>
 auto Pose3d<T>::inverse() const -> Pose3d<T> {
     // Inverse transform in matrix form:
@@ -69,9 +86,11 @@ auto Pose3d<T>::toMatrix() const -> Mat4 {
 
 template <typename T>
 auto Pose3d<T>::operator*(const Pose3d<T>& rhs) const -> Pose3d<T> {
-    auto res_orientation = (this->orientation * rhs.orientation).normalized();
-    auto res_position = this->position + this->orientation.rotate(rhs.position);
-    return Pose3d<T>(res_position, res_orientation);
+    // Set the members directly, as the constructor would normalize it again
+    Pose3d<T> result;
+    result.position = this->position + this->orientation.rotate(rhs.position);
+    result.orientation = (this->orientation * rhs.orientation).normalized();
+    return result;
 }
 
 template <typename T>
@@ -79,4 +98,42 @@ auto Pose3d<T>::operator*(const Vec3& rhs) const -> Vec3 {
     return this->apply(rhs);
 }
 
+// ***************************************************************************//
+//                       Batch operations over arrays of poses                //
+// ***************************************************************************//
+
+/// \brief Composes two arrays of poses element-wise, dst[i] = lhs[i] * rhs[i]
+///
+/// \param lhs Array of `num` poses (left-hand side of each composition)
+/// \param rhs Array of `num` poses (right-hand side of each composition)
+/// \param dst Array of `num` poses to store the results (can be lhs or rhs)
+/// \param num Number of poses to compose
+/// \param renormalize Whether to renormalize the composed orientations
+///
+/// The composition of two unit quaternions is a unit quaternion up to rounding
+/// errors, which only build up when the results are composed again, e.g. when
+/// propagating poses down a kinematic chain, or from one step to the next. So
+/// renormalizing the orientations (a sqrt and a division each) can be skipped
+/// in most of those calls, and it's up to the caller to decide in which ones,
+/// e.g. only once every k steps of an integration loop. With `renormalize`
+/// set (the default) the results are the same as with operator*. The
+/// orientations of the inputs are assumed to be unit quaternions
+template <typename T>
+auto composePoses(const Pose3d<T>* lhs, const Pose3d<T>* rhs, Pose3d<T>* dst,
+                  size_t num, bool renormalize = true) -> void {
+    MATH3D_DISPATCH_KERNEL(kernel_compose_poses_aos<T>, aos_cast<T>(dst),
+                           aos_cast<T>(lhs), aos_cast<T>(rhs), num,
+                           renormalize);
+}
+
+/// \brief Inverts an array of poses element-wise, dst[i] = src[i].inverse()
+///
+/// The orientations are assumed to be unit quaternions, so their inverse is
+/// just their conjugate (`dst` can be `src`)
+template <typename T>
+auto invertPoses(const Pose3d<T>* src, Pose3d<T>* dst, size_t num) -> void {
+    MATH3D_DISPATCH_KERNEL(kernel_invert_poses_aos<T>, aos_cast<T>(dst),
+                           aos_cast<T>(src), num);
+}
+
 }  // namespace math
@@ -51,6 +51,9 @@ class Pose3d {
     /// Transforms the given vector by using this pose
     MATH3D_INLINE auto apply(const Vec3& rhs) const -> Vec3;
 
+    /// Transforms an array of vectors by using this pose (`dst` can be `src`)
+    auto apply(const Vec3* src, Vec3* dst, size_t num) const -> void;
+
     /// Returns the inverse of this pose
     MATH3D_INLINE auto inverse() const -> Pose3d<T>;
 
@@ -72,4 +75,19 @@ class Pose3d {
     }
 };
 
+/// \brief Returns a pointer to the scalars of an array of poses
+///
+/// Same as aos_cast for arrays of Vector3: each pose is stored as its position
+/// followed by its orientation (w, x, y, z), and the batch kernels take the
+/// array of poses as an array of scalars with that layout
+template <typename T>
+MATH3D_INLINE auto aos_cast(Pose3d<T>* poses) -> T* {
+    return reinterpret_cast<T*>(poses);  // NOLINT
+}
+
+template <typename T>
+MATH3D_INLINE auto aos_cast(const Pose3d<T>* poses) -> const T* {
+    return reinterpret_cast<const T*>(poses);  // NOLINT
+}
+
 }  // namespace math
@@ -1,13 +1,27 @@
 #pragma once
 
+#include <algorithm>
 #include <cmath>
+#include <limits>
 
+#include "./dispatch.hpp"
+#include "./fast_math.hpp"
 #include "./quat_t_decl.hpp"
+#include "./vec3_batch_t.hpp"
 
 #include "./impl/quat_t_scalar_impl.hpp"
 #include "./impl/quat_t_sse_impl.hpp"
 #include "./impl/quat_t_avx_impl.hpp"
 
+#include "./impl/mat4_batch_t_scalar_impl.hpp"
+#include "./impl/mat4_batch_t_sse_impl.hpp"
+#include "./impl/mat4_batch_t_avx_impl.hpp"
+#include "./impl/mat4_batch_t_avx512_impl.hpp"
+#include "./impl/quat_batch_t_scalar_impl.hpp"
+#include "./impl/quat_batch_t_sse_impl.hpp"
+#include "./impl/quat_batch_t_avx_impl.hpp"
+#include "./impl/quat_batch_t_avx512_impl.hpp"
+
 #include "./vec3_t.hpp"
 #include "./euler_t.hpp"
 
@@ -133,8 +147,16 @@ template <typename T>
 MATH3D_INLINE auto operator*(const Quaternion<T>& lhs, const Quaternion<T>& rhs)
     -> Quaternion<T> {
     Quaternion<T> dst;
+#if defined(MATH3D_AVX_ENABLED)
+    avx::kernel_quatmul_quat<T>(dst.elements(), lhs.elements(),
+                                rhs.elements());
+#elif defined(MATH3D_SSE_ENABLED)
+    sse::kernel_quatmul_quat<T>(dst.elements(), lhs.elements(),
+                                rhs.elements());
+#else
     scalar::kernel_quatmul_quat<T>(dst.elements(), lhs.elements(),
                                    rhs.elements());
+#endif
     return dst;
 }
 
@@ -155,15 +177,52 @@ MATH3D_INLINE auto inverse(const Quaternion<T>& quat) -> Quaternion<T> {
     return q_inv;
 }
 
+/// Returns the given vector rotated by the given quaternion, i.e. q * p * q^-1
 template <typename T>
 MATH3D_INLINE auto rotate(const Quaternion<T>& quat, const Vector3<T>& vec)
     -> Vector3<T> {
-    // We use the form f(p) = q * p * q ^-1
-    Quaternion<T> quat_p(static_cast<T>(0.0), vec.x(), vec.y(), vec.z());
-    auto quat_qinv = inverse(quat);
-    auto quat_qp = quat * quat_p;
-    auto quat_qpqinv = quat_qp * quat_qinv;
-    return Vector3<T>(quat_qpqinv.x(), quat_qpqinv.y(), quat_qpqinv.z());
+    Vector3<T> dst;
+#if defined(MATH3D_AVX_ENABLED)
+    avx::kernel_rotate_vec3_quat<T>(dst.elements(), quat.elements(),
+                                    vec.elements());
+#elif defined(MATH3D_SSE_ENABLED)
+    sse::kernel_rotate_vec3_quat<T>(dst.elements(), quat.elements(),
+                                    vec.elements());
+#else
+    scalar::kernel_rotate_vec3_quat<T>(dst.elements(), quat.elements(),
+                                       vec.elements());
+#endif
+    return dst;
+}
+
+/// Rotates an array of 3d vectors by the given quaternion
+///
+/// \param[in] quat The quaternion representing the rotation
+/// \param[in] src Pointer to the array of vectors to be rotated
+/// \param[out] dst Pointer to the array where to store the results (can be
+///                 the same as `src`)
+/// \param[in] num The number of vectors in both arrays
+///
+/// The quaternion is converted once into a rotation matrix, and the vectors
+/// are then rotated using the batch kernels selected at runtime
+template <typename T>
+auto rotate(const Quaternion<T>& quat, const Vector3<T>* src, Vector3<T>* dst,
+            size_t num) -> void {
+    typename Matrix4<T>::BufferType rotation;
+    scalar::kernel_rotation_mat4_quat<T>(rotation, quat.elements());
+    MATH3D_DISPATCH_KERNEL(kernel_transform_directions_vec3_aos<T>,
+                           aos_cast<T>(dst), rotation, aos_cast<T>(src), num);
+}
+
+/// Rotates a batch of 3d vectors by the given quaternion (resizes `dst`)
+template <typename T>
+auto rotate(const Quaternion<T>& quat, const Vector3Batch<T>& src,
+            Vector3Batch<T>& dst) -> void {  // NOLINT
+    typename Matrix4<T>::BufferType rotation;
+    scalar::kernel_rotation_mat4_quat<T>(rotation, quat.elements());
+    dst.resize(src.size());
+    MATH3D_DISPATCH_KERNEL(kernel_transform_directions_vec3_batch<T>,
+                           dst.planes(), rotation, src.planes(), src.size());
 }
 
 template <typename T>
@@ -184,6 +243,158 @@ MATH3D_INLINE auto operator!=(const Quaternion<T>& lhs,
     return !scalar::kernel_compare_eq_quat<T>(lhs.elements(), rhs.elements());
 }
 
+// ***************************************************************************//
+//                          Quaternion interpolation                          //
+// ***************************************************************************//
+
+/// Returns the dot product of the given quaternions (seen as 4d vectors)
+template <typename T>
+MATH3D_INLINE auto dot(const Quaternion<T>& lhs, const Quaternion<T>& rhs)
+    -> T {
+    return lhs.w() * rhs.w() + lhs.x() * rhs.x() + lhs.y() * rhs.y() +
+           lhs.z() * rhs.z();
+}
+
+/// \brief Returns the normalized linear interpolation between two quaternions
+///
+/// Cheaper than slerp, and follows the same (shortest) path, but not at a
+/// constant angular velocity
+///
+/// \param[in] q_a Quaternion at the start of the interpolation (alpha = 0)
+/// \param[in] q_b Quaternion at the end of the interpolation (alpha = 1)
+/// \param[in] alpha Interpolation parameter
+template <typename T>
+auto nlerp(const Quaternion<T>& q_a, const Quaternion<T>& q_b, T alpha)
+    -> Quaternion<T> {
+    // Take the shortest path, i.e. use -q_b (same rotation) if required
+    const T w_a = static_cast<T>(1.0) - alpha;
+    const T w_b = (dot<T>(q_a, q_b) < static_cast<T>(0.0)) ? -alpha : alpha;
+    Quaternion<T> dst(w_a * q_a.w() + w_b * q_b.w(),
+                      w_a * q_a.x() + w_b * q_b.x(),
+                      w_a * q_a.y() + w_b * q_b.y(),
+                      w_a * q_a.z() + w_b * q_b.z());
+    dst.normalize();
+    return dst;
+}
+
+/// \brief Returns the spherical linear interpolation between two unit
+/// quaternions, along the shortest path
+///
+/// To get many samples between the same two quaternions use SlerpInterpolator
+/// instead, which computes the angle between both only once
+///
+/// \param[in] q_a Quaternion at the start of the interpolation (alpha = 0)
+/// \param[in] q_b Quaternion at the end of the interpolation (alpha = 1)
+/// \param[in] alpha Interpolation parameter
+template <typename T>
+auto slerp(const Quaternion<T>& q_a, const Quaternion<T>& q_b, T alpha)
+    -> Quaternion<T> {
+    return SlerpInterpolator<T>(q_a, q_b)(alpha);
+}
+
+/// \brief Interpolates with slerp each pair of unit quaternions of two arrays
+///
+/// The kernels (selected at runtime) use polynomial approximations of acos and
+/// sin, so for alpha in [0, 1] the results are within 2e-8 of the exact slerp
+/// for float64, and ~3e-7 for float32 (see quat_batch_t_scalar_impl.hpp)
+///
+/// \param[in] q_a Array of quaternions at the start of the interpolation
+/// \param[in] q_b Array of quaternions at the end of the interpolation
+/// \param[in] alpha Interpolation parameter, shared by all pairs
+/// \param[out] dst Array where to store the results (can alias q_a or q_b)
+/// \param[in] num Number of quaternions in each of the arrays
+template <typename T>
+auto slerp(const Quaternion<T>* q_a, const Quaternion<T>* q_b, T alpha,
+           Quaternion<T>* dst, size_t num) -> void {
+    MATH3D_DISPATCH_KERNEL(kernel_slerp_quat_aos<T>, aos_cast<T>(dst),
+                           aos_cast<T>(q_a), aos_cast<T>(q_b), &alpha, 0, num);
+}
+
+/// \brief Interpolates with slerp each pair of unit quaternions of two arrays,
+/// using the interpolation parameter given for each pair in `alpha`
+template <typename T>
+auto slerp(const Quaternion<T>* q_a, const Quaternion<T>* q_b, const T* alpha,
+           Quaternion<T>* dst, size_t num) -> void {
+    MATH3D_DISPATCH_KERNEL(kernel_slerp_quat_aos<T>, aos_cast<T>(dst),
+                           aos_cast<T>(q_a), aos_cast<T>(q_b), alpha, 1, num);
+}
+
+/// \brief Interpolates with nlerp each pair of quaternions of two arrays
+///
+/// \param[in] q_a Array of quaternions at the start of the interpolation
+/// \param[in] q_b Array of quaternions at the end of the interpolation
+/// \param[in] alpha Interpolation parameter, shared by all pairs
+/// \param[out] dst Array where to store the results (can alias q_a or q_b)
+/// \param[in] num Number of quaternions in each of the arrays
+template <typename T>
+auto nlerp(const Quaternion<T>* q_a, const Quaternion<T>* q_b, T alpha,
+           Quaternion<T>* dst, size_t num) -> void {
+    MATH3D_DISPATCH_KERNEL(kernel_nlerp_quat_aos<T>, aos_cast<T>(dst),
+                           aos_cast<T>(q_a), aos_cast<T>(q_b), &alpha, 0, num);
+}
+
+/// \brief Interpolates with nlerp each pair of quaternions of two arrays,
+/// using the interpolation parameter given for each pair in `alpha`
+template <typename T>
+auto nlerp(const Quaternion<T>* q_a, const Quaternion<T>* q_b, const T* alpha,
+           Quaternion<T>* dst, size_t num) -> void {
+    MATH3D_DISPATCH_KERNEL(kernel_nlerp_quat_aos<T>, aos_cast<T>(dst),
+                           aos_cast<T>(q_a), aos_cast<T>(q_b), alpha, 1, num);
+}
+
+// ***************************************************************************//
+//                     Conversions over arrays of rotations                   //
+// ***************************************************************************//
+
+/// \brief Converts an array of (intrinsic) Euler angles into quaternions
+///
+/// \param[in] angles Array of the Euler angles, each given as (x, y, z)
+/// \param[in] order Order of the elemental rotations (same for every angle)
+/// \param[out] dst Array where to store the quaternions
+/// \param[in] num Number of sets of angles in the array
+/// \param[in] accuracy Accuracy of the sines and cosines (see fast_math.hpp)
+///
+/// Gives the same results as Quaternion::setFromEuler (up to rounding), but
+/// the order is only resolved once for the whole array, and the kernels
+/// (selected at runtime) use the fast sincos over whole registers of angles
+/// (see note 6 of quat_batch_t_scalar_impl.hpp)
+template <typename T>
+auto quaternionsFromEuler(const Vector3<T>* angles, euler::Order order,
+                          Quaternion<T>* dst, size_t num,
+                          fast::Accuracy accuracy = fast::Accuracy::FULL)
+    -> void {
+    MATH3D_DISPATCH_KERNEL(kernel_quat_from_euler_aos<T>, aos_cast<T>(dst),
+                           aos_cast<T>(angles), order, num, accuracy);
+}
+
+/// \brief Converts an array of rotation matrices into quaternions
+///
+/// \param[in] mats Array of 3x3 rotation matrices
+/// \param[out] dst Array where to store the quaternions
+/// \param[in] num Number of matrices in the array
+///
+/// Same results as Quaternion::setFromRotationMatrix (up to rounding), but the
+/// kernels (selected at runtime) have no branches, so the SIMD ones convert a
+/// whole register of matrices at once
+template <typename T>
+auto quaternionsFromRotationMatrices(const Matrix3<T>* mats, Quaternion<T>* dst,
+                                     size_t num) -> void {
+    MATH3D_DISPATCH_KERNEL(kernel_quat_from_mat3_aos<T>, aos_cast<T>(dst),
+                           aos_cast<T>(mats), num);
+}
+
+/// \brief Converts an array of quaternions into rotation matrices
+///
+/// \param[in] quats Array of quaternions (don't need to be normalized)
+/// \param[out] dst Array where to store the 3x3 rotation matrices
+/// \param[in] num Number of quaternions in the array
+template <typename T>
+auto rotationMatricesFromQuaternions(const Quaternion<T>* quats,
+                                     Matrix3<T>* dst, size_t num) -> void {
+    MATH3D_DISPATCH_KERNEL(kernel_mat3_from_quat_aos<T>, aos_cast<T>(dst),
+                           aos_cast<T>(quats), num);
+}
+
 // ***************************************************************************//
 //                         Quaternion-type methods                            //
 // ***************************************************************************//
@@ -248,74 +459,32 @@ auto Quaternion<T>::setFromTransform(const Mat4& m) -> void {
 }
 
 template <typename T>
+template <typename Trig>
 auto Quaternion<T>::setFromEuler(const Euler<T>& euler) -> void {
     constexpr auto HALF = static_cast<T>(0.5);
-    auto c1 = std::cos(HALF * euler.x);
-    auto c2 = std::cos(HALF * euler.y);
-    auto c3 = std::cos(HALF * euler.z);
-
-    auto s1 = std::sin(HALF * euler.x);
-    auto s2 = std::sin(HALF * euler.y);
-    auto s3 = std::sin(HALF * euler.z);
-
-    // TODO(wilbert): Check that YXZ conversion is correct
-
-    switch (euler.order) {
-        case euler::Order::XYZ: {
-            m_Elements[1] = s1 * c2 * c3 + c1 * s2 * s3;
-            m_Elements[2] = c1 * s2 * c3 - s1 * c2 * s3;
-            m_Elements[3] = c1 * c2 * s3 + s1 * s2 * c3;
-            m_Elements[0] = c1 * c2 * c3 - s1 * s2 * s3;
-            break;
-        }
-        case euler::Order::YXZ: {
-            m_Elements[1] = s1 * c2 * c3 + c1 * s2 * s3;
-            m_Elements[2] = c1 * s2 * c3 - s1 * c2 * s3;
-            m_Elements[3] = c1 * c2 * s3 - s1 * s2 * c3;
-            m_Elements[0] = c1 * c2 * c3 + s1 * s2 * s3;
-            break;
-        }
-        case euler::Order::ZXY: {
-            m_Elements[1] = s1 * c2 * c3 - c1 * s2 * s3;
-            m_Elements[2] = c1 * s2 * c3 + s1 * c2 * s3;
-            m_Elements[3] = c1 * c2 * s3 + s1 * s2 * c3;
-            m_Elements[0] = c1 * c2 * c3 - s1 * s2 * s3;
-            break;
-        }
-        case euler::Order::ZYX: {
-            m_Elements[1] = s1 * c2 * c3 - c1 * s2 * s3;
-            m_Elements[2] = c1 * s2 * c3 + s1 * c2 * s3;
-            m_Elements[3] = c1 * c2 * s3 - s1 * s2 * c3;
-            m_Elements[0] = c1 * c2 * c3 + s1 * s2 * s3;
-            break;
-        }
-        case euler::Order::YZX: {
-            m_Elements[1] = s1 * c2 * c3 + c1 * s2 * s3;
-            m_Elements[2] = c1 * s2 * c3 + s1 * c2 * s3;
-            m_Elements[3] = c1 * c2 * s3 - s1 * s2 * c3;
-            m_Elements[0] = c1 * c2 * c3 - s1 * s2 * s3;
-            break;
-        }
-        case euler::Order::XZY: {
-            m_Elements[1] = s1 * c2 * c3 - c1 * s2 * s3;
-            m_Elements[2] = c1 * s2 * c3 - s1 * c2 * s3;
-            m_Elements[3] = c1 * c2 * s3 + s1 * s2 * c3;
-            m_Elements[0] = c1 * c2 * c3 + s1 * s2 * s3;
-            break;
-        }
-        default:
-            break;
-    }
+    T s1, s2, s3, c1, c2, c3;  // NOLINT
+    Trig::sincos(HALF * euler.x, s1, c1);
+    Trig::sincos(HALF * euler.y, s2, c2);
+    Trig::sincos(HALF * euler.z, s3, c3);
+
+    // The order only changes the signs of the second products (see note 4 of
+    // quat_batch_t_scalar_impl.hpp)
+    const auto signs = scalar::euler_quat_signs<T>(euler.order);
+    m_Elements[0] = c1 * c2 * c3 + signs[0] * (s1 * s2 * s3);
+    m_Elements[1] = s1 * c2 * c3 + signs[1] * (c1 * s2 * s3);
+    m_Elements[2] = c1 * s2 * c3 + signs[2] * (s1 * c2 * s3);
+    m_Elements[3] = c1 * c2 * s3 + signs[3] * (s1 * s2 * c3);
 }
 
 template <typename T>
+template <typename Trig>
 auto Quaternion<T>::setFromAxisAngle(const Vec3& axis, T angle) -> void {
     // Just in case, make sure the axis is normalized
     auto axis_n = axis.normalized();
 
     constexpr auto HALF = static_cast<T>(0.5);
-    auto cos_half = std::cos(HALF * angle);
-    auto sin_half = std::sin(HALF * angle);
+    T sin_half, cos_half;  // NOLINT
+    Trig::sincos(HALF * angle, sin_half, cos_half);
     m_Elements[0] = cos_half;               // w
     m_Elements[1] = sin_half * axis_n.x();  // x
     m_Elements[2] = sin_half * axis_n.y();  // y
@@ -358,24 +527,70 @@ auto Quaternion<T>::length() const -> T {
 }
 
 template <typename T>
+template <typename Trig>
 auto Quaternion<T>::RotationX(T angle) -> Quaternion<T> {
-    auto cos_half = std::cos(angle / static_cast<T>(2.0));
-    auto sin_half = std::sin(angle / static_cast<T>(2.0));
+    T sin_half, cos_half;  // NOLINT
+    Trig::sincos(angle / static_cast<T>(2.0), sin_half, cos_half);
     return Quaternion<T>(cos_half, sin_half, 0, 0);
 }
 
 template <typename T>
+template <typename Trig>
 auto Quaternion<T>::RotationY(T angle) -> Quaternion<T> {
-    auto cos_half = std::cos(angle / static_cast<T>(2.0));
-    auto sin_half = std::sin(angle / static_cast<T>(2.0));
+    T sin_half, cos_half;  // NOLINT
+    Trig::sincos(angle / static_cast<T>(2.0), sin_half, cos_half);
     return Quaternion<T>(cos_half, 0, sin_half, 0);
 }
 
 template <typename T>
+template <typename Trig>
 auto Quaternion<T>::RotationZ(T angle) -> Quaternion<T> {
-    auto cos_half = std::cos(angle / static_cast<T>(2.0));
-    auto sin_half = std::sin(angle / static_cast<T>(2.0));
+    T sin_half, cos_half;  // NOLINT
+    Trig::sincos(angle / static_cast<T>(2.0), sin_half, cos_half);
     return Quaternion<T>(cos_half, 0, 0, sin_half);
 }
 
+// ***************************************************************************//
+//                       SlerpInterpolator-type methods                       //
+// ***************************************************************************//
+
+template <typename T>
+SlerpInterpolator<T>::SlerpInterpolator(const Quat& q_start, const Quat& q_end)
+    : m_Start(q_start), m_End(q_end) {
+    auto cos_angle = dot<T>(q_start, q_end);
+    // Take the shortest path, i.e. use -q_end (same rotation) if required
+    if (cos_angle < static_cast<T>(0.0)) {
+        m_End = Quat(-q_end.w(), -q_end.x(), -q_end.y(), -q_end.z());
+        cos_angle = -cos_angle;
+    }
+    m_Angle = std::acos(std::min(cos_angle, static_cast<T>(1.0)));
+    const auto sin_angle = std::sin(m_Angle);
+    // If both are (almost) the same the interpolation falls back to a lerp
+    if (sin_angle > std::numeric_limits<T>::epsilon()) {
+        m_InvSinAngle = static_cast<T>(1.0) / sin_angle;
+    }
+}
+
+template <typename T>
+auto SlerpInterpolator<T>::operator()(T alpha) const -> Quat {
+    T w_a = static_cast<T>(1.0) - alpha;
+    T w_b = alpha;
+    if (m_InvSinAngle > static_cast<T>(0.0)) {
+        w_a = std::sin(w_a * m_Angle) * m_InvSinAngle;
+        w_b = std::sin(w_b * m_Angle) * m_InvSinAngle;
+    }
+    return Quat(w_a * m_Start.w() + w_b * m_End.w(),
+                w_a * m_Start.x() + w_b * m_End.x(),
+                w_a * m_Start.y() + w_b * m_End.y(),
+                w_a * m_Start.z() + w_b * m_End.z());
+}
+
+template <typename T>
+auto SlerpInterpolator<T>::operator()(const T* alphas, Quat* dst,
+                                      size_t num) const -> void {
+    for (size_t i = 0; i < num; ++i) {
+        dst[i] = (*this)(alphas[i]);
+    }
+}
+
 }  // namespace math
@@ -9,6 +9,7 @@
 #include <algorithm>
 #include <type_traits>
 
+#include "./fast_math_decl.hpp"
 #include "./vec3_t_decl.hpp"
 #include "./mat3_t_decl.hpp"
 #include "./mat4_t_decl.hpp"
@@ -110,9 +111,14 @@ class Quaternion {
     auto setFromTransform(const Mat4& transform) -> void;
 
     /// \brief Updates this quaternion with a given set of Euler angles
+    ///
+    /// The trigonometric functions are the ones of the `Trig` policy, i.e.
+    /// fast::StdTrig (<cmath>) by default, or fast::FastTrig<accuracy>
+    template <typename Trig = fast::StdTrig>
     auto setFromEuler(const Euler<T>& euler) -> void;
 
     /// \brief Updates this quaternion with a given axes-angle pair
+    template <typename Trig = fast::StdTrig>
     auto setFromAxisAngle(const Vec3& axis, T angle) -> void;
 
     /// \brief Returns the conjugate of this quaternion
@@ -197,12 +203,15 @@ class Quaternion {
     }
 
     /// Returns the quaternion associated with the given rotation around x-axis
+    template <typename Trig = fast::StdTrig>
     static auto RotationX(T angle) -> Quaternion<T>;
 
     /// Returns the quaternion associated with the given rotation around y-axis
+    template <typename Trig = fast::StdTrig>
     static auto RotationY(T angle) -> Quaternion<T>;
 
     /// Returns the quaternion associated with the given rotation around z-axis
+    template <typename Trig = fast::StdTrig>
     static auto RotationZ(T angle) -> Quaternion<T>;
 
  private:
@@ -210,4 +219,56 @@ class Quaternion {
     BufferType m_Elements = {1, 0, 0, 0};
 };
 
+/// \brief Returns a pointer to the scalars of an array of quaternions
+///
+/// Same as aos_cast for arrays of Vector3, i.e. the batch kernels take the
+/// array as the interleaved entries of the quaternions (w0 x0 y0 z0 w1 ...)
+template <typename T>
+MATH3D_INLINE auto aos_cast(Quaternion<T>* quats) -> T* {
+    return reinterpret_cast<T*>(quats);  // NOLINT
+}
+
+template <typename T>
+MATH3D_INLINE auto aos_cast(const Quaternion<T>* quats) -> const T* {
+    return reinterpret_cast<const T*>(quats);  // NOLINT
+}
+
+/// \class SlerpInterpolator
+///
+/// \brief Spherical linear interpolation between two fixed unit quaternions
+///
+/// The angle between both quaternions (along the shortest path) and its sine
+/// are computed once at construction, so each sample (e.g. the frames between
+/// two keyframes of an animation) only takes two sines and a few products
+///
+/// \tparam T Type of scalar used by the quaternions
+template <typename T>
+class SlerpInterpolator {
+ public:
+    using Quat = Quaternion<T>;
+
+    /// Interpolates from `q_start` (alpha = 0) to `q_end` (alpha = 1)
+    SlerpInterpolator(const Quat& q_start, const Quat& q_end);
+
+    /// Returns the interpolated quaternion at the given alpha
+    auto operator()(T alpha) const -> Quat;
+
+    /// Stores into `dst` the interpolated quaternions at each of the `num`
+    /// given alphas
+    auto operator()(const T* alphas, Quat* dst, size_t num) const -> void;
+
+    /// Returns the angle between both quaternions (in [0, pi/2])
+    auto angle() const -> T { return m_Angle; }
+
+ private:
+    /// Quaternion at the start of the interpolation
+    Quat m_Start;
+    /// Quaternion at the end (negated if required to take the shortest path)
+    Quat m_End;
+    /// Angle between both quaternions, seen as 4d vectors
+    T m_Angle = static_cast<T>(0.0);
+    /// Inverse of the sine of the angle (zero if the angle is too small)
+    T m_InvSinAngle = static_cast<T>(0.0);
+};
+
 }  // namespace math
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <algorithm>
+#include <vector>
+
+#include "./parallel.hpp"
+#include "./pose3d_t.hpp"
+#include "./transform_tree_t_decl.hpp"
+
+namespace math {
+
+template <typename T>
+auto TransformTree<T>::addNode(int32_t parent, const Pose& local) -> size_t {
+    if (parent != NO_PARENT &&
+        (parent < 0 || static_cast<size_t>(parent) >= size())) {
+        return INVALID_NODE;
+    }
+    const uint32_t depth =
+        (parent == NO_PARENT) ? 0 : m_Depths[static_cast<size_t>(parent)] + 1;
+    // Keep the nodes in BFS order, so each level is a contiguous range
+    if (!empty() && depth < m_Depths.back()) {
+        return INVALID_NODE;
+    }
+    if (depth >= numLevels()) {
+        m_LevelBegin.push_back(size());
+    }
+
+    const size_t index = size();
+    m_Parents.push_back(parent);
+    m_Depths.push_back(depth);
+    m_Locals.push_back(local);
+    m_Worlds.push_back(local);
+    m_Dirty.push_back(1);
+    m_Scratch.emplace_back();
+    return index;
+}
+
+template <typename T>
+auto TransformTree<T>::clear() -> void {
+    m_Parents.clear();
+    m_Depths.clear();
+    m_LevelBegin.clear();
+    m_Locals.clear();
+    m_Worlds.clear();
+    m_Dirty.clear();
+    m_Scratch.clear();
+}
+
+template <typename T>
+auto TransformTree<T>::markAllDirty() -> void {
+    std::fill(m_Dirty.begin(), m_Dirty.end(), static_cast<uint8_t>(1));
+}
+
+template <typename T>
+auto TransformTree<T>::update(size_t num_threads) -> void {
+    // Propagate the dirty flags down the tree (parents come first)
+    for (size_t i = 0; i < size(); ++i) {
+        if (m_Parents[i] != NO_PARENT &&
+            m_Dirty[static_cast<size_t>(m_Parents[i])] != 0) {
+            m_Dirty[i] = 1;
+        }
+    }
+
+    // The nodes of a level only read the world poses of the levels above
+    for (size_t level = 0; level < numLevels(); ++level) {
+        const size_t begin = levelBegin(level);
+        parallel::ParallelForThreads(
+            num_threads, levelEnd(level) - begin,
+            [this, begin](size_t range_begin, size_t range_end) {
+                updateRange(begin + range_begin, begin + range_end);
+            },
+            MIN_NODES_PER_THREAD);
+    }
+
+    std::fill(m_Dirty.begin(), m_Dirty.end(), static_cast<uint8_t>(0));
+}
+
+template <typename T>
+auto TransformTree<T>::updateRange(size_t begin, size_t end) -> void {
+    const auto all_dirty =
+        std::all_of(m_Dirty.begin() + static_cast<std::ptrdiff_t>(begin),
+                    m_Dirty.begin() + static_cast<std::ptrdiff_t>(end),
+                    [](uint8_t dirty) { return dirty != 0; });
+    if (all_dirty && m_Parents[begin] != NO_PARENT) {
+        // Gather the world poses of the parents, and compose them in batch
+        for (size_t i = begin; i < end; ++i) {
+            m_Scratch[i] = m_Worlds[static_cast<size_t>(m_Parents[i])];
+        }
+        composePoses(m_Scratch.data() + begin, m_Locals.data() + begin,
+                     m_Worlds.data() + begin, end - begin);
+        return;
+    }
+
+    for (size_t i = begin; i < end; ++i) {
+        if (m_Dirty[i] == 0) {
+            continue;
+        }
+        m_Worlds[i] = (m_Parents[i] == NO_PARENT)
+                          ? m_Locals[i]
+                          : m_Worlds[static_cast<size_t>(m_Parents[i])] *
+                                m_Locals[i];
+    }
+}
+
+}  // namespace math
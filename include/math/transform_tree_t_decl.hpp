@@ -0,0 +1,160 @@
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "./common.hpp"
+#include "./pose3d_t_decl.hpp"
+
+namespace math {
+
+/// \class TransformTree
+///
+/// \brief Tree of rigid transforms, e.g. a kinematic tree or a scene graph
+///
+/// \tparam T Type of scalar value used for the poses (float|double)
+///
+/// Each node has a local pose (relative to its parent) and a world pose, given
+/// by world[i] = world[parent[i]] * local[i] (the world pose of a root node is
+/// just its local pose). The nodes are stored in breadth-first order: a node
+/// can only be added after its parent, and no shallower than the last node
+/// added. So parents always come before their children, and the nodes of each
+/// level of the tree are contiguous in the arrays of poses. A whole level can
+/// then be updated with the batch kernels (see composePoses), and split across
+/// threads, as its nodes only depend on the nodes of the previous levels.
+///
+/// Changing the local pose of a node marks it as dirty, and update() only
+/// recomputes the world poses of the dirty nodes and of their descendants.
+template <typename T>
+class TransformTree {
+ public:
+    /// Parent index used for root nodes
+    static constexpr int32_t NO_PARENT = -1;
+    /// Index returned by addNode when the node can't be added
+    static constexpr size_t INVALID_NODE = std::numeric_limits<size_t>::max();
+    /// Levels with less than this many nodes per thread are updated serially
+    static constexpr size_t MIN_NODES_PER_THREAD = 512;
+
+    // Some handy type aliases used throught the codebase
+    using Type = TransformTree<T>;
+    using ElementType = T;
+
+    // Some related types
+    using Pose = Pose3d<T>;
+
+    /// Constructs an empty tree
+    TransformTree() = default;
+
+    /// \brief Adds a node to the tree, and returns its index
+    ///
+    /// \param parent Index of the parent node (or NO_PARENT for a root node)
+    /// \param local Pose of the node relative to its parent
+    ///
+    /// The parent must already be in the tree, and the depth of the new node
+    /// can't be smaller than the depth of the last node added (BFS order).
+    /// Otherwise the tree is left unchanged, and INVALID_NODE is returned
+    auto addNode(int32_t parent, const Pose& local = Pose()) -> size_t;
+
+    /// Removes all nodes from the tree
+    auto clear() -> void;
+
+    /// Returns the number of nodes in the tree
+    auto size() const -> size_t { return m_Parents.size(); }
+
+    /// Returns whether or not the tree has no nodes
+    auto empty() const -> bool { return m_Parents.empty(); }
+
+    /// Returns the number of levels of the tree (max. depth + 1)
+    auto numLevels() const -> size_t { return m_LevelBegin.size(); }
+
+    /// Returns the index of the first node of the given level
+    auto levelBegin(size_t level) const -> size_t {
+        assert(level < numLevels());
+        return m_LevelBegin[level];
+    }
+
+    /// Returns the index one past the last node of the given level
+    auto levelEnd(size_t level) const -> size_t {
+        assert(level < numLevels());
+        return (level + 1 < numLevels()) ? m_LevelBegin[level + 1] : size();
+    }
+
+    /// Returns the index of the parent of the given node (or NO_PARENT)
+    auto parent(size_t index) const -> int32_t {
+        assert(index < size());
+        return m_Parents[index];
+    }
+
+    /// Returns the depth of the given node (0 for root nodes)
+    auto depth(size_t index) const -> uint32_t {
+        assert(index < size());
+        return m_Depths[index];
+    }
+
+    /// Returns the pose of the given node relative to its parent
+    auto local(size_t index) const -> const Pose& {
+        assert(index < size());
+        return m_Locals[index];
+    }
+
+    /// Returns the world pose of the given node (as of the last update)
+    auto world(size_t index) const -> const Pose& {
+        assert(index < size());
+        return m_Worlds[index];
+    }
+
+    /// Sets the pose of the given node relative to its parent (marks it dirty)
+    auto setLocal(size_t index, const Pose& local) -> void {
+        assert(index < size());
+        m_Locals[index] = local;
+        m_Dirty[index] = 1;
+    }
+
+    /// Returns whether or not the given node changed since the last update
+    auto isDirty(size_t index) const -> bool {
+        assert(index < size());
+        return m_Dirty[index] != 0;
+    }
+
+    /// Marks all nodes as dirty, so the next update recomputes the whole tree
+    auto markAllDirty() -> void;
+
+    /// Returns the parent indices of all nodes (in BFS order)
+    auto parents() const -> const std::vector<int32_t>& { return m_Parents; }
+
+    /// Returns the local poses of all nodes (in BFS order)
+    auto locals() const -> const std::vector<Pose>& { return m_Locals; }
+
+    /// Returns the world poses of all nodes (in BFS order)
+    auto worlds() const -> const std::vector<Pose>& { return m_Worlds; }
+
+    /// \brief Recomputes the world poses of the dirty nodes and descendants
+    ///
+    /// \param num_threads Max. number of threads used to update each level.
+    ///                    Only levels with at least MIN_NODES_PER_THREAD nodes
+    ///                    per thread are split, the rest run in this thread
+    auto update(size_t num_threads = 1) -> void;
+
+ private:
+    /// Recomputes the world poses of the dirty nodes in [begin, end)
+    auto updateRange(size_t begin, size_t end) -> void;
+
+    /// Index of the parent of each node (NO_PARENT for root nodes)
+    std::vector<int32_t> m_Parents;
+    /// Depth of each node in the tree
+    std::vector<uint32_t> m_Depths;
+    /// Index of the first node of each level
+    std::vector<size_t> m_LevelBegin;
+    /// Poses of each node relative to their parents
+    std::vector<Pose> m_Locals;
+    /// Poses of each node relative to the world (as of the last update)
+    std::vector<Pose> m_Worlds;
+    /// Whether or not each node has to be recomputed in the next update
+    std::vector<uint8_t> m_Dirty;
+    /// World poses of the parents, gathered for the batch kernels
+    std::vector<Pose> m_Scratch;
+};
+
+}  // namespace math
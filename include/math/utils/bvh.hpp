@@ -0,0 +1,795 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include <math/vec3_t.hpp>
+#include <math/utils/geometry_helpers.hpp>
+
+namespace math {
+
+/// \class BVH
+///
+/// \brief Bounding volume hierarchy over an array of axis-aligned boxes
+///
+/// \tparam T Type of scalar value used for the boxes (float|double)
+///
+/// The tree is built top-down with the binned surface area heuristic (SAH):
+/// the centroids of the boxes of a node are binned along each axis, and the
+/// node is split at the bin boundary with the lowest expected cost, or kept as
+/// a leaf if no split is cheaper than testing all of its boxes. The nodes are
+/// stored in a flat array (32 bytes each for float32), the children of a node
+/// are next to each other, and the boxes are reordered so the ones of a leaf
+/// are contiguous. All queries report the indices of the boxes in the array
+/// given to build().
+///
+/// When the boxes move, refit() recomputes the bounds of all nodes in a single
+/// bottom-up pass (the topology is kept), and updateBox() only the ones of the
+/// ancestors of a single box. The quality of the tree degrades as the boxes
+/// move away from where they were at build time, so rebuild it eventually.
+template <typename T>
+class BVH {
+ public:
+    /// Number of bins used along each axis to evaluate the splits
+    static constexpr uint32_t NUM_BINS = 16;
+    /// Default max. number of boxes of a leaf that aren't worth splitting
+    static constexpr uint32_t MAX_LEAF_SIZE = 4;
+    /// Max. depth of the tree (deeper nodes become leaves)
+    static constexpr uint32_t MAX_DEPTH = 64;
+    /// Index used for the parent of the root node
+    static constexpr uint32_t INVALID_INDEX = ~static_cast<uint32_t>(0);
+
+    // Some handy type aliases used throught the codebase
+    using Type = BVH<T>;
+    using ElementType = T;
+
+    // Some related types
+    using Vec3 = Vector3<T>;
+    using Box = AABB<T>;
+
+    /// Node of the tree, either internal (count == 0) or a leaf
+    struct Node {
+        /// Lower (x, y, z) boundary of the node
+        std::array<T, 3> p_min;
+        /// Index of the left child (the right one is next to it), or of the
+        /// first box of a leaf (in the reordered boxes)
+        uint32_t first;
+        /// Upper (x, y, z) boundary of the node
+        std::array<T, 3> p_max;
+        /// Number of boxes of a leaf (0 for internal nodes)
+        uint32_t count;
+
+        /// Returns whether or not this node is a leaf
+        auto isLeaf() const -> bool { return count > 0; }
+    };
+
+    /// Creates an empty tree
+    BVH() = default;
+
+    /// Creates a tree over the given array of boxes (see build)
+    BVH(const Box* boxes, size_t num, uint32_t max_leaf_size = MAX_LEAF_SIZE) {
+        build(boxes, num, max_leaf_size);
+    }
+
+    /// \brief Builds the tree over the given array of boxes
+    ///
+    /// \param boxes Array of boxes (copied, so it can be discarded afterwards)
+    /// \param num Number of boxes in the array
+    /// \param max_leaf_size Nodes with at most this many boxes aren't split
+    auto build(const Box* boxes, size_t num,
+               uint32_t max_leaf_size = MAX_LEAF_SIZE) -> void;
+
+    /// \brief Recomputes the bounds of all nodes, after the boxes moved
+    ///
+    /// \param boxes The new boxes, in the same order as given to build()
+    /// \param num Number of boxes (the same as given to build())
+    auto refit(const Box* boxes, size_t num) -> void;
+
+    /// Replaces the given box, and recomputes the bounds of its ancestors
+    auto updateBox(size_t index, const Box& box) -> void;
+
+    /// Returns the number of boxes in the tree
+    auto size() const -> size_t { return m_Indices.size(); }
+
+    /// Returns whether or not the tree has no boxes
+    auto empty() const -> bool { return m_Indices.empty(); }
+
+    /// Returns the number of nodes of the tree
+    auto numNodes() const -> size_t { return m_Nodes.size(); }
+
+    /// Returns the nodes of the tree (the root is the first one)
+    auto nodes() const -> const std::vector<Node>& { return m_Nodes; }
+
+    /// Returns the index of each box of the leaves (in leaf order)
+    auto indices() const -> const std::vector<uint32_t>& { return m_Indices; }
+
+    /// Returns the given box (by its index in the array given to build())
+    auto box(size_t index) const -> const Box& {
+        assert(index < size());
+        return m_Boxes[m_Slots[index]];
+    }
+
+    /// Returns the bounds of all boxes of the tree
+    auto bounds() const -> Box;
+
+    /// \brief Calls fn(index) for each box that overlaps the given box
+    ///
+    /// The boxes are considered to overlap if they touch (same as
+    /// AABB::intersects), and are reported in no particular order
+    template <typename Fn>
+    auto queryOverlaps(const Box& query, Fn fn) const -> void;
+
+    /// Returns the indices of the boxes that overlap the given box
+    auto queryOverlaps(const Box& query) const -> std::vector<size_t>;
+
+    /// \brief Calls fn(index) for each box that may be visible from a frustum
+    ///
+    /// Each node is only tested against the planes its parent crosses (see
+    /// Frustum::classify), and the boxes of the nodes inside all of the planes
+    /// are reported without further tests. Same results as testing each box
+    /// with Frustum::intersects, reported in no particular order
+    template <typename Fn>
+    auto queryFrustum(const Frustum<T>& frustum, Fn fn) const -> void;
+
+    /// Returns the indices of the boxes that may be visible from a frustum
+    auto queryFrustum(const Frustum<T>& frustum) const -> std::vector<size_t>;
+
+    /// \brief Calls fn(index, t) for each box hit by the given ray
+    ///
+    /// \param ray The ray to test the boxes against
+    /// \param t_max Only boxes entered at ray.pointAt(t), with t in
+    ///              [0, t_max], are reported (t = 0 for boxes containing the
+    ///              origin)
+    /// \param fn Called with the index of each box and its entry distance t.
+    ///           The nodes are visited front to back, but the boxes aren't
+    ///           strictly reported by increasing t
+    template <typename Fn>
+    auto queryRay(const Ray<T>& ray, T t_max, Fn fn) const -> void;
+
+    /// Calls fn(index, t) for each box hit by the ray (origin, direction)
+    template <typename Fn>
+    auto queryRay(const Vec3& origin, const Vec3& direction, T t_max,
+                  Fn fn) const -> void {
+        queryRay(Ray<T>(origin, direction), t_max, fn);
+    }
+
+    /// \brief Returns the closest box hit by the given ray, and its distance
+    ///
+    /// \return The index of the box and its entry distance t (see queryRay),
+    ///         or (INVALID_INDEX, infinity) if no box is hit
+    auto closestHit(const Ray<T>& ray,
+                    T t_max = std::numeric_limits<T>::infinity()) const
+        -> std::pair<size_t, T>;
+
+    /// Returns the closest box hit by the ray (origin, direction)
+    auto closestHit(const Vec3& origin, const Vec3& direction,
+                    T t_max = std::numeric_limits<T>::infinity()) const
+        -> std::pair<size_t, T> {
+        return closestHit(Ray<T>(origin, direction), t_max);
+    }
+
+    /// \brief Finds the closest box hit by each ray of the given array
+    ///
+    /// \param rays Array of rays to trace through the tree
+    /// \param num Number of rays in the array
+    /// \param indices Array where to store the index of the box hit by each
+    ///                ray (INVALID_INDEX if none)
+    /// \param distances Array where to store the entry distance of each ray
+    ///                  into its box (infinity if none)
+    /// \param t_max Only boxes entered within [0, t_max] are considered
+    auto closestHits(const Ray<T>* rays, size_t num, size_t* indices,
+                     T* distances,
+                     T t_max = std::numeric_limits<T>::infinity()) const
+        -> void;
+
+    /// \brief Calls fn(i, j) for each pair of overlapping boxes of the tree
+    ///
+    /// Each pair is reported once, with i < j, in no particular order
+    template <typename Fn>
+    auto queryPairs(Fn fn) const -> void;
+
+    /// Returns all pairs (i, j), i < j, of overlapping boxes of the tree
+    auto queryPairs() const -> std::vector<std::pair<size_t, size_t>>;
+
+ private:
+    /// Returns whether or not the bounds of the node overlap the given box
+    static auto overlaps(const Node& node, const Box& box) -> bool {
+        return !(box.p_max.x() < node.p_min[0] ||
+                 box.p_min.x() > node.p_max[0] ||
+                 box.p_max.y() < node.p_min[1] ||
+                 box.p_min.y() > node.p_max[1] ||
+                 box.p_max.z() < node.p_min[2] ||
+                 box.p_min.z() > node.p_max[2]);
+    }
+
+    /// Returns whether or not the bounds of both nodes overlap
+    static auto overlaps(const Node& lhs, const Node& rhs) -> bool {
+        return !(rhs.p_max[0] < lhs.p_min[0] || rhs.p_min[0] > lhs.p_max[0] ||
+                 rhs.p_max[1] < lhs.p_min[1] || rhs.p_min[1] > lhs.p_max[1] ||
+                 rhs.p_max[2] < lhs.p_min[2] || rhs.p_min[2] > lhs.p_max[2]);
+    }
+
+    /// Returns the surface area of the given bounds (half of it, actually),
+    /// or the sum of their extents if `is_flat` (e.g. boxes along a line)
+    static auto halfArea(const std::array<T, 3>& p_min,
+                         const std::array<T, 3>& p_max, bool is_flat = false)
+        -> T {
+        const T dx = p_max[0] - p_min[0];
+        const T dy = p_max[1] - p_min[1];
+        const T dz = p_max[2] - p_min[2];
+        return is_flat ? (dx + dy + dz) : (dx * dy + dy * dz + dz * dx);
+    }
+
+    /// Grows the given bounds to contain the given box
+    static auto grow(std::array<T, 3>& p_min, std::array<T, 3>& p_max,
+                     const Box& box) -> void {
+        for (uint32_t d = 0; d < 3; ++d) {
+            p_min[d] = std::min(p_min[d], box.p_min[d]);
+            p_max[d] = std::max(p_max[d], box.p_max[d]);
+        }
+    }
+
+    /// Sets the bounds of the given node to the ones of the given boxes
+    static auto fit(Node& node, const Box* boxes, const uint32_t* indices)
+        -> void {
+        node.p_min.fill(std::numeric_limits<T>::infinity());
+        node.p_max.fill(-std::numeric_limits<T>::infinity());
+        for (uint32_t k = node.first; k < node.first + node.count; ++k) {
+            grow(node.p_min, node.p_max, boxes[indices[k]]);
+        }
+    }
+
+    /// \brief Visits the boxes hit by the given ray, with closer nodes first
+    ///
+    /// Calls fn(slot, t, t_max) for each box hit (by its position in the
+    /// reordered boxes), which returns the t_max used for the rest of the
+    /// traversal, e.g. the distance of the closest hit found so far
+    template <typename Fn>
+    auto traverseRay(const Ray<T>& ray, T t_max, Fn fn) const -> void;
+
+    /// Recomputes the bounds of the given node from its boxes or children
+    auto refitNode(uint32_t node_index) -> void;
+
+    /// Tries to split the given node, and returns whether it was split
+    auto splitNode(uint32_t node_index, uint32_t max_leaf_size,
+                   const Box* boxes, const std::vector<Vec3>& centroids)
+        -> bool;
+
+    /// Nodes of the tree, with the root first
+    std::vector<Node> m_Nodes;
+    /// Parent of each node (INVALID_INDEX for the root)
+    std::vector<uint32_t> m_Parents;
+    /// Boxes of the tree, reordered so the ones of each leaf are contiguous
+    std::vector<Box> m_Boxes;
+    /// Index (as given to build) of each of the reordered boxes
+    std::vector<uint32_t> m_Indices;
+    /// Position of each box (as given to build) in the reordered boxes
+    std::vector<uint32_t> m_Slots;
+    /// Leaf that holds each of the reordered boxes
+    std::vector<uint32_t> m_LeafOf;
+};
+
+template <typename T>
+auto BVH<T>::build(const Box* boxes, size_t num, uint32_t max_leaf_size)
+    -> void {
+    assert(num < static_cast<size_t>(INVALID_INDEX));
+    max_leaf_size = std::max(max_leaf_size, static_cast<uint32_t>(1));
+    m_Nodes.clear();
+    m_Parents.clear();
+    m_Indices.resize(num);
+    m_Boxes.resize(num);
+    m_Slots.resize(num);
+    m_LeafOf.resize(num);
+    if (num == 0) {
+        return;
+    }
+
+    std::vector<Vec3> centroids(num);
+    for (size_t i = 0; i < num; ++i) {
+        m_Indices[i] = static_cast<uint32_t>(i);
+        centroids[i] = boxes[i].computeCenter();
+    }
+
+    // A binary tree with at most one box per leaf has 2 * num - 1 nodes
+    m_Nodes.reserve(2 * num - 1);
+    m_Parents.reserve(2 * num - 1);
+    m_Nodes.push_back({{}, 0, {}, static_cast<uint32_t>(num)});
+    // Pass a copy, as push_back would odr-use the constant (before C++17)
+    const uint32_t root_parent = INVALID_INDEX;
+    m_Parents.push_back(root_parent);
+    fit(m_Nodes[0], boxes, m_Indices.data());
+
+    // Split the nodes depth-first, so the stack holds at most one node per
+    // level (the siblings still to be split)
+    std::vector<std::pair<uint32_t, uint32_t>> stack = {{0, 0}};
+    while (!stack.empty()) {
+        const auto node_index = stack.back().first;
+        const auto depth = stack.back().second;
+        stack.pop_back();
+        if (depth + 1 >= MAX_DEPTH ||
+            !splitNode(node_index, max_leaf_size, boxes, centroids)) {
+            continue;
+        }
+        const auto left = m_Nodes[node_index].first;
+        stack.emplace_back(left + 1, depth + 1);
+        stack.emplace_back(left, depth + 1);
+    }
+
+    // Reorder the boxes in leaf order, and keep track of where each one went
+    for (size_t k = 0; k < num; ++k) {
+        m_Boxes[k] = boxes[m_Indices[k]];
+        m_Slots[m_Indices[k]] = static_cast<uint32_t>(k);
+    }
+    for (uint32_t n = 0; n < m_Nodes.size(); ++n) {
+        const auto& node = m_Nodes[n];
+        for (uint32_t k = 0; k < node.count; ++k) {
+            m_LeafOf[node.first + k] = n;
+        }
+    }
+}
+
+template <typename T>
+auto BVH<T>::splitNode(uint32_t node_index, uint32_t max_leaf_size,
+                       const Box* boxes, const std::vector<Vec3>& centroids)
+    -> bool {
+    const uint32_t first = m_Nodes[node_index].first;
+    const uint32_t count = m_Nodes[node_index].count;
+    if (count <= max_leaf_size) {
+        return false;
+    }
+
+    // Bounds of the centroids, which are the ones binned along each axis
+    std::array<T, 3> c_min, c_max;
+    c_min.fill(std::numeric_limits<T>::infinity());
+    c_max.fill(-std::numeric_limits<T>::infinity());
+    for (uint32_t k = first; k < first + count; ++k) {
+        const auto& centroid = centroids[m_Indices[k]];
+        for (uint32_t axis = 0; axis < 3; ++axis) {
+            c_min[axis] = std::min(c_min[axis], centroid[axis]);
+            c_max[axis] = std::max(c_max[axis], centroid[axis]);
+        }
+    }
+
+    struct Bin {
+        std::array<T, 3> p_min;
+        std::array<T, 3> p_max;
+        uint32_t count;
+    };
+
+    // Cost of a split relative to testing all boxes of the node: one
+    // traversal step plus the boxes of each side, weighted by their area
+    // If the node has no area (e.g. points along a line), its extent is used
+    // in place of the area of the sides
+    constexpr T TRAVERSAL_COST = static_cast<T>(1.0);
+    const auto& node_min = m_Nodes[node_index].p_min;
+    const auto& node_max = m_Nodes[node_index].p_max;
+    const bool is_flat = !(halfArea(node_min, node_max) > 0);
+    const T node_area = halfArea(node_min, node_max, is_flat);
+    T best_cost = static_cast<T>(count);
+    uint32_t best_axis = 3;
+    uint32_t best_split = 0;
+
+    // Bin the boxes along all axes in a single pass over them (the axes along
+    // which all centroids are the same can't be split)
+    std::array<std::array<Bin, NUM_BINS>, 3> axis_bins;
+    std::array<T, 3> scale;
+    for (uint32_t axis = 0; axis < 3; ++axis) {
+        const T extent = c_max[axis] - c_min[axis];
+        scale[axis] = (extent > static_cast<T>(0.0))
+                          ? static_cast<T>(NUM_BINS) / extent
+                          : static_cast<T>(0.0);
+        for (auto& bin : axis_bins[axis]) {
+            bin.p_min.fill(std::numeric_limits<T>::infinity());
+            bin.p_max.fill(-std::numeric_limits<T>::infinity());
+            bin.count = 0;
+        }
+    }
+    for (uint32_t k = first; k < first + count; ++k) {
+        const auto& centroid = centroids[m_Indices[k]];
+        const auto& box = boxes[m_Indices[k]];
+        for (uint32_t axis = 0; axis < 3; ++axis) {
+            const auto bin_index = std::min(
+                NUM_BINS - 1,
+                static_cast<uint32_t>((centroid[axis] - c_min[axis]) *
+                                      scale[axis]));
+            auto& bin = axis_bins[axis][bin_index];
+            grow(bin.p_min, bin.p_max, box);
+            ++bin.count;
+        }
+    }
+
+    for (uint32_t axis = 0; axis < 3; ++axis) {
+        if (!(scale[axis] > static_cast<T>(0.0))) {
+            continue;
+        }
+        const auto& bins = axis_bins[axis];
+
+        // Sweep from the right to get the area and count of each right side,
+        // then from the left evaluating the split after each bin
+        std::array<T, NUM_BINS> right_area;
+        std::array<uint32_t, NUM_BINS> right_count;
+        Bin right = {bins[NUM_BINS - 1].p_min, bins[NUM_BINS - 1].p_max, 0};
+        for (uint32_t b = NUM_BINS - 1; b > 0; --b) {
+            for (uint32_t d = 0; d < 3; ++d) {
+                right.p_min[d] = std::min(right.p_min[d], bins[b].p_min[d]);
+                right.p_max[d] = std::max(right.p_max[d], bins[b].p_max[d]);
+            }
+            right.count += bins[b].count;
+            right_area[b] = halfArea(right.p_min, right.p_max, is_flat);
+            right_count[b] = right.count;
+        }
+        Bin left = {bins[0].p_min, bins[0].p_max, 0};
+        for (uint32_t b = 0; b + 1 < NUM_BINS; ++b) {
+            for (uint32_t d = 0; d < 3; ++d) {
+                left.p_min[d] = std::min(left.p_min[d], bins[b].p_min[d]);
+                left.p_max[d] = std::max(left.p_max[d], bins[b].p_max[d]);
+            }
+            left.count += bins[b].count;
+            if (left.count == 0 || right_count[b + 1] == 0) {
+                continue;
+            }
+            const T left_area = halfArea(left.p_min, left.p_max, is_flat);
+            const T cost =
+                TRAVERSAL_COST +
+                (static_cast<T>(left.count) * left_area +
+                 static_cast<T>(right_count[b + 1]) * right_area[b + 1]) /
+                    node_area;
+            if (cost < best_cost) {
+                best_cost = cost;
+                best_axis = axis;
+                best_split = b + 1;
+            }
+        }
+    }
+    if (best_axis == 3) {
+        return false;
+    }
+
+    // Move the boxes of the bins [0, best_split) before the rest
+    auto* begin = m_Indices.data() + first;
+    auto* middle =
+        std::partition(begin, begin + count, [&](uint32_t index) {
+            const auto bin_index = std::min(
+                NUM_BINS - 1,
+                static_cast<uint32_t>(
+                    (centroids[index][best_axis] - c_min[best_axis]) *
+                    scale[best_axis]));
+            return bin_index < best_split;
+        });
+    const auto left_count = static_cast<uint32_t>(middle - begin);
+    if (left_count == 0 || left_count == count) {
+        return false;
+    }
+
+    const auto left_index = static_cast<uint32_t>(m_Nodes.size());
+    m_Nodes.push_back({{}, first, {}, left_count});
+    m_Nodes.push_back({{}, first + left_count, {}, count - left_count});
+    m_Parents.push_back(node_index);
+    m_Parents.push_back(node_index);
+    m_Nodes[node_index].first = left_index;
+    m_Nodes[node_index].count = 0;
+    fit(m_Nodes[left_index], boxes, m_Indices.data());
+    fit(m_Nodes[left_index + 1], boxes, m_Indices.data());
+    return true;
+}
+
+template <typename T>
+auto BVH<T>::refitNode(uint32_t node_index) -> void {
+    auto& node = m_Nodes[node_index];
+    if (node.isLeaf()) {
+        // The boxes are already in leaf order, so fit them as they are
+        node.p_min.fill(std::numeric_limits<T>::infinity());
+        node.p_max.fill(-std::numeric_limits<T>::infinity());
+        for (uint32_t k = node.first; k < node.first + node.count; ++k) {
+            grow(node.p_min, node.p_max, m_Boxes[k]);
+        }
+        return;
+    }
+    const auto& left = m_Nodes[node.first];
+    const auto& right = m_Nodes[node.first + 1];
+    for (uint32_t d = 0; d < 3; ++d) {
+        node.p_min[d] = std::min(left.p_min[d], right.p_min[d]);
+        node.p_max[d] = std::max(left.p_max[d], right.p_max[d]);
+    }
+}
+
+template <typename T>
+auto BVH<T>::refit(const Box* boxes, size_t num) -> void {
+    assert(num == size());
+    (void)num;
+    for (size_t k = 0; k < m_Boxes.size(); ++k) {
+        m_Boxes[k] = boxes[m_Indices[k]];
+    }
+    // Children are always stored after their parents, so a reverse sweep
+    // refits every node after its children
+    for (size_t n = m_Nodes.size(); n > 0; --n) {
+        refitNode(static_cast<uint32_t>(n - 1));
+    }
+}
+
+template <typename T>
+auto BVH<T>::updateBox(size_t index, const Box& box) -> void {
+    assert(index < size());
+    const auto slot = m_Slots[index];
+    m_Boxes[slot] = box;
+    auto node_index = m_LeafOf[slot];
+    refitNode(node_index);
+    // Walk up to the root, stopping once the bounds of a node don't change
+    while (m_Parents[node_index] != INVALID_INDEX) {
+        node_index = m_Parents[node_index];
+        const auto old_min = m_Nodes[node_index].p_min;
+        const auto old_max = m_Nodes[node_index].p_max;
+        refitNode(node_index);
+        if (m_Nodes[node_index].p_min == old_min &&
+            m_Nodes[node_index].p_max == old_max) {
+            break;
+        }
+    }
+}
+
+template <typename T>
+auto BVH<T>::bounds() const -> Box {
+    if (m_Nodes.empty()) {
+        const auto inf = std::numeric_limits<T>::infinity();
+        return Box(Vec3(inf, inf, inf), Vec3(-inf, -inf, -inf));
+    }
+    const auto& root = m_Nodes[0];
+    return Box(Vec3(root.p_min[0], root.p_min[1], root.p_min[2]),
+               Vec3(root.p_max[0], root.p_max[1], root.p_max[2]));
+}
+
+template <typename T>
+template <typename Fn>
+auto BVH<T>::queryOverlaps(const Box& query, Fn fn) const -> void {
+    if (m_Nodes.empty()) {
+        return;
+    }
+    // Depth-first, so the stack holds at most one node per level
+    std::array<uint32_t, MAX_DEPTH + 1> stack;
+    size_t stack_size = 0;
+    stack[stack_size++] = 0;
+    while (stack_size > 0) {
+        const auto& node = m_Nodes[stack[--stack_size]];
+        if (!overlaps(node, query)) {
+            continue;
+        }
+        if (!node.isLeaf()) {
+            stack[stack_size++] = node.first + 1;
+            stack[stack_size++] = node.first;
+            continue;
+        }
+        for (uint32_t k = node.first; k < node.first + node.count; ++k) {
+            if (m_Boxes[k].intersects(query)) {
+                fn(static_cast<size_t>(m_Indices[k]));
+            }
+        }
+    }
+}
+
+template <typename T>
+auto BVH<T>::queryOverlaps(const Box& query) const -> std::vector<size_t> {
+    std::vector<size_t> hits;
+    queryOverlaps(query, [&hits](size_t index) { hits.push_back(index); });
+    return hits;
+}
+
+template <typename T>
+template <typename Fn>
+auto BVH<T>::queryFrustum(const Frustum<T>& frustum, Fn fn) const -> void {
+    if (m_Nodes.empty()) {
+        return;
+    }
+    // Nodes still to visit, with the planes they still have to be tested
+    // against (the ones their parent crosses)
+    std::array<std::pair<uint32_t, uint32_t>, MAX_DEPTH + 1> stack;
+    size_t stack_size = 0;
+    stack[stack_size++] = {0, static_cast<uint32_t>(Frustum<T>::ALL_PLANES)};
+    while (stack_size > 0) {
+        const auto entry = stack[--stack_size];
+        const auto& node = m_Nodes[entry.first];
+        auto plane_mask = entry.second;
+        if (plane_mask != 0) {
+            const Box bounds(
+                Vec3(node.p_min[0], node.p_min[1], node.p_min[2]),
+                Vec3(node.p_max[0], node.p_max[1], node.p_max[2]));
+            if (frustum.classify(bounds, plane_mask) == Visibility::OUTSIDE) {
+                continue;
+            }
+        }
+        if (!node.isLeaf()) {
+            stack[stack_size++] = {node.first + 1, plane_mask};
+            stack[stack_size++] = {node.first, plane_mask};
+            continue;
+        }
+        for (uint32_t k = node.first; k < node.first + node.count; ++k) {
+            auto box_mask = plane_mask;
+            if (box_mask == 0 || frustum.classify(m_Boxes[k], box_mask) !=
+                                     Visibility::OUTSIDE) {
+                fn(static_cast<size_t>(m_Indices[k]));
+            }
+        }
+    }
+}
+
+template <typename T>
+auto BVH<T>::queryFrustum(const Frustum<T>& frustum) const
+    -> std::vector<size_t> {
+    std::vector<size_t> hits;
+    queryFrustum(frustum, [&hits](size_t index) { hits.push_back(index); });
+    return hits;
+}
+
+template <typename T>
+template <typename Fn>
+auto BVH<T>::traverseRay(const Ray<T>& ray, T t_max, Fn fn) const -> void {
+    if (m_Nodes.empty()) {
+        return;
+    }
+    const auto inf = std::numeric_limits<T>::infinity();
+
+    // Nodes still to visit, with the distance at which the ray enters them
+    std::array<std::pair<uint32_t, T>, MAX_DEPTH + 1> stack;
+    size_t stack_size = 0;
+    const T t_root =
+        ray.intersect(m_Nodes[0].p_min.data(), m_Nodes[0].p_max.data(), t_max);
+    if (t_root < inf) {
+        stack[stack_size++] = {0, t_root};
+    }
+    while (stack_size > 0) {
+        const auto entry = stack[--stack_size];
+        // Skip the nodes that are now beyond t_max
+        if (entry.second > t_max) {
+            continue;
+        }
+        const auto& node = m_Nodes[entry.first];
+        if (node.isLeaf()) {
+            for (uint32_t k = node.first; k < node.first + node.count; ++k) {
+                const T t_hit = ray.intersect(m_Boxes[k].p_min.data(),
+                                              m_Boxes[k].p_max.data(), t_max);
+                if (t_hit < inf) {
+                    t_max = fn(k, t_hit, t_max);
+                }
+            }
+            continue;
+        }
+        // Visit the closest child first (pushed last)
+        const auto& left = m_Nodes[node.first];
+        const auto& right = m_Nodes[node.first + 1];
+        const T t_left =
+            ray.intersect(left.p_min.data(), left.p_max.data(), t_max);
+        const T t_right =
+            ray.intersect(right.p_min.data(), right.p_max.data(), t_max);
+        const bool left_first = (t_left <= t_right);
+        const auto near = left_first ? std::make_pair(node.first, t_left)
+                                     : std::make_pair(node.first + 1, t_right);
+        const auto far = left_first ? std::make_pair(node.first + 1, t_right)
+                                    : std::make_pair(node.first, t_left);
+        if (far.second < inf) {
+            stack[stack_size++] = far;
+        }
+        if (near.second < inf) {
+            stack[stack_size++] = near;
+        }
+    }
+}
+
+template <typename T>
+template <typename Fn>
+auto BVH<T>::queryRay(const Ray<T>& ray, T t_max, Fn fn) const -> void {
+    traverseRay(ray, t_max,
+                [&fn, this](uint32_t slot, T t_hit, T t_limit) {
+                    fn(static_cast<size_t>(m_Indices[slot]), t_hit);
+                    return t_limit;
+                });
+}
+
+template <typename T>
+auto BVH<T>::closestHit(const Ray<T>& ray, T t_max) const
+    -> std::pair<size_t, T> {
+    std::pair<size_t, T> closest = {static_cast<size_t>(INVALID_INDEX),
+                                    std::numeric_limits<T>::infinity()};
+    // Each hit shrinks the range of the ray, so farther nodes are culled. The
+    // boxes entered at the same distance are still visited, so ties are
+    // broken by index (as with queryRay)
+    traverseRay(ray, t_max,
+                [&closest, this](uint32_t slot, T t_hit, T t_limit) {
+                    const auto index = static_cast<size_t>(m_Indices[slot]);
+                    if (t_hit < closest.second ||
+                        (t_hit == closest.second && index < closest.first)) {
+                        closest = {index, t_hit};
+                    }
+                    return std::min(t_limit, t_hit);
+                });
+    return closest;
+}
+
+template <typename T>
+auto BVH<T>::closestHits(const Ray<T>* rays, size_t num, size_t* indices,
+                         T* distances, T t_max) const -> void {
+    for (size_t i = 0; i < num; ++i) {
+        const auto hit = closestHit(rays[i], t_max);
+        indices[i] = hit.first;
+        distances[i] = hit.second;
+    }
+}
+
+template <typename T>
+template <typename Fn>
+auto BVH<T>::queryPairs(Fn fn) const -> void {
+    if (m_Nodes.empty()) {
+        return;
+    }
+    auto report = [&fn, this](uint32_t slot_a, uint32_t slot_b) {
+        if (m_Boxes[slot_a].intersects(m_Boxes[slot_b])) {
+            const auto index_a = static_cast<size_t>(m_Indices[slot_a]);
+            const auto index_b = static_cast<size_t>(m_Indices[slot_b]);
+            fn(std::min(index_a, index_b), std::max(index_a, index_b));
+        }
+    };
+    // Pairs of nodes whose boxes are tested against each other. A node paired
+    // with itself stands for the pairs of boxes within its subtree
+    std::vector<std::pair<uint32_t, uint32_t>> stack = {{0, 0}};
+    while (!stack.empty()) {
+        const auto node_pair = stack.back();
+        stack.pop_back();
+        const auto& node_a = m_Nodes[node_pair.first];
+        const auto& node_b = m_Nodes[node_pair.second];
+        if (node_pair.first == node_pair.second) {
+            if (node_a.isLeaf()) {
+                const auto end = node_a.first + node_a.count;
+                for (uint32_t i = node_a.first; i < end; ++i) {
+                    for (uint32_t j = i + 1; j < end; ++j) {
+                        report(i, j);
+                    }
+                }
+            } else {
+                stack.emplace_back(node_a.first, node_a.first);
+                stack.emplace_back(node_a.first + 1, node_a.first + 1);
+                stack.emplace_back(node_a.first, node_a.first + 1);
+            }
+            continue;
+        }
+        if (!overlaps(node_a, node_b)) {
+            continue;
+        }
+        if (node_a.isLeaf() && node_b.isLeaf()) {
+            for (uint32_t i = node_a.first; i < node_a.first + node_a.count;
+                 ++i) {
+                for (uint32_t j = node_b.first;
+                     j < node_b.first + node_b.count; ++j) {
+                    report(i, j);
+                }
+            }
+            continue;
+        }
+        // Descend into the larger node (or the one that isn't a leaf)
+        const bool split_a =
+            node_b.isLeaf() ||
+            (!node_a.isLeaf() && halfArea(node_a.p_min, node_a.p_max) >=
+                                     halfArea(node_b.p_min, node_b.p_max));
+        if (split_a) {
+            stack.emplace_back(node_a.first, node_pair.second);
+            stack.emplace_back(node_a.first + 1, node_pair.second);
+        } else {
+            stack.emplace_back(node_pair.first, node_b.first);
+            stack.emplace_back(node_pair.first, node_b.first + 1);
+        }
+    }
+}
+
+template <typename T>
+auto BVH<T>::queryPairs() const -> std::vector<std::pair<size_t, size_t>> {
+    std::vector<std::pair<size_t, size_t>> pairs;
+    queryPairs([&pairs](size_t index_a, size_t index_b) {
+        pairs.emplace_back(index_a, index_b);
+    });
+    return pairs;
+}
+
+}  // namespace math
@@ -1,6 +1,9 @@
 #pragma once
 
 #include <array>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
 #include <initializer_list>
 #include <limits>
 #include <sstream>
@@ -181,7 +184,7 @@ struct AABB {
     }
 
     /// \brief Returns whether or not it intersects the given box
-    auto intersects(const AABB<T>& other) -> bool {
+    auto intersects(const AABB<T>& other) const -> bool {
         return !(other.p_max.x() < this->p_min.x() ||
                  other.p_min.x() > this->p_max.x() ||
                  other.p_max.y() < this->p_min.y() ||
@@ -191,6 +194,97 @@ struct AABB {
     }
 };
 
+/// \brief Class representing a ray, given by its origin and direction
+///
+/// The inverse of the direction is computed once on construction, so the slab
+/// tests against boxes (e.g. when traversing a BVH) only take products. The
+/// axes the ray is parallel to get an inverse of +inf (also for a -0 entry),
+/// which the slab tests rely on to handle those axes without branches.
+template <typename T>
+struct Ray {
+    using Vec3 = Vector3<T>;
+
+    /// \brief The origin of the ray
+    Vec3 origin = {static_cast<T>(0.0), static_cast<T>(0.0),
+                   static_cast<T>(0.0)};
+    /// \brief The direction of the ray (doesn't have to be unit)
+    Vec3 direction = {static_cast<T>(1.0), static_cast<T>(0.0),
+                      static_cast<T>(0.0)};
+    /// \brief The inverse of each entry of the direction of the ray
+    Vec3 inv_direction = {static_cast<T>(1.0),
+                          std::numeric_limits<T>::infinity(),
+                          std::numeric_limits<T>::infinity()};
+
+    /// \brief Creates a default ray from the origin along the x-axis
+    Ray() = default;
+
+    /// \brief Creates a ray with the given origin and direction
+    ///
+    /// \param p_origin The point where the ray starts
+    /// \param p_direction The direction of the ray (doesn't have to be unit)
+    Ray(const Vec3& p_origin, const Vec3& p_direction)
+        : origin(p_origin), direction(p_direction) {
+        // Adding zero turns -0 into +0, so parallel axes get +inf
+        const T ONE = static_cast<T>(1.0);
+        const T ZERO = static_cast<T>(0.0);
+        inv_direction = Vec3(ONE / (direction.x() + ZERO),
+                             ONE / (direction.y() + ZERO),
+                             ONE / (direction.z() + ZERO));
+    }
+
+    /// \brief Returns a string representation of this ray
+    MATH3D_NODISCARD auto toString() const -> std::string {
+        std::stringstream sstr_result;
+        sstr_result << "<Ray\n";
+        sstr_result << "  origin: " << origin.toString() << "\n";
+        sstr_result << "  direction: " << direction.toString() << "\n";
+        sstr_result << ">\n";
+        return sstr_result.str();
+    }
+
+    /// \brief Returns the point at the given distance along the ray
+    auto pointAt(T t) const -> Vec3 { return origin + t * direction; }
+
+    /// \brief Returns the distance at which the ray enters the given bounds
+    ///
+    /// Branchless slab test against the bounds [p_min, p_max]. Boxes that
+    /// contain the origin are entered at t = 0, and boxes only touched by the
+    /// ray count as hit (as in AABB::intersects).
+    ///
+    /// \param p_min Lower (x, y, z) boundary of the bounds
+    /// \param p_max Upper (x, y, z) boundary of the bounds
+    /// \param t_max Only entry distances in [0, t_max] are reported
+    /// \return The entry distance, or infinity if the bounds are missed
+    auto intersect(const T* p_min, const T* p_max,
+                   T t_max = std::numeric_limits<T>::infinity()) const -> T {
+        // A parallel axis gives 0 * inf = NaN if the origin lies on one of its
+        // slabs. NaNs fail all comparisons below, so these slabs don't clip
+        // the interval (the comparisons map to min|max instructions)
+        T t_enter = static_cast<T>(0.0);
+        T t_exit = t_max;
+        for (uint32_t d = 0; d < 3; ++d) {
+            const T t_a = (p_min[d] - origin[d]) * inv_direction[d];
+            const T t_b = (p_max[d] - origin[d]) * inv_direction[d];
+            const T t_near = (t_a > t_b) ? t_b : t_a;
+            const T t_far = (t_a > t_b) ? t_a : t_b;
+            t_enter = (t_near > t_enter) ? t_near : t_enter;
+            t_exit = (t_far < t_exit) ? t_far : t_exit;
+        }
+        return (t_enter <= t_exit) ? t_enter
+                                   : std::numeric_limits<T>::infinity();
+    }
+
+    /// \brief Returns the distance at which the ray enters the given box
+    ///
+    /// \param box The box to test the ray against
+    /// \param t_max Only entry distances in [0, t_max] are reported
+    /// \return The entry distance, or infinity if the box is missed
+    auto intersect(const AABB<T>& box,
+                   T t_max = std::numeric_limits<T>::infinity()) const -> T {
+        return intersect(box.p_min.data(), box.p_max.data(), t_max);
+    }
+};
+
 /// \brief Class representing a simple sphere
 template <typename T>
 struct Sphere {
@@ -209,21 +303,202 @@ struct Sphere {
         : center(p_center), radius(p_radius) {}
 
     /// \brief Returns the distance from the given point to the sphere
-    auto distanceTo(const Vec3& point) -> T {
+    auto distanceTo(const Vec3& point) const -> T {
         return (point - center).length() - radius;
     }
 
     /// \brief Returns whether or not the given point is inside the sphere
-    auto contains(const Vec3& point) -> bool {
+    auto contains(const Vec3& point) const -> bool {
         return (point - center).lengthSquare() <= radius * radius;
     }
 
     /// |brief Returns whether it intersects with a given sphere
-    auto intersects(const Sphere& other) -> bool {
+    auto intersects(const Sphere& other) const -> bool {
         auto radius_sum = radius + other.radius;
         return (other.center - center).lengthSquare() <=
                radius_sum * radius_sum;
     }
 };
 
+/// \brief Result of testing a volume against the planes of a frustum
+enum class Visibility : uint8_t {
+    /// The volume is outside of (at least) one of the planes
+    OUTSIDE,
+    /// The volume crosses some of the planes, so it may be partially visible
+    PARTIAL,
+    /// The volume is inside all of the planes
+    INSIDE,
+};
+
+/// \brief Class representing a view frustum, given by its six planes
+///
+/// The planes are extracted from a view-projection matrix (e.g. the product of
+/// Matrix4::Perspective and a view matrix, with clip coordinates in [-w, w]),
+/// in the order left, right, bottom, top, near and far. These are stored as
+/// SoA, normalized and with their normals pointing inwards, so a point p is
+/// inside the frustum if n.dot(p) + d >= 0 for all of them. The batch tests
+/// (see frustum_culling.hpp) broadcast the coefficients of one plane at a time.
+///
+/// The tests against spheres and boxes are conservative: a volume that's near
+/// a corner of the frustum can be reported as visible even if it isn't.
+template <typename T>
+struct Frustum {
+    using Vec3 = Vector3<T>;
+    using Mat4 = Matrix4<T>;
+
+    /// Number of planes of the frustum
+    static constexpr uint32_t NUM_PLANES = 6;
+    /// Mask with the bits of all planes set (see classify)
+    static constexpr uint32_t ALL_PLANES = (1U << NUM_PLANES) - 1U;
+
+    /// \brief The x-component of the normal of each plane
+    std::array<T, NUM_PLANES> normal_x = {};
+    /// \brief The y-component of the normal of each plane
+    std::array<T, NUM_PLANES> normal_y = {};
+    /// \brief The z-component of the normal of each plane
+    std::array<T, NUM_PLANES> normal_z = {};
+    /// \brief The offset d of each plane (n.dot(p) + d = 0 on the plane)
+    std::array<T, NUM_PLANES> offset = {};
+
+    /// \brief Creates a frustum that contains the whole space
+    Frustum() = default;
+
+    /// \brief Creates the frustum of the given view-projection matrix
+    explicit Frustum(const Mat4& view_proj) { setFromMatrix(view_proj); }
+
+    /// \brief Extracts the planes of the given view-projection matrix
+    ///
+    /// Each plane is a sum or a difference of the last row of the matrix and
+    /// one of the others (e.g. w + x >= 0 for the left one), normalized so
+    /// that n.dot(p) + d is the signed distance from p to the plane
+    auto setFromMatrix(const Mat4& view_proj) -> void {
+        for (uint32_t k = 0; k < NUM_PLANES; ++k) {
+            const uint32_t row = k / 2;
+            const T sign = (k % 2 == 0) ? static_cast<T>(1.0)
+                                        : static_cast<T>(-1.0);
+            T coeffs[4];  // NOLINT
+            for (uint32_t col = 0; col < 4; ++col) {
+                coeffs[col] = view_proj(3, col) + sign * view_proj(row, col);
+            }
+            const T length = std::sqrt(coeffs[0] * coeffs[0] +
+                                       coeffs[1] * coeffs[1] +
+                                       coeffs[2] * coeffs[2]);
+            // Leave degenerate planes as they are (e.g. the far plane of an
+            // infinite projection), as these don't clip anything
+            const T scale = (length > static_cast<T>(0.0))
+                                ? static_cast<T>(1.0) / length
+                                : static_cast<T>(1.0);
+            normal_x[k] = coeffs[0] * scale;
+            normal_y[k] = coeffs[1] * scale;
+            normal_z[k] = coeffs[2] * scale;
+            offset[k] = coeffs[3] * scale;
+        }
+    }
+
+    /// \brief Returns the plane at the given index (see the order above)
+    auto plane(uint32_t index) const -> Plane<T> {
+        assert(index < NUM_PLANES);
+        const Vec3 normal(normal_x[index], normal_y[index], normal_z[index]);
+        return Plane<T>(static_cast<double>(-offset[index]) * normal, normal);
+    }
+
+    /// \brief Returns the signed distance from a point to the given plane
+    /// (positive on the inner side of the plane)
+    auto signedDistanceTo(uint32_t index, const Vec3& point) const -> T {
+        return normal_x[index] * point.x() + normal_y[index] * point.y() +
+               normal_z[index] * point.z() + offset[index];
+    }
+
+    /// \brief Returns whether or not the given point is inside the frustum
+    auto contains(const Vec3& point) const -> bool {
+        for (uint32_t k = 0; k < NUM_PLANES; ++k) {
+            if (!(signedDistanceTo(k, point) >= static_cast<T>(0.0))) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /// \brief Returns whether or not the given sphere may be visible
+    auto intersects(const Sphere<T>& sphere) const -> bool {
+        for (uint32_t k = 0; k < NUM_PLANES; ++k) {
+            if (!(signedDistanceTo(k, sphere.center) >= -sphere.radius)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /// \brief Returns whether or not the given box may be visible
+    auto intersects(const AABB<T>& box) const -> bool {
+        for (uint32_t k = 0; k < NUM_PLANES; ++k) {
+            if (!(signedDistanceTo(k, positiveCorner(k, box)) >=
+                  static_cast<T>(0.0))) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /// \brief Tests the given box against some of the planes of the frustum
+    ///
+    /// This is meant for hierarchies of boxes (e.g. a BVH), where the children
+    /// of a node are contained in it: once a node is inside a plane, its
+    /// children are too, so they don't have to be tested against it again.
+    ///
+    /// \param box The box to test against the frustum
+    /// \param plane_mask The planes to test (bit k for the k-th plane). On
+    ///                   return, the bits of the planes the box is inside of
+    ///                   are cleared, so it can be passed to its children
+    /// \return Whether the box is outside, inside or crosses the frustum
+    auto classify(const AABB<T>& box, uint32_t& plane_mask) const
+        -> Visibility {
+        for (uint32_t k = 0; k < NUM_PLANES; ++k) {
+            if ((plane_mask & (1U << k)) == 0) {
+                continue;
+            }
+            if (!(signedDistanceTo(k, positiveCorner(k, box)) >=
+                  static_cast<T>(0.0))) {
+                return Visibility::OUTSIDE;
+            }
+            // If the corner furthest behind the plane is in front of it, the
+            // whole box is inside the plane
+            if (signedDistanceTo(k, negativeCorner(k, box)) >=
+                static_cast<T>(0.0)) {
+                plane_mask &= ~(1U << k);
+            }
+        }
+        return (plane_mask == 0) ? Visibility::INSIDE : Visibility::PARTIAL;
+    }
+
+    /// \brief Returns a string representation of this frustum
+    MATH3D_NODISCARD auto toString() const -> std::string {
+        std::stringstream sstr_result;
+        sstr_result << "<Frustum\n";
+        for (uint32_t k = 0; k < NUM_PLANES; ++k) {
+            sstr_result << "  plane: (" << normal_x[k] << ", " << normal_y[k]
+                        << ", " << normal_z[k] << ", " << offset[k] << ")\n";
+        }
+        sstr_result << ">\n";
+        return sstr_result.str();
+    }
+
+ private:
+    /// Returns the corner of the box furthest along the normal of a plane
+    auto positiveCorner(uint32_t index, const AABB<T>& box) const -> Vec3 {
+        const T zero = static_cast<T>(0.0);
+        return Vec3((normal_x[index] >= zero) ? box.p_max.x() : box.p_min.x(),
+                    (normal_y[index] >= zero) ? box.p_max.y() : box.p_min.y(),
+                    (normal_z[index] >= zero) ? box.p_max.z() : box.p_min.z());
+    }
+
+    /// Returns the corner of the box furthest behind a plane
+    auto negativeCorner(uint32_t index, const AABB<T>& box) const -> Vec3 {
+        const T zero = static_cast<T>(0.0);
+        return Vec3((normal_x[index] >= zero) ? box.p_min.x() : box.p_max.x(),
+                    (normal_y[index] >= zero) ? box.p_min.y() : box.p_max.y(),
+                    (normal_z[index] >= zero) ? box.p_min.z() : box.p_max.z());
+    }
+};
+
 }  // namespace math
@@ -0,0 +1,555 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <initializer_list>
+#include <limits>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include <math/parallel.hpp>
+#include <math/vec3_t.hpp>
+
+namespace math {
+
+/// \class SpatialHashGrid
+///
+/// \brief Uniform grid over a set of points, for neighborhood queries
+///
+/// \tparam T Type of scalar value used for the points (float|double)
+///
+/// Space is divided into cubic cells of a given size, and each cell is mapped
+/// by a hash of its integer coordinates to one of the buckets of a table (so
+/// the grid has no bounds, and empty cells take no memory). The points are
+/// sorted by bucket with a counting sort, so the points of a bucket are
+/// contiguous (different cells can share a bucket, so the cell of each point is
+/// checked when visiting a cell). All queries report the indices of the points
+/// in the array given to build().
+///
+/// The queries only visit the cells within their reach, so these work best
+/// with a cell size close to the radius of the queries: much smaller cells
+/// mean many (mostly empty) cells per query, and much larger ones many points
+/// per cell that are too far away.
+template <typename T>
+class SpatialHashGrid {
+ public:
+    /// Max. number of points of the grid (so the buckets fit in 32-bit)
+    static constexpr size_t MAX_POINTS = static_cast<size_t>(1) << 31;
+    /// Min. number of points given to each thread by the parallel calls
+    static constexpr size_t MIN_POINTS_PER_THREAD = 1024;
+
+    // Some handy type aliases used throught the codebase
+    using Type = SpatialHashGrid<T>;
+    using ElementType = T;
+
+    // Some related types
+    using Vec3 = Vector3<T>;
+    /// Integer coordinates (x, y, z) of a cell of the grid
+    using Cell = std::array<int32_t, 3>;
+
+    /// Creates an empty grid
+    SpatialHashGrid() = default;
+
+    /// Creates a grid over the given array of points (see build)
+    SpatialHashGrid(const Vec3* points, size_t num, T cell_size) {
+        build(points, num, cell_size);
+    }
+
+    /// Creates a grid over the given points (see build)
+    SpatialHashGrid(const std::vector<Vec3>& points, T cell_size) {
+        build(points.data(), points.size(), cell_size);
+    }
+
+    /// \brief Builds the grid over the given array of points
+    ///
+    /// The points are binned, counted and scattered into their buckets by as
+    /// many threads as set in parallel::SetNumThreads (for large arrays), and
+    /// the grid is the same regardless of the number of threads.
+    ///
+    /// \param points Array of points (copied, so it can be discarded later)
+    /// \param num Number of points in the array
+    /// \param cell_size Length of the side of the cells (must be positive)
+    auto build(const Vec3* points, size_t num, T cell_size) -> void;
+
+    /// Returns the number of points in the grid
+    auto size() const -> size_t { return m_Indices.size(); }
+
+    /// Returns whether or not the grid has no points
+    auto empty() const -> bool { return m_Indices.empty(); }
+
+    /// Returns the length of the side of the cells
+    auto cellSize() const -> T { return m_CellSize; }
+
+    /// Returns the number of buckets of the hash table
+    auto numBuckets() const -> size_t {
+        return m_BucketStart.empty() ? 0 : m_BucketStart.size() - 1;
+    }
+
+    /// Returns the index of each point of the grid (in bucket order)
+    auto indices() const -> const std::vector<uint32_t>& { return m_Indices; }
+
+    /// Returns the cell that contains the given point
+    auto cellOf(const Vec3& point) const -> Cell {
+        // Clamped, so far away points don't overflow the coordinates
+        const T max_coord = static_cast<T>(1 << 30);
+        Cell cell;
+        for (uint32_t d = 0; d < 3; ++d) {
+            const T coord = std::max(
+                -max_coord, std::min(max_coord, point[d] * m_InvCellSize));
+            // Rounded towards zero, so one less below the (negative) integer
+            cell[d] = static_cast<int32_t>(coord);
+            cell[d] -= (coord < static_cast<T>(cell[d])) ? 1 : 0;
+        }
+        return cell;
+    }
+
+    /// \brief Calls fn(index, dist_sq) for each point within a sphere
+    ///
+    /// The points are those whose squared distance to the center is at most
+    /// radius * radius, reported along with that distance, in no particular
+    /// order
+    template <typename Fn>
+    auto queryRadius(const Vec3& center, T radius, Fn fn) const -> void;
+
+    /// Returns the indices of the points within the given sphere
+    auto queryRadius(const Vec3& center, T radius) const
+        -> std::vector<size_t>;
+
+    /// \brief Returns the indices of the k points closest to the given point
+    ///
+    /// The cells are visited in rings of increasing distance around the cell
+    /// of the point, until no cell left can hold a point closer than the k-th
+    /// one found so far. The indices are sorted by increasing distance (and
+    /// by index, for points at the same distance)
+    auto queryKNearest(const Vec3& point, size_t k) const
+        -> std::vector<size_t>;
+
+    /// \brief Calls fn(i, j) for each pair of points within a distance
+    ///
+    /// Each pair is reported once, with i < j, in no particular order
+    template <typename Fn>
+    auto queryPairs(T radius, Fn fn) const -> void;
+
+    /// \brief Returns all pairs (i, j), i < j, of points within a distance
+    ///
+    /// The points are split across threads (see parallel::SetNumThreads), so
+    /// the pairs are in no particular order
+    auto queryPairs(T radius) const -> std::vector<std::pair<size_t, size_t>>;
+
+ private:
+    /// \brief Returns the hash of the coordinates of the given cell
+    ///
+    /// Only the (y, z) coordinates are hashed, and x is added to the result,
+    /// so the cells of a row along x map to consecutive buckets (and their
+    /// points are contiguous), which the queries visit with a single loop
+    static auto hashCell(const Cell& cell) -> uint32_t {
+        // Spatial hash of Teschner et al., followed by the finalizer of
+        // MurmurHash3 to mix the lower bits used by the table
+        uint32_t hash = (static_cast<uint32_t>(cell[1]) * 19349663U) ^
+                        (static_cast<uint32_t>(cell[2]) * 83492791U);
+        hash ^= hash >> 16;
+        hash *= 0x85EBCA6BU;
+        hash ^= hash >> 13;
+        return hash + static_cast<uint32_t>(cell[0]);
+    }
+
+    /// Returns the bucket of the hash table of the given cell
+    auto bucketOf(const Cell& cell) const -> uint32_t {
+        return hashCell(cell) & m_BucketMask;
+    }
+
+    /// Clips the range of cells [lo, hi] to the cells holding points, and
+    /// returns whether or not the clipped range is non-empty
+    auto clipToBounds(Cell& lo, Cell& hi) const -> bool {
+        for (uint32_t d = 0; d < 3; ++d) {
+            lo[d] = std::max(lo[d], m_CellMin[d]);
+            hi[d] = std::min(hi[d], m_CellMax[d]);
+            if (lo[d] > hi[d]) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /// Returns the number of cells in the range [lo, hi]
+    static auto numCells(const Cell& lo, const Cell& hi) -> uint64_t {
+        uint64_t count = 1;
+        for (uint32_t d = 0; d < 3; ++d) {
+            count *= static_cast<uint64_t>(static_cast<int64_t>(hi[d]) -
+                                           static_cast<int64_t>(lo[d]) + 1);
+        }
+        return count;
+    }
+
+    /// Calls fn(slot) for each point (by its position in the sorted points)
+    /// of the cells from the given one up to last_x along x. The row must
+    /// have at most as many cells as there are buckets
+    template <typename Fn>
+    auto visitRow(const Cell& first, int32_t last_x, Fn fn) const -> void {
+        auto visit_buckets = [&](uint32_t begin, uint32_t end) {
+            const auto slot_end = m_BucketStart[end];
+            for (uint32_t slot = m_BucketStart[begin]; slot < slot_end;
+                 ++slot) {
+                const auto cell = cellOf(m_Points[slot]);
+                if (cell[1] == first[1] && cell[2] == first[2] &&
+                    cell[0] >= first[0] && cell[0] <= last_x) {
+                    fn(slot);
+                }
+            }
+        };
+        // The buckets of the row, which might wrap around the table
+        const uint32_t begin = bucketOf(first);
+        const uint32_t end = begin + static_cast<uint32_t>(
+                                         static_cast<int64_t>(last_x) -
+                                         static_cast<int64_t>(first[0]) + 1);
+        if (end <= m_BucketMask + 1) {
+            visit_buckets(begin, end);
+        } else {
+            visit_buckets(begin, m_BucketMask + 1);
+            visit_buckets(0, end - (m_BucketMask + 1));
+        }
+    }
+
+    /// Calls fn(slot) for each point of the cells in the range [lo, hi], or
+    /// for all points if that range has more cells than the grid has points
+    template <typename Fn>
+    auto visitCells(const Cell& lo, const Cell& hi, Fn fn) const -> void {
+        if (numCells(lo, hi) > static_cast<uint64_t>(size())) {
+            for (uint32_t slot = 0; slot < m_Indices.size(); ++slot) {
+                fn(slot);
+            }
+            return;
+        }
+        Cell cell = lo;
+        for (cell[2] = lo[2]; cell[2] <= hi[2]; ++cell[2]) {
+            for (cell[1] = lo[1]; cell[1] <= hi[1]; ++cell[1]) {
+                visitRow(cell, hi[0], fn);
+            }
+        }
+    }
+
+    /// Calls fn(i, j) for each pair of points within a distance, whose first
+    /// point is in the given range of slots (see queryPairs)
+    template <typename Fn>
+    auto queryPairsRange(T radius, size_t begin, size_t end, Fn fn) const
+        -> void;
+
+    /// Length of the side of the cells
+    T m_CellSize = static_cast<T>(1.0);
+    /// Inverse of the length of the side of the cells
+    T m_InvCellSize = static_cast<T>(1.0);
+    /// Mask that maps a hash to a bucket (the number of buckets minus one)
+    uint32_t m_BucketMask = 0;
+    /// Lower (x, y, z) coordinates of the cells holding points
+    Cell m_CellMin = {{0, 0, 0}};
+    /// Upper (x, y, z) coordinates of the cells holding points
+    Cell m_CellMax = {{-1, -1, -1}};
+    /// Position of the first point of each bucket (plus the total at the end)
+    std::vector<uint32_t> m_BucketStart;
+    /// Points of the grid, sorted by bucket
+    std::vector<Vec3> m_Points;
+    /// Index (as given to build) of each of the sorted points
+    std::vector<uint32_t> m_Indices;
+};
+
+template <typename T>
+auto SpatialHashGrid<T>::build(const Vec3* points, size_t num, T cell_size)
+    -> void {
+    assert(cell_size > static_cast<T>(0.0));
+    assert(num <= MAX_POINTS);
+    m_CellSize = cell_size;
+    m_InvCellSize = static_cast<T>(1.0) / cell_size;
+    // About one bucket per point, as a power of two so the hashes are masked
+    size_t num_buckets = 1;
+    while (num_buckets < num) {
+        num_buckets *= 2;
+    }
+    m_BucketMask = static_cast<uint32_t>(num_buckets - 1);
+    m_BucketStart.assign(num_buckets + 1, 0);
+    m_Points.resize(num);
+    m_Indices.resize(num);
+    m_CellMin.fill(std::numeric_limits<int32_t>::max());
+    m_CellMax.fill(std::numeric_limits<int32_t>::min());
+    if (num == 0) {
+        return;
+    }
+
+    // Counting sort by bucket, with the points split into contiguous chunks
+    // (one per thread). Each chunk computes the buckets of its points, the
+    // bounds of their cells, and its own histogram of the buckets
+    const size_t num_chunks = std::max(
+        static_cast<size_t>(1),
+        std::min(parallel::GetNumThreads(), num / MIN_POINTS_PER_THREAD));
+    const size_t chunk_size = (num + num_chunks - 1) / num_chunks;
+    std::vector<uint32_t> buckets(num);
+    std::vector<uint32_t> counts(num_chunks * num_buckets, 0);
+    std::mutex bounds_mutex;
+    parallel::ParallelFor(
+        num_chunks,
+        [&](size_t chunks_begin, size_t chunks_end) {
+            for (size_t chunk = chunks_begin; chunk < chunks_end; ++chunk) {
+                auto* chunk_counts = counts.data() + chunk * num_buckets;
+                Cell cell_min;
+                Cell cell_max;
+                cell_min.fill(std::numeric_limits<int32_t>::max());
+                cell_max.fill(std::numeric_limits<int32_t>::min());
+                const size_t begin = chunk * chunk_size;
+                const size_t end = std::min(num, begin + chunk_size);
+                for (size_t i = begin; i < end; ++i) {
+                    const auto cell = cellOf(points[i]);
+                    buckets[i] = bucketOf(cell);
+                    for (uint32_t d = 0; d < 3; ++d) {
+                        cell_min[d] = std::min(cell_min[d], cell[d]);
+                        cell_max[d] = std::max(cell_max[d], cell[d]);
+                    }
+                }
+                // Separate loop, so the one above can still be vectorized
+                for (size_t i = begin; i < end; ++i) {
+                    ++chunk_counts[buckets[i]];
+                }
+                std::lock_guard<std::mutex> lock(bounds_mutex);
+                for (uint32_t d = 0; d < 3; ++d) {
+                    m_CellMin[d] = std::min(m_CellMin[d], cell_min[d]);
+                    m_CellMax[d] = std::max(m_CellMax[d], cell_max[d]);
+                }
+            }
+        },
+        1);
+
+    // A single prefix sum over (bucket, chunk) turns the histograms into the
+    // first slot of each chunk in each bucket, so the points of a bucket end
+    // up in the order of their indices, regardless of the number of chunks
+    uint32_t offset = 0;
+    for (size_t k = 0; k < num_buckets; ++k) {
+        m_BucketStart[k] = offset;
+        for (size_t chunk = 0; chunk < num_chunks; ++chunk) {
+            auto& count = counts[chunk * num_buckets + k];
+            const auto chunk_offset = offset;
+            offset += count;
+            count = chunk_offset;
+        }
+    }
+    m_BucketStart[num_buckets] = offset;
+
+    // Each chunk scatters its own points, into slots no other chunk writes to
+    parallel::ParallelFor(
+        num_chunks,
+        [&](size_t chunks_begin, size_t chunks_end) {
+            for (size_t chunk = chunks_begin; chunk < chunks_end; ++chunk) {
+                auto* cursors = counts.data() + chunk * num_buckets;
+                const size_t end = std::min(num, (chunk + 1) * chunk_size);
+                for (size_t i = chunk * chunk_size; i < end; ++i) {
+                    m_Indices[cursors[buckets[i]]++] = static_cast<uint32_t>(i);
+                }
+            }
+        },
+        1);
+
+    // Gather the points in bucket order (cheaper than scattering these along
+    // with the indices, as the writes are sequential)
+    parallel::ParallelFor(
+        num,
+        [&](size_t begin, size_t end) {
+            for (size_t slot = begin; slot < end; ++slot) {
+                m_Points[slot] = points[m_Indices[slot]];
+            }
+        },
+        MIN_POINTS_PER_THREAD);
+}
+
+template <typename T>
+template <typename Fn>
+auto SpatialHashGrid<T>::queryRadius(const Vec3& center, T radius, Fn fn) const
+    -> void {
+    if (empty() || !(radius >= static_cast<T>(0.0))) {
+        return;
+    }
+    const T radius_sq = radius * radius;
+    const Vec3 extent(radius, radius, radius);
+    auto lo = cellOf(center - extent);
+    auto hi = cellOf(center + extent);
+    if (!clipToBounds(lo, hi)) {
+        return;
+    }
+    visitCells(lo, hi, [&](uint32_t slot) {
+        const T dist_sq = (m_Points[slot] - center).lengthSquare();
+        if (dist_sq <= radius_sq) {
+            fn(static_cast<size_t>(m_Indices[slot]), dist_sq);
+        }
+    });
+}
+
+template <typename T>
+auto SpatialHashGrid<T>::queryRadius(const Vec3& center, T radius) const
+    -> std::vector<size_t> {
+    std::vector<size_t> hits;
+    queryRadius(center, radius,
+                [&hits](size_t index, T) { hits.push_back(index); });
+    return hits;
+}
+
+template <typename T>
+auto SpatialHashGrid<T>::queryKNearest(const Vec3& point, size_t k) const
+    -> std::vector<size_t> {
+    k = std::min(k, size());
+    if (k == 0) {
+        return {};
+    }
+    // Max-heap of the k closest points found so far, by (dist_sq, index)
+    using Candidate = std::pair<T, uint32_t>;
+    std::vector<Candidate> best;
+    best.reserve(k + 1);
+    auto visit = [&](uint32_t slot) {
+        const Candidate candidate((m_Points[slot] - point).lengthSquare(),
+                                  m_Indices[slot]);
+        if (best.size() < k || candidate < best.front()) {
+            best.push_back(candidate);
+            std::push_heap(best.begin(), best.end());
+            if (best.size() > k) {
+                std::pop_heap(best.begin(), best.end());
+                best.pop_back();
+            }
+        }
+    };
+
+    // The ring at distance L holds the cells whose coordinates differ from
+    // the ones of the cell of the point by at most L, and by L along at least
+    // one axis. The rings closer than the bounds of the cells are empty
+    const auto center = cellOf(point);
+    int64_t ring = 0;
+    for (uint32_t d = 0; d < 3; ++d) {
+        ring = std::max(ring, static_cast<int64_t>(m_CellMin[d]) - center[d]);
+        ring = std::max(ring, static_cast<int64_t>(center[d]) - m_CellMax[d]);
+    }
+    for (;; ++ring) {
+        // Range of the cells up to this ring, clipped to the bounds
+        Cell lo;
+        Cell hi;
+        bool covers_bounds = true;
+        for (uint32_t d = 0; d < 3; ++d) {
+            const int64_t first = static_cast<int64_t>(center[d]) - ring;
+            const int64_t last = static_cast<int64_t>(center[d]) + ring;
+            lo[d] = static_cast<int32_t>(
+                std::max(first, static_cast<int64_t>(m_CellMin[d])));
+            hi[d] = static_cast<int32_t>(
+                std::min(last, static_cast<int64_t>(m_CellMax[d])));
+            covers_bounds = covers_bounds && first <= m_CellMin[d] &&
+                            last >= m_CellMax[d];
+        }
+        // Once there are more cells than points (e.g. for sparse points, or
+        // far away from them), scanning all the points is cheaper
+        if (numCells(lo, hi) > static_cast<uint64_t>(size())) {
+            best.clear();
+            for (uint32_t slot = 0; slot < m_Indices.size(); ++slot) {
+                visit(slot);
+            }
+            break;
+        }
+        Cell cell;
+        for (cell[2] = lo[2]; cell[2] <= hi[2]; ++cell[2]) {
+            const bool z_on_ring =
+                std::abs(int64_t{cell[2]} - center[2]) == ring;
+            for (cell[1] = lo[1]; cell[1] <= hi[1]; ++cell[1]) {
+                if (z_on_ring ||
+                    std::abs(int64_t{cell[1]} - center[1]) == ring) {
+                    cell[0] = lo[0];
+                    visitRow(cell, hi[0], visit);
+                    continue;
+                }
+                // Off the faces of the ring along z and y, only its two ends
+                // along x are on the ring
+                for (const int64_t x : {center[0] - ring, center[0] + ring}) {
+                    if (x >= lo[0] && x <= hi[0]) {
+                        cell[0] = static_cast<int32_t>(x);
+                        visitRow(cell, cell[0], visit);
+                    }
+                }
+            }
+        }
+        // The cells past this ring are farther than the faces of the box of
+        // cells visited so far (at least ring * cell_size away), less a few
+        // ulps in case some points were binned into the next cell by rounding
+        T reach = std::numeric_limits<T>::max();
+        for (uint32_t d = 0; d < 3; ++d) {
+            const T lower = static_cast<T>(center[d] - ring) * m_CellSize;
+            const T upper = static_cast<T>(center[d] + ring + 1) * m_CellSize;
+            const T slack = 4 * std::numeric_limits<T>::epsilon() *
+                            std::max(std::abs(lower), std::abs(upper));
+            reach = std::min(reach, std::min(point[d] - lower,
+                                             upper - point[d]) - slack);
+        }
+        reach = std::max(reach, static_cast<T>(0.0));
+        if (covers_bounds ||
+            (best.size() == k && best.front().first <= reach * reach)) {
+            break;
+        }
+    }
+
+    std::sort_heap(best.begin(), best.end());
+    std::vector<size_t> indices(best.size());
+    for (size_t i = 0; i < best.size(); ++i) {
+        indices[i] = static_cast<size_t>(best[i].second);
+    }
+    return indices;
+}
+
+template <typename T>
+template <typename Fn>
+auto SpatialHashGrid<T>::queryPairsRange(T radius, size_t begin, size_t end,
+                                         Fn fn) const -> void {
+    if (!(radius >= static_cast<T>(0.0))) {
+        return;
+    }
+    const T radius_sq = radius * radius;
+    const Vec3 extent(radius, radius, radius);
+    for (size_t slot_a = begin; slot_a < end; ++slot_a) {
+        const auto& point = m_Points[slot_a];
+        auto lo = cellOf(point - extent);
+        auto hi = cellOf(point + extent);
+        clipToBounds(lo, hi);
+        // Each pair is found from both of its points, so it's only reported
+        // from the one that comes first in the sorted points
+        visitCells(lo, hi, [&](uint32_t slot_b) {
+            if (slot_b <= slot_a ||
+                (m_Points[slot_b] - point).lengthSquare() > radius_sq) {
+                return;
+            }
+            const auto index_a = static_cast<size_t>(m_Indices[slot_a]);
+            const auto index_b = static_cast<size_t>(m_Indices[slot_b]);
+            fn(std::min(index_a, index_b), std::max(index_a, index_b));
+        });
+    }
+}
+
+template <typename T>
+template <typename Fn>
+auto SpatialHashGrid<T>::queryPairs(T radius, Fn fn) const -> void {
+    queryPairsRange(radius, 0, size(), fn);
+}
+
+template <typename T>
+auto SpatialHashGrid<T>::queryPairs(T radius) const
+    -> std::vector<std::pair<size_t, size_t>> {
+    std::vector<std::pair<size_t, size_t>> pairs;
+    std::mutex pairs_mutex;
+    parallel::ParallelFor(
+        size(),
+        [&](size_t begin, size_t end) {
+            std::vector<std::pair<size_t, size_t>> range_pairs;
+            queryPairsRange(radius, begin, end,
+                            [&range_pairs](size_t index_a, size_t index_b) {
+                                range_pairs.emplace_back(index_a, index_b);
+                            });
+            std::lock_guard<std::mutex> lock(pairs_mutex);
+            pairs.insert(pairs.end(), range_pairs.begin(), range_pairs.end());
+        },
+        MIN_POINTS_PER_THREAD);
+    return pairs;
+}
+
+}  // namespace math
@@ -15,6 +15,7 @@
 #include <initializer_list>
 
 #include <math/common.hpp>
+#include <math/fast_math.hpp>
 #include <math/vec3_t_decl.hpp>
 
 #define CLAMP(x, min_x, max_x) std::max(std::min(x, max_x), min_x)
@@ -27,12 +28,17 @@ class SphericalCoords {
     SphericalCoords() = default;
 
     explicit SphericalCoords(T p_rho, T p_theta, T p_phi)
-        : rho(p_rho), theta(p_theta), phi(p_phi) {}
+        : rho(p_rho), phi(p_phi), theta(p_theta) {}
 
+    // The conversions take a trigonometric policy, which uses the functions
+    // of <cmath> by default (see math/fast_math_decl.hpp)
+
+    template <typename Trig = fast::StdTrig>
     auto SetFromCartesian(const Vector3<T>& vec) -> void {
-        SetFromCartesian(vec.x(), vec.y(), vec.z());
+        SetFromCartesian<Trig>(vec.x(), vec.y(), vec.z());
     }
 
+    template <typename Trig = fast::StdTrig>
     auto SetFromCartesian(T x, T y, T z) -> void {
         rho = std::sqrt(x * x + y * y + z * z);
         constexpr auto EPS_RADIUS = static_cast<T>(1e-10);
@@ -40,18 +46,18 @@ class SphericalCoords {
             theta = static_cast<T>(0.0);
             phi = static_cast<T>(0.0);
         } else {
-            theta = std::atan2(y, x);
+            theta = Trig::atan2(y, x);
             constexpr auto MIN_RATIO = static_cast<T>(-1.0);
             constexpr auto MAX_RATIO = static_cast<T>(1.0);
-            phi = std::acos(CLAMP(z / rho, MIN_RATIO, MAX_RATIO));
+            phi = Trig::acos(CLAMP(z / rho, MIN_RATIO, MAX_RATIO));
         }
     }
 
+    template <typename Trig = fast::StdTrig>
     auto GetCartesian() const -> Vector3<T> {
-        const auto sin_theta = std::sin(theta);  // NOLINT
-        const auto cos_theta = std::cos(theta);  // NOLINT
-        const auto sin_phi = std::sin(phi);      // NOLINT
-        const auto cos_phi = std::cos(phi);      // NOLINT
+        T sin_theta, cos_theta, sin_phi, cos_phi;  // NOLINT
+        Trig::sincos(theta, sin_theta, cos_theta);
+        Trig::sincos(phi, sin_phi, cos_phi);
 
         auto x = rho * cos_theta * sin_phi;
         auto y = rho * sin_theta * sin_phi;
@@ -15,10 +15,9 @@ template <typename T>
 MATH3D_INLINE auto lerp(const Vector2<T>& vec_a, const Vector2<T>& vec_b,
                         T alpha) -> Vector2<T> {
     Vector2<T> result;
-#if defined(MATH3D_AVX_ENABLED)
-    // TODO(wilbert): implement AVX kernel
-#elif defined(MATH3D_SSE_ENABLED)
-    // TODO(wilbert): implement SSE kernel
+#if defined(MATH3D_AVX_ENABLED) || defined(MATH3D_SSE_ENABLED)
+    sse::kernel_lerp_vec2<T>(result.elements(), vec_a.elements(),
+                             vec_b.elements(), alpha);
 #else
     scalar::kernel_lerp_vec2<T>(result.elements(), vec_a.elements(),
                                 vec_b.elements(), alpha);
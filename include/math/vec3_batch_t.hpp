@@ -0,0 +1,336 @@
+#pragma once
+
+#include "./dispatch.hpp"
+#include "./vec3_batch_t_decl.hpp"
+#include "./vec3_t.hpp"
+
+#include "./impl/vec3_batch_t_scalar_impl.hpp"
+#include "./impl/vec3_batch_t_sse_impl.hpp"
+#include "./impl/vec3_batch_t_avx_impl.hpp"
+#include "./impl/vec3_batch_t_avx512_impl.hpp"
+
+namespace math {
+
+// ***************************************************************************//
+//                Vector3Batch helper functions and operators                 //
+// ***************************************************************************//
+
+/// \brief Returns the element-wise sum of two batches of 3d vectors
+///
+/// \tparam T Type of scalar used by both batch operands
+///
+/// \param[in] lhs Left-hand-side operand of the vector-sum
+/// \param[in] rhs Right-hand-side operand of the vector-sum (same size)
+template <typename T>
+auto operator+(const Vector3Batch<T>& lhs, const Vector3Batch<T>& rhs)
+    -> Vector3Batch<T> {
+    assert(lhs.size() == rhs.size());
+    Vector3Batch<T> dst(lhs.size());
+    MATH3D_DISPATCH_KERNEL(kernel_add_vec3_batch<T>, dst.planes(),
+                           lhs.planes(), rhs.planes(), lhs.size());
+    return dst;
+}
+
+/// \brief Returns the element-wise difference of two batches of 3d vectors
+///
+/// \tparam T Type of scalar used by both batch operands
+///
+/// \param[in] lhs Left-hand-side operand of the vector-difference
+/// \param[in] rhs Right-hand-side operand of the vector-difference (same size)
+template <typename T>
+auto operator-(const Vector3Batch<T>& lhs, const Vector3Batch<T>& rhs)
+    -> Vector3Batch<T> {
+    assert(lhs.size() == rhs.size());
+    Vector3Batch<T> dst(lhs.size());
+    MATH3D_DISPATCH_KERNEL(kernel_sub_vec3_batch<T>, dst.planes(),
+                           lhs.planes(), rhs.planes(), lhs.size());
+    return dst;
+}
+
+/// \brief Returns all vectors of the batch scaled by the given scalar
+///
+/// \tparam T Type of scalar used by the batch operand
+///
+/// \param[in] scale Scalar value by which to scale the second operand
+/// \param[in] batch Batch of 3d vectors which we want to scale
+template <typename T>
+auto operator*(double scale, const Vector3Batch<T>& batch) -> Vector3Batch<T> {
+    Vector3Batch<T> dst(batch.size());
+    MATH3D_DISPATCH_KERNEL(kernel_scale_vec3_batch<T>, dst.planes(),
+                           static_cast<T>(scale), batch.planes(),
+                           batch.size());
+    return dst;
+}
+
+/// \brief Returns all vectors of the batch scaled by the given scalar
+///
+/// \tparam T Type of scalar used by the batch operand
+///
+/// \param[in] batch Batch of 3d vectors which we want to scale
+/// \param[in] scale Scalar value by which to scale the first operand
+template <typename T>
+auto operator*(const Vector3Batch<T>& batch, double scale) -> Vector3Batch<T> {
+    return scale * batch;
+}
+
+/// \brief Returns the element-wise product of two batches of 3d vectors
+///
+/// \tparam T Type of scalar used by both batch operands
+///
+/// \param[in] lhs Left-hand-side operand of the element-wise product
+/// \param[in] rhs Right-hand-side operand of the element-wise product
+template <typename T>
+auto operator*(const Vector3Batch<T>& lhs, const Vector3Batch<T>& rhs)
+    -> Vector3Batch<T> {
+    assert(lhs.size() == rhs.size());
+    Vector3Batch<T> dst(lhs.size());
+    MATH3D_DISPATCH_KERNEL(kernel_hadamard_vec3_batch<T>, dst.planes(),
+                           lhs.planes(), rhs.planes(), lhs.size());
+    return dst;
+}
+
+/// \brief Computes the dot-product of each pair of vectors of two batches
+///
+/// \param[out] dst Array where to store the dot-products (of size lhs.size())
+/// \param[in] lhs Left-hand-side operand of the dot-product
+/// \param[in] rhs Right-hand-side operand of the dot-product (same size)
+template <typename T>
+auto dot(const Vector3Batch<T>& lhs, const Vector3Batch<T>& rhs, T* dst)
+    -> void {
+    assert(lhs.size() == rhs.size());
+    MATH3D_DISPATCH_KERNEL(kernel_dot_vec3_batch<T>, dst, lhs.planes(),
+                           rhs.planes(), lhs.size());
+}
+
+/// \brief Returns the dot-product of each pair of vectors of two batches
+template <typename T>
+auto dot(const Vector3Batch<T>& lhs, const Vector3Batch<T>& rhs)
+    -> std::vector<T> {
+    std::vector<T> dst(lhs.size());
+    dot<T>(lhs, rhs, dst.data());
+    return dst;
+}
+
+/// \brief Returns the cross-product of each pair of vectors of two batches
+template <typename T>
+auto cross(const Vector3Batch<T>& lhs, const Vector3Batch<T>& rhs)
+    -> Vector3Batch<T> {
+    assert(lhs.size() == rhs.size());
+    Vector3Batch<T> dst(lhs.size());
+    MATH3D_DISPATCH_KERNEL(kernel_cross_vec3_batch<T>, dst.planes(),
+                           lhs.planes(), rhs.planes(), lhs.size());
+    return dst;
+}
+
+/// \brief Computes the square of the norm-2 of each vector of the batch
+///
+/// \param[in] batch The batch of vectors whose norms we want
+/// \param[out] dst Array where to store the results (of size batch.size())
+template <typename T>
+auto squareNorm(const Vector3Batch<T>& batch, T* dst) -> void {
+    MATH3D_DISPATCH_KERNEL(kernel_length_square_vec3_batch<T>, dst,
+                           batch.planes(), batch.size());
+}
+
+/// \brief Returns the square of the norm-2 of each vector of the batch
+template <typename T>
+auto squareNorm(const Vector3Batch<T>& batch) -> std::vector<T> {
+    std::vector<T> dst(batch.size());
+    squareNorm<T>(batch, dst.data());
+    return dst;
+}
+
+/// \brief Computes the norm-2 of each vector of the batch
+///
+/// \param[in] batch The batch of vectors whose norms we want
+/// \param[out] dst Array where to store the results (of size batch.size())
+template <typename T>
+auto norm(const Vector3Batch<T>& batch, T* dst) -> void {
+    MATH3D_DISPATCH_KERNEL(kernel_length_vec3_batch<T>, dst, batch.planes(),
+                           batch.size());
+}
+
+/// \brief Returns the norm-2 of each vector of the batch
+template <typename T>
+auto norm(const Vector3Batch<T>& batch) -> std::vector<T> {
+    std::vector<T> dst(batch.size());
+    norm<T>(batch, dst.data());
+    return dst;
+}
+
+/// \brief Returns a batch with the normalized version of the given vectors
+template <typename T>
+auto normalize(const Vector3Batch<T>& batch) -> Vector3Batch<T> {
+    Vector3Batch<T> dst(batch.size());
+    MATH3D_DISPATCH_KERNEL(kernel_normalize_vec3_batch<T>, dst.planes(),
+                           batch.planes(), batch.size());
+    return dst;
+}
+
+/// \brief Normalizes in-place all vectors of the given batch
+template <typename T>
+auto normalize_in_place(Vector3Batch<T>& batch) -> void {  // NOLINT
+    MATH3D_DISPATCH_KERNEL(kernel_normalize_vec3_batch<T>, batch.planes(),
+                           batch.planes(), batch.size());
+}
+
+/// \brief Prints the given batch of 3d vectors to the given output stream
+template <typename T>
+auto operator<<(std::ostream& output_stream, const Vector3Batch<T>& src)
+    -> std::ostream& {
+    output_stream << src.toString();
+    return output_stream;
+}
+
+// ***************************************************************************//
+//            Batch operations over arrays of Vector3 (AoS storage)           //
+// ***************************************************************************//
+
+/// \brief Computes the dot-product of each pair of vectors of two arrays
+///
+/// \tparam T Type of scalar used by the 3d vectors
+///
+/// \param[in] lhs Array of left-hand-side operands of the dot-product
+/// \param[in] rhs Array of right-hand-side operands of the dot-product
+/// \param[out] dst Array where to store the dot-products
+/// \param[in] num Number of vectors in each of the arrays
+template <typename T>
+auto dot(const Vector3<T>* lhs, const Vector3<T>* rhs, T* dst, size_t num)
+    -> void {
+    MATH3D_DISPATCH_KERNEL(kernel_dot_vec3_aos<T>, dst, aos_cast<T>(lhs),
+                           aos_cast<T>(rhs), num);
+}
+
+/// \brief Computes the cross-product of each pair of vectors of two arrays
+///
+/// \tparam T Type of scalar used by the 3d vectors
+///
+/// \param[in] lhs Array of left-hand-side operands of the cross-product
+/// \param[in] rhs Array of right-hand-side operands of the cross-product
+/// \param[out] dst Array where to store the results (can alias lhs or rhs)
+/// \param[in] num Number of vectors in each of the arrays
+template <typename T>
+auto cross(const Vector3<T>* lhs, const Vector3<T>* rhs, Vector3<T>* dst,
+           size_t num) -> void {
+    MATH3D_DISPATCH_KERNEL(kernel_cross_vec3_aos<T>, aos_cast<T>(dst),
+                           aos_cast<T>(lhs), aos_cast<T>(rhs), num);
+}
+
+/// \brief Computes the square of the norm-2 of each vector of the array
+template <typename T>
+auto squareNorm(const Vector3<T>* vecs, T* dst, size_t num) -> void {
+    MATH3D_DISPATCH_KERNEL(kernel_length_square_vec3_aos<T>, dst,
+                           aos_cast<T>(vecs), num);
+}
+
+/// \brief Computes the norm-2 of each vector of the array
+template <typename T>
+auto norm(const Vector3<T>* vecs, T* dst, size_t num) -> void {
+    MATH3D_DISPATCH_KERNEL(kernel_length_vec3_aos<T>, dst, aos_cast<T>(vecs),
+                           num);
+}
+
+/// \brief Writes the normalized version of each vector of the array to `dst`
+template <typename T>
+auto normalize(const Vector3<T>* vecs, Vector3<T>* dst, size_t num) -> void {
+    MATH3D_DISPATCH_KERNEL(kernel_normalize_vec3_aos<T>, aos_cast<T>(dst),
+                           aos_cast<T>(vecs), num);
+}
+
+/// \brief Normalizes in-place all vectors of the given array
+template <typename T>
+auto normalize_in_place(Vector3<T>* vecs, size_t num) -> void {  // NOLINT
+    MATH3D_DISPATCH_KERNEL(kernel_normalize_vec3_aos<T>, aos_cast<T>(vecs),
+                           aos_cast<T>(vecs), num);
+}
+
+/// \brief Linearly interpolates between each pair of vectors of two arrays
+///
+/// \tparam T Type of scalar used by the 3d vectors
+///
+/// \param[in] vec_a Array of start points of the interpolation
+/// \param[in] vec_b Array of end points of the interpolation
+/// \param[in] alpha Interpolation parameter, shared by all pairs
+/// \param[out] dst Array where to store the results (can alias vec_a or vec_b)
+/// \param[in] num Number of vectors in each of the arrays
+template <typename T>
+auto lerp(const Vector3<T>* vec_a, const Vector3<T>* vec_b, T alpha,
+          Vector3<T>* dst, size_t num) -> void {
+    MATH3D_DISPATCH_KERNEL(kernel_lerp_vec3_aos<T>, aos_cast<T>(dst),
+                           aos_cast<T>(vec_a), aos_cast<T>(vec_b), alpha, num);
+}
+
+/// \brief Linearly interpolates between each pair of vectors of two arrays,
+/// using the interpolation parameter given for each pair in `alpha`
+template <typename T>
+auto lerp(const Vector3<T>* vec_a, const Vector3<T>* vec_b, const T* alpha,
+          Vector3<T>* dst, size_t num) -> void {
+    MATH3D_DISPATCH_KERNEL(kernel_lerp_vec3_aos<T>, aos_cast<T>(dst),
+                           aos_cast<T>(vec_a), aos_cast<T>(vec_b), alpha, num);
+}
+
+// ***************************************************************************//
+//                         Vector3Batch-type methods                          //
+// ***************************************************************************//
+
+template <typename T>
+auto Vector3Batch<T>::resize(size_t size) -> void {
+    const size_t stride =
+        ((size + PLANE_PADDING - 1) / PLANE_PADDING) * PLANE_PADDING;
+    const size_t num_kept = std::min(size, m_Size);
+    if (stride != m_Stride) {
+        BufferType elements(3 * stride, static_cast<T>(0));
+        for (size_t plane = 0; plane < 3; ++plane) {
+            std::copy_n(m_Elements.data() + plane * m_Stride, num_kept,
+                        elements.data() + plane * stride);
+        }
+        m_Elements.swap(elements);
+        m_Stride = stride;
+    } else if (size < m_Size) {
+        // Keep the padding zeroed, in case the batch grows back later
+        for (size_t plane = 0; plane < 3; ++plane) {
+            std::fill(m_Elements.data() + plane * m_Stride + size,
+                      m_Elements.data() + plane * m_Stride + m_Size,
+                      static_cast<T>(0));
+        }
+    }
+    m_Size = size;
+}
+
+template <typename T>
+auto Vector3Batch<T>::fromAoS(const Vec3* vectors, size_t size) -> void {
+    resize(size);
+    if (size == 0) {
+        return;
+    }
+    MATH3D_DISPATCH_KERNEL(kernel_aos_to_soa_vec3<T>, planes(),
+                           aos_cast<T>(vectors), size);
+}
+
+template <typename T>
+auto Vector3Batch<T>::toAoS(Vec3* vectors) const -> void {
+    if (m_Size == 0) {
+        return;
+    }
+    MATH3D_DISPATCH_KERNEL(kernel_soa_to_aos_vec3<T>, aos_cast<T>(vectors),
+                           planes(), m_Size);
+}
+
+template <typename T>
+auto Vector3Batch<T>::toVector() const -> std::vector<Vec3> {
+    std::vector<Vec3> vectors(m_Size);
+    toAoS(vectors.data());
+    return vectors;
+}
+
+template <typename T>
+auto Vector3Batch<T>::normalize() -> void {
+    ::math::normalize_in_place<T>(*this);
+}
+
+template <typename T>
+auto Vector3Batch<T>::normalized() const -> Vector3Batch<T> {
+    return ::math::normalize<T>(*this);
+}
+
+}  // namespace math
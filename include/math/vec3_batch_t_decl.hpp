@@ -0,0 +1,225 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "./aligned_allocator.hpp"
+#include "./common.hpp"
+#include "./vec3_t_decl.hpp"
+
+namespace math {
+
+/// \struct Vector3Planes
+///
+/// \brief Non-owning view of a batch of 3d vectors stored as SoA
+///
+/// \tparam T Type of scalar of the planes (use `const T` for read-only views)
+///
+/// This is what the batch kernels operate on: three planes of scalars, with
+/// the i-th vector given by (x[i], y[i], z[i]).
+template <typename T>
+struct Vector3Planes {
+    /// Plane holding the x-coordinates of the batch
+    T* x = nullptr;
+    /// Plane holding the y-coordinates of the batch
+    T* y = nullptr;
+    /// Plane holding the z-coordinates of the batch
+    T* z = nullptr;
+
+    /// Constructs an empty view
+    Vector3Planes() = default;
+
+    /// Constructs a view of the given planes
+    Vector3Planes(T* x_plane, T* y_plane, T* z_plane)
+        : x(x_plane), y(y_plane), z(z_plane) {}
+
+    /// Returns a view of the same planes, starting at the given index
+    auto offset(size_t index) const -> Vector3Planes<T> {
+        return {x + index, y + index, z + index};
+    }
+
+    /// Converts a mutable view into a read-only one
+    // NOLINTNEXTLINE(google-explicit-constructor)
+    operator Vector3Planes<const T>() const { return {x, y, z}; }
+};
+
+/// \brief Returns a pointer to the scalars of an array of 3d vectors
+///
+/// Vector3 is a standard-layout wrapper around its buffer of scalars, so an
+/// array of them is just the interleaved coordinates (x0 y0 z0 x1 ...). This
+/// also avoids dereferencing the array if it's empty (or nullptr)
+template <typename T>
+MATH3D_INLINE auto aos_cast(Vector3<T>* vecs) -> T* {
+    return reinterpret_cast<T*>(vecs);  // NOLINT
+}
+
+template <typename T>
+MATH3D_INLINE auto aos_cast(const Vector3<T>* vecs) -> const T* {
+    return reinterpret_cast<const T*>(vecs);  // NOLINT
+}
+
+/// \class Vector3Batch
+///
+/// \brief Batch of 3d vectors stored as a structure of arrays (SoA)
+///
+/// \tparam T Type of scalar value used for the 3d-vectors (float|double)
+///
+/// Stores the x, y and z coordinates of a batch of vectors in three separate
+/// planes, so the batch kernels can load a full SIMD register of the same
+/// coordinate at once (4 or 8 vectors per instruction, depending on the ISA
+/// selected at runtime, see dispatch.hpp). Each plane is aligned to a 64-byte
+/// boundary, and padded to a multiple of 64 bytes.
+///
+/// For data already stored as arrays of Vector3 (e.g. std::vector<Vector3>),
+/// the batch operations also have overloads taking `const Vector3<T>*` plus a
+/// count, which transpose the vectors in registers and avoid any copy.
+template <typename T>
+class Vector3Batch {
+ public:
+    /// Alignment (in bytes) of each one of the planes
+    static constexpr uint32_t ALIGNMENT = 64;
+    /// Each plane is padded to a multiple of this number of scalars
+    static constexpr uint32_t PLANE_PADDING = ALIGNMENT / sizeof(T);
+
+    // Some handy type aliases used throught the codebase
+    using Type = Vector3Batch<T>;
+    using ElementType = T;
+    using BufferType = std::vector<T, AlignedAllocator<T, ALIGNMENT>>;
+
+    // Some related types
+    using Vec3 = Vector3<T>;
+
+    /// Constructs an empty batch
+    Vector3Batch() = default;
+
+    /// Constructs a batch of the given size, with all vectors set to zero
+    explicit Vector3Batch(size_t size) { resize(size); }
+
+    /// Constructs a batch of the given size, with all vectors set to `value`
+    explicit Vector3Batch(size_t size, const Vec3& value) {
+        resize(size);
+        std::fill_n(x(), size, value.x());
+        std::fill_n(y(), size, value.y());
+        std::fill_n(z(), size, value.z());
+    }
+
+    /// Constructs a batch by gathering the given array of vectors
+    explicit Vector3Batch(const Vec3* vectors, size_t size) {
+        fromAoS(vectors, size);
+    }
+
+    /// Constructs a batch by gathering the given vector of vectors
+    explicit Vector3Batch(const std::vector<Vec3>& vectors) {
+        fromAoS(vectors.data(), vectors.size());
+    }
+
+    /// Returns the number of vectors in the batch
+    auto size() const -> size_t { return m_Size; }
+
+    /// Returns whether or not the batch has no vectors
+    auto empty() const -> bool { return m_Size == 0; }
+
+    /// Returns the distance (in scalars) between the start of two planes
+    auto stride() const -> size_t { return m_Stride; }
+
+    /// Changes the number of vectors (keeps the existing ones, zero-fills new)
+    auto resize(size_t size) -> void;
+
+    /// Removes all vectors from the batch
+    auto clear() -> void { resize(0); }
+
+    /// Returns a pointer to the plane of x-coordinates
+    auto x() -> T* { return m_Elements.data(); }
+
+    /// Returns a pointer to the plane of y-coordinates
+    auto y() -> T* { return m_Elements.data() + m_Stride; }
+
+    /// Returns a pointer to the plane of z-coordinates
+    auto z() -> T* { return m_Elements.data() + 2 * m_Stride; }
+
+    /// Returns a const-pointer to the plane of x-coordinates
+    auto x() const -> const T* { return m_Elements.data(); }
+
+    /// Returns a const-pointer to the plane of y-coordinates
+    auto y() const -> const T* { return m_Elements.data() + m_Stride; }
+
+    /// Returns a const-pointer to the plane of z-coordinates
+    auto z() const -> const T* { return m_Elements.data() + 2 * m_Stride; }
+
+    /// Returns a mutable view of the planes, as used by the batch kernels
+    auto planes() -> Vector3Planes<T> { return {x(), y(), z()}; }
+
+    /// Returns an unmutable view of the planes, as used by the batch kernels
+    auto planes() const -> Vector3Planes<const T> { return {x(), y(), z()}; }
+
+    /// Returns a mutable reference to the underlying storage of the batch
+    auto elements() -> BufferType& { return m_Elements; }
+
+    /// Returns an unmutable reference to the underlying storage of the batch
+    auto elements() const -> const BufferType& { return m_Elements; }
+
+    /// Returns a copy of the vector at the given index
+    auto get(size_t index) const -> Vec3 {
+        assert(index < m_Size);
+        return Vec3(x()[index], y()[index], z()[index]);
+    }
+
+    /// Sets the vector at the given index
+    auto set(size_t index, const Vec3& vec) -> void {
+        assert(index < m_Size);
+        x()[index] = vec.x();
+        y()[index] = vec.y();
+        z()[index] = vec.z();
+    }
+
+    /// Returns a copy of the vector at the given index
+    auto operator[](size_t index) const -> Vec3 { return get(index); }
+
+    /// Replaces the contents of the batch with the given array of vectors
+    auto fromAoS(const Vec3* vectors, size_t size) -> void;
+
+    /// Writes all vectors of the batch into the given array (of size())
+    auto toAoS(Vec3* vectors) const -> void;
+
+    /// Returns the vectors of the batch as an array of Vector3
+    auto toVector() const -> std::vector<Vec3>;
+
+    /// Normalizes in place all the vectors of the batch
+    auto normalize() -> void;
+
+    /// Returns a batch with the normalized version of these vectors
+    auto normalized() const -> Vector3Batch<T>;
+
+    /// Returns a printable string-representation of the batch
+    MATH3D_NODISCARD auto toString() const -> std::string {
+        std::stringstream str_result;
+        if (std::is_same<ElementType, float>::value) {
+            str_result << "Vector3Batchf(";
+        } else if (std::is_same<ElementType, double>::value) {
+            str_result << "Vector3Batchd(";
+        } else {
+            str_result << "Vector3BatchX(";
+        }
+        for (size_t i = 0; i < m_Size; ++i) {
+            str_result << (i > 0 ? ", " : "") << "(" << x()[i] << ", "
+                       << y()[i] << ", " << z()[i] << ")";
+        }
+        str_result << ")";
+        return str_result.str();
+    }
+
+ private:
+    /// Number of vectors in the batch
+    size_t m_Size = 0;
+    /// Number of scalars reserved for each plane (multiple of PLANE_PADDING)
+    size_t m_Stride = 0;
+    /// Storage for the three planes, back to back (x, then y, then z)
+    BufferType m_Elements;
+};
+
+}  // namespace math
@@ -5,6 +5,7 @@
 #include "./impl/vec3_t_scalar_impl.hpp"
 #include "./impl/vec3_t_sse_impl.hpp"
 #include "./impl/vec3_t_avx_impl.hpp"
+#include "./impl/vec3_t_fma_impl.hpp"
 
 namespace math {
 
@@ -16,41 +17,84 @@ template <typename T>
 MATH3D_INLINE auto lerp(const Vector3<T>& vec_a, const Vector3<T>& vec_b,
                         T alpha) -> Vector3<T> {
     Vector3<T> dst;
+#if defined(MATH3D_FMA_ENABLED)
+    fma3::kernel_lerp_vec3<T>(dst.elements(), vec_a.elements(),
+                              vec_b.elements(), alpha);
+#elif defined(MATH3D_VEC3_AVX_ENABLED)
+    avx::kernel_lerp_vec3<T>(dst.elements(), vec_a.elements(),
+                             vec_b.elements(), alpha);
+#elif defined(MATH3D_VEC3_SSE_ENABLED)
+    sse::kernel_lerp_vec3<T>(dst.elements(), vec_a.elements(),
+                             vec_b.elements(), alpha);
+#else
     scalar::kernel_lerp_vec3<T>(dst.elements(), vec_a.elements(),
                                 vec_b.elements(), alpha);
+#endif
     return dst;
 }
 
 /// \brief Returns the square of the norm-2 of the vector
 template <typename T>
 MATH3D_INLINE auto squareNorm(const Vector3<T>& vec) -> T {
+#if defined(MATH3D_VEC3_AVX_ENABLED)
+    return avx::kernel_length_square_vec3<T>(vec.elements());
+#elif defined(MATH3D_VEC3_SSE_ENABLED)
+    return sse::kernel_length_square_vec3<T>(vec.elements());
+#else
     return scalar::kernel_length_square_vec3<T>(vec.elements());
+#endif
 }
 
 /// \brief Returns the norm-2 of the vector
 template <typename T>
 MATH3D_INLINE auto norm(const Vector3<T>& vec) -> T {
+#if defined(MATH3D_VEC3_AVX_ENABLED)
+    return avx::kernel_length_vec3<T>(vec.elements());
+#elif defined(MATH3D_VEC3_SSE_ENABLED)
+    return sse::kernel_length_vec3<T>(vec.elements());
+#else
     return std::sqrt(scalar::kernel_length_square_vec3<T>(vec.elements()));
+#endif
 }
 
 /// \brief Returns a normalized version of this vector
 template <typename T>
 MATH3D_INLINE auto normalize(const Vector3<T>& vec) -> Vector3<T> {
     Vector3<T> vec_normalized = vec;
+#if defined(MATH3D_VEC3_AVX_ENABLED)
+    avx::kernel_normalize_in_place_vec3<T>(vec_normalized.elements());
+#elif defined(MATH3D_VEC3_SSE_ENABLED)
+    sse::kernel_normalize_in_place_vec3<T>(vec_normalized.elements());
+#else
     scalar::kernel_normalize_in_place_vec3<T>(vec_normalized.elements());
+#endif
     return vec_normalized;
 }
 
 /// \brief Normalizes in-place the given vector
 template <typename T>
 MATH3D_INLINE auto normalize_in_place(Vector3<T>& vec) -> void {  // NOLINT
+#if defined(MATH3D_VEC3_AVX_ENABLED)
+    avx::kernel_normalize_in_place_vec3<T>(vec.elements());
+#elif defined(MATH3D_VEC3_SSE_ENABLED)
+    sse::kernel_normalize_in_place_vec3<T>(vec.elements());
+#else
     scalar::kernel_normalize_in_place_vec3<T>(vec.elements());
+#endif
 }
 
 /// \brief Returns the dot-product of the given two vectors
 template <typename T>
 MATH3D_INLINE auto dot(const Vector3<T>& lhs, const Vector3<T>& rhs) -> T {
+#if defined(MATH3D_FMA_ENABLED)
+    return fma3::kernel_dot_vec3<T>(lhs.elements(), rhs.elements());
+#elif defined(MATH3D_VEC3_AVX_ENABLED)
+    return avx::kernel_dot_vec3<T>(lhs.elements(), rhs.elements());
+#elif defined(MATH3D_VEC3_SSE_ENABLED)
+    return sse::kernel_dot_vec3<T>(lhs.elements(), rhs.elements());
+#else
     return scalar::kernel_dot_vec3<T>(lhs.elements(), rhs.elements());
+#endif
 }
 
 /// \brief Returns the cross-product of the given two vectors
@@ -58,8 +102,16 @@ template <typename T>
 MATH3D_INLINE auto cross(const Vector3<T>& lhs, const Vector3<T>& rhs)
     -> Vector3<T> {
     Vector3<T> vec_cross;
+#if defined(MATH3D_VEC3_AVX_ENABLED)
+    avx::kernel_cross_vec3<T>(vec_cross.elements(), lhs.elements(),
+                              rhs.elements());
+#elif defined(MATH3D_VEC3_SSE_ENABLED)
+    sse::kernel_cross_vec3<T>(vec_cross.elements(), lhs.elements(),
+                              rhs.elements());
+#else
     scalar::kernel_cross_vec3<T>(vec_cross.elements(), lhs.elements(),
                                  rhs.elements());
+#endif
     return vec_cross;
 }
 
@@ -73,7 +125,13 @@ template <typename T>
 MATH3D_INLINE auto operator+(const Vector3<T>& lhs, const Vector3<T>& rhs)
     -> Vector3<T> {
     Vector3<T> dst;
+#if defined(MATH3D_VEC3_AVX_ENABLED)
+    avx::kernel_add_vec3<T>(dst.elements(), lhs.elements(), rhs.elements());
+#elif defined(MATH3D_VEC3_SSE_ENABLED)
+    sse::kernel_add_vec3<T>(dst.elements(), lhs.elements(), rhs.elements());
+#else
     scalar::kernel_add_vec3<T>(dst.elements(), lhs.elements(), rhs.elements());
+#endif
     return dst;
 }
 
@@ -87,7 +145,13 @@ template <typename T>
 MATH3D_INLINE auto operator-(const Vector3<T>& lhs, const Vector3<T>& rhs)
     -> Vector3<T> {
     Vector3<T> dst;
+#if defined(MATH3D_VEC3_AVX_ENABLED)
+    avx::kernel_sub_vec3<T>(dst.elements(), lhs.elements(), rhs.elements());
+#elif defined(MATH3D_VEC3_SSE_ENABLED)
+    sse::kernel_sub_vec3<T>(dst.elements(), lhs.elements(), rhs.elements());
+#else
     scalar::kernel_sub_vec3<T>(dst.elements(), lhs.elements(), rhs.elements());
+#endif
     return dst;
 }
 
@@ -101,8 +165,16 @@ template <typename T>
 MATH3D_INLINE auto operator*(double scale, const Vector3<T>& vec)
     -> Vector3<T> {
     Vector3<T> dst;
+#if defined(MATH3D_VEC3_AVX_ENABLED)
+    avx::kernel_scale_vec3<T>(dst.elements(), static_cast<T>(scale),
+                              vec.elements());
+#elif defined(MATH3D_VEC3_SSE_ENABLED)
+    sse::kernel_scale_vec3<T>(dst.elements(), static_cast<T>(scale),
+                              vec.elements());
+#else
     scalar::kernel_scale_vec3<T>(dst.elements(), static_cast<T>(scale),
                                  vec.elements());
+#endif
     return dst;
 }
 
@@ -116,8 +188,16 @@ template <typename T>
 MATH3D_INLINE auto operator*(const Vector3<T>& vec, double scale)
     -> Vector3<T> {
     Vector3<T> dst;
+#if defined(MATH3D_VEC3_AVX_ENABLED)
+    avx::kernel_scale_vec3<T>(dst.elements(), static_cast<T>(scale),
+                              vec.elements());
+#elif defined(MATH3D_VEC3_SSE_ENABLED)
+    sse::kernel_scale_vec3<T>(dst.elements(), static_cast<T>(scale),
+                              vec.elements());
+#else
     scalar::kernel_scale_vec3(dst.elements(), static_cast<T>(scale),
                               vec.elements());
+#endif
     return dst;
 }
 
@@ -131,8 +211,16 @@ template <typename T>
 MATH3D_INLINE auto operator*(const Vector3<T>& lhs, const Vector3<T>& rhs)
     -> Vector3<T> {
     Vector3<T> dst;
+#if defined(MATH3D_VEC3_AVX_ENABLED)
+    avx::kernel_hadamard_vec3<T>(dst.elements(), lhs.elements(),
+                                 rhs.elements());
+#elif defined(MATH3D_VEC3_SSE_ENABLED)
+    sse::kernel_hadamard_vec3<T>(dst.elements(), lhs.elements(),
+                                 rhs.elements());
+#else
     scalar::kernel_hadamard_vec3<T>(dst.elements(), lhs.elements(),
                                     rhs.elements());
+#endif
     return dst;
 }
 
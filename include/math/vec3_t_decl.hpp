@@ -29,12 +29,18 @@ namespace math {
 ///
 /// This is a class that represents a 3d-vector with entries x, y, z of some
 /// scalar floating-point type. Its storage is a buffer of the given scalar
-/// type, and contains only the required storage for 3 elements.
+/// type, and contains only the required storage for 3 elements. When built
+/// with MATH3D_VEC3_PADDED, the buffer has instead a 4th (zero) entry and is
+/// aligned to its size (16 bytes for float32, 32 bytes for float64), so the
+/// SIMD kernels can use aligned loads and stores of whole registers.
 template <typename T>
 class Vector3 {
  public:
-    /// Number of scalars used in the storage of the vector
-    static constexpr uint32_t BUFFER_SIZE = 3;
+    /// Number of scalars used in the storage of the vector (3, or 4 if padded)
+    static constexpr uint32_t BUFFER_SIZE = HAS_VEC3_PADDING::value ? 4 : 3;
+    /// Alignment (in bytes) of the storage of the vector
+    static constexpr uint32_t BUFFER_ALIGNMENT =
+        HAS_VEC3_PADDING::value ? 4 * sizeof(T) : alignof(T);
     /// Number of scalar dimensions of the vector
     static constexpr uint32_t VECTOR_SIZE = 3;
     /// Number of dimensions of this vector (as in np.array.ndim)
@@ -165,8 +171,8 @@ class Vector3 {
     }
 
  private:
-    /// Storage of the vector's scalars
-    BufferType m_Elements = {0, 0, 0};
+    /// Storage of the vector's scalars (the padding entry, if any, stays zero)
+    alignas(BUFFER_ALIGNMENT) BufferType m_Elements = {0, 0, 0};
 };
 
 }  // namespace math
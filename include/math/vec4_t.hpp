@@ -5,6 +5,7 @@
 #include "./impl/vec4_t_scalar_impl.hpp"
 #include "./impl/vec4_t_sse_impl.hpp"
 #include "./impl/vec4_t_avx_impl.hpp"
+#include "./impl/vec4_t_fma_impl.hpp"
 
 namespace math {
 
@@ -16,11 +17,52 @@ template <typename T>
 MATH3D_INLINE auto lerp(const Vector4<T>& vec_a, const Vector4<T>& vec_b,
                         T alpha) -> Vector4<T> {
     Vector4<T> dst;
+#if defined(MATH3D_FMA_ENABLED)
+    fma3::kernel_lerp_vec4<T>(dst.elements(), vec_a.elements(),
+                              vec_b.elements(), alpha);
+#elif defined(MATH3D_AVX_ENABLED)
+    avx::kernel_lerp_vec4<T>(dst.elements(), vec_a.elements(),
+                             vec_b.elements(), alpha);
+#elif defined(MATH3D_SSE_ENABLED)
+    sse::kernel_lerp_vec4<T>(dst.elements(), vec_a.elements(),
+                             vec_b.elements(), alpha);
+#else
     scalar::kernel_lerp_vec4<T>(dst.elements(), vec_a.elements(),
                                 vec_b.elements(), alpha);
+#endif
     return dst;
 }
 
+/// \brief Linearly interpolates between each pair of vectors of two arrays
+///
+/// A single Vector4 already fills a whole xmm|ymm register, so this streams the
+/// kernel of the single-object lerp over the arrays
+///
+/// \tparam T Type of scalar used by the 4d vectors
+///
+/// \param[in] vec_a Array of start points of the interpolation
+/// \param[in] vec_b Array of end points of the interpolation
+/// \param[in] alpha Interpolation parameter, shared by all pairs
+/// \param[out] dst Array where to store the results (can alias vec_a or vec_b)
+/// \param[in] num Number of vectors in each of the arrays
+template <typename T>
+auto lerp(const Vector4<T>* vec_a, const Vector4<T>* vec_b, T alpha,
+          Vector4<T>* dst, size_t num) -> void {
+    for (size_t i = 0; i < num; ++i) {
+        dst[i] = lerp<T>(vec_a[i], vec_b[i], alpha);
+    }
+}
+
+/// \brief Linearly interpolates between each pair of vectors of two arrays,
+/// using the interpolation parameter given for each pair in `alpha`
+template <typename T>
+auto lerp(const Vector4<T>* vec_a, const Vector4<T>* vec_b, const T* alpha,
+          Vector4<T>* dst, size_t num) -> void {
+    for (size_t i = 0; i < num; ++i) {
+        dst[i] = lerp<T>(vec_a[i], vec_b[i], alpha[i]);
+    }
+}
+
 template <typename T>
 MATH3D_INLINE auto squareNorm(const Vector4<T>& vec) -> T {
 #if defined(MATH3D_AVX_ENABLED)
@@ -73,7 +115,9 @@ MATH3D_INLINE auto normalize_in_place(Vector4<T>& vec) -> void {  // NOLINT
 /// \brief Returns the dot-product of the given two vectors
 template <typename T>
 MATH3D_INLINE auto dot(const Vector4<T>& lhs, const Vector4<T>& rhs) -> T {
-#if defined(MATH3D_AVX_ENABLED)
+#if defined(MATH3D_FMA_ENABLED)
+    return fma3::kernel_dot_vec4<T>(lhs.elements(), rhs.elements());
+#elif defined(MATH3D_AVX_ENABLED)
     return avx::kernel_dot_vec4<T>(lhs.elements(), rhs.elements());
 #elif defined(MATH3D_SSE_ENABLED)
     return sse::kernel_dot_vec4<T>(lhs.elements(), rhs.elements());
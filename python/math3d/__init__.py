@@ -3,32 +3,57 @@ from math3d_bindings import (  # type: ignore
     AABB_f,
     Euler_d,
     Euler_f,
+    Frustum_d,
+    Frustum_f,
     Line_d,
     Line_f,
     Matrix2d,
     Matrix2f,
     Matrix3d,
     Matrix3f,
+    Matrix4Array_d,
+    Matrix4Array_f,
     Matrix4d,
     Matrix4f,
     Plane_d,
     Plane_f,
+    Pose3dArray_d,
+    Pose3dArray_f,
     Pose3d_d,
     Pose3d_f,
+    QuaternionArray_d,
+    QuaternionArray_f,
     Quaterniond,
     Quaternionf,
+    Ray_d,
+    Ray_f,
     Vector2d,
     Vector2f,
+    Vector3Array_d,
+    Vector3Array_f,
     Vector3d,
     Vector3f,
     Vector4d,
     Vector4f,
+    compose_poses,
     cross,
+    cull_aabbs,
+    cull_points,
+    cull_spheres,
     determinant,
     dot,
     eConvention,
+    eIsa,
     eOrder,
+    get_active_isa,
+    get_best_isa,
+    get_num_threads,
+    get_supported_isas,
+    intersect_rays_aabbs,
     inverse,
+    inverseAffine,
+    inverseRigid,
+    is_isa_supported,
     lerp,
     mat2_to_nparray_f32,
     mat2_to_nparray_f64,
@@ -36,6 +61,7 @@ from math3d_bindings import (  # type: ignore
     mat3_to_nparray_f64,
     mat4_to_nparray_f32,
     mat4_to_nparray_f64,
+    matmul,
     norm,
     normalize,
     normalize_,
@@ -53,10 +79,19 @@ from math3d_bindings import (  # type: ignore
     nparray_to_vec3_f64,
     nparray_to_vec4_f32,
     nparray_to_vec4_f64,
+    quat_from_euler,
+    quat_from_rotation_matrix,
     quat_to_nparray_f32,
     quat_to_nparray_f64,
+    raycast_aabbs,
+    reset_active_isa,
+    rotate_vectors,
+    rotation_matrix_from_quat,
+    set_active_isa,
+    set_num_threads,
     squareNorm,
     trace,
+    transform_points,
     transpose,
     transpose_,
     vec2_to_nparray_f32,
@@ -89,6 +124,15 @@ __all__ = [
     "eConvention",
     "Pose3d_f",
     "Pose3d_d",
+    # arrays of math3d types (views over numpy arrays)
+    "Vector3Array_f",
+    "Vector3Array_d",
+    "QuaternionArray_f",
+    "QuaternionArray_d",
+    "Matrix4Array_f",
+    "Matrix4Array_d",
+    "Pose3dArray_f",
+    "Pose3dArray_d",
     # utilities
     "Line_f",
     "Line_d",
@@ -96,6 +140,10 @@ __all__ = [
     "Plane_d",
     "AABB_f",
     "AABB_d",
+    "Ray_f",
+    "Ray_d",
+    "Frustum_f",
+    "Frustum_d",
     # math3d -> numpy conversions
     "quat_to_nparray_f32",
     "quat_to_nparray_f64",
@@ -140,4 +188,32 @@ __all__ = [
     "trace",
     "determinant",
     "inverse",
+    "inverseRigid",
+    "inverseAffine",
+    # batch conversions of rotations
+    "quat_from_euler",
+    "quat_from_rotation_matrix",
+    "rotation_matrix_from_quat",
+    # batch operations over numpy arrays
+    "transform_points",
+    "rotate_vectors",
+    "compose_poses",
+    "matmul",
+    # geometric queries over numpy arrays
+    "intersect_rays_aabbs",
+    "raycast_aabbs",
+    "cull_points",
+    "cull_spheres",
+    "cull_aabbs",
+    # runtime dispatch of batch kernels
+    "eIsa",
+    "get_active_isa",
+    "set_active_isa",
+    "reset_active_isa",
+    "get_best_isa",
+    "get_supported_isas",
+    "is_isa_supported",
+    # threaded execution of batch calls
+    "get_num_threads",
+    "set_num_threads",
 ]
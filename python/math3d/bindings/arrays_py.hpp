@@ -0,0 +1,401 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <pybind11/pybind11.h>
+#include <pybind11/numpy.h>
+
+#include <math/aligned_allocator.hpp>
+#include <math/mat4_t.hpp>
+#include <math/pose3d_t.hpp>
+#include <math/quat_t.hpp>
+#include <math/vec3_t.hpp>
+
+#include <batch_helpers_py.hpp>
+
+// -----------------------------------------------------------------------------
+// Arrays of math3d objects (Vector3, Quaternion, Matrix4 and Pose3d) exposed to
+// Python, e.g. as Vector3Array_f, whose storage is handed as is to the batch
+// functions (no conversions from or to NumPy arrays in between).
+//
+// An array either owns its storage, or is a view over the memory of another
+// Python object (e.g. a NumPy array), which requires the latter to have the
+// same layout as the C++ objects (checked when the view is created). In both
+// cases, the objects are exposed through the buffer protocol and numpy()
+// without copies: e.g. a Vector3Array_f is seen as an (N, 3) float32 array,
+// whose rows are 16 bytes apart if Vector3 is padded (MATH3D_VEC3_PADDED).
+// -----------------------------------------------------------------------------
+
+namespace py = pybind11;
+
+namespace math {
+
+/// Returns the offset (in bytes) of the given scalar of an object
+template <typename Elem, typename T>
+auto scalar_offset(const Elem& obj, const T& scalar) -> py::ssize_t {
+    return reinterpret_cast<const char*>(&scalar) -  // NOLINT
+           reinterpret_cast<const char*>(&obj);      // NOLINT
+}
+
+/// \brief Layout of the scalars of each object of an array, as seen from Python
+///
+/// Each specialization provides the scalar type, the shape of the scalars of
+/// each object (e.g. (4, 4) for Matrix4) and the offset of each of them (in
+/// row-major order of that shape) from the start of the object
+template <typename Elem>
+struct ArrayLayout;
+
+template <typename T>
+struct ArrayLayout<Vector3<T>> {
+    using Scalar = T;
+
+    static auto shape() -> std::vector<py::ssize_t> { return {3}; }
+
+    static auto offsets() -> std::vector<py::ssize_t> {
+        const Vector3<T> vec;
+        return {scalar_offset(vec, vec[0]), scalar_offset(vec, vec[1]),
+                scalar_offset(vec, vec[2])};
+    }
+};
+
+template <typename T>
+struct ArrayLayout<Quaternion<T>> {
+    using Scalar = T;
+
+    static auto shape() -> std::vector<py::ssize_t> { return {4}; }
+
+    static auto offsets() -> std::vector<py::ssize_t> {
+        const Quaternion<T> quat;
+        std::vector<py::ssize_t> offsets;
+        for (uint32_t k = 0; k < 4; ++k) {
+            offsets.push_back(scalar_offset(quat, quat[k]));
+        }
+        return offsets;
+    }
+};
+
+template <typename T>
+struct ArrayLayout<Matrix4<T>> {
+    using Scalar = T;
+
+    static auto shape() -> std::vector<py::ssize_t> { return {4, 4}; }
+
+    static auto offsets() -> std::vector<py::ssize_t> {
+        // Entry [i, j] of the NumPy array is row i and column j of the matrix
+        const Matrix4<T> mat;
+        std::vector<py::ssize_t> offsets;
+        for (uint32_t i = 0; i < 4; ++i) {
+            for (uint32_t j = 0; j < 4; ++j) {
+                offsets.push_back(scalar_offset(mat, mat(i, j)));
+            }
+        }
+        return offsets;
+    }
+};
+
+template <typename T>
+struct ArrayLayout<Pose3d<T>> {
+    using Scalar = T;
+
+    /// The position (x, y, z) followed by the orientation (w, x, y, z)
+    static auto shape() -> std::vector<py::ssize_t> {
+        return {static_cast<py::ssize_t>(POSE_NUM_SCALARS)};
+    }
+
+    static auto offsets() -> std::vector<py::ssize_t> {
+        const Pose3d<T> pose;
+        std::vector<py::ssize_t> offsets;
+        for (uint32_t k = 0; k < 3; ++k) {
+            offsets.push_back(scalar_offset(pose, pose.position[k]));
+        }
+        for (uint32_t k = 0; k < 4; ++k) {
+            offsets.push_back(scalar_offset(pose, pose.orientation[k]));
+        }
+        return offsets;
+    }
+};
+
+/// Returns the offsets of the entries of an array of the given shape and
+/// strides (in bytes), in row-major order
+inline auto strided_offsets(const std::vector<py::ssize_t>& shape,
+                            const std::vector<py::ssize_t>& strides)
+    -> std::vector<py::ssize_t> {
+    std::vector<py::ssize_t> offsets = {0};
+    for (size_t d = 0; d < shape.size(); ++d) {
+        std::vector<py::ssize_t> next;
+        for (auto offset : offsets) {
+            for (py::ssize_t k = 0; k < shape[d]; ++k) {
+                next.push_back(offset + k * strides[d]);
+            }
+        }
+        offsets = std::move(next);
+    }
+    return offsets;
+}
+
+/// Returns the strides of the scalars of each object, or an empty vector if
+/// these can't be described by strides (e.g. Pose3d with a padded Vector3)
+template <typename Elem>
+auto layout_strides() -> std::vector<py::ssize_t> {
+    const auto shape = ArrayLayout<Elem>::shape();
+    const auto offsets = ArrayLayout<Elem>::offsets();
+    // The stride of each dimension is the offset of the entry right after the
+    // first one along that dimension
+    std::vector<py::ssize_t> strides(shape.size());
+    size_t step = offsets.size();
+    for (size_t d = 0; d < shape.size(); ++d) {
+        step /= static_cast<size_t>(shape[d]);
+        strides[d] = offsets[step] - offsets[0];
+    }
+    if (offsets[0] != 0 || strided_offsets(shape, strides) != offsets) {
+        return {};
+    }
+    return strides;
+}
+
+/// \class ArrayPy
+///
+/// \brief Contiguous array of math3d objects, either owned or a view
+template <typename Elem>
+class ArrayPy {
+ public:
+    /// Alignment of the owned storage (a cache line, as in Vector3Batch)
+    static constexpr size_t ALIGNMENT = 64;
+
+    using BufferType = std::vector<Elem, AlignedAllocator<Elem, ALIGNMENT>>;
+
+    /// Creates an array of `num` default-constructed objects
+    explicit ArrayPy(size_t num)
+        : m_Storage(num), m_Data(m_Storage.data()), m_Size(num) {}
+
+    /// Creates a view over the `num` objects at `data`, kept alive by `owner`
+    ArrayPy(Elem* data, size_t num, py::object owner)
+        : m_Data(data), m_Size(num), m_Owner(std::move(owner)) {}
+
+    ArrayPy(const ArrayPy<Elem>& other) = delete;
+
+    ArrayPy(ArrayPy<Elem>&& other) noexcept = default;
+
+    auto operator=(const ArrayPy<Elem>& rhs) -> ArrayPy<Elem>& = delete;
+
+    auto operator=(ArrayPy<Elem>&& rhs) noexcept -> ArrayPy<Elem>& = default;
+
+    ~ArrayPy() = default;
+
+    /// Returns a pointer to the first object of the array
+    auto data() -> Elem* { return m_Data; }
+
+    /// Returns a const pointer to the first object of the array
+    auto data() const -> const Elem* { return m_Data; }
+
+    /// Returns the number of objects in the array
+    auto size() const -> size_t { return m_Size; }
+
+    /// Returns whether the array is a view over the memory of another object
+    auto isView() const -> bool { return static_cast<bool>(m_Owner); }
+
+ private:
+    /// Storage of the objects, if owned by this array
+    BufferType m_Storage;
+    /// Pointer to the first object (either owned or from a view)
+    Elem* m_Data = nullptr;
+    /// Number of objects in the array
+    size_t m_Size = 0;
+    /// The Python object that owns the memory of a view (null if owned)
+    py::object m_Owner;
+};
+
+/// Creates an array from a buffer (e.g. a NumPy array) of shape (N, ...), as a
+/// view over its memory or (if `copy` is set) as a copy of its entries
+template <typename Elem>
+auto array_from_buffer(const py::buffer& buff, bool copy,
+                       const std::string& class_name) -> ArrayPy<Elem> {
+    using T = typename ArrayLayout<Elem>::Scalar;
+    const auto shape = ArrayLayout<Elem>::shape();
+    const auto offsets = ArrayLayout<Elem>::offsets();
+
+    // Views write into the memory of the buffer, so it must be writeable
+    py::buffer_info info = buff.request(!copy);
+    if (info.format != py::format_descriptor<T>::format()) {
+        throw std::runtime_error(
+            class_name + ": incompatible format, expected a " +
+            (IsFloat32<T>::value ? "float32" : "float64") + " array");
+    }
+    bool is_valid_shape =
+        (info.ndim == static_cast<py::ssize_t>(shape.size() + 1));
+    for (size_t d = 0; is_valid_shape && d < shape.size(); ++d) {
+        is_valid_shape = (info.shape[d + 1] == shape[d]);
+    }
+    if (!is_valid_shape) {
+        std::vector<py::ssize_t> expected = {0};
+        expected.insert(expected.end(), shape.begin(), shape.end());
+        throw std::runtime_error(class_name +
+                                 ": incompatible shape, expected " +
+                                 shape_to_string(expected));
+    }
+
+    const auto num = static_cast<size_t>(info.shape[0]);
+    const std::vector<py::ssize_t> strides(info.strides.begin() + 1,
+                                           info.strides.end());
+    const auto src_offsets = strided_offsets(shape, strides);
+    const auto* src = static_cast<const char*>(info.ptr);
+    if (!copy) {
+        const bool is_valid_layout =
+            (src_offsets == offsets) &&
+            (num <= 1 ||
+             info.strides[0] == static_cast<py::ssize_t>(sizeof(Elem))) &&
+            (reinterpret_cast<uintptr_t>(src) % alignof(Elem) == 0);  // NOLINT
+        if (!is_valid_layout) {
+            throw std::runtime_error(
+                class_name + ": the layout of the array doesn't match the " +
+                "one of the objects, use copy=True to copy its entries");
+        }
+        return ArrayPy<Elem>(static_cast<Elem*>(info.ptr), num, buff);
+    }
+
+    ArrayPy<Elem> array(num);
+    auto* dst = reinterpret_cast<char*>(array.data());  // NOLINT
+    for (size_t n = 0; n < num; ++n) {
+        const char* src_elem =
+            src + static_cast<py::ssize_t>(n) * info.strides[0];
+        char* dst_elem = dst + n * sizeof(Elem);
+        for (size_t k = 0; k < offsets.size(); ++k) {
+            std::memcpy(dst_elem + offsets[k], src_elem + src_offsets[k],
+                        sizeof(T));
+        }
+    }
+    return array;
+}
+
+/// Returns a NumPy array of shape (N, ...) with the given strides, which views
+/// the scalars starting at `data` and keeps `base` alive
+template <typename T>
+auto array_view(const std::vector<py::ssize_t>& shape,
+                const std::vector<py::ssize_t>& strides, T* data,
+                const py::object& base) -> py::array_t<T> {
+    return py::array_t<T>(shape, strides, data, base);
+}
+
+template <typename Elem>
+// NOLINTNEXTLINE
+auto bindings_array(py::module& m, const char* class_name)
+    -> py::class_<ArrayPy<Elem>> {
+    using Class = ArrayPy<Elem>;
+    using T = typename ArrayLayout<Elem>::Scalar;
+    const std::string name = class_name;
+    const auto elem_shape = ArrayLayout<Elem>::shape();
+    const auto elem_strides = layout_strides<Elem>();
+    const bool is_strided = !elem_strides.empty();
+
+    // Returns the shape and strides of an array of N objects (as scalars)
+    auto full_layout = [elem_shape, elem_strides](const Class& self) {
+        std::vector<py::ssize_t> shape = {
+            static_cast<py::ssize_t>(self.size())};
+        std::vector<py::ssize_t> strides = {
+            static_cast<py::ssize_t>(sizeof(Elem))};
+        shape.insert(shape.end(), elem_shape.begin(), elem_shape.end());
+        strides.insert(strides.end(), elem_strides.begin(),
+                       elem_strides.end());
+        return std::make_pair(shape, strides);
+    };
+
+    auto cls = is_strided
+                   ? py::class_<Class>(m, class_name, py::buffer_protocol())
+                   : py::class_<Class>(m, class_name);
+    cls.def(py::init([name](const py::buffer& buff, bool copy) -> Class {
+                return array_from_buffer<Elem>(buff, copy, name);
+            }),
+            py::arg("array"), py::arg("copy") = false)
+        .def(py::init([](size_t num) -> Class { return Class(num); }),
+             py::arg("num"))
+        .def("__len__", &Class::size)
+        .def("__getitem__",
+             [](const Class& self, py::ssize_t index) -> Elem {
+                 if (index < 0 ||
+                     index >= static_cast<py::ssize_t>(self.size())) {
+                     throw py::index_error();
+                 }
+                 return self.data()[index];
+             })
+        .def("__setitem__",
+             [](Class& self, py::ssize_t index, const Elem& value) -> void {
+                 if (index < 0 ||
+                     index >= static_cast<py::ssize_t>(self.size())) {
+                     throw py::index_error();
+                 }
+                 self.data()[index] = value;
+             })
+        .def_property_readonly("is_view", &Class::isView)
+        .def("numpy",
+             [name, is_strided, full_layout](
+                 const py::object& self_py) -> py::array_t<T> {
+                 if (!is_strided) {
+                     throw std::runtime_error(
+                         name + ": the objects can't be viewed as a single " +
+                         "array, as their storage is padded");
+                 }
+                 auto& self = self_py.cast<Class&>();
+                 const auto layout = full_layout(self);
+                 return array_view<T>(
+                     layout.first, layout.second,
+                     reinterpret_cast<T*>(self.data()),  // NOLINT
+                     self_py);
+             })
+        .def("__repr__", [name](const Class& self) -> py::str {
+            return py::str("{}(size={}, view={})")
+                .format(name, self.size(), self.isView());
+        });
+    if (is_strided) {
+        cls.def_buffer([full_layout](Class& self) -> py::buffer_info {
+            const auto layout = full_layout(self);
+            const auto ndim = static_cast<py::ssize_t>(layout.first.size());
+            return py::buffer_info(self.data(), sizeof(T),
+                                   py::format_descriptor<T>::format(), ndim,
+                                   layout.first, layout.second);
+        });
+    }
+    return cls;
+}
+
+template <typename T>
+// NOLINTNEXTLINE
+auto bindings_pose3d_array(py::module& m, const char* class_name) -> void {
+    using Class = ArrayPy<Pose3d<T>>;
+    // The positions and orientations can always be viewed as arrays of their
+    // own, even if the poses (padded) can't be viewed as an (N, 7) array
+    constexpr auto POSE_STRIDE = static_cast<py::ssize_t>(sizeof(Pose3d<T>));
+    constexpr auto SCALAR_STRIDE = static_cast<py::ssize_t>(sizeof(T));
+    const Pose3d<T> pose;
+    const auto orientation_offset = scalar_offset(pose, pose.orientation[0]);
+    bindings_array<Pose3d<T>>(m, class_name)
+        .def("positions",
+             [](const py::object& self_py) -> py::array_t<T> {
+                 auto& self = self_py.cast<Class&>();
+                 return array_view<T>(
+                     {static_cast<py::ssize_t>(self.size()), 3},
+                     {POSE_STRIDE, SCALAR_STRIDE},
+                     reinterpret_cast<T*>(self.data()),  // NOLINT
+                     self_py);
+             })
+        .def("orientations",
+             [orientation_offset](
+                 const py::object& self_py) -> py::array_t<T> {
+                 auto& self = self_py.cast<Class&>();
+                 auto* data = reinterpret_cast<char*>(self.data());  // NOLINT
+                 if (data != nullptr) {
+                     data += orientation_offset;
+                 }
+                 return array_view<T>(
+                     {static_cast<py::ssize_t>(self.size()), 4},
+                     {POSE_STRIDE, SCALAR_STRIDE},
+                     reinterpret_cast<T*>(data),  // NOLINT
+                     self_py);
+             });
+}
+
+}  // namespace math
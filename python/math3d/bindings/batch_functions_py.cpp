@@ -0,0 +1,383 @@
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <pybind11/pybind11.h>
+#include <pybind11/numpy.h>
+
+#include <math/mat4_t.hpp>
+#include <math/parallel.hpp>
+#include <math/pose3d_t.hpp>
+#include <math/quat_t.hpp>
+
+#include <arrays_py.hpp>
+#include <batch_helpers_py.hpp>
+
+namespace py = pybind11;
+
+namespace math {
+
+/// Returns the matrix given as a (4, 4) (row-major) array
+template <typename T>
+auto mat4_from_array(const ArrayNp<T>& mat_np, const char* func_name)
+    -> Matrix4<T> {
+    if (mat_np.ndim() != 2 || mat_np.shape(0) != 4 || mat_np.shape(1) != 4) {
+        throw std::runtime_error(std::string(func_name) +
+                                 ": incompatible shape, expected (4, 4)");
+    }
+    const auto* data = mat_np.data();
+    Matrix4<T> mat;
+    for (uint32_t i = 0; i < 4; ++i) {
+        for (uint32_t j = 0; j < 4; ++j) {
+            mat(i, j) = data[4 * i + j];
+        }
+    }
+    return mat;
+}
+
+/// Runs the given batch operation, op(src, dst, num), over an (N, 3) array of
+/// vectors, and returns the (N, 3) array of results (`out` if given)
+template <typename T, typename Op>
+auto map_vec3_array(const ArrayNp<T>& src_np, const py::object& out,
+                    const char* func_name, Op op) -> OutArrayNp<T> {
+    const auto num = batch_size<T>(src_np, 2, 3, func_name);
+    auto dst_np =
+        output_array<T>(out, {static_cast<py::ssize_t>(num), 3}, func_name);
+    const auto* src_data = src_np.data();
+    auto* dst_data = dst_np.mutable_data();
+    {
+        py::gil_scoped_release release;
+        parallel::ParallelFor(num, [&](size_t begin, size_t end) {
+            const auto* src_range = src_data + 3 * begin;
+            auto* dst_range = dst_data + 3 * begin;
+            std::vector<Vector3<T>> src_storage, dst_storage;
+            const auto* src =
+                as_vec3_array<T>(src_range, end - begin, src_storage);
+            auto* dst =
+                as_mutable_vec3_array<T>(dst_range, end - begin, dst_storage);
+            op(src, dst, end - begin);
+            store_vec3_array<T>(dst_range, dst_storage);
+        });
+    }
+    return dst_np;
+}
+
+/// Returns the array given as `out` (checked against the expected type and
+/// number of objects), or a new array of `num` objects if `out` is None
+template <typename Elem>
+auto output_objects_array(const py::object& out, size_t num,
+                          const char* func_name) -> py::object {
+    if (out.is_none()) {
+        return py::cast(ArrayPy<Elem>(num));
+    }
+    if (!py::isinstance<ArrayPy<Elem>>(out)) {
+        throw std::runtime_error(std::string(func_name) +
+                                 ": out must be an array of the same type");
+    }
+    if (out.cast<const ArrayPy<Elem>&>().size() != num) {
+        throw std::runtime_error(std::string(func_name) +
+                                 ": out must have the same number of objects");
+    }
+    return out;
+}
+
+/// Runs the given batch operation, op(src, dst, num), over an array of
+/// objects, and returns the array of results (`out` if given). Unlike
+/// map_vec3_array, the objects are handed to the operation as they are
+template <typename Elem, typename Op>
+auto map_objects_array(const ArrayPy<Elem>& src_array, const py::object& out,
+                       const char* func_name, Op op) -> py::object {
+    const auto num = src_array.size();
+    py::object dst_py = output_objects_array<Elem>(out, num, func_name);
+    const auto* src = src_array.data();
+    auto* dst = dst_py.cast<ArrayPy<Elem>&>().data();
+    {
+        py::gil_scoped_release release;
+        parallel::ParallelFor(num, [&](size_t begin, size_t end) {
+            op(src + begin, dst + begin, end - begin);
+        });
+    }
+    return dst_py;
+}
+
+/// Transforms an array of points by the given transform
+template <typename T>
+auto transform_points_mat4_objects(const Matrix4<T>& transform,
+                                   const ArrayPy<Vector3<T>>& points,
+                                   const py::object& out) -> py::object {
+    return map_objects_array<Vector3<T>>(
+        points, out, "transform_points",
+        [&](const Vector3<T>* src, Vector3<T>* dst, size_t num) {
+            ::math::transformPoints<T>(transform, src, dst, num);
+        });
+}
+
+/// Transforms an array of points by the given pose
+template <typename T>
+auto transform_points_pose_objects(const Pose3d<T>& pose,
+                                   const ArrayPy<Vector3<T>>& points,
+                                   const py::object& out) -> py::object {
+    return map_objects_array<Vector3<T>>(
+        points, out, "transform_points",
+        [&](const Vector3<T>* src, Vector3<T>* dst, size_t num) {
+            pose.apply(src, dst, num);
+        });
+}
+
+/// Rotates an array of vectors by the given quaternion
+template <typename T>
+auto rotate_vectors_objects(const Quaternion<T>& quat,
+                            const ArrayPy<Vector3<T>>& vectors,
+                            const py::object& out) -> py::object {
+    return map_objects_array<Vector3<T>>(
+        vectors, out, "rotate_vectors",
+        [&](const Vector3<T>* src, Vector3<T>* dst, size_t num) {
+            ::math::rotate<T>(quat, src, dst, num);
+        });
+}
+
+/// Transforms an (N, 3) array of points by the given transform
+template <typename T>
+auto transform_points_mat4(const Matrix4<T>& transform,
+                           const ArrayNp<T>& points_np, const py::object& out)
+    -> OutArrayNp<T> {
+    return map_vec3_array<T>(
+        points_np, out, "transform_points",
+        [&](const Vector3<T>* src, Vector3<T>* dst, size_t num) {
+            ::math::transformPoints<T>(transform, src, dst, num);
+        });
+}
+
+/// Transforms an (N, 3) array of points by the given (4, 4) transform
+template <typename T>
+auto transform_points_array(const ArrayNp<T>& transform_np,
+                            const ArrayNp<T>& points_np, const py::object& out)
+    -> OutArrayNp<T> {
+    return transform_points_mat4<T>(
+        mat4_from_array<T>(transform_np, "transform_points"), points_np, out);
+}
+
+/// Transforms an (N, 3) array of points by the given pose
+template <typename T>
+auto transform_points_pose(const Pose3d<T>& pose, const ArrayNp<T>& points_np,
+                           const py::object& out) -> OutArrayNp<T> {
+    return map_vec3_array<T>(
+        points_np, out, "transform_points",
+        [&](const Vector3<T>* src, Vector3<T>* dst, size_t num) {
+            pose.apply(src, dst, num);
+        });
+}
+
+/// Rotates an (N, 3) array of vectors by the given quaternion
+template <typename T>
+auto rotate_vectors_quat(const Quaternion<T>& quat,
+                         const ArrayNp<T>& vectors_np, const py::object& out)
+    -> OutArrayNp<T> {
+    return map_vec3_array<T>(
+        vectors_np, out, "rotate_vectors",
+        [&](const Vector3<T>* src, Vector3<T>* dst, size_t num) {
+            ::math::rotate<T>(quat, src, dst, num);
+        });
+}
+
+/// Rotates an (N, 3) array of vectors by the given (w, x, y, z) quaternion
+template <typename T>
+auto rotate_vectors_array(const ArrayNp<T>& quat_np,
+                          const ArrayNp<T>& vectors_np, const py::object& out)
+    -> OutArrayNp<T> {
+    if (quat_np.ndim() != 1 || quat_np.shape(0) != 4) {
+        throw std::runtime_error(
+            "rotate_vectors: incompatible shape, expected (4,)");
+    }
+    const auto* data = quat_np.data();
+    const Quaternion<T> quat(data[0], data[1], data[2], data[3]);
+    return rotate_vectors_quat<T>(quat, vectors_np, out);
+}
+
+/// Composes two (N, 7) arrays of poses element-wise, out[i] = lhs[i] * rhs[i]
+template <typename T>
+auto compose_poses(const ArrayNp<T>& lhs_np, const ArrayNp<T>& rhs_np,
+                   const py::object& out, bool renormalize)
+    -> OutArrayNp<T> {
+    constexpr auto POSE_DIM = static_cast<py::ssize_t>(POSE_NUM_SCALARS);
+    const auto num = batch_size<T>(lhs_np, 2, POSE_DIM, "compose_poses");
+    if (batch_size<T>(rhs_np, 2, POSE_DIM, "compose_poses") != num) {
+        throw std::runtime_error(
+            "compose_poses: lhs and rhs must have the same number of poses");
+    }
+    auto dst_np = output_array<T>(
+        out, {static_cast<py::ssize_t>(num), POSE_DIM}, "compose_poses");
+    const auto* lhs_data = lhs_np.data();
+    const auto* rhs_data = rhs_np.data();
+    auto* dst_data = dst_np.mutable_data();
+    {
+        py::gil_scoped_release release;
+        parallel::ParallelFor(
+            num,
+            [&](size_t begin, size_t end) {
+                const size_t offset = POSE_NUM_SCALARS * begin;
+                const size_t count = end - begin;
+                std::vector<Pose3d<T>> lhs_storage, rhs_storage, dst_storage;
+                const auto* lhs =
+                    as_pose3d_array<T>(lhs_data + offset, count, lhs_storage);
+                const auto* rhs =
+                    as_pose3d_array<T>(rhs_data + offset, count, rhs_storage);
+                auto* dst = as_mutable_pose3d_array<T>(dst_data + offset,
+                                                       count, dst_storage);
+                ::math::composePoses<T>(lhs, rhs, dst, count, renormalize);
+                store_pose3d_array<T>(dst_data + offset, dst_storage);
+            },
+            parallel::MIN_ELEMENTS_PER_THREAD);
+    }
+    return dst_np;
+}
+
+/// Composes two arrays of poses element-wise, out[i] = lhs[i] * rhs[i]
+template <typename T>
+auto compose_poses_objects(const ArrayPy<Pose3d<T>>& lhs_array,
+                           const ArrayPy<Pose3d<T>>& rhs_array,
+                           const py::object& out, bool renormalize)
+    -> py::object {
+    const auto num = lhs_array.size();
+    if (rhs_array.size() != num) {
+        throw std::runtime_error(
+            "compose_poses: lhs and rhs must have the same number of poses");
+    }
+    py::object dst_py =
+        output_objects_array<Pose3d<T>>(out, num, "compose_poses");
+    const auto* lhs = lhs_array.data();
+    const auto* rhs = rhs_array.data();
+    auto* dst = dst_py.cast<ArrayPy<Pose3d<T>>&>().data();
+    {
+        py::gil_scoped_release release;
+        parallel::ParallelFor(
+            num,
+            [&](size_t begin, size_t end) {
+                ::math::composePoses<T>(lhs + begin, rhs + begin, dst + begin,
+                                        end - begin, renormalize);
+            },
+            parallel::MIN_ELEMENTS_PER_THREAD);
+    }
+    return dst_py;
+}
+
+/// Multiplies two arrays of matrices element-wise, out[i] = lhs[i] * rhs[i]
+template <typename T>
+auto matmul_objects(const ArrayPy<Matrix4<T>>& lhs_array,
+                    const ArrayPy<Matrix4<T>>& rhs_array,
+                    const py::object& out) -> py::object {
+    const auto num = lhs_array.size();
+    if (rhs_array.size() != num) {
+        throw std::runtime_error(
+            "matmul: lhs and rhs must have the same number of matrices");
+    }
+    py::object dst_py = output_objects_array<Matrix4<T>>(out, num, "matmul");
+    const auto* lhs = lhs_array.data();
+    const auto* rhs = rhs_array.data();
+    auto* dst = dst_py.cast<ArrayPy<Matrix4<T>>&>().data();
+    {
+        py::gil_scoped_release release;
+        parallel::ParallelFor(num, [&](size_t begin, size_t end) {
+            ::math::multiplyMatrices<T>(lhs + begin, rhs + begin, dst + begin,
+                                        end - begin);
+        });
+    }
+    return dst_py;
+}
+
+/// Multiplies two (N, 4, 4) arrays of matrices element-wise, out[i] = lhs[i]
+/// @ rhs[i]
+template <typename T>
+auto matmul(const ArrayNp<T>& lhs_np, const ArrayNp<T>& rhs_np,
+            const py::object& out) -> OutArrayNp<T> {
+    static_assert(sizeof(Matrix4<T>) == 16 * sizeof(T),
+                  "matmul requires the storage of Matrix4 to be packed");
+    const auto num = batch_size<T>(lhs_np, 3, 4, "matmul");
+    if (batch_size<T>(rhs_np, 3, 4, "matmul") != num) {
+        throw std::runtime_error(
+            "matmul: lhs and rhs must have the same number of matrices");
+    }
+    auto dst_np =
+        output_array<T>(out, {static_cast<py::ssize_t>(num), 4, 4}, "matmul");
+    // NumPy arrays are row-major, so each one is read as the transpose of the
+    // (column-major) matrix, and (lhs * rhs)^T = rhs^T * lhs^T is the transpose
+    // of the result we're after, i.e. the result itself in row-major order
+    const auto* lhs_t = reinterpret_cast<const Matrix4<T>*>(  // NOLINT
+        lhs_np.data());
+    const auto* rhs_t = reinterpret_cast<const Matrix4<T>*>(  // NOLINT
+        rhs_np.data());
+    auto* dst_t = reinterpret_cast<Matrix4<T>*>(  // NOLINT
+        dst_np.mutable_data());
+    {
+        py::gil_scoped_release release;
+        parallel::ParallelFor(num, [&](size_t begin, size_t end) {
+            ::math::multiplyMatrices<T>(rhs_t + begin, lhs_t + begin,
+                                        dst_t + begin, end - begin);
+        });
+    }
+    return dst_np;
+}
+
+auto bindings_batch_functions(py::module m) -> void {
+    // The float64 versions are registered first, so they're the ones used for
+    // inputs that require a conversion (e.g. lists). The overloads that take
+    // math3d objects go before the ones that take arrays, and the ones that
+    // take arrays of math3d objects (e.g. Vector3Array_d) go first
+    m.def("transform_points", transform_points_mat4_objects<float64_t>,
+          py::arg("transform"), py::arg("points"), py::arg("out") = py::none());
+    m.def("transform_points", transform_points_mat4_objects<float32_t>,
+          py::arg("transform"), py::arg("points"), py::arg("out") = py::none());
+    m.def("transform_points", transform_points_pose_objects<float64_t>,
+          py::arg("pose"), py::arg("points"), py::arg("out") = py::none());
+    m.def("transform_points", transform_points_pose_objects<float32_t>,
+          py::arg("pose"), py::arg("points"), py::arg("out") = py::none());
+    m.def("transform_points", transform_points_mat4<float64_t>,
+          py::arg("transform"), py::arg("points"), py::arg("out") = py::none());
+    m.def("transform_points", transform_points_mat4<float32_t>,
+          py::arg("transform"), py::arg("points"), py::arg("out") = py::none());
+    m.def("transform_points", transform_points_pose<float64_t>,
+          py::arg("pose"), py::arg("points"), py::arg("out") = py::none());
+    m.def("transform_points", transform_points_pose<float32_t>,
+          py::arg("pose"), py::arg("points"), py::arg("out") = py::none());
+    m.def("transform_points", transform_points_array<float64_t>,
+          py::arg("transform"), py::arg("points"), py::arg("out") = py::none());
+    m.def("transform_points", transform_points_array<float32_t>,
+          py::arg("transform"), py::arg("points"), py::arg("out") = py::none());
+
+    m.def("rotate_vectors", rotate_vectors_objects<float64_t>,
+          py::arg("rotation"), py::arg("vectors"), py::arg("out") = py::none());
+    m.def("rotate_vectors", rotate_vectors_objects<float32_t>,
+          py::arg("rotation"), py::arg("vectors"), py::arg("out") = py::none());
+    m.def("rotate_vectors", rotate_vectors_quat<float64_t>,
+          py::arg("rotation"), py::arg("vectors"), py::arg("out") = py::none());
+    m.def("rotate_vectors", rotate_vectors_quat<float32_t>,
+          py::arg("rotation"), py::arg("vectors"), py::arg("out") = py::none());
+    m.def("rotate_vectors", rotate_vectors_array<float64_t>,
+          py::arg("rotation"), py::arg("vectors"), py::arg("out") = py::none());
+    m.def("rotate_vectors", rotate_vectors_array<float32_t>,
+          py::arg("rotation"), py::arg("vectors"), py::arg("out") = py::none());
+
+    m.def("compose_poses", compose_poses_objects<float64_t>, py::arg("lhs"),
+          py::arg("rhs"), py::arg("out") = py::none(),
+          py::arg("renormalize") = true);
+    m.def("compose_poses", compose_poses_objects<float32_t>, py::arg("lhs"),
+          py::arg("rhs"), py::arg("out") = py::none(),
+          py::arg("renormalize") = true);
+    m.def("compose_poses", compose_poses<float64_t>, py::arg("lhs"),
+          py::arg("rhs"), py::arg("out") = py::none(),
+          py::arg("renormalize") = true);
+    m.def("compose_poses", compose_poses<float32_t>, py::arg("lhs"),
+          py::arg("rhs"), py::arg("out") = py::none(),
+          py::arg("renormalize") = true);
+
+    m.def("matmul", matmul_objects<float64_t>, py::arg("lhs"), py::arg("rhs"),
+          py::arg("out") = py::none());
+    m.def("matmul", matmul_objects<float32_t>, py::arg("lhs"), py::arg("rhs"),
+          py::arg("out") = py::none());
+    m.def("matmul", matmul<float64_t>, py::arg("lhs"), py::arg("rhs"),
+          py::arg("out") = py::none());
+    m.def("matmul", matmul<float32_t>, py::arg("lhs"), py::arg("rhs"),
+          py::arg("out") = py::none());
+}
+
+}  // namespace math
@@ -0,0 +1,193 @@
+#pragma once
+
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <pybind11/pybind11.h>
+#include <pybind11/numpy.h>
+
+#include <math/vec3_t.hpp>
+#include <math/pose3d_t.hpp>
+
+// -----------------------------------------------------------------------------
+// Helpers shared by the functions that take NumPy arrays of N elements, e.g.
+// (N, 3) arrays of points or (N, 7) arrays of poses, and run the batch kernels
+// over them in a single call.
+//
+// The inputs are converted to C-contiguous arrays of the right dtype (a copy is
+// only made if required). The outputs can be provided by the caller (`out`),
+// in which case these must already be C-contiguous, writeable, and of the
+// right dtype and shape, as no copy is made to write the results into them.
+// -----------------------------------------------------------------------------
+
+namespace py = pybind11;
+
+namespace math {
+
+template <typename T>
+using ArrayNp = py::array_t<T, py::array::c_style | py::array::forcecast>;
+
+template <typename T>
+using OutArrayNp = py::array_t<T, py::array::c_style>;
+
+/// Returns the string representation of the given shape, e.g. "(N, 4, 4)"
+inline auto shape_to_string(const std::vector<py::ssize_t>& shape)
+    -> std::string {
+    std::string str = "(N";
+    for (size_t k = 1; k < shape.size(); ++k) {
+        str += ", " + std::to_string(shape[k]);
+    }
+    return str + ")";
+}
+
+/// Returns the number of entries N of the given (N, dim) or (N, dim, dim)
+/// array, or throws if the array doesn't have that shape
+template <typename T>
+auto batch_size(const ArrayNp<T>& array_np, py::ssize_t ndim, py::ssize_t dim,
+                const char* func_name) -> size_t {
+    bool is_valid_shape = (array_np.ndim() == ndim);
+    for (py::ssize_t k = 1; is_valid_shape && k < ndim; ++k) {
+        is_valid_shape = (array_np.shape(k) == dim);
+    }
+    if (!is_valid_shape) {
+        const std::vector<py::ssize_t> shape(static_cast<size_t>(ndim), dim);
+        throw std::runtime_error(std::string(func_name) +
+                                 ": incompatible shape, expected " +
+                                 shape_to_string(shape));
+    }
+    return static_cast<size_t>(array_np.shape(0));
+}
+
+/// Returns the array given as `out` (checked against the expected dtype and
+/// shape), or a new array of that shape if `out` is None
+template <typename T>
+auto output_array(const py::object& out, const std::vector<py::ssize_t>& shape,
+                  const char* func_name) -> OutArrayNp<T> {
+    if (out.is_none()) {
+        return OutArrayNp<T>(shape);
+    }
+    if (!py::isinstance<OutArrayNp<T>>(out)) {
+        throw std::runtime_error(
+            std::string(func_name) + ": out must be a C-contiguous " +
+            (IsFloat32<T>::value ? "float32" : "float64") + " array");
+    }
+    auto out_np = py::reinterpret_borrow<OutArrayNp<T>>(out);
+    bool is_valid_shape =
+        (out_np.ndim() == static_cast<py::ssize_t>(shape.size()));
+    for (size_t k = 0; is_valid_shape && k < shape.size(); ++k) {
+        is_valid_shape =
+            (out_np.shape(static_cast<py::ssize_t>(k)) == shape[k]);
+    }
+    if (!is_valid_shape) {
+        throw std::runtime_error(std::string(func_name) +
+                                 ": incompatible shape of out, expected " +
+                                 shape_to_string(shape));
+    }
+    if (!out_np.writeable()) {
+        throw std::runtime_error(std::string(func_name) +
+                                 ": out must be writeable");
+    }
+    return out_np;
+}
+
+/// Returns the (N, 3) array as an array of Vector3, which only requires a copy
+/// if the storage of Vector3 is padded (MATH3D_VEC3_PADDED)
+template <typename T>
+auto as_vec3_array(const T* data, size_t num, std::vector<Vector3<T>>& storage)
+    -> const Vector3<T>* {
+#if defined(MATH3D_VEC3_PADDED)
+    storage.resize(num);
+    for (size_t i = 0; i < num; ++i) {
+        storage[i] = Vector3<T>(data[3 * i], data[3 * i + 1], data[3 * i + 2]);
+    }
+    return storage.data();
+#else
+    (void)num;
+    (void)storage;
+    return reinterpret_cast<const Vector3<T>*>(data);  // NOLINT
+#endif
+}
+
+/// Returns the (N, 3) array as an array of Vector3 to write results into. If
+/// Vector3 is padded, these are written into `storage` instead, and have to be
+/// copied back with store_vec3_array
+template <typename T>
+auto as_mutable_vec3_array(T* data, size_t num,
+                           std::vector<Vector3<T>>& storage) -> Vector3<T>* {
+#if defined(MATH3D_VEC3_PADDED)
+    (void)data;
+    storage.resize(num);
+    return storage.data();
+#else
+    (void)num;
+    (void)storage;
+    return reinterpret_cast<Vector3<T>*>(data);  // NOLINT
+#endif
+}
+
+/// Copies the results written by as_mutable_vec3_array back into the array
+template <typename T>
+auto store_vec3_array(T* data, const std::vector<Vector3<T>>& storage)
+    -> void {
+    for (size_t i = 0; i < storage.size(); ++i) {
+        data[3 * i + 0] = storage[i].x();
+        data[3 * i + 1] = storage[i].y();
+        data[3 * i + 2] = storage[i].z();
+    }
+}
+
+/// Number of scalars of each pose of an (N, 7) array: the position (x, y, z)
+/// followed by the orientation (w, x, y, z), the same layout as Pose3d
+constexpr size_t POSE_NUM_SCALARS = 7;
+
+/// Returns whether the storage of Pose3d is the same as the rows of an (N, 7)
+/// array (i.e. Vector3 isn't padded), so the array can be used in place
+template <typename T>
+constexpr auto is_pose3d_packed() -> bool {
+    return sizeof(Pose3d<T>) == POSE_NUM_SCALARS * sizeof(T);
+}
+
+/// Returns the (N, 7) array as an array of Pose3d, which only requires a copy
+/// if the storage of Pose3d is padded
+template <typename T>
+auto as_pose3d_array(const T* data, size_t num,
+                     std::vector<Pose3d<T>>& storage) -> const Pose3d<T>* {
+    if (is_pose3d_packed<T>()) {
+        return reinterpret_cast<const Pose3d<T>*>(data);  // NOLINT
+    }
+    storage.resize(num);
+    for (size_t i = 0; i < num; ++i) {
+        const T* pose = data + POSE_NUM_SCALARS * i;
+        storage[i].position = Vector3<T>(pose[0], pose[1], pose[2]);
+        storage[i].orientation =
+            Quaternion<T>(pose[3], pose[4], pose[5], pose[6]);
+    }
+    return storage.data();
+}
+
+/// Returns the (N, 7) array as an array of Pose3d to write results into (see
+/// as_mutable_vec3_array, the results are copied back with store_pose3d_array)
+template <typename T>
+auto as_mutable_pose3d_array(T* data, size_t num,
+                             std::vector<Pose3d<T>>& storage) -> Pose3d<T>* {
+    if (is_pose3d_packed<T>()) {
+        return reinterpret_cast<Pose3d<T>*>(data);  // NOLINT
+    }
+    storage.resize(num);
+    return storage.data();
+}
+
+/// Copies the results written by as_mutable_pose3d_array back into the array
+template <typename T>
+auto store_pose3d_array(T* data, const std::vector<Pose3d<T>>& storage)
+    -> void {
+    for (size_t i = 0; i < storage.size(); ++i) {
+        T* pose = data + POSE_NUM_SCALARS * i;
+        std::memcpy(pose, storage[i].position.data(), 3 * sizeof(T));
+        std::memcpy(pose + 3, storage[i].orientation.data(), 4 * sizeof(T));
+    }
+}
+
+}  // namespace math
@@ -9,6 +9,7 @@
 #include <quat_py.hpp>
 #include <euler_py.hpp>
 #include <pose3d_py.hpp>
+#include <arrays_py.hpp>
 #include <utils/geometry_helpers_py.hpp>
 
 namespace py = pybind11;
@@ -16,12 +17,17 @@ namespace py = pybind11;
 namespace math {
 
 extern auto bindings_conversions_functions(py::module m) -> void;
+extern auto bindings_dispatch_functions(py::module m) -> void;
+extern auto bindings_parallel_functions(py::module m) -> void;
 extern auto bindings_vec2_functions(py::module m) -> void;
 extern auto bindings_vec3_functions(py::module m) -> void;
 extern auto bindings_vec4_functions(py::module m) -> void;
 extern auto bindings_mat2_functions(py::module m) -> void;
 extern auto bindings_mat3_functions(py::module m) -> void;
 extern auto bindings_mat4_functions(py::module m) -> void;
+extern auto bindings_quat_functions(py::module m) -> void;
+extern auto bindings_batch_functions(py::module m) -> void;
+extern auto bindings_geometry_functions(py::module m) -> void;
 
 }  // namespace math
 
@@ -47,14 +53,35 @@ PYBIND11_MODULE(math3d_bindings, m) {
     ::math::bindings_pose3d<::math::float32_t>(m, "Pose3d_f");
     ::math::bindings_pose3d<::math::float64_t>(m, "Pose3d_d");
 
+    ::math::bindings_array<::math::Vector3<::math::float32_t>>(
+        m, "Vector3Array_f");
+    ::math::bindings_array<::math::Vector3<::math::float64_t>>(
+        m, "Vector3Array_d");
+    ::math::bindings_array<::math::Quaternion<::math::float32_t>>(
+        m, "QuaternionArray_f");
+    ::math::bindings_array<::math::Quaternion<::math::float64_t>>(
+        m, "QuaternionArray_d");
+    ::math::bindings_array<::math::Matrix4<::math::float32_t>>(
+        m, "Matrix4Array_f");
+    ::math::bindings_array<::math::Matrix4<::math::float64_t>>(
+        m, "Matrix4Array_d");
+    ::math::bindings_pose3d_array<::math::float32_t>(m, "Pose3dArray_f");
+    ::math::bindings_pose3d_array<::math::float64_t>(m, "Pose3dArray_d");
+
     ::math::bindings_utils_line<::math::float32_t>(m, "Line_f");
     ::math::bindings_utils_line<::math::float64_t>(m, "Line_d");
     ::math::bindings_utils_plane<::math::float32_t>(m, "Plane_f");
     ::math::bindings_utils_plane<::math::float64_t>(m, "Plane_d");
     ::math::bindings_utils_aabb<::math::float32_t>(m, "AABB_f");
     ::math::bindings_utils_aabb<::math::float64_t>(m, "AABB_d");
+    ::math::bindings_utils_ray<::math::float32_t>(m, "Ray_f");
+    ::math::bindings_utils_ray<::math::float64_t>(m, "Ray_d");
+    ::math::bindings_utils_frustum<::math::float32_t>(m, "Frustum_f");
+    ::math::bindings_utils_frustum<::math::float64_t>(m, "Frustum_d");
 
     ::math::bindings_conversions_functions(m);
+    ::math::bindings_dispatch_functions(m);
+    ::math::bindings_parallel_functions(m);
 
     ::math::bindings_vec2_functions(m);
     ::math::bindings_vec3_functions(m);
@@ -63,4 +90,9 @@ PYBIND11_MODULE(math3d_bindings, m) {
     ::math::bindings_mat2_functions(m);
     ::math::bindings_mat3_functions(m);
     ::math::bindings_mat4_functions(m);
+
+    ::math::bindings_quat_functions(m);
+
+    ::math::bindings_batch_functions(m);
+    ::math::bindings_geometry_functions(m);
 }
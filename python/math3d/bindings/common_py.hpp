@@ -85,7 +85,8 @@
                                py::format_descriptor<T>::format(),          \
                                Class::MATRIX_NDIM,                          \
                                {Class::MATRIX_SIZE, Class::MATRIX_SIZE},    \
-                               {sizeof(T), sizeof(T) * Class::MATRIX_SIZE});\
+                               {sizeof(T),                                  \
+                                sizeof(typename Class::ColumnType)});       \
     })
 
 // NOLINTNEXTLINE
@@ -230,9 +231,9 @@
     })                                                                  \
     .def("determinant", [](const Class& self) -> Type {                 \
         return ::math::determinant<Type>(self);                         \
-    })                                                                  \
+    }, py::call_guard<py::gil_scoped_release>())                        \
     .def("inverse", [](const Class& self) -> Class {                    \
         return ::math::inverse<Type>(self);                             \
-    })
+    }, py::call_guard<py::gil_scoped_release>())
 
 // clang-format on
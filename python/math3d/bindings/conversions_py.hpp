@@ -57,7 +57,8 @@ namespace py = pybind11;
 // NOLINTNEXTLINE
 #define VECTOR_TO_NPARRAY(VecCls, xvec)                             \
     auto array_np = py::array_t<T>(VecCls::VECTOR_SIZE);            \
-    memcpy(array_np.request().ptr, xvec.data(), sizeof(VecCls));    \
+    memcpy(array_np.request().ptr, xvec.data(),                     \
+           sizeof(T) * VecCls::VECTOR_SIZE);                        \
     return array_np
 
 // NOLINTNEXTLINE
@@ -69,7 +70,7 @@ namespace py = pybind11;
                                  " elements");                              \
     }                                                                       \
     VecCls vec;                                                             \
-    memcpy(vec.data(), info.ptr, sizeof(VecCls));                           \
+    memcpy(vec.data(), info.ptr, sizeof(T) * VecCls::VECTOR_SIZE);         \
     return vec
 
 // NOLINTNEXTLINE
@@ -118,7 +119,7 @@ namespace py = pybind11;
                         py::format_descriptor<Type>::format(),          \
                         2,                                              \
                         {SIZE_N, SIZE_N},                               \
-                        {sizeof(Type), sizeof(Type) * SIZE_N}))
+                        {sizeof(Type), sizeof(typename MatCls::ColumnType)}))
 
 
 // NOLINTNEXTLINE
@@ -0,0 +1,28 @@
+#include <string>
+#include <vector>
+
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+#include <math/dispatch.hpp>
+
+namespace py = pybind11;
+
+namespace math {
+
+auto bindings_dispatch_functions(py::module m) -> void {
+    py::enum_<::math::dispatch::Isa>(m, "eIsa")
+        .value("SCALAR", ::math::dispatch::Isa::SCALAR)
+        .value("SSE", ::math::dispatch::Isa::SSE)
+        .value("AVX", ::math::dispatch::Isa::AVX)
+        .value("AVX512", ::math::dispatch::Isa::AVX512);
+
+    m.def("get_active_isa", ::math::dispatch::GetActiveIsa);
+    m.def("set_active_isa", ::math::dispatch::SetActiveIsa);
+    m.def("reset_active_isa", ::math::dispatch::ResetActiveIsa);
+    m.def("get_best_isa", ::math::dispatch::GetBestIsa);
+    m.def("get_supported_isas", ::math::dispatch::GetSupportedIsas);
+    m.def("is_isa_supported", ::math::dispatch::IsSupported);
+}
+
+}  // namespace math
@@ -0,0 +1,255 @@
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <pybind11/pybind11.h>
+#include <pybind11/numpy.h>
+
+#include <math/aabb_batch_t.hpp>
+#include <math/frustum_culling.hpp>
+#include <math/parallel.hpp>
+#include <math/utils/bvh.hpp>
+
+#include <batch_helpers_py.hpp>
+
+namespace py = pybind11;
+
+namespace math {
+
+/// Minimum number of rays handled by each thread in raycast_aabbs (each one is
+/// a traversal of the BVH, much more work than an element of a batch kernel)
+constexpr size_t MIN_RAYS_PER_THREAD = 64;
+
+/// Returns the rays given by two (N, 3) arrays of origins and directions
+template <typename T>
+auto rays_from_arrays(const ArrayNp<T>& origins_np,
+                      const ArrayNp<T>& directions_np, const char* func_name)
+    -> std::vector<Ray<T>> {
+    const auto num = batch_size<T>(origins_np, 2, 3, func_name);
+    if (batch_size<T>(directions_np, 2, 3, func_name) != num) {
+        throw std::runtime_error(
+            std::string(func_name) +
+            ": origins and directions must have the same number of rays");
+    }
+    const auto* origins = origins_np.data();
+    const auto* directions = directions_np.data();
+    std::vector<Ray<T>> rays(num);
+    for (size_t i = 0; i < num; ++i) {
+        rays[i] = Ray<T>(Vector3<T>(origins[3 * i], origins[3 * i + 1],
+                                    origins[3 * i + 2]),
+                         Vector3<T>(directions[3 * i], directions[3 * i + 1],
+                                    directions[3 * i + 2]));
+    }
+    return rays;
+}
+
+/// Returns the boxes given by two (M, 3) arrays of lower and upper boundaries
+template <typename T>
+auto boxes_from_arrays(const ArrayNp<T>& mins_np, const ArrayNp<T>& maxs_np,
+                       const char* func_name) -> std::vector<AABB<T>> {
+    const auto num = batch_size<T>(mins_np, 2, 3, func_name);
+    if (batch_size<T>(maxs_np, 2, 3, func_name) != num) {
+        throw std::runtime_error(
+            std::string(func_name) +
+            ": mins and maxs must have the same number of boxes");
+    }
+    const auto* mins = mins_np.data();
+    const auto* maxs = maxs_np.data();
+    std::vector<AABB<T>> boxes(num);
+    for (size_t i = 0; i < num; ++i) {
+        boxes[i] = AABB<T>(
+            Vector3<T>(mins[3 * i], mins[3 * i + 1], mins[3 * i + 2]),
+            Vector3<T>(maxs[3 * i], maxs[3 * i + 1], maxs[3 * i + 2]));
+    }
+    return boxes;
+}
+
+/// Returns the points given by an (N, 3) array, gathered into SoA
+template <typename T>
+auto points_from_array(const ArrayNp<T>& points_np, const char* func_name)
+    -> Vector3Batch<T> {
+    const auto num = batch_size<T>(points_np, 2, 3, func_name);
+    const auto* points = points_np.data();
+    Vector3Batch<T> batch(num);
+    for (size_t i = 0; i < num; ++i) {
+        batch.set(i, Vector3<T>(points[3 * i], points[3 * i + 1],
+                                points[3 * i + 2]));
+    }
+    return batch;
+}
+
+/// Runs a culling call over [0, num) in parallel and returns its results as an
+/// (N,) array of bools. The ranges start at multiples of 64, so each thread
+/// writes whole words of the bitmask
+template <typename Fn>
+auto cull_to_bools(size_t num, Fn cull_range) -> py::array_t<bool> {
+    py::array_t<bool> dst_np(static_cast<py::ssize_t>(num));
+    auto* dst = dst_np.mutable_data();
+    {
+        py::gil_scoped_release release;
+        std::vector<uint64_t> visible(bitmaskWords(num));
+        parallel::ParallelFor(
+            num,
+            [&](size_t begin, size_t end) {
+                cull_range(begin, end - begin, visible.data() + begin / 64);
+                for (size_t i = begin; i < end; ++i) {
+                    dst[i] = bitmaskTest(visible.data(), i);
+                }
+            },
+            parallel::MIN_ELEMENTS_PER_THREAD, 64);
+    }
+    return dst_np;
+}
+
+/// Returns an (N,) array with whether each of the N points is in the frustum
+template <typename T>
+auto cull_points(const Frustum<T>& frustum, const ArrayNp<T>& points_np)
+    -> py::array_t<bool> {
+    const auto points = points_from_array<T>(points_np, "cull_points");
+    return cull_to_bools(
+        points.size(), [&](size_t begin, size_t num, uint64_t* visible) {
+            ::math::cullPoints<T>(frustum, points.planes().offset(begin), num,
+                                  visible);
+        });
+}
+
+/// Returns an (N,) array with whether each of the N spheres given by an (N, 3)
+/// array of centers and an (N,) array of radii may be visible
+template <typename T>
+auto cull_spheres(const Frustum<T>& frustum, const ArrayNp<T>& centers_np,
+                  const ArrayNp<T>& radii_np) -> py::array_t<bool> {
+    const auto centers = points_from_array<T>(centers_np, "cull_spheres");
+    if (batch_size<T>(radii_np, 1, 1, "cull_spheres") != centers.size()) {
+        throw std::runtime_error(
+            "cull_spheres: centers and radii must have the same number of "
+            "spheres");
+    }
+    const auto* radii = radii_np.data();
+    return cull_to_bools(
+        centers.size(), [&](size_t begin, size_t num, uint64_t* visible) {
+            ::math::cullSpheres<T>(frustum, centers.planes().offset(begin),
+                                   radii + begin, num, visible);
+        });
+}
+
+/// Returns an (M,) array with whether each of the M boxes may be visible
+template <typename T>
+auto cull_aabbs(const Frustum<T>& frustum, const ArrayNp<T>& mins_np,
+                const ArrayNp<T>& maxs_np) -> py::array_t<bool> {
+    const AABBBatch<T> boxes(
+        boxes_from_arrays<T>(mins_np, maxs_np, "cull_aabbs"));
+    return cull_to_bools(
+        boxes.size(), [&](size_t begin, size_t num, uint64_t* visible) {
+            ::math::cullBoxes<T>(frustum, boxes.planes().offset(begin), num,
+                                 visible);
+        });
+}
+
+/// Returns the (N, M) array with the distance at which each of the N rays
+/// enters each of the M boxes (infinity if it misses the box)
+template <typename T>
+auto intersect_rays_aabbs(const ArrayNp<T>& origins_np,
+                          const ArrayNp<T>& directions_np,
+                          const ArrayNp<T>& mins_np, const ArrayNp<T>& maxs_np,
+                          T t_max) -> OutArrayNp<T> {
+    const auto rays =
+        rays_from_arrays<T>(origins_np, directions_np, "intersect_rays_aabbs");
+    const auto boxes =
+        boxes_from_arrays<T>(mins_np, maxs_np, "intersect_rays_aabbs");
+    const auto num_rays = rays.size();
+    const auto num_boxes = boxes.size();
+    OutArrayNp<T> dst_np({static_cast<py::ssize_t>(num_rays),
+                          static_cast<py::ssize_t>(num_boxes)});
+    auto* dst = dst_np.mutable_data();
+    {
+        py::gil_scoped_release release;
+        // Gathered once into SoA, so each ray runs the SIMD kernel over all
+        // the boxes. Each ray is a batch call over num_boxes elements, so the
+        // threads get at least as many ray-box tests as in the other calls
+        const AABBBatch<T> batch(boxes);
+        const size_t min_rays = std::max<size_t>(
+            1, parallel::MIN_ELEMENTS_PER_THREAD /
+                   std::max<size_t>(num_boxes, 1));
+        parallel::ParallelFor(
+            num_rays,
+            [&](size_t begin, size_t end) {
+                for (size_t i = begin; i < end; ++i) {
+                    ::math::intersect<T>(rays[i], batch, dst + i * num_boxes,
+                                         t_max);
+                }
+            },
+            min_rays);
+    }
+    return dst_np;
+}
+
+/// Returns the index of the closest box hit by each of the N rays (-1 if none)
+/// and the distance at which it enters that box (infinity if none), as a tuple
+/// of two (N,) arrays
+template <typename T>
+auto raycast_aabbs(const ArrayNp<T>& origins_np,
+                   const ArrayNp<T>& directions_np, const ArrayNp<T>& mins_np,
+                   const ArrayNp<T>& maxs_np, T t_max) -> py::tuple {
+    const auto rays =
+        rays_from_arrays<T>(origins_np, directions_np, "raycast_aabbs");
+    const auto boxes = boxes_from_arrays<T>(mins_np, maxs_np, "raycast_aabbs");
+    const auto num_rays = rays.size();
+    py::array_t<int64_t> indices_np(static_cast<py::ssize_t>(num_rays));
+    OutArrayNp<T> distances_np(static_cast<py::ssize_t>(num_rays));
+    auto* indices = indices_np.mutable_data();
+    auto* distances = distances_np.mutable_data();
+    {
+        py::gil_scoped_release release;
+        const BVH<T> bvh(boxes.data(), boxes.size());
+        const auto invalid = static_cast<size_t>(BVH<T>::INVALID_INDEX);
+        parallel::ParallelFor(
+            num_rays,
+            [&](size_t begin, size_t end) {
+                std::vector<size_t> hits(end - begin);
+                bvh.closestHits(rays.data() + begin, end - begin, hits.data(),
+                                distances + begin, t_max);
+                for (size_t i = begin; i < end; ++i) {
+                    const auto hit = hits[i - begin];
+                    indices[i] =
+                        (hit == invalid) ? -1 : static_cast<int64_t>(hit);
+                }
+            },
+            MIN_RAYS_PER_THREAD);
+    }
+    return py::make_tuple(indices_np, distances_np);
+}
+
+auto bindings_geometry_functions(py::module m) -> void {
+    // The float64 versions are registered first (see batch_functions_py.cpp)
+    constexpr auto INF_F64 = std::numeric_limits<float64_t>::infinity();
+    constexpr auto INF_F32 = std::numeric_limits<float32_t>::infinity();
+    m.def("intersect_rays_aabbs", intersect_rays_aabbs<float64_t>,
+          py::arg("origins"), py::arg("directions"), py::arg("mins"),
+          py::arg("maxs"), py::arg("t_max") = INF_F64);
+    m.def("intersect_rays_aabbs", intersect_rays_aabbs<float32_t>,
+          py::arg("origins"), py::arg("directions"), py::arg("mins"),
+          py::arg("maxs"), py::arg("t_max") = INF_F32);
+    m.def("raycast_aabbs", raycast_aabbs<float64_t>, py::arg("origins"),
+          py::arg("directions"), py::arg("mins"), py::arg("maxs"),
+          py::arg("t_max") = INF_F64);
+    m.def("raycast_aabbs", raycast_aabbs<float32_t>, py::arg("origins"),
+          py::arg("directions"), py::arg("mins"), py::arg("maxs"),
+          py::arg("t_max") = INF_F32);
+    m.def("cull_points", cull_points<float64_t>, py::arg("frustum"),
+          py::arg("points"));
+    m.def("cull_points", cull_points<float32_t>, py::arg("frustum"),
+          py::arg("points"));
+    m.def("cull_spheres", cull_spheres<float64_t>, py::arg("frustum"),
+          py::arg("centers"), py::arg("radii"));
+    m.def("cull_spheres", cull_spheres<float32_t>, py::arg("frustum"),
+          py::arg("centers"), py::arg("radii"));
+    m.def("cull_aabbs", cull_aabbs<float64_t>, py::arg("frustum"),
+          py::arg("mins"), py::arg("maxs"));
+    m.def("cull_aabbs", cull_aabbs<float32_t>, py::arg("frustum"),
+          py::arg("mins"), py::arg("maxs"));
+}
+
+}  // namespace math
@@ -24,17 +24,23 @@ auto bindings_mat2_functions(py::module m) -> void {
     m.def("trace", static_cast<float64_t (*)(const Matrix2<float64_t>&)>(
                        ::math::trace<float64_t>));
 
-    m.def("determinant", static_cast<float32_t (*)(const Matrix2<float32_t>&)>(
-                             ::math::determinant<float32_t>));
-    m.def("determinant", static_cast<float64_t (*)(const Matrix2<float64_t>&)>(
-                             ::math::determinant<float64_t>));
+    m.def("determinant",
+          static_cast<float32_t (*)(const Matrix2<float32_t>&)>(
+              ::math::determinant<float32_t>),
+          py::call_guard<py::gil_scoped_release>());
+    m.def("determinant",
+          static_cast<float64_t (*)(const Matrix2<float64_t>&)>(
+              ::math::determinant<float64_t>),
+          py::call_guard<py::gil_scoped_release>());
 
     m.def("inverse",
           static_cast<Matrix2<float32_t> (*)(const Matrix2<float32_t>&)>(
-              ::math::inverse<float32_t>));
+              ::math::inverse<float32_t>),
+          py::call_guard<py::gil_scoped_release>());
     m.def("inverse",
           static_cast<Matrix2<float64_t> (*)(const Matrix2<float64_t>&)>(
-              ::math::inverse<float64_t>));
+              ::math::inverse<float64_t>),
+          py::call_guard<py::gil_scoped_release>());
 }
 
 }  // namespace math
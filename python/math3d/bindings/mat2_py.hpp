@@ -47,8 +47,8 @@ auto bindings_matrix2(py::module& m, const char* class_name) -> void {
              [](const Class& self) -> py::array_t<T> {
                  return py::array_t<T>(
                      {Class::MATRIX_SIZE, Class::MATRIX_SIZE},
-                     {sizeof(T), sizeof(T) * Class::MATRIX_SIZE}, self.data(),
-                     py::cast(self));
+                     {sizeof(T), sizeof(typename Class::ColumnType)},
+                     self.data(), py::cast(self));
              })
         .def("flatten",
              [](const Class& self) -> py::array_t<T> {
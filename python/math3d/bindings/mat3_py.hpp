@@ -47,20 +47,34 @@ auto bindings_matrix3(py::module& m, const char* class_name) -> void {
              [](const Class& self) -> py::array_t<T> {
                  return py::array_t<T>(
                      {Class::MATRIX_SIZE, Class::MATRIX_SIZE},
-                     {sizeof(T), sizeof(T) * Class::MATRIX_SIZE}, self.data(),
-                     py::cast(self));
+                     {sizeof(T), sizeof(typename Class::ColumnType)},
+                     self.data(), py::cast(self));
              })
         .def("flatten",
              [](const Class& self) -> py::array_t<T> {
+#if defined(MATH3D_VEC3_PADDED)
+                 // The padded columns aren't contiguous, so return a copy of
+                 // the entries (in column-major order) instead of a view
+                 constexpr auto SIZE_N = Class::MATRIX_SIZE;
+                 py::array_t<T> flat(SIZE_N * SIZE_N);
+                 auto* flat_data = flat.mutable_data();
+                 for (uint32_t j = 0; j < SIZE_N; ++j) {
+                     for (uint32_t i = 0; i < SIZE_N; ++i) {
+                         flat_data[i + j * SIZE_N] = self(i, j);
+                     }
+                 }
+                 return flat;
+#else
                  return py::array_t<T>(Class::BUFFER_SIZE, self.data(),
                                        py::cast(self));
+#endif
              })
         .def_property_readonly(
             "T",
             [](const Class& self) -> Class { return math::transpose<T>(self); })
-        .def_static("RotationX", &Class::RotationX)
-        .def_static("RotationY", &Class::RotationY)
-        .def_static("RotationZ", &Class::RotationZ)
+        .def_static("RotationX", &Class::template RotationX<>)
+        .def_static("RotationY", &Class::template RotationY<>)
+        .def_static("RotationZ", &Class::template RotationZ<>)
         .def_static("Scale",
                     [](T scale_x, T scale_y, T scale_z) -> Class {
                         return Class::Scale(scale_x, scale_y, scale_z);
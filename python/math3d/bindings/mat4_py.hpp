@@ -26,9 +26,6 @@ namespace math {
 template <typename T>
 using SFINAE_MAT4_BINDINGS = typename std::enable_if<IsScalar<T>::value>::type*;
 
-template <typename... Args>
-using overload_cast = pybind11::detail::overload_cast_impl<Args...>;
-
 template <typename T, SFINAE_MAT4_BINDINGS<T> = nullptr>
 // NOLINTNEXTLINE
 auto bindings_matrix4(py::module& m, const char* class_name) -> void {
@@ -50,8 +47,8 @@ auto bindings_matrix4(py::module& m, const char* class_name) -> void {
              [](const Class& self) -> py::array_t<T> {
                  return py::array_t<T>(
                      {Class::MATRIX_SIZE, Class::MATRIX_SIZE},
-                     {sizeof(T), sizeof(T) * Class::MATRIX_SIZE}, self.data(),
-                     py::cast(self));
+                     {sizeof(T), sizeof(typename Class::ColumnType)},
+                     self.data(), py::cast(self));
              })
         .def("flatten",
              [](const Class& self) -> py::array_t<T> {
@@ -61,9 +58,9 @@ auto bindings_matrix4(py::module& m, const char* class_name) -> void {
         .def_property_readonly(
             "T",
             [](const Class& self) -> Class { return math::transpose<T>(self); })
-        .def_static("RotationX", &Class::RotationX)
-        .def_static("RotationY", &Class::RotationY)
-        .def_static("RotationZ", &Class::RotationZ)
+        .def_static("RotationX", &Class::template RotationX<>)
+        .def_static("RotationY", &Class::template RotationY<>)
+        .def_static("RotationZ", &Class::template RotationZ<>)
         .def_static("Scale",
                     [](T scale_x, T scale_y, T scale_z) -> Class {
                         return Class::Scale(scale_x, scale_y, scale_z);
@@ -73,10 +70,9 @@ auto bindings_matrix4(py::module& m, const char* class_name) -> void {
                         return Class::Scale(scale);
                     })
         .def_static("Translation", &Class::Translation)
-        .def_static("Perspective",
-                    overload_cast<T, T, T, T>()(&Class::Perspective))
-        .def_static("Perspective",
-                    overload_cast<T, T, T, T, T, T>()(&Class::Perspective))
+        .def_static("Perspective", &Class::template Perspective<>)
+        .def_static("Perspective", static_cast<Class (*)(T, T, T, T, T, T)>(
+                                       &Class::Perspective))
         .def_static("Ortho", &Class::Ortho)
         .def_static("Identity", &Class::Identity)
         .def_static("Zeros", &Class::Zeros)
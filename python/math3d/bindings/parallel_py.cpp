@@ -0,0 +1,15 @@
+#include <pybind11/pybind11.h>
+
+#include <math/parallel.hpp>
+
+namespace py = pybind11;
+
+namespace math {
+
+auto bindings_parallel_functions(py::module m) -> void {
+    m.def("get_num_threads", ::math::parallel::GetNumThreads);
+    m.def("set_num_threads", ::math::parallel::SetNumThreads,
+          py::arg("num_threads"));
+}
+
+}  // namespace math
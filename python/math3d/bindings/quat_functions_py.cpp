@@ -0,0 +1,118 @@
+#include <vector>
+
+#include <pybind11/pybind11.h>
+#include <pybind11/numpy.h>
+
+#include <math/mat3_t.hpp>
+#include <math/parallel.hpp>
+#include <math/quat_t.hpp>
+
+#include <batch_helpers_py.hpp>
+
+namespace py = pybind11;
+
+namespace math {
+
+/// Converts an (N, 3) array of Euler angles into an (N, 4) array of (w, x, y,
+/// z) quaternions, written into `out` if given
+template <typename T>
+auto quat_from_euler(const ArrayNp<T>& angles_np, euler::Order order,
+                     const py::object& out) -> OutArrayNp<T> {
+    const auto num = batch_size<T>(angles_np, 2, 3, "quat_from_euler");
+    auto quats_np = output_array<T>(
+        out, {static_cast<py::ssize_t>(num), 4}, "quat_from_euler");
+    const auto* angles_data = angles_np.data();
+    auto* quats = reinterpret_cast<Quaternion<T>*>(  // NOLINT
+        quats_np.mutable_data());
+    {
+        py::gil_scoped_release release;
+        parallel::ParallelFor(num, [&](size_t begin, size_t end) {
+            std::vector<Vector3<T>> storage;
+            const auto* angles = as_vec3_array<T>(angles_data + 3 * begin,
+                                                  end - begin, storage);
+            ::math::quaternionsFromEuler<T>(angles, order, quats + begin,
+                                            end - begin);
+        });
+    }
+    return quats_np;
+}
+
+/// Converts an (N, 3, 3) array of rotation matrices into an (N, 4) array of
+/// (w, x, y, z) quaternions
+template <typename T>
+auto quat_from_rotation_matrix(const ArrayNp<T>& mats_np) -> py::array_t<T> {
+    const auto num =
+        batch_size<T>(mats_np, 3, 3, "quat_from_rotation_matrix");
+    const auto* data = mats_np.data();
+    py::array_t<T> quats_np({num, static_cast<size_t>(4)});
+    auto* quats = reinterpret_cast<Quaternion<T>*>(  // NOLINT
+        quats_np.mutable_data());
+    {
+        py::gil_scoped_release release;
+        parallel::ParallelFor(num, [&](size_t begin, size_t end) {
+            // NumPy arrays are row-major, whereas our matrices are
+            // column-major
+            std::vector<Matrix3<T>> mats(end - begin);
+            for (size_t n = begin; n < end; ++n) {
+                for (uint32_t i = 0; i < 3; ++i) {
+                    for (uint32_t j = 0; j < 3; ++j) {
+                        mats[n - begin](i, j) = data[9 * n + 3 * i + j];
+                    }
+                }
+            }
+            ::math::quaternionsFromRotationMatrices<T>(
+                mats.data(), quats + begin, end - begin);
+        });
+    }
+    return quats_np;
+}
+
+/// Converts an (N, 4) array of (w, x, y, z) quaternions into an (N, 3, 3)
+/// array of rotation matrices
+template <typename T>
+auto rotation_matrix_from_quat(const ArrayNp<T>& quats_np) -> py::array_t<T> {
+    const auto num =
+        batch_size<T>(quats_np, 2, 4, "rotation_matrix_from_quat");
+    const auto* quats =
+        reinterpret_cast<const Quaternion<T>*>(quats_np.data());  // NOLINT
+    constexpr size_t SIZE_N = 3;
+    py::array_t<T> mats_np({num, SIZE_N, SIZE_N});
+    auto* data = mats_np.mutable_data();
+    {
+        py::gil_scoped_release release;
+        parallel::ParallelFor(num, [&](size_t begin, size_t end) {
+            std::vector<Matrix3<T>> mats(end - begin);
+            ::math::rotationMatricesFromQuaternions<T>(
+                quats + begin, mats.data(), end - begin);
+            for (size_t n = begin; n < end; ++n) {
+                for (uint32_t i = 0; i < 3; ++i) {
+                    for (uint32_t j = 0; j < 3; ++j) {
+                        data[9 * n + 3 * i + j] = mats[n - begin](i, j);
+                    }
+                }
+            }
+        });
+    }
+    return mats_np;
+}
+
+auto bindings_quat_functions(py::module m) -> void {
+    // The float64 versions are registered first, so they're the ones used for
+    // inputs that require a conversion (e.g. lists)
+    m.def("quat_from_euler", quat_from_euler<float64_t>, py::arg("angles"),
+          py::arg("order") = euler::Order::XYZ, py::arg("out") = py::none());
+    m.def("quat_from_euler", quat_from_euler<float32_t>, py::arg("angles"),
+          py::arg("order") = euler::Order::XYZ, py::arg("out") = py::none());
+
+    m.def("quat_from_rotation_matrix", quat_from_rotation_matrix<float64_t>,
+          py::arg("mats"));
+    m.def("quat_from_rotation_matrix", quat_from_rotation_matrix<float32_t>,
+          py::arg("mats"));
+
+    m.def("rotation_matrix_from_quat", rotation_matrix_from_quat<float64_t>,
+          py::arg("quats"));
+    m.def("rotation_matrix_from_quat", rotation_matrix_from_quat<float32_t>,
+          py::arg("quats"));
+}
+
+}  // namespace math
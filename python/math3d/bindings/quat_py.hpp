@@ -129,9 +129,9 @@ auto bindings_quaternion(py::module& m, const char* class_name) -> void {
              [](const Class& lhs, const Class& rhs) -> bool {
                  return lhs != rhs;
              })
-        .def_static("RotationX", &Class::RotationX)
-        .def_static("RotationY", &Class::RotationY)
-        .def_static("RotationZ", &Class::RotationZ)
+        .def_static("RotationX", &Class::template RotationX<>)
+        .def_static("RotationY", &Class::template RotationY<>)
+        .def_static("RotationZ", &Class::template RotationZ<>)
         .def("length", [](const Class& self) -> T { return norm<T>(self); })
         .def("lengthSquare",
              [](const Class& self) -> T { return ::math::squareNorm<T>(self); })
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <limits>
 #include <memory>
 #include <utility>
 
@@ -123,4 +124,86 @@ auto bindings_utils_aabb(py::module& m, const char* class_name) -> void {
         });
 }
 
+template <typename T>
+using SFINAE_RAY_BINDINGS = typename std::enable_if<IsScalar<T>::value>::type*;
+
+template <typename T, SFINAE_RAY_BINDINGS<T> = nullptr>
+// NOLINTNEXTLINE
+auto bindings_utils_ray(py::module& m, const char* class_name) -> void {
+    using Ray = ::math::Ray<T>;
+    using AABB = ::math::AABB<T>;
+    using Vec3 = ::math::Vector3<T>;
+    constexpr T INF = std::numeric_limits<T>::infinity();
+    py::class_<Ray>(m, class_name)
+        .def(py::init<>())
+        .def(py::init<Vec3, Vec3>())
+        .def(py::init([](const py::array_t<T>& np_origin,
+                         const py::array_t<T>& np_direction) -> Ray {
+            return Ray(::math::nparray_to_vec3<T>(np_origin),
+                       ::math::nparray_to_vec3<T>(np_direction));
+        }))
+        // Setting any of these recomputes the inverse of the direction
+        .def_property(
+            "origin", [](const Ray& self) -> Vec3 { return self.origin; },
+            [](Ray& self, const Vec3& origin) -> void {
+                self = Ray(origin, self.direction);
+            })
+        .def_property(
+            "direction",
+            [](const Ray& self) -> Vec3 { return self.direction; },
+            [](Ray& self, const Vec3& direction) -> void {
+                self = Ray(self.origin, direction);
+            })
+        .def_readonly("inv_direction", &Ray::inv_direction)
+        .def("pointAt", &Ray::pointAt)
+        .def(
+            "intersect",
+            [](const Ray& self, const AABB& box, T t_max) -> T {
+                return self.intersect(box, t_max);
+            },
+            py::arg("box"), py::arg("t_max") = INF)
+        .def("__repr__", [](const Ray& self) -> py::str {
+            return py::str(self.toString());
+        });
+}
+
+template <typename T>
+using SFINAE_FRUSTUM_BINDINGS =
+    typename std::enable_if<IsScalar<T>::value>::type*;
+
+template <typename T, SFINAE_FRUSTUM_BINDINGS<T> = nullptr>
+// NOLINTNEXTLINE
+auto bindings_utils_frustum(py::module& m, const char* class_name) -> void {
+    using Frustum = ::math::Frustum<T>;
+    using AABB = ::math::AABB<T>;
+    using Vec3 = ::math::Vector3<T>;
+    using Mat4 = ::math::Matrix4<T>;
+    py::class_<Frustum>(m, class_name)
+        .def(py::init<>())
+        .def(py::init<Mat4>())
+        .def("setFromMatrix", &Frustum::setFromMatrix)
+        .def("plane",
+             [](const Frustum& self, uint32_t index) -> ::math::Plane<T> {
+                 if (index >= Frustum::NUM_PLANES) {
+                     throw py::index_error();
+                 }
+                 return self.plane(index);
+             })
+        .def("contains",
+             [](const Frustum& self, const Vec3& point) -> bool {
+                 return self.contains(point);
+             })
+        .def("contains",
+             [](const Frustum& self, const py::array_t<T>& np_point) -> bool {
+                 return self.contains(::math::nparray_to_vec3<T>(np_point));
+             })
+        .def("intersects",
+             [](const Frustum& self, const AABB& box) -> bool {
+                 return self.intersects(box);
+             })
+        .def("__repr__", [](const Frustum& self) -> py::str {
+            return py::str(self.toString());
+        });
+}
+
 }  // namespace math
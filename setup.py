@@ -75,6 +75,7 @@ class CMakeBuild(build_ext):
         cmake_args += [
             "-DMATH3D_BUILD_SSE=OFF",
             "-DMATH3D_BUILD_AVX=OFF",
+            "-DMATH3D_BUILD_RUNTIME_DISPATCH=ON",
             "-DMATH3D_BUILD_FORCE_INLINE=ON",
             "-DMATH3D_BUILD_PYTHON_BINDINGS=ON",
             "-DMATH3D_BUILD_DOCS=OFF",
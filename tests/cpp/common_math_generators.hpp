@@ -8,6 +8,7 @@
 #include <math/quat_t.hpp>
 
 #include <random>
+#include <vector>
 
 namespace math {
 
@@ -498,4 +499,63 @@ auto random_transform_mat4()
         Catch::Generators::pf::make_unique<RandomTransformMat4<T>>());
 }
 
+//****************************************************************************//
+//                    Helpers for the batch entry points                      //
+//****************************************************************************//
+
+/// Returns an array of `num` vectors with entries in the given range
+template <typename T>
+auto random_vec3_array(size_t num, T val_range_min = static_cast<T>(-1.0),
+                       T val_range_max = static_cast<T>(1.0))
+    -> std::vector<Vector3<T>> {
+    std::uniform_real_distribution<T> dist(val_range_min, val_range_max);
+    std::minstd_rand gen(std::random_device{}());  // NOLINT
+    std::vector<Vector3<T>> vecs(num);
+    for (auto& vec : vecs) {
+        vec = Vector3<T>(dist(gen), dist(gen), dist(gen));
+    }
+    return vecs;
+}
+
+/// Returns an array of `num` vectors with entries in the given range
+template <typename T>
+auto random_vec4_array(size_t num, T val_range_min = static_cast<T>(-1.0),
+                       T val_range_max = static_cast<T>(1.0))
+    -> std::vector<Vector4<T>> {
+    std::uniform_real_distribution<T> dist(val_range_min, val_range_max);
+    std::minstd_rand gen(std::random_device{}());  // NOLINT
+    std::vector<Vector4<T>> vecs(num);
+    for (auto& vec : vecs) {
+        vec = Vector4<T>(dist(gen), dist(gen), dist(gen), dist(gen));
+    }
+    return vecs;
+}
+
+/// Returns an array of `num` random unit quaternions
+template <typename T>
+auto random_unit_quat_array(size_t num) -> std::vector<Quaternion<T>> {
+    std::uniform_real_distribution<T> dist(-1.0, 1.0);
+    std::minstd_rand gen(std::random_device{}());  // NOLINT
+    std::vector<Quaternion<T>> quats(num);
+    for (auto& quat : quats) {
+        quat = Quaternion<T>(dist(gen), dist(gen), dist(gen), dist(gen));
+        quat.normalize();
+    }
+    return quats;
+}
+
+/// Returns an array of `num` scalars in the given range
+template <typename T>
+auto random_scalar_array(size_t num, T val_range_min = static_cast<T>(0.0),
+                         T val_range_max = static_cast<T>(1.0))
+    -> std::vector<T> {
+    std::uniform_real_distribution<T> dist(val_range_min, val_range_max);
+    std::minstd_rand gen(std::random_device{}());  // NOLINT
+    std::vector<T> values(num);
+    for (auto& value : values) {
+        value = dist(gen);
+    }
+    return values;
+}
+
 }  // namespace math
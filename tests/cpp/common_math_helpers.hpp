@@ -1,3 +1,7 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
 #include <catch2/catch.hpp>
 #include <math/vec2_t.hpp>
 #include <math/vec3_t.hpp>
@@ -119,4 +123,34 @@ constexpr auto func_all_close(const ::math::Euler<T>& euler, T ex, T ey, T ez,
            func_value_close<T>(euler.z, ez, eps);
 }
 
+// Tolerance for the entries of a product computed with a different rounding
+// order (e.g. the FMA kernels), i.e. a few ulps of the magnitude of the terms
+template <typename T, typename Mat>
+auto func_matmul_tolerance(const Mat& lhs, const Mat& rhs, T eps) -> T {
+    T max_abs = static_cast<T>(0.0);
+    for (uint32_t row = 0; row < Mat::MATRIX_SIZE; ++row) {
+        for (uint32_t col = 0; col < Mat::MATRIX_SIZE; ++col) {
+            T sum_abs = static_cast<T>(0.0);
+            for (uint32_t k = 0; k < Mat::MATRIX_SIZE; ++k) {
+                sum_abs += std::abs(lhs(row, k) * rhs(k, col));
+            }
+            max_abs = std::max(max_abs, sum_abs);
+        }
+    }
+    return eps + 8 * std::numeric_limits<T>::epsilon() * max_abs;
+}
+
+template <typename T, typename Mat, typename Vec>
+auto func_matvec_tolerance(const Mat& mat, const Vec& vec, T eps) -> T {
+    T max_abs = static_cast<T>(0.0);
+    for (uint32_t row = 0; row < Mat::MATRIX_SIZE; ++row) {
+        T sum_abs = static_cast<T>(0.0);
+        for (uint32_t k = 0; k < Mat::MATRIX_SIZE; ++k) {
+            sum_abs += std::abs(mat(row, k) * vec[k]);
+        }
+        max_abs = std::max(max_abs, sum_abs);
+    }
+    return eps + 8 * std::numeric_limits<T>::epsilon() * max_abs;
+}
+
 }  // namespace math
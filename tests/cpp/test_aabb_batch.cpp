@@ -0,0 +1,181 @@
+#include <catch2/catch.hpp>
+#include <math/aabb_batch_t.hpp>
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+#if defined(__clang__)
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wimplicit-float-conversion"
+#pragma clang diagnostic ignored "-Wdouble-promotion"
+#elif defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wfloat-conversion"
+#pragma GCC diagnostic ignored "-Wdouble-promotion"
+#elif defined(_MSC_VER)
+#pragma warning(push)
+#pragma warning(disable : 4305)
+#pragma warning(disable : 4244)
+#endif
+
+// NOLINTNEXTLINE
+TEMPLATE_TEST_CASE("AABBBatch class (aabb_batch_t) type", "[aabb_batch_t]",
+                   ::math::float32_t, ::math::float64_t) {
+    using T = TestType;
+    using Vec3 = ::math::Vector3<T>;
+    using AABB = ::math::AABB<T>;
+    using AABBBatch = ::math::AABBBatch<T>;
+
+    const AABB box_a({-1.0, -2.0, -3.0}, {1.0, 2.0, 3.0});
+    const AABB box_b({0.5, 1.5, 2.5}, {4.0, 5.0, 6.0});
+
+    SECTION("Default and sized constructors") {
+        AABBBatch batch;
+        REQUIRE(batch.empty());
+
+        AABBBatch batch_zero(5);
+        REQUIRE(batch_zero.size() == 5);
+        for (size_t i = 0; i < batch_zero.size(); ++i) {
+            REQUIRE(batch_zero[i].p_min == Vec3(0.0, 0.0, 0.0));
+            REQUIRE(batch_zero[i].p_max == Vec3(0.0, 0.0, 0.0));
+        }
+    }
+
+    SECTION("Planes are aligned and padded") {
+        AABBBatch batch(13);
+        const auto align = static_cast<uintptr_t>(AABBBatch::ALIGNMENT);
+        const auto planes = batch.planes();
+        REQUIRE(batch.stride() >= batch.size());
+        REQUIRE(batch.stride() % AABBBatch::PLANE_PADDING == 0);
+        REQUIRE(reinterpret_cast<uintptr_t>(planes.min_x) % align == 0);
+        REQUIRE(reinterpret_cast<uintptr_t>(planes.max_z) % align == 0);
+    }
+
+    SECTION("Conversions from and to arrays of AABB") {
+        AABBBatch batch(std::vector<AABB>{box_a, box_b});
+        REQUIRE(batch.size() == 2);
+        REQUIRE(batch.planes().min_y[1] == 1.5);
+        REQUIRE(batch.planes().max_x[0] == 1.0);
+
+        batch.resize(40);
+        batch.set(39, box_b);
+        const auto boxes = batch.toVector();
+        REQUIRE(boxes.size() == 40);
+        REQUIRE(boxes[0].p_min == box_a.p_min);
+        REQUIRE(boxes[0].p_max == box_a.p_max);
+        REQUIRE(boxes[39].p_min == box_b.p_min);
+        REQUIRE(boxes[39].p_max == box_b.p_max);
+    }
+
+    SECTION("Packets of boxes") {
+        ::math::AABBPacket<T, 4> packet;
+        packet.set(2, box_b);
+        REQUIRE(packet.get(2).p_min == box_b.p_min);
+        REQUIRE(packet.get(2).p_max == box_b.p_max);
+        REQUIRE(std::isinf(packet.get(0).p_min.x()));
+    }
+}
+
+// NOLINTNEXTLINE
+TEMPLATE_TEST_CASE("AABBBatch class (aabb_batch_t) ray queries",
+                   "[aabb_batch_t]", ::math::float32_t, ::math::float64_t) {
+    using T = TestType;
+    using Vec3 = ::math::Vector3<T>;
+    using AABB = ::math::AABB<T>;
+    using Ray = ::math::Ray<T>;
+    using AABBBatch = ::math::AABBBatch<T>;
+
+    // Not a multiple of any register width, so the remainder is also tested
+    constexpr size_t NUM_BOXES = 203;
+    const auto inf = std::numeric_limits<T>::infinity();
+
+    std::minstd_rand gen(std::random_device{}());  // NOLINT
+    std::uniform_real_distribution<T> dist_pos(-5.0, 5.0);
+    std::uniform_real_distribution<T> dist_size(0.0, 1.0);
+    std::uniform_int_distribution<int> dist_int(-5, 5);
+    std::vector<AABB> boxes(NUM_BOXES);
+    for (auto& box : boxes) {
+        const Vec3 center(dist_pos(gen), dist_pos(gen), dist_pos(gen));
+        const Vec3 half(dist_size(gen), dist_size(gen), dist_size(gen));
+        box = AABB(center - half, center + half);
+    }
+    // Boxes with integer bounds, so axis-aligned rays can lie on their faces
+    for (size_t i = 0; i < NUM_BOXES; i += 3) {
+        const Vec3 corner(dist_int(gen), dist_int(gen), dist_int(gen));
+        boxes[i] = AABB(corner, corner + Vec3(1.0, 1.0, 1.0));
+    }
+    const AABBBatch batch(boxes);
+
+    std::vector<Ray> rays;
+    for (size_t q = 0; q < 64; ++q) {
+        const Vec3 origin(dist_pos(gen), dist_pos(gen), dist_pos(gen));
+        const Vec3 dir(dist_pos(gen), dist_pos(gen), dist_pos(gen));
+        rays.emplace_back(origin, dir);
+        // Axis-aligned rays from integer points (parallel slabs, NaNs)
+        const Vec3 corner(dist_int(gen), dist_int(gen), dist_int(gen));
+        const T sign = (q % 2 == 0) ? 1.0 : -1.0;
+        rays.emplace_back(corner, Vec3(0.0, 0.0, sign));
+        rays.emplace_back(corner, Vec3(-0.0, sign, 0.0));
+    }
+
+    SECTION("Ray against a batch of boxes") {
+        for (const auto isa : ::math::dispatch::GetSupportedIsas()) {
+            ::math::dispatch::ScopedIsa guard(isa);
+            INFO("isa: " << ::math::dispatch::ToString(isa));
+            for (const auto& ray : rays) {
+                for (const T t_max : {inf, static_cast<T>(3.0)}) {
+                    const auto t_hits = ::math::intersect(ray, batch, t_max);
+                    REQUIRE(t_hits.size() == NUM_BOXES);
+                    for (size_t i = 0; i < NUM_BOXES; ++i) {
+                        // Same operations in the same order, so exact
+                        REQUIRE(t_hits[i] == ray.intersect(boxes[i], t_max));
+                    }
+                }
+            }
+        }
+    }
+
+    SECTION("Ray against packets of 4 and 8 boxes") {
+        ::math::AABBPacket<T, 4> packet_4;
+        ::math::AABBPacket<T, 8> packet_8;
+        // Leave some slots empty, these can't be hit by any ray
+        for (size_t slot = 0; slot < 3; ++slot) {
+            packet_4.set(slot, boxes[slot]);
+        }
+        for (size_t slot = 0; slot < 8; slot += 2) {
+            packet_8.set(slot, boxes[slot]);
+        }
+        for (const auto isa : ::math::dispatch::GetSupportedIsas()) {
+            ::math::dispatch::ScopedIsa guard(isa);
+            INFO("isa: " << ::math::dispatch::ToString(isa));
+            for (const auto& ray : rays) {
+                T t_hits_4[4];
+                T t_hits_8[8];
+                const auto mask_4 = ::math::intersect(ray, packet_4, t_hits_4);
+                const auto mask_8 = ::math::intersect(ray, packet_8, t_hits_8);
+                REQUIRE((mask_4 & 0x8U) == 0);
+                REQUIRE((mask_8 & 0xAAU) == 0);
+                for (size_t slot = 0; slot < 8; ++slot) {
+                    const auto t_hit = ray.intersect(boxes[slot]);
+                    if (slot < 3) {
+                        REQUIRE(t_hits_4[slot] == t_hit);
+                        REQUIRE(((mask_4 >> slot) & 1U) == (t_hit < inf));
+                    }
+                    if (slot % 2 == 0) {
+                        REQUIRE(t_hits_8[slot] == t_hit);
+                        REQUIRE(((mask_8 >> slot) & 1U) == (t_hit < inf));
+                    }
+                }
+            }
+        }
+    }
+}
+
+#if defined(__clang__)
+#pragma clang diagnostic pop
+#elif defined(__GNUC__)
+#pragma GCC diagnostic pop
+#elif defined(_MSC_VER)
+#pragma warning(pop)
+#endif
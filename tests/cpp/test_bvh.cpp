@@ -0,0 +1,377 @@
+#include <catch2/catch.hpp>
+#include <math/utils/bvh.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <utility>
+#include <vector>
+
+#if defined(__clang__)
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wimplicit-float-conversion"
+#pragma clang diagnostic ignored "-Wdouble-promotion"
+#elif defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wfloat-conversion"
+#pragma GCC diagnostic ignored "-Wdouble-promotion"
+#elif defined(_MSC_VER)
+#pragma warning(push)
+#pragma warning(disable : 4305)
+#pragma warning(disable : 4244)
+#endif
+
+// Returns a sorted copy of the given results (the queries have no given order)
+template <typename Container>
+auto sorted(Container values) -> Container {
+    std::sort(values.begin(), values.end());
+    return values;
+}
+
+TEMPLATE_TEST_CASE("Bounding volume hierarchy [BVH]", "[bvh][geometric]",
+                   ::math::float32_t, ::math::float64_t) {
+    using T = TestType;
+    using Vec3 = ::math::Vector3<T>;
+    using AABB = ::math::AABB<T>;
+    using BVH = ::math::BVH<T>;
+    using Pair = std::pair<size_t, size_t>;
+
+    constexpr size_t NUM_BOXES = 1000;
+
+    std::minstd_rand gen(std::random_device{}());  // NOLINT
+    std::uniform_real_distribution<T> dist_pos(-10.0, 10.0);
+    std::uniform_real_distribution<T> dist_size(0.0, 1.0);
+    auto random_box = [&]() {
+        const Vec3 center(dist_pos(gen), dist_pos(gen), dist_pos(gen));
+        const Vec3 half(dist_size(gen), dist_size(gen), dist_size(gen));
+        return AABB(center - half, center + half);
+    };
+    auto random_boxes = [&](size_t num) {
+        std::vector<AABB> boxes(num);
+        for (auto& box : boxes) {
+            box = random_box();
+        }
+        return boxes;
+    };
+
+    // Brute-force versions of the queries, used as reference
+    auto brute_overlaps = [](const std::vector<AABB>& boxes,
+                             const AABB& query) {
+        std::vector<size_t> hits;
+        for (size_t i = 0; i < boxes.size(); ++i) {
+            if (query.intersects(boxes[i])) {
+                hits.push_back(i);
+            }
+        }
+        return hits;
+    };
+    auto brute_pairs = [](const std::vector<AABB>& boxes) {
+        std::vector<Pair> pairs;
+        for (size_t i = 0; i < boxes.size(); ++i) {
+            for (size_t j = i + 1; j < boxes.size(); ++j) {
+                if (boxes[i].intersects(boxes[j])) {
+                    pairs.emplace_back(i, j);
+                }
+            }
+        }
+        return pairs;
+    };
+
+    // Every box is in exactly one leaf, within the bounds of its ancestors
+    auto check_tree = [](const BVH& bvh, const std::vector<AABB>& boxes) {
+        REQUIRE(bvh.size() == boxes.size());
+        auto indices = bvh.indices();
+        std::sort(indices.begin(), indices.end());
+        for (size_t i = 0; i < indices.size(); ++i) {
+            REQUIRE(indices[i] == i);
+        }
+        const auto& nodes = bvh.nodes();
+        size_t num_in_leaves = 0;
+        std::vector<std::pair<uint32_t, AABB>> stack = {{0, bvh.bounds()}};
+        while (!stack.empty()) {
+            const auto node_index = stack.back().first;
+            const auto parent_box = stack.back().second;
+            stack.pop_back();
+            const auto& node = nodes[node_index];
+            const AABB node_box(
+                Vec3(node.p_min[0], node.p_min[1], node.p_min[2]),
+                Vec3(node.p_max[0], node.p_max[1], node.p_max[2]));
+            for (uint32_t d = 0; d < 3; ++d) {
+                REQUIRE(node_box.p_min[d] >= parent_box.p_min[d]);
+                REQUIRE(node_box.p_max[d] <= parent_box.p_max[d]);
+            }
+            if (!node.isLeaf()) {
+                stack.emplace_back(node.first, node_box);
+                stack.emplace_back(node.first + 1, node_box);
+                continue;
+            }
+            for (uint32_t k = node.first; k < node.first + node.count; ++k) {
+                const auto& box = boxes[bvh.indices()[k]];
+                for (uint32_t d = 0; d < 3; ++d) {
+                    REQUIRE(box.p_min[d] >= node_box.p_min[d]);
+                    REQUIRE(box.p_max[d] <= node_box.p_max[d]);
+                }
+                ++num_in_leaves;
+            }
+        }
+        REQUIRE(num_in_leaves == boxes.size());
+    };
+
+    SECTION("Empty tree") {
+        BVH bvh;
+        REQUIRE(bvh.empty());
+        REQUIRE(bvh.numNodes() == 0);
+        REQUIRE(bvh.queryOverlaps(AABB()).empty());
+        REQUIRE(bvh.queryPairs().empty());
+        const auto hit = bvh.closestHit(Vec3(0.0, 0.0, 0.0),
+                                        Vec3(1.0, 0.0, 0.0));
+        REQUIRE(hit.first == static_cast<size_t>(BVH::INVALID_INDEX));
+
+        bvh.build(nullptr, 0);
+        REQUIRE(bvh.empty());
+    }
+
+    SECTION("Build over random boxes") {
+        const auto boxes = random_boxes(NUM_BOXES);
+        BVH bvh(boxes.data(), boxes.size());
+        REQUIRE(bvh.size() == NUM_BOXES);
+        REQUIRE(bvh.numNodes() > 1);
+        REQUIRE(bvh.numNodes() < 2 * NUM_BOXES);
+        check_tree(bvh, boxes);
+        for (size_t i = 0; i < NUM_BOXES; ++i) {
+            REQUIRE(bvh.box(i).p_min == boxes[i].p_min);
+            REQUIRE(bvh.box(i).p_max == boxes[i].p_max);
+        }
+
+        // A single leaf holds all boxes if these aren't worth splitting
+        BVH bvh_leaf(boxes.data(), boxes.size(), NUM_BOXES);
+        REQUIRE(bvh_leaf.numNodes() == 1);
+        check_tree(bvh_leaf, boxes);
+    }
+
+    SECTION("Overlap queries") {
+        const auto boxes = random_boxes(NUM_BOXES);
+        BVH bvh(boxes.data(), boxes.size());
+        for (size_t q = 0; q < 100; ++q) {
+            const auto query = random_box();
+            REQUIRE(sorted(bvh.queryOverlaps(query)) ==
+                    brute_overlaps(boxes, query));
+        }
+        // The default box covers the whole space
+        REQUIRE(sorted(bvh.queryOverlaps(AABB())).size() == NUM_BOXES);
+    }
+
+    SECTION("Pair queries") {
+        const auto boxes = random_boxes(NUM_BOXES);
+        BVH bvh(boxes.data(), boxes.size());
+        const auto pairs = sorted(bvh.queryPairs());
+        REQUIRE(!pairs.empty());
+        REQUIRE(pairs == brute_pairs(boxes));
+    }
+
+    SECTION("Frustum queries") {
+        using Mat4 = ::math::Matrix4<T>;
+        using Frustum = ::math::Frustum<T>;
+        const auto boxes = random_boxes(NUM_BOXES);
+        BVH bvh(boxes.data(), boxes.size());
+        std::uniform_real_distribution<T> dist_angle(-3.0, 3.0);
+        for (size_t q = 0; q < 20; ++q) {
+            const Vec3 eye(dist_pos(gen), dist_pos(gen), dist_pos(gen));
+            const auto view = Mat4::RotationX(dist_angle(gen)) *
+                              Mat4::RotationY(dist_angle(gen)) *
+                              Mat4::Translation(-eye);
+            const Frustum frustum(Mat4::Perspective(60.0, 1.0, 0.1, 15.0) *
+                                  view);
+            std::vector<size_t> expected;
+            for (size_t i = 0; i < NUM_BOXES; ++i) {
+                if (frustum.intersects(boxes[i])) {
+                    expected.push_back(i);
+                }
+            }
+            REQUIRE(sorted(bvh.queryFrustum(frustum)) == expected);
+        }
+        // The default frustum contains the whole space
+        REQUIRE(bvh.queryFrustum(Frustum()).size() == NUM_BOXES);
+    }
+
+    SECTION("Ray queries") {
+        const auto boxes = random_boxes(NUM_BOXES);
+        BVH bvh(boxes.data(), boxes.size());
+        std::uniform_real_distribution<T> dist_dir(-1.0, 1.0);
+        const T T_MAX = 15.0;
+        std::vector<::math::Ray<T>> rays;
+        std::vector<std::pair<size_t, T>> closest_hits;
+        for (size_t q = 0; q < 100; ++q) {
+            const Vec3 origin(dist_pos(gen), dist_pos(gen), dist_pos(gen));
+            Vec3 dir(dist_dir(gen), dist_dir(gen), dist_dir(gen));
+            // Axis-aligned rays exercise the slabs parallel to the ray
+            if (q % 4 == 0) {
+                dir = Vec3(0.0, 0.0, (q % 8 == 0) ? 1.0 : -1.0);
+            }
+
+            // Reference: slab test over each box, in double precision
+            std::vector<size_t> expected;
+            for (size_t i = 0; i < NUM_BOXES; ++i) {
+                double t_enter = 0.0;
+                double t_exit = T_MAX;
+                for (uint32_t d = 0; d < 3; ++d) {
+                    const double org = origin[d];
+                    const double lo = boxes[i].p_min[d];
+                    const double hi = boxes[i].p_max[d];
+                    if (dir[d] == 0) {
+                        if (org < lo || org > hi) {
+                            t_exit = -1.0;
+                        }
+                        continue;
+                    }
+                    const double t_a = (lo - org) / dir[d];
+                    const double t_b = (hi - org) / dir[d];
+                    t_enter = std::max(t_enter, std::min(t_a, t_b));
+                    t_exit = std::min(t_exit, std::max(t_a, t_b));
+                }
+                if (t_enter <= t_exit) {
+                    expected.push_back(i);
+                }
+            }
+
+            std::vector<size_t> hits;
+            std::vector<T> distances(NUM_BOXES, -1.0);
+            bvh.queryRay(origin, dir, T_MAX, [&](size_t index, T t_hit) {
+                hits.push_back(index);
+                distances[index] = t_hit;
+            });
+            hits = sorted(hits);
+            // Boxes grazed by the ray might differ by rounding, so only
+            // compare the count loosely and check the reported hits
+            for (auto index : hits) {
+                REQUIRE(distances[index] >= 0.0);
+                REQUIRE(distances[index] <= T_MAX);
+                const Vec3 point = origin + distances[index] * dir;
+                const T tol = 1e-3;
+                for (uint32_t d = 0; d < 3; ++d) {
+                    REQUIRE(point[d] >= boxes[index].p_min[d] - tol);
+                    REQUIRE(point[d] <= boxes[index].p_max[d] + tol);
+                }
+            }
+            std::vector<size_t> missed;
+            std::set_difference(expected.begin(), expected.end(),
+                                hits.begin(), hits.end(),
+                                std::back_inserter(missed));
+            REQUIRE(missed.size() <= 1);
+
+            const auto closest = bvh.closestHit(origin, dir, T_MAX);
+            if (hits.empty()) {
+                REQUIRE(closest.first ==
+                        static_cast<size_t>(BVH::INVALID_INDEX));
+                REQUIRE(std::isinf(closest.second));
+            } else {
+                T t_min = T_MAX;
+                for (auto index : hits) {
+                    t_min = std::min(t_min, distances[index]);
+                }
+                REQUIRE(closest.second == t_min);
+                REQUIRE(distances[closest.first] == t_min);
+            }
+            rays.emplace_back(origin, dir);
+            closest_hits.push_back(closest);
+        }
+
+        // Batch of rays, same results as one closestHit call per ray
+        std::vector<size_t> indices(rays.size());
+        std::vector<T> t_hits(rays.size());
+        bvh.closestHits(rays.data(), rays.size(), indices.data(),
+                        t_hits.data(), T_MAX);
+        for (size_t q = 0; q < rays.size(); ++q) {
+            REQUIRE(indices[q] == closest_hits[q].first);
+            REQUIRE(t_hits[q] == closest_hits[q].second);
+        }
+
+        // A ray starting inside a box hits it at t = 0
+        const auto center = boxes[0].computeCenter();
+        bool found = false;
+        bvh.queryRay(center, Vec3(1.0, 0.0, 0.0), T_MAX,
+                     [&](size_t index, T t_hit) {
+                         if (index == 0) {
+                             found = (t_hit == 0.0);
+                         }
+                     });
+        REQUIRE(found);
+    }
+
+    SECTION("Refit after the boxes move") {
+        auto boxes = random_boxes(NUM_BOXES);
+        BVH bvh(boxes.data(), boxes.size());
+        for (auto& box : boxes) {
+            const Vec3 offset(dist_size(gen), -dist_size(gen), dist_size(gen));
+            box = AABB(box.p_min + offset, box.p_max + offset);
+        }
+        bvh.refit(boxes.data(), boxes.size());
+        check_tree(bvh, boxes);
+        REQUIRE(sorted(bvh.queryPairs()) == brute_pairs(boxes));
+
+        // Move a few boxes one by one
+        for (size_t i = 0; i < NUM_BOXES; i += 97) {
+            boxes[i] = random_box();
+            bvh.updateBox(i, boxes[i]);
+            REQUIRE(bvh.box(i).p_min == boxes[i].p_min);
+        }
+        check_tree(bvh, boxes);
+        for (size_t q = 0; q < 20; ++q) {
+            const auto query = random_box();
+            REQUIRE(sorted(bvh.queryOverlaps(query)) ==
+                    brute_overlaps(boxes, query));
+        }
+        REQUIRE(sorted(bvh.queryPairs()) == brute_pairs(boxes));
+    }
+
+    SECTION("Degenerate inputs") {
+        // Identical boxes can't be split, so these end up in a single leaf
+        std::vector<AABB> same(100, AABB(Vec3(0.0, 0.0, 0.0),
+                                         Vec3(1.0, 1.0, 1.0)));
+        BVH bvh_same(same.data(), same.size());
+        REQUIRE(bvh_same.numNodes() == 1);
+        REQUIRE(bvh_same.queryPairs().size() == 100 * 99 / 2);
+
+        // Points along a line (no area), which are still split
+        std::vector<AABB> points(200);
+        for (size_t i = 0; i < points.size(); ++i) {
+            const Vec3 point(static_cast<T>(i), 0.0, 0.0);
+            points[i] = AABB(point, point);
+        }
+        BVH bvh_points(points.data(), points.size());
+        REQUIRE(bvh_points.numNodes() > 1);
+        check_tree(bvh_points, points);
+        const auto hits = sorted(bvh_points.queryOverlaps(
+            AABB(Vec3(9.5, -1.0, -1.0), Vec3(20.0, 1.0, 1.0))));
+        REQUIRE(hits.size() == 11);
+        REQUIRE(hits.front() == 10);
+        REQUIRE(bvh_points.queryPairs().empty());
+        const auto hit = bvh_points.closestHit(Vec3(-5.0, 0.0, 0.0),
+                                               Vec3(1.0, 0.0, 0.0));
+        REQUIRE(hit.first == 0);
+        REQUIRE(hit.second == 5.0);
+
+        // Rays parallel to a face of a box, starting on its plane, hit it
+        const AABB unit(Vec3(0.0, 0.0, 0.0), Vec3(1.0, 1.0, 1.0));
+        BVH bvh_unit(&unit, 1);
+        for (const T x : {0.0, 1.0}) {
+            for (const T dir_x : {0.0, -0.0}) {
+                const auto face_hit = bvh_unit.closestHit(
+                    Vec3(x, 0.5, -1.0), Vec3(dir_x, 0.0, 1.0));
+                REQUIRE(face_hit.first == 0);
+                REQUIRE(face_hit.second == 1.0);
+            }
+        }
+        REQUIRE(bvh_unit.closestHit(Vec3(1.5, 0.5, -1.0),
+                                    Vec3(-0.0, 0.0, 1.0))
+                    .first == static_cast<size_t>(BVH::INVALID_INDEX));
+    }
+}
+
+#if defined(__clang__)
+#pragma clang diagnostic pop  // NOLINT
+#elif defined(__GNUC__)
+#pragma GCC diagnostic pop
+#elif defined(_MSC_VER)
+#pragma warning(pop)
+#endif
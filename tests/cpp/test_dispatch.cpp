@@ -0,0 +1,87 @@
+#include <catch2/catch.hpp>
+#include <math/dispatch.hpp>
+
+// NOLINTNEXTLINE
+TEST_CASE("Runtime dispatch of the batch kernel-sets", "[dispatch]") {
+    using ::math::dispatch::Isa;
+
+    ::math::dispatch::ResetActiveIsa();
+
+    SECTION("Scalar kernels are always available") {
+        REQUIRE(::math::dispatch::IsCompiledIn(Isa::SCALAR));
+        REQUIRE(::math::dispatch::IsSupported(Isa::SCALAR));
+        auto isas = ::math::dispatch::GetSupportedIsas();
+        REQUIRE(!isas.empty());
+        REQUIRE(isas.front() == Isa::SCALAR);
+    }
+
+    SECTION("Supported ISAs are compiled-in and sorted by capability") {
+        auto isas = ::math::dispatch::GetSupportedIsas();
+        for (size_t i = 0; i < isas.size(); ++i) {
+            REQUIRE(::math::dispatch::IsCompiledIn(isas[i]));
+            if (i > 0) {
+                REQUIRE(static_cast<int>(isas[i - 1]) <
+                        static_cast<int>(isas[i]));
+            }
+        }
+        REQUIRE(::math::dispatch::GetBestIsa() == isas.back());
+    }
+
+    SECTION("The active ISA defaults to a supported one") {
+        auto active = ::math::dispatch::GetActiveIsa();
+        REQUIRE(::math::dispatch::IsSupported(active));
+        REQUIRE(static_cast<int>(active) <=
+                static_cast<int>(::math::dispatch::GetBestIsa()));
+    }
+
+    SECTION("Forcing an ISA only succeeds if it is supported") {
+        const auto initial = ::math::dispatch::GetActiveIsa();
+        for (const auto isa :
+             {Isa::SCALAR, Isa::SSE, Isa::AVX, Isa::AVX512}) {
+            const bool supported = ::math::dispatch::IsSupported(isa);
+            const auto before = ::math::dispatch::GetActiveIsa();
+            REQUIRE(::math::dispatch::SetActiveIsa(isa) == supported);
+            if (supported) {
+                REQUIRE(::math::dispatch::GetActiveIsa() == isa);
+            } else {
+                REQUIRE(::math::dispatch::GetActiveIsa() == before);
+            }
+        }
+        ::math::dispatch::ResetActiveIsa();
+        REQUIRE(::math::dispatch::GetActiveIsa() == initial);
+    }
+
+    SECTION("Scoped ISA restores the previous one") {
+        const auto initial = ::math::dispatch::GetActiveIsa();
+        {
+            ::math::dispatch::ScopedIsa guard(Isa::SCALAR);
+            REQUIRE(guard.active());
+            REQUIRE(::math::dispatch::GetActiveIsa() == Isa::SCALAR);
+        }
+        REQUIRE(::math::dispatch::GetActiveIsa() == initial);
+    }
+
+    SECTION("String representation of the ISAs") {
+        REQUIRE(::math::dispatch::ToString(Isa::SCALAR) == "scalar");
+        REQUIRE(::math::dispatch::ToString(Isa::SSE) == "sse");
+        REQUIRE(::math::dispatch::ToString(Isa::AVX) == "avx");
+        REQUIRE(::math::dispatch::ToString(Isa::AVX512) == "avx512");
+    }
+
+    SECTION("CPU features are consistent") {
+        const auto& cpu = ::math::dispatch::GetCpuFeatures();
+        // AVX2 and FMA are only reported if the OS saves the ymm registers
+        if (cpu.avx2 || cpu.fma) {
+            REQUIRE(cpu.avx);
+        }
+        // Same for AVX-512 and the zmm registers (which extend the ymm ones)
+        if (cpu.avx512dq) {
+            REQUIRE(cpu.avx512f);
+        }
+        if (cpu.avx512f) {
+            REQUIRE(cpu.avx);
+        }
+    }
+
+    ::math::dispatch::ResetActiveIsa();
+}
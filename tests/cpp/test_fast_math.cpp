@@ -0,0 +1,201 @@
+#include <catch2/catch.hpp>
+#include <math/fast_math.hpp>
+#include <math/mat4_t.hpp>
+#include <math/quat_t.hpp>
+#include <math/euler_t.hpp>
+#include <math/utils/spherical_coordinates.hpp>
+
+#include <cmath>
+#include <vector>
+
+#include "./common_math_helpers.hpp"
+#include "./common_math_generators.hpp"
+
+#if defined(__clang__)
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wimplicit-float-conversion"
+#pragma clang diagnostic ignored "-Wdouble-promotion"
+#elif defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wfloat-conversion"
+#pragma GCC diagnostic ignored "-Wdouble-promotion"
+#elif defined(_MSC_VER)
+#pragma warning(push)
+#pragma warning(disable : 4305)
+#pragma warning(disable : 4244)
+#endif
+
+using Accuracy = ::math::fast::Accuracy;
+
+/// Returns the maximum absolute error expected from the fast functions (the
+/// errors measured are ~1 ulp, see fast_math_scalar_impl.hpp)
+template <typename T>
+auto fast_tolerance(Accuracy accuracy) -> T {
+    if (::math::IsFloat32<T>::value) {
+        return static_cast<T>(5e-7);
+    }
+    return static_cast<T>(accuracy == Accuracy::FULL ? 2e-15 : 2e-8);
+}
+
+/// Returns whether all the entries of both matrices are within `eps`
+template <typename T>
+auto mat4_all_close(const ::math::Matrix4<T>& lhs,
+                    const ::math::Matrix4<T>& rhs, T eps) -> bool {
+    for (uint32_t i = 0; i < 4; ++i) {
+        for (uint32_t j = 0; j < 4; ++j) {
+            if (std::abs(lhs(i, j) - rhs(i, j)) > eps) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// NOLINTNEXTLINE
+TEMPLATE_TEST_CASE("Fast trigonometric functions (fast_math)", "[fast_math]",
+                   ::math::float32_t, ::math::float64_t) {
+    using T = TestType;
+
+    constexpr T PI = static_cast<T>(::math::PI);
+    constexpr T ONE = static_cast<T>(1.0);
+    constexpr T ZERO = static_cast<T>(0.0);
+
+    // Not a multiple of any register width, so we also test the remainders
+    constexpr size_t NUM_VALUES = 1001;
+
+    auto angles = ::math::random_scalar_array<T>(NUM_VALUES, -1000, 1000);
+    auto ys = ::math::random_scalar_array<T>(NUM_VALUES, -10, 10);
+    auto xs = ::math::random_scalar_array<T>(NUM_VALUES, -10, 10);
+    auto ratios = ::math::random_scalar_array<T>(NUM_VALUES, -ONE, ONE);
+    // Multiples of pi / 2 (the edges of the quadrants), the zeros of atan2
+    // with both signs, and the edges of the domain of asin|acos
+    angles[0] = ZERO;
+    angles[1] = PI / 2;
+    angles[2] = -PI;
+    angles[3] = 3 * PI / 2;
+    ys[0] = ZERO;
+    ys[1] = -ZERO;
+    xs[2] = ZERO;
+    xs[3] = -ZERO;
+    ys[4] = xs[4] = ZERO;
+    ratios[0] = ONE;
+    ratios[1] = -ONE;
+    ratios[2] = ZERO;
+
+    SECTION("Scalar functions") {
+        for (auto accuracy : {Accuracy::FULL, Accuracy::FAST}) {
+            const T tolerance = fast_tolerance<T>(accuracy);
+            for (size_t i = 0; i < NUM_VALUES; ++i) {
+                INFO("i: " << i);
+                T sin_x{}, cos_x{};  // NOLINT
+                T atan2_yx{}, asin_x{}, acos_x{}, tan_x{};
+                if (accuracy == Accuracy::FULL) {
+                    ::math::fast::sincos<Accuracy::FULL>(angles[i], sin_x,
+                                                         cos_x);
+                    tan_x = ::math::fast::tan<Accuracy::FULL>(ratios[i]);
+                    atan2_yx =
+                        ::math::fast::atan2<Accuracy::FULL>(ys[i], xs[i]);
+                    asin_x = ::math::fast::asin<Accuracy::FULL>(ratios[i]);
+                    acos_x = ::math::fast::acos<Accuracy::FULL>(ratios[i]);
+                } else {
+                    ::math::fast::sincos<Accuracy::FAST>(angles[i], sin_x,
+                                                         cos_x);
+                    tan_x = ::math::fast::tan<Accuracy::FAST>(ratios[i]);
+                    atan2_yx =
+                        ::math::fast::atan2<Accuracy::FAST>(ys[i], xs[i]);
+                    asin_x = ::math::fast::asin<Accuracy::FAST>(ratios[i]);
+                    acos_x = ::math::fast::acos<Accuracy::FAST>(ratios[i]);
+                }
+                REQUIRE(std::abs(sin_x - std::sin(angles[i])) < tolerance);
+                REQUIRE(std::abs(cos_x - std::cos(angles[i])) < tolerance);
+                REQUIRE(std::abs(tan_x - std::tan(ratios[i])) < 4 * tolerance);
+                REQUIRE(std::abs(atan2_yx - std::atan2(ys[i], xs[i])) <
+                        tolerance);
+                REQUIRE(std::abs(asin_x - std::asin(ratios[i])) < tolerance);
+                REQUIRE(std::abs(acos_x - std::acos(ratios[i])) < tolerance);
+            }
+        }
+    }
+
+    SECTION("Batch functions, for every kernel-set") {
+        for (const auto isa : ::math::dispatch::GetSupportedIsas()) {
+            ::math::dispatch::ScopedIsa guard(isa);
+            INFO("isa: " << ::math::dispatch::ToString(isa));
+            for (auto accuracy : {Accuracy::FULL, Accuracy::FAST}) {
+                const T tolerance = fast_tolerance<T>(accuracy);
+                std::vector<T> sines(NUM_VALUES), cosines(NUM_VALUES);
+                std::vector<T> atans(NUM_VALUES), asins(NUM_VALUES);
+                std::vector<T> acoses(NUM_VALUES);
+                ::math::fast::sincos<T>(angles.data(), sines.data(),
+                                        cosines.data(), NUM_VALUES, accuracy);
+                ::math::fast::atan2<T>(ys.data(), xs.data(), atans.data(),
+                                       NUM_VALUES, accuracy);
+                ::math::fast::asin<T>(ratios.data(), asins.data(), NUM_VALUES,
+                                      accuracy);
+                ::math::fast::acos<T>(ratios.data(), acoses.data(), NUM_VALUES,
+                                      accuracy);
+                for (size_t i = 0; i < NUM_VALUES; ++i) {
+                    INFO("i: " << i);
+                    REQUIRE(std::abs(sines[i] - std::sin(angles[i])) <
+                            tolerance);
+                    REQUIRE(std::abs(cosines[i] - std::cos(angles[i])) <
+                            tolerance);
+                    REQUIRE(std::abs(atans[i] - std::atan2(ys[i], xs[i])) <
+                            tolerance);
+                    REQUIRE(std::abs(asins[i] - std::asin(ratios[i])) <
+                            tolerance);
+                    REQUIRE(std::abs(acoses[i] - std::acos(ratios[i])) <
+                            tolerance);
+                }
+            }
+        }
+    }
+
+    SECTION("Rotation constructors with the fast policy") {
+        using Mat4 = ::math::Matrix4<T>;
+        using Quat = ::math::Quaternion<T>;
+        using Euler = ::math::Euler<T>;
+        using FastTrig = ::math::fast::FastTrig<Accuracy::FULL>;
+
+        constexpr T EPSILON = static_cast<T>(1e-5);
+        for (size_t i = 0; i < 16; ++i) {
+            const T angle = angles[i] / 100;
+            INFO("angle: " << angle);
+            auto rot_x = Mat4::template RotationX<FastTrig>(angle);
+            REQUIRE(mat4_all_close<T>(rot_x, Mat4::RotationX(angle), EPSILON));
+            auto rot_z = Quat::template RotationZ<FastTrig>(angle);
+            auto rot_z_std = Quat::RotationZ(angle);
+            REQUIRE(::math::func_all_close<T>(rot_z, rot_z_std.w(),
+                                              rot_z_std.x(), rot_z_std.y(),
+                                              rot_z_std.z(), EPSILON));
+
+            Euler euler(angle, angles[i + 1] / 1000, angles[i + 2] / 1000,
+                        ::math::euler::Order::ZYX);
+            Quat quat, quat_std(euler);
+            quat.template setFromEuler<FastTrig>(euler);
+            REQUIRE(::math::func_all_close<T>(quat, quat_std.w(), quat_std.x(),
+                                              quat_std.y(), quat_std.z(),
+                                              EPSILON));
+
+            ::math::SphericalCoords<T> coords(2, angles[i] / 1000,
+                                              std::abs(angle));
+            auto point = coords.template GetCartesian<FastTrig>();
+            auto point_std = coords.GetCartesian();
+            REQUIRE(::math::func_all_close<T>(point, point_std.x(),
+                                              point_std.y(), point_std.z(),
+                                              EPSILON));
+        }
+
+        auto proj = Mat4::template Perspective<FastTrig>(60, 1.5, 0.1, 100);
+        REQUIRE(mat4_all_close<T>(proj, Mat4::Perspective(60, 1.5, 0.1, 100),
+                                  EPSILON));
+    }
+}
+
+#if defined(__clang__)
+#pragma clang diagnostic pop  // NOLINT
+#elif defined(__GNUC__)
+#pragma GCC diagnostic pop
+#elif defined(_MSC_VER)
+#pragma warning(pop)
+#endif
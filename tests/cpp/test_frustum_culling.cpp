@@ -0,0 +1,143 @@
+#include <catch2/catch.hpp>
+#include <math/frustum_culling.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#if defined(__clang__)
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wimplicit-float-conversion"
+#pragma clang diagnostic ignored "-Wdouble-promotion"
+#elif defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wfloat-conversion"
+#pragma GCC diagnostic ignored "-Wdouble-promotion"
+#elif defined(_MSC_VER)
+#pragma warning(push)
+#pragma warning(disable : 4305)
+#pragma warning(disable : 4244)
+#endif
+
+// NOLINTNEXTLINE
+TEMPLATE_TEST_CASE("Frustum culling of batches (frustum_culling)",
+                   "[frustum_culling]", ::math::float32_t, ::math::float64_t) {
+    using T = TestType;
+    using Vec3 = ::math::Vector3<T>;
+    using Mat4 = ::math::Matrix4<T>;
+    using AABB = ::math::AABB<T>;
+    using Sphere = ::math::Sphere<T>;
+    using Frustum = ::math::Frustum<T>;
+
+    // Not a multiple of 64 nor of any register width, so the remainders and
+    // the last (partial) word of the bitmasks are also tested
+    constexpr size_t NUM = 203;
+    // Elements closer than this to a plane are skipped: the kernels match the
+    // scalar tests exactly, unless the compiler contracts the latter into FMAs
+    constexpr T EPSILON = static_cast<T>(1e-4);
+
+    std::minstd_rand gen(std::random_device{}());  // NOLINT
+    std::uniform_real_distribution<T> dist_pos(-12.0, 12.0);
+    std::uniform_real_distribution<T> dist_size(0.0, 2.0);
+
+    // Camera at (1, 2, 3), rotated and looking roughly along -z
+    const auto proj = Mat4::Perspective(60.0, 1.5, 0.5, 20.0);
+    const auto view = Mat4::RotationX(0.3) * Mat4::RotationY(-0.2) *
+                      Mat4::Translation({-1.0, -2.0, -3.0});
+    const Frustum frustum(proj * view);
+
+    // Smallest signed distance to the planes (the margin of the test)
+    auto min_distance = [&](const Vec3& point) {
+        T dist = frustum.signedDistanceTo(0, point);
+        for (uint32_t k = 1; k < Frustum::NUM_PLANES; ++k) {
+            dist = std::min(dist, frustum.signedDistanceTo(k, point));
+        }
+        return dist;
+    };
+
+    std::vector<Vec3> points(NUM);
+    std::vector<T> radii(NUM);
+    std::vector<AABB> boxes(NUM);
+    for (size_t i = 0; i < NUM; ++i) {
+        points[i] = Vec3(dist_pos(gen), dist_pos(gen), dist_pos(gen));
+        radii[i] = dist_size(gen);
+        const Vec3 half(dist_size(gen), dist_size(gen), dist_size(gen));
+        boxes[i] = AABB(points[i] - half, points[i] + half);
+    }
+    const ::math::Vector3Batch<T> points_batch(points);
+    const ::math::AABBBatch<T> boxes_batch(boxes);
+
+    SECTION("Bitmask helpers") {
+        REQUIRE(::math::bitmaskWords(0) == 0);
+        REQUIRE(::math::bitmaskWords(64) == 1);
+        REQUIRE(::math::bitmaskWords(65) == 2);
+        const uint64_t bitmask[] = {0x5ULL, 0x8000000000000000ULL};
+        REQUIRE(::math::bitmaskTest(bitmask, 0));
+        REQUIRE(!::math::bitmaskTest(bitmask, 1));
+        REQUIRE(::math::bitmaskTest(bitmask, 2));
+        REQUIRE(::math::bitmaskTest(bitmask, 127));
+    }
+
+    SECTION("Points, spheres and boxes against a frustum") {
+        size_t num_visible = 0;
+        for (const auto isa : ::math::dispatch::GetSupportedIsas()) {
+            ::math::dispatch::ScopedIsa guard(isa);
+            INFO("isa: " << ::math::dispatch::ToString(isa));
+            const auto visible_points =
+                ::math::cullPoints(frustum, points_batch);
+            const auto visible_spheres =
+                ::math::cullSpheres(frustum, points_batch, radii);
+            const auto visible_boxes = ::math::cullBoxes(frustum, boxes_batch);
+            REQUIRE(visible_points.size() == ::math::bitmaskWords(NUM));
+            REQUIRE(visible_spheres.size() == ::math::bitmaskWords(NUM));
+            REQUIRE(visible_boxes.size() == ::math::bitmaskWords(NUM));
+            // The unused bits of the last word are cleared
+            const auto unused = ~((1ULL << (NUM % 64)) - 1);
+            REQUIRE((visible_points.back() & unused) == 0);
+            REQUIRE((visible_spheres.back() & unused) == 0);
+            REQUIRE((visible_boxes.back() & unused) == 0);
+
+            for (size_t i = 0; i < NUM; ++i) {
+                const auto margin = min_distance(points[i]);
+                if (std::abs(margin) > EPSILON) {
+                    REQUIRE(::math::bitmaskTest(visible_points.data(), i) ==
+                            frustum.contains(points[i]));
+                    num_visible += frustum.contains(points[i]) ? 1 : 0;
+                }
+                if (std::abs(margin + radii[i]) > EPSILON) {
+                    REQUIRE(::math::bitmaskTest(visible_spheres.data(), i) ==
+                            frustum.intersects(Sphere(points[i], radii[i])));
+                }
+                // Skip the boxes with a corner close to any of the planes
+                bool near_plane = false;
+                for (const auto& corner : boxes[i].computeCorners()) {
+                    for (uint32_t k = 0; k < Frustum::NUM_PLANES; ++k) {
+                        near_plane = near_plane ||
+                                     std::abs(frustum.signedDistanceTo(
+                                         k, corner)) <= EPSILON;
+                    }
+                }
+                if (!near_plane) {
+                    REQUIRE(::math::bitmaskTest(visible_boxes.data(), i) ==
+                            frustum.intersects(boxes[i]));
+                }
+            }
+        }
+        // Some of the points are expected to be visible (about a tenth)
+        REQUIRE(num_visible > 0);
+    }
+
+    SECTION("Empty batches") {
+        REQUIRE(::math::cullPoints(frustum, ::math::Vector3Batch<T>()).empty());
+        REQUIRE(::math::cullBoxes(frustum, ::math::AABBBatch<T>()).empty());
+    }
+}
+
+#if defined(__clang__)
+#pragma clang diagnostic pop
+#elif defined(__GNUC__)
+#pragma GCC diagnostic pop
+#elif defined(_MSC_VER)
+#pragma warning(pop)
+#endif
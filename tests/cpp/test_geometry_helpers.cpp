@@ -1,6 +1,8 @@
 #include <catch2/catch.hpp>
 #include <math/utils/geometry_helpers.hpp>
 
+#include <cmath>
+
 #if defined(__clang__)
 #pragma clang diagnostic push
 #pragma clang diagnostic ignored "-Wimplicit-float-conversion"
@@ -22,7 +24,11 @@ TEMPLATE_TEST_CASE("Utilities [Geometric-Helpers]", "[geometric][funcs]",
     using Line = ::math::Line<T>;
     using Plane = ::math::Plane<T>;
     using AABB = ::math::AABB<T>;
+    using Ray = ::math::Ray<T>;
     using Sphere = ::math::Sphere<T>;
+    using Mat4 = ::math::Matrix4<T>;
+    using Frustum = ::math::Frustum<T>;
+    using Visibility = ::math::Visibility;
 
     const Vec3 ZERO = {0.0, 0.0, 0.0};
     const Vec3 DIR_X = {1.0, 0.0, 0.0};
@@ -231,6 +237,44 @@ TEMPLATE_TEST_CASE("Utilities [Geometric-Helpers]", "[geometric][funcs]",
         REQUIRE(!bbox_a.intersects(bbox_c));
     }
 
+    // Ray related tests -------------------------------------------------------
+
+    SECTION("Ray default constructor") {
+        Ray ray;
+        REQUIRE(ray.origin == ZERO);
+        REQUIRE(ray.direction == DIR_X);
+        REQUIRE(ray.inv_direction.x() == 1.0);
+        REQUIRE(std::isinf(ray.inv_direction.y()));
+        REQUIRE(std::isinf(ray.inv_direction.z()));
+    }
+
+    SECTION("Ray constructor from origin and direction") {
+        Ray ray({1.0, 2.0, 3.0}, {2.0, -0.0, -4.0});
+        REQUIRE(ray.origin == Vec3(1.0, 2.0, 3.0));
+        REQUIRE(ray.inv_direction.x() == 0.5);
+        REQUIRE(ray.inv_direction.z() == -0.25);
+        // Negative zero still gives a positive infinity
+        REQUIRE(ray.inv_direction.y() > 0.0);
+        REQUIRE(std::isinf(ray.inv_direction.y()));
+        REQUIRE(ray.pointAt(2.0) == Vec3(5.0, 2.0, -5.0));
+    }
+
+    SECTION("Ray intersect AABB") {
+        const AABB box({1.0, -1.0, -1.0}, {2.0, 1.0, 1.0});
+        REQUIRE(Ray(ZERO, DIR_X).intersect(box) == 1.0);
+        REQUIRE(Ray(ZERO, 2.0 * DIR_X).intersect(box) == 0.5);
+        REQUIRE(std::isinf(Ray(ZERO, -1.0 * DIR_X).intersect(box)));
+        REQUIRE(std::isinf(Ray(ZERO, DIR_Y).intersect(box)));
+        // Hits beyond t_max are reported as misses
+        REQUIRE(std::isinf(Ray(ZERO, DIR_X).intersect(box, 0.5)));
+        // Rays starting inside the box hit it at t = 0
+        REQUIRE(Ray({1.5, 0.0, 0.0}, DIR_Z).intersect(box) == 0.0);
+        // Rays parallel to a face, starting on its plane, touch the box
+        REQUIRE(Ray({0.0, 1.0, 0.0}, DIR_X).intersect(box) == 1.0);
+        REQUIRE(Ray({0.0, -1.0, 0.0}, {1.0, -0.0, 0.0}).intersect(box) == 1.0);
+        REQUIRE(std::isinf(Ray({0.0, 1.5, 0.0}, DIR_X).intersect(box)));
+    }
+
     // Sphere related tests ----------------------------------------------------
 
     SECTION("Sphere default ctor") {
@@ -278,4 +322,77 @@ TEMPLATE_TEST_CASE("Utilities [Geometric-Helpers]", "[geometric][funcs]",
             REQUIRE(sph1.intersects(sph2));
         }
     }
+
+    // Frustum related tests ---------------------------------------------------
+
+    SECTION("Frustum default constructor") {
+        // Contains the whole space
+        Frustum frustum;
+        REQUIRE(frustum.contains(ZERO));
+        REQUIRE(frustum.contains({1e6, -1e6, 1e6}));
+        REQUIRE(frustum.intersects(AABB({-1.0, -1.0, -1.0}, {1.0, 1.0, 1.0})));
+    }
+
+    SECTION("Frustum from a perspective projection") {
+        // 90 deg. fov, so the sides of the frustum are at |x|, |y| <= -z
+        const auto proj = Mat4::Perspective(90.0, 1.0, 1.0, 10.0);
+        // The camera is at z = -2, so the near plane is at z = -3
+        const auto view = Mat4::Translation({0.0, 0.0, 2.0});
+        const Frustum frustum(proj * view);
+
+        // The planes are normalized, and their normals point inwards
+        constexpr T EPSILON = static_cast<T>(1e-5);
+        const T SQRT_HALF = std::sqrt(static_cast<T>(0.5));
+        const auto left = frustum.plane(0);
+        REQUIRE(std::abs(left.normal.length() - 1.0) < EPSILON);
+        REQUIRE(std::abs(left.normal.x() - SQRT_HALF) < EPSILON);
+        REQUIRE(std::abs(left.normal.z() + SQRT_HALF) < EPSILON);
+        const auto near = frustum.plane(4);
+        REQUIRE(std::abs(near.normal.z() + 1.0) < EPSILON);
+        REQUIRE(std::abs(near.signedDistanceTo({0.0, 0.0, -3.0})) < EPSILON);
+        const auto far = frustum.plane(5);
+        REQUIRE(std::abs(far.normal.z() - 1.0) < EPSILON);
+        REQUIRE(std::abs(frustum.signedDistanceTo(5, {0.0, 0.0, -7.0}) - 5.0) <
+                EPSILON);
+
+        REQUIRE(frustum.contains({0.0, 0.0, -5.0}));
+        REQUIRE(frustum.contains({2.5, -2.5, -5.0}));
+        REQUIRE(!frustum.contains({3.5, 0.0, -5.0}));
+        REQUIRE(!frustum.contains({0.0, 0.0, -2.5}));
+        REQUIRE(!frustum.contains({0.0, 0.0, -13.0}));
+        REQUIRE(!frustum.contains({0.0, 0.0, 5.0}));
+
+        REQUIRE(frustum.intersects(Sphere({0.0, 0.0, -1.0}, 2.5)));
+        REQUIRE(!frustum.intersects(Sphere({0.0, 0.0, -1.0}, 1.5)));
+        REQUIRE(frustum.intersects(Sphere({4.0, 0.0, -5.0}, 1.0)));
+        REQUIRE(!frustum.intersects(Sphere({5.0, 0.0, -5.0}, 1.0)));
+
+        REQUIRE(frustum.intersects(AABB({3.5, -1.0, -6.0}, {4.0, 1.0, -5.0})));
+        REQUIRE(!frustum.intersects(AABB({3.5, -1.0, -5.0}, {4.0, 1.0, -4.0})));
+        REQUIRE(!frustum.intersects(AABB({-1.0, -1.0, 0.0}, {1.0, 1.0, 1.0})));
+    }
+
+    SECTION("Frustum classify AABB with plane masks") {
+        const Frustum frustum(Mat4::Perspective(90.0, 1.0, 1.0, 10.0));
+
+        // Inside all planes, so its children don't need any more tests
+        uint32_t mask_inside = Frustum::ALL_PLANES;
+        REQUIRE(frustum.classify(AABB({-1.0, -1.0, -4.0}, {1.0, 1.0, -2.0}),
+                                 mask_inside) == Visibility::INSIDE);
+        REQUIRE(mask_inside == 0);
+
+        // Crosses the near plane (bit 4) only
+        uint32_t mask_near = Frustum::ALL_PLANES;
+        REQUIRE(frustum.classify(AABB({-0.5, -0.5, -2.0}, {0.5, 0.5, -0.8}),
+                                 mask_near) == Visibility::PARTIAL);
+        REQUIRE(mask_near == (1U << 4));
+
+        // Planes not in the mask aren't tested (this box is behind the camera)
+        uint32_t mask_none = 0;
+        REQUIRE(frustum.classify(AABB({-1.0, -1.0, 1.0}, {1.0, 1.0, 2.0}),
+                                 mask_none) == Visibility::INSIDE);
+        uint32_t mask_all = Frustum::ALL_PLANES;
+        REQUIRE(frustum.classify(AABB({-1.0, -1.0, 1.0}, {1.0, 1.0, 2.0}),
+                                 mask_all) == Visibility::OUTSIDE);
+    }
 }
@@ -66,4 +66,24 @@ TEMPLATE_TEST_CASE("Lerp function for vec4_t", "[vec4_t][lerp]",
         auto v_b = ::math::lerp<T>(v_0, v_1, 1.5);
         REQUIRE(::math::func_all_close<T>(v_b, 1.5, 3.0, 4.5, 6.0, EPSILON));
     }
+
+    SECTION("Arrays of vectors") {
+        constexpr size_t NUM_VECTORS = 13;
+        constexpr T ALPHA = static_cast<T>(0.75);
+        auto vecs_a = ::math::random_vec4_array<T>(NUM_VECTORS);
+        auto vecs_b = ::math::random_vec4_array<T>(NUM_VECTORS);
+        auto alphas = ::math::random_scalar_array<T>(NUM_VECTORS);
+
+        std::vector<Vector4> lerps(NUM_VECTORS);
+        std::vector<Vector4> lerps_each(NUM_VECTORS);
+        ::math::lerp(vecs_a.data(), vecs_b.data(), ALPHA, lerps.data(),
+                     NUM_VECTORS);
+        ::math::lerp(vecs_a.data(), vecs_b.data(), alphas.data(),
+                     lerps_each.data(), NUM_VECTORS);
+        for (size_t i = 0; i < NUM_VECTORS; ++i) {
+            REQUIRE(lerps[i] == ::math::lerp(vecs_a[i], vecs_b[i], ALPHA));
+            REQUIRE(lerps_each[i] ==
+                    ::math::lerp(vecs_a[i], vecs_b[i], alphas[i]));
+        }
+    }
 }
@@ -122,13 +122,15 @@ TEMPLATE_TEST_CASE("Matrix2 class (mat2_t) core operations", "[mat2_t][ops]",
 
         // Test-cases using the random matrices ----------
         auto mat_mul_ab = MAT_A * MAT_B;
+        auto tolerance =
+            ::math::func_matmul_tolerance<T>(MAT_A, MAT_B, EPSILON);
 
         // clang-format off
         REQUIRE(::math::func_all_close<T>(mat_mul_ab,
             x00 * y00 + x01 * y10,
             x00 * y01 + x01 * y11,
             x10 * y00 + x11 * y10,
-            x10 * y01 + x11 * y11, EPSILON));
+            x10 * y01 + x11 * y11, tolerance));
         // clang-format on
         // -----------------------------------------------
     }
@@ -151,11 +153,12 @@ TEMPLATE_TEST_CASE("Matrix2 class (mat2_t) core operations", "[mat2_t][ops]",
             take(NUM_SAMPLES, ::math::random_vec2<T>(RANGE_MIN, RANGE_MAX)));
 
         auto mat_vec_mul_2 = MAT_A * v_a;
+        auto tolerance = ::math::func_matvec_tolerance<T>(MAT_A, v_a, EPSILON);
 
         // clang-format off
         REQUIRE(::math::func_all_close<T>(mat_vec_mul_2,
             x00 * v_a.x() + x01 * v_a.y(),
-            x10 * v_a.x() + x11 * v_a.y(), EPSILON));
+            x10 * v_a.x() + x11 * v_a.y(), tolerance));
         // clang-format on
         // -----------------------------------------------
     }
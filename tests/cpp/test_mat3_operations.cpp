@@ -145,6 +145,8 @@ TEMPLATE_TEST_CASE("Matrix3 class (mat3_t) core operations", "[mat3_t][ops]",
 
         // Test-cases using the random matrices ------------------
         auto mat_mul_ab = MAT_A * MAT_B;
+        auto tolerance =
+            ::math::func_matmul_tolerance<T>(MAT_A, MAT_B, EPSILON);
         // clang-format off
         REQUIRE(::math::func_all_close<T>(mat_mul_ab,
                 // First row
@@ -158,7 +160,7 @@ TEMPLATE_TEST_CASE("Matrix3 class (mat3_t) core operations", "[mat3_t][ops]",
                 // Third row
                 x20 * y00 + x21 * y10 + x22 * y20,
                 x20 * y01 + x21 * y11 + x22 * y21,
-                x20 * y02 + x21 * y12 + x22 * y22, EPSILON));
+                x20 * y02 + x21 * y12 + x22 * y22, tolerance));
         // clang-format on
         // ------------------------------------------------------
         // @todo(wilbert): test with poorly conditioned matrices
@@ -184,12 +186,13 @@ TEMPLATE_TEST_CASE("Matrix3 class (mat3_t) core operations", "[mat3_t][ops]",
             take(NUM_SAMPLES, ::math::random_vec3<T>(RANGE_MIN, RANGE_MAX)));
 
         auto mat_vec_mul_2 = MAT_A * v_a;
+        auto tolerance = ::math::func_matvec_tolerance<T>(MAT_A, v_a, EPSILON);
 
         // clang-format off
         REQUIRE(::math::func_all_close<T>(mat_vec_mul_2,
             x00 * v_a.x() + x01 * v_a.y() + x02 * v_a.z(),
             x10 * v_a.x() + x11 * v_a.y() + x12 * v_a.z(),
-            x20 * v_a.x() + x21 * v_a.y() + x22 * v_a.z(), EPSILON));
+            x20 * v_a.x() + x21 * v_a.y() + x22 * v_a.z(), tolerance));
         // clang-format on
         // ------------------------------------------------------
     }
@@ -256,6 +259,35 @@ TEMPLATE_TEST_CASE("Matrix3 class (mat3_t) core operations", "[mat3_t][ops]",
              0.555556, -0.388889, -0.666667, EPSILON));
         // clang-format on
     }
+
+    SECTION("Matrix storage (MATH3D_VEC3_PADDED)") {
+        if (!::math::HAS_VEC3_PADDING::value) {
+            REQUIRE(sizeof(Matrix3) == 9 * sizeof(T));
+            return;
+        }
+        REQUIRE(sizeof(Matrix3) == 12 * sizeof(T));
+        REQUIRE(alignof(Matrix3) == 4 * sizeof(T));
+
+        auto m_a = GENERATE(
+            take(NUM_SAMPLES, ::math::random_mat3<T>(RANGE_MIN, RANGE_MAX)));
+        auto m_b = GENERATE(
+            take(NUM_SAMPLES, ::math::random_mat3<T>(RANGE_MIN, RANGE_MAX)));
+
+        // The padding entry of each column must stay zero after every operation
+        auto is_padding_zero = [](const Matrix3& mat) -> bool {
+            return mat[0].data()[3] == static_cast<T>(0.0) &&
+                   mat[1].data()[3] == static_cast<T>(0.0) &&
+                   mat[2].data()[3] == static_cast<T>(0.0);
+        };
+        REQUIRE(is_padding_zero(m_a));
+        REQUIRE(is_padding_zero(m_a + m_b));
+        REQUIRE(is_padding_zero(m_a - m_b));
+        REQUIRE(is_padding_zero(m_a * m_b));
+        REQUIRE(is_padding_zero(2.0 * m_a));
+        REQUIRE(is_padding_zero(::math::hadamard(m_a, m_b)));
+        REQUIRE(is_padding_zero(::math::transpose(m_a)));
+        REQUIRE((m_a * m_b[0]).data()[3] == static_cast<T>(0.0));
+    }
 }
 
 #if defined(__clang__)
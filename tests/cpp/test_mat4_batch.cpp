@@ -0,0 +1,144 @@
+#include <catch2/catch.hpp>
+#include <math/mat4_t.hpp>
+
+#include "./common_math_helpers.hpp"
+#include "./common_math_generators.hpp"
+
+#if defined(__clang__)
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wimplicit-float-conversion"
+#pragma clang diagnostic ignored "-Wdouble-promotion"
+#elif defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wfloat-conversion"
+#pragma GCC diagnostic ignored "-Wdouble-promotion"
+#elif defined(_MSC_VER)
+#pragma warning(push)
+#pragma warning(disable : 4305)
+#pragma warning(disable : 4244)
+#endif
+
+constexpr double USER_EPSILON = 1e-5;
+
+constexpr auto NUM_SAMPLES = 4;
+
+// NOLINTNEXTLINE
+TEMPLATE_TEST_CASE("Matrix4 class (mat4_t) batch transforms",
+                   "[mat4_t][batch]", ::math::float32_t, ::math::float64_t) {
+    using T = TestType;
+    using Vector3 = ::math::Vector3<T>;
+    using Vector4 = ::math::Vector4<T>;
+    using Vector3Batch = ::math::Vector3Batch<T>;
+
+    constexpr T EPSILON = static_cast<T>(USER_EPSILON);
+
+    // Not a multiple of any register width (nor of the unrolled loops)
+    constexpr size_t NUM_VECTORS = 43;
+
+    auto mat = GENERATE(take(NUM_SAMPLES, ::math::random_mat4<T>()));
+    auto vecs = ::math::random_vec3_array<T>(NUM_VECTORS);
+
+    std::vector<Vector3> expected_points(NUM_VECTORS);
+    std::vector<Vector3> expected_directions(NUM_VECTORS);
+    for (size_t i = 0; i < NUM_VECTORS; ++i) {
+        const auto& v = vecs[i];
+        expected_points[i] = Vector3(mat * Vector4(v.x(), v.y(), v.z(), 1.0));
+        expected_directions[i] =
+            Vector3(mat * Vector4(v.x(), v.y(), v.z(), 0.0));
+    }
+
+    SECTION("Transform arrays of points and directions") {
+        for (const auto isa : ::math::dispatch::GetSupportedIsas()) {
+            ::math::dispatch::ScopedIsa guard(isa);
+            INFO("isa: " << ::math::dispatch::ToString(isa));
+            std::vector<Vector3> points(NUM_VECTORS);
+            std::vector<Vector3> directions(NUM_VECTORS);
+            ::math::transformPoints(mat, vecs.data(), points.data(),
+                                    NUM_VECTORS);
+            ::math::transformDirections(mat, vecs.data(), directions.data(),
+                                        NUM_VECTORS);
+            for (size_t i = 0; i < NUM_VECTORS; ++i) {
+                // clang-format off
+                REQUIRE(::math::func_all_close<T>(points[i],
+                    expected_points[i].x(),
+                    expected_points[i].y(),
+                    expected_points[i].z(), EPSILON));
+                REQUIRE(::math::func_all_close<T>(directions[i],
+                    expected_directions[i].x(),
+                    expected_directions[i].y(),
+                    expected_directions[i].z(), EPSILON));
+                // clang-format on
+            }
+
+            // In-place transforms should give the same results
+            auto points_in_place = vecs;
+            ::math::transformPoints(mat, points_in_place.data(),
+                                    points_in_place.data(), NUM_VECTORS);
+            for (size_t i = 0; i < NUM_VECTORS; ++i) {
+                REQUIRE(points_in_place[i] == points[i]);
+            }
+        }
+    }
+
+    SECTION("Transform batches of points and directions") {
+        for (const auto isa : ::math::dispatch::GetSupportedIsas()) {
+            ::math::dispatch::ScopedIsa guard(isa);
+            INFO("isa: " << ::math::dispatch::ToString(isa));
+            Vector3Batch batch(vecs);
+            Vector3Batch points;
+            Vector3Batch directions;
+            ::math::transformPoints(mat, batch, points);
+            ::math::transformDirections(mat, batch, directions);
+            REQUIRE(points.size() == NUM_VECTORS);
+            REQUIRE(directions.size() == NUM_VECTORS);
+            for (size_t i = 0; i < NUM_VECTORS; ++i) {
+                // clang-format off
+                REQUIRE(::math::func_all_close<T>(points[i],
+                    expected_points[i].x(),
+                    expected_points[i].y(),
+                    expected_points[i].z(), EPSILON));
+                REQUIRE(::math::func_all_close<T>(directions[i],
+                    expected_directions[i].x(),
+                    expected_directions[i].y(),
+                    expected_directions[i].z(), EPSILON));
+                // clang-format on
+            }
+        }
+    }
+
+    SECTION("Multiply arrays of matrices") {
+        using Mat4 = ::math::Matrix4<T>;
+        std::vector<Mat4> lhs(NUM_SAMPLES), rhs(NUM_SAMPLES);
+        for (size_t i = 0; i < NUM_SAMPLES; ++i) {
+            lhs[i] = mat * static_cast<T>(i + 1);
+            rhs[i] = Mat4(Vector4(vecs[i].x(), vecs[i].y(), vecs[i].z(), 1.0),
+                          Vector4(vecs[i].y(), 2.0, 1.0, 0.0),
+                          Vector4(vecs[i].z(), 0.0, 3.0, 1.0),
+                          Vector4(1.0, vecs[i].x(), 0.0, 1.0));
+        }
+        std::vector<Mat4> products(NUM_SAMPLES);
+        ::math::multiplyMatrices(lhs.data(), rhs.data(), products.data(),
+                                 NUM_SAMPLES);
+        // In-place, overwriting the left-hand side
+        ::math::multiplyMatrices(lhs.data(), rhs.data(), lhs.data(),
+                                 NUM_SAMPLES);
+        for (size_t n = 0; n < NUM_SAMPLES; ++n) {
+            const Mat4 expected = (mat * static_cast<T>(n + 1)) * rhs[n];
+            for (uint32_t i = 0; i < 4; ++i) {
+                for (uint32_t j = 0; j < 4; ++j) {
+                    REQUIRE(std::abs(products[n](i, j) - expected(i, j)) <
+                            EPSILON);
+                    REQUIRE(lhs[n](i, j) == products[n](i, j));
+                }
+            }
+        }
+    }
+}
+
+#if defined(__clang__)
+#pragma clang diagnostic pop  // NOLINT
+#elif defined(__GNUC__)
+#pragma GCC diagnostic pop
+#elif defined(_MSC_VER)
+#pragma warning(pop)
+#endif
@@ -169,6 +169,8 @@ TEMPLATE_TEST_CASE("Matrix4 class (mat4_t) core operations", "[mat4_t][ops]",
         // clang-format off
         // Test-cases using the random matrices ----------------
         auto mat_mul_ab = MAT_A * MAT_B;
+        auto tolerance =
+            ::math::func_matmul_tolerance<T>(MAT_A, MAT_B, EPSILON);
         REQUIRE(::math::func_all_close<T>(mat_mul_ab,
             // First row
             x00 * y00 + x01 * y10 + x02 * y20 + x03 * y30,
@@ -189,7 +191,7 @@ TEMPLATE_TEST_CASE("Matrix4 class (mat4_t) core operations", "[mat4_t][ops]",
             x30 * y00 + x31 * y10 + x32 * y20 + x33 * y30,
             x30 * y01 + x31 * y11 + x32 * y21 + x33 * y31,
             x30 * y02 + x31 * y12 + x32 * y22 + x33 * y32,
-            x30 * y03 + x31 * y13 + x32 * y23 + x33 * y33, EPSILON));
+            x30 * y03 + x31 * y13 + x32 * y23 + x33 * y33, tolerance));
         // ----------------------------------------------------
         // clang-format on
         // @todo(wilbert): test with poorly conditioned matrices
@@ -214,13 +216,14 @@ TEMPLATE_TEST_CASE("Matrix4 class (mat4_t) core operations", "[mat4_t][ops]",
             take(NUM_SAMPLES, ::math::random_vec4<T>(RANGE_MIN, RANGE_MAX)));
 
         auto mat_vec_mul_2 = MAT_A * v_a;
+        auto tolerance = ::math::func_matvec_tolerance<T>(MAT_A, v_a, EPSILON);
         // clang-format off
         REQUIRE(::math::func_all_close<T>(mat_vec_mul_2,
              x00 * v_a.x() + x01 * v_a.y() + x02 * v_a.z() + x03 * v_a.w(),
              x10 * v_a.x() + x11 * v_a.y() + x12 * v_a.z() + x13 * v_a.w(),
              x20 * v_a.x() + x21 * v_a.y() + x22 * v_a.z() + x23 * v_a.w(),
              x30 * v_a.x() + x31 * v_a.y() + x32 * v_a.z() + x33 * v_a.w(),
-             EPSILON));
+             tolerance));
         // clang-format on
         // ------------------------------------------------------
     }
@@ -293,7 +296,217 @@ TEMPLATE_TEST_CASE("Matrix4 class (mat4_t) core operations", "[mat4_t][ops]",
            0.00451977,  -0.19435,  0.258757, -0.0870056, EPSILON));
         // clang-format on
     }
+
+    SECTION("Matrix inverse and determinant (random matrices)") {
+        auto rand_mat = GENERATE(take(NUM_SAMPLES, ::math::random_mat4<T>()));
+        // Keep the matrix well-conditioned (diagonally dominant)
+        auto mat = rand_mat + static_cast<T>(4.0) * Matrix4::Identity();
+
+        auto expected_det = ::math::scalar::kernel_determinant_mat4<T>(
+            mat.elements());
+        REQUIRE(::math::func_value_close<T>(
+            ::math::determinant(mat), expected_det,
+            static_cast<T>(USER_EPSILON) * std::abs(expected_det)));
+
+        auto inv_mat = ::math::inverse(mat);
+        REQUIRE(::math::func_all_close<T>(mat * inv_mat, 1.0, 0.0, 0.0, 0.0,
+                                          0.0, 1.0, 0.0, 0.0, 0.0, 0.0, 1.0,
+                                          0.0, 0.0, 0.0, 0.0, 1.0, EPSILON));
+
+        auto mat_t = ::math::transpose(mat);
+        ::math::transposeInPlace(mat_t);
+        REQUIRE(mat_t == mat);
+    }
+
+    SECTION("Rigid and affine inverses") {
+        using Vector3 = ::math::Vector3<T>;
+        auto quat =
+            GENERATE(take(NUM_SAMPLES, ::math::random_unit_quaternion<T>()));
+        auto pos = GENERATE(take(1, ::math::random_vec3<T>()));
+        auto scale = GENERATE(take(1, ::math::random_vec3<T>(0.5, 2.0)));
+
+        Matrix4 rigid(pos, quat);
+        REQUIRE(::math::scalar::kernel_is_rigid_mat4<T>(rigid.elements(),
+                                                        EPSILON));
+        auto inv_rigid = ::math::inverseRigid(rigid);
+        REQUIRE(::math::func_all_close<T>(rigid * inv_rigid, 1.0, 0.0, 0.0,
+                                          0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 0.0,
+                                          1.0, 0.0, 0.0, 0.0, 0.0, 1.0,
+                                          EPSILON));
+
+        Matrix4 affine = rigid * Matrix4::Scale(scale);
+        REQUIRE(::math::scalar::kernel_is_affine_mat4<T>(affine.elements(),
+                                                         EPSILON));
+        REQUIRE_FALSE(::math::scalar::kernel_is_rigid_mat4<T>(
+            (rigid * Matrix4::Scale(Vector3(2.0, 1.0, 1.0))).elements(),
+            EPSILON));
+        auto inv_affine = ::math::inverseAffine(affine);
+        REQUIRE(::math::func_all_close<T>(affine * inv_affine, 1.0, 0.0, 0.0,
+                                          0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 0.0,
+                                          1.0, 0.0, 0.0, 0.0, 0.0, 1.0,
+                                          EPSILON));
+
+        // Both should match the general inverse (and the scalar kernels)
+        auto expected_rigid = ::math::inverse(rigid);
+        auto expected_affine = ::math::inverse(affine);
+        Matrix4 scalar_rigid;
+        Matrix4 scalar_affine;
+        ::math::scalar::kernel_inverse_rigid_mat4<T>(scalar_rigid.elements(),
+                                                     rigid.elements());
+        ::math::scalar::kernel_inverse_affine_mat4<T>(
+            scalar_affine.elements(), affine.elements());
+        for (uint32_t col = 0; col < 4; ++col) {
+            for (uint32_t row = 0; row < 4; ++row) {
+                REQUIRE(::math::func_value_close<T>(
+                    inv_rigid(row, col), expected_rigid(row, col), EPSILON));
+                REQUIRE(::math::func_value_close<T>(
+                    scalar_rigid(row, col), inv_rigid(row, col), EPSILON));
+                REQUIRE(::math::func_value_close<T>(
+                    inv_affine(row, col), expected_affine(row, col), EPSILON));
+                REQUIRE(::math::func_value_close<T>(
+                    scalar_affine(row, col), inv_affine(row, col), EPSILON));
+            }
+        }
+    }
+}
+
+#if defined(MATH3D_AVX512_ENABLED)
+// NOLINTNEXTLINE
+TEMPLATE_TEST_CASE("Matrix4 class (mat4_t) AVX-512 kernels", "[mat4_t][avx512]",
+                   ::math::float32_t, ::math::float64_t) {
+    using T = TestType;
+    using Matrix4 = ::math::Matrix4<T>;
+    using Vector4 = ::math::Vector4<T>;
+
+    constexpr T EPSILON = static_cast<T>(USER_EPSILON);
+
+    // The whole binary targets AVX-512 in this configuration, so it should run
+    // under an emulator (e.g. Intel SDE) on machines without it
+    if (!::math::dispatch::IsSupported(::math::dispatch::Isa::AVX512)) {
+        WARN("AVX-512 isn't supported by this CPU, skipping kernel checks");
+        return;
+    }
+
+    const auto MAT_A = GENERATE(take(NUM_SAMPLES, ::math::random_mat4<T>()));
+    const auto MAT_B = GENERATE(take(NUM_SAMPLES, ::math::random_mat4<T>()));
+    const auto VEC = GENERATE(take(1, ::math::random_vec4<T>()));
+    const auto SCALE = static_cast<T>(2.5);
+
+    auto check = [&](const Matrix4& result, const Matrix4& expected) {
+        for (uint32_t col = 0; col < 4; ++col) {
+            for (uint32_t row = 0; row < 4; ++row) {
+                REQUIRE(::math::func_value_close<T>(
+                    result(row, col), expected(row, col), EPSILON));
+            }
+        }
+    };
+
+    Matrix4 result;
+    Matrix4 expected;
+
+    ::math::avx512::kernel_add_mat4<T>(result.elements(), MAT_A.elements(),
+                                       MAT_B.elements());
+    ::math::scalar::kernel_add_mat4<T>(expected.elements(), MAT_A.elements(),
+                                       MAT_B.elements());
+    check(result, expected);
+
+    ::math::avx512::kernel_sub_mat4<T>(result.elements(), MAT_A.elements(),
+                                       MAT_B.elements());
+    ::math::scalar::kernel_sub_mat4<T>(expected.elements(), MAT_A.elements(),
+                                       MAT_B.elements());
+    check(result, expected);
+
+    ::math::avx512::kernel_scale_mat4<T>(result.elements(), SCALE,
+                                         MAT_A.elements());
+    ::math::scalar::kernel_scale_mat4<T>(expected.elements(), SCALE,
+                                         MAT_A.elements());
+    check(result, expected);
+
+    ::math::avx512::kernel_hadamard_mat4<T>(result.elements(),
+                                            MAT_A.elements(), MAT_B.elements());
+    ::math::scalar::kernel_hadamard_mat4<T>(
+        expected.elements(), MAT_A.elements(), MAT_B.elements());
+    check(result, expected);
+
+    // The scalar matmul kernels accumulate into dst, so start from zeros
+    Matrix4 expected_matmul;
+    ::math::avx512::kernel_matmul_mat4<T>(result.elements(), MAT_A.elements(),
+                                          MAT_B.elements());
+    ::math::scalar::kernel_matmul_mat4<T>(expected_matmul.elements(),
+                                          MAT_A.elements(), MAT_B.elements());
+    check(result, expected_matmul);
+
+    Vector4 result_vec;
+    Vector4 expected_vec;
+    ::math::avx512::kernel_matmul_vec_mat4<T>(
+        result_vec.elements(), MAT_A.elements(), VEC.elements());
+    ::math::scalar::kernel_matmul_vec_mat4<T>(
+        expected_vec.elements(), MAT_A.elements(), VEC.elements());
+    REQUIRE(::math::func_all_close<T>(result_vec, expected_vec.x(),
+                                      expected_vec.y(), expected_vec.z(),
+                                      expected_vec.w(), EPSILON));
+}
+#endif  // MATH3D_AVX512_ENABLED
+
+#if defined(MATH3D_FMA_ENABLED)
+// NOLINTNEXTLINE
+TEMPLATE_TEST_CASE("Matrix4 class (mat4_t) FMA kernels", "[mat4_t][fma]",
+                   ::math::float32_t, ::math::float64_t) {
+    using T = TestType;
+    using Matrix4 = ::math::Matrix4<T>;
+    using Vector4 = ::math::Vector4<T>;
+
+    constexpr T EPSILON = static_cast<T>(USER_EPSILON);
+    constexpr T RANGE_MIN = static_cast<T>(USER_RANGE_MIN);
+    constexpr T RANGE_MAX = static_cast<T>(USER_RANGE_MAX);
+
+    const auto MAT_A = GENERATE(
+        take(NUM_SAMPLES, ::math::random_mat4<T>(RANGE_MIN, RANGE_MAX)));
+    const auto MAT_B = GENERATE(
+        take(NUM_SAMPLES, ::math::random_mat4<T>(RANGE_MIN, RANGE_MAX)));
+    const auto VEC =
+        GENERATE(take(1, ::math::random_vec4<T>(RANGE_MIN, RANGE_MAX)));
+
+    const auto TOLERANCE =
+        ::math::func_matmul_tolerance<T>(MAT_A, MAT_B, EPSILON);
+    auto check = [&](const Matrix4& result, const Matrix4& expected) {
+        for (uint32_t col = 0; col < 4; ++col) {
+            for (uint32_t row = 0; row < 4; ++row) {
+                REQUIRE(::math::func_value_close<T>(
+                    result(row, col), expected(row, col), TOLERANCE));
+            }
+        }
+    };
+
+    // The scalar matmul kernels accumulate into dst, so start from zeros
+    Matrix4 result;
+    Matrix4 expected;
+    ::math::fma3::kernel_matmul_mat4<T>(result.elements(), MAT_A.elements(),
+                                        MAT_B.elements());
+    ::math::scalar::kernel_matmul_mat4<T>(expected.elements(), MAT_A.elements(),
+                                          MAT_B.elements());
+    check(result, expected);
+
+    // The columns of lhs are loaded before any store, so dst can alias it
+    Matrix4 result_aliased = MAT_A;
+    ::math::fma3::kernel_matmul_mat4<T>(result_aliased.elements(),
+                                        result_aliased.elements(),
+                                        MAT_B.elements());
+    check(result_aliased, expected);
+
+    Vector4 result_vec;
+    Vector4 expected_vec;
+    ::math::fma3::kernel_matmul_vec_mat4<T>(
+        result_vec.elements(), MAT_A.elements(), VEC.elements());
+    ::math::scalar::kernel_matmul_vec_mat4<T>(
+        expected_vec.elements(), MAT_A.elements(), VEC.elements());
+    const auto TOLERANCE_VEC =
+        ::math::func_matvec_tolerance<T>(MAT_A, VEC, EPSILON);
+    REQUIRE(::math::func_all_close<T>(result_vec, expected_vec.x(),
+                                      expected_vec.y(), expected_vec.z(),
+                                      expected_vec.w(), TOLERANCE_VEC));
 }
+#endif  // MATH3D_FMA_ENABLED
 
 #if defined(__clang__)
 #pragma clang diagnostic pop  // NOLINT
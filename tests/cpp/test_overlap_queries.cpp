@@ -0,0 +1,155 @@
+#include <catch2/catch.hpp>
+#include <math/overlap_queries.hpp>
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+#if defined(__clang__)
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wimplicit-float-conversion"
+#pragma clang diagnostic ignored "-Wdouble-promotion"
+#elif defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wfloat-conversion"
+#pragma GCC diagnostic ignored "-Wdouble-promotion"
+#elif defined(_MSC_VER)
+#pragma warning(push)
+#pragma warning(disable : 4305)
+#pragma warning(disable : 4244)
+#endif
+
+TEST_CASE("Bitmasks of query results (bitmask)", "[bitmask]") {
+    std::vector<uint64_t> bitmask(::math::bitmaskWords(130));
+    REQUIRE(bitmask.size() == 3);
+    // Written in order a few bits at a time, as the batch kernels do
+    for (size_t i = 0; i < 130; i += 2) {
+        ::math::bitmaskWrite(bitmask.data(), i, (i % 3 == 0) ? 0x3U : 0x2U);
+    }
+    std::vector<size_t> expected;
+    for (size_t i = 0; i < 130; ++i) {
+        if (i % 2 == 1 || i % 3 == 0) {
+            expected.push_back(i);
+        }
+        REQUIRE(::math::bitmaskTest(bitmask.data(), i) ==
+                (i % 2 == 1 || i % 3 == 0));
+    }
+    REQUIRE(::math::bitmaskCount(bitmask.data(), 130) == expected.size());
+    REQUIRE(::math::bitmaskToIndices(bitmask.data(), 130) == expected);
+    REQUIRE(::math::bitmaskToIndices(bitmask.data(), 0).empty());
+}
+
+// NOLINTNEXTLINE
+TEMPLATE_TEST_CASE("Overlap queries against batches (overlap_queries)",
+                   "[overlap_queries]", ::math::float32_t, ::math::float64_t) {
+    using T = TestType;
+    using Vec3 = ::math::Vector3<T>;
+    using AABB = ::math::AABB<T>;
+    using Sphere = ::math::Sphere<T>;
+
+    // Not a multiple of 64 nor of any register width, so the remainders and
+    // the last (partial) word of the bitmasks are also tested
+    constexpr size_t NUM = 203;
+    // Spheres closer than this to the boundary of the query are skipped, in
+    // case the compiler contracts the scalar tests into FMAs
+    constexpr T EPSILON = static_cast<T>(1e-3);
+
+    std::minstd_rand gen(std::random_device{}());  // NOLINT
+    std::uniform_real_distribution<T> dist_pos(-5.0, 5.0);
+    std::uniform_real_distribution<T> dist_size(0.0, 2.0);
+
+    std::vector<Vec3> points(NUM);
+    std::vector<T> radii(NUM);
+    std::vector<AABB> boxes(NUM);
+    for (size_t i = 0; i < NUM; ++i) {
+        points[i] = Vec3(dist_pos(gen), dist_pos(gen), dist_pos(gen));
+        radii[i] = dist_size(gen);
+        const Vec3 half(dist_size(gen), dist_size(gen), dist_size(gen));
+        boxes[i] = AABB(points[i] - half, points[i] + half);
+    }
+    const ::math::Vector3Batch<T> points_batch(points);
+    const ::math::AABBBatch<T> boxes_batch(boxes);
+
+    const Sphere sphere(Vec3(0.5, -0.5, 1.0), 3.0);
+    const AABB box(Vec3(-2.0, -1.0, -3.0), Vec3(1.0, 3.0, 0.5));
+
+    SECTION("Sphere, sphere and box queries match the member functions") {
+        for (const auto isa : ::math::dispatch::GetSupportedIsas()) {
+            ::math::dispatch::ScopedIsa guard(isa);
+            INFO("isa: " << ::math::dispatch::ToString(isa));
+            const auto inside =
+                ::math::sphereContainsPoints(sphere, points_batch);
+            const auto sphere_overlaps =
+                ::math::sphereIntersectsSpheres(sphere, points_batch, radii);
+            const auto box_overlaps =
+                ::math::aabbIntersectsAABBs(box, boxes_batch);
+            REQUIRE(inside.size() == ::math::bitmaskWords(NUM));
+            REQUIRE(sphere_overlaps.size() == ::math::bitmaskWords(NUM));
+            REQUIRE(box_overlaps.size() == ::math::bitmaskWords(NUM));
+            // The unused bits of the last word are cleared
+            const auto unused = ~((1ULL << (NUM % 64)) - 1);
+            REQUIRE((inside.back() & unused) == 0);
+            REQUIRE((sphere_overlaps.back() & unused) == 0);
+            REQUIRE((box_overlaps.back() & unused) == 0);
+
+            for (size_t i = 0; i < NUM; ++i) {
+                const auto distance = (points[i] - sphere.center).length();
+                if (std::abs(distance - sphere.radius) > EPSILON) {
+                    REQUIRE(::math::bitmaskTest(inside.data(), i) ==
+                            sphere.contains(points[i]));
+                }
+                if (std::abs(distance - sphere.radius - radii[i]) > EPSILON) {
+                    REQUIRE(::math::bitmaskTest(sphere_overlaps.data(), i) ==
+                            sphere.intersects(Sphere(points[i], radii[i])));
+                }
+                // Only comparisons, so these match exactly
+                REQUIRE(::math::bitmaskTest(box_overlaps.data(), i) ==
+                        box.intersects(boxes[i]));
+            }
+            // Some elements of each batch overlap the volumes, but not all
+            const auto num_inside = ::math::bitmaskCount(inside.data(), NUM);
+            const auto num_boxes =
+                ::math::bitmaskCount(box_overlaps.data(), NUM);
+            REQUIRE((num_inside > 0 && num_inside < NUM));
+            REQUIRE((num_boxes > 0 && num_boxes < NUM));
+        }
+    }
+
+    SECTION("Index lists of the overlapping elements") {
+        const auto box_overlaps = ::math::aabbIntersectsAABBs(box, boxes_batch);
+        std::vector<size_t> expected;
+        for (size_t i = 0; i < NUM; ++i) {
+            if (box.intersects(boxes[i])) {
+                expected.push_back(i);
+            }
+        }
+        REQUIRE(::math::bitmaskToIndices(box_overlaps.data(), NUM) ==
+                expected);
+    }
+
+    SECTION("Boxes touching along a face overlap") {
+        const ::math::AABBBatch<T> touching(std::vector<AABB>{
+            AABB(Vec3(1.0, 0.0, 0.0), Vec3(2.0, 1.0, 0.5)),
+            AABB(Vec3(1.5, 0.0, 0.0), Vec3(2.0, 1.0, 0.5)),
+            AABB(Vec3(-3.0, -2.0, -4.0), Vec3(-2.0, -1.0, -3.0)),
+            AABB()});
+        const auto overlaps = ::math::aabbIntersectsAABBs(box, touching);
+        REQUIRE(overlaps.size() == 1);
+        REQUIRE(overlaps[0] == 0xDU);
+    }
+
+    SECTION("Empty batches") {
+        REQUIRE(::math::sphereContainsPoints(sphere, ::math::Vector3Batch<T>())
+                    .empty());
+        REQUIRE(::math::aabbIntersectsAABBs(box, ::math::AABBBatch<T>())
+                    .empty());
+    }
+}
+
+#if defined(__clang__)
+#pragma clang diagnostic pop
+#elif defined(__GNUC__)
+#pragma GCC diagnostic pop
+#elif defined(_MSC_VER)
+#pragma warning(pop)
+#endif
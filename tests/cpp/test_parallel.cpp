@@ -0,0 +1,153 @@
+#include <catch2/catch.hpp>
+#include <math/parallel.hpp>
+#include <math/pose3d_t.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "./common_math_helpers.hpp"
+#include "./common_math_generators.hpp"
+
+#if defined(__clang__)
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wimplicit-float-conversion"
+#pragma clang diagnostic ignored "-Wdouble-promotion"
+#elif defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wfloat-conversion"
+#pragma GCC diagnostic ignored "-Wdouble-promotion"
+#elif defined(_MSC_VER)
+#pragma warning(push)
+#pragma warning(disable : 4305)
+#pragma warning(disable : 4244)
+#endif
+
+TEST_CASE("Threaded execution of batch calls (parallel)", "[parallel]") {
+    using Range = std::pair<size_t, size_t>;
+
+    // Returns the ranges ParallelFor splits [0, num) into (sorted)
+    auto split = [](size_t num, size_t min_per_thread, size_t grain) {
+        std::mutex mutex;
+        std::vector<Range> ranges;
+        ::math::parallel::ParallelFor(
+            num,
+            [&](size_t begin, size_t end) {
+                std::lock_guard<std::mutex> lock(mutex);
+                ranges.emplace_back(begin, end);
+            },
+            min_per_thread, grain);
+        std::sort(ranges.begin(), ranges.end());
+        return ranges;
+    };
+
+    SECTION("Number of threads") {
+        ::math::parallel::ScopedNumThreads guard(3);
+        REQUIRE(::math::parallel::GetNumThreads() == 3);
+        {
+            ::math::parallel::ScopedNumThreads guard_all(0);
+            REQUIRE(::math::parallel::GetNumThreads() ==
+                    std::max(1U, std::thread::hardware_concurrency()));
+        }
+        REQUIRE(::math::parallel::GetNumThreads() == 3);
+    }
+
+    SECTION("Serial execution") {
+        ::math::parallel::ScopedNumThreads guard(1);
+        auto ranges = split(100000, 10, 1);
+        REQUIRE(ranges.size() == 1);
+        REQUIRE(ranges[0] == Range(0, 100000));
+        // Too few elements to split them across threads
+        ::math::parallel::ScopedNumThreads guard_four(4);
+        ranges = split(7000, 4096, 1);
+        REQUIRE(ranges.size() == 1);
+        REQUIRE(split(0, 4096, 1).size() == 1);
+    }
+
+    SECTION("Ranges cover all the elements, starting at whole grains") {
+        ::math::parallel::ScopedNumThreads guard(4);
+        for (size_t num : {1000, 1001, 1003, 4096}) {
+            for (size_t grain : {1, 3, 64}) {
+                INFO("num: " << num << ", grain: " << grain);
+                auto ranges = split(num, 100, grain);
+                REQUIRE(ranges.size() > 1);
+                REQUIRE(ranges.size() <= 4);
+                REQUIRE(ranges.front().first == 0);
+                REQUIRE(ranges.back().second == num);
+                for (size_t k = 0; k < ranges.size(); ++k) {
+                    REQUIRE(ranges[k].first % grain == 0);
+                    REQUIRE(ranges[k].first < ranges[k].second);
+                    if (k > 0) {
+                        REQUIRE(ranges[k].first == ranges[k - 1].second);
+                    }
+                }
+            }
+        }
+    }
+
+    SECTION("Exceptions thrown in the calling thread") {
+        ::math::parallel::ScopedNumThreads guard(4);
+        std::atomic<size_t> num_processed{0};
+        // The calling thread runs the first range, so the workers must still
+        // be joined before the exception leaves ParallelFor
+        REQUIRE_THROWS_AS(::math::parallel::ParallelFor(
+                              1000,
+                              [&](size_t begin, size_t end) {
+                                  if (begin == 0) {
+                                      throw std::runtime_error("first range");
+                                  }
+                                  num_processed += end - begin;
+                              },
+                              100),
+                          std::runtime_error);
+        REQUIRE(num_processed.load() == 750);
+    }
+
+    SECTION("Batch functions over the ranges") {
+        using T = ::math::float64_t;
+        using Pose = ::math::Pose3d<T>;
+        constexpr size_t NUM_POSES = 5000;
+        constexpr T EPSILON = static_cast<T>(1e-10);
+
+        auto positions = ::math::random_vec3_array<T>(NUM_POSES);
+        auto rotations = ::math::random_unit_quat_array<T>(NUM_POSES);
+        std::vector<Pose> poses(NUM_POSES);
+        for (size_t i = 0; i < NUM_POSES; ++i) {
+            poses[i] = Pose(positions[i], rotations[i]);
+        }
+        std::vector<Pose> serial(NUM_POSES), threaded(NUM_POSES);
+        ::math::composePoses(poses.data(), poses.data(), serial.data(),
+                             NUM_POSES);
+
+        ::math::parallel::ScopedNumThreads guard(4);
+        ::math::parallel::ParallelFor(
+            NUM_POSES,
+            [&](size_t begin, size_t end) {
+                ::math::composePoses(poses.data() + begin, poses.data() + begin,
+                                     threaded.data() + begin, end - begin);
+            },
+            256);
+        for (size_t i = 0; i < NUM_POSES; ++i) {
+            const auto& expected = serial[i];
+            REQUIRE(::math::func_all_close<T>(
+                threaded[i].position, expected.position.x(),
+                expected.position.y(), expected.position.z(), EPSILON));
+            REQUIRE(::math::func_all_close<T>(
+                threaded[i].orientation, expected.orientation.w(),
+                expected.orientation.x(), expected.orientation.y(),
+                expected.orientation.z(), EPSILON));
+        }
+    }
+}
+
+#if defined(__clang__)
+#pragma clang diagnostic pop  // NOLINT
+#elif defined(__GNUC__)
+#pragma GCC diagnostic pop
+#elif defined(_MSC_VER)
+#pragma warning(pop)
+#endif
@@ -5,6 +5,7 @@
 #include <math/pose3d_t.hpp>
 
 #include "./common_math_generators.hpp"
+#include "./common_math_helpers.hpp"
 
 #if defined(__clang__)
 #pragma clang diagnostic push
@@ -155,6 +156,77 @@ TEMPLATE_TEST_CASE("Pose3d class (pose3d_t) API", "[pose3d_t][template]",
         }
     }
 
+    SECTION("'Apply' method (transform an array of vec3)") {
+        constexpr size_t NUM_VECTORS = 43;
+        auto position = GENERATE(take(4, ::math::random_vec3<T>()));
+        auto orientation = GENERATE(take(4, ::math::random_quaternion<T>()));
+
+        Pose X(position, orientation);  // NOLINT
+        auto points = ::math::random_vec3_array<T>(NUM_VECTORS);
+        std::vector<Vec3> results(NUM_VECTORS);
+        for (const auto isa : ::math::dispatch::GetSupportedIsas()) {
+            ::math::dispatch::ScopedIsa guard(isa);
+            X.apply(points.data(), results.data(), NUM_VECTORS);
+            for (size_t i = 0; i < NUM_VECTORS; ++i) {
+                REQUIRE(results[i] == X.apply(points[i]));
+            }
+        }
+    }
+
+    SECTION("Compose and invert arrays of poses") {
+        constexpr size_t NUM_POSES = 19;
+        std::vector<Pose> lhs;
+        std::vector<Pose> rhs;
+        auto gen_pos = ::math::random_vec3<T>();
+        auto gen_quat = ::math::random_quaternion<T>();
+        for (size_t i = 0; i < 2 * NUM_POSES; ++i) {
+            auto& poses = (i < NUM_POSES) ? lhs : rhs;
+            gen_pos.next();
+            gen_quat.next();
+            poses.emplace_back(gen_pos.get(), gen_quat.get());
+        }
+
+        for (const auto isa : ::math::dispatch::GetSupportedIsas()) {
+            ::math::dispatch::ScopedIsa guard(isa);
+            std::vector<Pose> composed(NUM_POSES);
+            std::vector<Pose> inverted(NUM_POSES);
+            ::math::composePoses(lhs.data(), rhs.data(), composed.data(),
+                                 NUM_POSES);
+            ::math::invertPoses(lhs.data(), inverted.data(), NUM_POSES);
+            for (size_t i = 0; i < NUM_POSES; ++i) {
+                auto expected = lhs[i] * rhs[i];
+                REQUIRE(composed[i].position == expected.position);
+                REQUIRE(composed[i].orientation == expected.orientation);
+                auto expected_inv = lhs[i].inverse();
+                REQUIRE(inverted[i].position == expected_inv.position);
+                REQUIRE(inverted[i].orientation == expected_inv.orientation);
+            }
+
+            // Skipping the renormalization only changes the rounding errors,
+            // e.g. when renormalizing once every few steps of a chain
+            constexpr size_t RENORMALIZE_EVERY = 4;
+            std::vector<Pose> chained = lhs;
+            std::vector<Pose> chained_normalized = lhs;
+            for (size_t step = 1; step <= 2 * RENORMALIZE_EVERY; ++step) {
+                ::math::composePoses(chained.data(), rhs.data(),
+                                     chained.data(), NUM_POSES,
+                                     step % RENORMALIZE_EVERY == 0);
+                ::math::composePoses(chained_normalized.data(), rhs.data(),
+                                     chained_normalized.data(), NUM_POSES);
+            }
+            constexpr T EPSILON = static_cast<T>(1e-4);
+            for (size_t i = 0; i < NUM_POSES; ++i) {
+                const auto& pos = chained_normalized[i].position;
+                const auto& quat = chained_normalized[i].orientation;
+                REQUIRE(::math::func_all_close<T>(chained[i].position, pos.x(),
+                                                  pos.y(), pos.z(), EPSILON));
+                REQUIRE(::math::func_all_close<T>(chained[i].orientation,
+                                                  quat.w(), quat.x(), quat.y(),
+                                                  quat.z(), EPSILON));
+            }
+        }
+    }
+
     SECTION("'Inverse' method (inverts the transform)") {
         // X of A in W = {pos=(0.0, 3.0, 0.0), rot=quat_rot_x(PI / 2)}
         // X of W in A = (pos=(0.0, 0.0, 3.0), rot=quat_rot_x(-PI / 2))
@@ -0,0 +1,165 @@
+#include <catch2/catch.hpp>
+#include <math/mat3_t.hpp>
+#include <math/quat_t.hpp>
+
+#include "./common_math_helpers.hpp"
+#include "./common_math_generators.hpp"
+
+#if defined(__clang__)
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wimplicit-float-conversion"
+#pragma clang diagnostic ignored "-Wdouble-promotion"
+#elif defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wfloat-conversion"
+#pragma GCC diagnostic ignored "-Wdouble-promotion"
+#elif defined(_MSC_VER)
+#pragma warning(push)
+#pragma warning(disable : 4305)
+#pragma warning(disable : 4244)
+#endif
+
+constexpr double USER_EPSILON = 1e-5;
+
+// NOLINTNEXTLINE
+TEMPLATE_TEST_CASE("Quaternion class (quat_t) batch conversions",
+                   "[quat_t][batch]", ::math::float32_t, ::math::float64_t) {
+    using T = TestType;
+    using Quat = ::math::Quaternion<T>;
+    using Mat3 = ::math::Matrix3<T>;
+    using Euler = ::math::Euler<T>;
+
+    constexpr T EPSILON = static_cast<T>(USER_EPSILON);
+    constexpr T PI = static_cast<T>(::math::PI);
+
+    // Not a multiple of any register width, so we also test the remainders
+    constexpr size_t NUM_ROTATIONS = 37;
+
+    SECTION("From Euler angles, for every order") {
+        auto angles = ::math::random_vec3_array<T>(NUM_ROTATIONS, -PI, PI);
+        for (const auto isa : ::math::dispatch::GetSupportedIsas()) {
+            ::math::dispatch::ScopedIsa guard(isa);
+            INFO("isa: " << ::math::dispatch::ToString(isa));
+            for (auto order :
+                 {::math::euler::Order::XYZ, ::math::euler::Order::YZX,
+                  ::math::euler::Order::ZXY, ::math::euler::Order::XZY,
+                  ::math::euler::Order::YXZ, ::math::euler::Order::ZYX}) {
+                INFO("order: " << ::math::euler::ToString(order));
+                std::vector<Quat> quats(NUM_ROTATIONS);
+                std::vector<Quat> quats_fast(NUM_ROTATIONS);
+                ::math::quaternionsFromEuler<T>(angles.data(), order,
+                                                quats.data(), NUM_ROTATIONS);
+                ::math::quaternionsFromEuler<T>(
+                    angles.data(), order, quats_fast.data(), NUM_ROTATIONS,
+                    ::math::fast::Accuracy::FAST);
+                for (size_t i = 0; i < NUM_ROTATIONS; ++i) {
+                    INFO("i: " << i);
+                    Quat expected(Euler(angles[i].x(), angles[i].y(),
+                                        angles[i].z(), order));
+                    REQUIRE(::math::func_all_close<T>(
+                        quats[i], expected.w(), expected.x(), expected.y(),
+                        expected.z(), EPSILON));
+                    REQUIRE(::math::func_all_close<T>(
+                        quats_fast[i], expected.w(), expected.x(), expected.y(),
+                        expected.z(), EPSILON));
+                }
+            }
+        }
+    }
+
+    SECTION("From Euler angles, YXZ round-trip") {
+        // Intrinsic YXZ is Ry * Rx * Rz, and the angles can be recovered back
+        // from it while x stays away from the gimbal-lock at +-pi/2
+        auto angles = ::math::random_vec3_array<T>(NUM_ROTATIONS, -PI, PI);
+        for (auto& angle : angles) {
+            angle.x() *= static_cast<T>(0.45);
+        }
+        for (const auto isa : ::math::dispatch::GetSupportedIsas()) {
+            ::math::dispatch::ScopedIsa guard(isa);
+            INFO("isa: " << ::math::dispatch::ToString(isa));
+            std::vector<Quat> quats(NUM_ROTATIONS);
+            ::math::quaternionsFromEuler<T>(angles.data(),
+                                            ::math::euler::Order::YXZ,
+                                            quats.data(), NUM_ROTATIONS);
+            for (size_t i = 0; i < NUM_ROTATIONS; ++i) {
+                INFO("i: " << i);
+                const Mat3 expected = Mat3::RotationY(angles[i].y()) *
+                                      Mat3::RotationX(angles[i].x()) *
+                                      Mat3::RotationZ(angles[i].z());
+                const Mat3 result(quats[i]);
+                // clang-format off
+                REQUIRE(::math::func_all_close<T>(result,
+                    expected(0, 0), expected(0, 1), expected(0, 2),
+                    expected(1, 0), expected(1, 1), expected(1, 2),
+                    expected(2, 0), expected(2, 1), expected(2, 2), EPSILON));
+                // clang-format on
+                const Euler recovered(result, ::math::euler::Order::YXZ);
+                REQUIRE(std::abs(recovered.x - angles[i].x()) < EPSILON);
+                REQUIRE(std::abs(recovered.y - angles[i].y()) < EPSILON);
+                REQUIRE(std::abs(recovered.z - angles[i].z()) < EPSILON);
+            }
+        }
+    }
+
+    // Random rotations, plus the ones that take each of the four branches of
+    // Quaternion::setFromRotationMatrix
+    auto quats = ::math::random_unit_quat_array<T>(NUM_ROTATIONS);
+    quats[0] = Quat();
+    quats[1] = Quat::RotationX(PI);
+    quats[2] = Quat::RotationY(PI);
+    quats[3] = Quat::RotationZ(PI);
+    quats[4] = Quat::RotationZ(static_cast<T>(0.9) * PI);
+
+    SECTION("From rotation matrices") {
+        std::vector<Mat3> mats(NUM_ROTATIONS);
+        for (size_t i = 0; i < NUM_ROTATIONS; ++i) {
+            mats[i] = Mat3(quats[i]);
+        }
+        for (const auto isa : ::math::dispatch::GetSupportedIsas()) {
+            ::math::dispatch::ScopedIsa guard(isa);
+            INFO("isa: " << ::math::dispatch::ToString(isa));
+            std::vector<Quat> results(NUM_ROTATIONS);
+            ::math::quaternionsFromRotationMatrices<T>(
+                mats.data(), results.data(), NUM_ROTATIONS);
+            for (size_t i = 0; i < NUM_ROTATIONS; ++i) {
+                INFO("i: " << i);
+                Quat expected(mats[i]);
+                REQUIRE(::math::func_all_close<T>(results[i], expected.w(),
+                                                  expected.x(), expected.y(),
+                                                  expected.z(), EPSILON));
+            }
+        }
+    }
+
+    SECTION("To rotation matrices") {
+        // The quaternions don't need to be normalized
+        auto scaled = quats;
+        scaled[5] = Quat(2 * quats[5].w(), 2 * quats[5].x(), 2 * quats[5].y(),
+                         2 * quats[5].z());
+        for (const auto isa : ::math::dispatch::GetSupportedIsas()) {
+            ::math::dispatch::ScopedIsa guard(isa);
+            INFO("isa: " << ::math::dispatch::ToString(isa));
+            std::vector<Mat3> results(NUM_ROTATIONS);
+            ::math::rotationMatricesFromQuaternions<T>(
+                scaled.data(), results.data(), NUM_ROTATIONS);
+            for (size_t i = 0; i < NUM_ROTATIONS; ++i) {
+                INFO("i: " << i);
+                Mat3 expected(quats[i]);
+                // clang-format off
+                REQUIRE(::math::func_all_close<T>(results[i],
+                    expected(0, 0), expected(0, 1), expected(0, 2),
+                    expected(1, 0), expected(1, 1), expected(1, 2),
+                    expected(2, 0), expected(2, 1), expected(2, 2), EPSILON));
+                // clang-format on
+            }
+        }
+    }
+}
+
+#if defined(__clang__)
+#pragma clang diagnostic pop  // NOLINT
+#elif defined(__GNUC__)
+#pragma GCC diagnostic pop
+#elif defined(_MSC_VER)
+#pragma warning(pop)
+#endif
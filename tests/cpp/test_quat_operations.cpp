@@ -218,6 +218,71 @@ TEMPLATE_TEST_CASE("Quaternion class (quat_t) core Operations", "[quat_t][ops]",
         REQUIRE(vec_k == ::math::rotate<T>(q_x, vec_j));
         REQUIRE(vec_i == ::math::rotate<T>(q_y, vec_k));
     }
+
+    SECTION("Quaternion rotation matches q * p * q^-1") {
+        constexpr auto NUM_SAMPLES = 10;
+        // Quaternions aren't normalized (the rotation should still be valid)
+        auto q = GENERATE(take(NUM_SAMPLES, ::math::random_quaternion<T>()));
+        auto v = GENERATE(take(NUM_SAMPLES, ::math::random_vec3<T>()));
+
+        Quat q_p(0.0, v.x(), v.y(), v.z());
+        auto q_result = (q * q_p) * ::math::inverse<T>(q);
+        auto v_rotated = ::math::rotate<T>(q, v);
+        REQUIRE(::math::func_all_close<T>(v_rotated, q_result.x(),
+                                          q_result.y(), q_result.z(), EPSILON));
+    }
+}
+
+// NOLINTNEXTLINE
+TEMPLATE_TEST_CASE("Quaternion class (quat_t) batch rotations",
+                   "[quat_t][batch]", ::math::float32_t, ::math::float64_t) {
+    using T = TestType;
+    using Vec3 = ::math::Vector3<T>;
+    using Vec3Batch = ::math::Vector3Batch<T>;
+
+    constexpr T EPSILON = static_cast<T>(USER_EPSILON);
+
+    // Not a multiple of any register width (nor of the unrolled loops)
+    constexpr size_t NUM_VECTORS = 43;
+    constexpr auto NUM_SAMPLES = 4;
+
+    auto q = GENERATE(take(NUM_SAMPLES, ::math::random_quaternion<T>()));
+    auto vecs = ::math::random_vec3_array<T>(NUM_VECTORS);
+
+    std::vector<Vec3> expected(NUM_VECTORS);
+    for (size_t i = 0; i < NUM_VECTORS; ++i) {
+        expected[i] = ::math::rotate<T>(q, vecs[i]);
+    }
+
+    SECTION("Rotate an array of vectors") {
+        for (const auto isa : ::math::dispatch::GetSupportedIsas()) {
+            ::math::dispatch::ScopedIsa guard(isa);
+            INFO("isa: " << ::math::dispatch::ToString(isa));
+            std::vector<Vec3> rotated(NUM_VECTORS);
+            ::math::rotate<T>(q, vecs.data(), rotated.data(), NUM_VECTORS);
+            for (size_t i = 0; i < NUM_VECTORS; ++i) {
+                REQUIRE(::math::func_all_close<T>(rotated[i], expected[i].x(),
+                                                  expected[i].y(),
+                                                  expected[i].z(), EPSILON));
+            }
+        }
+    }
+
+    SECTION("Rotate a batch of vectors") {
+        for (const auto isa : ::math::dispatch::GetSupportedIsas()) {
+            ::math::dispatch::ScopedIsa guard(isa);
+            INFO("isa: " << ::math::dispatch::ToString(isa));
+            Vec3Batch batch(vecs);
+            Vec3Batch rotated;
+            ::math::rotate<T>(q, batch, rotated);
+            REQUIRE(rotated.size() == NUM_VECTORS);
+            for (size_t i = 0; i < NUM_VECTORS; ++i) {
+                REQUIRE(::math::func_all_close<T>(rotated[i], expected[i].x(),
+                                                  expected[i].y(),
+                                                  expected[i].z(), EPSILON));
+            }
+        }
+    }
 }
 
 #if defined(__clang__)
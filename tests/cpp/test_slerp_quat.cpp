@@ -0,0 +1,189 @@
+#include <catch2/catch.hpp>
+#include <math/quat_t.hpp>
+
+#include "./common_math_helpers.hpp"
+#include "./common_math_generators.hpp"
+
+#if defined(__clang__)
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wimplicit-float-conversion"
+#pragma clang diagnostic ignored "-Wdouble-promotion"
+#elif defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wfloat-conversion"
+#pragma GCC diagnostic ignored "-Wdouble-promotion"
+#elif defined(_MSC_VER)
+#pragma warning(push)
+#pragma warning(disable : 4305)
+#pragma warning(disable : 4244)
+#endif
+
+// NOLINTNEXTLINE
+TEMPLATE_TEST_CASE("Slerp and nlerp functions for quat_t", "[quat_t][slerp]",
+                   ::math::float32_t, ::math::float64_t) {
+    using T = TestType;
+    using Quat = ::math::Quaternion<T>;
+
+    constexpr T EPSILON = static_cast<T>(1e-5);
+    constexpr T ANGLE = static_cast<T>(1.2);
+
+    const auto q_start = Quat::RotationZ(0.0);
+    const auto q_end = Quat::RotationZ(ANGLE);
+
+    SECTION("Slerp keeps a constant angular velocity") {
+        for (T alpha : {0.0, 0.1, 0.25, 0.5, 0.75, 1.0}) {
+            auto q = ::math::slerp<T>(q_start, q_end, alpha);
+            auto expected = Quat::RotationZ(alpha * ANGLE);
+            REQUIRE(::math::func_all_close<T>(q, expected.w(), expected.x(),
+                                              expected.y(), expected.z(),
+                                              EPSILON));
+        }
+    }
+
+    SECTION("Slerp and nlerp take the shortest path") {
+        const Quat q_end_neg(-q_end.w(), -q_end.x(), -q_end.y(), -q_end.z());
+        for (T alpha : {0.0, 0.3, 0.5, 1.0}) {
+            auto q = ::math::slerp<T>(q_start, q_end_neg, alpha);
+            auto expected = ::math::slerp<T>(q_start, q_end, alpha);
+            REQUIRE(::math::func_all_close<T>(q, expected.w(), expected.x(),
+                                              expected.y(), expected.z(),
+                                              EPSILON));
+            auto q_n = ::math::nlerp<T>(q_start, q_end_neg, alpha);
+            auto expected_n = ::math::nlerp<T>(q_start, q_end, alpha);
+            REQUIRE(::math::func_all_close<T>(q_n, expected_n.w(),
+                                              expected_n.x(), expected_n.y(),
+                                              expected_n.z(), EPSILON));
+        }
+    }
+
+    SECTION("Nlerp returns unit quaternions along the same path") {
+        // Both agree at the endpoints and at the midpoint (by symmetry)
+        for (T alpha : {0.0, 0.5, 1.0}) {
+            auto q = ::math::nlerp<T>(q_start, q_end, alpha);
+            auto expected = Quat::RotationZ(alpha * ANGLE);
+            REQUIRE(::math::func_all_close<T>(q, expected.w(), expected.x(),
+                                              expected.y(), expected.z(),
+                                              EPSILON));
+        }
+        auto q = ::math::nlerp<T>(q_start, q_end, 0.2);
+        REQUIRE(::math::func_value_close<T>(q.length(), 1.0, EPSILON));
+    }
+
+    SECTION("Slerp between the same quaternion") {
+        auto q = ::math::slerp<T>(q_end, q_end, 0.3);
+        REQUIRE(::math::func_all_close<T>(q, q_end.w(), q_end.x(), q_end.y(),
+                                          q_end.z(), EPSILON));
+    }
+
+    SECTION("SlerpInterpolator") {
+        auto q_a = GENERATE(take(4, ::math::random_unit_quaternion<T>()));
+        auto q_b = GENERATE(take(4, ::math::random_unit_quaternion<T>()));
+        ::math::SlerpInterpolator<T> interpolator(q_a, q_b);
+        REQUIRE(interpolator.angle() >= 0.0);
+        REQUIRE(interpolator.angle() <= 0.5 * ::math::PI + EPSILON);
+
+        constexpr size_t NUM_SAMPLES = 11;
+        T alphas[NUM_SAMPLES];
+        for (size_t i = 0; i < NUM_SAMPLES; ++i) {
+            alphas[i] = static_cast<T>(i) / static_cast<T>(NUM_SAMPLES - 1);
+        }
+        Quat samples[NUM_SAMPLES];
+        interpolator(alphas, samples, NUM_SAMPLES);
+        for (size_t i = 0; i < NUM_SAMPLES; ++i) {
+            auto expected = ::math::slerp<T>(q_a, q_b, alphas[i]);
+            REQUIRE(::math::func_all_close<T>(samples[i], expected.w(),
+                                              expected.x(), expected.y(),
+                                              expected.z(), EPSILON));
+            REQUIRE(::math::func_value_close<T>(samples[i].length(), 1.0,
+                                                EPSILON));
+        }
+        // Each step covers the same angle
+        const auto step_angle = interpolator.angle() / (NUM_SAMPLES - 1);
+        for (size_t i = 1; i < NUM_SAMPLES; ++i) {
+            auto cos_step = std::abs(::math::dot(samples[i - 1], samples[i]));
+            REQUIRE(::math::func_value_close<T>(cos_step, std::cos(step_angle),
+                                                EPSILON));
+        }
+    }
+}
+
+// NOLINTNEXTLINE
+TEMPLATE_TEST_CASE("Slerp and nlerp over arrays of quat_t", "[quat_t][slerp]",
+                   ::math::float32_t, ::math::float64_t) {
+    using T = TestType;
+    using Quat = ::math::Quaternion<T>;
+
+    // Error bound of the polynomial approximations used by the batch kernels
+    constexpr T EPSILON = static_cast<T>(
+        std::is_same<T, ::math::float32_t>::value ? 2e-6 : 1e-7);
+    constexpr T ALPHA = static_cast<T>(0.35);
+
+    // Not a multiple of any register width, so we also test the remainders
+    constexpr size_t NUM_QUATS = 37;
+
+    auto quats_a = ::math::random_unit_quat_array<T>(NUM_QUATS);
+    auto quats_b = ::math::random_unit_quat_array<T>(NUM_QUATS);
+    auto alphas = ::math::random_scalar_array<T>(NUM_QUATS);
+    // Include the edge cases of the same quaternion, and of the same rotation
+    quats_b[3] = quats_a[3];
+    quats_b[4] = Quat(-quats_a[4].w(), -quats_a[4].x(), -quats_a[4].y(),
+                      -quats_a[4].z());
+    alphas[5] = 0.0;
+    alphas[6] = 1.0;
+
+    for (const auto isa : ::math::dispatch::GetSupportedIsas()) {
+        ::math::dispatch::ScopedIsa guard(isa);
+        INFO("isa: " << ::math::dispatch::ToString(isa));
+        std::vector<Quat> slerps(NUM_QUATS);
+        std::vector<Quat> slerps_each(NUM_QUATS);
+        std::vector<Quat> nlerps(NUM_QUATS);
+        std::vector<Quat> nlerps_each(NUM_QUATS);
+        ::math::slerp(quats_a.data(), quats_b.data(), ALPHA, slerps.data(),
+                      NUM_QUATS);
+        ::math::slerp(quats_a.data(), quats_b.data(), alphas.data(),
+                      slerps_each.data(), NUM_QUATS);
+        ::math::nlerp(quats_a.data(), quats_b.data(), ALPHA, nlerps.data(),
+                      NUM_QUATS);
+        ::math::nlerp(quats_a.data(), quats_b.data(), alphas.data(),
+                      nlerps_each.data(), NUM_QUATS);
+        for (size_t i = 0; i < NUM_QUATS; ++i) {
+            INFO("i: " << i);
+            auto expected = ::math::slerp(quats_a[i], quats_b[i], ALPHA);
+            auto expected_each =
+                ::math::slerp(quats_a[i], quats_b[i], alphas[i]);
+            auto expected_n = ::math::nlerp(quats_a[i], quats_b[i], ALPHA);
+            auto expected_n_each =
+                ::math::nlerp(quats_a[i], quats_b[i], alphas[i]);
+            REQUIRE(::math::func_all_close<T>(slerps[i], expected.w(),
+                                              expected.x(), expected.y(),
+                                              expected.z(), EPSILON));
+            REQUIRE(::math::func_all_close<T>(
+                slerps_each[i], expected_each.w(), expected_each.x(),
+                expected_each.y(), expected_each.z(), EPSILON));
+            REQUIRE(::math::func_all_close<T>(nlerps[i], expected_n.w(),
+                                              expected_n.x(), expected_n.y(),
+                                              expected_n.z(), EPSILON));
+            REQUIRE(::math::func_all_close<T>(
+                nlerps_each[i], expected_n_each.w(), expected_n_each.x(),
+                expected_n_each.y(), expected_n_each.z(), EPSILON));
+        }
+
+        // The results can be written over the inputs
+        auto quats_c = quats_a;
+        ::math::slerp(quats_c.data(), quats_b.data(), ALPHA, quats_c.data(),
+                      NUM_QUATS);
+        for (size_t i = 0; i < NUM_QUATS; ++i) {
+            REQUIRE(::math::func_all_close<T>(quats_c[i], slerps[i].w(),
+                                              slerps[i].x(), slerps[i].y(),
+                                              slerps[i].z(), EPSILON));
+        }
+    }
+}
+
+#if defined(__clang__)
+#pragma clang diagnostic pop  // NOLINT
+#elif defined(__GNUC__)
+#pragma GCC diagnostic pop
+#elif defined(_MSC_VER)
+#pragma warning(pop)
+#endif
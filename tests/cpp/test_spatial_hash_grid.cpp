@@ -0,0 +1,191 @@
+#include <catch2/catch.hpp>
+#include <math/utils/spatial_hash_grid.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <utility>
+#include <vector>
+
+#if defined(__clang__)
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wimplicit-float-conversion"
+#pragma clang diagnostic ignored "-Wdouble-promotion"
+#elif defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wfloat-conversion"
+#pragma GCC diagnostic ignored "-Wdouble-promotion"
+#elif defined(_MSC_VER)
+#pragma warning(push)
+#pragma warning(disable : 4305)
+#pragma warning(disable : 4244)
+#endif
+
+// Returns a sorted copy of the given results (the queries have no given order)
+template <typename Container>
+auto sorted_results(Container values) -> Container {
+    std::sort(values.begin(), values.end());
+    return values;
+}
+
+TEMPLATE_TEST_CASE("Spatial hash grid [SpatialHashGrid]",
+                   "[spatial_hash_grid][geometric]", ::math::float32_t,
+                   ::math::float64_t) {
+    using T = TestType;
+    using Vec3 = ::math::Vector3<T>;
+    using Grid = ::math::SpatialHashGrid<T>;
+    using Pair = std::pair<size_t, size_t>;
+
+    constexpr size_t NUM_POINTS = 2000;
+
+    std::minstd_rand gen(std::random_device{}());  // NOLINT
+    std::uniform_real_distribution<T> dist_pos(-10.0, 10.0);
+    std::vector<Vec3> points(NUM_POINTS);
+    for (auto& point : points) {
+        point = Vec3(dist_pos(gen), dist_pos(gen), dist_pos(gen));
+    }
+
+    // Brute-force versions of the queries, used as reference
+    auto brute_radius = [&points](const Vec3& center, T radius) {
+        std::vector<size_t> hits;
+        for (size_t i = 0; i < points.size(); ++i) {
+            if ((points[i] - center).lengthSquare() <= radius * radius) {
+                hits.push_back(i);
+            }
+        }
+        return hits;
+    };
+    auto brute_knearest = [&points](const Vec3& point, size_t k) {
+        std::vector<std::pair<T, size_t>> candidates(points.size());
+        for (size_t i = 0; i < points.size(); ++i) {
+            candidates[i] = {(points[i] - point).lengthSquare(), i};
+        }
+        std::sort(candidates.begin(), candidates.end());
+        std::vector<size_t> indices;
+        for (size_t i = 0; i < std::min(k, candidates.size()); ++i) {
+            indices.push_back(candidates[i].second);
+        }
+        return indices;
+    };
+    auto brute_pairs = [&points](T radius) {
+        std::vector<Pair> pairs;
+        for (size_t i = 0; i < points.size(); ++i) {
+            for (size_t j = i + 1; j < points.size(); ++j) {
+                if ((points[i] - points[j]).lengthSquare() <= radius * radius) {
+                    pairs.emplace_back(i, j);
+                }
+            }
+        }
+        return pairs;
+    };
+
+    SECTION("Empty grid") {
+        Grid grid(points.data(), 0, 1.0);
+        REQUIRE(grid.empty());
+        REQUIRE(grid.queryRadius(Vec3(0.0, 0.0, 0.0), 5.0).empty());
+        REQUIRE(grid.queryKNearest(Vec3(0.0, 0.0, 0.0), 3).empty());
+        REQUIRE(grid.queryPairs(5.0).empty());
+    }
+
+    SECTION("Build over random points") {
+        Grid grid(points, 1.0);
+        REQUIRE(grid.size() == NUM_POINTS);
+        REQUIRE(grid.cellSize() == 1.0);
+        REQUIRE(grid.numBuckets() >= NUM_POINTS);
+        // Every point is stored exactly once
+        std::vector<size_t> indices(grid.indices().begin(),
+                                    grid.indices().end());
+        REQUIRE(sorted_results(indices).back() == NUM_POINTS - 1);
+        REQUIRE(std::unique(indices.begin(), indices.end()) == indices.end());
+    }
+
+    SECTION("Radius queries") {
+        // Radii smaller and larger than the cells, and queries outside
+        Grid grid(points, 1.0);
+        for (const T radius : {0.0, 0.3, 1.0, 2.5, 40.0}) {
+            for (size_t q = 0; q < 50; ++q) {
+                const Vec3 center(1.5 * dist_pos(gen), dist_pos(gen),
+                                  dist_pos(gen));
+                REQUIRE(sorted_results(grid.queryRadius(center, radius)) ==
+                        brute_radius(center, radius));
+            }
+        }
+        // The distances reported are the ones to the given points
+        const Vec3 center(1.0, 2.0, 3.0);
+        grid.queryRadius(center, 3.0, [&](size_t index, T dist_sq) {
+            REQUIRE(dist_sq == (points[index] - center).lengthSquare());
+        });
+        // A query at a point of the grid finds at least the point itself
+        REQUIRE(!grid.queryRadius(points[7], 0.0).empty());
+    }
+
+    SECTION("K-nearest queries") {
+        Grid grid(points, 0.5);
+        for (const size_t k : {1, 5, 32}) {
+            for (size_t q = 0; q < 50; ++q) {
+                // Some of the points are far away from all the cells
+                const Vec3 point(3.0 * dist_pos(gen), dist_pos(gen),
+                                 dist_pos(gen));
+                REQUIRE(grid.queryKNearest(point, k) ==
+                        brute_knearest(point, k));
+            }
+        }
+        REQUIRE(grid.queryKNearest(points[3], 1) == std::vector<size_t>{3});
+        REQUIRE(grid.queryKNearest(points[0], 0).empty());
+        REQUIRE(grid.queryKNearest(points[0], 2 * NUM_POINTS).size() ==
+                NUM_POINTS);
+    }
+
+    SECTION("Pair queries") {
+        Grid grid(points, 1.0);
+        for (const T radius : {0.5, 1.0, 1.7}) {
+            REQUIRE(sorted_results(grid.queryPairs(radius)) ==
+                    brute_pairs(radius));
+            std::vector<Pair> pairs;
+            grid.queryPairs(radius, [&pairs](size_t i, size_t j) {
+                pairs.emplace_back(i, j);
+            });
+            REQUIRE(sorted_results(pairs) == brute_pairs(radius));
+        }
+    }
+
+    SECTION("Parallel build and queries") {
+        const Grid serial(points, 1.0);
+        std::vector<Vec3> many_points(20 * NUM_POINTS);
+        for (auto& point : many_points) {
+            point = Vec3(dist_pos(gen), dist_pos(gen), dist_pos(gen));
+        }
+        const Grid serial_many(many_points, 0.5);
+
+        ::math::parallel::ScopedNumThreads guard(4);
+        const Grid threaded(points, 1.0);
+        const Grid threaded_many(many_points, 0.5);
+        // The same grid regardless of the number of threads
+        REQUIRE(threaded.indices() == serial.indices());
+        REQUIRE(threaded_many.indices() == serial_many.indices());
+        REQUIRE(sorted_results(threaded_many.queryPairs(0.2)) ==
+                sorted_results(serial_many.queryPairs(0.2)));
+        REQUIRE(sorted_results(threaded.queryPairs(1.0)) == brute_pairs(1.0));
+    }
+
+    SECTION("Coincident and distant points") {
+        std::vector<Vec3> clustered(100, Vec3(1.0, 1.0, 1.0));
+        clustered.emplace_back(1e6, -1e6, 1e6);
+        clustered.emplace_back(-1e15, 0.0, 0.0);
+        Grid grid(clustered, 0.1);
+        REQUIRE(grid.queryRadius(Vec3(1.0, 1.0, 1.0), 0.0).size() == 100);
+        REQUIRE(grid.queryPairs(0.0).size() == 100 * 99 / 2);
+        REQUIRE(grid.queryKNearest(Vec3(2e6, -2e6, 2e6), 1) ==
+                std::vector<size_t>{100});
+        REQUIRE(grid.queryKNearest(Vec3(-1e16, 0.0, 0.0), 1) ==
+                std::vector<size_t>{101});
+    }
+}
+
+#if defined(__clang__)
+#pragma clang diagnostic pop
+#elif defined(__GNUC__)
+#pragma GCC diagnostic pop
+#elif defined(_MSC_VER)
+#pragma warning(pop)
+#endif
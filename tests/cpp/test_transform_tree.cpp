@@ -0,0 +1,160 @@
+#include <vector>
+
+#include <catch2/catch.hpp>
+#include <math/transform_tree_t.hpp>
+
+#include "./common_math_helpers.hpp"
+#include "./common_math_generators.hpp"
+
+#if defined(__clang__)
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wimplicit-float-conversion"
+#pragma clang diagnostic ignored "-Wdouble-promotion"
+#elif defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wfloat-conversion"
+#pragma GCC diagnostic ignored "-Wdouble-promotion"
+#elif defined(_MSC_VER)
+#pragma warning(push)
+#pragma warning(disable : 4305)
+#pragma warning(disable : 4244)
+#endif
+
+constexpr double USER_EPSILON = 1e-4;
+
+// Computes the world poses of the tree by walking up to the root of each node
+template <typename T>
+auto naive_world_poses(const ::math::TransformTree<T>& tree)
+    -> std::vector<::math::Pose3d<T>> {
+    std::vector<::math::Pose3d<T>> worlds(tree.size());
+    for (size_t i = 0; i < tree.size(); ++i) {
+        auto pose = tree.local(i);
+        auto parent = tree.parent(i);
+        while (parent != ::math::TransformTree<T>::NO_PARENT) {
+            pose = tree.local(static_cast<size_t>(parent)) * pose;
+            parent = tree.parent(static_cast<size_t>(parent));
+        }
+        worlds[i] = pose;
+    }
+    return worlds;
+}
+
+template <typename T>
+auto func_tree_matches(const ::math::TransformTree<T>& tree) -> bool {
+    constexpr T EPSILON = static_cast<T>(USER_EPSILON);
+    auto expected = naive_world_poses(tree);
+    for (size_t i = 0; i < tree.size(); ++i) {
+        const auto& pos = expected[i].position;
+        const auto& quat = expected[i].orientation;
+        if (!::math::func_all_close<T>(tree.world(i).position, pos.x(),
+                                       pos.y(), pos.z(), EPSILON) ||
+            !::math::func_all_close<T>(tree.world(i).orientation, quat.w(),
+                                       quat.x(), quat.y(), quat.z(),
+                                       EPSILON)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// NOLINTNEXTLINE
+TEMPLATE_TEST_CASE("TransformTree class (transform_tree_t)",
+                   "[transform_tree_t][template]", ::math::float32_t,
+                   ::math::float64_t) {
+    using T = TestType;
+    using Pose = ::math::Pose3d<T>;
+    using TransformTree = ::math::TransformTree<T>;
+
+    auto gen_pos = ::math::random_vec3<T>();
+    auto gen_quat = ::math::random_quaternion<T>();
+    auto random_pose = [&]() -> Pose {
+        gen_pos.next();
+        gen_quat.next();
+        return Pose(gen_pos.get(), gen_quat.get());
+    };
+
+    // Two roots, with a wide last level (so it gets split across threads)
+    const std::vector<size_t> LEVEL_SIZES = {2, 5, 40, 3 * 1024};
+    TransformTree tree;
+    size_t parent_begin = 0;
+    size_t parent_count = 0;
+    for (const auto level_size : LEVEL_SIZES) {
+        const size_t level_begin = tree.size();
+        for (size_t i = 0; i < level_size; ++i) {
+            auto parent = (parent_count == 0)
+                              ? TransformTree::NO_PARENT
+                              : static_cast<int32_t>(parent_begin +
+                                                     (i * 7) % parent_count);
+            tree.addNode(parent, random_pose());
+        }
+        parent_begin = level_begin;
+        parent_count = level_size;
+    }
+
+    SECTION("Tree structure (BFS order)") {
+        REQUIRE(tree.numLevels() == LEVEL_SIZES.size());
+        for (size_t level = 0; level < tree.numLevels(); ++level) {
+            REQUIRE(tree.levelEnd(level) - tree.levelBegin(level) ==
+                    LEVEL_SIZES[level]);
+            for (auto i = tree.levelBegin(level); i < tree.levelEnd(level);
+                 ++i) {
+                REQUIRE(tree.depth(i) == level);
+                REQUIRE(tree.isDirty(i));
+            }
+        }
+    }
+
+    SECTION("Nodes that would break the BFS order are rejected") {
+        const size_t num_nodes = tree.size();
+        const auto invalid = TransformTree::INVALID_NODE;
+        // A root, or a child of a node above the last level
+        REQUIRE(tree.addNode(TransformTree::NO_PARENT) == invalid);
+        REQUIRE(tree.addNode(static_cast<int32_t>(tree.levelBegin(1))) ==
+                invalid);
+        // Parents that aren't in the tree
+        REQUIRE(tree.addNode(static_cast<int32_t>(num_nodes)) == invalid);
+        REQUIRE(tree.addNode(-2) == invalid);
+        REQUIRE(tree.size() == num_nodes);
+        REQUIRE(tree.numLevels() == LEVEL_SIZES.size());
+        tree.update();
+        REQUIRE(func_tree_matches(tree));
+
+        // Children of the nodes of the last two levels are still accepted
+        const auto last = static_cast<int32_t>(num_nodes - 1);
+        REQUIRE(tree.addNode(static_cast<int32_t>(tree.levelBegin(2))) ==
+                num_nodes);
+        REQUIRE(tree.addNode(last) == num_nodes + 1);
+        REQUIRE(tree.numLevels() == LEVEL_SIZES.size() + 1);
+    }
+
+    SECTION("Full and incremental updates") {
+        for (const auto isa : ::math::dispatch::GetSupportedIsas()) {
+            ::math::dispatch::ScopedIsa guard(isa);
+            INFO("isa: " << ::math::dispatch::ToString(isa));
+            for (const size_t num_threads : {1, 4}) {
+                tree.markAllDirty();
+                tree.update(num_threads);
+                REQUIRE(func_tree_matches(tree));
+                REQUIRE_FALSE(tree.isDirty(tree.size() - 1));
+
+                // Only the subtree below the changed node should be dirty
+                const size_t changed = tree.levelBegin(1) + 2;
+                const auto old_world = tree.world(changed);
+                tree.setLocal(changed, random_pose());
+                REQUIRE(tree.isDirty(changed));
+                REQUIRE(tree.world(changed).position == old_world.position);
+                tree.update(num_threads);
+                REQUIRE_FALSE(tree.isDirty(changed));
+                REQUIRE(func_tree_matches(tree));
+            }
+        }
+    }
+}
+
+#if defined(__clang__)
+#pragma clang diagnostic pop  // NOLINT
+#elif defined(__GNUC__)
+#pragma GCC diagnostic pop
+#elif defined(_MSC_VER)
+#pragma warning(pop)
+#endif
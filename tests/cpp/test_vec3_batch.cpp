@@ -0,0 +1,252 @@
+#include <catch2/catch.hpp>
+#include <math/vec3_batch_t.hpp>
+
+#include "./common_math_helpers.hpp"
+#include "./common_math_generators.hpp"
+
+#if defined(__clang__)
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wimplicit-float-conversion"
+#pragma clang diagnostic ignored "-Wdouble-promotion"
+#elif defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wfloat-conversion"
+#pragma GCC diagnostic ignored "-Wdouble-promotion"
+#elif defined(_MSC_VER)
+#pragma warning(push)
+#pragma warning(disable : 4305)
+#pragma warning(disable : 4244)
+#endif
+
+constexpr double USER_RANGE_MIN = -1.0;
+constexpr double USER_RANGE_MAX = 1.0;
+constexpr double USER_EPSILON = 1e-4;
+
+// NOLINTNEXTLINE
+TEMPLATE_TEST_CASE("Vector3Batch class (vec3_batch_t) type", "[vec3_batch_t]",
+                   ::math::float32_t, ::math::float64_t) {
+    using T = TestType;
+    using Vector3 = ::math::Vector3<T>;
+    using Vector3Batch = ::math::Vector3Batch<T>;
+
+    SECTION("Default constructor") {
+        Vector3Batch batch;
+        REQUIRE(batch.size() == 0);
+        REQUIRE(batch.empty());
+    }
+
+    SECTION("Sized constructors") {
+        Vector3Batch batch(5);
+        REQUIRE(batch.size() == 5);
+        for (size_t i = 0; i < batch.size(); ++i) {
+            REQUIRE(batch[i] == Vector3(0.0, 0.0, 0.0));
+        }
+
+        Vector3Batch batch_filled(3, Vector3(1.0, 2.0, 3.0));
+        for (size_t i = 0; i < batch_filled.size(); ++i) {
+            REQUIRE(batch_filled[i] == Vector3(1.0, 2.0, 3.0));
+        }
+    }
+
+    SECTION("Planes are aligned and padded") {
+        Vector3Batch batch(13);
+        const auto align = static_cast<uintptr_t>(Vector3Batch::ALIGNMENT);
+        REQUIRE(batch.stride() >= batch.size());
+        REQUIRE(batch.stride() % Vector3Batch::PLANE_PADDING == 0);
+        REQUIRE(reinterpret_cast<uintptr_t>(batch.x()) % align == 0);
+        REQUIRE(reinterpret_cast<uintptr_t>(batch.y()) % align == 0);
+        REQUIRE(reinterpret_cast<uintptr_t>(batch.z()) % align == 0);
+    }
+
+    SECTION("Resize keeps the existing vectors") {
+        auto vecs = ::math::random_vec3_array<T>(10);
+        Vector3Batch batch(vecs);
+        batch.resize(100);
+        REQUIRE(batch.size() == 100);
+        for (size_t i = 0; i < vecs.size(); ++i) {
+            REQUIRE(batch[i] == vecs[i]);
+        }
+        for (size_t i = vecs.size(); i < batch.size(); ++i) {
+            REQUIRE(batch[i] == Vector3(0.0, 0.0, 0.0));
+        }
+        batch.resize(3);
+        batch.resize(6);
+        for (size_t i = 0; i < 3; ++i) {
+            REQUIRE(batch[i] == vecs[i]);
+        }
+        for (size_t i = 3; i < 6; ++i) {
+            REQUIRE(batch[i] == Vector3(0.0, 0.0, 0.0));
+        }
+    }
+
+    SECTION("Conversions from and to arrays of Vector3") {
+        for (const auto isa : ::math::dispatch::GetSupportedIsas()) {
+            ::math::dispatch::ScopedIsa guard(isa);
+            for (const size_t num : {0, 1, 7, 37}) {
+                auto vecs = ::math::random_vec3_array<T>(num);
+                Vector3Batch batch(vecs);
+                REQUIRE(batch.size() == num);
+                for (size_t i = 0; i < num; ++i) {
+                    REQUIRE(batch.get(i) == vecs[i]);
+                    REQUIRE(batch.x()[i] == vecs[i].x());
+                    REQUIRE(batch.y()[i] == vecs[i].y());
+                    REQUIRE(batch.z()[i] == vecs[i].z());
+                }
+                auto vecs_back = batch.toVector();
+                REQUIRE(vecs_back.size() == num);
+                for (size_t i = 0; i < num; ++i) {
+                    REQUIRE(vecs_back[i] == vecs[i]);
+                }
+            }
+        }
+    }
+}
+
+// NOLINTNEXTLINE
+TEMPLATE_TEST_CASE("Vector3Batch class (vec3_batch_t) core Operations",
+                   "[vec3_batch_t][ops]", ::math::float32_t,
+                   ::math::float64_t) {
+    using T = TestType;
+    using Vector3Batch = ::math::Vector3Batch<T>;
+
+    constexpr T EPSILON = static_cast<T>(USER_EPSILON);
+    constexpr T RANGE_MIN = static_cast<T>(USER_RANGE_MIN);
+    constexpr T RANGE_MAX = static_cast<T>(USER_RANGE_MAX);
+
+    // Not a multiple of any register width, so we also test the remainders
+    constexpr size_t NUM_VECTORS = 37;
+
+    auto vecs_a =
+        ::math::random_vec3_array<T>(NUM_VECTORS, RANGE_MIN, RANGE_MAX);
+    auto vecs_b =
+        ::math::random_vec3_array<T>(NUM_VECTORS, RANGE_MIN, RANGE_MAX);
+    Vector3Batch batch_a(vecs_a);
+    Vector3Batch batch_b(vecs_b);
+
+    SECTION("Batch addition, difference and scaling") {
+        for (const auto isa : ::math::dispatch::GetSupportedIsas()) {
+            ::math::dispatch::ScopedIsa guard(isa);
+            INFO("isa: " << ::math::dispatch::ToString(isa));
+            auto sum = batch_a + batch_b;
+            auto diff = batch_a - batch_b;
+            auto scaled = 2.5 * batch_a;
+            auto scaled_r = batch_a * 2.5;
+            auto hadamard = batch_a * batch_b;
+            for (size_t i = 0; i < NUM_VECTORS; ++i) {
+                REQUIRE(sum[i] == vecs_a[i] + vecs_b[i]);
+                REQUIRE(diff[i] == vecs_a[i] - vecs_b[i]);
+                REQUIRE(scaled[i] == 2.5 * vecs_a[i]);
+                REQUIRE(scaled_r[i] == vecs_a[i] * 2.5);
+                REQUIRE(hadamard[i] == vecs_a[i] * vecs_b[i]);
+            }
+        }
+    }
+
+    SECTION("Batch dot and cross products") {
+        for (const auto isa : ::math::dispatch::GetSupportedIsas()) {
+            ::math::dispatch::ScopedIsa guard(isa);
+            INFO("isa: " << ::math::dispatch::ToString(isa));
+            auto dots = ::math::dot(batch_a, batch_b);
+            auto crosses = ::math::cross(batch_a, batch_b);
+            std::vector<T> dots_aos(NUM_VECTORS);
+            std::vector<::math::Vector3<T>> crosses_aos(NUM_VECTORS);
+            ::math::dot(vecs_a.data(), vecs_b.data(), dots_aos.data(),
+                        NUM_VECTORS);
+            ::math::cross(vecs_a.data(), vecs_b.data(), crosses_aos.data(),
+                          NUM_VECTORS);
+            for (size_t i = 0; i < NUM_VECTORS; ++i) {
+                const auto expected_dot = ::math::dot(vecs_a[i], vecs_b[i]);
+                const auto expected_cross = ::math::cross(vecs_a[i], vecs_b[i]);
+                REQUIRE(::math::func_value_close<T>(dots[i], expected_dot,
+                                                    EPSILON));
+                REQUIRE(::math::func_value_close<T>(dots_aos[i], expected_dot,
+                                                    EPSILON));
+                REQUIRE(crosses[i] == expected_cross);
+                REQUIRE(crosses_aos[i] == expected_cross);
+            }
+        }
+    }
+
+    SECTION("Batch norms and normalization") {
+        for (const auto isa : ::math::dispatch::GetSupportedIsas()) {
+            ::math::dispatch::ScopedIsa guard(isa);
+            INFO("isa: " << ::math::dispatch::ToString(isa));
+            auto norms = ::math::norm(batch_a);
+            auto square_norms = ::math::squareNorm(batch_a);
+            auto normalized = batch_a.normalized();
+            std::vector<T> norms_aos(NUM_VECTORS);
+            std::vector<T> square_norms_aos(NUM_VECTORS);
+            std::vector<::math::Vector3<T>> normalized_aos(NUM_VECTORS);
+            ::math::norm(vecs_a.data(), norms_aos.data(), NUM_VECTORS);
+            ::math::squareNorm(vecs_a.data(), square_norms_aos.data(),
+                               NUM_VECTORS);
+            ::math::normalize(vecs_a.data(), normalized_aos.data(),
+                              NUM_VECTORS);
+            for (size_t i = 0; i < NUM_VECTORS; ++i) {
+                const auto expected_norm = ::math::norm(vecs_a[i]);
+                const auto expected_sqnorm = ::math::squareNorm(vecs_a[i]);
+                REQUIRE(::math::func_value_close<T>(norms[i], expected_norm,
+                                                    EPSILON));
+                REQUIRE(::math::func_value_close<T>(norms_aos[i],
+                                                    expected_norm, EPSILON));
+                REQUIRE(::math::func_value_close<T>(
+                    square_norms[i], expected_sqnorm, EPSILON * 100));
+                REQUIRE(::math::func_value_close<T>(
+                    square_norms_aos[i], expected_sqnorm, EPSILON * 100));
+                REQUIRE(normalized[i] == ::math::normalize(vecs_a[i]));
+                REQUIRE(normalized_aos[i] == ::math::normalize(vecs_a[i]));
+            }
+
+            auto batch_c = batch_a;
+            batch_c.normalize();
+            auto vecs_c = vecs_a;
+            ::math::normalize_in_place(vecs_c.data(), NUM_VECTORS);
+            for (size_t i = 0; i < NUM_VECTORS; ++i) {
+                REQUIRE(batch_c[i] == ::math::normalize(vecs_a[i]));
+                REQUIRE(vecs_c[i] == ::math::normalize(vecs_a[i]));
+            }
+        }
+    }
+
+    SECTION("Linear interpolation over arrays of Vector3") {
+        constexpr T ALPHA = static_cast<T>(0.25);
+        auto alphas = ::math::random_scalar_array<T>(NUM_VECTORS);
+        for (const auto isa : ::math::dispatch::GetSupportedIsas()) {
+            ::math::dispatch::ScopedIsa guard(isa);
+            INFO("isa: " << ::math::dispatch::ToString(isa));
+            std::vector<::math::Vector3<T>> lerps(NUM_VECTORS);
+            std::vector<::math::Vector3<T>> lerps_each(NUM_VECTORS);
+            ::math::lerp(vecs_a.data(), vecs_b.data(), ALPHA, lerps.data(),
+                         NUM_VECTORS);
+            ::math::lerp(vecs_a.data(), vecs_b.data(), alphas.data(),
+                         lerps_each.data(), NUM_VECTORS);
+            for (size_t i = 0; i < NUM_VECTORS; ++i) {
+                const auto expected = ::math::lerp(vecs_a[i], vecs_b[i], ALPHA);
+                const auto expected_each =
+                    ::math::lerp(vecs_a[i], vecs_b[i], alphas[i]);
+                REQUIRE(::math::func_all_close<T>(
+                    lerps[i], expected.x(), expected.y(), expected.z(),
+                    EPSILON));
+                REQUIRE(::math::func_all_close<T>(
+                    lerps_each[i], expected_each.x(), expected_each.y(),
+                    expected_each.z(), EPSILON));
+            }
+
+            // The endpoints are exact, and dst can alias the inputs
+            auto vecs_c = vecs_a;
+            ::math::lerp(vecs_c.data(), vecs_b.data(), static_cast<T>(1),
+                         vecs_c.data(), NUM_VECTORS);
+            for (size_t i = 0; i < NUM_VECTORS; ++i) {
+                REQUIRE(vecs_c[i] == vecs_b[i]);
+            }
+        }
+    }
+}
+
+#if defined(__clang__)
+#pragma clang diagnostic pop  // NOLINT
+#elif defined(__GNUC__)
+#pragma GCC diagnostic pop
+#elif defined(_MSC_VER)
+#pragma warning(pop)
+#endif
@@ -1,3 +1,6 @@
+#include <cmath>
+#include <limits>
+
 #include <catch2/catch.hpp>
 #include <math/vec3_t.hpp>
 
@@ -167,7 +170,14 @@ TEMPLATE_TEST_CASE("Vector3 class (vec3_t) core Operations", "[vec3_t][ops]",
         auto dot = v_a.x() * v_b.x() + v_a.y() * v_b.y() + v_a.z() * v_b.z();
         auto v_dot = ::math::dot(v_a, v_b);
 
-        REQUIRE(::math::func_value_close<T>(v_dot, dot, EPSILON));
+        // The FMA kernel fuses some of the products into the sums, so allow for
+        // a few ulps of the magnitude of the terms (which can be large here)
+        auto dot_abs = std::abs(v_a.x() * v_b.x()) +
+                       std::abs(v_a.y() * v_b.y()) +
+                       std::abs(v_a.z() * v_b.z());
+        auto tolerance =
+            EPSILON + 8 * std::numeric_limits<T>::epsilon() * dot_abs;
+        REQUIRE(::math::func_value_close<T>(v_dot, dot, tolerance));
     }
 
     SECTION("Vector cross-product") {
@@ -210,6 +220,31 @@ TEMPLATE_TEST_CASE("Vector3 class (vec3_t) core Operations", "[vec3_t][ops]",
         REQUIRE(
             ::math::func_all_close<T>(inv_v, -v.x(), -v.y(), -v.z(), EPSILON));
     }
+
+    SECTION("Vector storage (MATH3D_VEC3_PADDED)") {
+        if (!::math::HAS_VEC3_PADDING::value) {
+            REQUIRE(sizeof(Vector3) == 3 * sizeof(T));
+            return;
+        }
+        REQUIRE(sizeof(Vector3) == 4 * sizeof(T));
+        REQUIRE(alignof(Vector3) == 4 * sizeof(T));
+
+        auto v_a = GENERATE(
+            take(NUM_SAMPLES, ::math::random_vec3<T>(RANGE_MIN, RANGE_MAX)));
+        auto v_b = GENERATE(
+            take(NUM_SAMPLES, ::math::random_vec3<T>(RANGE_MIN, RANGE_MAX)));
+
+        // The padding entry must stay zero after every operation
+        REQUIRE(v_a.data()[3] == static_cast<T>(0.0));
+        REQUIRE((v_a + v_b).data()[3] == static_cast<T>(0.0));
+        REQUIRE((v_a - v_b).data()[3] == static_cast<T>(0.0));
+        REQUIRE((v_a * v_b).data()[3] == static_cast<T>(0.0));
+        REQUIRE((2.0 * v_a).data()[3] == static_cast<T>(0.0));
+        REQUIRE(::math::cross(v_a, v_b).data()[3] == static_cast<T>(0.0));
+        REQUIRE(::math::normalize(v_a).data()[3] == static_cast<T>(0.0));
+        REQUIRE(::math::lerp(v_a, v_b, static_cast<T>(0.5)).data()[3] ==
+                static_cast<T>(0.0));
+    }
 }
 
 #if defined(__clang__)
@@ -1,3 +1,6 @@
+#include <cmath>
+#include <limits>
+
 #include <catch2/catch.hpp>
 #include <math/vec4_t.hpp>
 
@@ -190,16 +193,15 @@ TEMPLATE_TEST_CASE("Vector4 class (vec4_t) core Operations", "[vec4_t][ops]",
                    v_a.w() * v_b.w();
         auto v_dot = ::math::dot(v_a, v_b);
 
-        if (::math::IsFloat32<T>::value) {
-            // TODO(wilbert): If scalar version is more precise, then we might
-            // have an issue with SIMD instructions not returning the correct
-            // value
-
-            // Use larger delta, as we're losing precision quickly on f32
-            REQUIRE(::math::func_value_close<T>(v_dot, dot, 1e-1));
-        } else {
-            REQUIRE(::math::func_value_close<T>(v_dot, dot, EPSILON));
-        }
+        // The SIMD kernels add the products in a different order (and the FMA
+        // one fuses some of them), so the result can be off by a few ulps of
+        // the magnitude of the terms, which a fixed delta can't cover for f32
+        auto dot_abs =
+            std::abs(v_a.x() * v_b.x()) + std::abs(v_a.y() * v_b.y()) +
+            std::abs(v_a.z() * v_b.z()) + std::abs(v_a.w() * v_b.w());
+        auto tolerance =
+            EPSILON + 8 * std::numeric_limits<T>::epsilon() * dot_abs;
+        REQUIRE(::math::func_value_close<T>(v_dot, dot, tolerance));
     }
 
     SECTION("Vector additive inverse") {
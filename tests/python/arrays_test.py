@@ -0,0 +1,127 @@
+import numpy as np
+import pytest
+
+import math3d as m3d
+
+NUM_ELEMENTS = 29
+
+
+@pytest.mark.parametrize(
+    "Vec3Array,Vec3,FloatType",
+    [
+        (m3d.Vector3Array_f, m3d.Vector3f, np.float32),
+        (m3d.Vector3Array_d, m3d.Vector3d, np.float64),
+    ],
+)
+def test_vector3_array(Vec3Array: type, Vec3: type, FloatType: type) -> None:
+    array = Vec3Array(NUM_ELEMENTS)
+    assert len(array) == NUM_ELEMENTS and not array.is_view
+    array[1] = Vec3(1.0, 2.0, 3.0)
+    assert array[1] == Vec3(1.0, 2.0, 3.0)
+
+    # numpy() and the buffer protocol expose the storage without copies
+    array_np = array.numpy()
+    assert array_np.shape == (NUM_ELEMENTS, 3) and array_np.dtype == FloatType
+    assert np.allclose(array_np[1], [1.0, 2.0, 3.0])
+    array_np[2] = [4.0, 5.0, 6.0]
+    assert array[2] == Vec3(4.0, 5.0, 6.0)
+    assert np.shares_memory(np.asarray(array), array_np)
+
+
+@pytest.mark.parametrize(
+    "Vec3Array,FloatType",
+    [(m3d.Vector3Array_f, np.float32), (m3d.Vector3Array_d, np.float64)],
+)
+def test_view_over_numpy(Vec3Array: type, FloatType: type) -> None:
+    rng = np.random.default_rng(0)
+    points = rng.uniform(-1.0, 1.0, size=(NUM_ELEMENTS, 3)).astype(FloatType)
+    # Arrays with another layout (e.g. the dtype or the strides) can only be
+    # copied, and the layout of Vector3 depends on the build (padded or not)
+    try:
+        array = Vec3Array(points)
+    except RuntimeError:
+        array = Vec3Array(points, copy=True)
+        assert not array.is_view
+        assert np.allclose(array.numpy(), points)
+        return
+    assert array.is_view
+    points[0] = [7.0, 8.0, 9.0]
+    assert np.allclose(array.numpy()[0], [7.0, 8.0, 9.0])
+
+    with pytest.raises(RuntimeError):
+        Vec3Array(np.zeros((NUM_ELEMENTS, 4), dtype=FloatType))
+    with pytest.raises(RuntimeError):
+        Vec3Array(np.zeros((3, NUM_ELEMENTS), dtype=FloatType).T)
+
+
+@pytest.mark.parametrize(
+    "Mat4Array,FloatType",
+    [(m3d.Matrix4Array_f, np.float32), (m3d.Matrix4Array_d, np.float64)],
+)
+def test_matrix4_array(Mat4Array: type, FloatType: type) -> None:
+    rng = np.random.default_rng(1)
+    lhs_np = rng.uniform(-1.0, 1.0, size=(NUM_ELEMENTS, 4, 4))
+    rhs_np = rng.uniform(-1.0, 1.0, size=(NUM_ELEMENTS, 4, 4))
+    # Row-major NumPy arrays don't have the layout of the (column-major)
+    # matrices, whereas their transposes do
+    with pytest.raises(RuntimeError):
+        Mat4Array(lhs_np.astype(FloatType))
+    lhs = Mat4Array(lhs_np.astype(FloatType), copy=True)
+    rhs = Mat4Array(np.ascontiguousarray(rhs_np.transpose(0, 2, 1)).astype(
+        FloatType).transpose(0, 2, 1))
+    assert not lhs.is_view and rhs.is_view
+    assert np.allclose(lhs.numpy(), lhs_np, atol=1e-6)
+    assert np.allclose(rhs.numpy(), rhs_np, atol=1e-6)
+
+    result = m3d.matmul(lhs, rhs)
+    assert type(result) == Mat4Array
+    assert np.allclose(result.numpy(), lhs_np @ rhs_np, atol=1e-5)
+
+
+@pytest.mark.parametrize(
+    "PoseArray,QuatArray,FloatType",
+    [
+        (m3d.Pose3dArray_f, m3d.QuaternionArray_f, np.float32),
+        (m3d.Pose3dArray_d, m3d.QuaternionArray_d, np.float64),
+    ],
+)
+def test_pose3d_array(
+    PoseArray: type, QuatArray: type, FloatType: type
+) -> None:
+    rng = np.random.default_rng(2)
+    positions = rng.uniform(-1.0, 1.0, size=(NUM_ELEMENTS, 3))
+    quats = rng.uniform(-1.0, 1.0, size=(NUM_ELEMENTS, 4))
+    quats /= np.linalg.norm(quats, axis=1, keepdims=True)
+    poses_np = np.hstack([positions, quats]).astype(FloatType)
+
+    poses = PoseArray(poses_np, copy=True)
+    assert np.allclose(poses.positions(), poses_np[:, :3])
+    assert np.allclose(poses.orientations(), poses_np[:, 3:])
+    assert np.allclose(QuatArray(poses_np[:, 3:], copy=True).numpy(),
+                       poses_np[:, 3:])
+
+    # The same results as with (N, 7) arrays, written in place
+    expected = m3d.compose_poses(poses_np, poses_np)
+    m3d.compose_poses(poses, poses, out=poses)
+    assert np.allclose(poses.positions(), expected[:, :3], atol=1e-5)
+    assert np.allclose(poses.orientations(), expected[:, 3:], atol=1e-5)
+
+
+@pytest.mark.parametrize(
+    "Vec3Array,FloatType",
+    [(m3d.Vector3Array_f, np.float32), (m3d.Vector3Array_d, np.float64)],
+)
+def test_batch_functions(Vec3Array: type, FloatType: type) -> None:
+    rng = np.random.default_rng(3)
+    points_np = rng.uniform(-1.0, 1.0, size=(NUM_ELEMENTS, 3))
+    points = Vec3Array(points_np.astype(FloatType), copy=True)
+    Mat4 = m3d.Matrix4f if FloatType == np.float32 else m3d.Matrix4d
+    transform = Mat4(np.eye(4, dtype=FloatType))
+    transform[3] = np.array([1.0, 2.0, 3.0, 1.0], dtype=FloatType)
+
+    out = Vec3Array(NUM_ELEMENTS)
+    result = m3d.transform_points(transform, points, out=out)
+    assert result is out
+    assert np.allclose(out.numpy(), points_np + [1.0, 2.0, 3.0], atol=1e-5)
+    with pytest.raises(RuntimeError):
+        m3d.transform_points(transform, points, out=Vec3Array(1))
@@ -0,0 +1,141 @@
+import numpy as np
+import pytest
+
+import math3d as m3d
+
+NUM_ELEMENTS = 37
+
+
+def random_rotations(rng: np.random.Generator, FloatType: type) -> np.ndarray:
+    quats = rng.uniform(-1.0, 1.0, size=(NUM_ELEMENTS, 4))
+    quats /= np.linalg.norm(quats, axis=1, keepdims=True)
+    return quats.astype(FloatType)
+
+
+def random_poses(rng: np.random.Generator, FloatType: type) -> np.ndarray:
+    positions = rng.uniform(-1.0, 1.0, size=(NUM_ELEMENTS, 3))
+    quats = random_rotations(rng, np.float64)
+    return np.hstack([positions, quats]).astype(FloatType)
+
+
+def pose_to_matrix(pose: np.ndarray) -> np.ndarray:
+    transform = np.eye(4)
+    transform[:3, :3] = m3d.rotation_matrix_from_quat(
+        pose[np.newaxis, 3:].astype(np.float64)
+    )[0]
+    transform[:3, 3] = pose[:3]
+    return transform
+
+
+@pytest.mark.parametrize("FloatType", [np.float32, np.float64])
+def test_transform_points(FloatType: type) -> None:
+    rng = np.random.default_rng(0)
+    transform = rng.uniform(-1.0, 1.0, size=(4, 4)).astype(FloatType)
+    points = rng.uniform(-1.0, 1.0, size=(NUM_ELEMENTS, 3)).astype(FloatType)
+    expected = points @ transform[:3, :3].T + transform[:3, 3]
+
+    result = m3d.transform_points(transform, points)
+    assert result.shape == points.shape and result.dtype == FloatType
+    assert np.allclose(result, expected, atol=1e-5)
+
+    # The results are written into the given array, with no copies
+    out = np.zeros_like(points)
+    result = m3d.transform_points(transform, points, out=out)
+    assert np.shares_memory(result, out)
+    assert np.allclose(out, expected, atol=1e-5)
+
+
+@pytest.mark.parametrize(
+    "Pose,FloatType", [(m3d.Pose3d_f, np.float32), (m3d.Pose3d_d, np.float64)]
+)
+def test_transform_points_by_pose(Pose: type, FloatType: type) -> None:
+    rng = np.random.default_rng(1)
+    pose_np = random_poses(rng, FloatType)[0]
+    Vec3 = m3d.Vector3f if FloatType == np.float32 else m3d.Vector3d
+    Quat = m3d.Quaternionf if FloatType == np.float32 else m3d.Quaterniond
+    pose = Pose(Vec3(*pose_np[:3]), Quat(*pose_np[3:]))
+    points = rng.uniform(-1.0, 1.0, size=(NUM_ELEMENTS, 3)).astype(FloatType)
+
+    result = m3d.transform_points(pose, points)
+    for point, transformed in zip(points, result):
+        expected = pose.apply(point)
+        assert np.allclose(transformed, expected, atol=1e-5)
+
+
+@pytest.mark.parametrize("FloatType", [np.float32, np.float64])
+def test_rotate_vectors(FloatType: type) -> None:
+    rng = np.random.default_rng(2)
+    quat = random_rotations(rng, FloatType)[0]
+    vectors = rng.uniform(-1.0, 1.0, size=(NUM_ELEMENTS, 3)).astype(FloatType)
+    rotation = m3d.rotation_matrix_from_quat(quat[np.newaxis])[0]
+    expected = vectors @ rotation.T
+
+    result = m3d.rotate_vectors(quat, vectors)
+    assert result.shape == vectors.shape and result.dtype == FloatType
+    assert np.allclose(result, expected, atol=1e-5)
+
+    # In-place, overwriting the inputs
+    m3d.rotate_vectors(quat, vectors, out=vectors)
+    assert np.allclose(vectors, expected, atol=1e-5)
+
+
+@pytest.mark.parametrize("FloatType", [np.float32, np.float64])
+def test_compose_poses(FloatType: type) -> None:
+    rng = np.random.default_rng(3)
+    lhs = random_poses(rng, FloatType)
+    rhs = random_poses(rng, FloatType)
+
+    result = m3d.compose_poses(lhs, rhs)
+    assert result.shape == (NUM_ELEMENTS, 7) and result.dtype == FloatType
+    for pose_a, pose_b, pose in zip(lhs, rhs, result):
+        expected = pose_to_matrix(pose_a) @ pose_to_matrix(pose_b)
+        assert np.allclose(pose_to_matrix(pose), expected, atol=1e-5)
+
+    # Skipping the renormalization only changes the rounding errors
+    unnormalized = m3d.compose_poses(lhs, rhs, renormalize=False)
+    assert np.allclose(unnormalized, result, atol=1e-5)
+
+
+@pytest.mark.parametrize("FloatType", [np.float32, np.float64])
+def test_matmul(FloatType: type) -> None:
+    rng = np.random.default_rng(4)
+    lhs = rng.uniform(-1.0, 1.0, size=(NUM_ELEMENTS, 4, 4)).astype(FloatType)
+    rhs = rng.uniform(-1.0, 1.0, size=(NUM_ELEMENTS, 4, 4)).astype(FloatType)
+
+    result = m3d.matmul(lhs, rhs)
+    assert result.shape == lhs.shape and result.dtype == FloatType
+    assert np.allclose(result, lhs @ rhs, atol=1e-5)
+
+    out = np.empty_like(lhs)
+    m3d.matmul(lhs, rhs, out=out)
+    assert np.allclose(out, lhs @ rhs, atol=1e-5)
+
+
+@pytest.mark.parametrize("FloatType", [np.float32, np.float64])
+def test_quat_from_euler_out(FloatType: type) -> None:
+    rng = np.random.default_rng(5)
+    angles = rng.uniform(-np.pi, np.pi, size=(NUM_ELEMENTS, 3))
+    angles = angles.astype(FloatType)
+    out = np.empty((NUM_ELEMENTS, 4), dtype=FloatType)
+    result = m3d.quat_from_euler(angles, m3d.eOrder.XYZ, out=out)
+    assert np.shares_memory(result, out)
+    assert np.allclose(out, m3d.quat_from_euler(angles, m3d.eOrder.XYZ))
+
+
+def test_invalid_arguments() -> None:
+    points = np.zeros((NUM_ELEMENTS, 3), dtype=np.float64)
+    with pytest.raises(RuntimeError):
+        m3d.transform_points(np.eye(4), points.reshape(-1, 1))
+    # Wrong shape, dtype and layout of the output array
+    with pytest.raises(RuntimeError):
+        m3d.transform_points(np.eye(4), points, out=np.zeros((3, 3)))
+    with pytest.raises(RuntimeError):
+        m3d.transform_points(
+            np.eye(4), points, out=np.zeros_like(points, dtype=np.float32)
+        )
+    with pytest.raises(RuntimeError):
+        m3d.transform_points(
+            np.eye(4), points, out=np.zeros((3, NUM_ELEMENTS)).T
+        )
+    with pytest.raises(RuntimeError):
+        m3d.matmul(np.zeros((2, 4, 4)), np.zeros((3, 4, 4)))
@@ -0,0 +1,24 @@
+import math3d as m3d
+
+
+def test_scalar_always_supported() -> None:
+    assert m3d.is_isa_supported(m3d.eIsa.SCALAR)
+    isas = m3d.get_supported_isas()
+    assert len(isas) > 0 and isas[0] == m3d.eIsa.SCALAR
+    assert m3d.get_best_isa() == isas[-1]
+
+
+def test_active_isa_is_supported() -> None:
+    m3d.reset_active_isa()
+    assert m3d.is_isa_supported(m3d.get_active_isa())
+
+
+def test_force_isa() -> None:
+    initial = m3d.get_active_isa()
+    for isa in [m3d.eIsa.SCALAR, m3d.eIsa.SSE, m3d.eIsa.AVX]:
+        supported = m3d.is_isa_supported(isa)
+        assert m3d.set_active_isa(isa) == supported
+        if supported:
+            assert m3d.get_active_isa() == isa
+    m3d.reset_active_isa()
+    assert m3d.get_active_isa() == initial
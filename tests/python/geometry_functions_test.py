@@ -0,0 +1,182 @@
+from typing import Any, Tuple
+
+import numpy as np
+import pytest
+
+import math3d as m3d
+
+NUM_RAYS = 37
+NUM_BOXES = 101
+
+
+def random_boxes(
+    rng: np.random.Generator, FloatType: type
+) -> Tuple[np.ndarray, np.ndarray]:
+    centers = rng.uniform(-5.0, 5.0, size=(NUM_BOXES, 3))
+    half_extents = rng.uniform(0.1, 1.0, size=(NUM_BOXES, 3))
+    mins = (centers - half_extents).astype(FloatType)
+    maxs = (centers + half_extents).astype(FloatType)
+    return mins, maxs
+
+
+def slab_test(
+    origin: np.ndarray,
+    direction: np.ndarray,
+    mins: np.ndarray,
+    maxs: np.ndarray,
+) -> np.ndarray:
+    # Reference slab test, for rays that aren't parallel to any axis
+    t_a = (mins - origin) / direction
+    t_b = (maxs - origin) / direction
+    t_enter = np.maximum(np.minimum(t_a, t_b).max(axis=1), 0.0)
+    t_exit = np.maximum(t_a, t_b).min(axis=1)
+    return np.where(t_enter <= t_exit, t_enter, np.inf)
+
+
+@pytest.mark.parametrize("FloatType", [np.float32, np.float64])
+def test_intersect_rays_aabbs(FloatType: type) -> None:
+    rng = np.random.default_rng(0)
+    mins, maxs = random_boxes(rng, FloatType)
+    origins = rng.uniform(-6.0, 6.0, size=(NUM_RAYS, 3)).astype(FloatType)
+    directions = rng.uniform(0.5, 1.0, size=(NUM_RAYS, 3))
+    directions *= rng.choice([-1.0, 1.0], size=(NUM_RAYS, 3))
+    directions = directions.astype(FloatType)
+
+    result = m3d.intersect_rays_aabbs(origins, directions, mins, maxs)
+    assert result.shape == (NUM_RAYS, NUM_BOXES) and result.dtype == FloatType
+    for i in range(NUM_RAYS):
+        expected = slab_test(
+            origins[i].astype(np.float64),
+            directions[i].astype(np.float64),
+            mins.astype(np.float64),
+            maxs.astype(np.float64),
+        )
+        hits = np.isfinite(expected)
+        assert np.array_equal(np.isfinite(result[i]), hits)
+        assert np.allclose(result[i][hits], expected[hits], atol=1e-4)
+
+    # Only the boxes entered within [0, t_max] are reported
+    result_max = m3d.intersect_rays_aabbs(
+        origins, directions, mins, maxs, t_max=2.0
+    )
+    assert np.all(np.isinf(result_max[result > 2.0]))
+
+
+@pytest.mark.parametrize("FloatType", [np.float32, np.float64])
+def test_raycast_aabbs(FloatType: type) -> None:
+    rng = np.random.default_rng(1)
+    mins, maxs = random_boxes(rng, FloatType)
+    origins = rng.uniform(-6.0, 6.0, size=(NUM_RAYS, 3)).astype(FloatType)
+    directions = rng.uniform(-1.0, 1.0, size=(NUM_RAYS, 3)).astype(FloatType)
+
+    indices, distances = m3d.raycast_aabbs(origins, directions, mins, maxs)
+    assert indices.shape == (NUM_RAYS,) and indices.dtype == np.int64
+    assert distances.shape == (NUM_RAYS,) and distances.dtype == FloatType
+
+    # Same as the closest of all the ray-box distances
+    all_distances = m3d.intersect_rays_aabbs(origins, directions, mins, maxs)
+    for i in range(NUM_RAYS):
+        closest = all_distances[i].min()
+        assert distances[i] == closest
+        if np.isinf(closest):
+            assert indices[i] == -1
+        else:
+            assert all_distances[i][indices[i]] == closest
+
+
+def test_raycast_aabbs_invalid_shapes() -> None:
+    rays = np.zeros((4, 3))
+    boxes = np.zeros((5, 3))
+    with pytest.raises(RuntimeError):
+        m3d.raycast_aabbs(rays, rays, boxes, np.zeros((4, 3)))
+    with pytest.raises(RuntimeError):
+        m3d.intersect_rays_aabbs(rays, np.zeros((3, 3)), boxes, boxes)
+    with pytest.raises(RuntimeError):
+        m3d.intersect_rays_aabbs(rays, rays, np.zeros((5, 4)), boxes)
+
+
+
+NUM_VOLUMES = 203
+# Volumes closer than this to a plane of the frustum are skipped (the SIMD
+# kernels may round differently than the scalar tests, e.g. if using FMAs)
+CULL_EPSILON = 1e-3
+
+
+def make_frustum(FloatType: type) -> Tuple[Any, np.ndarray, np.ndarray]:
+    Frustum = m3d.Frustum_f if FloatType == np.float32 else m3d.Frustum_d
+    Mat4 = m3d.Matrix4f if FloatType == np.float32 else m3d.Matrix4d
+    Vec3 = m3d.Vector3f if FloatType == np.float32 else m3d.Vector3d
+    # Camera at (1, 2, 3), looking along -z
+    view_proj = Mat4.Perspective(60.0, 1.5, 0.5, 20.0) * Mat4.Translation(
+        Vec3(-1.0, -2.0, -3.0)
+    )
+    frustum = Frustum(view_proj)
+    # The (6, 3) normals and (6,) offsets of the planes of the frustum
+    planes = [frustum.plane(k) for k in range(6)]
+    normals = np.array([np.array(plane.normal) for plane in planes])
+    points = np.array([np.array(plane.point) for plane in planes])
+    offsets = -(normals * points).sum(axis=1)
+    return frustum, normals.astype(np.float64), offsets.astype(np.float64)
+
+
+@pytest.mark.parametrize("FloatType", [np.float32, np.float64])
+def test_cull_points(FloatType: type) -> None:
+    rng = np.random.default_rng(2)
+    frustum, normals, offsets = make_frustum(FloatType)
+    points = rng.uniform(-12.0, 12.0, size=(NUM_VOLUMES, 3)).astype(FloatType)
+
+    visible = m3d.cull_points(frustum, points)
+    assert visible.shape == (NUM_VOLUMES,) and visible.dtype == np.bool_
+    distances = points.astype(np.float64) @ normals.T + offsets
+    valid = np.abs(distances).min(axis=1) > CULL_EPSILON
+    expected = (distances >= 0.0).all(axis=1)
+    assert np.array_equal(visible[valid], expected[valid])
+    assert expected[valid].any() and not expected[valid].all()
+    for i in np.nonzero(valid)[0]:
+        assert visible[i] == frustum.contains(points[i])
+
+
+@pytest.mark.parametrize("FloatType", [np.float32, np.float64])
+def test_cull_spheres_and_aabbs(FloatType: type) -> None:
+    rng = np.random.default_rng(3)
+    frustum, normals, offsets = make_frustum(FloatType)
+    centers = rng.uniform(-12.0, 12.0, size=(NUM_VOLUMES, 3))
+    half_extents = rng.uniform(0.0, 2.0, size=(NUM_VOLUMES, 3))
+    radii = rng.uniform(0.0, 2.0, size=NUM_VOLUMES).astype(FloatType)
+    mins = (centers - half_extents).astype(FloatType)
+    maxs = (centers + half_extents).astype(FloatType)
+    centers = centers.astype(FloatType)
+
+    # A sphere is visible if its center is within its radius of every plane
+    visible_spheres = m3d.cull_spheres(frustum, centers, radii)
+    assert visible_spheres.shape == (NUM_VOLUMES,)
+    distances = centers.astype(np.float64) @ normals.T + offsets
+    margins = distances + radii.astype(np.float64)[:, np.newaxis]
+    valid = np.abs(margins).min(axis=1) > CULL_EPSILON
+    expected = (margins >= 0.0).all(axis=1)
+    assert np.array_equal(visible_spheres[valid], expected[valid])
+
+    # A box is visible if its corner furthest along the normal of each plane
+    # is in front of that plane
+    visible_boxes = m3d.cull_aabbs(frustum, mins, maxs)
+    assert visible_boxes.shape == (NUM_VOLUMES,)
+    margins = np.empty((NUM_VOLUMES, 6))
+    for k in range(6):
+        corners = np.where(normals[k] >= 0.0, maxs, mins).astype(np.float64)
+        margins[:, k] = corners @ normals[k] + offsets[k]
+    valid = np.abs(margins).min(axis=1) > CULL_EPSILON
+    expected = (margins >= 0.0).all(axis=1)
+    assert np.array_equal(visible_boxes[valid], expected[valid])
+    assert expected[valid].any() and not expected[valid].all()
+
+
+def test_cull_invalid_shapes() -> None:
+    frustum = m3d.Frustum_d()
+    with pytest.raises(RuntimeError):
+        m3d.cull_points(frustum, np.zeros((4, 2)))
+    with pytest.raises(RuntimeError):
+        m3d.cull_spheres(frustum, np.zeros((4, 3)), np.zeros(5))
+    with pytest.raises(RuntimeError):
+        m3d.cull_aabbs(frustum, np.zeros((4, 3)), np.zeros((5, 3)))
+    # The default frustum contains the whole space
+    assert np.all(m3d.cull_points(frustum, np.ones((70, 3))))
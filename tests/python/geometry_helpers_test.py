@@ -9,6 +9,7 @@ import math3d as m3d
 LineCls = Type[Union[m3d.Line_f, m3d.Line_d]]
 PlaneCls = Type[Union[m3d.Plane_f, m3d.Plane_d]]
 AABBCls = Type[Union[m3d.AABB_f, m3d.AABB_d]]
+RayCls = Type[Union[m3d.Ray_f, m3d.Ray_d]]
 Vector3Cls = Type[Union[m3d.Vector3f, m3d.Vector3d]]
 
 Vector3 = Union[m3d.Vector3f, m3d.Vector3d]
@@ -424,3 +425,61 @@ def test_aabb_method_computeCorners(AABB: AABBCls, FloatType: type) -> None:
     assert vec3_all_close(
         corners[7], np.array([1.0, 1.0, 1.0], dtype=FloatType)
     )
+
+
+# Tests for Ray type -----------------------------------------------------------
+
+
+@pytest.mark.parametrize(
+    "Ray, FloatType", [(m3d.Ray_f, np.float32), (m3d.Ray_d, np.float64)]
+)
+def test_ray_ctor_default(Ray: RayCls, FloatType: type) -> None:
+    ray = Ray()
+
+    assert vec3_all_close(ray.origin, np.zeros((3,)).astype(FloatType))
+    assert vec3_all_close(
+        ray.direction, np.array([1.0, 0.0, 0.0], dtype=FloatType)
+    )
+
+
+@pytest.mark.parametrize(
+    "Ray, FloatType", [(m3d.Ray_f, np.float32), (m3d.Ray_d, np.float64)]
+)
+def test_ray_inverse_direction(Ray: RayCls, FloatType: type) -> None:
+    ray = Ray(
+        np.array([0.0, 0.0, 0.0], dtype=FloatType),
+        np.array([2.0, 0.0, -4.0], dtype=FloatType),
+    )
+    inv_direction = np.array(ray.inv_direction)
+    assert inv_direction[0] == 0.5 and inv_direction[2] == -0.25
+    assert np.isposinf(inv_direction[1])
+
+    # Setting the direction also updates its inverse
+    ray.direction = ray.direction * 2.0
+    assert np.array(ray.inv_direction)[0] == 0.25
+
+
+@pytest.mark.parametrize(
+    "Ray, AABB, FloatType",
+    [
+        (m3d.Ray_f, m3d.AABB_f, np.float32),
+        (m3d.Ray_d, m3d.AABB_d, np.float64),
+    ],
+)
+def test_ray_intersect_aabb(
+    Ray: RayCls, AABB: AABBCls, FloatType: type
+) -> None:
+    bbox = AABB(
+        np.array([1.0, -1.0, -1.0], dtype=FloatType),
+        np.array([2.0, 1.0, 1.0], dtype=FloatType),
+    )
+    origin = np.zeros((3,), dtype=FloatType)
+    ray_x = Ray(origin, np.array([1.0, 0.0, 0.0], dtype=FloatType))
+    ray_y = Ray(origin, np.array([0.0, 1.0, 0.0], dtype=FloatType))
+
+    assert ray_x.intersect(bbox) == 1.0
+    assert np.isinf(ray_x.intersect(bbox, t_max=0.5))
+    assert np.isinf(ray_y.intersect(bbox))
+    assert vec3_all_close(
+        ray_x.pointAt(1.5), np.array([1.5, 0.0, 0.0], dtype=FloatType)
+    )
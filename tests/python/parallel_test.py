@@ -0,0 +1,35 @@
+import numpy as np
+
+import math3d as m3d
+
+
+def test_num_threads() -> None:
+    initial = m3d.get_num_threads()
+    assert initial >= 1
+    m3d.set_num_threads(3)
+    assert m3d.get_num_threads() == 3
+    # Zero requests one thread per hardware thread
+    m3d.set_num_threads(0)
+    assert m3d.get_num_threads() >= 1
+    m3d.set_num_threads(initial)
+    assert m3d.get_num_threads() == initial
+
+
+def test_threaded_batch_calls() -> None:
+    rng = np.random.default_rng(0)
+    transform = rng.uniform(-1.0, 1.0, size=(4, 4))
+    points = rng.uniform(-1.0, 1.0, size=(50000, 3))
+    lhs = rng.uniform(-1.0, 1.0, size=(20000, 4, 4))
+    rhs = rng.uniform(-1.0, 1.0, size=(20000, 4, 4))
+
+    initial = m3d.get_num_threads()
+    m3d.set_num_threads(1)
+    serial_points = m3d.transform_points(transform, points)
+    serial_mats = m3d.matmul(lhs, rhs)
+    m3d.set_num_threads(4)
+    threaded_points = m3d.transform_points(transform, points)
+    threaded_mats = m3d.matmul(lhs, rhs)
+    m3d.set_num_threads(initial)
+
+    assert np.array_equal(serial_points, threaded_points)
+    assert np.array_equal(serial_mats, threaded_mats)
@@ -245,3 +245,45 @@ def test_quat_rotate_vec(
     assert vec_j == q_rot_z.rotate(vec_i)
     assert vec_k == q_rot_x.rotate(vec_j)
     assert vec_i == q_rot_y.rotate(vec_k)
+
+
+@pytest.mark.parametrize(
+    "Quat,FloatType",
+    [(m3d.Quaternionf, np.float32), (m3d.Quaterniond, np.float64)],
+)
+def test_quat_from_euler_array(Quat: QuaternionCls, FloatType: type) -> None:
+    rng = np.random.default_rng(0)
+    angles = rng.uniform(-np.pi, np.pi, size=(11, 3)).astype(FloatType)
+    quats = m3d.quat_from_euler(angles, m3d.eOrder.XYZ)
+    assert quats.shape == (11, 4) and quats.dtype == FloatType
+    for angle, quat in zip(angles, quats):
+        # Intrinsic XYZ, i.e. a rotation around X, then Y', then Z''
+        expected = (
+            Quat.RotationX(angle[0])  # type: ignore
+            * Quat.RotationY(angle[1])  # type: ignore
+            * Quat.RotationZ(angle[2])  # type: ignore
+        )
+        assert quat_all_close(expected, quat.tolist())
+
+
+@pytest.mark.parametrize("FloatType", [np.float32, np.float64])
+def test_rotation_matrix_quat_arrays(FloatType: type) -> None:
+    rng = np.random.default_rng(0)
+    quats = rng.uniform(-1.0, 1.0, size=(11, 4))
+    quats /= np.linalg.norm(quats, axis=1, keepdims=True)
+    quats = quats.astype(FloatType)
+
+    mats = m3d.rotation_matrix_from_quat(quats)
+    assert mats.shape == (11, 3, 3) and mats.dtype == FloatType
+    identities = np.einsum("nij,nkj->nik", mats, mats)
+    assert np.allclose(identities, np.eye(3), atol=1e-5)
+    assert np.allclose(np.linalg.det(mats), 1.0, atol=1e-5)
+
+    # Both quaternions q and -q represent the same rotation
+    quats_back = m3d.quat_from_rotation_matrix(mats)
+    assert quats_back.shape == (11, 4) and quats_back.dtype == FloatType
+    dots = np.abs(np.sum(quats * quats_back, axis=1))
+    assert np.allclose(dots, 1.0, atol=1e-5)
+
+    with pytest.raises(RuntimeError):
+        m3d.quat_from_rotation_matrix(np.zeros((4, 3), dtype=FloatType))